@@ -18,9 +18,8 @@ ac_init(void)
     ac_shared->req_batches[idx].mutex = mutex_alloc();
     ac_shared->req_batches[idx].arena = arena_alloc();
   }
-  ac_shared->cancel_thread = thread_launch(ac_cancel_thread_entry_point, 0);
   ac_shared->cancel_thread_mutex = mutex_alloc();
-  mutex_take(ac_shared->cancel_thread_mutex);
+  ac_shared->cancel_thread = thread_launch(ac_cancel_thread_entry_point, 0);
 }
 
 ////////////////////////////////
@@ -30,7 +29,7 @@ internal AC_Artifact
 ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U64 endt_us)
 {
   ProfBeginFunction();
-  AC_RequestBatch *req_batch = &ac_shared->req_batches[params->flags & AC_Flag_HighPriority ? 0 : 1];
+  AC_RequestBatch *req_batch = &ac_shared->req_batches[params->flags & AC_Flag_HighPriority ? AC_Priority_High : AC_Priority_Low];
   
   //- rjf: create function -> cache
   AC_Cache *cache = 0;
@@ -94,7 +93,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
           artifact = n->val;
           access_touch(access, &n->access_pt, stripe->cv);
         }
-        if(is_stale)
+        if(is_stale && !(params->flags & AC_Flag_NoRequest))
         {
           B32 got_task = (ins_atomic_u64_eval_cond_assign(&n->working_count, 1, 0) == 0);
           need_request = got_task;
@@ -105,7 +104,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
   }
   
   //- rjf: didn't get artifact we want? -> fall back to slow path
-  if(!got_artifact || need_request)
+  if((!got_artifact || need_request) && !(params->flags & AC_Flag_NoRequest))
   {
     RWMutexScope(stripe->rw_mutex, 1) for(;;)
     {
@@ -141,6 +140,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
         node->key = str8_copy(stripe->arena, key);
         node->working_count = 1;
         node->evict_threshold_us = params->evict_threshold_us;
+        ins_atomic_u64_inc_eval(&ac_shared->stats.artifact_count);
       }
       node->access_pt.last_time_touched_us = os_now_microseconds();
       node->access_pt.last_update_idx_touched = update_tick_idx();
@@ -149,30 +149,13 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
       if(need_request)
       {
         need_request = 0;
+        AC_Request request = {key, params->gen, &node->cancelled, params->create};
         MutexScope(req_batch->mutex)
         {
-          AC_RequestNode *n = push_array(req_batch->arena, AC_RequestNode, 1);
-          if(params->flags & AC_Flag_Wide)
-          {
-            SLLQueuePush(req_batch->first_wide, req_batch->last_wide, n);
-            req_batch->wide_count += 1;
-          }
-          else
-          {
-            SLLQueuePush(req_batch->first_thin, req_batch->last_thin, n);
-            req_batch->thin_count += 1;
-          }
-          n->v.key = str8_copy(req_batch->arena, key);
-          n->v.gen = params->gen;
-          n->v.cancel_signal = &node->cancelled;
-          n->v.create = params->create;
+          ac_request_batch_push(req_batch, &request, !!(params->flags & AC_Flag_Wide));
         }
         cond_var_broadcast(async_tick_start_cond_var);
         ins_atomic_u32_eval_assign(&async_loop_again, 1);
-        if(params->flags & AC_Flag_HighPriority)
-        {
-          ins_atomic_u32_eval_assign(&async_loop_again_high_priority, 1);
-        }
       }
       
       // rjf: get value from node, if possible
@@ -205,6 +188,390 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
   return artifact;
 }
 
+////////////////////////////////
+//~ Memory Budget
+
+internal void
+ac_report_artifact_size(U64 size)
+{
+  ac_thread_artifact_size = size;
+}
+
+internal AC_Stats
+ac_stats(void)
+{
+  AC_Stats stats = {0};
+  stats.artifact_count                = ins_atomic_u64_eval(&ac_shared->stats.artifact_count);
+  stats.artifact_bytes                = ins_atomic_u64_eval(&ac_shared->stats.artifact_bytes);
+  stats.budget_evicted_artifact_count = ins_atomic_u64_eval(&ac_shared->stats.budget_evicted_artifact_count);
+  stats.budget_evicted_artifact_bytes = ins_atomic_u64_eval(&ac_shared->stats.budget_evicted_artifact_bytes);
+  return stats;
+}
+
+internal int
+ac_evict_candidate_qsort_compare__score_descending(AC_EvictCandidate *a, AC_EvictCandidate *b)
+{
+  int result = (a->score > b->score ? -1 : a->score < b->score ? +1 : 0);
+  return result;
+}
+
+////////////////////////////////
+//~ Scheduler
+
+internal void
+ac_request_batch_push(AC_RequestBatch *batch, AC_Request *request, B32 wide)
+{
+  AC_RequestNode *n = push_array(batch->arena, AC_RequestNode, 1);
+  if(wide)
+  {
+    SLLQueuePush(batch->first_wide, batch->last_wide, n);
+    batch->wide_count += 1;
+  }
+  else
+  {
+    SLLQueuePush(batch->first_thin, batch->last_thin, n);
+    batch->thin_count += 1;
+  }
+  MemoryCopyStruct(&n->v, request);
+  n->v.key = str8_copy(batch->arena, request->key);
+}
+
+internal B32
+ac_requests_pending_above_priority(AC_Priority priority)
+{
+  B32 result = 0;
+  for(AC_Priority p = (AC_Priority)0; p < priority; p = (AC_Priority)(p+1))
+  {
+    AC_RequestBatch *batch = &ac_shared->req_batches[p];
+    if(ins_atomic_u64_eval(&batch->wide_count) != 0 || ins_atomic_u64_eval(&batch->thin_count) != 0)
+    {
+      result = 1;
+      break;
+    }
+  }
+  return result;
+}
+
+internal B32
+ac_job_deque_take(AC_JobDeque *deque, B32 steal, U64 *idx_out)
+{
+  B32 result = 0;
+  for(;;)
+  {
+    U64 range = ins_atomic_u64_eval(&deque->range);
+    U64 lo = (range>>32);
+    U64 hi = (range&0xffffffff);
+    if(lo >= hi)
+    {
+      break;
+    }
+    U64 new_range = (steal ? (((lo+1)<<32) | hi) : ((lo<<32) | (hi-1)));
+    if(ins_atomic_u64_eval_cond_assign(&deque->range, new_range, range) == range)
+    {
+      idx_out[0] = (steal ? lo : hi-1);
+      result = 1;
+      break;
+    }
+  }
+  return result;
+}
+
+internal B32
+ac_job_pool_fill(Arena *arena, AC_JobPool *pool, AC_RequestBatch *batch)
+{
+  U64 lanes_count = lane_count();
+  if(pool->lane_deques == 0)
+  {
+    pool->lane_deques = push_array(arena, AC_JobDeque, lanes_count);
+  }
+  MutexScope(batch->mutex)
+  {
+    //- gather unfinished wide jobs, followed by newly submitted ones
+    {
+      U64 wide_left_count = pool->wide_count - pool->wide_take_idx;
+      AC_Request *wide = push_array_no_zero(arena, AC_Request, wide_left_count + batch->wide_count);
+      MemoryCopy(wide, pool->wide + pool->wide_take_idx, sizeof(wide[0])*wide_left_count);
+      U64 idx = wide_left_count;
+      for EachNode(n, AC_RequestNode, batch->first_wide)
+      {
+        MemoryCopyStruct(&wide[idx], &n->v);
+        wide[idx].key = str8_copy(arena, n->v.key);
+        idx += 1;
+      }
+      pool->wide = wide;
+      pool->wide_count = idx;
+      pool->wide_take_idx = 0;
+    }
+    
+    //- gather unfinished thin jobs from all lanes' deques, followed by
+    // newly submitted ones
+    {
+      U64 thin_left_count = 0;
+      for EachIndex(lane, lanes_count)
+      {
+        U64 range = pool->lane_deques[lane].range;
+        thin_left_count += (range&0xffffffff) - (range>>32);
+      }
+      AC_Request *thin = push_array_no_zero(arena, AC_Request, thin_left_count + batch->thin_count);
+      U64 idx = 0;
+      for EachIndex(lane, lanes_count)
+      {
+        U64 range = pool->lane_deques[lane].range;
+        for(U64 job_idx = (range>>32); job_idx < (range&0xffffffff); job_idx += 1)
+        {
+          MemoryCopyStruct(&thin[idx], &pool->thin[job_idx]);
+          idx += 1;
+        }
+      }
+      for EachNode(n, AC_RequestNode, batch->first_thin)
+      {
+        MemoryCopyStruct(&thin[idx], &n->v);
+        thin[idx].key = str8_copy(arena, n->v.key);
+        idx += 1;
+      }
+      pool->thin = thin;
+      pool->thin_count = idx;
+    }
+    
+    //- deal thin jobs out to lanes, in contiguous runs
+    for EachIndex(lane, lanes_count)
+    {
+      Rng1U64 range = m_range_from_n_idx_m_count(lane, lanes_count, pool->thin_count);
+      pool->lane_deques[lane].range = ((range.min<<32) | range.max);
+    }
+    
+    //- clear batch
+    arena_clear(batch->arena);
+    batch->first_wide = batch->last_wide = batch->first_thin = batch->last_thin = 0;
+    batch->wide_count = batch->thin_count = 0;
+  }
+  pool->preempted = 0;
+  B32 has_work = (pool->wide_count != 0 || pool->thin_count != 0);
+  return has_work;
+}
+
+internal void
+ac_job_pool_run(AC_JobPool *pool, AC_Priority priority, AC_RequestBatch *deferred)
+{
+  //- do wide jobs, one at a time across all lanes. before each, check for
+  // newly submitted higher priority work -> preempt
+  ProfScope("wide requests (p%I64u)", (U64)priority) for(;;)
+  {
+    lane_sync();
+    U64 job_idx = pool->wide_take_idx;
+    B32 preempted = 0;
+    if(lane_idx() == 0)
+    {
+      preempted = ac_requests_pending_above_priority(priority);
+      pool->preempted = preempted;
+    }
+    lane_sync_u64(&preempted, 0);
+    if(preempted || job_idx >= pool->wide_count)
+    {
+      break;
+    }
+    AC_Request *r = &pool->wide[job_idx];
+    
+    // rjf: compute val
+    B32 retry = 0;
+    U64 gen = r->gen;
+    ac_thread_artifact_size = 0;
+    AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen);
+    U64 size = ac_thread_artifact_size;
+    
+    // retry? -> defer; otherwise write value into cache
+    if(lane_idx() == 0)
+    {
+      if(retry)
+      {
+        ac_request_batch_push(deferred, r, 1);
+      }
+      else
+      {
+        ac_request_complete(r, val, gen, size);
+      }
+      pool->wide_take_idx += 1;
+    }
+  }
+  lane_sync();
+  
+  //- do thin jobs; each lane takes from its own deque first, then steals
+  // from the others. at each job boundary, check for newly submitted higher
+  // priority work -> preempt
+  if(!pool->preempted) ProfScope("thin requests (p%I64u)", (U64)priority)
+  {
+    U64 lanes_count = lane_count();
+    for(;;)
+    {
+      // preempted? -> exit
+      if(ins_atomic_u64_eval(&pool->preempted))
+      {
+        break;
+      }
+      if(ac_requests_pending_above_priority(priority))
+      {
+        ins_atomic_u64_eval_assign(&pool->preempted, 1);
+        break;
+      }
+      
+      // take next job
+      U64 job_idx = 0;
+      B32 got_job = ac_job_deque_take(&pool->lane_deques[lane_idx()], 0, &job_idx);
+      for(U64 steal_off = 1; !got_job && steal_off < lanes_count; steal_off += 1)
+      {
+        got_job = ac_job_deque_take(&pool->lane_deques[(lane_idx() + steal_off)%lanes_count], 1, &job_idx);
+      }
+      if(!got_job)
+      {
+        break;
+      }
+      AC_Request *r = &pool->thin[job_idx];
+      
+      // rjf: push thin lane ctx
+      U64 thin_lane_ctx_broadcast_memory = 0;
+      LaneCtx thin_lane_ctx = {0, 1, {0}, &thin_lane_ctx_broadcast_memory};
+      LaneCtx lane_ctx_restore = lane_ctx(thin_lane_ctx);
+      
+      // rjf: compute val
+      B32 retry = 0;
+      U64 gen = r->gen;
+      ac_thread_artifact_size = 0;
+      AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen);
+      U64 size = ac_thread_artifact_size;
+      
+      // rjf: restore wide lane ctx
+      lane_ctx(lane_ctx_restore);
+      
+      // retry? -> defer; otherwise write value into cache
+      if(retry)
+      {
+        ac_request_batch_push(deferred, r, 0);
+      }
+      else
+      {
+        ac_request_complete(r, val, gen, size);
+      }
+    }
+  }
+  lane_sync();
+}
+
+internal void
+ac_request_complete(AC_Request *request, AC_Artifact val, U64 gen, U64 size)
+{
+  //- rjf: create function -> cache
+  AC_Cache *cache = 0;
+  {
+    U64 cache_hash = u64_hash_from_str8(str8_struct(&request->create));
+    U64 cache_slot_idx = cache_hash%ac_shared->cache_slots_count;
+    Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
+    RWMutexScope(cache_stripe->rw_mutex, 0)
+    {
+      for(AC_Cache *c = ac_shared->cache_slots[cache_slot_idx]; c != 0; c = c->next)
+      {
+        if(c->create == request->create)
+        {
+          cache = c;
+          break;
+        }
+      }
+    }
+  }
+  
+  //- write value into cache
+  {
+    U64 hash = u64_hash_from_str8(request->key);
+    U64 slot_idx = hash%cache->slots_count;
+    AC_Slot *slot = &cache->slots[slot_idx];
+    Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
+    RWMutexScope(stripe->rw_mutex, 1)
+    {
+      for(AC_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(str8_match(n->key, request->key, 0))
+        {
+          ins_atomic_u64_add_eval(&ac_shared->stats.artifact_bytes, size - n->size);
+          ins_atomic_u64_add_eval(&cache_memory_total, size - n->size);
+          n->size = size;
+          n->last_completed_gen = gen;
+          n->val = val;
+          ins_atomic_u64_dec_eval(&n->working_count);
+          ins_atomic_u64_inc_eval(&n->completion_count);
+        }
+      }
+    }
+    cond_var_broadcast(stripe->cv);
+  }
+}
+
+internal void
+ac_async_do_requests(AC_Priority lowest_priority)
+{
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- set up job pools (shared across lanes) & deferred requests (per-lane)
+  AC_JobPool *pools = 0;
+  if(lane_idx() == 0)
+  {
+    pools = push_array(scratch.arena, AC_JobPool, AC_Priority_COUNT);
+  }
+  lane_sync_u64(&pools, 0);
+  AC_RequestBatch deferred[AC_Priority_COUNT] = {0};
+  for EachElement(idx, deferred)
+  {
+    deferred[idx].arena = scratch.arena;
+  }
+  
+  //- loop: pull newly submitted requests into the pools, then run the
+  // highest priority pool which has work, until it is either done or preempted
+  // by newly submitted higher priority requests. retried requests are held
+  // until the end, so they do not spin within this loop.
+  for(;;)
+  {
+    AC_Priority priority = AC_Priority_COUNT;
+    if(lane_idx() == 0)
+    {
+      for(AC_Priority p = (AC_Priority)0; p <= lowest_priority; p = (AC_Priority)(p+1))
+      {
+        B32 has_work = ac_job_pool_fill(scratch.arena, &pools[p], &ac_shared->req_batches[p]);
+        if(has_work && priority == AC_Priority_COUNT)
+        {
+          priority = p;
+        }
+      }
+    }
+    lane_sync_u64(&priority, 0);
+    if(priority == AC_Priority_COUNT)
+    {
+      break;
+    }
+    ac_job_pool_run(&pools[priority], priority, &deferred[priority]);
+  }
+  
+  //- resubmit retried requests for the next tick
+  for EachElement(idx, deferred)
+  {
+    if(deferred[idx].wide_count != 0 || deferred[idx].thin_count != 0)
+    {
+      AC_RequestBatch *batch = &ac_shared->req_batches[idx];
+      MutexScope(batch->mutex)
+      {
+        for EachNode(n, AC_RequestNode, deferred[idx].first_wide)
+        {
+          ac_request_batch_push(batch, &n->v, 1);
+        }
+        for EachNode(n, AC_RequestNode, deferred[idx].first_thin)
+        {
+          ac_request_batch_push(batch, &n->v, 0);
+        }
+      }
+      ins_atomic_u32_eval_assign(&async_loop_again, 1);
+    }
+  }
+  lane_sync();
+  scratch_end(scratch);
+}
+
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
 
@@ -216,8 +583,13 @@ ac_async_tick(void)
   //////////////////////////////
   //- rjf: enable cancellation scanning
   //
-  if(lane_idx() == 0)
+  // NOTE: the cancel thread mutex is only ever taken & dropped by lane 0, so
+  // that it is always released by its owner - dropping a mutex owned by
+  // another thread fails silently with pthreads & leaves it locked forever.
+  //
+  if(lane_idx() == 0 && ac_shared->cancel_thread_mutex_is_taken)
   {
+    ac_shared->cancel_thread_mutex_is_taken = 0;
     mutex_drop(ac_shared->cancel_thread_mutex);
   }
   
@@ -256,6 +628,9 @@ ac_async_tick(void)
                     DLLRemove(slot->first, slot->last, n);
                     n->next = (AC_Node *)stripe->free;
                     stripe->free = n;
+                    ins_atomic_u64_dec_eval(&ac_shared->stats.artifact_count);
+                    ins_atomic_u64_add_eval(&ac_shared->stats.artifact_bytes, -(S64)n->size);
+                    ins_atomic_u64_add_eval(&cache_memory_total, -(S64)n->size);
                     if(cache->destroy)
                     {
                       cache->destroy(n->val);
@@ -273,317 +648,92 @@ ac_async_tick(void)
       }
     }
   }
-  
-  //////////////////////////////
-  //- rjf: gather requests
-  //
-  typedef struct RequestBatchTask RequestBatchTask;
-  struct RequestBatchTask
-  {
-    AC_Request *wide;
-    U64 wide_count;
-    AC_Request *thin;
-    U64 thin_count;
-  };
-  RequestBatchTask *tasks = 0;
-  U64 tasks_count = 0;
-  if(lane_idx() == 0)
-  {
-    tasks_count = 2;
-    tasks = push_array(scratch.arena, RequestBatchTask, tasks_count);
-    for EachElement(task_idx, ac_shared->req_batches)
-    {
-      AC_RequestBatch *batch = &ac_shared->req_batches[task_idx];
-      MutexScope(batch->mutex)
-      {
-        tasks[task_idx].wide_count = batch->wide_count;
-        tasks[task_idx].thin_count = batch->thin_count;
-        tasks[task_idx].wide = push_array(scratch.arena, AC_Request, tasks[task_idx].wide_count);
-        tasks[task_idx].thin = push_array(scratch.arena, AC_Request, tasks[task_idx].thin_count);
-        {
-          U64 idx = 0;
-          for EachNode(n, AC_RequestNode, batch->first_wide)
-          {
-            MemoryCopyStruct(&tasks[task_idx].wide[idx], &n->v);
-            tasks[task_idx].wide[idx].key = str8_copy(scratch.arena, tasks[task_idx].wide[idx].key);
-            idx += 1;
-          }
-        }
-        {
-          U64 idx = 0;
-          for EachNode(n, AC_RequestNode, batch->first_thin)
-          {
-            MemoryCopyStruct(&tasks[task_idx].thin[idx], &n->v);
-            tasks[task_idx].thin[idx].key = str8_copy(scratch.arena, tasks[task_idx].thin[idx].key);
-            idx += 1;
-          }
-        }
-        arena_clear(batch->arena);
-        batch->first_wide = batch->last_wide = batch->first_thin = batch->last_thin = 0;
-        batch->wide_count = batch->thin_count = 0;
-      }
-    }
-  }
-  lane_sync_u64(&tasks, 0);
-  lane_sync_u64(&tasks_count, 0);
   lane_sync();
   
   //////////////////////////////
-  //- rjf: do all requests
+  //- over memory budget -> evict unused artifacts before their expiry, in
+  // proportion to this cache's share of the budget; larger & older first
   //
-  for EachIndex(task_idx, tasks_count)
+  if(lane_idx() == 0 && ins_atomic_u64_eval(&cache_memory_total) > cache_memory_budget) ProfScope("evict artifacts over budget")
   {
-    lane_sync();
-    RequestBatchTask *task = &tasks[task_idx];
-    
-    //- rjf: set up cancellation signal
-    U64 cancelled = 0;
-    U64 *cancelled_ptr = 0;
-    if(lane_idx() == 0)
-    {
-      cancelled_ptr = &cancelled;
-    }
-    lane_sync_u64(&cancelled_ptr, 0);
+    U64 global_total = ins_atomic_u64_eval(&cache_memory_total);
+    U64 local_total = ins_atomic_u64_eval(&ac_shared->stats.artifact_bytes);
+    U64 evict_target = (U64)((F64)(global_total - cache_memory_budget) * ((F64)local_total / (F64)global_total));
     
-    //- rjf: do all wide requests for this priority
-    U64 done_wide_count = 0;
-    ProfScope("wide requests (p%I64u)", task_idx)
+    //- gather candidates
+    U64 now_us = os_now_microseconds();
+    U64 candidates_count = 0;
+    U64 candidates_cap = ins_atomic_u64_eval(&ac_shared->stats.artifact_count);
+    AC_EvictCandidate *candidates = push_array_no_zero(scratch.arena, AC_EvictCandidate, candidates_cap);
+    for EachIndex(cache_slot_idx, ac_shared->cache_slots_count)
     {
-      for EachIndex(idx, task->wide_count)
+      Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
+      RWMutexScope(cache_stripe->rw_mutex, 0)
       {
-        lane_sync();
-        AC_Request *r = &task->wide[idx];
-        
-        // rjf: any new higher priority tasks? -> cancel
-        if(lane_idx() == 0)
-        {
-          if(task_idx == 1 && idx != 0 && ins_atomic_u32_eval(&async_loop_again_high_priority))
-          {
-            ins_atomic_u64_eval_assign(cancelled_ptr, 1);
-          }
-        }
-        lane_sync();
-        
-        // rjf: cancelled? -> exit
-        if(ins_atomic_u32_eval(cancelled_ptr))
-        {
-          break;
-        }
-        
-        // rjf: compute val
-        B32 retry = 0;
-        U64 gen = r->gen;
-        AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen);
-        
-        // rjf: retry? -> resubmit request
-        if(retry && lane_idx() == 0)
+        for EachNode(cache, AC_Cache, ac_shared->cache_slots[cache_slot_idx])
         {
-          AC_RequestBatch *batch = &ac_shared->req_batches[task_idx];
-          MutexScope(batch->mutex)
+          for EachIndex(slot_idx, cache->slots_count)
           {
-            AC_RequestNode *n = push_array(batch->arena, AC_RequestNode, 1);
-            SLLQueuePush(batch->first_wide, batch->last_wide, n);
-            batch->wide_count += 1;
-            MemoryCopyStruct(&n->v, r);
-            n->v.key = str8_copy(batch->arena, n->v.key);
-          }
-          ins_atomic_u32_eval_assign(&async_loop_again, 1);
-        }
-        
-        // rjf: create function -> cache
-        AC_Cache *cache = 0;
-        if(!retry && lane_idx() == 0)
-        {
-          U64 cache_hash = u64_hash_from_str8(str8_struct(&r->create));
-          U64 cache_slot_idx = cache_hash%ac_shared->cache_slots_count;
-          Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
-          RWMutexScope(cache_stripe->rw_mutex, 0)
-          {
-            for(AC_Cache *c = ac_shared->cache_slots[cache_slot_idx]; c != 0; c = c->next)
+            AC_Slot *slot = &cache->slots[slot_idx];
+            Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
+            RWMutexScope(stripe->rw_mutex, 0)
             {
-              if(c->create == r->create)
+              for(AC_Node *n = slot->first; n != 0 && candidates_count < candidates_cap; n = n->next)
               {
-                cache = c;
-                break;
-              }
-            }
-          }
-        }
-        
-        // rjf: write value into cache
-        if(!retry && lane_idx() == 0)
-        {
-          U64 hash = u64_hash_from_str8(r->key);
-          U64 slot_idx = hash%cache->slots_count;
-          AC_Slot *slot = &cache->slots[slot_idx];
-          Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
-          RWMutexScope(stripe->rw_mutex, 1)
-          {
-            for(AC_Node *n = slot->first; n != 0; n = n->next)
-            {
-              if(str8_match(n->key, r->key, 0))
-              {
-                n->last_completed_gen = gen;
-                n->val = val;
-                ins_atomic_u64_dec_eval(&n->working_count);
-                ins_atomic_u64_inc_eval(&n->completion_count);
+                if(n->size != 0 &&
+                   ins_atomic_u64_eval(&n->working_count) == 0 &&
+                   access_pt_is_expired(&n->access_pt, .time = 0))
+                {
+                  U64 age_us = now_us - Min(now_us, ins_atomic_u64_eval(&n->access_pt.last_time_touched_us));
+                  candidates[candidates_count].cache = cache;
+                  candidates[candidates_count].node = n;
+                  candidates[candidates_count].slot_idx = slot_idx;
+                  candidates[candidates_count].score = (F64)n->size * (F64)(age_us + 1);
+                  candidates_count += 1;
+                }
               }
             }
           }
-          cond_var_broadcast(stripe->cv);
         }
-        
-        // rjf: increment count
-        lane_sync();
-        done_wide_count += 1;
       }
     }
-    lane_sync();
+    quick_sort(candidates, candidates_count, sizeof(candidates[0]), ac_evict_candidate_qsort_compare__score_descending);
     
-    //- rjf: do all thin requests for this priority
-    U64 done_thin_count = 0;
-    ProfScope("thin requests (p%I64u)", task_idx)
+    //- evict until under target, re-checking each candidate under the
+    // write lock, since it may have been requested again since
+    U64 evicted_size = 0;
+    for(U64 idx = 0; idx < candidates_count && evicted_size < evict_target; idx += 1)
     {
-      U64 req_take_counter = 0;
-      U64 *req_take_counter_ptr = 0;
-      if(lane_idx() == 0)
-      {
-        req_take_counter_ptr = &req_take_counter;
-      }
-      lane_sync_u64(&req_take_counter_ptr, 0);
-      for(;;)
+      AC_EvictCandidate *c = &candidates[idx];
+      AC_Slot *slot = &c->cache->slots[c->slot_idx];
+      Stripe *stripe = stripe_from_slot_idx(&c->cache->stripes, c->slot_idx);
+      RWMutexScope(stripe->rw_mutex, 1)
       {
-        // rjf: any new higher priority tasks? -> cancel
-        if(task_idx == 1 && ins_atomic_u64_eval(req_take_counter_ptr) >= task->thin_count/2 &&
-           ins_atomic_u32_eval(&async_loop_again_high_priority))
+        AC_Node *n = c->node;
+        if(n->working_count == 0 && access_pt_is_expired(&n->access_pt, .time = 0))
         {
-          ins_atomic_u64_eval_assign(cancelled_ptr, 1);
-        }
-        
-        // rjf: cancelled? -> exit
-        if(ins_atomic_u64_eval(cancelled_ptr))
-        {
-          break;
-        }
-        
-        // rjf: take next task
-        U64 req_idx = ins_atomic_u64_inc_eval(req_take_counter_ptr) - 1;
-        if(req_idx >= task->thin_count) { break; }
-        AC_Request *r = &task->thin[req_idx];
-        
-        // rjf: push thin lane ctx
-        U64 thin_lane_ctx_broadcast_memory = 0;
-        LaneCtx thin_lane_ctx = {0, 1, {0}, &thin_lane_ctx_broadcast_memory};
-        LaneCtx lane_ctx_restore = lane_ctx(thin_lane_ctx);
-        
-        // rjf: compute val
-        B32 retry = 0;
-        U64 gen = r->gen;
-        AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen);
-        
-        // rjf: restore wide lane ctx
-        lane_ctx(lane_ctx_restore);
-        
-        // rjf: retry? -> resubmit request
-        if(retry)
-        {
-          AC_RequestBatch *batch = &ac_shared->req_batches[task_idx];
-          MutexScope(batch->mutex)
-          {
-            AC_RequestNode *n = push_array(batch->arena, AC_RequestNode, 1);
-            SLLQueuePush(batch->first_thin, batch->last_thin, n);
-            batch->thin_count += 1;
-            MemoryCopyStruct(&n->v, r);
-            n->v.key = str8_copy(batch->arena, n->v.key);
-          }
-          ins_atomic_u32_eval_assign(&async_loop_again, 1);
-        }
-        
-        // rjf: create function -> cache
-        AC_Cache *cache = 0;
-        if(!retry)
-        {
-          U64 cache_hash = u64_hash_from_str8(str8_struct(&r->create));
-          U64 cache_slot_idx = cache_hash%ac_shared->cache_slots_count;
-          Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
-          RWMutexScope(cache_stripe->rw_mutex, 0)
-          {
-            for(AC_Cache *c = ac_shared->cache_slots[cache_slot_idx]; c != 0; c = c->next)
-            {
-              if(c->create == r->create)
-              {
-                cache = c;
-                break;
-              }
-            }
-          }
-        }
-        
-        // rjf: write value into cache
-        if(!retry)
-        {
-          U64 hash = u64_hash_from_str8(r->key);
-          U64 slot_idx = hash%cache->slots_count;
-          AC_Slot *slot = &cache->slots[slot_idx];
-          Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
-          RWMutexScope(stripe->rw_mutex, 1)
+          DLLRemove(slot->first, slot->last, n);
+          n->next = (AC_Node *)stripe->free;
+          stripe->free = n;
+          evicted_size += n->size;
+          ins_atomic_u64_dec_eval(&ac_shared->stats.artifact_count);
+          ins_atomic_u64_add_eval(&ac_shared->stats.artifact_bytes, -(S64)n->size);
+          ins_atomic_u64_add_eval(&cache_memory_total, -(S64)n->size);
+          ins_atomic_u64_inc_eval(&ac_shared->stats.budget_evicted_artifact_count);
+          ins_atomic_u64_add_eval(&ac_shared->stats.budget_evicted_artifact_bytes, n->size);
+          if(c->cache->destroy)
           {
-            for(AC_Node *n = slot->first; n != 0; n = n->next)
-            {
-              if(str8_match(n->key, r->key, 0))
-              {
-                n->last_completed_gen = gen;
-                n->val = val;
-                ins_atomic_u64_dec_eval(&n->working_count);
-                ins_atomic_u64_inc_eval(&n->completion_count);
-              }
-            }
+            c->cache->destroy(n->val);
           }
-          cond_var_broadcast(stripe->cv);
         }
       }
-      lane_sync();
-      done_thin_count = ins_atomic_u64_eval(req_take_counter_ptr);
-      lane_sync();
     }
-    
-    //- rjf: cancelled early, unfinished tasks? -> defer to next tick
-    if(lane_idx() == 0 && task_idx > 0)
-    {
-      B32 need_another_try = (done_wide_count < task->wide_count || done_thin_count < task->thin_count);
-      AC_RequestBatch *batch = &ac_shared->req_batches[task_idx];
-      MutexScope(batch->mutex)
-      {
-        // rjf: push leftover wide tasks
-        for(U64 idx = done_wide_count; idx < task->wide_count; idx += 1)
-        {
-          AC_Request *r = &task->wide[idx];
-          AC_RequestNode *n = push_array(batch->arena, AC_RequestNode, 1);
-          SLLQueuePush(batch->first_wide, batch->last_wide, n);
-          batch->wide_count += 1;
-          MemoryCopyStruct(&n->v, r);
-          n->v.key = str8_copy(batch->arena, n->v.key);
-        }
-        
-        // rjf: push leftover thin tasks
-        for(U64 idx = done_thin_count; idx < task->thin_count; idx += 1)
-        {
-          AC_Request *r = &task->thin[idx];
-          AC_RequestNode *n = push_array(batch->arena, AC_RequestNode, 1);
-          SLLQueuePush(batch->first_thin, batch->last_thin, n);
-          batch->thin_count += 1;
-          MemoryCopyStruct(&n->v, r);
-          n->v.key = str8_copy(batch->arena, n->v.key);
-        }
-      }
-      if(need_another_try)
-      {
-        ins_atomic_u32_eval_assign(&async_loop_again, 1);
-      }
-    }
-    lane_sync();
   }
-  lane_sync();
+  
+  //////////////////////////////
+  //- rjf: do all requests
+  //
+  ac_async_do_requests(AC_Priority_Low);
   
   //////////////////////////////
   //- rjf: disable cancellation scanning
@@ -591,10 +741,38 @@ ac_async_tick(void)
   if(lane_idx() == 0)
   {
     mutex_take(ac_shared->cancel_thread_mutex);
+    ac_shared->cancel_thread_mutex_is_taken = 1;
   }
   scratch_end(scratch);
 }
 
+internal void
+ac_async_high_priority_tick(void)
+{
+  B32 has_work = 0;
+  if(lane_idx() == 0)
+  {
+    has_work = ac_requests_pending_above_priority(AC_Priority_Low);
+  }
+  lane_sync_u64(&has_work, 0);
+  if(has_work)
+  {
+    B32 cancel_thread_mutex_was_taken = 0;
+    if(lane_idx() == 0 && ac_shared->cancel_thread_mutex_is_taken)
+    {
+      cancel_thread_mutex_was_taken = 1;
+      ac_shared->cancel_thread_mutex_is_taken = 0;
+      mutex_drop(ac_shared->cancel_thread_mutex);
+    }
+    ac_async_do_requests(AC_Priority_High);
+    if(lane_idx() == 0 && cancel_thread_mutex_was_taken)
+    {
+      mutex_take(ac_shared->cancel_thread_mutex);
+      ac_shared->cancel_thread_mutex_is_taken = 1;
+    }
+  }
+}
+
 ////////////////////////////////
 //~ rjf: Cancel Thread
 
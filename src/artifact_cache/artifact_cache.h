@@ -25,6 +25,7 @@ typedef enum AC_FlagsEnum
   AC_Flag_WaitForFresh = (1<<0),
   AC_Flag_HighPriority = (1<<1),
   AC_Flag_Wide = (1<<2),
+  AC_Flag_NoRequest = (1<<3), // only return an already-computed artifact; never request one
 }
 AC_FlagsEnum;
 
@@ -77,7 +78,7 @@ struct AC_Node
   U64 completion_count;
   U64 evict_threshold_us;
   B32 cancelled;
-  U64 _unused_;
+  U64 size;
 };
 
 typedef struct AC_Slot AC_Slot;
@@ -101,6 +102,24 @@ struct AC_Cache
   StripeArray stripes;
 };
 
+typedef struct AC_EvictCandidate AC_EvictCandidate;
+struct AC_EvictCandidate
+{
+  AC_Cache *cache;
+  AC_Node *node;
+  U64 slot_idx;
+  F64 score;
+};
+
+typedef struct AC_Stats AC_Stats;
+struct AC_Stats
+{
+  U64 artifact_count;
+  U64 artifact_bytes;
+  U64 budget_evicted_artifact_count;
+  U64 budget_evicted_artifact_bytes;
+};
+
 typedef struct AC_RequestBatch AC_RequestBatch;
 struct AC_RequestBatch
 {
@@ -114,6 +133,39 @@ struct AC_RequestBatch
   U64 thin_count;
 };
 
+////////////////////////////////
+//~ Scheduler Types
+
+typedef enum AC_Priority
+{
+  AC_Priority_High,
+  AC_Priority_Low,
+  AC_Priority_COUNT
+}
+AC_Priority;
+
+typedef struct AC_JobDeque AC_JobDeque;
+struct AC_JobDeque
+{
+  // [lo, hi) range of a pool's thin jobs, packed as (lo<<32)|hi, so the
+  // owning lane (taking from hi) & stealing lanes (taking from lo) can both
+  // claim a job with a single compare-exchange
+  U64 range;
+  U64 _pad_[7];
+};
+
+typedef struct AC_JobPool AC_JobPool;
+struct AC_JobPool
+{
+  AC_Request *wide;
+  U64 wide_count;
+  U64 wide_take_idx;
+  AC_Request *thin;
+  U64 thin_count;
+  AC_JobDeque *lane_deques;
+  U64 preempted;
+};
+
 typedef struct AC_Shared AC_Shared;
 struct AC_Shared
 {
@@ -125,17 +177,22 @@ struct AC_Shared
   StripeArray cache_stripes;
   
   // rjf: requests
-  AC_RequestBatch req_batches[2]; // 0: high priority, 1: low priority
+  AC_RequestBatch req_batches[AC_Priority_COUNT];
+  
+  // memory accounting
+  AC_Stats stats;
   
   // rjf: cancel thread
   Thread cancel_thread;
   Mutex cancel_thread_mutex;
+  B32 cancel_thread_mutex_is_taken;
 };
 
 ////////////////////////////////
 //~ rjf: Globals
 
 global AC_Shared *ac_shared = 0;
+thread_static U64 ac_thread_artifact_size = 0;
 
 ////////////////////////////////
 //~ rjf: Layer Initialization
@@ -148,10 +205,35 @@ internal void ac_init(void);
 internal AC_Artifact ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U64 endt_us);
 #define ac_artifact_from_key(access, key, create_fn, destroy_fn, endt_us, ...) ac_artifact_from_key_((access), (key), &(AC_ArtifactParams){.create = (create_fn), .destroy = (destroy_fn), .evict_threshold_us = (2000000), __VA_ARGS__}, (endt_us))
 
+////////////////////////////////
+//~ Memory Budget
+
+// NOTE: create functions report the number of bytes their artifact owns
+// (arenas, GPU resources), which counts it against the global cache memory
+// budget. data submitted to the content cache is already counted there, so
+// artifacts which only hold a content key must not report it again. wide
+// create functions must report from lane 0. artifacts which do not report
+// count as zero bytes and are never evicted for budget reasons.
+internal void ac_report_artifact_size(U64 size);
+internal AC_Stats ac_stats(void);
+internal int ac_evict_candidate_qsort_compare__score_descending(AC_EvictCandidate *a, AC_EvictCandidate *b);
+
+////////////////////////////////
+//~ Scheduler
+
+internal void ac_request_batch_push(AC_RequestBatch *batch, AC_Request *request, B32 wide);
+internal B32 ac_requests_pending_above_priority(AC_Priority priority);
+internal B32 ac_job_deque_take(AC_JobDeque *deque, B32 steal, U64 *idx_out);
+internal B32 ac_job_pool_fill(Arena *arena, AC_JobPool *pool, AC_RequestBatch *batch);
+internal void ac_job_pool_run(AC_JobPool *pool, AC_Priority priority, AC_RequestBatch *deferred);
+internal void ac_request_complete(AC_Request *request, AC_Artifact val, U64 gen, U64 size);
+internal void ac_async_do_requests(AC_Priority lowest_priority);
+
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
 
 internal void ac_async_tick(void);
+internal void ac_async_high_priority_tick(void);
 
 ////////////////////////////////
 //~ rjf: Cancel Thread
@@ -7,9 +7,10 @@ global CondVar async_tick_start_cond_var = {0};
 global Mutex async_tick_start_mutex = {0};
 global Mutex async_tick_stop_mutex = {0};
 global B32 async_loop_again = 0;
-global B32 async_loop_again_high_priority = 0;
 global B32 global_async_exit = 0;
 thread_static B32 is_async_thread = 0;
+global U64 cache_memory_budget = GB(2);
+global U64 cache_memory_total = 0;
 
 internal void
 main_thread_base_entry_point(int arguments_count, char **arguments)
@@ -53,6 +54,15 @@ main_thread_base_entry_point(int arguments_count, char **arguments)
     ProfMsg(BUILD_TITLE);
   }
   
+  //- set up memory budget, shared by all caches which are evicted by async ticks
+  {
+    U64 cache_memory_budget_mb = 0;
+    if(try_u64_from_str8_c_rules(cmd_line_string(&cmdline, str8_lit("cache_budget_mb")), &cache_memory_budget_mb))
+    {
+      cache_memory_budget = MB(cache_memory_budget_mb);
+    }
+  }
+  
   //- rjf: initialize all included layers
 #if defined(ARTIFACT_CACHE_H) && !defined(AC_INIT_MANUAL)
   ac_init();
@@ -66,6 +76,9 @@ main_thread_base_entry_point(int arguments_count, char **arguments)
 #if defined(FILE_STREAM_H) && !defined(FS_INIT_MANUAL)
   fs_init();
 #endif
+#if defined(TEXT_H) && !defined(TXT_INIT_MANUAL)
+  txt_init();
+#endif
 #if defined(MUTABLE_TEXT_H) && !defined(MTX_INIT_MANUAL)
   mtx_init();
 #endif
@@ -197,11 +210,13 @@ async_thread_entry_point(void *params)
         MutexScope(async_tick_start_mutex) cond_var_wait(async_tick_start_cond_var, async_tick_start_mutex, os_now_microseconds()+1000000);
       }
       ins_atomic_u32_eval_assign(&async_loop_again, 0);
-      ins_atomic_u32_eval_assign(&async_loop_again_high_priority, 0);
     }
     lane_sync();
     
-    // rjf: do all ticks for all layers
+    // do all ticks for all layers. the artifact cache schedules its own
+    // jobs by priority, but it can only preempt at job boundaries - so between
+    // the other layers' ticks, let any newly submitted high priority artifact
+    // requests run, rather than have them wait for the next full tick
     ProfScope("async tick")
     {
 #if defined(ARTIFACT_CACHE_H)
@@ -210,9 +225,15 @@ async_thread_entry_point(void *params)
 #if defined(CONTENT_H)
       c_async_tick();
 #endif
+#if defined(ARTIFACT_CACHE_H)
+      ac_async_high_priority_tick();
+#endif
 #if defined(FILE_STREAM_H)
       fs_async_tick();
 #endif
+#if defined(ARTIFACT_CACHE_H)
+      ac_async_high_priority_tick();
+#endif
 #if defined(DBG_INFO_H)
       di_async_tick();
 #endif
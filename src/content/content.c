@@ -212,6 +212,9 @@ c_submit_data(C_Key key, Arena **data_arena, String8 data)
       }
       node->data = data;
       DLLPushBack(slot->first, slot->last, node);
+      ins_atomic_u64_inc_eval(&c_shared->stats.blob_count);
+      ins_atomic_u64_add_eval(&c_shared->stats.blob_bytes, data.size);
+      ins_atomic_u64_add_eval(&cache_memory_total, data.size);
     }
     
     // rjf: bump key ref count
@@ -465,6 +468,27 @@ c_data_from_hash(Access *access, U128 hash)
   return result;
 }
 
+////////////////////////////////
+//~ Memory Budget
+
+internal C_Stats
+c_stats(void)
+{
+  C_Stats stats = {0};
+  stats.blob_count                = ins_atomic_u64_eval(&c_shared->stats.blob_count);
+  stats.blob_bytes                = ins_atomic_u64_eval(&c_shared->stats.blob_bytes);
+  stats.budget_evicted_blob_count = ins_atomic_u64_eval(&c_shared->stats.budget_evicted_blob_count);
+  stats.budget_evicted_blob_bytes = ins_atomic_u64_eval(&c_shared->stats.budget_evicted_blob_bytes);
+  return stats;
+}
+
+internal int
+c_evict_candidate_qsort_compare__score_descending(C_EvictCandidate *a, C_EvictCandidate *b)
+{
+  int result = (a->score > b->score ? -1 : a->score < b->score ? +1 : 0);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
 
@@ -502,6 +526,9 @@ c_async_tick(void)
               {
                 DLLRemove(slot->first, slot->last, n);
                 SLLStackPush(c_shared->blob_stripes_free_nodes[stripe_idx], n);
+                ins_atomic_u64_dec_eval(&c_shared->stats.blob_count);
+                ins_atomic_u64_add_eval(&c_shared->stats.blob_bytes, -(S64)n->data.size);
+                ins_atomic_u64_add_eval(&cache_memory_total, -(S64)n->data.size);
                 if(n->arena != 0)
                 {
                   arena_release(n->arena);
@@ -517,6 +544,79 @@ c_async_tick(void)
       }
     }
   }
+  lane_sync();
+  
+  //- over memory budget -> evict unreferenced blobs before their expiry,
+  // in proportion to this cache's share of the budget. larger & older blobs
+  // go first, since each of those frees the most for the least likely reuse.
+  if(lane_idx() == 0 && ins_atomic_u64_eval(&cache_memory_total) > cache_memory_budget) ProfScope("evict blobs over budget")
+  {
+    Temp scratch = scratch_begin(0, 0);
+    U64 global_total = ins_atomic_u64_eval(&cache_memory_total);
+    U64 local_total = ins_atomic_u64_eval(&c_shared->stats.blob_bytes);
+    U64 evict_target = (U64)((F64)(global_total - cache_memory_budget) * ((F64)local_total / (F64)global_total));
+    
+    //- gather candidates
+    U64 now_us = os_now_microseconds();
+    U64 candidates_count = 0;
+    U64 candidates_cap = ins_atomic_u64_eval(&c_shared->stats.blob_count);
+    C_EvictCandidate *candidates = push_array_no_zero(scratch.arena, C_EvictCandidate, candidates_cap);
+    for EachIndex(slot_idx, c_shared->blob_slots_count)
+    {
+      U64 stripe_idx = slot_idx%c_shared->blob_stripes_count;
+      C_BlobSlot *slot = &c_shared->blob_slots[slot_idx];
+      C_Stripe *stripe = &c_shared->blob_stripes[stripe_idx];
+      RWMutexScope(stripe->rw_mutex, 0)
+      {
+        for(C_BlobNode *n = slot->first; n != 0 && candidates_count < candidates_cap; n = n->next)
+        {
+          if(ins_atomic_u64_eval(&n->key_ref_count) == 0 &&
+             ins_atomic_u64_eval(&n->downstream_ref_count) == 0 &&
+             access_pt_is_expired(&n->access_pt, .time = 0))
+          {
+            U64 age_us = now_us - Min(now_us, ins_atomic_u64_eval(&n->access_pt.last_time_touched_us));
+            candidates[candidates_count].node = n;
+            candidates[candidates_count].slot_idx = slot_idx;
+            candidates[candidates_count].score = (F64)n->data.size * (F64)(age_us + 1);
+            candidates_count += 1;
+          }
+        }
+      }
+    }
+    quick_sort(candidates, candidates_count, sizeof(candidates[0]), c_evict_candidate_qsort_compare__score_descending);
+    
+    //- evict until under target; candidates may have been picked up again
+    // since they were gathered, so re-check them under the write lock
+    U64 evicted_size = 0;
+    for(U64 idx = 0; idx < candidates_count && evicted_size < evict_target; idx += 1)
+    {
+      C_EvictCandidate *c = &candidates[idx];
+      U64 stripe_idx = c->slot_idx%c_shared->blob_stripes_count;
+      C_BlobSlot *slot = &c_shared->blob_slots[c->slot_idx];
+      C_Stripe *stripe = &c_shared->blob_stripes[stripe_idx];
+      RWMutexScope(stripe->rw_mutex, 1)
+      {
+        C_BlobNode *n = c->node;
+        if(n->key_ref_count == 0 && n->downstream_ref_count == 0 && access_pt_is_expired(&n->access_pt, .time = 0))
+        {
+          DLLRemove(slot->first, slot->last, n);
+          SLLStackPush(c_shared->blob_stripes_free_nodes[stripe_idx], n);
+          evicted_size += n->data.size;
+          ins_atomic_u64_dec_eval(&c_shared->stats.blob_count);
+          ins_atomic_u64_add_eval(&c_shared->stats.blob_bytes, -(S64)n->data.size);
+          ins_atomic_u64_add_eval(&cache_memory_total, -(S64)n->data.size);
+          ins_atomic_u64_inc_eval(&c_shared->stats.budget_evicted_blob_count);
+          ins_atomic_u64_add_eval(&c_shared->stats.budget_evicted_blob_bytes, n->data.size);
+          if(n->arena != 0)
+          {
+            arena_release(n->arena);
+          }
+        }
+      }
+    }
+    scratch_end(scratch);
+  }
+  lane_sync();
   
   ProfEnd();
 }
@@ -158,6 +158,26 @@ struct C_BlobSlot
   C_BlobNode *last;
 };
 
+////////////////////////////////
+//~ Memory Budget Types
+
+typedef struct C_EvictCandidate C_EvictCandidate;
+struct C_EvictCandidate
+{
+  C_BlobNode *node;
+  U64 slot_idx;
+  F64 score;
+};
+
+typedef struct C_Stats C_Stats;
+struct C_Stats
+{
+  U64 blob_count;
+  U64 blob_bytes;
+  U64 budget_evicted_blob_count;
+  U64 budget_evicted_blob_bytes;
+};
+
 ////////////////////////////////
 //~ rjf: Shared State
 
@@ -173,6 +193,9 @@ struct C_Shared
   C_Stripe *blob_stripes;
   C_BlobNode **blob_stripes_free_nodes;
   
+  // memory accounting
+  C_Stats stats;
+  
   // rjf: key cache
   U64 key_slots_count;
   U64 key_stripes_count;
@@ -235,6 +258,12 @@ internal void c_hash_downstream_dec(U128 hash);
 internal U128 c_hash_from_key(C_Key key, U64 rewind_count);
 internal String8 c_data_from_hash(Access *access, U128 hash);
 
+////////////////////////////////
+//~ Memory Budget
+
+internal C_Stats c_stats(void);
+internal int c_evict_candidate_qsort_compare__score_descending(C_EvictCandidate *a, C_EvictCandidate *b);
+
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
 
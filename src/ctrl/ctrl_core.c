@@ -1476,6 +1476,15 @@ ctrl_init(void)
     ctrl_state->module_image_info_cache.stripes[idx].arena = arena_alloc();
     ctrl_state->module_image_info_cache.stripes[idx].rw_mutex = rw_mutex_alloc();
   }
+  ctrl_state->mem_page_gen_cache.slots_count = 4096;
+  ctrl_state->mem_page_gen_cache.slots = push_array(arena, CTRL_MemPageGenSlot, ctrl_state->mem_page_gen_cache.slots_count);
+  ctrl_state->mem_page_gen_cache.stripes_count = os_get_system_info()->logical_processor_count;
+  ctrl_state->mem_page_gen_cache.stripes = push_array(arena, CTRL_MemPageGenStripe, ctrl_state->mem_page_gen_cache.stripes_count);
+  for(U64 idx = 0; idx < ctrl_state->mem_page_gen_cache.stripes_count; idx += 1)
+  {
+    ctrl_state->mem_page_gen_cache.stripes[idx].arena = arena_alloc();
+    ctrl_state->mem_page_gen_cache.stripes[idx].rw_mutex = rw_mutex_alloc();
+  }
   ctrl_state->u2c_ring_size = KB(64);
   ctrl_state->u2c_ring_base = push_array_no_zero(arena, U8, ctrl_state->u2c_ring_size);
   ctrl_state->u2c_ring_mutex = mutex_alloc();
@@ -1782,6 +1791,79 @@ ctrl_raddbg_data_from_module(Arena *arena, CTRL_Handle module_handle)
   return result;
 }
 
+internal B32
+ctrl_module_has_eh_frame(CTRL_Handle module_handle)
+{
+  B32 result = 0;
+  U64 hash = ctrl_hash_from_handle(module_handle);
+  U64 slot_idx = hash%ctrl_state->module_image_info_cache.slots_count;
+  U64 stripe_idx = slot_idx%ctrl_state->module_image_info_cache.stripes_count;
+  CTRL_ModuleImageInfoCacheSlot *slot = &ctrl_state->module_image_info_cache.slots[slot_idx];
+  CTRL_ModuleImageInfoCacheStripe *stripe = &ctrl_state->module_image_info_cache.stripes[stripe_idx];
+  MutexScopeR(stripe->rw_mutex) for(CTRL_ModuleImageInfoCacheNode *n = slot->first; n != 0; n = n->next)
+  {
+    if(ctrl_handle_match(n->module, module_handle))
+    {
+      result = (n->eh_frame.size != 0);
+      break;
+    }
+  }
+  return result;
+}
+
+internal B32
+ctrl_eh_frame_cfi_from_module_voff(Arena *arena, CTRL_Handle module_handle, U64 voff, EH_CIE *cie_out, EH_FDE *fde_out)
+{
+  B32 result = 0;
+  U64 hash = ctrl_hash_from_handle(module_handle);
+  U64 slot_idx = hash%ctrl_state->module_image_info_cache.slots_count;
+  U64 stripe_idx = slot_idx%ctrl_state->module_image_info_cache.stripes_count;
+  CTRL_ModuleImageInfoCacheSlot *slot = &ctrl_state->module_image_info_cache.slots[slot_idx];
+  CTRL_ModuleImageInfoCacheStripe *stripe = &ctrl_state->module_image_info_cache.stripes[stripe_idx];
+  MutexScopeR(stripe->rw_mutex) for(CTRL_ModuleImageInfoCacheNode *n = slot->first; n != 0; n = n->next)
+  {
+    if(ctrl_handle_match(n->module, module_handle))
+    {
+      // voff -> FDE offset; .eh_frame_hdr search table first, sorted FDE index otherwise
+      EH_PtrCtx ptr_ctx = {0};
+      ptr_ctx.raw_base_vaddr = n->eh_frame_voff;
+      U64 fde_off = max_U64;
+      if(n->eh_frame_hdr.fde_count != 0)
+      {
+        EH_PtrCtx hdr_ptr_ctx = {0};
+        hdr_ptr_ctx.raw_base_vaddr = n->eh_frame_hdr_voff;
+        hdr_ptr_ctx.data_vaddr = n->eh_frame_hdr_voff;
+        U64 fde_voff = eh_fde_vaddr_from_frame_hdr(&n->eh_frame_hdr, &hdr_ptr_ctx, voff);
+        if(fde_voff != max_U64 && n->eh_frame_voff <= fde_voff)
+        {
+          fde_off = fde_voff - n->eh_frame_voff;
+        }
+      }
+      else
+      {
+        fde_off = eh_fde_off_from_index(&n->eh_frame_fde_index, voff);
+      }
+      
+      // FDE offset -> parsed CIE & FDE; copy out programs, node may be evicted once we release the lock
+      EH_CIE cie = {0};
+      EH_FDE fde = {0};
+      if(fde_off != max_U64 &&
+         eh_parse_fde(n->eh_frame, fde_off, &ptr_ctx, &cie, &fde) &&
+         fde.pc_range.min <= voff && voff < fde.pc_range.max)
+      {
+        cie.aug_string = push_str8_copy(arena, cie.aug_string);
+        cie.insts = push_str8_copy(arena, cie.insts);
+        fde.insts = push_str8_copy(arena, fde.insts);
+        *cie_out = cie;
+        *fde_out = fde;
+        result = 1;
+      }
+      break;
+    }
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Unwinding Functions
 
@@ -2646,10 +2728,226 @@ ctrl_unwind_step__pe_x64(CTRL_Handle process_handle, CTRL_Handle module_handle,
   return result;
 }
 
+internal REGS_Reg64 *
+ctrl_unwind_reg_from_dw_reg__elf_x64(REGS_RegBlockX64 *regs, DW_Reg dw_reg)
+{
+  REGS_Reg64 *result = 0;
+  switch(dw_reg)
+  {
+    default:{}break;
+    case DW_RegX64_Rax:{result = &regs->rax;}break;
+    case DW_RegX64_Rdx:{result = &regs->rdx;}break;
+    case DW_RegX64_Rcx:{result = &regs->rcx;}break;
+    case DW_RegX64_Rbx:{result = &regs->rbx;}break;
+    case DW_RegX64_Rsi:{result = &regs->rsi;}break;
+    case DW_RegX64_Rdi:{result = &regs->rdi;}break;
+    case DW_RegX64_Rbp:{result = &regs->rbp;}break;
+    case DW_RegX64_Rsp:{result = &regs->rsp;}break;
+    case DW_RegX64_R8 :{result = &regs->r8 ;}break;
+    case DW_RegX64_R9 :{result = &regs->r9 ;}break;
+    case DW_RegX64_R10:{result = &regs->r10;}break;
+    case DW_RegX64_R11:{result = &regs->r11;}break;
+    case DW_RegX64_R12:{result = &regs->r12;}break;
+    case DW_RegX64_R13:{result = &regs->r13;}break;
+    case DW_RegX64_R14:{result = &regs->r14;}break;
+    case DW_RegX64_R15:{result = &regs->r15;}break;
+    case DW_RegX64_Rip:{result = &regs->rip;}break;
+  }
+  return result;
+}
+
+internal
+DW_REG_READ(ctrl_unwind_reg_read__elf_x64)
+{
+  CTRL_UnwindCFICtxX64 *ctx = (CTRL_UnwindCFICtxX64 *)ud;
+  DW_UnwindStatus result = DW_UnwindStatus_Fail;
+  REGS_Reg64 *reg = ctrl_unwind_reg_from_dw_reg__elf_x64(ctx->src_regs, reg_id);
+  if(reg != 0 && buffer_max <= sizeof(reg->u64))
+  {
+    MemoryCopy(buffer, &reg->u64, buffer_max);
+    result = DW_UnwindStatus_Ok;
+  }
+  return result;
+}
+
+internal
+DW_REG_WRITE(ctrl_unwind_reg_write__elf_x64)
+{
+  CTRL_UnwindCFICtxX64 *ctx = (CTRL_UnwindCFICtxX64 *)ud;
+  REGS_Reg64 *reg = ctrl_unwind_reg_from_dw_reg__elf_x64(ctx->dst_regs, reg_id);
+  if(reg != 0 && value_size <= sizeof(reg->u64))
+  {
+    reg->u64 = 0;
+    MemoryCopy(&reg->u64, value, value_size);
+  }
+  return DW_UnwindStatus_Ok;
+}
+
+internal
+DW_MEM_READ(ctrl_unwind_mem_read__elf_x64)
+{
+  CTRL_UnwindCFICtxX64 *ctx = (CTRL_UnwindCFICtxX64 *)ud;
+  DW_UnwindStatus result = DW_UnwindStatus_Ok;
+  B32 is_stale = 0;
+  if(!ctrl_process_memory_read(ctx->process, r1u64(addr, addr+size), &is_stale, buffer, ctx->endt_us) || is_stale)
+  {
+    ctx->is_stale = ctx->is_stale || is_stale;
+    ctx->is_read_bad = 1;
+    result = DW_UnwindStatus_Fail;
+  }
+  return result;
+}
+
+internal
+DW_DECODE_PTR(ctrl_unwind_decode_ptr__elf_x64)
+{
+  // NOTE: only reached by DW_CFA_set_loc, which compilers don't emit in .eh_frame;
+  // relative encodings would need the location of the operand, so only absolute ones are decoded
+  EH_CIE *cie = (EH_CIE *)ud;
+  U64 result = 0;
+  if((cie->aug.addr_encoding & EH_PtrEnc_ModifierMask) == 0)
+  {
+    EH_PtrCtx ptr_ctx = {0};
+    result = eh_read_ptr(data, 0, &ptr_ctx, cie->aug.addr_encoding, ptr_out);
+  }
+  return result;
+}
+
+internal CTRL_UnwindStepResult
+ctrl_unwind_step__elf_x64(CTRL_Handle process_handle, CTRL_Handle module_handle, U64 module_base_vaddr, REGS_RegBlockX64 *regs, B32 rip_is_return_address, U64 endt_us)
+{
+  B32 is_stale = 0;
+  B32 is_good = 1;
+  B32 did_cfi_unwind = 0;
+  B32 caller_rip_is_exact = 0;
+  Temp scratch = scratch_begin(0, 0);
+  
+  //////////////////////////////
+  //- rjf: unpack parameters
+  //
+  U64 rip_voff = regs->rip.u64 - module_base_vaddr;
+  
+  //////////////////////////////
+  //- rip_voff -> CIE & FDE
+  //
+  // NOTE: in caller frames, rip is a return address, which points past the
+  // call - that can be the start of the next row, or one past the end of the
+  // function, for calls to noreturn functions. so both the FDE & the CFA row
+  // are looked up for the call instruction, at the previous byte.
+  //
+  EH_CIE cie = {0};
+  EH_FDE fde = {0};
+  U64 lookup_voff = rip_voff;
+  if(rip_is_return_address && lookup_voff != 0)
+  {
+    lookup_voff -= 1;
+  }
+  B32 has_cfi = ctrl_eh_frame_cfi_from_module_voff(scratch.arena, module_handle, lookup_voff, &cie, &fde);
+  
+  //////////////////////////////
+  //- CIE & FDE -> run CFA program up to rip, apply register rules
+  //
+  if(has_cfi) ProfScope("CIE & FDE -> run CFA program up to rip, apply register rules")
+  {
+    DW_CIE dw_cie = {0};
+    dw_cie.insts             = cie.insts;
+    dw_cie.aug_string        = cie.aug_string;
+    dw_cie.code_align_factor = cie.code_align_factor;
+    dw_cie.data_align_factor = cie.data_align_factor;
+    dw_cie.ret_addr_reg      = cie.ret_addr_reg;
+    dw_cie.format            = DW_Format_32Bit;
+    dw_cie.version           = cie.version;
+    dw_cie.address_size      = 8;
+    DW_FDE dw_fde = {0};
+    dw_fde.format   = DW_Format_32Bit;
+    dw_fde.pc_range = fde.pc_range;
+    dw_fde.insts    = fde.insts;
+    DW_CFI_Unwind *uw = dw_cfi_unwind_init(scratch.arena, Arch_x64, &dw_cie, &dw_fde, ctrl_unwind_decode_ptr__elf_x64, &cie);
+    if(dw_cfi_unwind_to_pc(scratch.arena, uw, lookup_voff))
+    {
+      REGS_RegBlockX64 *src_regs = push_array(scratch.arena, REGS_RegBlockX64, 1);
+      REGS_RegBlockX64 *dst_regs = push_array(scratch.arena, REGS_RegBlockX64, 1);
+      MemoryCopyStruct(src_regs, regs);
+      MemoryCopyStruct(dst_regs, regs);
+      CTRL_UnwindCFICtxX64 ctx = {process_handle, endt_us, 0, 0, src_regs, dst_regs};
+      U64 cfa = 0;
+      DW_UnwindStatus status = dw_cfi_apply_register_rules(uw,
+                                                           ctrl_unwind_mem_read__elf_x64, &ctx,
+                                                           ctrl_unwind_reg_read__elf_x64, &ctx,
+                                                           ctrl_unwind_reg_write__elf_x64, &ctx,
+                                                           &cfa);
+      is_stale = ctx.is_stale;
+      if(status == DW_UnwindStatus_Ok)
+      {
+        // CFA is the stack pointer value at the call site
+        if(uw->row->regs[DW_RegX64_Rsp].rule == DW_CFI_RegisterRule_SameValue)
+        {
+          dst_regs->rsp.u64 = cfa;
+        }
+        
+        // return address column -> rip
+        if(cie.ret_addr_reg != DW_RegX64_Rip)
+        {
+          REGS_Reg64 *ret_addr_reg = ctrl_unwind_reg_from_dw_reg__elf_x64(dst_regs, cie.ret_addr_reg);
+          if(ret_addr_reg != 0)
+          {
+            dst_regs->rip.u64 = ret_addr_reg->u64;
+          }
+        }
+        
+        // signal trampolines restore the interrupted context, so the caller's
+        // rip is the interrupted instruction, rather than a return address
+        caller_rip_is_exact = !!(cie.aug.flags & EH_AugFlag_IsSignal);
+        
+        // rjf: commit registers
+        MemoryCopyStruct(regs, dst_regs);
+        did_cfi_unwind = 1;
+      }
+      else if(ctx.is_read_bad)
+      {
+        is_good = 0;
+      }
+    }
+  }
+  
+  //////////////////////////////
+  //- no CFI, or unsupported CFI rules -> unwind by reading stack pointer
+  //
+  if(is_good && !did_cfi_unwind) ProfScope("no CFI, or unsupported CFI rules -> unwind by reading stack pointer")
+  {
+    // rjf: read rip from stack pointer
+    U64 rsp = regs->rsp.u64;
+    U64 new_rip = 0;
+    if(!ctrl_process_memory_read_struct(process_handle, rsp, &is_stale, &new_rip, endt_us) ||
+       is_stale)
+    {
+      is_good = 0;
+    }
+    
+    // rjf: commit registers
+    if(is_good)
+    {
+      U64 new_rsp = rsp + 8;
+      regs->rip.u64 = new_rip;
+      regs->rsp.u64 = new_rsp;
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: fill & return
+  //
+  scratch_end(scratch);
+  CTRL_UnwindStepResult result = {0};
+  if(!is_good) {result.flags |= CTRL_UnwindFlag_Error;}
+  if(is_stale) {result.flags |= CTRL_UnwindFlag_Stale;}
+  result.caller_rip_is_exact = caller_rip_is_exact;
+  return result;
+}
+
 //- rjf: abstracted unwind step
 
 internal CTRL_UnwindStepResult
-ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, U64 endt_us)
+ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, B32 rip_is_return_address, U64 endt_us)
 {
   CTRL_UnwindStepResult result = {0};
   switch(arch)
@@ -2657,7 +2955,14 @@ ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr,
     default:{}break;
     case Arch_x64:
     {
-      result = ctrl_unwind_step__pe_x64(process, module, module_base_vaddr, (REGS_RegBlockX64 *)reg_block, endt_us);
+      if(ctrl_module_has_eh_frame(module))
+      {
+        result = ctrl_unwind_step__elf_x64(process, module, module_base_vaddr, (REGS_RegBlockX64 *)reg_block, rip_is_return_address, endt_us);
+      }
+      else
+      {
+        result = ctrl_unwind_step__pe_x64(process, module, module_base_vaddr, (REGS_RegBlockX64 *)reg_block, endt_us);
+      }
     }break;
   }
   return result;
@@ -2690,6 +2995,10 @@ ctrl_unwind_from_thread(Arena *arena, CTRL_EntityCtx *ctx, CTRL_Handle thread, U
   if(regs_block_good)
   {
     unwind.flags = 0;
+    
+    // NOTE: only the first frame's rip is exact; every caller's is a return
+    // address, unless it was restored by a signal trampoline
+    B32 rip_is_return_address = 0;
     for(;;)
     {
       // rjf: regs -> rip*module
@@ -2720,8 +3029,9 @@ ctrl_unwind_from_thread(Arena *arena, CTRL_EntityCtx *ctx, CTRL_Handle thread, U
       frame_node_count += 1;
       
       // rjf: unwind one step
-      CTRL_UnwindStepResult step = ctrl_unwind_step(process_entity->handle, module->handle, module->vaddr_range.min, arch, regs_block, endt_us);
+      CTRL_UnwindStepResult step = ctrl_unwind_step(process_entity->handle, module->handle, module->vaddr_range.min, arch, regs_block, rip_is_return_address, endt_us);
       unwind.flags |= step.flags;
+      rip_is_return_address = !step.caller_rip_is_exact;
       if(step.flags & CTRL_UnwindFlag_Error ||
          regs_rsp_from_arch_block(arch, regs_block) == 0 ||
          regs_rip_from_arch_block(arch, regs_block) == 0 ||
@@ -3089,6 +3399,8 @@ ctrl_thread__entry_point(void *p)
           arena_clear(ctrl_state->ctrl_thread_msg_process_arena);
           ctrl_state->module_req_cache_slots_count = 4096;
           ctrl_state->module_req_cache_slots = push_array(ctrl_state->ctrl_thread_msg_process_arena, CTRL_ModuleReqCacheNode *, ctrl_state->module_req_cache_slots_count);
+          ctrl_state->cond_bytecode_cache_slots_count = 256;
+          ctrl_state->cond_bytecode_cache_slots = push_array(ctrl_state->ctrl_thread_msg_process_arena, CTRL_CondBytecodeCacheNode *, ctrl_state->cond_bytecode_cache_slots_count);
           MemoryZeroStruct(&ctrl_state->msg_user_bp_touched_files);
           MemoryZeroStruct(&ctrl_state->msg_user_bp_touched_symbols);
           MemoryCopyArray(ctrl_state->exception_code_filters, msg->exception_code_filters);
@@ -3641,6 +3953,104 @@ ctrl_thread__module_open(CTRL_Handle process, CTRL_Handle module, Rng1U64 vaddr_
     }
   }
   
+  //////////////////////////////
+  //- unpack ELF unwind info
+  //
+  U64 eh_frame_hdr_voff = 0;
+  U64 eh_frame_voff = 0;
+  String8 eh_frame = {0};
+  EH_FrameHdr eh_frame_hdr = {0};
+  EH_FDEIndex eh_frame_fde_index = {0};
+  ProfScope("unpack ELF unwind info")
+  {
+    Temp scratch = scratch_begin(0, 0);
+    B32 is_valid = 1;
+    
+    //- read ELF header
+    ELF_Hdr64 elf_hdr = {0};
+    if(is_valid)
+    {
+      if(dmn_process_read_struct(process.dmn_handle, vaddr_range.min, &elf_hdr) != sizeof(elf_hdr) ||
+         !MemoryMatch(elf_hdr.e_ident, elf_magic, sizeof(elf_magic)) ||
+         !ELF_HdrIs64Bit(elf_hdr.e_ident) ||
+         elf_hdr.e_phentsize < sizeof(ELF_Phdr64))
+      {
+        is_valid = 0;
+      }
+    }
+    
+    //- read program headers; segment addresses are image-relative for
+    // position independent images, and absolute for fixed ones
+    U64 segment_vaddr_bias = (elf_hdr.e_type == ELF_Type_Exec ? vaddr_range.min : 0);
+    ELF_Phdr64 *phdrs = 0;
+    U64 phdrs_count = 0;
+    if(is_valid)
+    {
+      phdrs_count = elf_hdr.e_phnum;
+      phdrs = push_array(scratch.arena, ELF_Phdr64, phdrs_count);
+      for EachIndex(idx, phdrs_count)
+      {
+        dmn_process_read_struct(process.dmn_handle, vaddr_range.min + elf_hdr.e_phoff + idx*elf_hdr.e_phentsize, &phdrs[idx]);
+      }
+    }
+    
+    //- find & read .eh_frame_hdr
+    String8 eh_frame_hdr_data = {0};
+    for EachIndex(idx, phdrs_count)
+    {
+      if(phdrs[idx].p_type == ELF_PType_GnuEHFrame && phdrs[idx].p_vaddr >= segment_vaddr_bias)
+      {
+        eh_frame_hdr_voff = phdrs[idx].p_vaddr - segment_vaddr_bias;
+        eh_frame_hdr_data.size = phdrs[idx].p_memsz;
+        eh_frame_hdr_data.str = push_array(arena, U8, eh_frame_hdr_data.size);
+        eh_frame_hdr_data.size = dmn_process_read(process.dmn_handle, r1u64(vaddr_range.min + eh_frame_hdr_voff, vaddr_range.min + eh_frame_hdr_voff + eh_frame_hdr_data.size), eh_frame_hdr_data.str);
+        break;
+      }
+    }
+    
+    //- parse .eh_frame_hdr
+    EH_PtrCtx hdr_ptr_ctx = {0};
+    hdr_ptr_ctx.raw_base_vaddr = eh_frame_hdr_voff;
+    hdr_ptr_ctx.data_vaddr = eh_frame_hdr_voff;
+    if(eh_frame_hdr_data.size != 0 && eh_parse_frame_hdr(eh_frame_hdr_data, &hdr_ptr_ctx, &eh_frame_hdr))
+    {
+      eh_frame_voff = eh_frame_hdr.eh_frame_ptr;
+    }
+    
+    //- read .eh_frame; its size isn't recorded anywhere in memory, so read up to
+    // the end of the containing segment and trim at the terminator
+    if(eh_frame_voff != 0)
+    {
+      for EachIndex(idx, phdrs_count)
+      {
+        ELF_Phdr64 *phdr = &phdrs[idx];
+        if(phdr->p_type == ELF_PType_Load && phdr->p_vaddr >= segment_vaddr_bias)
+        {
+          Rng1U64 segment_voff_range = r1u64(phdr->p_vaddr - segment_vaddr_bias, phdr->p_vaddr - segment_vaddr_bias + phdr->p_memsz);
+          if(contains_1u64(segment_voff_range, eh_frame_voff))
+          {
+            String8 segment_tail = {0};
+            segment_tail.size = segment_voff_range.max - eh_frame_voff;
+            segment_tail.str = push_array_no_zero(scratch.arena, U8, segment_tail.size);
+            segment_tail.size = dmn_process_read(process.dmn_handle, r1u64(vaddr_range.min + eh_frame_voff, vaddr_range.min + segment_voff_range.max), segment_tail.str);
+            eh_frame = push_str8_copy(arena, str8_prefix(segment_tail, eh_size_from_frame(segment_tail)));
+            break;
+          }
+        }
+      }
+    }
+    
+    //- no searchable .eh_frame_hdr table -> build sorted FDE index
+    if(eh_frame.size != 0 && eh_frame_hdr.fde_count == 0)
+    {
+      EH_PtrCtx ptr_ctx = {0};
+      ptr_ctx.raw_base_vaddr = eh_frame_voff;
+      eh_frame_fde_index = eh_fde_index_from_frame(arena, eh_frame, &ptr_ctx);
+    }
+    
+    scratch_end(scratch);
+  }
+  
   //////////////////////////////
   //- rjf: pick default initial debug info path
   //
@@ -3722,6 +4132,11 @@ ctrl_thread__module_open(CTRL_Handle process, CTRL_Handle module, Rng1U64 vaddr_
         node->initial_debug_info_path = initial_debug_info_path;
         node->raddbg_section_voff_range = raddbg_section_voff_range;
         node->raddbg_data = raddbg_data;
+        node->eh_frame_hdr_voff = eh_frame_hdr_voff;
+        node->eh_frame_voff = eh_frame_voff;
+        node->eh_frame = eh_frame;
+        node->eh_frame_hdr = eh_frame_hdr;
+        node->eh_frame_fde_index = eh_frame_fde_index;
       }
     }
   }
@@ -4002,6 +4417,9 @@ ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg,
       {
         dmn_process_write(spoof->process, r1u64(spoof->vaddr, spoof->vaddr+size_of_spoof), &spoof_old_ip_value);
       }
+      
+      // figure out which cached memory pages were written by the run
+      ctrl_thread__refresh_mem_page_gens();
     }
   }
   
@@ -4089,6 +4507,7 @@ ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg,
       out_evt->entity     = ctrl_handle_make(CTRL_MachineID_Local, event->process);
       out_evt->u64_code   = event->code;
       ctrl_state->process_counter -= 1;
+      ctrl_mem_page_gens_release_process(out_evt->entity);
     }break;
     case DMN_EventKind_ExitThread:
     {
@@ -4273,6 +4692,12 @@ ctrl_thread__eval_scope_begin(Arena *arena, CTRL_UserBreakpointList *user_bps, C
   CTRL_Entity *module = ctrl_module_from_process_vaddr(process, thread_rip_vaddr);
   U64 thread_rip_voff = ctrl_voff_from_vaddr(module, thread_rip_vaddr);
   
+  scope->process = process->handle;
+  scope->thread = thread->handle;
+  scope->module = module->handle;
+  scope->ip_voff = thread_rip_voff;
+  scope->dbg_info_gen = entity_ctx->entity_kind_alloc_gens[CTRL_EntityKind_Module];
+  
   //////////////////////////////
   //- rjf: gather evaluation debug infos & modules
   //
@@ -4396,6 +4821,10 @@ ctrl_thread__eval_scope_begin(Arena *arena, CTRL_UserBreakpointList *user_bps, C
             rdi = di_rdi_from_key(scope->access, dbgi_key, 1, max_U64);
           }
           
+          //- fold into debug info generation; compiled expressions are
+          // only valid for the same set of loaded debug infos
+          scope->dbg_info_gen = u64_hash_from_seed_str8(scope->dbg_info_gen, str8_struct(&rdi));
+          
           //- rjf: fill debug info
           eval_dbg_infos[eval_dbg_info_idx].dbgi_key = dbgi_key;
           eval_dbg_infos[eval_dbg_info_idx].rdi      = rdi;
@@ -4498,6 +4927,54 @@ ctrl_thread__eval_scope_end(CTRL_EvalScope *scope)
   access_close(scope->access);
 }
 
+internal String8
+ctrl_thread__cond_bytecode_from_eval_scope(CTRL_EvalScope *scope, String8 condition)
+{
+  ProfBeginFunction();
+  
+  //- look up cached bytecode for this condition, at this location, with
+  // this set of debug infos; the bytecode refers to the process' & thread's
+  // spaces, so those are part of the key too
+  U64 hash = u64_hash_from_seed_str8(scope->dbg_info_gen ^ scope->ip_voff, condition);
+  hash = u64_hash_from_seed_str8(hash, str8_struct(&scope->module));
+  hash = u64_hash_from_seed_str8(hash, str8_struct(&scope->process));
+  hash = u64_hash_from_seed_str8(hash, str8_struct(&scope->thread));
+  U64 slot_idx = hash%ctrl_state->cond_bytecode_cache_slots_count;
+  CTRL_CondBytecodeCacheNode *node = 0;
+  for(CTRL_CondBytecodeCacheNode *n = ctrl_state->cond_bytecode_cache_slots[slot_idx]; n != 0; n = n->next)
+  {
+    if(n->ip_voff == scope->ip_voff &&
+       n->dbg_info_gen == scope->dbg_info_gen &&
+       ctrl_handle_match(n->process, scope->process) &&
+       ctrl_handle_match(n->thread, scope->thread) &&
+       ctrl_handle_match(n->module, scope->module) &&
+       str8_match(n->condition, condition, 0))
+    {
+      node = n;
+      break;
+    }
+  }
+  
+  //- not cached -> parse, type-check, & generate bytecode once
+  if(node == 0) ProfScope("compile condition")
+  {
+    String8 bytecode = e_bytecode_from_string(condition);
+    node = push_array(ctrl_state->ctrl_thread_msg_process_arena, CTRL_CondBytecodeCacheNode, 1);
+    node->next = ctrl_state->cond_bytecode_cache_slots[slot_idx];
+    ctrl_state->cond_bytecode_cache_slots[slot_idx] = node;
+    node->condition = push_str8_copy(ctrl_state->ctrl_thread_msg_process_arena, condition);
+    node->process = scope->process;
+    node->thread = scope->thread;
+    node->module = scope->module;
+    node->ip_voff = scope->ip_voff;
+    node->dbg_info_gen = scope->dbg_info_gen;
+    node->bytecode = push_str8_copy(ctrl_state->ctrl_thread_msg_process_arena, bytecode);
+  }
+  
+  ProfEnd();
+  return node->bytecode;
+}
+
 //- rjf: log flusher
 
 internal void
@@ -4789,6 +5266,13 @@ ctrl_thread__detach(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
   //- rjf: detach
   B32 detach_worked = dmn_ctrl_detach(ctrl_ctx, process);
   
+  //- release tracked page generations; a detached process may not report
+  // its exit to us
+  if(detach_worked)
+  {
+    ctrl_mem_page_gens_release_process(msg->entity);
+  }
+  
   //- rjf: wait for process to be dead
   if(detach_worked)
   {
@@ -5576,14 +6060,15 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
           for(String8Node *condition_n = conditions.first; condition_n != 0; condition_n = condition_n->next)
           {
             // rjf: evaluate
-            E_Eval eval = zero_struct;
+            E_Interpretation interpret = zero_struct;
             ProfScope("evaluate expression")
             {
-              eval = e_eval_from_string(condition_n->string);
+              String8 bytecode = ctrl_thread__cond_bytecode_from_eval_scope(eval_scope, condition_n->string);
+              interpret = e_interpret(bytecode);
             }
             
             // rjf: interpret evaluation
-            if(eval.code == E_InterpretationCode_Good && eval.value.u64 == 0)
+            if(interpret.code == E_InterpretationCode_Good && interpret.value.u64 == 0)
             {
               hit_user_bp = 0;
               hit_conditional_bp_but_filtered = 1;
@@ -5999,6 +6484,230 @@ ctrl_thread__single_step(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
   ProfEnd();
 }
 
+////////////////////////////////
+//~ Process Memory Page Generation Functions
+
+internal U64
+ctrl_mem_gen_from_process_vaddr_range(CTRL_Handle process, Rng1U64 vaddr_range, B32 zero_terminated)
+{
+  U64 result = ctrl_mem_gen();
+  
+  //- single whole pages carry their own generation, which only advances
+  // when the page is known to have been written - everything else is
+  // invalidated by any change to process memory
+  U64 page_size = os_get_system_info()->page_size;
+  if(!zero_terminated && vaddr_range.min%page_size == 0 && dim_1u64(vaddr_range) == page_size)
+  {
+    CTRL_MemPageGenCache *cache = &ctrl_state->mem_page_gen_cache;
+    U64 hash = ctrl_hash_from_handle(process) ^ u64_hash_from_str8(str8_struct(&vaddr_range.min));
+    U64 slot_idx = hash%cache->slots_count;
+    U64 stripe_idx = slot_idx%cache->stripes_count;
+    CTRL_MemPageGenSlot *slot = &cache->slots[slot_idx];
+    CTRL_MemPageGenStripe *stripe = &cache->stripes[stripe_idx];
+    for(B32 write_mode = 0; write_mode <= 1; write_mode += 1)
+    {
+      B32 found = 0;
+      RWMutexScope(stripe->rw_mutex, write_mode)
+      {
+        for(CTRL_MemPageGenNode *n = slot->first; n != 0; n = n->next)
+        {
+          if(n->vaddr == vaddr_range.min && ctrl_handle_match(n->process, process))
+          {
+            result = ins_atomic_u64_eval(&n->gen);
+            ins_atomic_u64_eval_assign(&n->last_touched_us, os_now_microseconds());
+            found = 1;
+            break;
+          }
+        }
+        if(write_mode && !found)
+        {
+          CTRL_MemPageGenNode *node = stripe->free_node;
+          if(node != 0)
+          {
+            SLLStackPop(stripe->free_node);
+          }
+          else
+          {
+            node = push_array_no_zero(stripe->arena, CTRL_MemPageGenNode, 1);
+          }
+          MemoryZeroStruct(node);
+          DLLPushBack(slot->first, slot->last, node);
+          node->process = process;
+          node->vaddr   = vaddr_range.min;
+          node->gen     = result;
+          node->last_touched_us = os_now_microseconds();
+          found = 1;
+        }
+      }
+      if(found)
+      {
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+internal void
+ctrl_mem_page_gens_mark_dirty(CTRL_Handle process, Rng1U64 vaddr_range)
+{
+  CTRL_MemPageGenCache *cache = &ctrl_state->mem_page_gen_cache;
+  U64 page_size = os_get_system_info()->page_size;
+  U64 gen = ctrl_mem_gen();
+  for(U64 page_vaddr = AlignDownPow2(vaddr_range.min, page_size); page_vaddr < vaddr_range.max; page_vaddr += page_size)
+  {
+    U64 hash = ctrl_hash_from_handle(process) ^ u64_hash_from_str8(str8_struct(&page_vaddr));
+    U64 slot_idx = hash%cache->slots_count;
+    U64 stripe_idx = slot_idx%cache->stripes_count;
+    CTRL_MemPageGenSlot *slot = &cache->slots[slot_idx];
+    CTRL_MemPageGenStripe *stripe = &cache->stripes[stripe_idx];
+    MutexScopeR(stripe->rw_mutex) for(CTRL_MemPageGenNode *n = slot->first; n != 0; n = n->next)
+    {
+      if(n->vaddr == page_vaddr && ctrl_handle_match(n->process, process))
+      {
+        ins_atomic_u64_eval_assign(&n->gen, gen);
+        break;
+      }
+    }
+  }
+}
+
+internal void
+ctrl_mem_page_gens_release_process(CTRL_Handle process)
+{
+  CTRL_MemPageGenCache *cache = &ctrl_state->mem_page_gen_cache;
+  for EachIndex(slot_idx, cache->slots_count)
+  {
+    U64 stripe_idx = slot_idx%cache->stripes_count;
+    CTRL_MemPageGenSlot *slot = &cache->slots[slot_idx];
+    CTRL_MemPageGenStripe *stripe = &cache->stripes[stripe_idx];
+    MutexScopeW(stripe->rw_mutex) for(CTRL_MemPageGenNode *n = slot->first, *next = 0; n != 0; n = next)
+    {
+      next = n->next;
+      if(ctrl_handle_match(n->process, process))
+      {
+        DLLRemove(slot->first, slot->last, n);
+        SLLStackPush(stripe->free_node, n);
+      }
+    }
+  }
+}
+
+internal int
+ctrl_mem_page_gen_node_ptr_compare(CTRL_MemPageGenNode **a, CTRL_MemPageGenNode **b)
+{
+  int result = 0;
+  if(a[0]->process.machine_id < b[0]->process.machine_id)
+  {
+    result = -1;
+  }
+  else if(a[0]->process.machine_id > b[0]->process.machine_id)
+  {
+    result = +1;
+  }
+  else if(a[0]->process.dmn_handle.u64[0] < b[0]->process.dmn_handle.u64[0])
+  {
+    result = -1;
+  }
+  else if(a[0]->process.dmn_handle.u64[0] > b[0]->process.dmn_handle.u64[0])
+  {
+    result = +1;
+  }
+  else if(a[0]->vaddr < b[0]->vaddr)
+  {
+    result = -1;
+  }
+  else if(a[0]->vaddr > b[0]->vaddr)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+internal void
+ctrl_thread__refresh_mem_page_gens(void)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
+  CTRL_MemPageGenCache *cache = &ctrl_state->mem_page_gen_cache;
+  U64 page_size = os_get_system_info()->page_size;
+  U64 gen = ctrl_mem_gen();
+  ins_atomic_u64_eval_assign(&ctrl_state->mem_page_gens_refresh_gen, gen);
+  
+  //- evict pages whose artifacts are gone, and count the rest
+  U64 now_us = os_now_microseconds();
+  U64 nodes_count = 0;
+  for EachIndex(slot_idx, cache->slots_count)
+  {
+    CTRL_MemPageGenSlot *slot = &cache->slots[slot_idx];
+    CTRL_MemPageGenStripe *stripe = &cache->stripes[slot_idx%cache->stripes_count];
+    MutexScopeW(stripe->rw_mutex) for(CTRL_MemPageGenNode *n = slot->first, *next = 0; n != 0; n = next)
+    {
+      next = n->next;
+      U64 last_touched_us = ins_atomic_u64_eval(&n->last_touched_us);
+      if(last_touched_us + CTRL_MEM_ARTIFACT_EVICT_THRESHOLD_US < now_us)
+      {
+        DLLRemove(slot->first, slot->last, n);
+        SLLStackPush(stripe->free_node, n);
+      }
+      else
+      {
+        nodes_count += 1;
+      }
+    }
+  }
+  
+  //- gather all tracked pages. nodes are only released on the ctrl
+  // thread, so they stay valid outside of their stripe locks here. nodes
+  // created after the count was taken already carry the current generation,
+  // so they can be skipped.
+  CTRL_MemPageGenNode **nodes = push_array_no_zero(scratch.arena, CTRL_MemPageGenNode *, nodes_count);
+  {
+    U64 node_idx = 0;
+    for(U64 slot_idx = 0; slot_idx < cache->slots_count && node_idx < nodes_count; slot_idx += 1)
+    {
+      CTRL_MemPageGenStripe *stripe = &cache->stripes[slot_idx%cache->stripes_count];
+      MutexScopeR(stripe->rw_mutex) for(CTRL_MemPageGenNode *n = cache->slots[slot_idx].first; n != 0 && node_idx < nodes_count; n = n->next)
+      {
+        nodes[node_idx] = n;
+        node_idx += 1;
+      }
+    }
+    nodes_count = node_idx;
+  }
+  
+  //- sort by process & address, so runs of adjacent pages can be
+  // queried all at once
+  quick_sort(nodes, nodes_count, sizeof(nodes[0]), ctrl_mem_page_gen_node_ptr_compare);
+  
+  //- query written pages for each run; bump the generations of written
+  // pages, and of all pages if the demon can't tell us what was written
+  for(U64 run_first_idx = 0, run_opl_idx = 0; run_first_idx < nodes_count; run_first_idx = run_opl_idx)
+  {
+    CTRL_Handle process = nodes[run_first_idx]->process;
+    for(run_opl_idx = run_first_idx+1;
+        run_opl_idx < nodes_count &&
+        run_opl_idx - run_first_idx < 4096 &&
+        ctrl_handle_match(nodes[run_opl_idx]->process, process) &&
+        nodes[run_opl_idx]->vaddr == nodes[run_opl_idx-1]->vaddr + page_size;
+        run_opl_idx += 1);
+    Rng1U64 range = r1u64(nodes[run_first_idx]->vaddr, nodes[run_opl_idx-1]->vaddr + page_size);
+    U64 *dirty_flags = push_array(scratch.arena, U64, (run_opl_idx-run_first_idx+63)/64);
+    B32 dirty_flags_good = (process.machine_id == CTRL_MachineID_Local && dmn_process_read_dirty_page_flags(process.dmn_handle, range, dirty_flags));
+    for(U64 idx = run_first_idx; idx < run_opl_idx; idx += 1)
+    {
+      U64 page_idx = idx - run_first_idx;
+      if(!dirty_flags_good || dirty_flags[page_idx/64] & (1ull<<(page_idx%64)))
+      {
+        ins_atomic_u64_eval_assign(&nodes[idx]->gen, gen);
+      }
+    }
+  }
+  
+  scratch_end(scratch);
+  ProfEnd();
+}
+
 ////////////////////////////////
 //~ rjf: Process Memory Artifact Cache Hooks / Lookups
 
@@ -6031,7 +6740,7 @@ ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64
     Arena *range_arena = 0;
     void *range_base = 0;
     U64 zero_terminated_size = 0;
-    U64 pre_read_mem_gen = ctrl_mem_gen();
+    U64 pre_read_mem_gen = ctrl_mem_gen_from_process_vaddr_range(process, vaddr_range, zero_terminated);
     B32 pre_run_state = ins_atomic_u64_eval(&ctrl_state->ctrl_thread_run_state);
     if(range_size != 0)
     {
@@ -6045,28 +6754,41 @@ ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64
       {
         // rjf: read as much as possible
         range_base = push_array_no_zero(range_arena, U8, range_size);
-        U64 bytes_read = 0;
-        U64 retry_count = 0;
-        U64 retry_limit = range_size > page_size ? 64 : 0;
-        for(Rng1U64 vaddr_range_clamped_retry = vaddr_range_clamped;
-            retry_count <= retry_limit;
-            retry_count += 1)
-        {
-          bytes_read = dmn_process_read(process.dmn_handle, vaddr_range_clamped_retry, range_base);
-          if(bytes_read == 0 && vaddr_range_clamped_retry.max > vaddr_range_clamped_retry.min)
+        U64 bytes_read = dmn_process_read(process.dmn_handle, vaddr_range_clamped, range_base);
+        
+        // multi-page range failed -> some page in it isn't readable. find
+        // the readable prefix by reading it page-by-page, in batches of page
+        // requests, stopping at the first batch with a failed page.
+        if(bytes_read == 0 && range_size > page_size)
+        {
+          Temp scratch = scratch_begin(0, 0);
+          U64 first_page_vaddr = AlignDownPow2(vaddr_range_clamped.min, page_size);
+          U64 pages_count = (AlignPow2(vaddr_range_clamped.max, page_size) - first_page_vaddr)/page_size;
+          U64 batch_cap = 1024;
+          DMN_ReadRequest *requests = push_array_no_zero(scratch.arena, DMN_ReadRequest, batch_cap);
+          B32 hit_unreadable_page = 0;
+          for(U64 batch_first_page_idx = 0; batch_first_page_idx < pages_count && !hit_unreadable_page; batch_first_page_idx += batch_cap)
           {
-            U64 diff = (vaddr_range_clamped_retry.max-vaddr_range_clamped_retry.min)/2;
-            vaddr_range_clamped_retry.max -= diff;
-            vaddr_range_clamped_retry.max = AlignDownPow2(vaddr_range_clamped_retry.max, page_size);
-            if(diff == 0)
+            U64 batch_count = Min(batch_cap, pages_count - batch_first_page_idx);
+            for EachIndex(idx, batch_count)
             {
-              break;
+              U64 page_vaddr = first_page_vaddr + (batch_first_page_idx+idx)*page_size;
+              requests[idx].range = intersect_1u64(r1u64(page_vaddr, page_vaddr+page_size), vaddr_range_clamped);
+              requests[idx].dst = (U8 *)range_base + (requests[idx].range.min - vaddr_range_clamped.min);
+              requests[idx].bytes_read = 0;
+            }
+            dmn_process_read_batch(process.dmn_handle, requests, batch_count);
+            for EachIndex(idx, batch_count)
+            {
+              bytes_read += requests[idx].bytes_read;
+              if(requests[idx].bytes_read != dim_1u64(requests[idx].range))
+              {
+                hit_unreadable_page = 1;
+                break;
+              }
             }
           }
-          else
-          {
-            break;
-          }
+          scratch_end(scratch);
         }
         
         // rjf: if we read nothing, release arena
@@ -6100,7 +6822,7 @@ ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64
         }
       }
     }
-    U64 post_read_mem_gen = ctrl_mem_gen();
+    U64 post_read_mem_gen = ctrl_mem_gen_from_process_vaddr_range(process, vaddr_range, zero_terminated);
     B32 post_run_state = ins_atomic_u64_eval(&ctrl_state->ctrl_thread_run_state);
     
     //- rjf: form content key
@@ -6179,10 +6901,10 @@ ctrl_key_from_process_vaddr_range(CTRL_Handle process, Rng1U64 vaddr_range, B32
   Access *access = access_open();
   AC_Artifact artifact = ac_artifact_from_key(access, key, ctrl_memory_artifact_create, ctrl_memory_artifact_destroy, endt_us,
                                               .flags = AC_Flag_HighPriority | (wait_for_fresh ? AC_Flag_WaitForFresh : 0),
-                                              .gen = ctrl_mem_gen(),
+                                              .gen = ctrl_mem_gen_from_process_vaddr_range(process, vaddr_range, zero_terminated),
                                               .slots_count = 2048,
                                               .stale_out = out_is_stale,
-                                              .evict_threshold_us = 10000000);
+                                              .evict_threshold_us = CTRL_MEM_ARTIFACT_EVICT_THRESHOLD_US);
   C_Key content_key = {0};
   MemoryCopyStruct(&content_key, &artifact);
   access_close(access);
@@ -6206,7 +6928,7 @@ ctrl_process_memory_slice_from_vaddr_range(Arena *arena, CTRL_Handle process, Rn
     Access *access = access_open();
     
     //- rjf: unpack address range, prepare per-touched-page info
-    U64 page_size = KB(4);
+    U64 page_size = os_get_system_info()->page_size;
     Rng1U64 page_range = r1u64(AlignDownPow2(range.min, page_size), AlignPow2(range.max, page_size));
     U64 page_count = dim_1u64(page_range)/page_size;
     U128 *page_hashes = push_array(scratch.arena, U128, page_count);
@@ -6222,6 +6944,15 @@ ctrl_process_memory_slice_from_vaddr_range(Arena *arena, CTRL_Handle process, Rn
         C_Key page_key = ctrl_key_from_process_vaddr_range(process, r1u64(page_base_vaddr, page_base_vaddr+page_size), 0, wait_for_fresh, endt_us, &page_is_stale);
         U128 page_hash = c_hash_from_key(page_key, 0);
         U128 page_last_hash = c_hash_from_key(page_key, 1);
+        
+        // pages which weren't written since the last stop are never
+        // re-read, so their hash history doesn't roll forward - they haven't
+        // changed
+        U64 page_gen = ctrl_mem_gen_from_process_vaddr_range(process, r1u64(page_base_vaddr, page_base_vaddr+page_size), 0);
+        if(page_gen < ins_atomic_u64_eval(&ctrl_state->mem_page_gens_refresh_gen))
+        {
+          page_last_hash = page_hash;
+        }
         result.stale = (result.stale || page_is_stale);
         page_hashes[page_idx] = page_hash;
         page_last_hashes[page_idx] = page_last_hash;
@@ -6366,6 +7097,7 @@ ctrl_process_write(CTRL_Handle process, Rng1U64 range, void *src)
   if(result)
   {
     ins_atomic_u64_inc_eval(&ctrl_state->mem_gen);
+    ctrl_mem_page_gens_mark_dirty(process, range);
   }
   
   //- rjf: success -> wait for cache updates, for small regions - prefer relatively seamless
@@ -6554,6 +7286,7 @@ ctrl_call_stack_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out,
     {
       artifact.u64[0] = (U64)arena;
       artifact.u64[1] = (U64)call_stack;
+      ac_report_artifact_size(arena_pos(arena));
     }
     
     //- rjf: mark retry
@@ -6701,6 +7434,10 @@ ctrl_call_stack_tree_artifact_create(String8 key, B32 *cancel_signal, B32 *retry
   {
     artifact.u64[0] = (U64)arena;
     artifact.u64[1] = (U64)tree;
+    if(arena != 0)
+    {
+      ac_report_artifact_size(arena_pos(arena));
+    }
   }
   
   //- rjf: retry on stale
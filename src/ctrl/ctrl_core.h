@@ -228,6 +228,18 @@ typedef struct CTRL_UnwindStepResult CTRL_UnwindStepResult;
 struct CTRL_UnwindStepResult
 {
   CTRL_UnwindFlags flags;
+  B32 caller_rip_is_exact;
+};
+
+typedef struct CTRL_UnwindCFICtxX64 CTRL_UnwindCFICtxX64;
+struct CTRL_UnwindCFICtxX64
+{
+  CTRL_Handle process;
+  U64 endt_us;
+  B32 is_stale;
+  B32 is_read_bad;
+  REGS_RegBlockX64 *src_regs;
+  REGS_RegBlockX64 *dst_regs;
 };
 
 typedef struct CTRL_UnwindFrame CTRL_UnwindFrame;
@@ -548,6 +560,49 @@ struct CTRL_ProcessMemorySlice
   B32 any_byte_changed;
 };
 
+////////////////////////////////
+//~ Process Memory Page Generation Cache Types
+
+// process memory artifacts go away once they've been unrequested for this
+// long. every request looks up its page's generation node, so nodes left
+// untouched for as long belong to no artifact and are evicted as well
+#define CTRL_MEM_ARTIFACT_EVICT_THRESHOLD_US 10000000
+
+typedef struct CTRL_MemPageGenNode CTRL_MemPageGenNode;
+struct CTRL_MemPageGenNode
+{
+  CTRL_MemPageGenNode *next;
+  CTRL_MemPageGenNode *prev;
+  CTRL_Handle process;
+  U64 vaddr;
+  U64 gen;
+  U64 last_touched_us;
+};
+
+typedef struct CTRL_MemPageGenSlot CTRL_MemPageGenSlot;
+struct CTRL_MemPageGenSlot
+{
+  CTRL_MemPageGenNode *first;
+  CTRL_MemPageGenNode *last;
+};
+
+typedef struct CTRL_MemPageGenStripe CTRL_MemPageGenStripe;
+struct CTRL_MemPageGenStripe
+{
+  Arena *arena;
+  RWMutex rw_mutex;
+  CTRL_MemPageGenNode *free_node;
+};
+
+typedef struct CTRL_MemPageGenCache CTRL_MemPageGenCache;
+struct CTRL_MemPageGenCache
+{
+  U64 slots_count;
+  CTRL_MemPageGenSlot *slots;
+  U64 stripes_count;
+  CTRL_MemPageGenStripe *stripes;
+};
+
 ////////////////////////////////
 //~ rjf: Thread Register Cache Types
 
@@ -602,6 +657,11 @@ struct CTRL_ModuleImageInfoCacheNode
   String8 initial_debug_info_path;
   Rng1U64 raddbg_section_voff_range;
   String8 raddbg_data;
+  U64 eh_frame_hdr_voff;
+  U64 eh_frame_voff;
+  String8 eh_frame;
+  EH_FrameHdr eh_frame_hdr;
+  EH_FDEIndex eh_frame_fde_index;
 };
 
 typedef struct CTRL_ModuleImageInfoCacheSlot CTRL_ModuleImageInfoCacheSlot;
@@ -654,6 +714,11 @@ struct CTRL_EvalScope
   E_BaseCtx base_ctx;
   E_IRCtx ir_ctx;
   E_InterpretCtx interpret_ctx;
+  CTRL_Handle process;
+  CTRL_Handle thread;
+  CTRL_Handle module;
+  U64 ip_voff;
+  U64 dbg_info_gen;
 };
 
 ////////////////////////////////
@@ -667,6 +732,22 @@ struct CTRL_ModuleReqCacheNode
   B32 required;
 };
 
+////////////////////////////////
+//~ Conditional Breakpoint Bytecode Cache Types
+
+typedef struct CTRL_CondBytecodeCacheNode CTRL_CondBytecodeCacheNode;
+struct CTRL_CondBytecodeCacheNode
+{
+  CTRL_CondBytecodeCacheNode *next;
+  String8 condition;
+  CTRL_Handle process;
+  CTRL_Handle thread;
+  CTRL_Handle module;
+  U64 ip_voff;
+  U64 dbg_info_gen;
+  String8 bytecode;
+};
+
 ////////////////////////////////
 //~ rjf: Wakeup Hook Function Types
 
@@ -689,11 +770,13 @@ struct CTRL_State
   // rjf: caches
   CTRL_ThreadRegCache thread_reg_cache;
   CTRL_ModuleImageInfoCache module_image_info_cache;
+  CTRL_MemPageGenCache mem_page_gen_cache;
   
   // rjf: generations
   U64 run_gen;
   U64 mem_gen;
   U64 reg_gen;
+  U64 mem_page_gens_refresh_gen;
   
   // rjf: user -> ctrl msg ring buffer
   U64 u2c_ring_size;
@@ -733,6 +816,8 @@ struct CTRL_State
   CTRL_DbgDirNode *dbg_dir_root;
   U64 module_req_cache_slots_count;
   CTRL_ModuleReqCacheNode **module_req_cache_slots;
+  U64 cond_bytecode_cache_slots_count;
+  CTRL_CondBytecodeCacheNode **cond_bytecode_cache_slots;
   String8List msg_user_bp_touched_files;
   String8List msg_user_bp_touched_symbols;
 };
@@ -914,6 +999,8 @@ internal U64 ctrl_entry_point_voff_from_module(CTRL_Handle module_handle);
 internal Rng1U64 ctrl_tls_vaddr_range_from_module(CTRL_Handle module_handle);
 internal String8 ctrl_initial_debug_info_path_from_module(Arena *arena, CTRL_Handle module_handle);
 internal String8 ctrl_raddbg_data_from_module(Arena *arena, CTRL_Handle module_handle);
+internal B32 ctrl_module_has_eh_frame(CTRL_Handle module_handle);
+internal B32 ctrl_eh_frame_cfi_from_module_voff(Arena *arena, CTRL_Handle module_handle, U64 voff, EH_CIE *cie_out, EH_FDE *fde_out);
 
 ////////////////////////////////
 //~ rjf: Unwinding Functions
@@ -924,9 +1011,15 @@ internal CTRL_Unwind ctrl_unwind_deep_copy(Arena *arena, Arch arch, CTRL_Unwind
 //- rjf: [x64]
 internal REGS_Reg64 *ctrl_unwind_reg_from_pe_gpr_reg__pe_x64(REGS_RegBlockX64 *regs, PE_UnwindGprRegX64 gpr_reg);
 internal CTRL_UnwindStepResult ctrl_unwind_step__pe_x64(CTRL_Handle process_handle, CTRL_Handle module_handle, U64 module_base_vaddr, REGS_RegBlockX64 *regs, U64 endt_us);
+internal REGS_Reg64 *ctrl_unwind_reg_from_dw_reg__elf_x64(REGS_RegBlockX64 *regs, DW_Reg dw_reg);
+internal DW_REG_READ(ctrl_unwind_reg_read__elf_x64);
+internal DW_REG_WRITE(ctrl_unwind_reg_write__elf_x64);
+internal DW_MEM_READ(ctrl_unwind_mem_read__elf_x64);
+internal DW_DECODE_PTR(ctrl_unwind_decode_ptr__elf_x64);
+internal CTRL_UnwindStepResult ctrl_unwind_step__elf_x64(CTRL_Handle process_handle, CTRL_Handle module_handle, U64 module_base_vaddr, REGS_RegBlockX64 *regs, B32 rip_is_return_address, U64 endt_us);
 
 //- rjf: abstracted unwind step
-internal CTRL_UnwindStepResult ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, U64 endt_us);
+internal CTRL_UnwindStepResult ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, B32 rip_is_return_address, U64 endt_us);
 
 //- rjf: abstracted full unwind
 internal CTRL_Unwind ctrl_unwind_from_thread(Arena *arena, CTRL_EntityCtx *ctx, CTRL_Handle thread, U64 endt_us);
@@ -979,14 +1072,16 @@ internal void ctrl_thread__module_close(CTRL_Handle process, CTRL_Handle module,
 
 //- rjf: attached process running/event gathering
 internal DMN_Event *ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg, DMN_RunCtrls *run_ctrls, CTRL_Spoof *spoof);
+internal void ctrl_thread__refresh_mem_page_gens(void);
 
-//- rjf: eval helpers
+//- rjf: eval helpers
 internal U64 ctrl_eval_space_gen(E_Space space);
 internal B32 ctrl_eval_space_read(E_Space space, void *out, Rng1U64 vaddr_range);
 
 //- rjf: control thread eval scopes
 internal CTRL_EvalScope *ctrl_thread__eval_scope_begin(Arena *arena, CTRL_UserBreakpointList *user_bps, CTRL_Entity *thread);
 internal void ctrl_thread__eval_scope_end(CTRL_EvalScope *scope);
+internal String8 ctrl_thread__cond_bytecode_from_eval_scope(CTRL_EvalScope *scope, String8 condition);
 
 //- rjf: log flusher
 internal void ctrl_thread__end_and_flush_log(void);
@@ -1000,6 +1095,14 @@ internal void ctrl_thread__detach(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg);
 internal void ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg);
 internal void ctrl_thread__single_step(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg);
 
+////////////////////////////////
+//~ Process Memory Page Generation Functions
+
+internal U64 ctrl_mem_gen_from_process_vaddr_range(CTRL_Handle process, Rng1U64 vaddr_range, B32 zero_terminated);
+internal void ctrl_mem_page_gens_mark_dirty(CTRL_Handle process, Rng1U64 vaddr_range);
+internal void ctrl_mem_page_gens_release_process(CTRL_Handle process);
+internal int ctrl_mem_page_gen_node_ptr_compare(CTRL_MemPageGenNode **a, CTRL_MemPageGenNode **b);
+
 ////////////////////////////////
 //~ rjf: Process Memory Artifact Cache Hooks / Lookups
 
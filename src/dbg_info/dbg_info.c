@@ -79,21 +79,47 @@ di_init(CmdLine *cmdline)
   di_shared->conversion_completion_code = signal_code;
   di_shared->conversion_completion_lock_semaphore_name = str8f(arena, "conversion_completion_lock_pid_%I64u", signal_pid);
   di_shared->conversion_completion_signal_semaphore_name = str8f(arena, "conversion_completion_signal_pid_%I64u", signal_pid);
+  di_shared->conversion_completion_space_semaphore_name = str8f(arena, "conversion_completion_space_pid_%I64u", signal_pid);
   di_shared->conversion_completion_shared_memory_name = str8f(arena, "conversion_completion_shared_memory_pid_%I64u", signal_pid);
   if(has_parent)
   {
     di_shared->conversion_completion_lock_semaphore = semaphore_open(di_shared->conversion_completion_lock_semaphore_name);
     di_shared->conversion_completion_signal_semaphore = semaphore_open(di_shared->conversion_completion_signal_semaphore_name);
+    di_shared->conversion_completion_space_semaphore = semaphore_open(di_shared->conversion_completion_space_semaphore_name);
     di_shared->conversion_completion_shared_memory = os_shared_memory_open(di_shared->conversion_completion_shared_memory_name);
+    U64 conversion_server_gen = 0;
+    if(try_u64_from_str8_c_rules(cmd_line_string(cmdline, str8_lit("conversion_server_gen")), &conversion_server_gen))
+    {
+      di_conversion_server_objects_open(signal_pid, conversion_server_gen, 1);
+    }
   }
   else
   {
     di_shared->conversion_completion_lock_semaphore = semaphore_alloc(1, 1, di_shared->conversion_completion_lock_semaphore_name);
     di_shared->conversion_completion_signal_semaphore = semaphore_alloc(0, 65536, di_shared->conversion_completion_signal_semaphore_name);
-    di_shared->conversion_completion_shared_memory = os_shared_memory_alloc(KB(4), di_shared->conversion_completion_shared_memory_name);
+    di_shared->conversion_completion_space_semaphore = semaphore_alloc(DI_CONVERSION_COMPLETION_RING_CAP, DI_CONVERSION_COMPLETION_RING_CAP, di_shared->conversion_completion_space_semaphore_name);
+    di_shared->conversion_completion_shared_memory = os_shared_memory_alloc(sizeof(DI_ConversionCompletionRing), di_shared->conversion_completion_shared_memory_name);
+    di_shared->use_conversion_server = cmd_line_has_flag(cmdline, str8_lit("use_conversion_server"));
     di_shared->conversion_completion_signal_receiver_thread = thread_launch(di_conversion_completion_signal_receiver_thread_entry_point, 0);
   }
-  di_shared->conversion_completion_shared_memory_base = (U64 *)os_shared_memory_view_open(di_shared->conversion_completion_shared_memory, r1u64(0, KB(4)));
+  di_shared->conversion_completion_ring = (DI_ConversionCompletionRing *)os_shared_memory_view_open(di_shared->conversion_completion_shared_memory, r1u64(0, sizeof(DI_ConversionCompletionRing)));
+  String8 rdi_cache_dir = cmd_line_string(cmdline, str8_lit("rdi_cache"));
+  if(!has_parent && rdi_cache_dir.size != 0)
+  {
+    os_make_directory(rdi_cache_dir);
+    di_shared->rdi_cache_dir = os_full_path_from_path(arena, rdi_cache_dir);
+    di_shared->rdi_cache_size_cap = DI_RDI_CACHE_SIZE_CAP_DEFAULT;
+    U64 rdi_cache_size_cap_mb = 0;
+    if(try_u64_from_str8_c_rules(cmd_line_string(cmdline, str8_lit("rdi_cache_size_mb")), &rdi_cache_size_cap_mb))
+    {
+      di_shared->rdi_cache_size_cap = MB(rdi_cache_size_cap_mb);
+    }
+    
+    // the cache directory may be shared by many debugger instances, so its
+    // lock is named by the directory, rather than by this process
+    String8 rdi_cache_lock_semaphore_name = str8f(arena, "rdi_cache_lock_%I64x", u64_hash_from_str8(di_shared->rdi_cache_dir));
+    di_shared->rdi_cache_lock_semaphore = semaphore_alloc(1, 1, rdi_cache_lock_semaphore_name);
+  }
   di_shared->completion_mutex = mutex_alloc();
   di_shared->completion_arena = arena_alloc();
   di_shared->event_mutex = mutex_alloc();
@@ -328,6 +354,8 @@ di_close(DI_Key key, B32 force_closed)
   FileProperties file_props = {0};
   void *file_base = 0;
   Arena *arena = 0;
+  DI_SectionCache *section_cache = 0;
+  DI_SearchIndex *first_search_index = 0;
   RWMutexScope(stripe->rw_mutex, 1)
   {
     DI_Node *node = 0;
@@ -364,6 +392,8 @@ di_close(DI_Key key, B32 force_closed)
             file_props = node->file_props;
             file_base = node->file_base;
             arena = node->arena;
+            section_cache = (DI_SectionCache *)node->rdi.section_unpack_hook_user_data;
+            first_search_index = node->first_search_index;
             break;
           }
           cond_var_wait_rw(stripe->cv, stripe->rw_mutex, 1, max_U64);
@@ -380,10 +410,16 @@ di_close(DI_Key key, B32 force_closed)
     os_file_map_view_close(file_map, file_base, r1u64(0, file_props.size));
     os_file_map_close(file_map);
     os_file_close(file);
+    di_section_cache_release(section_cache);
     if(arena != 0)
     {
       arena_release(arena);
     }
+    for(DI_SearchIndex *index = first_search_index, *next = 0; index != 0; index = next)
+    {
+      next = index->next;
+      arena_release(index->arena);
+    }
   }
 }
 
@@ -488,7 +524,6 @@ di_rdi_from_key(Access *access, DI_Key key, B32 high_priority, U64 endt_us)
         }
         cond_var_broadcast(async_tick_start_cond_var);
         ins_atomic_u32_eval_assign(&async_loop_again, 1);
-        ins_atomic_u32_eval_assign(&async_loop_again_high_priority, 1);
       }
       
       // rjf: found current results, or out-of-time? abort
@@ -527,6 +562,236 @@ di_get_events(Arena *arena)
   return dst;
 }
 
+////////////////////////////////
+//~ Packed Section Cache
+
+internal DI_SectionCache *
+di_section_cache_alloc(Arena *arena, RDI_Parsed *rdi)
+{
+  DI_SectionCache *cache = 0;
+  U64 page_size = os_get_system_info()->page_size;
+  for EachIndex(idx, rdi->sections_count)
+  {
+    RDI_Section *section = &rdi->sections[idx];
+    if(section->encoding == RDI_SectionEncoding_Unpacked || section->unpacked_size == 0)
+    {
+      continue;
+    }
+    if(cache == 0)
+    {
+      cache = push_array(arena, DI_SectionCache, 1);
+      cache->sections_count = rdi->sections_count;
+      cache->sections = push_array(arena, DI_UnpackedSection, cache->sections_count);
+    }
+    DI_UnpackedSection *dst = &cache->sections[idx];
+    dst->block_size   = rdi_section_block_size_from_kind(rdi, (RDI_SectionKind)idx, &dst->block_count);
+    dst->reserve_size = AlignPow2(section->unpacked_size, page_size);
+    dst->base         = (U8 *)os_reserve(dst->reserve_size);
+    dst->block_states = push_array(arena, U64, dst->block_count);
+    dst->block_touch_idxs = push_array(arena, U64, dst->block_count);
+    if(dst->base != 0 && dst->block_size == 0)
+    {
+      os_release(dst->base, dst->reserve_size);
+    }
+    if(dst->base == 0 || dst->block_size == 0)
+    {
+      MemoryZeroStruct(dst);
+    }
+  }
+  return cache;
+}
+
+internal void
+di_section_cache_release(DI_SectionCache *cache)
+{
+  if(cache != 0)
+  {
+    for EachIndex(idx, cache->sections_count)
+    {
+      if(cache->sections[idx].base != 0)
+      {
+        os_release(cache->sections[idx].base, cache->sections[idx].reserve_size);
+      }
+    }
+    ins_atomic_u64_add_eval(&di_shared->section_cache_unpacked_size, -(S64)ins_atomic_u64_eval(&cache->unpacked_size));
+  }
+}
+
+internal void *
+di_section_unpack_hook(void *user_data, RDI_Parsed *rdi, RDI_SectionKind kind, U64 min, U64 opl)
+{
+  DI_SectionCache *cache = (DI_SectionCache *)user_data;
+  void *result = 0;
+  if(kind < cache->sections_count && cache->sections[kind].base != 0)
+  {
+    DI_UnpackedSection *section = &cache->sections[kind];
+    result = section->base;
+    U64 page_size = os_get_system_info()->page_size;
+    U64 touch_idx = update_tick_idx();
+    U64 first_block_idx = min/section->block_size;
+    U64 opl_block_idx = (min < opl) ? Min((opl + section->block_size - 1)/section->block_size, section->block_count) : first_block_idx;
+    for(U64 block_idx = first_block_idx; block_idx < opl_block_idx; block_idx += 1)
+    {
+      U64 *state = &section->block_states[block_idx];
+      
+      // stamp block, for eviction
+      if(ins_atomic_u64_eval(&section->block_touch_idxs[block_idx]) != touch_idx)
+      {
+        ins_atomic_u64_eval_assign(&section->block_touch_idxs[block_idx], touch_idx);
+      }
+      
+      // claim block; unpack it if we got it
+      if(ins_atomic_u64_eval(state) != DI_SectionBlockState_Unpacked &&
+         ins_atomic_u64_eval_cond_assign(state, DI_SectionBlockState_Unpacking, DI_SectionBlockState_Packed) == DI_SectionBlockState_Packed)
+      {
+        U64 block_off = section->block_size*block_idx;
+        U64 block_opl = Min(block_off + section->block_size, rdi->sections[kind].unpacked_size);
+        U64 commit_off = AlignDownPow2(block_off, page_size);
+        U64 commit_opl = AlignPow2(block_opl, page_size);
+        os_commit(section->base + commit_off, commit_opl - commit_off);
+        rdi_section_unpack_block(rdi, kind, block_idx, section->base);
+        ins_atomic_u64_eval_assign(state, DI_SectionBlockState_Unpacked);
+        ins_atomic_u64_inc_eval(&section->unpacked_block_count);
+        ins_atomic_u64_add_eval(&cache->unpacked_size, block_opl - block_off);
+        ins_atomic_u64_add_eval(&di_shared->section_cache_unpacked_size, block_opl - block_off);
+      }
+      
+      // another thread is unpacking this block -> wait for it
+      for(;ins_atomic_u64_eval(state) != DI_SectionBlockState_Unpacked;)
+      {
+        os_sleep_milliseconds(0);
+      }
+    }
+  }
+  return result;
+}
+
+internal int
+di_evictable_block_qsort_compare__touch_idx(DI_EvictableBlock *a, DI_EvictableBlock *b)
+{
+  int result = 0;
+  if(a->touch_idx < b->touch_idx)      { result = -1; }
+  else if(a->touch_idx > b->touch_idx) { result = +1; }
+  return result;
+}
+
+internal void
+di_section_cache_evict(U64 cap, U64 target_size)
+{
+  if(ins_atomic_u64_eval(&di_shared->section_cache_unpacked_size) <= cap)
+  {
+    return;
+  }
+  Temp scratch = scratch_begin(0, 0);
+  U64 page_size = os_get_system_info()->page_size;
+  
+  //- gather unpacked blocks of all RDIs which are not being accessed
+  typedef struct EvictableBlockNode EvictableBlockNode;
+  struct EvictableBlockNode
+  {
+    EvictableBlockNode *next;
+    DI_EvictableBlock v;
+  };
+  EvictableBlockNode *first_block = 0;
+  U64 blocks_count = 0;
+  for EachIndex(slot_idx, di_shared->slots_count)
+  {
+    DI_Slot *slot = &di_shared->slots[slot_idx];
+    Stripe *stripe = stripe_from_slot_idx(&di_shared->stripes, slot_idx);
+    RWMutexScope(stripe->rw_mutex, 0)
+    {
+      for EachNode(n, DI_Node, slot->first)
+      {
+        DI_SectionCache *cache = (DI_SectionCache *)n->rdi.section_unpack_hook_user_data;
+        if(ins_atomic_u64_eval(&n->completion_count) == 0 || cache == 0 || ins_atomic_u64_eval(&n->access_pt.access_refcount) != 0)
+        {
+          continue;
+        }
+        for EachIndex(section_idx, cache->sections_count)
+        {
+          DI_UnpackedSection *section = &cache->sections[section_idx];
+          for EachIndex(block_idx, section->block_count)
+          {
+            if(ins_atomic_u64_eval(&section->block_states[block_idx]) == DI_SectionBlockState_Unpacked)
+            {
+              EvictableBlockNode *block_n = push_array(scratch.arena, EvictableBlockNode, 1);
+              block_n->v.key         = n->key;
+              block_n->v.cache       = cache;
+              block_n->v.section_idx = section_idx;
+              block_n->v.block_idx   = block_idx;
+              block_n->v.touch_idx   = ins_atomic_u64_eval(&section->block_touch_idxs[block_idx]);
+              SLLStackPush(first_block, block_n);
+              blocks_count += 1;
+            }
+          }
+        }
+      }
+    }
+  }
+  
+  //- sort least recently touched first
+  DI_EvictableBlock *blocks = push_array(scratch.arena, DI_EvictableBlock, blocks_count);
+  {
+    U64 idx = 0;
+    for EachNode(n, EvictableBlockNode, first_block)
+    {
+      blocks[idx] = n->v;
+      idx += 1;
+    }
+  }
+  quick_sort(blocks, blocks_count, sizeof(blocks[0]), di_evictable_block_qsort_compare__touch_idx);
+  
+  //- evict blocks until under the target. the owning node must still be
+  // loaded & unaccessed - readers only take access under the stripe's lock, so
+  // holding it for writing keeps them out while a block is decommitted.
+  for EachIndex(block_idx, blocks_count)
+  {
+    if(ins_atomic_u64_eval(&di_shared->section_cache_unpacked_size) <= target_size)
+    {
+      break;
+    }
+    DI_EvictableBlock *block = &blocks[block_idx];
+    U64 hash = u64_hash_from_str8(str8_struct(&block->key));
+    U64 slot_idx = hash%di_shared->slots_count;
+    DI_Slot *slot = &di_shared->slots[slot_idx];
+    Stripe *stripe = stripe_from_slot_idx(&di_shared->stripes, slot_idx);
+    RWMutexScope(stripe->rw_mutex, 1)
+    {
+      DI_Node *node = 0;
+      for EachNode(n, DI_Node, slot->first)
+      {
+        if(di_key_match(n->key, block->key) && n->completion_count > 0 && n->rdi.section_unpack_hook_user_data == block->cache)
+        {
+          node = n;
+          break;
+        }
+      }
+      if(node != 0 && node->access_pt.access_refcount == 0)
+      {
+        DI_UnpackedSection *section = &block->cache->sections[block->section_idx];
+        U64 *state = &section->block_states[block->block_idx];
+        if(ins_atomic_u64_eval_cond_assign(state, DI_SectionBlockState_Packed, DI_SectionBlockState_Unpacked) == DI_SectionBlockState_Unpacked)
+        {
+          // NOTE: pages shared with neighboring blocks stay committed
+          U64 block_off = section->block_size*block->block_idx;
+          U64 block_opl = Min(block_off + section->block_size, node->rdi.sections[block->section_idx].unpacked_size);
+          U64 decommit_off = AlignPow2(block_off, page_size);
+          U64 decommit_opl = AlignDownPow2(block_opl, page_size);
+          if(decommit_off < decommit_opl)
+          {
+            os_decommit(section->base + decommit_off, decommit_opl - decommit_off);
+          }
+          ins_atomic_u64_dec_eval(&section->unpacked_block_count);
+          ins_atomic_u64_add_eval(&block->cache->unpacked_size, -(S64)(block_opl - block_off));
+          ins_atomic_u64_add_eval(&di_shared->section_cache_unpacked_size, -(S64)(block_opl - block_off));
+        }
+      }
+    }
+  }
+  
+  scratch_end(scratch);
+}
+
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
 
@@ -596,6 +861,24 @@ di_async_tick(void)
       di_shared->first_completion = di_shared->last_completion = 0;
     }
     
+    ////////////////////////////
+    //- detect conversion server exit - it only exits on its own once it
+    // has been idle, but if it crashed, then whatever it was working on is
+    // lost, and those tasks need to be re-run. tasks dispatched later in
+    // this tick relaunch the server under a new generation, so only tasks
+    // stamped with the exited generation are re-run.
+    //
+    B32 conversion_server_exited = 0;
+    U64 exited_conversion_server_gen = 0;
+    if(!os_handle_match(di_shared->conversion_server_process, os_handle_zero()) &&
+       os_process_join(di_shared->conversion_server_process, 0, 0))
+    {
+      conversion_server_exited = 1;
+      exited_conversion_server_gen = di_shared->conversion_server_gen;
+      os_process_detach(di_shared->conversion_server_process);
+      di_shared->conversion_server_process = os_handle_zero();
+    }
+    
     ////////////////////////////
     //- rjf: generate load tasks for all unique requests
     //
@@ -732,6 +1015,22 @@ di_async_tick(void)
         }
         B32 rdi_is_stale = t->rdi_is_stale;
         
+        //- if the RDI next to the O.G. file is stale, look for this O.G. debug
+        // info in the shared RDI cache - on a hit, load that instead; on a miss,
+        // the conversion is published there
+        if(rdi_is_stale && !og_is_rdi && og_is_good && di_shared->rdi_cache_dir.size != 0 && !t->rdi_cache_analyzed)
+        {
+          t->rdi_cache_analyzed = 1;
+          t->rdi_cache_id = di_rdi_cache_id_from_og_path(og_path);
+          t->rdi_cache_hit = di_rdi_cache_lookup(t->rdi_cache_id);
+        }
+        B32 rdi_is_cached = !u128_match(t->rdi_cache_id, u128_zero());
+        if(t->rdi_cache_hit)
+        {
+          rdi_path = di_rdi_cache_path_from_id(scratch.arena, t->rdi_cache_id);
+          rdi_is_stale = 0;
+        }
+        
         //- rjf: calculate thread counts for conversion processes
         if(!og_is_rdi && rdi_is_stale && t->thread_count == 0)
         {
@@ -785,48 +1084,83 @@ di_async_tick(void)
           }
         }
         
-        //- rjf: launch conversion processes
+        //- rjf: launch conversion processes, or hand conversion off to the
+        // conversion server
+        B32 conversion_launch_is_bad = 0;
         if(og_is_good && ready_to_launch_conversion)
         {
-          B32 should_compress = 0;
-          OS_ProcessLaunchParams params = {0};
-          params.path = os_get_process_info()->binary_path;
-          params.inherit_env = 1;
-          params.consoleless = 1;
-          str8_list_pushf(scratch.arena, &params.cmd_line, "raddbg");
-          str8_list_pushf(scratch.arena, &params.cmd_line, "--bin");
-          str8_list_pushf(scratch.arena, &params.cmd_line, "--quiet");
+          B32 should_compress = 1;
+          String8List cmd_line = {0};
+          str8_list_pushf(scratch.arena, &cmd_line, "raddbg");
+          str8_list_pushf(scratch.arena, &cmd_line, "--bin");
+          str8_list_pushf(scratch.arena, &cmd_line, "--quiet");
           if(should_compress)
           {
-            str8_list_pushf(scratch.arena, &params.cmd_line, "--compress");
+            str8_list_pushf(scratch.arena, &cmd_line, "--compress");
           }
-          // str8_list_pushf(scratch.arena, &params.cmd_line, "--capture");
-          str8_list_pushf(scratch.arena, &params.cmd_line, "--rdi");
-          str8_list_pushf(scratch.arena, &params.cmd_line, "--out:%S", rdi_path);
-          str8_list_pushf(scratch.arena, &params.cmd_line, "--thread_count:%I64u", t->thread_count);
-          str8_list_pushf(scratch.arena, &params.cmd_line, "--signal_pid:%I64u", (U64)os_get_process_info()->pid);
-          str8_list_pushf(scratch.arena, &params.cmd_line, "--signal_code:%I64u", (U64)t);
-          str8_list_pushf(scratch.arena, &params.cmd_line, "%S", og_path);
-          ProfMsg("launch creation for %.*s", str8_varg(rdi_path));
-          t->process = os_process_launch(&params);
-          t->status = DI_LoadTaskStatus_Active;
-          di_shared->conversion_process_count += 1;
-          di_shared->conversion_thread_count += t->thread_count;
-          
-          // rjf: send event
-          MutexScope(di_shared->event_mutex)
+          // str8_list_pushf(scratch.arena, &cmd_line, "--capture");
+          str8_list_pushf(scratch.arena, &cmd_line, "--rdi");
+          str8_list_pushf(scratch.arena, &cmd_line, "--out:%S", rdi_is_cached ? di_rdi_cache_temp_path_from_id(scratch.arena, t->rdi_cache_id, (U64)t) : rdi_path);
+          str8_list_pushf(scratch.arena, &cmd_line, "--thread_count:%I64u", t->thread_count);
+          str8_list_pushf(scratch.arena, &cmd_line, "%S", og_path);
+          B32 use_conversion_server = (di_shared->use_conversion_server && !t->needs_own_process);
+          B32 is_launched = 0;
+          if(use_conversion_server)
           {
-            DI_EventNode *n = push_array(di_shared->event_arena, DI_EventNode, 1);
-            SLLQueuePush(di_shared->events.first, di_shared->events.last, n);
-            di_shared->events.count += 1;
-            n->v.kind = DI_EventKind_ConversionStarted;
-            n->v.string = str8_copy(di_shared->event_arena, rdi_path);
+            if(di_conversion_job_push((U64)t, &cmd_line, &t->conversion_server_gen))
+            {
+              ProfMsg("dispatch conversion for %.*s", str8_varg(rdi_path));
+              is_launched = 1;
+            }
+            
+            //- no server could be launched -> fall back to a process of its own
+            else if(os_handle_match(di_shared->conversion_server_process, os_handle_zero()))
+            {
+              use_conversion_server = 0;
+            }
+            
+            //- job ring is full or busy -> leave the task pending & try again
+            // next tick, once the server has drained some jobs
+            else
+            {
+              ins_atomic_u32_eval_assign(&async_loop_again, 1);
+            }
+          }
+          if(!use_conversion_server)
+          {
+            OS_ProcessLaunchParams params = {0};
+            params.path = os_get_process_info()->binary_path;
+            params.inherit_env = 1;
+            params.consoleless = 1;
+            params.cmd_line = cmd_line;
+            str8_list_pushf(scratch.arena, &params.cmd_line, "--signal_pid:%I64u", (U64)os_get_process_info()->pid);
+            str8_list_pushf(scratch.arena, &params.cmd_line, "--signal_code:%I64u", (U64)t);
+            ProfMsg("launch creation for %.*s", str8_varg(rdi_path));
+            t->process = os_process_launch(&params);
+            is_launched = !os_handle_match(t->process, os_handle_zero());
+            conversion_launch_is_bad = !is_launched;
+          }
+          if(is_launched)
+          {
+            t->status = DI_LoadTaskStatus_Active;
+            di_shared->conversion_process_count += 1;
+            di_shared->conversion_thread_count += t->thread_count;
+            
+            // rjf: send event
+            if(!t->is_dispatched) MutexScope(di_shared->event_mutex)
+            {
+              DI_EventNode *n = push_array(di_shared->event_arena, DI_EventNode, 1);
+              SLLQueuePush(di_shared->events.first, di_shared->events.last, n);
+              di_shared->events.count += 1;
+              n->v.kind = DI_EventKind_ConversionStarted;
+              n->v.string = str8_copy(di_shared->event_arena, rdi_path);
+            }
+            t->is_dispatched = 1;
           }
         }
         
         //- rjf: if active & process has completed, mark as done
         {
-          U64 exit_code = 0;
           if(t->status == DI_LoadTaskStatus_Active)
           {
             B32 task_is_done = 0;
@@ -838,21 +1172,41 @@ di_async_tick(void)
                 break;
               }
             }
-            if(!task_is_done)
+            if(!task_is_done && !os_handle_match(t->process, os_handle_zero()))
             {
               task_is_done = os_process_join(t->process, 0, 0);
             }
+            
+            //- conversion was lost with the server that was running it ->
+            // run it again, in a process of its own
+            B32 task_is_lost = (!task_is_done &&
+                                os_handle_match(t->process, os_handle_zero()) &&
+                                conversion_server_exited &&
+                                t->conversion_server_gen == exited_conversion_server_gen);
+            if(task_is_lost)
+            {
+              t->status = DI_LoadTaskStatus_Null;
+              t->needs_own_process = 1;
+              di_shared->conversion_process_count -= 1;
+              di_shared->conversion_thread_count -= t->thread_count;
+              ins_atomic_u32_eval_assign(&async_loop_again, 1);
+            }
             if(task_is_done)
             {
               t->status = DI_LoadTaskStatus_Done;
               di_shared->conversion_process_count -= 1;
               di_shared->conversion_thread_count -= t->thread_count;
+              if(rdi_is_cached)
+              {
+                t->rdi_cache_hit = di_rdi_cache_publish(t->rdi_cache_id, di_rdi_cache_temp_path_from_id(scratch.arena, t->rdi_cache_id, (U64)t), rdi_path);
+              }
             }
           }
         }
         
-        //- rjf: ready to launch, but bad O.G. file -> just immediately mark as done
-        if(!og_is_good && ready_to_launch_conversion)
+        //- rjf: ready to launch, but bad O.G. file or conversion could not be
+        // launched -> just immediately mark as done
+        if((!og_is_good || conversion_launch_is_bad) && ready_to_launch_conversion)
         {
           t->status = DI_LoadTaskStatus_Done;
         }
@@ -875,7 +1229,7 @@ di_async_tick(void)
         //- rjf: if task is done, retire & recycle task; gather path to load
         if(t->status == DI_LoadTaskStatus_Done)
         {
-          if(!os_handle_match(t->process, os_handle_zero())) MutexScope(di_shared->event_mutex)
+          if(t->is_dispatched) MutexScope(di_shared->event_mutex)
           {
             DI_EventNode *n = push_array(di_shared->event_arena, DI_EventNode, 1);
             SLLQueuePush(di_shared->events.first, di_shared->events.last, n);
@@ -883,11 +1237,15 @@ di_async_tick(void)
             n->v.kind = DI_EventKind_ConversionEnded;
             n->v.string = str8_copy(di_shared->event_arena, rdi_path);
           }
+          if(!os_handle_match(t->process, os_handle_zero()))
+          {
+            os_process_detach(t->process);
+          }
           DLLRemove(di_shared->first_load_task[priority_idx], di_shared->last_load_task[priority_idx], t);
           SLLStackPush(di_shared->free_load_task, t);
           ParseTaskNode *n = push_array(scratch.arena, ParseTaskNode, 1);
           n->v.key = key;
-          n->v.rdi_path = rdi_path;
+          n->v.rdi_path = t->rdi_cache_hit ? di_rdi_cache_path_from_id(scratch.arena, t->rdi_cache_id) : rdi_path;
           SLLQueuePush(first_parse_task, last_parse_task, n);
           parse_tasks_count += 1;
         }
@@ -949,24 +1307,20 @@ di_async_tick(void)
       }
       
       //- rjf: do initial parse of rdi
-      RDI_Parsed rdi_parsed_maybe_compressed = rdi_parsed_nil;
+      RDI_Parsed rdi_parsed = rdi_parsed_nil;
       {
-        RDI_ParseStatus parse_status = rdi_parse((U8 *)file_base, file_props.size, &rdi_parsed_maybe_compressed);
+        RDI_ParseStatus parse_status = rdi_parse((U8 *)file_base, file_props.size, &rdi_parsed);
         (void)parse_status;
       }
       
-      //- rjf: decompress & re-parse, if necessary
-      Arena *rdi_parsed_arena = 0;
-      RDI_Parsed rdi_parsed = rdi_parsed_maybe_compressed;
+      //- set up on-demand unpacking of packed sections, if necessary
+      Arena *rdi_parsed_arena = arena_alloc();
       {
-        U64 decompressed_size = rdi_decompressed_size_from_parsed(&rdi_parsed_maybe_compressed);
-        if(decompressed_size > file_props.size)
+        DI_SectionCache *section_cache = di_section_cache_alloc(rdi_parsed_arena, &rdi_parsed);
+        if(section_cache != 0)
         {
-          rdi_parsed_arena = arena_alloc();
-          U8 *decompressed_data = push_array_no_zero(rdi_parsed_arena, U8, decompressed_size);
-          rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi_parsed_maybe_compressed);
-          RDI_ParseStatus parse_status = rdi_parse(decompressed_data, decompressed_size, &rdi_parsed);
-          (void)parse_status;
+          rdi_parsed.section_unpack_hook = di_section_unpack_hook;
+          rdi_parsed.section_unpack_hook_user_data = section_cache;
         }
       }
       
@@ -995,6 +1349,7 @@ di_async_tick(void)
             node->file_props = file_props;
             node->file_base = file_base;
             node->arena = rdi_parsed_arena;
+            node->rdi_path = str8_copy(rdi_parsed_arena, rdi_path);
             MemoryCopyStruct(&node->rdi, &rdi_parsed);
             node->completion_count += 1;
             node->working_count -= 1;
@@ -1006,10 +1361,8 @@ di_async_tick(void)
           }
           else
           {
-            if(rdi_parsed_arena != 0)
-            {
-              arena_release(rdi_parsed_arena);
-            }
+            di_section_cache_release((DI_SectionCache *)rdi_parsed.section_unpack_hook_user_data);
+            arena_release(rdi_parsed_arena);
             os_file_map_view_close(file_map, file_base, r1u64(0, file_props.size));
             os_file_map_close(file_map);
             os_file_close(file);
@@ -1023,83 +1376,1072 @@ di_async_tick(void)
   }
   lane_sync();
   
+  //////////////////////////////
+  //- evict unpacked section blocks, if over budget
+  //
+  if(lane_idx() == 0)
+  {
+    di_section_cache_evict(DI_SECTION_CACHE_UNPACKED_SIZE_CAP, DI_SECTION_CACHE_UNPACKED_SIZE_CAP - DI_SECTION_CACHE_UNPACKED_SIZE_CAP/4);
+  }
+  
   scratch_end(scratch);
 }
 
 ////////////////////////////////
-//~ rjf: Conversion Completion Signal Receiver Thread
+//~ Shared RDI Cache
 
-internal void
-di_signal_completion(void)
+internal U128
+di_rdi_cache_id_from_og_path(String8 og_path)
 {
-  semaphore_take(di_shared->conversion_completion_lock_semaphore, max_U64);
-  di_shared->conversion_completion_shared_memory_base[0] = di_shared->conversion_completion_code;
-  semaphore_drop(di_shared->conversion_completion_lock_semaphore);
-  semaphore_drop(di_shared->conversion_completion_signal_semaphore);
+  U128 result = {0};
+  Temp scratch = scratch_begin(0, 0);
+  OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, og_path);
+  FileProperties props = os_properties_from_file(file);
+  OS_Handle file_map = os_file_map_open(OS_AccessFlag_Read, file);
+  void *file_base = os_file_map_view_open(file_map, OS_AccessFlag_Read, r1u64(0, props.size));
+  String8 data = str8((U8 *)file_base, file_base != 0 ? props.size : 0);
+  String8 identity = {0};
+  
+  //- PDB -> GUID + age
+  if(identity.size == 0 &&
+     (str8_match(str8_prefix(data, sizeof(msf_msf20_magic)), str8((U8 *)msf_msf20_magic, sizeof(msf_msf20_magic)), 0) ||
+      str8_match(str8_prefix(data, sizeof(msf_msf70_magic)), str8((U8 *)msf_msf70_magic, sizeof(msf_msf70_magic)), 0)))
+  {
+    MSF_RawStreamTable *st = msf_raw_stream_table_from_data(scratch.arena, data);
+    String8 info_data = msf_data_from_stream_number(scratch.arena, data, st, PDB_FixedStream_Info);
+    PDB_Info *info = pdb_info_from_data(scratch.arena, info_data);
+    if(info != 0 && info_data.size >= sizeof(PDB_InfoHeader))
+    {
+      PDB_InfoHeader *info_header = (PDB_InfoHeader *)info_data.str;
+      identity = str8f(scratch.arena, "pdb:%S:%u", string_from_guid(scratch.arena, info->auth_guid), info_header->age);
+    }
+  }
+  
+  //- ELF -> GNU build ID
+  if(identity.size == 0 && str8_match(str8_prefix(data, elf_magic_string.size), elf_magic_string, 0))
+  {
+    ELF_Bin bin = elf_bin_from_data(scratch.arena, data);
+    String8 build_id = elf_gnu_build_id_from_bin(data, &bin);
+    if(build_id.size != 0)
+    {
+      identity = push_str8_cat(scratch.arena, str8_lit("elf:"), build_id);
+    }
+  }
+  
+  //- no embedded identity -> full path + size + timestamp. this runs on the
+  // async tick, so the file's contents are never hashed here.
+  if(identity.size == 0 && data.size != 0)
+  {
+    String8 full_path = os_full_path_from_path(scratch.arena, og_path);
+    identity = str8f(scratch.arena, "file:%S:%I64u:%I64u", full_path, props.size, props.modified);
+  }
+  
+  //- identity -> ID; RDIs of an older encoding or converter live under a different ID
+  if(identity.size != 0)
+  {
+    String8 versioned_identity = str8f(scratch.arena, "%S:converter:%s", identity, DI_RDI_CACHE_CONVERTER_VERSION_STRING_LITERAL);
+    result = u128_hash_from_seed_str8(RDI_ENCODING_VERSION, versioned_identity);
+  }
+  
+  os_file_map_view_close(file_map, file_base, r1u64(0, props.size));
+  os_file_map_close(file_map);
+  os_file_close(file);
+  scratch_end(scratch);
+  return result;
 }
 
-internal void
-di_conversion_completion_signal_receiver_thread_entry_point(void *p)
+internal String8
+di_rdi_cache_path_from_id(Arena *arena, U128 id)
 {
-  ThreadNameF("di_conversion_completion_signal_receiver_thread");
-  for(;;)
+  String8 result = str8f(arena, "%S/%016I64x%016I64x.rdi", di_shared->rdi_cache_dir, id.u64[1], id.u64[0]);
+  return result;
+}
+
+internal String8
+di_rdi_cache_temp_path_from_id(Arena *arena, U128 id, U64 code)
+{
+  String8 result = str8f(arena, "%S/%016I64x%016I64x.rdi.%I64u_%I64x.tmp", di_shared->rdi_cache_dir, id.u64[1], id.u64[0], (U64)os_get_process_info()->pid, code);
+  return result;
+}
+
+internal B32
+di_rdi_cache_lock_take(void)
+{
+  B32 result = semaphore_take(di_shared->rdi_cache_lock_semaphore, os_now_microseconds() + DI_RDI_CACHE_LOCK_TIMEOUT_US);
+  return result;
+}
+
+internal B32
+di_rdi_cache_lookup(U128 id)
+{
+  B32 result = 0;
+  if(!u128_match(id, u128_zero()))
   {
-    if(semaphore_take(di_shared->conversion_completion_signal_semaphore, max_U64))
+    Temp scratch = scratch_begin(0, 0);
+    String8 path = di_rdi_cache_path_from_id(scratch.arena, id);
+    if(di_rdi_cache_lock_take())
     {
-      // rjf: get the next retired code
-      U64 retired_code = 0;
-      semaphore_take(di_shared->conversion_completion_lock_semaphore, max_U64);
-      retired_code = di_shared->conversion_completion_shared_memory_base[0];
-      semaphore_drop(di_shared->conversion_completion_lock_semaphore);
-      
-      // rjf: push completion record
-      MutexScope(di_shared->completion_mutex)
+      // check for a complete RDI
+      OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, path);
+      RDI_Header header = {0};
+      if(os_file_read_struct(file, 0, &header) == sizeof(header) &&
+         header.magic == RDI_MAGIC_CONSTANT &&
+         header.encoding_version == RDI_ENCODING_VERSION)
       {
-        DI_LoadCompletion *c = push_array(di_shared->completion_arena, DI_LoadCompletion, 1);
-        SLLQueuePush(di_shared->first_completion, di_shared->last_completion, c);
-        c->code = retired_code;
+        result = 1;
       }
+      os_file_close(file);
       
-      // rjf: signal async system to resume
-      ProfMsg("signal conversion completion");
-      ins_atomic_u32_eval_assign(&async_loop_again, 1);
-      ins_atomic_u32_eval_assign(&async_loop_again_high_priority, 1);
-      cond_var_broadcast(async_tick_start_cond_var);
+      // hit -> bump entry's last-use stamp, so eviction sees it as recent
+      if(result)
+      {
+        DenseTime now_time = dense_time_from_date_time(os_now_universal_time());
+        os_write_data_to_file_path(push_str8_cat(scratch.arena, path, str8_lit(".lru")), str8_struct(&now_time));
+      }
+      semaphore_drop(di_shared->rdi_cache_lock_semaphore);
     }
+    scratch_end(scratch);
   }
+  return result;
 }
 
-////////////////////////////////
-//~ rjf: Search Artifact Cache Hooks / Lookups
-
-internal AC_Artifact
-di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+internal B32
+di_rdi_cache_publish(U128 id, String8 temp_path, String8 local_path)
 {
-  ProfBeginFunction();
-  Access *access = access_open();
   Temp scratch = scratch_begin(0, 0);
-  AC_Artifact artifact = {0};
+  String8 path = di_rdi_cache_path_from_id(scratch.arena, id);
+  
+  //- check the whole RDI: header, section table, & every section's bounds
+  // must fit in the file, so a truncated conversion never gets published
+  B32 temp_is_good = 0;
   {
-    //- rjf: unpack key
-    RDI_SectionKind section_kind = RDI_SectionKind_NULL;
-    String8 query = {0};
-    {
-      U64 key_read_off = 0;
-      key_read_off += str8_deserial_read_struct(key, key_read_off, &section_kind);
-      key_read_off += str8_deserial_read_struct(key, key_read_off, &query.size);
-      query.str = push_array(scratch.arena, U8, query.size);
-      key_read_off += str8_deserial_read(key, key_read_off, query.str, query.size, 1);
-    }
-    
-    //- rjf: gather all debug info keys we'll search on
-    DI_KeyArray keys = {0};
-    ProfScope("gather all debug info keys we'll search on")
+    OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, temp_path);
+    FileProperties props = os_properties_from_file(file);
+    OS_Handle file_map = os_file_map_open(OS_AccessFlag_Read, file);
+    void *file_base = os_file_map_view_open(file_map, OS_AccessFlag_Read, r1u64(0, props.size));
+    if(file_base != 0)
     {
-      if(lane_idx() == 0)
+      RDI_Parsed rdi = rdi_parsed_nil;
+      if(rdi_parse((U8 *)file_base, props.size, &rdi) == RDI_ParseStatus_Good)
       {
-        keys = di_push_all_loaded_keys(scratch.arena);
+        temp_is_good = 1;
+        for EachIndex(section_idx, rdi.sections_count)
+        {
+          RDI_Section *section = &rdi.sections[section_idx];
+          if(section->off > props.size || section->encoded_size > props.size - section->off)
+          {
+            temp_is_good = 0;
+            break;
+          }
+        }
       }
-      lane_sync_u64(&keys.v, 0);
+    }
+    os_file_map_view_close(file_map, file_base, r1u64(0, props.size));
+    os_file_map_close(file_map);
+    os_file_close(file);
+  }
+  
+  //- move the finished conversion into place. readers only ever look at
+  // the final path, so they never see a partially-written RDI. if another
+  // instance published the same entry first, its copy is kept.
+  B32 is_published = 0;
+  if(temp_is_good && di_rdi_cache_lock_take())
+  {
+    is_published = (os_file_path_exists(path) || os_move_file_path(path, temp_path));
+    semaphore_drop(di_shared->rdi_cache_lock_semaphore);
+  }
+  
+  //- could not publish (cache locked, or the move failed) -> keep the
+  // conversion as the RDI next to the O.G. file, so the stale one isn't loaded
+  if(temp_is_good && !is_published)
+  {
+    os_delete_file_at_path(local_path);
+    if(!os_move_file_path(local_path, temp_path))
+    {
+      os_copy_file_path(local_path, temp_path);
+    }
+  }
+  os_delete_file_at_path(temp_path);
+  
+  //- look up published entry, & trim the cache down to size around it
+  B32 result = (is_published && di_rdi_cache_lookup(id));
+  if(result)
+  {
+    di_rdi_cache_evict(id);
+  }
+  
+  scratch_end(scratch);
+  return result;
+}
+
+internal int
+di_rdi_cache_file_qsort_compare__entry_name(DI_RDICacheFile *a, DI_RDICacheFile *b)
+{
+  int result = strncmp((char *)a->entry_name.str, (char *)b->entry_name.str, Min(a->entry_name.size, b->entry_name.size));
+  if(result == 0)
+  {
+    result = (a->entry_name.size < b->entry_name.size ? -1 : a->entry_name.size > b->entry_name.size ? +1 : 0);
+  }
+  return result;
+}
+
+internal int
+di_rdi_cache_entry_qsort_compare__last_use_time(DI_RDICacheEntry *a, DI_RDICacheEntry *b)
+{
+  int result = (a->last_use_time < b->last_use_time ? -1 : a->last_use_time > b->last_use_time ? +1 : 0);
+  return result;
+}
+
+internal void
+di_rdi_cache_evict(U128 keep_id)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String8 keep_entry_name = str8f(scratch.arena, "%016I64x%016I64x", keep_id.u64[1], keep_id.u64[0]);
+  if(di_rdi_cache_lock_take())
+  {
+    //- gather cache files. an entry is all files sharing the `<id>.rdi`
+    // prefix (the RDI, its `.lru` stamp, its search indices). in-flight or
+    // abandoned temporaries are each their own entry, so that temporaries left
+    // by crashed conversions age out like anything else.
+    typedef struct FileNode FileNode;
+    struct FileNode
+    {
+      FileNode *next;
+      DI_RDICacheFile v;
+    };
+    FileNode *first_file = 0;
+    FileNode *last_file = 0;
+    U64 files_count = 0;
+    U64 total_size = 0;
+    {
+      OS_FileIter *it = os_file_iter_begin(scratch.arena, di_shared->rdi_cache_dir, OS_FileIterFlag_SkipFolders);
+      for(OS_FileInfo info = {0}; os_file_iter_next(scratch.arena, it, &info);)
+      {
+        U64 id_string_size = keep_entry_name.size;
+        if(info.name.size < id_string_size + 4 ||
+           !str8_match(str8_substr(info.name, r1u64(id_string_size, id_string_size + 4)), str8_lit(".rdi"), 0))
+        {
+          continue;
+        }
+        FileNode *n = push_array(scratch.arena, FileNode, 1);
+        SLLQueuePush(first_file, last_file, n);
+        n->v.name = info.name;
+        n->v.entry_name = str8_match(str8_postfix(info.name, 4), str8_lit(".tmp"), 0) ? info.name : str8_prefix(info.name, id_string_size);
+        n->v.size = info.props.size;
+        n->v.modified = info.props.modified;
+        files_count += 1;
+        total_size += info.props.size;
+      }
+      os_file_iter_end(it);
+    }
+    
+    //- over the cap -> group files into entries, & evict oldest first
+    if(total_size > di_shared->rdi_cache_size_cap)
+    {
+      DI_RDICacheFile *files = push_array(scratch.arena, DI_RDICacheFile, files_count);
+      {
+        U64 idx = 0;
+        for EachNode(n, FileNode, first_file)
+        {
+          files[idx] = n->v;
+          idx += 1;
+        }
+      }
+      quick_sort(files, files_count, sizeof(files[0]), di_rdi_cache_file_qsort_compare__entry_name);
+      DI_RDICacheEntry *entries = push_array(scratch.arena, DI_RDICacheEntry, files_count);
+      U64 entries_count = 0;
+      for EachIndex(idx, files_count)
+      {
+        if(entries_count == 0 || !str8_match(files[entries[entries_count-1].first_file_idx].entry_name, files[idx].entry_name, 0))
+        {
+          entries[entries_count].first_file_idx = idx;
+          entries_count += 1;
+        }
+        DI_RDICacheEntry *entry = &entries[entries_count-1];
+        entry->file_count += 1;
+        entry->size += files[idx].size;
+        entry->last_use_time = Max(entry->last_use_time, files[idx].modified);
+      }
+      quick_sort(entries, entries_count, sizeof(entries[0]), di_rdi_cache_entry_qsort_compare__last_use_time);
+      for EachIndex(entry_idx, entries_count)
+      {
+        if(total_size <= di_shared->rdi_cache_size_cap)
+        {
+          break;
+        }
+        DI_RDICacheEntry *entry = &entries[entry_idx];
+        if(str8_match(files[entry->first_file_idx].entry_name, keep_entry_name, 0))
+        {
+          continue;
+        }
+        
+        // deleting a file another instance still has open may fail - that
+        // entry just stays around until a later eviction pass
+        for(U64 file_idx = entry->first_file_idx; file_idx < entry->first_file_idx + entry->file_count; file_idx += 1)
+        {
+          String8 path = str8f(scratch.arena, "%S/%S", di_shared->rdi_cache_dir, files[file_idx].name);
+          if(os_delete_file_at_path(path))
+          {
+            total_size -= files[file_idx].size;
+          }
+        }
+      }
+    }
+    semaphore_drop(di_shared->rdi_cache_lock_semaphore);
+  }
+  scratch_end(scratch);
+}
+
+////////////////////////////////
+//~ Conversion Server
+
+internal void
+di_conversion_server_objects_open(U64 signal_pid, U64 gen, B32 is_server)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String8 lock_semaphore_name = str8f(scratch.arena, "conversion_job_lock_pid_%I64u_gen_%I64u", signal_pid, gen);
+  String8 signal_semaphore_name = str8f(scratch.arena, "conversion_job_signal_pid_%I64u_gen_%I64u", signal_pid, gen);
+  String8 shared_memory_name = str8f(scratch.arena, "conversion_job_shared_memory_pid_%I64u_gen_%I64u", signal_pid, gen);
+  if(is_server)
+  {
+    di_shared->conversion_job_lock_semaphore = semaphore_open(lock_semaphore_name);
+    di_shared->conversion_job_signal_semaphore = semaphore_open(signal_semaphore_name);
+    di_shared->conversion_job_shared_memory = os_shared_memory_open(shared_memory_name);
+  }
+  else
+  {
+    di_shared->conversion_job_lock_semaphore = semaphore_alloc(1, 1, lock_semaphore_name);
+    di_shared->conversion_job_signal_semaphore = semaphore_alloc(0, 65536, signal_semaphore_name);
+    di_shared->conversion_job_shared_memory = os_shared_memory_alloc(sizeof(DI_ConversionJobRing), shared_memory_name);
+  }
+  di_shared->conversion_job_ring = (DI_ConversionJobRing *)os_shared_memory_view_open(di_shared->conversion_job_shared_memory, r1u64(0, sizeof(DI_ConversionJobRing)));
+  di_shared->conversion_server_gen = gen;
+  scratch_end(scratch);
+}
+
+internal void
+di_conversion_server_objects_close(void)
+{
+  if(di_shared->conversion_job_ring != 0)
+  {
+    os_shared_memory_view_close(di_shared->conversion_job_shared_memory, di_shared->conversion_job_ring, r1u64(0, sizeof(DI_ConversionJobRing)));
+    os_shared_memory_close(di_shared->conversion_job_shared_memory);
+    semaphore_release(di_shared->conversion_job_lock_semaphore);
+    semaphore_release(di_shared->conversion_job_signal_semaphore);
+    di_shared->conversion_job_ring = 0;
+    MemoryZeroStruct(&di_shared->conversion_job_shared_memory);
+    MemoryZeroStruct(&di_shared->conversion_job_lock_semaphore);
+    MemoryZeroStruct(&di_shared->conversion_job_signal_semaphore);
+  }
+}
+
+internal B32
+di_conversion_server_launch(void)
+{
+  // NOTE: a previous server may still be winding down after closing itself;
+  // it's killed rather than left running, and the new generation gets new
+  // objects, so the two never share a ring
+  if(!os_handle_match(di_shared->conversion_server_process, os_handle_zero()))
+  {
+    os_process_kill(di_shared->conversion_server_process);
+    os_process_detach(di_shared->conversion_server_process);
+    di_shared->conversion_server_process = os_handle_zero();
+  }
+  di_conversion_server_objects_close();
+  U64 signal_pid = (U64)os_get_process_info()->pid;
+  U64 gen = di_shared->conversion_server_gen + 1;
+  di_conversion_server_objects_open(signal_pid, gen, 0);
+  if(di_shared->conversion_job_ring != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    OS_ProcessLaunchParams params = {0};
+    params.path = os_get_process_info()->binary_path;
+    params.inherit_env = 1;
+    params.consoleless = 1;
+    str8_list_pushf(scratch.arena, &params.cmd_line, "raddbg");
+    str8_list_pushf(scratch.arena, &params.cmd_line, "--bin");
+    str8_list_pushf(scratch.arena, &params.cmd_line, "--conversion_server");
+    str8_list_pushf(scratch.arena, &params.cmd_line, "--signal_pid:%I64u", signal_pid);
+    str8_list_pushf(scratch.arena, &params.cmd_line, "--conversion_server_gen:%I64u", gen);
+    ProfMsg("launch conversion server");
+    di_shared->conversion_server_process = os_process_launch(&params);
+    scratch_end(scratch);
+  }
+  B32 result = !os_handle_match(di_shared->conversion_server_process, os_handle_zero());
+  return result;
+}
+
+internal B32
+di_conversion_job_push(U64 code, String8List *cmd_line, U64 *server_gen_out)
+{
+  B32 result = 0;
+  U64 args_size = 0;
+  for(String8Node *n = cmd_line->first; n != 0; n = n->next)
+  {
+    args_size += n->string.size + 1;
+  }
+  for(B32 retry = 1; retry;)
+  {
+    retry = 0;
+    if(os_handle_match(di_shared->conversion_server_process, os_handle_zero()))
+    {
+      di_conversion_server_launch();
+    }
+    
+    // NOTE: the lock take is bounded - a server which died while holding the
+    // lock would otherwise block this thread forever. it is noticed as exited
+    // on a later tick, and the next launch does not reuse its lock.
+    DI_ConversionJobRing *ring = di_shared->conversion_job_ring;
+    if(!os_handle_match(di_shared->conversion_server_process, os_handle_zero()) &&
+       semaphore_take(di_shared->conversion_job_lock_semaphore, os_now_microseconds() + DI_CONVERSION_JOB_LOCK_TIMEOUT_US))
+    {
+      U64 unconsumed_size = ring->write_pos - ring->read_pos;
+      U64 available_size = sizeof(ring->buffer) - unconsumed_size;
+      B32 server_is_closed = ring->server_is_closed;
+      if(!server_is_closed && available_size >= sizeof(code) + sizeof(args_size) + args_size)
+      {
+        U8 zero = 0;
+        ring->write_pos += ring_write_struct(ring->buffer, sizeof(ring->buffer), ring->write_pos, &code);
+        ring->write_pos += ring_write_struct(ring->buffer, sizeof(ring->buffer), ring->write_pos, &args_size);
+        for(String8Node *n = cmd_line->first; n != 0; n = n->next)
+        {
+          ring->write_pos += ring_write(ring->buffer, sizeof(ring->buffer), ring->write_pos, n->string.str, n->string.size);
+          ring->write_pos += ring_write_struct(ring->buffer, sizeof(ring->buffer), ring->write_pos, &zero);
+        }
+        *server_gen_out = di_shared->conversion_server_gen;
+        result = 1;
+      }
+      semaphore_drop(di_shared->conversion_job_lock_semaphore);
+      
+      // NOTE: a closed server has nothing in flight & is on its way out - the
+      // job goes to a freshly launched generation instead
+      if(server_is_closed)
+      {
+        retry = di_conversion_server_launch();
+      }
+    }
+  }
+  if(result)
+  {
+    semaphore_drop(di_shared->conversion_job_signal_semaphore);
+  }
+  return result;
+}
+
+internal DI_ConversionJob
+di_conversion_job_pop(Arena *arena, U64 idle_timeout_us)
+{
+  DI_ConversionJob job = {0};
+  DI_ConversionJobRing *ring = di_shared->conversion_job_ring;
+  for(B32 done = 0; !done;)
+  {
+    //- job available -> read it & mark this runner as busy
+    if(semaphore_take(di_shared->conversion_job_signal_semaphore, os_now_microseconds() + idle_timeout_us))
+    {
+      String8 args = {0};
+      semaphore_take(di_shared->conversion_job_lock_semaphore, max_U64);
+      if(ring->write_pos - ring->read_pos >= sizeof(job.code) + sizeof(args.size))
+      {
+        ring->read_pos += ring_read_struct(ring->buffer, sizeof(ring->buffer), ring->read_pos, &job.code);
+        ring->read_pos += ring_read_struct(ring->buffer, sizeof(ring->buffer), ring->read_pos, &args.size);
+        args.str = push_array_no_zero(arena, U8, args.size);
+        ring->read_pos += ring_read(ring->buffer, sizeof(ring->buffer), ring->read_pos, args.str, args.size);
+        ring->busy_runner_count += 1;
+        done = 1;
+      }
+      semaphore_drop(di_shared->conversion_job_lock_semaphore);
+      U8 splits[] = {0};
+      job.cmd_line = str8_split(arena, args, splits, ArrayCount(splits), 0);
+    }
+    
+    //- timed out -> if nothing is queued or in flight, close the server; the
+    // parent will relaunch it when it next has work
+    else
+    {
+      semaphore_take(di_shared->conversion_job_lock_semaphore, max_U64);
+      if(ring->server_is_closed || (ring->write_pos == ring->read_pos && ring->busy_runner_count == 0))
+      {
+        ring->server_is_closed = 1;
+        done = 1;
+      }
+      semaphore_drop(di_shared->conversion_job_lock_semaphore);
+    }
+  }
+  return job;
+}
+
+internal void
+di_conversion_job_finish(DI_ConversionJob *job)
+{
+  DI_ConversionJobRing *ring = di_shared->conversion_job_ring;
+  semaphore_take(di_shared->conversion_job_lock_semaphore, max_U64);
+  ring->busy_runner_count -= 1;
+  semaphore_drop(di_shared->conversion_job_lock_semaphore);
+  di_signal_completion_code(job->code);
+}
+
+////////////////////////////////
+//~ rjf: Conversion Completion Signal Receiver Thread
+
+internal void
+di_signal_completion_code(U64 code)
+{
+  // completions are queued, rather than overwriting a single slot, since
+  // many conversions may now retire (from one server) before the receiver wakes.
+  // the space semaphore counts free slots, so a full ring blocks the writer
+  // until the receiver has read a code.
+  DI_ConversionCompletionRing *ring = di_shared->conversion_completion_ring;
+  semaphore_take(di_shared->conversion_completion_space_semaphore, max_U64);
+  semaphore_take(di_shared->conversion_completion_lock_semaphore, max_U64);
+  {
+    ring->codes[ring->write_pos%ArrayCount(ring->codes)] = code;
+    ring->write_pos += 1;
+  }
+  semaphore_drop(di_shared->conversion_completion_lock_semaphore);
+  semaphore_drop(di_shared->conversion_completion_signal_semaphore);
+}
+
+internal void
+di_signal_completion(void)
+{
+  di_signal_completion_code(di_shared->conversion_completion_code);
+}
+
+internal void
+di_conversion_completion_signal_receiver_thread_entry_point(void *p)
+{
+  ThreadNameF("di_conversion_completion_signal_receiver_thread");
+  for(;;)
+  {
+    if(semaphore_take(di_shared->conversion_completion_signal_semaphore, max_U64))
+    {
+      // rjf: get the next retired code
+      U64 retired_code = 0;
+      B32 got_code = 0;
+      semaphore_take(di_shared->conversion_completion_lock_semaphore, max_U64);
+      {
+        DI_ConversionCompletionRing *ring = di_shared->conversion_completion_ring;
+        if(ring->read_pos < ring->write_pos)
+        {
+          retired_code = ring->codes[ring->read_pos%ArrayCount(ring->codes)];
+          ring->read_pos += 1;
+          got_code = 1;
+        }
+      }
+      semaphore_drop(di_shared->conversion_completion_lock_semaphore);
+      if(got_code)
+      {
+        semaphore_drop(di_shared->conversion_completion_space_semaphore);
+      }
+      
+      // rjf: push completion record
+      MutexScope(di_shared->completion_mutex)
+      {
+        DI_LoadCompletion *c = push_array(di_shared->completion_arena, DI_LoadCompletion, 1);
+        SLLQueuePush(di_shared->first_completion, di_shared->last_completion, c);
+        c->code = retired_code;
+      }
+      
+      // rjf: signal async system to resume
+      ProfMsg("signal conversion completion");
+      ins_atomic_u32_eval_assign(&async_loop_again, 1);
+      cond_var_broadcast(async_tick_start_cond_var);
+    }
+  }
+}
+
+////////////////////////////////
+//~ Search Indices
+
+internal String8
+di_search_name_from_element_idx(Arena *arena, RDI_Parsed *rdi, RDI_SectionKind section_kind, U64 idx)
+{
+  String8 name = {0};
+  switch(section_kind)
+  {
+    default:{}break;
+    case RDI_SectionKind_Procedures:
+    {
+      RDI_Procedure *procedure = rdi_element_from_name_idx(rdi, Procedures, idx);
+      name.str = rdi_string_from_idx(rdi, procedure->name_string_idx, &name.size);
+    }break;
+    case RDI_SectionKind_GlobalVariables:
+    {
+      RDI_GlobalVariable *gvar = rdi_element_from_name_idx(rdi, GlobalVariables, idx);
+      name.str = rdi_string_from_idx(rdi, gvar->name_string_idx, &name.size);
+    }break;
+    case RDI_SectionKind_ThreadVariables:
+    {
+      RDI_ThreadVariable *tvar = rdi_element_from_name_idx(rdi, ThreadVariables, idx);
+      name.str = rdi_string_from_idx(rdi, tvar->name_string_idx, &name.size);
+    }break;
+    case RDI_SectionKind_UDTs:
+    {
+      RDI_UDT *udt = rdi_element_from_name_idx(rdi, UDTs, idx);
+      RDI_TypeNode *type_node = rdi_element_from_name_idx(rdi, TypeNodes, udt->self_type_idx);
+      name.str = rdi_string_from_idx(rdi, type_node->user_defined.name_string_idx, &name.size);
+    }break;
+    case RDI_SectionKind_SourceFiles:
+    {
+      Temp scratch = scratch_begin(&arena, 1);
+      RDI_SourceFile *file = rdi_element_from_name_idx(rdi, SourceFiles, idx);
+      String8List path_parts = {0};
+      for(RDI_FilePathNode *fpn = rdi_element_from_name_idx(rdi, FilePathNodes, file->file_path_node_idx);
+          fpn != rdi_element_from_name_idx(rdi, FilePathNodes, 0);
+          fpn = rdi_element_from_name_idx(rdi, FilePathNodes, fpn->parent_path_node))
+      {
+        String8 path_part = {0};
+        path_part.str = rdi_string_from_idx(rdi, fpn->name_string_idx, &path_part.size);
+        str8_list_push_front(scratch.arena, &path_parts, path_part);
+      }
+      StringJoin join = {0};
+      join.sep = str8_lit("/");
+      name = str8_list_join(arena, &path_parts, &join);
+      scratch_end(scratch);
+    }break;
+  }
+  return name;
+}
+
+internal U32
+di_search_trigram_from_str(U8 *str)
+{
+  // NOTE: must normalize the same way as fuzzy matching's
+  // case- & slash-insensitive needle search
+  U32 result = 0;
+  for EachIndex(idx, 3)
+  {
+    result = (result << 8) | correct_slash_from_char(upper_from_char(str[idx]));
+  }
+  return result;
+}
+
+internal String8
+di_search_index_path_from_rdi_path(Arena *arena, String8 rdi_path, RDI_SectionKind section_kind)
+{
+  String8 result = str8f(arena, "%S.search_%u", rdi_path, (U32)section_kind);
+  return result;
+}
+
+internal DI_SearchIndex *
+di_search_index_build(RDI_Parsed *rdi, RDI_SectionKind section_kind)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
+  U64 element_count = rdi_section_element_count_from_kind(rdi, section_kind);
+  element_count = Min(element_count, max_U32);
+  
+  //- count all name windows
+  U64 pairs_count = 0;
+  for EachIndex(idx, element_count)
+  {
+    Temp temp = temp_begin(scratch.arena);
+    String8 name = di_search_name_from_element_idx(scratch.arena, rdi, section_kind, idx);
+    pairs_count += (name.size >= 3) ? (name.size - 2) : 0;
+    temp_end(temp);
+  }
+  
+  //- gather (trigram, element idx) pairs, in element order
+  U64 *pairs = push_array_no_zero(scratch.arena, U64, pairs_count);
+  {
+    U64 pair_idx = 0;
+    for EachIndex(idx, element_count)
+    {
+      Temp temp = temp_begin(scratch.arena);
+      String8 name = di_search_name_from_element_idx(scratch.arena, rdi, section_kind, idx);
+      for(U64 off = 0; off+3 <= name.size && pair_idx < pairs_count; off += 1, pair_idx += 1)
+      {
+        pairs[pair_idx] = ((U64)di_search_trigram_from_str(name.str + off) << 32) | idx;
+      }
+      temp_end(temp);
+    }
+  }
+  
+  //- stable radix sort pairs by trigram; element indices stay ascending per trigram
+  {
+    U64 *src = pairs;
+    U64 *dst = push_array_no_zero(scratch.arena, U64, pairs_count);
+    for EachIndex(digit_idx, 3)
+    {
+      U64 digit_offs[256] = {0};
+      U64 digit_shift = 32 + digit_idx*8;
+      for EachIndex(idx, pairs_count)
+      {
+        digit_offs[(U8)(src[idx] >> digit_shift)] += 1;
+      }
+      U64 off = 0;
+      for EachIndex(value_idx, ArrayCount(digit_offs))
+      {
+        U64 count = digit_offs[value_idx];
+        digit_offs[value_idx] = off;
+        off += count;
+      }
+      for EachIndex(idx, pairs_count)
+      {
+        dst[digit_offs[(U8)(src[idx] >> digit_shift)]++] = src[idx];
+      }
+      Swap(U64 *, src, dst);
+    }
+    pairs = src;
+  }
+  
+  //- count unique trigrams & postings
+  U64 trigrams_count = 0;
+  U64 postings_count = 0;
+  for EachIndex(idx, pairs_count)
+  {
+    if(idx == 0 || pairs[idx] != pairs[idx-1])
+    {
+      postings_count += 1;
+      if(idx == 0 || (pairs[idx] >> 32) != (pairs[idx-1] >> 32))
+      {
+        trigrams_count += 1;
+      }
+    }
+  }
+  
+  //- build index
+  Arena *arena = arena_alloc();
+  DI_SearchIndex *index = push_array(arena, DI_SearchIndex, 1);
+  index->arena          = arena;
+  index->section_kind   = section_kind;
+  index->element_count  = element_count;
+  index->trigrams_count = trigrams_count;
+  index->trigrams       = push_array_no_zero(arena, U32, trigrams_count);
+  index->posting_offs   = push_array_no_zero(arena, U32, trigrams_count+1);
+  index->postings_count = postings_count;
+  index->postings       = push_array_no_zero(arena, U32, postings_count);
+  {
+    U64 trigram_idx = 0;
+    U64 posting_idx = 0;
+    for EachIndex(idx, pairs_count)
+    {
+      if(idx != 0 && pairs[idx] == pairs[idx-1])
+      {
+        continue;
+      }
+      if(idx == 0 || (pairs[idx] >> 32) != (pairs[idx-1] >> 32))
+      {
+        index->trigrams[trigram_idx] = (U32)(pairs[idx] >> 32);
+        index->posting_offs[trigram_idx] = (U32)posting_idx;
+        trigram_idx += 1;
+      }
+      index->postings[posting_idx] = (U32)pairs[idx];
+      posting_idx += 1;
+    }
+    index->posting_offs[trigrams_count] = (U32)postings_count;
+  }
+  
+  scratch_end(scratch);
+  ProfEnd();
+  return index;
+}
+
+internal DI_SearchIndex *
+di_search_index_load(String8 path, FileProperties rdi_props, RDI_SectionKind section_kind, U64 element_count)
+{
+  DI_SearchIndex *index = 0;
+  Arena *arena = arena_alloc();
+  String8 data = os_data_from_file_path(arena, path);
+  DI_SearchIndexFileHeader hdr = {0};
+  str8_deserial_read_struct(data, 0, &hdr);
+  U64 trigrams_off     = sizeof(hdr);
+  U64 posting_offs_off = trigrams_off + hdr.trigrams_count*sizeof(U32);
+  U64 postings_off     = posting_offs_off + (hdr.trigrams_count+1)*sizeof(U32);
+  U64 opl              = postings_off + hdr.postings_count*sizeof(U32);
+  if(hdr.magic == DI_SEARCH_INDEX_FILE_MAGIC &&
+     hdr.rdi_modified == rdi_props.modified &&
+     hdr.rdi_size == rdi_props.size &&
+     hdr.section_kind == (U32)section_kind &&
+     hdr.element_count == element_count &&
+     data.size == opl)
+  {
+    index = push_array(arena, DI_SearchIndex, 1);
+    index->arena          = arena;
+    index->section_kind   = section_kind;
+    index->element_count  = element_count;
+    index->trigrams_count = hdr.trigrams_count;
+    index->trigrams       = (U32 *)(data.str + trigrams_off);
+    index->posting_offs   = (U32 *)(data.str + posting_offs_off);
+    index->postings_count = hdr.postings_count;
+    index->postings       = (U32 *)(data.str + postings_off);
+    if(index->posting_offs[index->trigrams_count] != index->postings_count)
+    {
+      index = 0;
+    }
+  }
+  if(index == 0)
+  {
+    arena_release(arena);
+  }
+  return index;
+}
+
+internal void
+di_search_index_store(DI_SearchIndex *index, String8 path, FileProperties rdi_props)
+{
+  Temp scratch = scratch_begin(0, 0);
+  DI_SearchIndexFileHeader hdr = {0};
+  hdr.magic          = DI_SEARCH_INDEX_FILE_MAGIC;
+  hdr.rdi_modified   = rdi_props.modified;
+  hdr.rdi_size       = rdi_props.size;
+  hdr.section_kind   = (U32)index->section_kind;
+  hdr.element_count  = (U32)index->element_count;
+  hdr.trigrams_count = (U32)index->trigrams_count;
+  hdr.postings_count = (U32)index->postings_count;
+  String8List blobs = {0};
+  str8_list_push(scratch.arena, &blobs, str8_struct(&hdr));
+  str8_list_push(scratch.arena, &blobs, str8((U8 *)index->trigrams, index->trigrams_count*sizeof(U32)));
+  str8_list_push(scratch.arena, &blobs, str8((U8 *)index->posting_offs, (index->trigrams_count+1)*sizeof(U32)));
+  str8_list_push(scratch.arena, &blobs, str8((U8 *)index->postings, index->postings_count*sizeof(U32)));
+  
+  // NOTE: write to a temporary path & move into place, so that other
+  // instances never observe a partially written index; failing to write is
+  // fine - the index will just be rebuilt next time.
+  String8 temp_path = str8f(scratch.arena, "%S.%u.tmp", path, os_get_process_info()->pid);
+  if(os_write_data_list_to_file_path(temp_path, blobs))
+  {
+    os_delete_file_at_path(path);
+    if(!os_move_file_path(path, temp_path))
+    {
+      os_delete_file_at_path(temp_path);
+    }
+  }
+  scratch_end(scratch);
+}
+
+internal DI_SearchIndex *
+di_search_index_from_key(DI_Key key, RDI_Parsed *rdi, RDI_SectionKind section_kind)
+{
+  Temp scratch = scratch_begin(0, 0);
+  DI_SearchIndex *index = 0;
+  
+  //- determine if this section is worth indexing
+  U64 element_count = rdi_section_element_count_from_kind(rdi, section_kind);
+  B32 is_indexable = 0;
+  switch(section_kind)
+  {
+    default:{}break;
+    case RDI_SectionKind_Procedures:
+    case RDI_SectionKind_GlobalVariables:
+    case RDI_SectionKind_ThreadVariables:
+    case RDI_SectionKind_UDTs:
+    case RDI_SectionKind_SourceFiles:
+    {
+      is_indexable = (DI_SEARCH_INDEX_MIN_ELEMENT_COUNT <= element_count && element_count <= max_U32);
+    }break;
+  }
+  
+  //- rjf: unpack key
+  U64 hash = u64_hash_from_str8(str8_struct(&key));
+  U64 slot_idx = hash%di_shared->slots_count;
+  DI_Slot *slot = &di_shared->slots[slot_idx];
+  Stripe *stripe = stripe_from_slot_idx(&di_shared->stripes, slot_idx);
+  
+  //- look up existing index, or node's file info
+  B32 node_found = 0;
+  String8 rdi_path = {0};
+  FileProperties rdi_props = {0};
+  if(is_indexable) RWMutexScope(stripe->rw_mutex, 0)
+  {
+    for(DI_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(di_key_match(n->key, key) && ins_atomic_u64_eval(&n->completion_count) > 0)
+      {
+        node_found = 1;
+        rdi_path = str8_copy(scratch.arena, n->rdi_path);
+        rdi_props = n->file_props;
+        for(DI_SearchIndex *idx = n->first_search_index; idx != 0; idx = idx->next)
+        {
+          if(idx->section_kind == section_kind && idx->element_count == element_count)
+          {
+            index = idx;
+            break;
+          }
+        }
+        break;
+      }
+    }
+  }
+  
+  //- no cached index -> load persisted index, or build & persist
+  if(node_found && index == 0)
+  {
+    String8 index_path = di_search_index_path_from_rdi_path(scratch.arena, rdi_path, section_kind);
+    DI_SearchIndex *new_index = di_search_index_load(index_path, rdi_props, section_kind, element_count);
+    if(new_index == 0)
+    {
+      new_index = di_search_index_build(rdi, section_kind);
+      di_search_index_store(new_index, index_path, rdi_props);
+    }
+    
+    //- commit to node; if another thread won the race, use its index
+    RWMutexScope(stripe->rw_mutex, 1)
+    {
+      DI_Node *node = 0;
+      for(DI_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(di_key_match(n->key, key) && ins_atomic_u64_eval(&n->completion_count) > 0)
+        {
+          node = n;
+          break;
+        }
+      }
+      if(node != 0)
+      {
+        for(DI_SearchIndex *idx = node->first_search_index; idx != 0; idx = idx->next)
+        {
+          if(idx->section_kind == section_kind && idx->element_count == element_count)
+          {
+            index = idx;
+            break;
+          }
+        }
+        if(index == 0)
+        {
+          SLLStackPush(node->first_search_index, new_index);
+          index = new_index;
+          new_index = 0;
+        }
+      }
+    }
+    if(new_index != 0)
+    {
+      arena_release(new_index->arena);
+    }
+  }
+  
+  scratch_end(scratch);
+  return index;
+}
+
+internal B32
+di_search_candidates_from_index_query(Arena *arena, DI_SearchIndex *index, String8 query, U32Array *candidates_out)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //- gather posting lists for all of the query's trigrams
+  typedef struct PostingList PostingList;
+  struct PostingList
+  {
+    PostingList *next;
+    U32 *v;
+    U64 count;
+  };
+  PostingList *first_list = 0;
+  U64 lists_count = 0;
+  B32 trigram_missing = 0;
+  String8List needles = str8_split(scratch.arena, query, (U8 *)" ", 1, 0);
+  for(String8Node *n = needles.first; n != 0 && !trigram_missing; n = n->next)
+  {
+    for(U64 off = 0; off+3 <= n->string.size; off += 1)
+    {
+      U32 trigram = di_search_trigram_from_str(n->string.str + off);
+      U64 lo = 0;
+      U64 hi = index->trigrams_count;
+      for(;lo < hi;)
+      {
+        U64 mid = lo + (hi-lo)/2;
+        if(index->trigrams[mid] < trigram)
+        {
+          lo = mid+1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      if(lo >= index->trigrams_count || index->trigrams[lo] != trigram)
+      {
+        trigram_missing = 1;
+        break;
+      }
+      PostingList *list = push_array(scratch.arena, PostingList, 1);
+      list->v = index->postings + index->posting_offs[lo];
+      list->count = index->posting_offs[lo+1] - index->posting_offs[lo];
+      SLLStackPush(first_list, list);
+      lists_count += 1;
+    }
+  }
+  
+  //- intersect, starting with the shortest list
+  B32 is_filtered = (trigram_missing || lists_count != 0);
+  U32Array candidates = {0};
+  if(lists_count != 0 && !trigram_missing)
+  {
+    PostingList *shortest = first_list;
+    for(PostingList *list = first_list; list != 0; list = list->next)
+    {
+      if(list->count < shortest->count)
+      {
+        shortest = list;
+      }
+    }
+    candidates.v = push_array_no_zero(arena, U32, shortest->count);
+    candidates.count = shortest->count;
+    MemoryCopy(candidates.v, shortest->v, sizeof(U32)*shortest->count);
+    for(PostingList *list = first_list; list != 0 && candidates.count != 0; list = list->next)
+    {
+      if(list == shortest)
+      {
+        continue;
+      }
+      U64 write_idx = 0;
+      U64 list_idx = 0;
+      for EachIndex(read_idx, candidates.count)
+      {
+        U32 element_idx = candidates.v[read_idx];
+        for(;list_idx < list->count && list->v[list_idx] < element_idx; list_idx += 1);
+        if(list_idx >= list->count)
+        {
+          break;
+        }
+        if(list->v[list_idx] == element_idx)
+        {
+          candidates.v[write_idx] = element_idx;
+          write_idx += 1;
+        }
+      }
+      candidates.count = write_idx;
+    }
+  }
+  
+  scratch_end(scratch);
+  *candidates_out = candidates;
+  return is_filtered;
+}
+
+////////////////////////////////
+//~ rjf: Search Artifact Cache Hooks / Lookups
+
+internal AC_Artifact
+di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+{
+  ProfBeginFunction();
+  Access *access = access_open();
+  Temp scratch = scratch_begin(0, 0);
+  AC_Artifact artifact = {0};
+  {
+    //- rjf: unpack key
+    RDI_SectionKind section_kind = RDI_SectionKind_NULL;
+    String8 query = {0};
+    {
+      U64 key_read_off = 0;
+      key_read_off += str8_deserial_read_struct(key, key_read_off, &section_kind);
+      key_read_off += str8_deserial_read_struct(key, key_read_off, &query.size);
+      query.str = push_array(scratch.arena, U8, query.size);
+      key_read_off += str8_deserial_read(key, key_read_off, query.str, query.size, 1);
+    }
+    
+    //- rjf: gather all debug info keys we'll search on
+    DI_KeyArray keys = {0};
+    ProfScope("gather all debug info keys we'll search on")
+    {
+      if(lane_idx() == 0)
+      {
+        keys = di_push_all_loaded_keys(scratch.arena);
+      }
+      lane_sync_u64(&keys.v, 0);
       lane_sync_u64(&keys.count, 0);
     }
     
@@ -1122,6 +2464,37 @@ di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *
     }
     lane_sync();
     
+    //- map all RDIs -> candidate element indices, via (lazily built) search indices
+    U32Array *rdis_candidates = 0;
+    B32 *rdis_candidates_are_filtered = 0;
+    ProfScope("map all RDIs -> candidate element indices")
+    {
+      U64 rdi_take_counter = 0;
+      U64 *rdi_take_counter_ptr = &rdi_take_counter;
+      if(lane_idx() == 0)
+      {
+        rdis_candidates = push_array(scratch.arena, U32Array, keys.count);
+        rdis_candidates_are_filtered = push_array(scratch.arena, B32, keys.count);
+      }
+      lane_sync_u64(&rdis_candidates, 0);
+      lane_sync_u64(&rdis_candidates_are_filtered, 0);
+      lane_sync_u64(&rdi_take_counter_ptr, 0);
+      for(;;)
+      {
+        U64 rdi_idx = ins_atomic_u64_inc_eval(rdi_take_counter_ptr) - 1;
+        if(rdi_idx >= keys.count)
+        {
+          break;
+        }
+        DI_SearchIndex *index = di_search_index_from_key(keys.v[rdi_idx], rdis[rdi_idx], section_kind);
+        if(index != 0)
+        {
+          rdis_candidates_are_filtered[rdi_idx] = di_search_candidates_from_index_query(scratch.arena, index, query, &rdis_candidates[rdi_idx]);
+        }
+      }
+    }
+    lane_sync();
+    
     //- rjf: do wide search on all lanes
     Arena *arena = arena_alloc();
     Arena **arenas = 0;
@@ -1147,85 +2520,24 @@ di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *
           DI_Key key = keys.v[rdi_idx];
           RDI_Parsed *rdi = rdis[rdi_idx];
           
-          // rjf: unpack table info
-          U64 element_count = 0;
-          void *table_base = rdi_section_raw_table_from_kind(rdi, section_kind, &element_count);
-          U64 element_size = rdi_section_element_size_table[section_kind];
+          // unpack candidates; all elements if no index could narrow them down
+          U64 element_count = rdi_section_element_count_from_kind(rdi, section_kind);
+          B32 candidates_are_filtered = rdis_candidates_are_filtered[rdi_idx];
+          U32Array candidates = rdis_candidates[rdi_idx];
+          U64 candidates_count = candidates_are_filtered ? candidates.count : element_count;
           
-          // rjf: determine name string index offset, depending on table kind
-          U64 element_name_idx_off = 0;
-          switch(section_kind)
-          {
-            default:{}break;
-            case RDI_SectionKind_Procedures:
-            {
-              element_name_idx_off = OffsetOf(RDI_Procedure, name_string_idx);
-            }break;
-            case RDI_SectionKind_GlobalVariables:
-            {
-              element_name_idx_off = OffsetOf(RDI_GlobalVariable, name_string_idx);
-            }break;
-            case RDI_SectionKind_ThreadVariables:
-            {
-              element_name_idx_off = OffsetOf(RDI_ThreadVariable, name_string_idx);
-            }break;
-            case RDI_SectionKind_UDTs:
-            {
-              // NOTE(rjf): name must be determined from self_type_idx
-            }break;
-            case RDI_SectionKind_SourceFiles:
-            {
-              // NOTE(rjf): name must be determined from file path node chain
-            }break;
-          }
-          
-          Rng1U64 range = lane_range(element_count);
-          for EachInRange(idx, range)
+          Rng1U64 range = lane_range(candidates_count);
+          for EachInRange(candidate_idx, range)
           {
             //- rjf: every so often, check if we need to cancel, and cancel
-            if(idx%10000 == 0 && !!ins_atomic_u32_eval(cancel_signal))
+            if(candidate_idx%10000 == 0 && !!ins_atomic_u32_eval(cancel_signal))
             {
               break;
             }
             
             //- rjf: get element, map to string; if empty, continue to next element
-            void *element = (U8 *)table_base + element_size*idx;
-            String8 name = {0};
-            switch(section_kind)
-            {
-              case RDI_SectionKind_UDTs:
-              {
-                RDI_UDT *udt = (RDI_UDT *)element;
-                RDI_TypeNode *type_node = rdi_element_from_name_idx(rdi, TypeNodes, udt->self_type_idx);
-                name.str = rdi_string_from_idx(rdi, type_node->user_defined.name_string_idx, &name.size);
-                name = str8_copy(arena, name);
-              }break;
-              case RDI_SectionKind_SourceFiles:
-              {
-                Temp scratch = scratch_begin(&arena, 1);
-                RDI_SourceFile *file = (RDI_SourceFile *)element;
-                String8List path_parts = {0};
-                for(RDI_FilePathNode *fpn = rdi_element_from_name_idx(rdi, FilePathNodes, file->file_path_node_idx);
-                    fpn != rdi_element_from_name_idx(rdi, FilePathNodes, 0);
-                    fpn = rdi_element_from_name_idx(rdi, FilePathNodes, fpn->parent_path_node))
-                {
-                  String8 path_part = {0};
-                  path_part.str = rdi_string_from_idx(rdi, fpn->name_string_idx, &path_part.size);
-                  str8_list_push_front(scratch.arena, &path_parts, path_part);
-                }
-                StringJoin join = {0};
-                join.sep = str8_lit("/");
-                name = str8_list_join(arena, &path_parts, &join);
-                scratch_end(scratch);
-              }break;
-              default:
-              {
-                U32 name_idx = *(U32 *)((U8 *)element + element_name_idx_off);
-                U64 name_size = 0;
-                U8 *name_base = rdi_string_from_idx(rdi, name_idx, &name_size);
-                name = str8(name_base, name_size);
-              }break;
-            }
+            U64 idx = candidates_are_filtered ? candidates.v[candidate_idx] : candidate_idx;
+            String8 name = di_search_name_from_element_idx(arena, rdi, section_kind, idx);
             if(name.size == 0) { continue; }
             
             //- rjf: fuzzy match against query
@@ -1457,6 +2769,15 @@ di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *
       artifact.u64[1] = arenas_count;
       artifact.u64[2] = (U64)items.v;
       artifact.u64[3] = items.count;
+      if(lane_idx() == 0)
+      {
+        U64 size = 0;
+        for EachIndex(idx, arenas_count)
+        {
+          size += arena_pos(arenas[idx]);
+        }
+        ac_report_artifact_size(size);
+      }
     }
     
     //- rjf: release results on cancel
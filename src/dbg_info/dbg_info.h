@@ -55,6 +55,95 @@ struct DI_KeySlot
   DI_KeyPathNode *last;
 };
 
+////////////////////////////////
+//~ Packed Section Cache Types
+
+// NOTE: packed (compressed) RDI sections are unpacked on demand, block
+// by block, into address space reserved for the entire unpacked section, so
+// that pointers into unpacked sections stay stable & only touched blocks
+// cost memory. once all unpacked blocks add up to more than the cap, blocks of
+// RDIs which no reader is accessing are decommitted, least recently touched
+// first, & unpacked again if touched later.
+
+#define DI_SECTION_CACHE_UNPACKED_SIZE_CAP MB(256)
+
+typedef enum DI_SectionBlockState
+{
+  DI_SectionBlockState_Packed,
+  DI_SectionBlockState_Unpacking,
+  DI_SectionBlockState_Unpacked,
+}
+DI_SectionBlockState;
+
+typedef struct DI_UnpackedSection DI_UnpackedSection;
+struct DI_UnpackedSection
+{
+  U8 *base;
+  U64 reserve_size;
+  U64 block_size;
+  U64 block_count;
+  U64 *block_states;
+  U64 *block_touch_idxs;
+  U64 unpacked_block_count;
+};
+
+typedef struct DI_SectionCache DI_SectionCache;
+struct DI_SectionCache
+{
+  DI_UnpackedSection *sections;
+  U64 sections_count;
+  U64 unpacked_size;
+};
+
+typedef struct DI_EvictableBlock DI_EvictableBlock;
+struct DI_EvictableBlock
+{
+  DI_Key key;
+  DI_SectionCache *cache;
+  U64 section_idx;
+  U64 block_idx;
+  U64 touch_idx;
+};
+
+////////////////////////////////
+//~ Search Index Types
+
+// NOTE: a search index maps every case- & slash-normalized 3-byte window
+// of each element name in one RDI section to the sorted list of elements whose
+// names contain it - postings[posting_offs[i], posting_offs[i+1]) for
+// trigrams[i]. every needle part matched by fuzzy searching must occur in the
+// name, so the element set to match against can be narrowed to the
+// intersection of all of the query's trigram posting lists.
+
+#define DI_SEARCH_INDEX_FILE_MAGIC 0x3130786469726764ull
+#define DI_SEARCH_INDEX_MIN_ELEMENT_COUNT 4096
+
+typedef struct DI_SearchIndexFileHeader DI_SearchIndexFileHeader;
+struct DI_SearchIndexFileHeader
+{
+  U64 magic;
+  U64 rdi_modified;
+  U64 rdi_size;
+  U32 section_kind;
+  U32 element_count;
+  U32 trigrams_count;
+  U32 postings_count;
+};
+
+typedef struct DI_SearchIndex DI_SearchIndex;
+struct DI_SearchIndex
+{
+  DI_SearchIndex *next;
+  Arena *arena;
+  RDI_SectionKind section_kind;
+  U64 element_count;
+  U64 trigrams_count;
+  U32 *trigrams;
+  U32 *posting_offs;
+  U64 postings_count;
+  U32 *postings;
+};
+
 ////////////////////////////////
 //~ rjf: Debug Info Cache Types
 
@@ -75,6 +164,10 @@ struct DI_Node
   FileProperties file_props;
   Arena *arena;
   RDI_Parsed rdi;
+  String8 rdi_path;
+  
+  // lazily-built search indices
+  DI_SearchIndex *first_search_index;
   
   // rjf: metadata
   AccessPt access_pt;
@@ -144,8 +237,15 @@ struct DI_LoadTask
   B32 rdi_analyzed;
   B32 rdi_is_stale;
   
+  B32 rdi_cache_analyzed;
+  B32 rdi_cache_hit;
+  U128 rdi_cache_id;
+  
   U64 thread_count;
+  B32 is_dispatched;
   OS_Handle process;
+  U64 conversion_server_gen;
+  B32 needs_own_process;
 };
 
 typedef struct DI_LoadCompletion DI_LoadCompletion;
@@ -155,6 +255,90 @@ struct DI_LoadCompletion
   U64 code;
 };
 
+////////////////////////////////
+//~ Conversion Server Types
+
+// NOTE: by default, every conversion runs in its own `--bin` child process.
+// with `--use_conversion_server`, conversions are instead handed to one
+// long-lived `--bin --conversion_server` child process, through a job ring in
+// shared memory. the server's runner threads each pull the next job off of the
+// ring as soon as they free up, and report each finished job through the
+// conversion completion ring.
+//
+// every server launch is a new generation, with its own ring & semaphores, so
+// a server which died holding the ring lock, or a stale server which is still
+// shutting down, can't block or steal jobs from the next one. jobs which were
+// in flight on a server that died are re-run, each in its own process, so one
+// crashing conversion does not take others down with it.
+
+#define DI_CONVERSION_JOB_RING_SIZE MB(1)
+#define DI_CONVERSION_SERVER_IDLE_TIMEOUT_US 30000000
+#define DI_CONVERSION_JOB_LOCK_TIMEOUT_US 1000000
+
+typedef struct DI_ConversionJobRing DI_ConversionJobRing;
+struct DI_ConversionJobRing
+{
+  U64 write_pos;
+  U64 read_pos;
+  U64 busy_runner_count;
+  B32 server_is_closed;
+  U8 buffer[DI_CONVERSION_JOB_RING_SIZE];
+};
+
+typedef struct DI_ConversionJob DI_ConversionJob;
+struct DI_ConversionJob
+{
+  U64 code;
+  String8List cmd_line;
+};
+
+#define DI_CONVERSION_COMPLETION_RING_CAP ((KB(4) - 2*sizeof(U64)) / sizeof(U64))
+
+typedef struct DI_ConversionCompletionRing DI_ConversionCompletionRing;
+struct DI_ConversionCompletionRing
+{
+  U64 write_pos;
+  U64 read_pos;
+  U64 codes[DI_CONVERSION_COMPLETION_RING_CAP];
+};
+
+////////////////////////////////
+//~ Shared RDI Cache Types
+
+// NOTE: when a cache directory is configured (`--rdi_cache:<path>`), RDIs
+// converted from O.G. debug info are stored there, named by the identity of
+// that debug info (PDB GUID + age, ELF build ID, or else full path + size +
+// timestamp), so that every debugger instance on a machine can share them. entries are
+// published with a move from a temporary path, & evicted least-recently-used
+// first, by each entry's `.lru` stamp file, once the directory exceeds its cap.
+// the RDI encoding version & the converting build's version are mixed into each
+// ID, so a converter change never serves RDIs produced by an older build.
+// the directory's lock is a named semaphore, & is only ever taken with a
+// timeout: on Linux, a named semaphore outlives a holder that crashed, so a
+// lock that can't be taken is treated as a cache miss, not waited on forever.
+
+#define DI_RDI_CACHE_SIZE_CAP_DEFAULT GB(8)
+#define DI_RDI_CACHE_LOCK_TIMEOUT_US 5000000
+#define DI_RDI_CACHE_CONVERTER_VERSION_STRING_LITERAL BUILD_VERSION_STRING_LITERAL BUILD_GIT_HASH_STRING_LITERAL_APPEND
+
+typedef struct DI_RDICacheFile DI_RDICacheFile;
+struct DI_RDICacheFile
+{
+  String8 name;
+  String8 entry_name;
+  U64 size;
+  DenseTime modified;
+};
+
+typedef struct DI_RDICacheEntry DI_RDICacheEntry;
+struct DI_RDICacheEntry
+{
+  U64 first_file_idx;
+  U64 file_count;
+  U64 size;
+  DenseTime last_use_time;
+};
+
 ////////////////////////////////
 //~ rjf: Search Types
 
@@ -263,6 +447,9 @@ struct DI_Shared
   DI_Slot *slots;
   StripeArray stripes;
   
+  // unpacked section block cache
+  U64 section_cache_unpacked_size;
+  
   // rjf: requests
   DI_RequestBatch req_batches[2]; // [0] -> high priority, [1] -> low priority
   
@@ -273,15 +460,31 @@ struct DI_Shared
   U64 conversion_process_count;
   U64 conversion_thread_count;
   
+  // shared RDI cache
+  String8 rdi_cache_dir;
+  U64 rdi_cache_size_cap;
+  Semaphore rdi_cache_lock_semaphore;
+  
+  // conversion server
+  B32 use_conversion_server;
+  OS_Handle conversion_server_process;
+  U64 conversion_server_gen;
+  Semaphore conversion_job_lock_semaphore;
+  Semaphore conversion_job_signal_semaphore;
+  OS_Handle conversion_job_shared_memory;
+  DI_ConversionJobRing *conversion_job_ring;
+  
   // rjf: conversion completion receiving thread
   U64 conversion_completion_code;
   String8 conversion_completion_lock_semaphore_name;
   String8 conversion_completion_signal_semaphore_name;
+  String8 conversion_completion_space_semaphore_name;
   String8 conversion_completion_shared_memory_name;
   Semaphore conversion_completion_lock_semaphore;
   Semaphore conversion_completion_signal_semaphore;
+  Semaphore conversion_completion_space_semaphore;
   OS_Handle conversion_completion_shared_memory;
-  U64 *conversion_completion_shared_memory_base;
+  DI_ConversionCompletionRing *conversion_completion_ring;
   Thread conversion_completion_signal_receiver_thread;
   
   // rjf: completion batch
@@ -338,17 +541,62 @@ internal RDI_Parsed *di_rdi_from_key(Access *access, DI_Key key, B32 high_priori
 
 internal DI_EventList di_get_events(Arena *arena);
 
+////////////////////////////////
+//~ Packed Section Cache
+
+internal DI_SectionCache *di_section_cache_alloc(Arena *arena, RDI_Parsed *rdi);
+internal void di_section_cache_release(DI_SectionCache *cache);
+internal void *di_section_unpack_hook(void *user_data, RDI_Parsed *rdi, RDI_SectionKind kind, U64 min, U64 opl);
+internal int di_evictable_block_qsort_compare__touch_idx(DI_EvictableBlock *a, DI_EvictableBlock *b);
+internal void di_section_cache_evict(U64 cap, U64 target_size);
+
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
 
 internal void di_async_tick(void);
 
+////////////////////////////////
+//~ Shared RDI Cache
+
+internal U128 di_rdi_cache_id_from_og_path(String8 og_path);
+internal String8 di_rdi_cache_path_from_id(Arena *arena, U128 id);
+internal String8 di_rdi_cache_temp_path_from_id(Arena *arena, U128 id, U64 code);
+internal B32 di_rdi_cache_lock_take(void);
+internal B32 di_rdi_cache_lookup(U128 id);
+internal B32 di_rdi_cache_publish(U128 id, String8 temp_path, String8 local_path);
+internal int di_rdi_cache_file_qsort_compare__entry_name(DI_RDICacheFile *a, DI_RDICacheFile *b);
+internal int di_rdi_cache_entry_qsort_compare__last_use_time(DI_RDICacheEntry *a, DI_RDICacheEntry *b);
+internal void di_rdi_cache_evict(U128 keep_id);
+
+////////////////////////////////
+//~ Conversion Server
+
+internal void di_conversion_server_objects_open(U64 signal_pid, U64 gen, B32 is_server);
+internal void di_conversion_server_objects_close(void);
+internal B32 di_conversion_server_launch(void);
+internal B32 di_conversion_job_push(U64 code, String8List *cmd_line, U64 *server_gen_out);
+internal DI_ConversionJob di_conversion_job_pop(Arena *arena, U64 idle_timeout_us);
+internal void di_conversion_job_finish(DI_ConversionJob *job);
+
 ////////////////////////////////
 //~ rjf: Conversion Completion Signal Receiver Thread
 
+internal void di_signal_completion_code(U64 code);
 internal void di_signal_completion(void);
 internal void di_conversion_completion_signal_receiver_thread_entry_point(void *p);
 
+////////////////////////////////
+//~ Search Indices
+
+internal String8 di_search_name_from_element_idx(Arena *arena, RDI_Parsed *rdi, RDI_SectionKind section_kind, U64 idx);
+internal U32 di_search_trigram_from_str(U8 *str);
+internal String8 di_search_index_path_from_rdi_path(Arena *arena, String8 rdi_path, RDI_SectionKind section_kind);
+internal DI_SearchIndex *di_search_index_build(RDI_Parsed *rdi, RDI_SectionKind section_kind);
+internal DI_SearchIndex *di_search_index_load(String8 path, FileProperties rdi_props, RDI_SectionKind section_kind, U64 element_count);
+internal void di_search_index_store(DI_SearchIndex *index, String8 path, FileProperties rdi_props);
+internal DI_SearchIndex *di_search_index_from_key(DI_Key key, RDI_Parsed *rdi, RDI_SectionKind section_kind);
+internal B32 di_search_candidates_from_index_query(Arena *arena, DI_SearchIndex *index, String8 query, U32Array *candidates_out);
+
 ////////////////////////////////
 //~ rjf: Search Artifact Cache Hooks / Lookups
 
@@ -149,6 +149,17 @@ struct DMN_RunCtrls
   DMN_TrapChunkList traps;
 };
 
+////////////////////////////////
+//~ Batched Memory Read Types
+
+typedef struct DMN_ReadRequest DMN_ReadRequest;
+struct DMN_ReadRequest
+{
+  Rng1U64 range;
+  void *dst;
+  U64 bytes_read;
+};
+
 ////////////////////////////////
 //~ rjf: System Process Listing Types
 
@@ -234,7 +245,9 @@ internal void dmn_process_memory_decommit(DMN_Handle process, U64 vaddr, U64 siz
 internal void dmn_process_memory_release(DMN_Handle process, U64 vaddr, U64 size);
 internal void dmn_process_memory_protect(DMN_Handle process, U64 vaddr, U64 size, OS_AccessFlags flags);
 internal U64 dmn_process_read(DMN_Handle process, Rng1U64 range, void *dst);
+internal void dmn_process_read_batch(DMN_Handle process, DMN_ReadRequest *requests, U64 requests_count);
 internal B32 dmn_process_write(DMN_Handle process, Rng1U64 range, void *src);
+internal B32 dmn_process_read_dirty_page_flags(DMN_Handle process, Rng1U64 range, U64 *dirty_flags_out);
 #define dmn_process_read_struct(process, vaddr, ptr) dmn_process_read((process), r1u64((vaddr), (vaddr)+(sizeof(*ptr))), ptr)
 #define dmn_process_write_struct(process, vaddr, ptr) dmn_process_write((process), r1u64((vaddr), (vaddr)+(sizeof(*ptr))), ptr)
 
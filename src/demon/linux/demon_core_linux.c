@@ -50,6 +50,65 @@ dmn_lnx_write(int memory_fd, Rng1U64 range, void *src)
   return result;
 }
 
+internal void
+dmn_lnx_read_batch(pid_t pid, int memory_fd, DMN_ReadRequest *requests, U64 requests_count)
+{
+  Temp scratch = scratch_begin(0, 0);
+  U64 iov_cap = Min(requests_count, DMN_LNX_IOV_MAX);
+  struct iovec *local_iov = push_array_no_zero(scratch.arena, struct iovec, iov_cap);
+  struct iovec *remote_iov = push_array_no_zero(scratch.arena, struct iovec, iov_cap);
+  B32 vm_readv_is_usable = 1;
+  for(U64 base_idx = 0; base_idx < requests_count;)
+  {
+    U64 count = Min(requests_count - base_idx, iov_cap);
+    U64 done_count = 0;
+    
+    //- read as many requests as possible in one process_vm_readv, from
+    // scatter lists. it stops at the first remote range it can't fully read.
+    if(vm_readv_is_usable)
+    {
+      for EachIndex(idx, count)
+      {
+        DMN_ReadRequest *r = &requests[base_idx+idx];
+        local_iov[idx].iov_base = r->dst;
+        local_iov[idx].iov_len = dim_1u64(r->range);
+        remote_iov[idx].iov_base = (void *)r->range.min;
+        remote_iov[idx].iov_len = dim_1u64(r->range);
+      }
+      // NOTE: called through syscall - glibc only declares process_vm_readv with
+      // _GNU_SOURCE, which is defined after the first libc include in unity builds
+      ssize_t read_size = syscall(SYS_process_vm_readv, pid, local_iov, count, remote_iov, count, 0);
+      if(read_size == -1 && (errno == ENOSYS || errno == EPERM))
+      {
+        vm_readv_is_usable = 0;
+      }
+      U64 bytes_left = (read_size > 0 ? (U64)read_size : 0);
+      for(;done_count < count; done_count += 1)
+      {
+        DMN_ReadRequest *r = &requests[base_idx+done_count];
+        U64 size = dim_1u64(r->range);
+        if(bytes_left < size)
+        {
+          break;
+        }
+        r->bytes_read = size;
+        bytes_left -= size;
+      }
+    }
+    
+    //- first request that failed -> fall back to /proc/pid/mem, which
+    // can read pages that the process itself cannot (& returns partial reads)
+    if(done_count < count)
+    {
+      DMN_ReadRequest *r = &requests[base_idx+done_count];
+      r->bytes_read = dmn_lnx_read(memory_fd, r->range, r->dst);
+      done_count += 1;
+    }
+    base_idx += done_count;
+  }
+  scratch_end(scratch);
+}
+
 internal String8
 dmn_lnx_read_string(Arena *arena, int memory_fd, U64 base_vaddr)
 {
@@ -462,12 +521,39 @@ dmn_lnx_entity_alloc(DMN_LNX_Entity *parent, DMN_LNX_EntityKind kind)
     entity->parent = parent;
   }
   entity->kind = kind;
+  if(kind == DMN_LNX_EntityKind_Thread)
+  {
+    entity->reg_cache = dmn_lnx_state->free_reg_cache;
+    if(entity->reg_cache != 0)
+    {
+      SLLStackPop(dmn_lnx_state->free_reg_cache);
+    }
+    else
+    {
+      entity->reg_cache = push_array_no_zero(dmn_lnx_state->reg_caches_arena, DMN_LNX_RegCache, 1);
+    }
+    MemoryZeroStruct(entity->reg_cache);
+  }
   return entity;
 }
 
 internal void
 dmn_lnx_entity_release(DMN_LNX_Entity *entity)
 {
+  if(entity->kind == DMN_LNX_EntityKind_Process) MutexScope(dmn_lnx_state->access_mutex)
+  {
+    dmn_lnx_process_traps_release(entity, 0);
+    if(entity->pagemap_fd > 0)
+    {
+      close(entity->pagemap_fd);
+      entity->pagemap_fd = 0;
+    }
+    if(entity->shared_vmas_arena != 0)
+    {
+      arena_release(entity->shared_vmas_arena);
+      entity->shared_vmas_arena = 0;
+    }
+  }
   if(entity->parent != &dmn_lnx_nil_entity)
   {
     DLLRemove_NPZ(&dmn_lnx_nil_entity, entity->parent->first, entity->parent->last, entity, next, prev);
@@ -480,6 +566,11 @@ dmn_lnx_entity_release(DMN_LNX_Entity *entity)
     for(DMN_LNX_EntityNode *t = first_task; t != 0; t = t->next)
     {
       SLLStackPush(dmn_lnx_state->free_entity, t->v);
+      if(t->v->reg_cache != 0)
+      {
+        SLLStackPush(dmn_lnx_state->free_reg_cache, t->v->reg_cache);
+        t->v->reg_cache = 0;
+      }
       for(DMN_LNX_Entity *child = t->v->first; child != &dmn_lnx_nil_entity; child = child->next)
       {
         DMN_LNX_EntityNode *task = push_array(scratch.arena, DMN_LNX_EntityNode, 1);
@@ -556,6 +647,16 @@ dmn_lnx_thread_read_reg_block(DMN_LNX_Entity *thread, void *reg_block)
     {
       REGS_RegBlockX64 *dst = (REGS_RegBlockX64 *)reg_block;
       pid_t tid = (pid_t)thread->id;
+      DMN_LNX_RegCache *cache = thread->reg_cache;
+      
+      //- thread hasn't run since its registers were last read? -> no
+      // need to go to the kernel
+      if(cache != 0 && ins_atomic_u32_eval(&cache->block_is_fresh))
+      {
+        MemoryCopyStruct(dst, &cache->x64);
+        result = 1;
+        break;
+      }
       
       //- rjf: read GPR
       B32 got_gpr = 0;
@@ -711,7 +812,8 @@ dmn_lnx_thread_read_reg_block(DMN_LNX_Entity *thread, void *reg_block)
         scratch_end(scratch);
       }
       
-      //- rjf: read debug registers
+      //- read debug registers; only dr6 can change without us writing
+      // it, so once cached, the rest come from the cache
       B32 got_debug = 0;
       if(got_fpr)
       {
@@ -721,9 +823,14 @@ dmn_lnx_thread_read_reg_block(DMN_LNX_Entity *thread, void *reg_block)
         {
           if(i != 4 && i != 5)
           {
+            if(i != 6 && cache != 0 && cache->debug_regs_are_cached)
+            {
+              dr_d->u64 = (&cache->x64.dr0)[i].u64;
+              continue;
+            }
             U64 offset = OffsetOf(DMN_LNX_UserX64, u_debugreg[i]);
             errno = 0;
-            int peek_result = ptrace(PTRACE_PEEKUSER, tid, PtrFromInt(offset), 0);
+            long peek_result = ptrace(PTRACE_PEEKUSER, tid, PtrFromInt(offset), 0);
             if(errno == 0)
             {
               dr_d->u64 = (U64)peek_result;
@@ -736,6 +843,14 @@ dmn_lnx_thread_read_reg_block(DMN_LNX_Entity *thread, void *reg_block)
         }
       }
       
+      //- store in cache
+      if(got_debug && cache != 0)
+      {
+        MemoryCopyStruct(&cache->x64, dst);
+        cache->debug_regs_are_cached = 1;
+        ins_atomic_u32_eval_assign(&cache->block_is_fresh, 1);
+      }
+      
       result = got_debug;
     }break;
   }
@@ -886,12 +1001,343 @@ dmn_lnx_thread_write_reg_block(DMN_LNX_Entity *thread, void *reg_block)
         }
       }
       
+      //- update cache - fully written? -> cache is exactly what we wrote.
+      // otherwise, we don't know which parts made it, so drop it.
+      DMN_LNX_RegCache *cache = thread->reg_cache;
+      if(cache != 0)
+      {
+        if(did_dbg)
+        {
+          MemoryCopyStruct(&cache->x64, src);
+          cache->debug_regs_are_cached = 1;
+          ins_atomic_u32_eval_assign(&cache->block_is_fresh, 1);
+        }
+        else
+        {
+          ins_atomic_u32_eval_assign(&cache->block_is_fresh, 0);
+          cache->debug_regs_are_cached = 0;
+        }
+      }
+      
       result = (did_dbg);
     }break;
   }
   return result;
 }
 
+////////////////////////////////
+//~ Resident Trap Functions
+
+internal DMN_LNX_TrapPage *
+dmn_lnx_trap_page_from_vaddr(DMN_LNX_Entity *process, U64 vaddr, B32 create)
+{
+  U64 page_size = os_get_system_info()->page_size;
+  U64 page_vaddr = AlignDownPow2(vaddr, page_size);
+  U64 hash = u64_hash_from_str8(str8_struct(&page_vaddr)) ^ process->id;
+  U64 slot_idx = hash%dmn_lnx_state->trap_page_slots_count;
+  DMN_LNX_TrapPageSlot *slot = &dmn_lnx_state->trap_page_slots[slot_idx];
+  DMN_LNX_TrapPage *page = 0;
+  for(DMN_LNX_TrapPage *p = slot->first; p != 0; p = p->hash_next)
+  {
+    if(p->process == process && p->vaddr == page_vaddr)
+    {
+      page = p;
+      break;
+    }
+  }
+  if(page == 0 && create)
+  {
+    page = dmn_lnx_state->free_trap_page;
+    if(page != 0)
+    {
+      dmn_lnx_state->free_trap_page = page->hash_next;
+      MemoryZeroStruct(page);
+    }
+    else
+    {
+      page = push_array(dmn_lnx_state->traps_arena, DMN_LNX_TrapPage, 1);
+    }
+    page->process = process;
+    page->vaddr = page_vaddr;
+    page->hash_next = slot->first;
+    slot->first = page;
+    DLLPushBack(process->first_trap_page, process->last_trap_page, page);
+  }
+  return page;
+}
+
+internal DMN_LNX_Trap *
+dmn_lnx_trap_from_vaddr(DMN_LNX_Entity *process, U64 vaddr)
+{
+  DMN_LNX_Trap *trap = 0;
+  DMN_LNX_TrapPage *page = dmn_lnx_trap_page_from_vaddr(process, vaddr, 0);
+  if(page != 0)
+  {
+    for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+    {
+      if(t->vaddr == vaddr)
+      {
+        trap = t;
+        break;
+      }
+    }
+  }
+  return trap;
+}
+
+internal void
+dmn_lnx_trap_page_flush(DMN_LNX_TrapPage *page)
+{
+  //- gather the span of bytes in this page which need to change; a trap
+  // is wanted in memory so long as its run generation is nonzero
+  U64 min_vaddr = max_U64;
+  U64 max_vaddr = 0;
+  for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+  {
+    B32 is_wanted = (t->run_gen != 0);
+    if(is_wanted != t->is_installed)
+    {
+      min_vaddr = Min(min_vaddr, t->vaddr);
+      max_vaddr = Max(max_vaddr, t->vaddr);
+    }
+  }
+  
+  //- read span, patch all trap bytes, write span back in one go; if the
+  // page can't be accessed it was unmapped, so none of our bytes survive
+  if(min_vaddr <= max_vaddr)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    int fd = page->process->fd;
+    Rng1U64 span = r1u64(min_vaddr, max_vaddr+1);
+    U8 *span_bytes = push_array_no_zero(scratch.arena, U8, dim_1u64(span));
+    B32 page_is_gone = 1;
+    if(dmn_lnx_read(fd, span, span_bytes) == dim_1u64(span))
+    {
+      for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+      {
+        B32 is_wanted = (t->run_gen != 0);
+        U8 *byte = &span_bytes[t->vaddr - span.min];
+        if(is_wanted && !t->is_installed)
+        {
+          t->og_byte = *byte;
+          *byte = 0xCC;
+        }
+        else if(!is_wanted && t->is_installed && *byte == 0xCC)
+        {
+          *byte = t->og_byte;
+        }
+      }
+      if(dmn_lnx_write(fd, span, span_bytes))
+      {
+        page_is_gone = 0;
+        for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+        {
+          t->is_installed = (t->run_gen != 0);
+        }
+      }
+    }
+    if(page_is_gone)
+    {
+      for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+      {
+        t->is_installed = 0;
+      }
+    }
+    scratch_end(scratch);
+  }
+  
+  //- drop all traps which are not in memory
+  for(DMN_LNX_Trap **t_ptr = &page->first_trap; *t_ptr != 0;)
+  {
+    DMN_LNX_Trap *t = *t_ptr;
+    if(!t->is_installed)
+    {
+      *t_ptr = t->next;
+      t->next = dmn_lnx_state->free_trap;
+      dmn_lnx_state->free_trap = t;
+      page->trap_count -= 1;
+    }
+    else
+    {
+      t_ptr = &t->next;
+    }
+  }
+  page->is_dirty = 0;
+  
+  //- drop page if empty
+  if(page->trap_count == 0)
+  {
+    DMN_LNX_Entity *process = page->process;
+    U64 hash = u64_hash_from_str8(str8_struct(&page->vaddr)) ^ process->id;
+    U64 slot_idx = hash%dmn_lnx_state->trap_page_slots_count;
+    DMN_LNX_TrapPageSlot *slot = &dmn_lnx_state->trap_page_slots[slot_idx];
+    for(DMN_LNX_TrapPage **p_ptr = &slot->first; *p_ptr != 0; p_ptr = &(*p_ptr)->hash_next)
+    {
+      if(*p_ptr == page)
+      {
+        *p_ptr = page->hash_next;
+        break;
+      }
+    }
+    DLLRemove(process->first_trap_page, process->last_trap_page, page);
+    page->hash_next = dmn_lnx_state->free_trap_page;
+    dmn_lnx_state->free_trap_page = page;
+  }
+}
+
+internal void
+dmn_lnx_process_traps_release(DMN_LNX_Entity *process, B32 restore_memory)
+{
+  for(DMN_LNX_TrapPage *page = process->first_trap_page, *next = 0; page != 0; page = next)
+  {
+    next = page->next;
+    for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+    {
+      t->run_gen = 0;
+      if(!restore_memory)
+      {
+        t->is_installed = 0;
+      }
+    }
+    dmn_lnx_trap_page_flush(page);
+  }
+}
+
+internal void
+dmn_lnx_overlay_trap_og_bytes(DMN_LNX_Entity *process, Rng1U64 range, void *dst)
+{
+  if(process->first_trap_page != 0)
+  {
+    U64 page_size = os_get_system_info()->page_size;
+    for(U64 page_vaddr = AlignDownPow2(range.min, page_size); page_vaddr < range.max; page_vaddr += page_size)
+    {
+      DMN_LNX_TrapPage *page = dmn_lnx_trap_page_from_vaddr(process, page_vaddr, 0);
+      if(page == 0) {continue;}
+      for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+      {
+        if(t->is_installed && contains_1u64(range, t->vaddr))
+        {
+          ((U8 *)dst)[t->vaddr - range.min] = t->og_byte;
+        }
+      }
+    }
+  }
+}
+
+////////////////////////////////
+//~ Soft-Dirty Page Tracking Functions
+
+internal Rng1U64Array
+dmn_lnx_shared_vmas_from_pid(Arena *arena, pid_t pid)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //- read maps; procfs files report no size, so read until the end
+  String8List chunks = {0};
+  int maps_fd = open((char *)str8f(scratch.arena, "/proc/%d/maps", pid).str, O_RDONLY);
+  if(maps_fd >= 0)
+  {
+    for(;;)
+    {
+      U64 chunk_cap = KB(16);
+      U8 *chunk = push_array_no_zero(scratch.arena, U8, chunk_cap);
+      ssize_t read_size = read(maps_fd, chunk, chunk_cap);
+      if(read_size <= 0) { break; }
+      str8_list_push(scratch.arena, &chunks, str8(chunk, (U64)read_size));
+    }
+    close(maps_fd);
+  }
+  String8 maps = str8_list_join(scratch.arena, &chunks, 0);
+  
+  //- gather lines with shared permissions, e.g.
+  // "7f0000000000-7f0000001000 rw-s 00000000 00:05 1234 /dev/shm/x"
+  Rng1U64List ranges = {0};
+  U8 split_char = '\n';
+  String8List lines = str8_split(scratch.arena, maps, &split_char, 1, 0);
+  for(String8Node *n = lines.first; n != 0; n = n->next)
+  {
+    String8 line = n->string;
+    U64 dash_pos = str8_find_needle(line, 0, str8_lit("-"), 0);
+    U64 space_pos = str8_find_needle(line, dash_pos, str8_lit(" "), 0);
+    if(space_pos+4 < line.size && line.str[space_pos+4] == 's')
+    {
+      U64 min = u64_from_str8(str8_substr(line, r1u64(0, dash_pos)), 16);
+      U64 max = u64_from_str8(str8_substr(line, r1u64(dash_pos+1, space_pos)), 16);
+      rng1u64_list_push(scratch.arena, &ranges, r1u64(min, max));
+    }
+  }
+  
+  Rng1U64Array result = rng1u64_array_from_list(arena, &ranges);
+  scratch_end(scratch);
+  return result;
+}
+
+internal B32
+dmn_lnx_process_soft_dirty_probe(DMN_LNX_Entity *process)
+{
+  // NOTE: kernels built without soft-dirty support still accept
+  // clear_refs writes, but never report soft-dirty bits. so, before ever
+  // clearing, check that a page we know has been written - the one at the
+  // top of a thread's stack - reports its bit.
+  B32 result = 0;
+  DMN_LNX_Entity *thread = process->first;
+  for(;thread != &dmn_lnx_nil_entity && thread->kind != DMN_LNX_EntityKind_Thread; thread = thread->next);
+  if(thread != &dmn_lnx_nil_entity && process->pagemap_fd > 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    void *reg_block = push_array(scratch.arena, U8, regs_block_size_from_arch(process->arch));
+    if(dmn_lnx_thread_read_reg_block(thread, reg_block))
+    {
+      U64 page_size = os_get_system_info()->page_size;
+      U64 rsp = regs_rsp_from_arch_block(process->arch, reg_block);
+      U64 entry = 0;
+      if(pread(process->pagemap_fd, &entry, sizeof(entry), (rsp/page_size)*sizeof(entry)) == sizeof(entry))
+      {
+        result = (entry & DMN_LNX_PAGEMAP_PRESENT) && (entry & DMN_LNX_PAGEMAP_SOFT_DIRTY);
+      }
+    }
+    scratch_end(scratch);
+  }
+  return result;
+}
+
+internal void
+dmn_lnx_process_soft_dirty_arm(DMN_LNX_Entity *process)
+{
+  if(!process->soft_dirty_is_probed)
+  {
+    process->soft_dirty_is_probed = 1;
+    process->soft_dirty_is_supported = dmn_lnx_process_soft_dirty_probe(process);
+  }
+  process->soft_dirty_is_armed = 0;
+  if(process->soft_dirty_is_supported)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    int clear_refs_fd = open((char *)str8f(scratch.arena, "/proc/%d/clear_refs", (pid_t)process->id).str, O_WRONLY);
+    if(clear_refs_fd >= 0)
+    {
+      process->soft_dirty_is_armed = (write(clear_refs_fd, "4", 1) == 1);
+      close(clear_refs_fd);
+    }
+    process->soft_dirty_is_supported = process->soft_dirty_is_armed;
+    scratch_end(scratch);
+  }
+  
+  // NOTE: writes to shared mappings from other processes never touch this
+  // process' page tables, so their pages are always reported as dirty.
+  // mappings created during the run start out soft-dirty, so a snapshot
+  // taken at arm time is enough.
+  if(process->soft_dirty_is_armed)
+  {
+    if(process->shared_vmas_arena == 0)
+    {
+      process->shared_vmas_arena = arena_alloc();
+    }
+    arena_clear(process->shared_vmas_arena);
+    process->shared_vmas = dmn_lnx_shared_vmas_from_pid(process->shared_vmas_arena, (pid_t)process->id);
+  }
+}
+
 ////////////////////////////////
 //~ rjf: @dmn_os_hooks Main Layer Initialization (Implemented Per-OS)
 
@@ -906,6 +1352,10 @@ dmn_init(void)
   dmn_lnx_state->entities_base = push_array(dmn_lnx_state->entities_arena, DMN_LNX_Entity, 0);
   dmn_lnx_entity_alloc(&dmn_lnx_nil_entity, DMN_LNX_EntityKind_Root);
   dmn_lnx_state->access_mutex = mutex_alloc();
+  dmn_lnx_state->traps_arena = arena_alloc();
+  dmn_lnx_state->reg_caches_arena = arena_alloc();
+  dmn_lnx_state->trap_page_slots_count = 4096;
+  dmn_lnx_state->trap_page_slots = push_array(arena, DMN_LNX_TrapPageSlot, dmn_lnx_state->trap_page_slots_count);
 }
 
 ////////////////////////////////
@@ -1076,6 +1526,7 @@ dmn_ctrl_launch(DMN_CtrlCtx *ctx, OS_ProcessLaunchParams *params)
             process->arch = dmn_lnx_arch_from_pid(pid);
             process->id = pid;
             process->fd = open((char*)str8f(scratch.arena, "/proc/%d/mem", pid).str, O_RDWR);
+            process->pagemap_fd = open((char*)str8f(scratch.arena, "/proc/%d/pagemap", pid).str, O_RDONLY);
             {
               DMN_Event *e = dmn_event_list_push(dmn_lnx_state->deferred_events_arena, &dmn_lnx_state->deferred_events);
               e->kind    = DMN_EventKind_CreateProcess;
@@ -1174,6 +1625,10 @@ dmn_ctrl_detach(DMN_CtrlCtx *ctx, DMN_Handle process)
 {
   B32 result = 0;
   DMN_LNX_Entity *process_entity = dmn_lnx_entity_from_handle(process);
+  if(process_entity != &dmn_lnx_nil_entity) MutexScope(dmn_lnx_state->access_mutex)
+  {
+    dmn_lnx_process_traps_release(process_entity, 1);
+  }
   if(process_entity != &dmn_lnx_nil_entity &&
      ptrace(PTRACE_DETACH, process_entity->id, 0, 0) != -1)
   {
@@ -1225,26 +1680,117 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
     B32 need_wait_on_events = (evts.count == 0);
     
     ////////////////////////////
-    //- rjf: write all traps into memory
+    //- sync resident traps with requested traps
+    //
+    // traps stay in memory across runs, so only traps which were added or
+    // dropped since the last run are written, batched per page. single-step
+    // runs only execute one instruction on one thread, so they leave traps
+    // they did not request in place, and only lift the trap underneath the
+    // stepping thread.
     //
-    U8 *trap_swap_bytes = push_array_no_zero(scratch.arena, U8, ctrls->traps.trap_count);
-    ProfScope("write all traps into memory")
+    DMN_LNX_Entity *lifted_trap_process = &dmn_lnx_nil_entity;
+    U64 lifted_trap_vaddr = 0;
+    ProfScope("sync resident traps with requested traps") MutexScope(dmn_lnx_state->access_mutex)
     {
-      U64 trap_idx = 0;
+      dmn_lnx_state->trap_run_gen += 1;
+      U64 run_gen = dmn_lnx_state->trap_run_gen;
+      
+      //- mark requested traps, add new ones
       for(DMN_TrapChunkNode *n = ctrls->traps.first; n != 0; n = n->next)
       {
-        for(U64 n_idx = 0; n_idx < n->count; n_idx += 1, trap_idx += 1)
+        for(U64 n_idx = 0; n_idx < n->count; n_idx += 1)
         {
           DMN_Trap *trap = n->v+n_idx;
-          if(trap->flags == 0)
+          DMN_LNX_Entity *process = dmn_lnx_entity_from_handle(trap->process);
+          if(trap->flags != 0 || process == &dmn_lnx_nil_entity) {continue;}
+          DMN_LNX_TrapPage *page = dmn_lnx_trap_page_from_vaddr(process, trap->vaddr, 1);
+          DMN_LNX_Trap *t = 0;
+          for(DMN_LNX_Trap *existing = page->first_trap; existing != 0; existing = existing->next)
+          {
+            if(existing->vaddr == trap->vaddr)
+            {
+              t = existing;
+              break;
+            }
+          }
+          if(t == 0)
+          {
+            t = dmn_lnx_state->free_trap;
+            if(t != 0)
+            {
+              dmn_lnx_state->free_trap = t->next;
+              MemoryZeroStruct(t);
+            }
+            else
+            {
+              t = push_array(dmn_lnx_state->traps_arena, DMN_LNX_Trap, 1);
+            }
+            t->vaddr = trap->vaddr;
+            t->next = page->first_trap;
+            page->first_trap = t;
+            page->trap_count += 1;
+          }
+          if(!t->is_installed || t->run_gen == 0)
+          {
+            page->is_dirty = 1;
+          }
+          t->run_gen = run_gen;
+        }
+      }
+      
+      //- mark unrequested traps for removal
+      if(single_step_thread == &dmn_lnx_nil_entity)
+      {
+        for(DMN_LNX_Entity *process = dmn_lnx_state->entities_base->first;
+            process != &dmn_lnx_nil_entity;
+            process = process->next)
+        {
+          if(process->kind != DMN_LNX_EntityKind_Process) {continue;}
+          for(DMN_LNX_TrapPage *page = process->first_trap_page; page != 0; page = page->next)
+          {
+            for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+            {
+              if(t->run_gen != run_gen)
+              {
+                t->run_gen = 0;
+                page->is_dirty = 1;
+              }
+            }
+          }
+        }
+      }
+      
+      //- write changes to all dirty pages
+      for(DMN_LNX_Entity *process = dmn_lnx_state->entities_base->first;
+          process != &dmn_lnx_nil_entity;
+          process = process->next)
+      {
+        if(process->kind != DMN_LNX_EntityKind_Process) {continue;}
+        for(DMN_LNX_TrapPage *page = process->first_trap_page, *next = 0; page != 0; page = next)
+        {
+          next = page->next;
+          if(page->is_dirty)
           {
-            trap_swap_bytes[trap_idx] = 0xCC;
-            dmn_process_read(trap->process, r1u64(trap->vaddr, trap->vaddr+1), trap_swap_bytes+trap_idx);
-            U8 int3 = 0xCC;
-            dmn_process_write(trap->process, r1u64(trap->vaddr, trap->vaddr+1), &int3);
+            dmn_lnx_trap_page_flush(page);
           }
         }
       }
+      
+      //- lift trap underneath single-stepping thread
+      if(single_step_thread != &dmn_lnx_nil_entity)
+      {
+        DMN_LNX_Entity *process = single_step_thread->parent;
+        void *regs_block = push_array(scratch.arena, U8, regs_block_size_from_arch(single_step_thread->arch));
+        dmn_lnx_thread_read_reg_block(single_step_thread, regs_block);
+        U64 rip = regs_rip_from_arch_block(single_step_thread->arch, regs_block);
+        DMN_LNX_Trap *t = dmn_lnx_trap_from_vaddr(process, rip);
+        if(t != 0 && t->is_installed && dmn_lnx_write_struct(process->fd, t->vaddr, &t->og_byte))
+        {
+          t->is_lifted = 1;
+          lifted_trap_process = process;
+          lifted_trap_vaddr = t->vaddr;
+        }
+      }
     }
     
     ////////////////////////////
@@ -1333,6 +1879,24 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       }
     }
     
+    ////////////////////////////
+    //- clear soft-dirty bits of all processes we're about to run, so that
+    // at the next stop, pagemap reports exactly the pages written by this run
+    //
+    if(need_wait_on_events) ProfScope("arm soft-dirty tracking")
+    {
+      DMN_LNX_Entity *last_armed_process = &dmn_lnx_nil_entity;
+      for(DMN_LNX_EntityNode *n = first_run_thread; n != 0; n = n->next)
+      {
+        DMN_LNX_Entity *process = n->v->parent;
+        if(process != last_armed_process)
+        {
+          dmn_lnx_process_soft_dirty_arm(process);
+          last_armed_process = process;
+        }
+      }
+    }
+    
     ////////////////////////////
     //- rjf: resume all threads we need to run
     //
@@ -1340,7 +1904,11 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
     DMN_LNX_EntityNode *last_ran_thread = 0;
     for(DMN_LNX_EntityNode *n = first_run_thread; n != 0; n = n->next)
     {
-      ptrace(PTRACE_CONT, (pid_t)n->v->id, 0, 0);
+      if(n->v->reg_cache != 0)
+      {
+        ins_atomic_u32_eval_assign(&n->v->reg_cache->block_is_fresh, 0);
+      }
+      ptrace(n->v == single_step_thread ? PTRACE_SINGLESTEP : PTRACE_CONT, (pid_t)n->v->id, 0, 0);
       DMN_LNX_EntityNode *n2 = push_array_no_zero(scratch.arena, DMN_LNX_EntityNode, 1);
       SLLQueuePush(first_ran_thread, last_ran_thread, n2);
       n2->v = n->v;
@@ -1584,26 +2152,17 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       }
     }
     
-    //////////////////////////
-    //- rjf: restore original memory at trap locations
+    ////////////////////////////
+    //- put lifted trap back into memory
     //
-    ProfScope("restore original memory at trap locations")
+    if(lifted_trap_process != &dmn_lnx_nil_entity) MutexScope(dmn_lnx_state->access_mutex)
     {
-      U64 trap_idx = 0;
-      for(DMN_TrapChunkNode *n = ctrls->traps.first; n != 0; n = n->next)
+      DMN_LNX_Trap *t = dmn_lnx_trap_from_vaddr(lifted_trap_process, lifted_trap_vaddr);
+      if(t != 0 && t->is_lifted)
       {
-        for(U64 n_idx = 0; n_idx < n->count; n_idx += 1, trap_idx += 1)
-        {
-          DMN_Trap *trap = n->v+n_idx;
-          if(trap->flags == 0)
-          {
-            U8 og_byte = trap_swap_bytes[trap_idx];
-            if(og_byte != 0xCC)
-            {
-              dmn_process_write(trap->process, r1u64(trap->vaddr, trap->vaddr+1), &og_byte);
-            }
-          }
-        }
+        U8 int3 = 0xCC;
+        dmn_lnx_write_struct(lifted_trap_process->fd, t->vaddr, &int3);
+        t->is_lifted = 0;
       }
     }
     
@@ -1695,16 +2254,120 @@ dmn_process_memory_protect(DMN_Handle process, U64 vaddr, U64 size, OS_AccessFla
 internal U64
 dmn_process_read(DMN_Handle process, Rng1U64 range, void *dst)
 {
-  DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
-  U64 result = dmn_lnx_read(entity->fd, range, dst);
+  U64 result = 0;
+  DMN_AccessScope
+  {
+    DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
+    DMN_ReadRequest request = {range, dst};
+    dmn_lnx_read_batch((pid_t)entity->id, entity->fd, &request, 1);
+    result = request.bytes_read;
+    
+    // resident traps are invisible to readers
+    dmn_lnx_overlay_trap_og_bytes(entity, r1u64(range.min, range.min+result), dst);
+  }
   return result;
 }
 
+internal void
+dmn_process_read_batch(DMN_Handle process, DMN_ReadRequest *requests, U64 requests_count)
+{
+  DMN_AccessScope
+  {
+    DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
+    dmn_lnx_read_batch((pid_t)entity->id, entity->fd, requests, requests_count);
+    
+    // resident traps are invisible to readers
+    for EachIndex(idx, requests_count)
+    {
+      DMN_ReadRequest *r = &requests[idx];
+      dmn_lnx_overlay_trap_og_bytes(entity, r1u64(r->range.min, r->range.min+r->bytes_read), r->dst);
+    }
+  }
+}
+
 internal B32
 dmn_process_write(DMN_Handle process, Rng1U64 range, void *src)
 {
-  DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
-  B32 result = dmn_lnx_write(entity->fd, range, src);
+  B32 result = 0;
+  DMN_AccessScope
+  {
+    DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
+    if(entity->first_trap_page == 0)
+    {
+      result = dmn_lnx_write(entity->fd, range, src);
+    }
+    
+    // writes over resident traps update the original bytes, and keep
+    // the traps in memory
+    else
+    {
+      Temp scratch = scratch_begin(0, 0);
+      U64 page_size = os_get_system_info()->page_size;
+      U8 *bytes = push_array_no_zero(scratch.arena, U8, dim_1u64(range));
+      MemoryCopy(bytes, src, dim_1u64(range));
+      for(U64 page_vaddr = AlignDownPow2(range.min, page_size); page_vaddr < range.max; page_vaddr += page_size)
+      {
+        DMN_LNX_TrapPage *page = dmn_lnx_trap_page_from_vaddr(entity, page_vaddr, 0);
+        if(page == 0) {continue;}
+        for(DMN_LNX_Trap *t = page->first_trap; t != 0; t = t->next)
+        {
+          if(t->is_installed && contains_1u64(range, t->vaddr))
+          {
+            t->og_byte = bytes[t->vaddr - range.min];
+            if(!t->is_lifted)
+            {
+              bytes[t->vaddr - range.min] = 0xCC;
+            }
+          }
+        }
+      }
+      result = dmn_lnx_write(entity->fd, range, bytes);
+      scratch_end(scratch);
+    }
+  }
+  return result;
+}
+
+internal B32
+dmn_process_read_dirty_page_flags(DMN_Handle process, Rng1U64 range, U64 *dirty_flags_out)
+{
+  B32 result = 0;
+  DMN_AccessScope
+  {
+    DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
+    if(entity->kind == DMN_LNX_EntityKind_Process && entity->soft_dirty_is_armed && range.max > range.min)
+    {
+      Temp scratch = scratch_begin(0, 0);
+      U64 page_size = os_get_system_info()->page_size;
+      U64 first_page_idx = range.min/page_size;
+      U64 page_count = (AlignPow2(range.max, page_size) - AlignDownPow2(range.min, page_size))/page_size;
+      U64 *entries = push_array_no_zero(scratch.arena, U64, page_count);
+      if(pread(entity->pagemap_fd, entries, sizeof(U64)*page_count, first_page_idx*sizeof(U64)) == sizeof(U64)*page_count)
+      {
+        for EachIndex(idx, page_count)
+        {
+          // pages not backed by anything can't vouch for their contents
+          B32 is_mapped = !!(entries[idx] & (DMN_LNX_PAGEMAP_PRESENT|DMN_LNX_PAGEMAP_SWAPPED));
+          if(!is_mapped || (entries[idx] & DMN_LNX_PAGEMAP_SOFT_DIRTY))
+          {
+            dirty_flags_out[idx/64] |= (1ull<<(idx%64));
+          }
+        }
+        Rng1U64 pages_range = r1u64(first_page_idx*page_size, (first_page_idx+page_count)*page_size);
+        for EachIndex(vma_idx, entity->shared_vmas.count)
+        {
+          Rng1U64 shared_range = intersect_1u64(entity->shared_vmas.v[vma_idx], pages_range);
+          for(U64 vaddr = AlignDownPow2(shared_range.min, page_size); vaddr < shared_range.max; vaddr += page_size)
+          {
+            U64 idx = vaddr/page_size - first_page_idx;
+            dirty_flags_out[idx/64] |= (1ull<<(idx%64));
+          }
+        }
+        result = 1;
+      }
+      scratch_end(scratch);
+    }
+  }
   return result;
 }
 
@@ -11,6 +11,7 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/uio.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 #include <elf.h>
 #include <dirent.h>
@@ -25,6 +26,18 @@ PTRACE_O_TRACEFORK|\
 PTRACE_O_TRACEVFORK|\
 PTRACE_O_TRACECLONE)
 
+////////////////////////////////
+//~ /proc/pid/pagemap entry bits
+
+#define DMN_LNX_PAGEMAP_SOFT_DIRTY (1ull<<55)
+#define DMN_LNX_PAGEMAP_SWAPPED    (1ull<<62)
+#define DMN_LNX_PAGEMAP_PRESENT    (1ull<<63)
+
+////////////////////////////////
+//~ process_vm_readv scatter list cap (UIO_MAXIOV)
+
+#define DMN_LNX_IOV_MAX 1024
+
 ////////////////////////////////
 //~ rjf: Register Layouts
 //
@@ -233,6 +246,39 @@ struct DMN_LNX_ModuleInfoList
   U64 count;
 };
 
+////////////////////////////////
+//~ Resident Trap Types
+
+typedef struct DMN_LNX_Trap DMN_LNX_Trap;
+struct DMN_LNX_Trap
+{
+  DMN_LNX_Trap *next;
+  U64 vaddr;
+  U64 run_gen;
+  U8 og_byte;
+  B8 is_installed;
+  B8 is_lifted;
+};
+
+typedef struct DMN_LNX_TrapPage DMN_LNX_TrapPage;
+struct DMN_LNX_TrapPage
+{
+  DMN_LNX_TrapPage *hash_next;
+  DMN_LNX_TrapPage *next;
+  DMN_LNX_TrapPage *prev;
+  struct DMN_LNX_Entity *process;
+  U64 vaddr;
+  DMN_LNX_Trap *first_trap;
+  U64 trap_count;
+  B32 is_dirty;
+};
+
+typedef struct DMN_LNX_TrapPageSlot DMN_LNX_TrapPageSlot;
+struct DMN_LNX_TrapPageSlot
+{
+  DMN_LNX_TrapPage *first;
+};
+
 ////////////////////////////////
 //~ rjf: Entity Types
 
@@ -247,6 +293,21 @@ typedef enum DMN_LNX_EntityKind
 }
 DMN_LNX_EntityKind;
 
+typedef struct DMN_LNX_RegCache DMN_LNX_RegCache;
+struct DMN_LNX_RegCache
+{
+  DMN_LNX_RegCache *next;
+  
+  // full register block, valid until the thread is next resumed
+  B32 block_is_fresh;
+  
+  // dr0-dr3 & dr7 are only ever changed by us, so they stay valid
+  // across stops; dr6 is written by the CPU, so it is re-read every stop
+  B32 debug_regs_are_cached;
+  
+  REGS_RegBlockX64 x64;
+};
+
 typedef struct DMN_LNX_Entity DMN_LNX_Entity;
 struct DMN_LNX_Entity
 {
@@ -260,7 +321,16 @@ struct DMN_LNX_Entity
   Arch arch;
   U64 id;
   int fd;
+  int pagemap_fd;
   B32 expecting_dummy_sigstop;
+  B32 soft_dirty_is_probed;
+  B32 soft_dirty_is_supported;
+  B32 soft_dirty_is_armed;
+  Arena *shared_vmas_arena;
+  Rng1U64Array shared_vmas;
+  DMN_LNX_TrapPage *first_trap_page;
+  DMN_LNX_TrapPage *last_trap_page;
+  DMN_LNX_RegCache *reg_cache;
 };
 
 typedef struct DMN_LNX_EntityNode DMN_LNX_EntityNode;
@@ -292,6 +362,18 @@ struct DMN_LNX_State
   U64 entities_count;
   DMN_LNX_Entity *free_entity;
   
+  // resident traps
+  Arena *traps_arena;
+  U64 trap_page_slots_count;
+  DMN_LNX_TrapPageSlot *trap_page_slots;
+  DMN_LNX_TrapPage *free_trap_page;
+  DMN_LNX_Trap *free_trap;
+  U64 trap_run_gen;
+  
+  // per-stop thread register caches
+  Arena *reg_caches_arena;
+  DMN_LNX_RegCache *free_reg_cache;
+  
   // rjf: halting mechanism
   B32 has_halt_injection;
   U64 halt_code;
@@ -310,6 +392,7 @@ internal U64 dmn_lnx_read(int memory_fd, Rng1U64 range, void *dst);
 internal B32 dmn_lnx_write(int memory_fd, Rng1U64 range, void *src);
 #define dmn_lnx_read_struct(fd, vaddr, ptr) dmn_lnx_read((fd), r1u64((vaddr), (vaddr)+sizeof(*(ptr))), (ptr))
 #define dmn_lnx_write_struct(fd, vaddr, ptr) dmn_lnx_write((fd), r1u64((vaddr), (vaddr)+sizeof(*(ptr))), (ptr))
+internal void dmn_lnx_read_batch(pid_t pid, int memory_fd, DMN_ReadRequest *requests, U64 requests_count);
 internal String8 dmn_lnx_read_string(Arena *arena, int memory_fd, U64 base_vaddr);
 
 //- rjf: pid => info extraction
@@ -323,6 +406,22 @@ internal DMN_LNX_PhdrInfo dmn_lnx_phdr_info_from_memory(int memory_fd, B32 is_32
 //- rjf: process entity => info extraction
 internal DMN_LNX_ModuleInfoList dmn_lnx_module_info_list_from_process(Arena *arena, DMN_LNX_Entity *process);
 
+////////////////////////////////
+//~ Resident Trap Functions
+
+internal DMN_LNX_TrapPage *dmn_lnx_trap_page_from_vaddr(DMN_LNX_Entity *process, U64 vaddr, B32 create);
+internal DMN_LNX_Trap *dmn_lnx_trap_from_vaddr(DMN_LNX_Entity *process, U64 vaddr);
+internal void dmn_lnx_trap_page_flush(DMN_LNX_TrapPage *page);
+internal void dmn_lnx_process_traps_release(DMN_LNX_Entity *process, B32 restore_memory);
+internal void dmn_lnx_overlay_trap_og_bytes(DMN_LNX_Entity *process, Rng1U64 range, void *dst);
+
+////////////////////////////////
+//~ Soft-Dirty Page Tracking Functions
+
+internal Rng1U64Array dmn_lnx_shared_vmas_from_pid(Arena *arena, pid_t pid);
+internal B32 dmn_lnx_process_soft_dirty_probe(DMN_LNX_Entity *process);
+internal void dmn_lnx_process_soft_dirty_arm(DMN_LNX_Entity *process);
+
 ////////////////////////////////
 //~ rjf: Entity Functions
 
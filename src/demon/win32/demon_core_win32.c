@@ -3094,6 +3094,19 @@ dmn_process_read(DMN_Handle process, Rng1U64 range, void *dst)
   return result;
 }
 
+internal void
+dmn_process_read_batch(DMN_Handle process, DMN_ReadRequest *requests, U64 requests_count)
+{
+  DMN_AccessScope
+  {
+    DMN_W32_Entity *entity = dmn_w32_entity_from_handle(process);
+    for EachIndex(idx, requests_count)
+    {
+      requests[idx].bytes_read = dmn_w32_process_read(entity->handle, requests[idx].range, requests[idx].dst);
+    }
+  }
+}
+
 internal B32
 dmn_process_write(DMN_Handle process, Rng1U64 range, void *src)
 {
@@ -3106,6 +3119,14 @@ dmn_process_write(DMN_Handle process, Rng1U64 range, void *src)
   return result;
 }
 
+internal B32
+dmn_process_read_dirty_page_flags(DMN_Handle process, Rng1U64 range, U64 *dirty_flags_out)
+{
+  // TODO: no write-tracking on windows yet - callers must assume all
+  // pages may have changed
+  return 0;
+}
+
 //- rjf: threads
 
 internal Arch
@@ -479,6 +479,7 @@ dasm_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_o
       artifact->arena = info_arena;
       artifact->info = info;
       artifact->data_hash = hash;
+      ac_report_artifact_size(arena_pos(info_arena));
     }
     
     access_close(access);
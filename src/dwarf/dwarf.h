@@ -57,7 +57,9 @@ X(LocLists,   ".debug_loclists",    "__debug_loclists",    ".debug_loclists.dwo"
 X(RngLists,   ".debug_rnglists",    "__debug_rnglists",    ".debug_rnglists.dwo"   )\
 X(StrOffsets, ".debug_str_offsets", "__debug_str_offsets", ".debug_str_offsets.dwo")\
 X(LineStr,    ".debug_line_str",    "__debug_line_str",    ".debug_line_str.dwo"   )\
-X(Names,      ".debug_names",       "__debug_names",       ".debug_names.dwo"      )
+X(Names,      ".debug_names",       "__debug_names",       ".debug_names.dwo"      )\
+X(CuIndex,    ".debug_cu_index",    "__debug_cu_index",    ".debug_cu_index"       )\
+X(TuIndex,    ".debug_tu_index",    "__debug_tu_index",    ".debug_tu_index"       )
 
 typedef U64 DW_SectionKind;
 typedef enum DW_SectionKindEnum
@@ -472,8 +474,8 @@ X(GNU_RefAlt,    0x1f20)   \
 X(GNU_StrpAlt,   0x1f21)
 
 #define DW_Form_AttribClass_GNU_XList(X)     \
-X(GNU_AddrIndex, DW_AttribClass_Undefined) \
-X(GNU_StrIndex,  DW_AttribClass_Undefined) \
+X(GNU_AddrIndex, DW_AttribClass_Address)   \
+X(GNU_StrIndex,  DW_AttribClass_String)    \
 X(GNU_RefAlt,    DW_AttribClass_Undefined) \
 X(GNU_StrpAlt,   DW_AttribClass_String)
 
@@ -1337,6 +1339,27 @@ typedef enum DW_LNCTEnum
   DW_LNCT_UserHi = 0x3fff
 } DW_LNCTEnum;
 
+// column ids of .debug_cu_index/.debug_tu_index in DWARF packages; version 2
+// (pre-standard GNU) indices use 5, 7 and 8 for .debug_loc, .debug_macinfo and
+// .debug_macro instead
+#define DW_SECT_XList(X) \
+X(Info,       1)       \
+X(Types,      2)       \
+X(Abbrev,     3)       \
+X(Line,       4)       \
+X(LocLists,   5)       \
+X(StrOffsets, 6)       \
+X(Macro,      7)       \
+X(RngLists,   8)
+
+typedef U32 DW_SECT;
+typedef enum DW_SECTEnum
+{
+#define X(_N, _ID) DW_SECT_##_N = _ID,
+  DW_SECT_XList(X)
+#undef X
+} DW_SECTEnum;
+
 ////////////////////////////////
 // CFA
 
@@ -1356,7 +1379,7 @@ X(AdvanceLoc1,    0x2,  DW_CFA_OperandType_Value)
 X(AdvanceLoc2,    0x3,  DW_CFA_OperandType_Value)                                   \
 X(AdvanceLoc4,    0x4,  DW_CFA_OperandType_Value)                                   \
 X(OffsetExt,      0x5,  DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
-X(RestoreExt,     0x6)                                                              \
+X(RestoreExt,     0x6,  DW_CFA_OperandType_Register)                                \
 X(Undefined,      0x7,  DW_CFA_OperandType_Register)                                \
 X(SameValue,      0x8,  DW_CFA_OperandType_Register)                                \
 X(Register,       0x9,  DW_CFA_OperandType_Register)                                \
@@ -1366,13 +1389,14 @@ X(DefCfa,         0xc,  DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)
 X(DefCfaRegister, 0xd,  DW_CFA_OperandType_Register)                                \
 X(DefCfaOffset,   0xe,  DW_CFA_OperandType_Value)                                   \
 X(DefCfaExpr,     0xf,  DW_CFA_OperandType_Expression)                              \
-X(Expr,           0x10, DW_CFA_OperandType_Expression)                              \
+X(Expr,           0x10, DW_CFA_OperandType_Register, DW_CFA_OperandType_Expression) \
 X(OffsetExtSf,    0x11, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(DefCfaSf,       0x12, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(DefCfaOffsetSf, 0x13, DW_CFA_OperandType_Value)                                   \
 X(ValOffset,      0x14, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(ValOffsetSf,    0x15, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(ValExpr,        0x16, DW_CFA_OperandType_Register, DW_CFA_OperandType_Expression) \
+X(GNUArgsSize,    0x2e, DW_CFA_OperandType_Value)                                   \
 X(AdvanceLoc,     0x40, DW_CFA_OperandType_Value)                                   \
 X(Offset,         0x80, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(Restore,        0xc0, DW_CFA_OperandType_Register)
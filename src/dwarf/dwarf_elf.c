@@ -27,57 +27,82 @@ dw_is_dwarf_present_from_elf_bin(String8 data, ELF_Bin *bin)
 #define SINFL_IMPLEMENTATION
 #include "third_party/sinfl/sinfl.h"
 
+internal int
+dw_elf_decompress_task_is_before(DW_ELFDecompressTask *a, DW_ELFDecompressTask *b)
+{
+  // largest inputs first, so lanes don't end up waiting on one big
+  // section picked up last
+  int result = 0;
+  if(a->src.size > b->src.size)      { result = -1; }
+  else if(a->src.size < b->src.size) { result = +1; }
+  return result;
+}
+
 internal DW_Input
 dw_input_from_elf_bin(Arena *arena, String8 data, ELF_Bin *bin)
 {
-  DW_Input result = {0};
-  B32 is_section_present[ArrayCount(result.sec)] = {0};
-  for(U64 section_idx = 1; section_idx < bin->shdrs.count; section_idx += 1)
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //////////////////////////////
+  //- gather sections, kick off decompression tasks for compressed ones
+  //
+  DW_Input *result = 0;
+  DW_ELFDecompressTask *tasks = 0;
+  U64 task_count = 0;
+  U64 task_take_counter = 0;
+  U64 *task_take_counter_ptr = &task_take_counter;
+  if(lane_idx() == 0)
   {
-    ELF_Shdr64 *shdr = &bin->shdrs.v[section_idx];
-    if(shdr->sh_type != ELF_SectionCode_ProgBits) { continue; } // skip BSS sections
-    
-    //- rjf: unpack section
-    String8 section_name = elf_name_from_shdr64(data, bin, shdr);
-    DW_SectionKind section_kind = dw_section_kind_from_string(section_name);
-    String8 section_data__maybe_compressed = str8_substr(data, r1u64(shdr->sh_offset, shdr->sh_offset + shdr->sh_size));
-    B32 is_dwo = 0;
-    if(section_kind == DW_Section_Null)
-    {
-      section_kind = dw_section_dwo_kind_from_string(section_name);
-      is_dwo = (section_kind != DW_Section_Null);
-    }
-    
-    if(section_kind == DW_Section_Null)  { continue; } // skip unknown sections
-    if(is_section_present[section_kind]) { continue; } // skip duplicate sections
-    
-    //- rjf: decompress section data if needed
-    String8 section_data__uncompressed = {0};
-    if(!(shdr->sh_flags & ELF_Shf_Compressed))
+    result = push_array(arena, DW_Input, 1);
+    DW_ELFDecompressTaskNode *first_task = 0;
+    DW_ELFDecompressTaskNode *last_task = 0;
+    B32 is_section_present[ArrayCount(result->sec)] = {0};
+    for(U64 section_idx = 1; section_idx < bin->shdrs.count; section_idx += 1)
     {
-      section_data__uncompressed = section_data__maybe_compressed;
-    }
-    else
-    {
-      // rjf: read compressed-section header
-      ELF_Chdr64 chdr64 = {0};
-      U64 chdr_size = 0;
-      if(ELF_HdrIs64Bit(bin->hdr.e_ident))
+      ELF_Shdr64 *shdr = &bin->shdrs.v[section_idx];
+      if(shdr->sh_type != ELF_SectionCode_ProgBits) { continue; } // skip BSS sections
+      
+      //- rjf: unpack section
+      String8 section_name = elf_name_from_shdr64(data, bin, shdr);
+      DW_SectionKind section_kind = dw_section_kind_from_string(section_name);
+      String8 section_data__maybe_compressed = str8_substr(data, r1u64(shdr->sh_offset, shdr->sh_offset + shdr->sh_size));
+      B32 is_dwo = 0;
+      if(section_kind == DW_Section_Null)
       {
-        chdr_size = str8_deserial_read_struct(section_data__maybe_compressed, 0, &chdr64);
+        section_kind = dw_section_dwo_kind_from_string(section_name);
+        is_dwo = (section_kind != DW_Section_Null);
       }
-      else if(ELF_HdrIs32Bit(bin->hdr.e_ident))
+      
+      if(section_kind == DW_Section_Null)  { continue; } // skip unknown sections
+      if(is_section_present[section_kind]) { continue; } // skip duplicate sections
+      
+      //- compressed sections -> allocate output & push tasks; decompressed
+      // size is known up front, so tasks write straight into the final buffer
+      String8 section_data__uncompressed = {0};
+      if(!(shdr->sh_flags & ELF_Shf_Compressed))
       {
-        ELF_Chdr32 chdr32 = {0};
-        chdr_size = str8_deserial_read_struct(section_data__maybe_compressed, 0, &chdr32);
-        if(chdr_size == sizeof(chdr32))
-        {
-          chdr64 = elf_chdr64_from_chdr32(chdr32);
-        }
+        section_data__uncompressed = section_data__maybe_compressed;
       }
-      
-      // rjf: decompress
+      else
       {
+        // rjf: read compressed-section header
+        ELF_Chdr64 chdr64 = {0};
+        U64 chdr_size = 0;
+        if(ELF_HdrIs64Bit(bin->hdr.e_ident))
+        {
+          chdr_size = str8_deserial_read_struct(section_data__maybe_compressed, 0, &chdr64);
+        }
+        else if(ELF_HdrIs32Bit(bin->hdr.e_ident))
+        {
+          ELF_Chdr32 chdr32 = {0};
+          chdr_size = str8_deserial_read_struct(section_data__maybe_compressed, 0, &chdr32);
+          if(chdr_size == sizeof(chdr32))
+          {
+            chdr64 = elf_chdr64_from_chdr32(chdr32);
+          }
+        }
+        
+        // build tasks
         String8 section_data__compressed_contents = str8_skip(section_data__maybe_compressed, chdr_size);
         switch(chdr64.ch_type)
         {
@@ -86,14 +111,56 @@ dw_input_from_elf_bin(Arena *arena, String8 data, ELF_Bin *bin)
             section_data__uncompressed = section_data__compressed_contents;
           }break;
           case ELF_CompressType_ZLib:
-          {
-            U8 *section_data_uncompressed_buffer = push_array_no_zero_aligned(arena, U8, chdr64.ch_size, chdr64.ch_addr_align);
-            U64 section_data_uncompressed_size = zsinflate(section_data_uncompressed_buffer, chdr64.ch_size, section_data__compressed_contents.str, section_data__compressed_contents.size);
-            section_data__uncompressed = str8(section_data_uncompressed_buffer, section_data_uncompressed_size);
-          }break;
           case ELF_CompressType_ZStd:
           {
-            NotImplemented;
+            U8 *section_data_uncompressed_buffer = push_array_no_zero_aligned(arena, U8, chdr64.ch_size, Max(chdr64.ch_addr_align, 1));
+            section_data__uncompressed = str8(section_data_uncompressed_buffer, chdr64.ch_size);
+            
+            // zstd frames are independent; if every frame records its
+            // content size, each one can be decoded on its own into its slice
+            ZSTD_FrameArray frames = {0};
+            if(chdr64.ch_type == ELF_CompressType_ZStd)
+            {
+              frames = zstd_frame_array_from_data(scratch.arena, section_data__compressed_contents);
+              U64 frames_dst_size = 0;
+              for EachIndex(frame_idx, frames.count)
+              {
+                if(frames.v[frame_idx].dst_size == max_U64) { frames_dst_size = max_U64; break; }
+                frames_dst_size += frames.v[frame_idx].dst_size;
+              }
+              if(frames_dst_size != chdr64.ch_size)
+              {
+                MemoryZeroStruct(&frames);
+              }
+            }
+            if(frames.count > 1)
+            {
+              U64 dst_off = 0;
+              for EachIndex(frame_idx, frames.count)
+              {
+                DW_ELFDecompressTaskNode *n = push_array(scratch.arena, DW_ELFDecompressTaskNode, 1);
+                n->v.section_kind  = section_kind;
+                n->v.compress_type = chdr64.ch_type;
+                n->v.src           = str8_substr(section_data__compressed_contents, frames.v[frame_idx].src_range);
+                n->v.dst           = section_data_uncompressed_buffer + dst_off;
+                n->v.dst_off       = dst_off;
+                n->v.dst_size      = frames.v[frame_idx].dst_size;
+                SLLQueuePush(first_task, last_task, n);
+                task_count += 1;
+                dst_off += frames.v[frame_idx].dst_size;
+              }
+            }
+            else
+            {
+              DW_ELFDecompressTaskNode *n = push_array(scratch.arena, DW_ELFDecompressTaskNode, 1);
+              n->v.section_kind  = section_kind;
+              n->v.compress_type = chdr64.ch_type;
+              n->v.src           = section_data__compressed_contents;
+              n->v.dst           = section_data_uncompressed_buffer;
+              n->v.dst_size      = chdr64.ch_size;
+              SLLQueuePush(first_task, last_task, n);
+              task_count += 1;
+            }
           }break;
           default:
           {
@@ -101,14 +168,80 @@ dw_input_from_elf_bin(Arena *arena, String8 data, ELF_Bin *bin)
           }break;
         }
       }
+      
+      //- rjf: store
+      is_section_present[section_kind] = 1;
+      DW_Section *d = &result->sec[section_kind];
+      d->name   = push_str8_copy(arena, section_name);
+      d->data   = section_data__uncompressed;
+      d->is_dwo = is_dwo;
     }
     
-    //- rjf: store
-    is_section_present[section_kind] = 1;
-    DW_Section *d = &result.sec[section_kind];
-    d->name   = push_str8_copy(arena, section_name);
-    d->data   = section_data__uncompressed;
-    d->is_dwo = is_dwo;
+    //- flatten & sort tasks
+    tasks = push_array(scratch.arena, DW_ELFDecompressTask, task_count);
+    {
+      U64 task_idx = 0;
+      for EachNode(n, DW_ELFDecompressTaskNode, first_task)
+      {
+        tasks[task_idx] = n->v;
+        task_idx += 1;
+      }
+    }
+    quick_sort(tasks, task_count, sizeof(tasks[0]), dw_elf_decompress_task_is_before);
   }
-  return result;
+  lane_sync_u64(&result, 0);
+  lane_sync_u64(&tasks, 0);
+  lane_sync_u64(&task_count, 0);
+  lane_sync_u64(&task_take_counter_ptr, 0);
+  
+  //////////////////////////////
+  //- decompress
+  //
+  ProfScope("decompress debug sections")
+  {
+    for(;;)
+    {
+      U64 task_idx = ins_atomic_u64_inc_eval(task_take_counter_ptr) - 1;
+      if(task_idx >= task_count)
+      {
+        break;
+      }
+      DW_ELFDecompressTask *task = &tasks[task_idx];
+      switch(task->compress_type)
+      {
+        default:{}break;
+        case ELF_CompressType_ZLib:
+        {
+          task->decoded_size = zsinflate(task->dst, task->dst_size, task->src.str, task->src.size);
+        }break;
+        case ELF_CompressType_ZStd:
+        {
+          task->decoded_size = zstd_decompress(task->dst, task->dst_size, task->src.str, task->src.size);
+        }break;
+      }
+    }
+  }
+  lane_sync();
+  
+  //////////////////////////////
+  //- trim sections to what actually decoded - if any part of a section
+  // came up short, only the prefix before it is usable
+  //
+  if(lane_idx() == 0)
+  {
+    for EachIndex(task_idx, task_count)
+    {
+      DW_ELFDecompressTask *task = &tasks[task_idx];
+      if(task->decoded_size < task->dst_size)
+      {
+        DW_Section *d = &result->sec[task->section_kind];
+        d->data.size = Min(d->data.size, task->dst_off + task->decoded_size);
+      }
+    }
+  }
+  lane_sync();
+  
+  DW_Input input = *result;
+  scratch_end(scratch);
+  return input;
 }
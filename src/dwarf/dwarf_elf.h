@@ -4,6 +4,26 @@
 #ifndef DWARF_ELF_H
 #define DWARF_ELF_H
 
+typedef struct DW_ELFDecompressTask DW_ELFDecompressTask;
+struct DW_ELFDecompressTask
+{
+  DW_SectionKind   section_kind;
+  ELF_CompressType compress_type;
+  String8          src;
+  U8              *dst;
+  U64              dst_off; // offset of this task's output within the section
+  U64              dst_size;
+  U64              decoded_size;
+};
+
+typedef struct DW_ELFDecompressTaskNode DW_ELFDecompressTaskNode;
+struct DW_ELFDecompressTaskNode
+{
+  DW_ELFDecompressTaskNode *next;
+  DW_ELFDecompressTask      v;
+};
+
+internal int dw_elf_decompress_task_is_before(DW_ELFDecompressTask *a, DW_ELFDecompressTask *b);
 internal B32 dw_is_dwarf_present_from_elf_bin(String8 raw_image, ELF_Bin *bin);
 internal DW_Input dw_input_from_elf_bin(Arena *arena, String8 raw_image, ELF_Bin *bin);
 
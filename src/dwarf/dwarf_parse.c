@@ -437,6 +437,121 @@ dw_addr_from_list_unit(DW_ListUnit *lu, U64 index)
   return addr;
 }
 
+internal DW_SectionKind
+dw_section_kind_from_sect(U32 index_version, DW_SECT sect)
+{
+  DW_SectionKind result = DW_Section_Null;
+  switch (sect) {
+    default: break;
+    case DW_SECT_Info:       { result = DW_Section_Info;                                              } break;
+    case DW_SECT_Abbrev:     { result = DW_Section_Abbrev;                                            } break;
+    case DW_SECT_Line:       { result = DW_Section_Line;                                              } break;
+    case DW_SECT_StrOffsets: { result = DW_Section_StrOffsets;                                        } break;
+    case DW_SECT_LocLists:   { result = index_version < 5 ? DW_Section_Loc     : DW_Section_LocLists; } break;
+    case DW_SECT_Macro:      { result = index_version < 5 ? DW_Section_MacInfo : DW_Section_Null;     } break;
+    case DW_SECT_RngLists:   { result = index_version < 5 ? DW_Section_Null    : DW_Section_RngLists; } break;
+  }
+  return result;
+}
+
+internal DW_UnitIndex
+dw_unit_index_from_data(Arena *arena, String8 data)
+{
+  DW_UnitIndex result = {0};
+  
+  // read header, v5 stores version as U16 followed by two bytes of padding,
+  // which reads the same as v2's U32 on little-endian
+  U32 version      = 0;
+  U32 column_count = 0;
+  U32 unit_count   = 0;
+  U32 slot_count   = 0;
+  U64 cursor       = 0;
+  cursor += str8_deserial_read_struct(data, cursor, &version);
+  cursor += str8_deserial_read_struct(data, cursor, &column_count);
+  cursor += str8_deserial_read_struct(data, cursor, &unit_count);
+  cursor += str8_deserial_read_struct(data, cursor, &slot_count);
+  
+  // validate header
+  U64 slot_sigs_off = cursor;
+  U64 slot_rows_off = slot_sigs_off + (U64)slot_count * sizeof(U64);
+  U64 columns_off   = slot_rows_off + (U64)slot_count * sizeof(U32);
+  U64 offsets_off   = columns_off   + (U64)column_count * sizeof(U32);
+  U64 sizes_off     = offsets_off   + (U64)unit_count * column_count * sizeof(U32);
+  U64 index_size    = sizes_off     + (U64)unit_count * column_count * sizeof(U32);
+  B32 is_header_ok  = (cursor == sizeof(U32) * 4 &&
+                       (version == 2 || version == 5) &&
+                       IsPow2OrZero(slot_count) &&
+                       index_size <= data.size);
+  
+  if (is_header_ok) {
+    result.version      = version;
+    result.column_count = column_count;
+    result.unit_count   = unit_count;
+    result.slot_count   = slot_count;
+    result.slot_sigs    = push_array_no_zero(arena, U64, slot_count);
+    result.slot_rows    = push_array_no_zero(arena, U32, slot_count);
+    result.column_kinds = push_array_no_zero(arena, DW_SectionKind, column_count);
+    result.offsets      = push_array_no_zero(arena, U32, (U64)unit_count * column_count);
+    result.sizes        = push_array_no_zero(arena, U32, (U64)unit_count * column_count);
+    str8_deserial_read_array(data, slot_sigs_off, result.slot_sigs, slot_count);
+    str8_deserial_read_array(data, slot_rows_off, result.slot_rows, slot_count);
+    str8_deserial_read_array(data, offsets_off,   result.offsets,   (U64)unit_count * column_count);
+    str8_deserial_read_array(data, sizes_off,     result.sizes,     (U64)unit_count * column_count);
+    for EachIndex(column_idx, column_count) {
+      DW_SECT sect = 0;
+      str8_deserial_read_struct(data, columns_off + column_idx * sizeof(sect), &sect);
+      result.column_kinds[column_idx] = dw_section_kind_from_sect(version, sect);
+    }
+  }
+  
+  return result;
+}
+
+internal U64
+dw_unit_index_row_from_sig(DW_UnitIndex *index, U64 sig)
+{
+  U64 row = 0;
+  if (index->slot_count) {
+    // open addressing with double hashing, as specified by DWARF5 7.3.5.3
+    U64 mask = index->slot_count - 1;
+    U64 slot = sig & mask;
+    U64 step = ((sig >> 32) & mask) | 1;
+    for EachIndex(probe_idx, index->slot_count) {
+      if (index->slot_rows[slot] == 0) {
+        break;
+      }
+      if (index->slot_sigs[slot] == sig) {
+        row = index->slot_rows[slot];
+        break;
+      }
+      slot = (slot + step) & mask;
+    }
+  }
+  if (row > index->unit_count) {
+    row = 0;
+  }
+  return row;
+}
+
+internal DW_Input
+dw_input_from_unit_index_row(DW_Input *package, DW_UnitIndex *index, U64 row)
+{
+  // sections listed in the index are narrowed to the unit's contributions,
+  // the rest (e.g. .debug_str.dwo) are shared by all units in the package
+  DW_Input result = *package;
+  if (0 < row && row <= index->unit_count) {
+    U32 *row_offsets = index->offsets + (row - 1) * index->column_count;
+    U32 *row_sizes   = index->sizes   + (row - 1) * index->column_count;
+    for EachIndex(column_idx, index->column_count) {
+      DW_SectionKind section_kind = index->column_kinds[column_idx];
+      if (section_kind == DW_Section_Null) { continue; }
+      Rng1U64 contrib_range = rng_1u64(row_offsets[column_idx], (U64)row_offsets[column_idx] + row_sizes[column_idx]);
+      result.sec[section_kind].data = str8_substr(package->sec[section_kind].data, contrib_range);
+    }
+  }
+  return result;
+}
+
 internal U64
 dw_read_abbrev_tag(String8 data, U64 offset, DW_Abbrev *out_abbrev)
 {
@@ -762,7 +877,9 @@ dw_read_form(String8      data,
     } break;
     case DW_Form_Addrx:
     case DW_Form_RngListx:
-    case DW_Form_Strx: {
+    case DW_Form_Strx:
+    case DW_Form_GNU_AddrIndex:
+    case DW_Form_GNU_StrIndex: {
       bytes_read = str8_deserial_read_uleb128(data, off, &form.xval);
     } break;
     case DW_Form_RefSup4: {
@@ -1043,7 +1160,7 @@ dw_interp_address(U64 address_size, U64 base_addr, DW_ListUnit *addr_lu, DW_Form
       AssertAlways(!"unable to decode address");
     }
   } else if (form_kind == DW_Form_Addrx || form_kind == DW_Form_Addrx1 || form_kind == DW_Form_Addrx2 ||
-             form_kind == DW_Form_Addrx3 || form_kind == DW_Form_Addrx4) {
+             form_kind == DW_Form_Addrx3 || form_kind == DW_Form_Addrx4 || form_kind == DW_Form_GNU_AddrIndex) {
     address = dw_addr_from_list_unit(addr_lu, form.xval);
   } else if (form_kind == DW_Form_SecOffset) {
     if (addr_lu->segment_selector_size > 0) {
@@ -1088,7 +1205,7 @@ dw_interp_string(DW_Input    *input,
     Assert(bytes_read > 0);
   } else if (form_kind == DW_Form_Strx || form_kind == DW_Form_Strx1 ||
              form_kind == DW_Form_Strx2 || form_kind == DW_Form_Strx3 ||
-             form_kind == DW_Form_Strx4) {
+             form_kind == DW_Form_Strx4 || form_kind == DW_Form_GNU_StrIndex) {
     U64 sec_offset = dw_offset_from_list_unit(str_offsets, form.xval);
     if (sec_offset < input->sec[DW_Section_Str].data.size) {
       U64 bytes_read = str8_deserial_read_cstr(input->sec[DW_Section_Str].data, sec_offset, &string);
@@ -1098,8 +1215,6 @@ dw_interp_string(DW_Input    *input,
     }
   } else if (form_kind == DW_Form_GNU_StrpAlt) {
     NotImplemented;
-  } else if (form_kind == DW_Form_GNU_StrIndex) {
-    NotImplemented;
   } else if (form_kind != DW_Form_Null) {
     AssertAlways(!"unexpected form");
   }
@@ -1138,8 +1253,9 @@ dw_interp_ref(DW_Input *input, DW_CompUnit *cu, DW_FormKind form_kind, DW_Form f
   if (form_kind == DW_Form_Ref1 || form_kind == DW_Form_Ref2 ||
       form_kind == DW_Form_Ref4 || form_kind == DW_Form_Ref8 ||
       form_kind == DW_Form_RefUData) {
+    // unit-relative forms are offsets from the unit header, tags are keyed by section offset
     ref.cu = cu;
-    ref.info_off = form.ref;
+    ref.info_off = cu->info_range.min + form.ref;
   } else if (form_kind == DW_Form_RefAddr) {
     NotImplemented;
   } else if (form_kind == DW_Form_RefSig8) {
@@ -1157,7 +1273,80 @@ dw_interp_loclist(Arena *arena, DW_Input *input, DW_CompUnit *cu, DW_FormKind fo
 {
   DW_LocList loclist = {0};
   
-  if (cu->version < DW_Version_5) {
+  if (cu->version < DW_Version_5 && input->sec[DW_Section_Info].is_dwo) {
+    // pre-standard split units (GNU extension) tag entries with the first five
+    // DWARF5 kinds, but addresses are indices into the skeleton's .debug_addr,
+    // lengths and offsets are four bytes and expression sizes are two bytes
+    if (form_kind == DW_Form_SecOffset) {
+      String8 sec       = str8_skip(input->sec[DW_Section_Loc].data, form.sec_offset);
+      U64     base_addr = cu->low_pc;
+      for (U64 cursor = 0, keep_parsing = (cu->addr_lu != 0); cursor < sec.size && keep_parsing; ) {
+        DW_LLE kind = DW_LLE_EndOfList;
+        cursor += str8_deserial_read_struct(sec, cursor, &kind);
+        
+        Rng1U64 range    = {0};
+        B32     has_expr = 0;
+        switch (kind) {
+          default: {
+            Assert(!"unknown kind");
+            keep_parsing = 0;
+          } break;
+          case DW_LLE_EndOfList: {
+            keep_parsing = 0;
+          } break;
+          case DW_LLE_BaseAddressx: {
+            U64 addrx = 0;
+            cursor   += str8_deserial_read_uleb128(sec, cursor, &addrx);
+            base_addr = dw_addr_from_list_unit(cu->addr_lu, addrx);
+          } break;
+          case DW_LLE_StartxEndx: {
+            U64 start_addrx = 0;
+            U64 end_addrx   = 0;
+            cursor += str8_deserial_read_uleb128(sec, cursor, &start_addrx);
+            cursor += str8_deserial_read_uleb128(sec, cursor, &end_addrx);
+            range    = rng_1u64(dw_addr_from_list_unit(cu->addr_lu, start_addrx), dw_addr_from_list_unit(cu->addr_lu, end_addrx));
+            has_expr = 1;
+          } break;
+          case DW_LLE_StartxLength: {
+            U64 start_addrx = 0;
+            U32 length      = 0;
+            cursor += str8_deserial_read_uleb128(sec, cursor, &start_addrx);
+            cursor += str8_deserial_read_struct(sec, cursor, &length);
+            U64 start = dw_addr_from_list_unit(cu->addr_lu, start_addrx);
+            range    = rng_1u64(start, start + length);
+            has_expr = 1;
+          } break;
+          case DW_LLE_OffsetPair: {
+            U32 start = 0;
+            U32 end   = 0;
+            cursor += str8_deserial_read_struct(sec, cursor, &start);
+            cursor += str8_deserial_read_struct(sec, cursor, &end);
+            range    = rng_1u64(base_addr + start, base_addr + end);
+            has_expr = 1;
+          } break;
+        }
+        
+        if (has_expr) {
+          U16     expr_size = 0;
+          String8 expr      = {0};
+          cursor += str8_deserial_read_struct(sec, cursor, &expr_size);
+          if (str8_deserial_read_block(sec, cursor, expr_size, &expr) != expr_size) {
+            break;
+          }
+          cursor += expr_size;
+          
+          DW_LocNode *loc_n = push_array(arena, DW_LocNode, 1);
+          loc_n->v.range    = range;
+          loc_n->v.expr     = expr;
+          
+          SLLQueuePush(loclist.first, loclist.last, loc_n);
+          ++loclist.count;
+        }
+      }
+    } else if (form_kind != DW_Form_Null) {
+      AssertAlways(!"unexpected form");
+    }
+  } else if (cu->version < DW_Version_5) {
     if (form_kind == DW_Form_SecOffset) {
       U64 sec_offset = max_U64;
       if (form_kind == DW_Form_SecOffset) {
@@ -2123,10 +2312,9 @@ dw_cu_from_info_off(Arena *arena, DW_Input *input, DW_ListUnitInput lu_input, U6
         dw_read_tag(arena, data, cursor, range.min, abbrev_table, abbrev_data, version, format, address_size, &cu_tag);
         
         // TODO: handle these unit types
-        Assert(cu_tag.kind != DW_TagKind_SkeletonUnit);
         Assert(cu_tag.kind != DW_TagKind_TypeUnit);
         
-        if (cu_tag.kind == DW_TagKind_CompileUnit || cu_tag.kind == DW_TagKind_PartialUnit) {
+        if (cu_tag.kind == DW_TagKind_CompileUnit || cu_tag.kind == DW_TagKind_PartialUnit || cu_tag.kind == DW_TagKind_SkeletonUnit) {
           // fetch attribs for list sections
           DW_Attrib *addr_base_attrib        = dw_attrib_from_tag(0, 0, cu_tag, DW_AttribKind_AddrBase      );
           DW_Attrib *str_offsets_base_attrib = dw_attrib_from_tag(0, 0, cu_tag, DW_AttribKind_StrOffsetsBase);
@@ -2151,10 +2339,42 @@ dw_cu_from_info_off(Arena *arena, DW_Input *input, DW_ListUnitInput lu_input, U6
           DW_ListUnit *rnglists_lu    = rnglists_lu_idx    < lu_input.rnglist_count    ? &lu_input.rnglists[rnglists_lu_idx]       : 0;
           DW_ListUnit *loclists_lu    = loclists_lu_idx    < lu_input.loclist_count    ? &lu_input.loclists[loclists_lu_idx]       : 0;
           
+          // pre-standard split units (GNU extension) have no headers in front of
+          // their list sections: the skeleton's address base points right at its
+          // addresses, and the string offsets of a .dwo start at its beginning
+          if (version < DW_Version_5) {
+            DW_Attrib *gnu_addr_base_attrib = dw_attrib_from_tag(0, 0, cu_tag, DW_AttribKind_GNU_AddrBase);
+            if (gnu_addr_base_attrib->attrib_kind == DW_AttribKind_GNU_AddrBase) {
+              U64 gnu_addr_base = dw_interp_sec_offset(gnu_addr_base_attrib->form_kind, gnu_addr_base_attrib->form);
+              addr_lu               = push_array(arena, DW_ListUnit, 1);
+              addr_lu->version      = version;
+              addr_lu->address_size = address_size;
+              addr_lu->entry_size   = address_size;
+              addr_lu->entries      = str8_skip(input->sec[DW_Section_Addr].data, gnu_addr_base);
+            }
+            if (input->sec[DW_Section_Info].is_dwo) {
+              str_offsets_lu             = push_array(arena, DW_ListUnit, 1);
+              str_offsets_lu->version    = version;
+              str_offsets_lu->entry_size = dw_size_from_format(format);
+              str_offsets_lu->entries    = input->sec[DW_Section_StrOffsets].data;
+            }
+          }
+          
           // find compile unit base address
           DW_Attrib *low_pc_attrib = dw_attrib_from_tag(0, 0, cu_tag, DW_AttribKind_LowPc);
           U64        low_pc        = dw_interp_address(address_size, max_U64, addr_lu, low_pc_attrib->form_kind, low_pc_attrib->form);
           
+          // find split unit id, pre-standard split units store it in an attribute
+          U64 dwo_id = 0;
+          if (unit_kind == DW_CompUnitKind_Skeleton || unit_kind == DW_CompUnitKind_SplitCompile) {
+            dwo_id = spec_dwo_id;
+          } else {
+            DW_Attrib *dwo_id_attrib = dw_attrib_from_tag(0, 0, cu_tag, DW_AttribKind_GNU_DwoId);
+            if (dwo_id_attrib->attrib_kind == DW_AttribKind_GNU_DwoId) {
+              dwo_id = dw_interp_const_u64(dwo_id_attrib->form_kind, dwo_id_attrib->form);
+            }
+          }
+          
           // fill out compile unit
           cu.relaxed            = relaxed;
           cu.ext                = DW_Ext_All;
@@ -2172,6 +2392,7 @@ dw_cu_from_info_off(Arena *arena, DW_Input *input, DW_ListUnitInput lu_input, U6
           cu.rnglists_lu        = rnglists_lu;
           cu.loclists_lu        = loclists_lu;
           cu.low_pc             = low_pc;
+          cu.dwo_id             = dwo_id;
           cu.tag                = cu_tag;
         } else { 
           // unexpected tag, release memory and exit
@@ -2222,7 +2443,7 @@ dw_tag_tree_from_cu(Arena *arena, DW_Input *input, DW_CompUnit *cu)
   String8    abbrev_data = input->sec[DW_Section_Abbrev].data;
   String8    info_data   = str8_substr(input->sec[DW_Section_Info].data, cu->info_range);
   DW_TagNode root        = {0};
-  U64        cursor      = cu->first_tag_info_off;
+  U64        cursor      = cu->first_tag_info_off - cu->info_range.min;
   U64        tag_count   = 0;
   dw_tag_tree_from_data(arena, info_data, abbrev_data, cu, &root, &cursor, &tag_count);
   
@@ -3550,6 +3771,7 @@ dw_parse_cfa_inst(String8        data,
     U32 delta = 0;
     U64 delta_size = str8_deserial_read_struct(data, cursor, &delta);
     if (delta_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
+    cursor += delta_size;
     operands[0].u64 = delta * code_align_factor;
   } break;
   case DW_CFA_DefCfa: {
@@ -3597,8 +3819,8 @@ dw_parse_cfa_inst(String8        data,
     operands[0].u64 = offset;
   } break;
   case DW_CFA_DefCfaOffsetSf: {
-    U64 offset = 0;
-    U64 offset_size = str8_deserial_read_uleb128(data, cursor, &offset);
+    S64 offset = 0;
+    U64 offset_size = str8_deserial_read_sleb128(data, cursor, &offset);
     if (offset_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
     cursor += offset_size;
 
@@ -3695,7 +3917,7 @@ dw_parse_cfa_inst(String8        data,
     cursor += offset_size;
 
     operands[0].u64 = val;
-    operands[1].s64 = offset;
+    operands[1].s64 = offset * data_align_factor;
   } break;
   case DW_CFA_Register: {
     U64 dst_reg = 0;
@@ -3726,7 +3948,8 @@ dw_parse_cfa_inst(String8        data,
     String8 expr = str8_prefix(str8_skip(data, cursor), expr_size);
     cursor += expr_size;
 
-    operands[0].block = expr;
+    operands[0].u64   = reg;
+    operands[1].block = expr;
   } break;
   case DW_CFA_ValExpr: {
     U64 val = 0;
@@ -3749,7 +3972,22 @@ dw_parse_cfa_inst(String8        data,
   case DW_CFA_Restore: {
     operands[0].u64 = implicit_operand;
   } break;
-  case DW_CFA_RestoreExt: {} break;
+  case DW_CFA_RestoreExt: {
+    U64 reg = 0;
+    U64 reg_size = str8_deserial_read_uleb128(data, cursor, &reg);
+    if (reg_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
+    cursor += reg_size;
+
+    operands[0].u64 = reg;
+  } break;
+  case DW_CFA_GNUArgsSize: {
+    U64 size = 0;
+    U64 size_size = str8_deserial_read_uleb128(data, cursor, &size);
+    if (size_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
+    cursor += size_size;
+
+    operands[0].u64 = size;
+  } break;
   case DW_CFA_RememberState: {} break;
   case DW_CFA_RestoreState: {} break;
   case DW_CFA_Nop: {} break;
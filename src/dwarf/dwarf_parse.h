@@ -313,6 +313,22 @@ typedef struct DW_PubStringsTable
   DW_PubStringsBucket **buckets;
 } DW_PubStringsTable;
 
+////////////////////////////////
+// .debug_cu_index and .debug_tu_index
+
+typedef struct DW_UnitIndex
+{
+  U32             version;
+  U32             column_count;
+  U32             unit_count;
+  U32             slot_count;
+  U64            *slot_sigs;    // [slot_count]
+  U32            *slot_rows;    // [slot_count], one-based, zero marks an empty slot
+  DW_SectionKind *column_kinds; // [column_count]
+  U32            *offsets;      // [unit_count * column_count]
+  U32            *sizes;        // [unit_count * column_count]
+} DW_UnitIndex;
+
 typedef struct DW_Reference
 {
   DW_CompUnit *cu;
@@ -457,6 +473,13 @@ internal DW_ListUnitInput dw_list_unit_input_from_input(Arena *arena, DW_Input *
 internal U64 dw_offset_from_list_unit(DW_ListUnit *lu, U64 index);
 internal U64 dw_addr_from_list_unit  (DW_ListUnit *lu, U64 index);
 
+// unit index (DWARF packages)
+
+internal DW_SectionKind dw_section_kind_from_sect(U32 index_version, DW_SECT sect);
+internal DW_UnitIndex   dw_unit_index_from_data(Arena *arena, String8 data);
+internal U64            dw_unit_index_row_from_sig(DW_UnitIndex *index, U64 sig);
+internal DW_Input       dw_input_from_unit_index_row(DW_Input *package, DW_UnitIndex *index, U64 row);
+
 // abbrev table
 
 internal U64            dw_read_abbrev_tag   (String8 data, U64 offset, DW_Abbrev *out_abbrev);
@@ -167,6 +167,7 @@ dw_cfi_next_row(Arena *arena, DW_CFI_Unwind *uw)
     } break;
 
     case DW_CFA_Nop: {} break;
+    case DW_CFA_GNUArgsSize: {} break; // size of stack arguments, only relevant for landing pads
 
     default: { NotImplemented; } break; // TODO: report error: unknown CFA opcode
     }
@@ -183,11 +184,33 @@ exit:;
   return is_row_valid;
 }
 
+internal B32
+dw_cfi_unwind_to_pc(Arena *arena, DW_CFI_Unwind *uw, U64 pc)
+{
+  B32 is_row_valid = 1;
+  if (pc < uw->fde->pc_range.min || pc >= uw->fde->pc_range.max) { is_row_valid = 0; goto exit; }
+
+  // execute rows until next row starts past the target PC
+  while (uw->curr_inst) {
+    DW_CFA_Inst *inst = &uw->curr_inst->v;
+    if (dw_is_new_row_cfa_opcode(inst->opcode)) {
+      U64 next_pc = inst->opcode == DW_CFA_SetLoc ? inst->operands[0].u64 : uw->pc + inst->operands[0].u64;
+      if (next_pc > pc) { break; }
+    }
+    is_row_valid = dw_cfi_next_row(arena, uw);
+    if (!is_row_valid) { break; }
+  }
+
+exit:;
+  return is_row_valid;
+}
+
 internal DW_UnwindStatus
 dw_cfi_apply_register_rules(DW_CFI_Unwind *uw,
                             DW_MemRead    *mem_read_func,  void *mem_read_ud,
                             DW_RegRead    *reg_read_func,  void *reg_read_ud,
-                            DW_RegWrite   *reg_write_func, void *reg_write_ud)
+                            DW_RegWrite   *reg_write_func, void *reg_write_ud,
+                            U64           *cfa_out)
 {
   Temp scratch = scratch_begin(0,0);
   DW_UnwindStatus unwind_status = DW_UnwindStatus_Ok;
@@ -209,8 +232,13 @@ dw_cfi_apply_register_rules(DW_CFI_Unwind *uw,
   } break;
   case DW_CFA_Rule_Expression: {
     // TODO: evaluate expression
+    unwind_status = DW_UnwindStatus_Fail;
+    goto exit;
   } break;
   }
+  if (cfa_out) {
+    *cfa_out = cfa;
+  }
 
   U64   max_reg_size = dw_reg_max_size_from_arch(uw->arch);
   void *reg_buffer   = push_array(scratch.arena, U8, max_reg_size);
@@ -219,8 +247,11 @@ dw_cfi_apply_register_rules(DW_CFI_Unwind *uw,
     DW_CFI_Register *reg = &uw->row->regs[reg_idx];
     switch (reg->rule) {
     case DW_CFI_RegisterRule_Undefined: {
-      // TODO: ???
-      Assert(!"undefined");
+      // value is not recoverable in the caller, e.g. return address in the outermost frame
+      U64 reg_size = dw_reg_size_from_code(uw->arch, reg_idx);
+      MemoryZero(reg_buffer, reg_size);
+      unwind_status = reg_write_func(reg_idx, reg_buffer, reg_size, reg_write_ud);
+      if (unwind_status != DW_UnwindStatus_Ok) { goto exit; }
     } break;
     case DW_CFI_RegisterRule_SameValue: {} break;
     case DW_CFI_RegisterRule_Offset: {
@@ -255,11 +286,13 @@ dw_cfi_apply_register_rules(DW_CFI_Unwind *uw,
     } break;
     case DW_CFI_RegisterRule_Expression: {
       // TODO: evaluate expression
-      NotImplemented;
+      unwind_status = DW_UnwindStatus_Fail;
+      goto exit;
     } break;
     case DW_CFI_RegisterRule_ValExpression: {
       // TODO: evaluate expression
-      NotImplemented;
+      unwind_status = DW_UnwindStatus_Fail;
+      goto exit;
     } break;
     case DW_CFI_RegisterRule_Architectural: {
       NotImplemented;
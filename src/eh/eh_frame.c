@@ -6,6 +6,11 @@ eh_read_ptr(String8 frame_base, U64 off, EH_PtrCtx *ptr_ctx, EH_PtrEnc encoding,
 {
   U64 ptr_off = off;
 
+  // pointer is not present
+  if (encoding == EH_PtrEnc_Omit) {
+    return 0;
+  }
+
   // align read offset as needed
   if (encoding == EH_PtrEnc_Aligned) {
     ptr_off  = AlignPow2(ptr_off, ptr_ctx->ptr_align);
@@ -48,7 +53,7 @@ eh_read_ptr(String8 frame_base, U64 off, EH_PtrCtx *ptr_ctx, EH_PtrEnc encoding,
   if (decode_size > 0) {
     U64 ptr = raw_ptr;
     switch (encoding & EH_PtrEnc_ModifierMask) {
-    case EH_PtrEnc_PcRel:   { ptr = ptr_ctx->raw_base_vaddr + off + raw_ptr; } break;
+    case EH_PtrEnc_PcRel:   { ptr = ptr_ctx->raw_base_vaddr + ptr_off + raw_ptr; } break;
     case EH_PtrEnc_TextRel: { ptr = ptr_ctx->text_vaddr + raw_ptr;           } break;
     case EH_PtrEnc_DataRel: { ptr = ptr_ctx->data_vaddr + raw_ptr;           } break;
     case EH_PtrEnc_FuncRel: {
@@ -58,11 +63,11 @@ eh_read_ptr(String8 frame_base, U64 off, EH_PtrCtx *ptr_ctx, EH_PtrEnc encoding,
     }
 
     if (ptr_out) {
-      *ptr_out = raw_ptr;
+      *ptr_out = ptr;
     }
   }
 
-  return decode_size;
+  return (ptr_off - off) + decode_size;
 }
 
 internal U64
@@ -74,7 +79,7 @@ eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_A
   // Reference: https://refspecs.linuxfoundation.org/LSB_3.0.0/LSB-PDA/LSB-PDA/ehframechpt.html
   // Reference doc doesn't clarify structure for EH Data though
 
-  U64 cursor = 0;
+  U64 aug_cursor = 0;
 
   EH_AugFlags aug_flags        = 0;
   EH_PtrEnc lsda_encoding    = EH_PtrEnc_Omit;
@@ -82,8 +87,7 @@ eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_A
   EH_PtrEnc handler_encoding = EH_PtrEnc_Omit;
   U64         handler_ip       = 0;
   if (str8_match(str8_prefix(aug_string, 1), str8_lit("z"), 0)) {
-    U64 aug_cursor = 0;
-    for (U8 *ptr = aug_string.str; ptr < (aug_string.str+aug_string.size); ptr += 1) {
+    for (U8 *ptr = aug_string.str + 1; ptr < (aug_string.str+aug_string.size); ptr += 1) {
       switch (*ptr) {
       case 'L': {
         aug_cursor += str8_deserial_read_struct(aug_data, aug_cursor, &lsda_encoding);
@@ -98,6 +102,10 @@ eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_A
         aug_cursor += str8_deserial_read_struct(aug_data, aug_cursor, &addr_encoding);
         aug_flags |= EH_AugFlag_HasAddrEnc;
       } break;
+      case 'S': {
+        // signal frame, no augmentation data
+        aug_flags |= EH_AugFlag_IsSignal;
+      } break;
       default: { Assert(!"failed to parse augmentation string"); goto exit; } break;
       }
     }
@@ -106,13 +114,13 @@ eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_A
   if (aug_out) {
     aug_out->handler_ip       = handler_ip;
     aug_out->handler_encoding = handler_encoding;
-    aug_out->lsda_encoding    = handler_encoding;
+    aug_out->lsda_encoding    = lsda_encoding;
     aug_out->addr_encoding    = addr_encoding;
     aug_out->flags            = aug_flags;
   }
 
 exit:;
-  U64 parse_size = cursor; 
+  U64 parse_size = aug_cursor;
   return parse_size;
 }
 
@@ -122,122 +130,354 @@ eh_size_from_aug_data(String8 aug_string, String8 data, EH_PtrCtx *ptr_ctx)
   return eh_parse_aug_data(aug_string, data, ptr_ctx, 0);
 }
 
+////////////////////////////////
+//~ .eh_frame Entries
+
 internal U64
-eh_frame_hdr_search_linear_x64(String8 raw_eh_frame_hdr, EH_PtrCtx *ptr_ctx, U64 location)
+eh_parse_entry_header(String8 eh_frame, U64 off, U32 *id_out, Rng1U64 *entry_range_out)
 {
-  // Table contains only addresses for first instruction in a function and we cannot
-  // guarantee that result is FDE that corresponds to the input location. 
-  // So input location must be cheked against range from FDE header again.
-  
-  U64 closest_location = max_U64;
-  U64 closest_address  = max_U64;
-  
+  U64 entry_size = 0;
+  U64 cursor     = off;
+
+  // read entry length, zero marks end of the section
+  U32 length32 = 0;
+  if (str8_deserial_read_struct(eh_frame, cursor, &length32) == 0) { goto exit; }
+  cursor += sizeof(length32);
+  U64 length = length32;
+  if (length32 == max_U32) {
+    if (str8_deserial_read_struct(eh_frame, cursor, &length) == 0) { goto exit; }
+    cursor += sizeof(length);
+  }
+  if (length == 0) { goto exit; }
+
+  // entry must fit in the section
+  if (length < sizeof(U32) || length > eh_frame.size - cursor) { goto exit; }
+
+  // CIE id or CIE pointer, always 4 bytes in .eh_frame
+  U32 id = 0;
+  str8_deserial_read_struct(eh_frame, cursor, &id);
+  cursor += sizeof(id);
+
+  if (id_out) {
+    *id_out = id;
+  }
+  if (entry_range_out) {
+    *entry_range_out = rng_1u64(cursor, cursor - sizeof(id) + length);
+  }
+  entry_size = (cursor - sizeof(id) + length) - off;
+
+exit:;
+  return entry_size;
+}
+
+internal B32
+eh_parse_cie(String8 eh_frame, U64 off, EH_PtrCtx *ptr_ctx, EH_CIE *cie_out)
+{
+  B32 is_parsed = 0;
+
+  U32     cie_id      = max_U32;
+  Rng1U64 entry_range = {0};
+  if (eh_parse_entry_header(eh_frame, off, &cie_id, &entry_range) == 0) { goto exit; }
+  if (cie_id != 0) { goto exit; }
+
+  String8 data   = str8_prefix(eh_frame, entry_range.max);
+  U64     cursor = entry_range.min;
+
+  U8 version = 0;
+  U64 version_size = str8_deserial_read_struct(data, cursor, &version);
+  if (version_size == 0) { goto exit; }
+  cursor += version_size;
+
+  String8 aug_string = {0};
+  U64 aug_string_size = str8_deserial_read_cstr(data, cursor, &aug_string);
+  if (aug_string_size == 0) { goto exit; }
+  cursor += aug_string_size;
+
+  // legacy "eh" augmentation carries pointer sized EH data
+  if (str8_match(str8_prefix(aug_string, 2), str8_lit("eh"), 0)) {
+    cursor += sizeof(U64);
+  }
+
+  U64 code_align_factor = 0;
+  U64 code_align_factor_size = str8_deserial_read_uleb128(data, cursor, &code_align_factor);
+  if (code_align_factor_size == 0) { goto exit; }
+  cursor += code_align_factor_size;
+
+  S64 data_align_factor = 0;
+  U64 data_align_factor_size = str8_deserial_read_sleb128(data, cursor, &data_align_factor);
+  if (data_align_factor_size == 0) { goto exit; }
+  cursor += data_align_factor_size;
+
+  U64 ret_addr_reg = 0;
+  U64 ret_addr_reg_size = 0;
+  if (version == 1) { ret_addr_reg_size = str8_deserial_read(data, cursor, &ret_addr_reg, sizeof(U8), sizeof(U8)); }
+  else              { ret_addr_reg_size = str8_deserial_read_uleb128(data, cursor, &ret_addr_reg);                 }
+  if (ret_addr_reg_size == 0) { goto exit; }
+  cursor += ret_addr_reg_size;
+
+  EH_Augmentation aug = {0};
+  aug.lsda_encoding    = EH_PtrEnc_Omit;
+  aug.handler_encoding = EH_PtrEnc_Omit;
+  aug.addr_encoding    = EH_PtrEnc_Ptr;
+  if (str8_match(str8_prefix(aug_string, 1), str8_lit("z"), 0)) {
+    U64 aug_data_size = 0;
+    U64 aug_data_size_size = str8_deserial_read_uleb128(data, cursor, &aug_data_size);
+    if (aug_data_size_size == 0) { goto exit; }
+    cursor += aug_data_size_size;
+
+    if (cursor + aug_data_size > data.size) { goto exit; }
+    String8 aug_data = str8_substr(data, rng_1u64(cursor, cursor + aug_data_size));
+
+    // pointers in augmentation data are relative to their own location
+    EH_PtrCtx aug_ptr_ctx      = *ptr_ctx;
+    aug_ptr_ctx.raw_base_vaddr = ptr_ctx->raw_base_vaddr + cursor;
+    eh_parse_aug_data(aug_string, aug_data, &aug_ptr_ctx, &aug);
+
+    cursor += aug_data_size;
+  } else if (aug_string.size > 0 && !str8_match(aug_string, str8_lit("eh"), 0)) {
+    // unknown augmentation, layout of the rest of the entry is unknown
+    goto exit;
+  }
+
+  cie_out->version           = version;
+  cie_out->aug_string        = aug_string;
+  cie_out->code_align_factor = code_align_factor;
+  cie_out->data_align_factor = data_align_factor;
+  cie_out->ret_addr_reg      = ret_addr_reg;
+  cie_out->aug               = aug;
+  cie_out->insts             = str8_substr(data, rng_1u64(cursor, data.size));
+
+  is_parsed = 1;
+exit:;
+  return is_parsed;
+}
+
+internal B32
+eh_parse_fde(String8 eh_frame, U64 off, EH_PtrCtx *ptr_ctx, EH_CIE *cie_out, EH_FDE *fde_out)
+{
+  B32 is_parsed = 0;
+
+  U32     cie_pointer = 0;
+  Rng1U64 entry_range = {0};
+  if (eh_parse_entry_header(eh_frame, off, &cie_pointer, &entry_range) == 0) { goto exit; }
+  if (cie_pointer == 0) { goto exit; }
+
+  // CIE pointer is relative to the pointer field
+  U64 cie_pointer_off = entry_range.min - sizeof(cie_pointer);
+  if (cie_pointer > cie_pointer_off) { goto exit; }
+  U64 cie_off = cie_pointer_off - cie_pointer;
+
+  EH_CIE cie = {0};
+  if (!eh_parse_cie(eh_frame, cie_off, ptr_ctx, &cie)) { goto exit; }
+
+  String8 data   = str8_prefix(eh_frame, entry_range.max);
+  U64     cursor = entry_range.min;
+
+  // extract address of first instruction
+  U64 pc_begin = 0;
+  U64 pc_begin_size = eh_read_ptr(data, cursor, ptr_ctx, cie.aug.addr_encoding, &pc_begin);
+  if (pc_begin_size == 0) { goto exit; }
+  cursor += pc_begin_size;
+
+  // extract instruction range size, modifiers don't apply to the size
+  U64 pc_range = 0;
+  U64 pc_range_size = eh_read_ptr(data, cursor, ptr_ctx, cie.aug.addr_encoding & EH_PtrEnc_TypeMask, &pc_range);
+  if (pc_range_size == 0) { goto exit; }
+  cursor += pc_range_size;
+
+  // extract LSDA pointer from augmentation data
+  U64 lsda_ip = 0;
+  if (str8_match(str8_prefix(cie.aug_string, 1), str8_lit("z"), 0)) {
+    U64 aug_data_size = 0;
+    U64 aug_data_size_size = str8_deserial_read_uleb128(data, cursor, &aug_data_size);
+    if (aug_data_size_size == 0) { goto exit; }
+    cursor += aug_data_size_size;
+
+    if (cie.aug.flags & EH_AugFlag_HasLSDA) {
+      eh_read_ptr(data, cursor, ptr_ctx, cie.aug.lsda_encoding, &lsda_ip);
+    }
+
+    cursor += aug_data_size;
+    if (cursor > data.size) { goto exit; }
+  }
+
+  if (cie_out) {
+    *cie_out = cie;
+  }
+  fde_out->cie_off  = cie_off;
+  fde_out->pc_range = rng_1u64(pc_begin, pc_begin + pc_range);
+  fde_out->lsda_ip  = lsda_ip;
+  fde_out->insts    = str8_substr(data, rng_1u64(cursor, data.size));
+
+  is_parsed = 1;
+exit:;
+  return is_parsed;
+}
+
+internal U64
+eh_size_from_frame(String8 eh_frame)
+{
+  // section size is not known when .eh_frame is located through .eh_frame_hdr,
+  // walk entries up to zero terminator
   U64 cursor = 0;
-  
+  for (;;) {
+    U64 entry_size = eh_parse_entry_header(eh_frame, cursor, 0, 0);
+    if (entry_size == 0) { break; }
+    cursor += entry_size;
+  }
+  return cursor;
+}
+
+////////////////////////////////
+//~ .eh_frame_hdr / FDE Lookup
+
+internal B32
+eh_parse_frame_hdr(String8 data, EH_PtrCtx *ptr_ctx, EH_FrameHdr *hdr_out)
+{
+  B32 is_parsed = 0;
+  U64 cursor    = 0;
+
   U8 version = 0;
-  cursor += str8_deserial_read_struct(raw_eh_frame_hdr, cursor, &version);
-  
-  if (version == 1) {
-#if 0
-    EH_PtrCtx ptr_ctx = {0};
-    // Set this to base address of .eh_frame_hdr. Entries are relative
-    // to this section for some reason.
-    ptr_ctx.data_vaddr = range.min;
-    // If input location is VMA then set this to address of .text. 
-    // Pointer parsing function will adjust "init_location" to correct VMA.
-    ptr_ctx.text_vaddr = 0; 
-#endif
-    
-    EH_PtrEnc eh_frame_ptr_enc = 0, fde_count_enc = 0, table_enc = 0;
-    cursor += str8_deserial_read_struct(raw_eh_frame_hdr, cursor, &eh_frame_ptr_enc);
-    cursor += str8_deserial_read_struct(raw_eh_frame_hdr, cursor, &fde_count_enc);
-    cursor += str8_deserial_read_struct(raw_eh_frame_hdr, cursor, &table_enc);
-    
-    U64 eh_frame_ptr = 0, fde_count = 0;
-    NotImplemented;
-    //cursor += dw_unwind_parse_pointer_x64(raw_eh_frame_hdr.str, rng_1u64(0, raw_eh_frame_hdr.size), ptr_ctx, eh_frame_ptr_enc, cursor, &eh_frame_ptr);
-    //cursor += dw_unwind_parse_pointer_x64(raw_eh_frame_hdr.str, rng_1u64(0, raw_eh_frame_hdr.size), ptr_ctx, fde_count_enc, cursor, &fde_count);
-    
-    for (U64 fde_idx = 0; fde_idx < fde_count; ++fde_idx) {
-      U64 init_location = 0, address = 0;
-      NotImplemented;
-      //cursor += dw_unwind_parse_pointer_x64(raw_eh_frame_hdr.str, rng_1u64(0, raw_eh_frame_hdr.size), ptr_ctx, table_enc, cursor, &init_location);
-      //cursor += dw_unwind_parse_pointer_x64(raw_eh_frame_hdr.str, rng_1u64(0, raw_eh_frame_hdr.size), ptr_ctx, table_enc, cursor, &address);
-      
-      S64 current_delta = (S64)(location - init_location);
-      S64 closest_delta = (S64)(location - closest_location);
-      if (0 <= current_delta && current_delta < closest_delta) {
-        closest_location = init_location;
-        closest_address  = address;
-      }
+  cursor += str8_deserial_read_struct(data, cursor, &version);
+  if (version != 1) { goto exit; }
+
+  EH_PtrEnc eh_frame_ptr_enc = 0, fde_count_enc = 0, table_enc = 0;
+  cursor += str8_deserial_read_struct(data, cursor, &eh_frame_ptr_enc);
+  cursor += str8_deserial_read_struct(data, cursor, &fde_count_enc);
+  cursor += str8_deserial_read_struct(data, cursor, &table_enc);
+  if (cursor != 4) { goto exit; }
+
+  U64 eh_frame_ptr = 0;
+  U64 eh_frame_ptr_size = eh_read_ptr(data, cursor, ptr_ctx, eh_frame_ptr_enc, &eh_frame_ptr);
+  if (eh_frame_ptr_size == 0) { goto exit; }
+  cursor += eh_frame_ptr_size;
+
+  U64 fde_count = 0;
+  cursor += eh_read_ptr(data, cursor, ptr_ctx, fde_count_enc, &fde_count);
+
+  // binary search needs fixed size table entries
+  U64 table_entry_size = 0;
+  if (fde_count_enc != EH_PtrEnc_Omit && table_enc != EH_PtrEnc_Omit && (table_enc & EH_PtrEnc_Indirect) == 0) {
+    switch (table_enc & EH_PtrEnc_TypeMask) {
+    case EH_PtrEnc_UData2: case EH_PtrEnc_SData2: { table_entry_size = 2; } break;
+    case EH_PtrEnc_UData4: case EH_PtrEnc_SData4: { table_entry_size = 4; } break;
+    case EH_PtrEnc_Ptr:
+    case EH_PtrEnc_UData8: case EH_PtrEnc_SData8: { table_entry_size = 8; } break;
     }
   }
-  
-  // address where to find corresponding FDE, this is an absolute offset
-  // into the image file.
-  return closest_address;
+  if (cursor + fde_count * table_entry_size * 2 > data.size) {
+    table_entry_size = 0;
+  }
+
+  hdr_out->data             = data;
+  hdr_out->version          = version;
+  hdr_out->eh_frame_ptr_enc = eh_frame_ptr_enc;
+  hdr_out->fde_count_enc    = fde_count_enc;
+  hdr_out->table_enc        = table_enc;
+  hdr_out->eh_frame_ptr     = eh_frame_ptr;
+  hdr_out->fde_count        = table_entry_size ? fde_count : 0;
+  hdr_out->table_off        = cursor;
+  hdr_out->table_entry_size = table_entry_size;
+
+  is_parsed = 1;
+exit:;
+  return is_parsed;
 }
 
-#if 0
-internal DW_CFIRecords
-dw_unwind_eh_frame_hdr_from_ip_fast_x64(String8 raw_eh_frame, String8 raw_eh_frame_hdr, EH_PtrCtx *ptr_ctx, U64 ip_voff)
+internal U64
+eh_fde_vaddr_from_frame_hdr(EH_FrameHdr *hdr, EH_PtrCtx *ptr_ctx, U64 vaddr)
 {
-  DW_CFIRecords result = {0};
-  
-  // find FDE offset
-  void *eh_frame_hdr = raw_eh_frame.str;
-  U64   fde_offset   = dw_search_eh_frame_hdr_linear_x64(raw_eh_frame_hdr, ptr_ctx, ip_voff);
-  
-  B32 is_fde_offset_valid = (fde_offset != max_U64);
-  if (is_fde_offset_valid) {
-    U64 fde_read_offset = (fde_offset - ptr_ctx->raw_base_vaddr);
-    
-    // read FDE size
-    U64 fde_size = 0;
-    fde_read_offset += str8_deserial_read_dwarf_packed_size(raw_eh_frame, fde_read_offset, &fde_size);
-    
-    // read FDE discriminator
-    U32 fde_discrim = 0;
-    fde_read_offset += str8_deserial_read_struct(raw_eh_frame, fde_read_offset, &fde_discrim);
-    
-    // compute parent CIE offset
-    U64 cie_read_offset = fde_read_offset - (fde_discrim + sizeof(fde_discrim));
-    
-    // read CIE size
-    U64 cie_size = 0;
-    cie_read_offset += str8_deserial_read_dwarf_packed_size(raw_eh_frame, cie_read_offset, &cie_size);
-    
-    // read CIE discriminator
-    U32 cie_discrim = max_U32;
-    cie_read_offset += str8_deserial_read_struct(raw_eh_frame, cie_read_offset, &cie_discrim);
-    
-    B32 is_fde = (fde_discrim != 0);
-    B32 is_cie = (cie_discrim == 0);
-    if (is_fde && is_cie) {
-      Rng1U64 cie_range = rng_1u64(0, cie_read_offset + (cie_size - sizeof(cie_discrim)));
-      Rng1U64 fde_range = rng_1u64(0, fde_read_offset + (fde_size - sizeof(fde_discrim)));
-      
-      // parse CIE
-      DW_CIE cie = {0};
-      dw_unwind_parse_cie_x64(raw_eh_frame.str, cie_range, ptr_ctx, cie_read_offset, &cie);
-      
-      // parse FDE
-      DW_FDE fde = {0};
-      NotImplemented;
-      //dw_unwind_parse_fde_x64(raw_eh_frame.str, fde_range, ptr_ctx, &cie, fde_read_offset, &fde);
-      
-      // range check instruction pointer
-      if (contains_1u64(fde.pc_range, ip_voff)) {
-        result.valid = 1;
-        result.cie   = cie;
-        result.fde   = fde;
+  // Table contains only addresses for first instruction in a function and we cannot
+  // guarantee that result is FDE that corresponds to the input location.
+  // So input location must be cheked against range from FDE header again.
+  U64 fde_vaddr = max_U64;
+
+  if (hdr->table_entry_size != 0 && hdr->fde_count != 0) {
+    U64 row_size = hdr->table_entry_size * 2;
+
+    // binary search: find max index s.t. table[index].init_location <= vaddr
+    U64 min = 0;
+    U64 opl = hdr->fde_count;
+    while (min < opl) {
+      U64 mid           = min + (opl - min) / 2;
+      U64 init_location = 0;
+      eh_read_ptr(hdr->data, hdr->table_off + mid * row_size, ptr_ctx, hdr->table_enc, &init_location);
+      if (init_location <= vaddr) {
+        min = mid + 1;
+      } else {
+        opl = mid;
       }
     }
+
+    if (min > 0) {
+      eh_read_ptr(hdr->data, hdr->table_off + (min - 1) * row_size + hdr->table_entry_size, ptr_ctx, hdr->table_enc, &fde_vaddr);
+    }
   }
-  
-  return result;
+
+  return fde_vaddr;
+}
+
+internal int
+eh_fde_index_entry_is_before(void *a, void *b)
+{
+  EH_FDEIndexEntry *l = a, *r = b;
+  return l->pc_min < r->pc_min ? -1 : l->pc_min > r->pc_min ? +1 : 0;
+}
+
+internal EH_FDEIndex
+eh_fde_index_from_frame(Arena *arena, String8 eh_frame, EH_PtrCtx *ptr_ctx)
+{
+  // count FDEs
+  U64 fde_count = 0;
+  for (U64 cursor = 0, entry_size; (entry_size = eh_parse_entry_header(eh_frame, cursor, 0, 0)) != 0; cursor += entry_size) {
+    fde_count += 1;
+  }
+
+  // map FDE ranges, CIEs are picked up from FDEs
+  EH_FDEIndex index = {0};
+  index.v = push_array_no_zero(arena, EH_FDEIndexEntry, fde_count);
+  for (U64 cursor = 0, entry_size; (entry_size = eh_parse_entry_header(eh_frame, cursor, 0, 0)) != 0; cursor += entry_size) {
+    EH_FDE fde = {0};
+    if (eh_parse_fde(eh_frame, cursor, ptr_ctx, 0, &fde) && fde.pc_range.min < fde.pc_range.max) {
+      EH_FDEIndexEntry *entry = &index.v[index.count++];
+      entry->pc_min  = fde.pc_range.min;
+      entry->pc_max  = fde.pc_range.max;
+      entry->fde_off = cursor;
+    }
+  }
+  arena_pop(arena, (fde_count - index.count) * sizeof(index.v[0]));
+
+  quick_sort(index.v, index.count, sizeof(index.v[0]), eh_fde_index_entry_is_before);
+
+  return index;
+}
+
+internal U64
+eh_fde_off_from_index(EH_FDEIndex *index, U64 vaddr)
+{
+  U64 fde_off = max_U64;
+
+  // binary search: find max index s.t. v[index].pc_min <= vaddr
+  U64 min = 0;
+  U64 opl = index->count;
+  while (min < opl) {
+    U64 mid = min + (opl - min) / 2;
+    if (index->v[mid].pc_min <= vaddr) {
+      min = mid + 1;
+    } else {
+      opl = mid;
+    }
+  }
+
+  if (min > 0) {
+    EH_FDEIndexEntry *entry = &index->v[min - 1];
+    if (entry->pc_min <= vaddr && vaddr < entry->pc_max) {
+      fde_off = entry->fde_off;
+    }
+  }
+
+  return fde_off;
 }
-#endif
 
 internal String8
 eh_string_from_ptr_enc_type(EH_PtrEnc type)
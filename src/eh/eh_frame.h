@@ -53,6 +53,7 @@ enum
   EH_AugFlag_HasLSDA    = (1 << 0),
   EH_AugFlag_HasHandler = (1 << 1),
   EH_AugFlag_HasAddrEnc = (1 << 2),
+  EH_AugFlag_IsSignal   = (1 << 3),
 };
 
 typedef struct EH_Augmentation
@@ -64,12 +65,76 @@ typedef struct EH_Augmentation
   EH_PtrEnc   addr_encoding;
 } EH_Augmentation;
 
+typedef struct EH_CIE
+{
+  U8              version;
+  String8         aug_string;
+  U64             code_align_factor;
+  S64             data_align_factor;
+  U64             ret_addr_reg;
+  EH_Augmentation aug;
+  String8         insts;
+} EH_CIE;
+
+typedef struct EH_FDE
+{
+  U64     cie_off;
+  Rng1U64 pc_range;
+  U64     lsda_ip;
+  String8 insts;
+} EH_FDE;
+
+typedef struct EH_FrameHdr
+{
+  String8   data;
+  U8        version;
+  EH_PtrEnc eh_frame_ptr_enc;
+  EH_PtrEnc fde_count_enc;
+  EH_PtrEnc table_enc;
+  U64       eh_frame_ptr;
+  U64       fde_count;
+  U64       table_off;
+  U64       table_entry_size; // zero when table entries can't be indexed directly
+} EH_FrameHdr;
+
+// sorted (pc range -> FDE offset) map, used when .eh_frame_hdr is missing or has no searchable table
+typedef struct EH_FDEIndexEntry
+{
+  U64 pc_min;
+  U64 pc_max;
+  U64 fde_off;
+} EH_FDEIndexEntry;
+
+typedef struct EH_FDEIndex
+{
+  U64               count;
+  EH_FDEIndexEntry *v;
+} EH_FDEIndex;
+
 ////////////////////////////////
 
 internal U64 eh_read_ptr(String8 frame_base, U64 off, EH_PtrCtx *ptr_ctx, EH_PtrEnc encoding, U64 *ptr_out);
 internal U64 eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_Augmentation *aug_out);
 internal U64 eh_size_from_aug_data(String8 aug_string, String8 data, EH_PtrCtx *ptr_ctx);
 
+////////////////////////////////
+//~ .eh_frame Entries
+
+internal U64 eh_parse_entry_header(String8 eh_frame, U64 off, U32 *id_out, Rng1U64 *entry_range_out);
+internal B32 eh_parse_cie(String8 eh_frame, U64 off, EH_PtrCtx *ptr_ctx, EH_CIE *cie_out);
+internal B32 eh_parse_fde(String8 eh_frame, U64 off, EH_PtrCtx *ptr_ctx, EH_CIE *cie_out, EH_FDE *fde_out);
+internal U64 eh_size_from_frame(String8 eh_frame);
+
+////////////////////////////////
+//~ .eh_frame_hdr / FDE Lookup
+
+internal B32 eh_parse_frame_hdr(String8 data, EH_PtrCtx *ptr_ctx, EH_FrameHdr *hdr_out);
+internal U64 eh_fde_vaddr_from_frame_hdr(EH_FrameHdr *hdr, EH_PtrCtx *ptr_ctx, U64 vaddr);
+
+internal int         eh_fde_index_entry_is_before(void *a, void *b);
+internal EH_FDEIndex eh_fde_index_from_frame(Arena *arena, String8 eh_frame, EH_PtrCtx *ptr_ctx);
+internal U64         eh_fde_off_from_index(EH_FDEIndex *index, U64 vaddr);
+
 ////////////////////////////////
 //~ Enum -> String
 
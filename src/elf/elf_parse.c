@@ -164,3 +164,37 @@ elf_gnu_debug_link_from_bin(String8 raw_data, ELF_Bin *bin)
   }
   return result;
 }
+
+internal String8
+elf_gnu_build_id_from_bin(String8 raw_data, ELF_Bin *bin)
+{
+  String8 result = {0};
+  for EachIndex(idx, bin->shdrs.count)
+  {
+    ELF_Shdr64 *shdr = &bin->shdrs.v[idx];
+    if(shdr->sh_type != ELF_SectionCode_Note)
+    {
+      continue;
+    }
+    Rng1U64 raw_data_range = rng_1u64(shdr->sh_offset, shdr->sh_offset + shdr->sh_size);
+    String8 data = str8_substr(raw_data, raw_data_range);
+    for(U64 cursor = 0; cursor + sizeof(ELF_Note) <= data.size && result.size == 0;)
+    {
+      ELF_Note note = {0};
+      cursor += str8_deserial_read_struct(data, cursor, &note);
+      String8 name = str8_substr(data, r1u64(cursor, cursor + note.name_size));
+      cursor = AlignPow2(cursor + note.name_size, 4);
+      String8 desc = str8_substr(data, r1u64(cursor, cursor + note.desc_size));
+      cursor = AlignPow2(cursor + note.desc_size, 4);
+      if(note.type == ELF_NoteType_GNU_BuildId && str8_match(str8_prefix(name, 3), str8_lit("GNU"), 0))
+      {
+        result = desc;
+      }
+    }
+    if(result.size != 0)
+    {
+      break;
+    }
+  }
+  return result;
+}
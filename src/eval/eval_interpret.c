@@ -20,7 +20,8 @@ e_select_interpret_ctx(E_InterpretCtx *ctx, RDI_Parsed *primary_rdi, U64 ip_voff
       RDI_LocationBlock *block = rdi_element_from_name_idx(primary_rdi, LocationBlocks, loc_block_idx);
       if (block->scope_off_first <= ip_voff && ip_voff < block->scope_off_opl) {
         U64  all_location_data_size = 0;
-        U8  *all_location_data      = rdi_table_from_name(primary_rdi, LocationData, &all_location_data_size);
+        U64  location_size          = rdi_location_size_from_off(primary_rdi, block->location_data_off);
+        U8  *all_location_data      = rdi_table_range_from_name(primary_rdi, LocationData, block->location_data_off, block->location_data_off + location_size, &all_location_data_size);
         if(block->location_data_off + sizeof(RDI_LocationKind) <= all_location_data_size)
         {
           RDI_LocationKind loc_kind = *(RDI_LocationKind *)(all_location_data + block->location_data_off);
@@ -2001,7 +2001,7 @@ e_push_irtree_and_type_from_expr(Arena *arena, E_IRTreeAndType *root_parent, E_I
                       if(constant_value_size <= 8)
                       {
                         RDI_U64 constant_value_data_size = 0;
-                        RDI_U8 *constant_value_data = rdi_table_from_name(rdi, ConstantValueData, &constant_value_data_size);
+                        RDI_U8 *constant_value_data = rdi_table_range_from_name(rdi, ConstantValueData, constant_value_off, constant_value_off + constant_value_size, &constant_value_data_size);
                         if(0 <= constant_value_off && constant_value_off + constant_value_size <= constant_value_data_size)
                         {
                           RDI_U64 value = 0;
@@ -2127,7 +2127,8 @@ e_push_irtree_and_type_from_expr(Arena *arena, E_IRTreeAndType *root_parent, E_I
             RDI_Parsed *rdi = dbg_info->rdi;
             RDI_LocationBlock *block = mapped_location_block;
             U64 all_location_data_size = 0;
-            U8 *all_location_data = rdi_table_from_name(rdi, LocationData, &all_location_data_size);
+            U64 location_size = rdi_location_size_from_off(rdi, block->location_data_off);
+            U8 *all_location_data = rdi_table_range_from_name(rdi, LocationData, block->location_data_off, block->location_data_off + location_size, &all_location_data_size);
             if(block->location_data_off + sizeof(RDI_LocationKind) <= all_location_data_size)
             {
               RDI_LocationKind loc_kind = *((RDI_LocationKind *)(all_location_data + block->location_data_off));
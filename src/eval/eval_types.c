@@ -2707,6 +2707,7 @@ e_list_gather_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U
         idx += n->count;
       }
     }
+    ac_report_artifact_size(arena_pos(arena));
   }
   
   //- rjf: package
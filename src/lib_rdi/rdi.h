@@ -67,7 +67,7 @@ union RDI_GUID {RDI_U8 u8[16]; RDI_U64 u64[2];};
 
 // "raddbg\0\0"
 #define RDI_MAGIC_CONSTANT   0x0000676264646172
-#define RDI_ENCODING_VERSION 17
+#define RDI_ENCODING_VERSION 18
 
 ////////////////////////////////////////////////////////////////
 //~ Format Types & Functions
@@ -126,6 +126,7 @@ typedef enum RDI_SectionEncodingEnum
 {
 RDI_SectionEncoding_Unpacked   = 0,
 RDI_SectionEncoding_LZB        = 1,
+RDI_SectionEncoding_LZBBlocks  = 2,
 } RDI_SectionEncodingEnum;
 
 typedef RDI_U32 RDI_Arch;
@@ -620,6 +621,7 @@ X(NameMapNodes, name_map_nodes, RDI_NameMapNode)\
 #define RDI_SectionEncoding_XList \
 X(Unpacked)\
 X(LZB)\
+X(LZBBlocks)\
 
 #define RDI_Section_XList \
 X(RDI_SectionEncoding, encoding)\
@@ -628,6 +630,10 @@ X(RDI_U64, off)\
 X(RDI_U64, encoded_size)\
 X(RDI_U64, unpacked_size)\
 
+#define RDI_SectionBlockHeader_XList \
+X(RDI_U32, block_size)\
+X(RDI_U32, block_count)\
+
 #define RDI_VMapEntry_XList \
 X(RDI_U64, voff)\
 X(RDI_U64, idx)\
@@ -1273,6 +1279,13 @@ RDI_U64 encoded_size;
 RDI_U64 unpacked_size;
 };
 
+typedef struct RDI_SectionBlockHeader RDI_SectionBlockHeader;
+struct RDI_SectionBlockHeader
+{
+RDI_U32 block_size;
+RDI_U32 block_count;
+};
+
 typedef struct RDI_VMapEntry RDI_VMapEntry;
 struct RDI_VMapEntry
 {
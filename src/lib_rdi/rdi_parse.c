@@ -212,6 +212,8 @@ rdi_parse(RDI_U8 *data, RDI_U64 size, RDI_Parsed *out)
     out->raw_data_size = size;
     out->sections = dsecs;
     out->sections_count = dsec_count;
+    out->section_unpack_hook = 0;
+    out->section_unpack_hook_user_data = 0;
   }
   
   return result;
@@ -236,6 +238,16 @@ rdi_section_raw_data_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_Sectio
     result = rdi->raw_data+rdi->sections[kind].off;
     *size_out = rdi->sections[kind].encoded_size;
     *encoding_out = rdi->sections[kind].encoding;
+    if(rdi->sections[kind].encoding != RDI_SectionEncoding_Unpacked && rdi->section_unpack_hook != 0)
+    {
+      void *unpacked = rdi->section_unpack_hook(rdi->section_unpack_hook_user_data, rdi, kind, 0, rdi->sections[kind].unpacked_size);
+      if(unpacked != 0)
+      {
+        result = unpacked;
+        *size_out = rdi->sections[kind].unpacked_size;
+        *encoding_out = RDI_SectionEncoding_Unpacked;
+      }
+    }
   }
   return result;
 }
@@ -257,20 +269,159 @@ rdi_section_raw_table_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 *
   return result;
 }
 
+RDI_PROC void *
+rdi_section_raw_table_range_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 first, RDI_U64 opl, RDI_U64 *count_out)
+{
+  void *result = 0;
+  
+  //- packed sections: returns the base & count of the whole table, but only
+  // elements [first, opl) are unpacked
+  if(0 <= kind && kind < rdi->sections_count &&
+     rdi->sections[kind].encoding != RDI_SectionEncoding_Unpacked &&
+     rdi->section_unpack_hook != 0)
+  {
+    RDI_U64 element_size = (RDI_U64)rdi_section_element_size_table[kind];
+    RDI_U64 count = rdi->sections[kind].unpacked_size/element_size;
+    RDI_U64 clamped_opl = rdi_parse__min(opl, count);
+    RDI_U64 clamped_first = rdi_parse__min(first, clamped_opl);
+    void *unpacked = rdi->section_unpack_hook(rdi->section_unpack_hook_user_data, rdi, kind, element_size*clamped_first, element_size*clamped_opl);
+    if(unpacked != 0)
+    {
+      result = unpacked;
+      *count_out = count;
+    }
+  }
+  
+  //- unpacked sections: whole table
+  else
+  {
+    result = rdi_section_raw_table_from_kind(rdi, kind, count_out);
+  }
+  
+  return result;
+}
+
 RDI_PROC void *
 rdi_section_raw_element_from_kind_idx(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 idx)
 {
-  RDI_U64 count = 0;
-  void *table = rdi_section_raw_table_from_kind(rdi, kind, &count);
-  void *result = table;
-  if(idx < count)
+  void *result = 0;
+  
+  //- packed sections: only unpack the element's part of the section
+  if(0 <= kind && kind < rdi->sections_count &&
+     rdi->sections[kind].encoding != RDI_SectionEncoding_Unpacked &&
+     rdi->section_unpack_hook != 0)
   {
     RDI_U64 element_size = (RDI_U64)rdi_section_element_size_table[kind];
-    result = (RDI_U8 *)table + element_size*idx;
+    RDI_U64 count = rdi->sections[kind].unpacked_size/element_size;
+    RDI_U64 clamped_idx = (idx < count) ? idx : 0;
+    RDI_U64 min = element_size*clamped_idx;
+    RDI_U8 *unpacked = (RDI_U8 *)rdi->section_unpack_hook(rdi->section_unpack_hook_user_data, rdi, kind, min, min+element_size);
+    if(unpacked != 0 && count != 0)
+    {
+      result = unpacked + min;
+    }
+#if !defined(RDI_DISABLE_NILS)
+    if(result == 0)
+    {
+      result = &rdi_nil_element_union;
+    }
+#endif
   }
+  
+  //- unpacked sections: index into table
+  else
+  {
+    RDI_U64 count = 0;
+    void *table = rdi_section_raw_table_from_kind(rdi, kind, &count);
+    result = table;
+    if(idx < count)
+    {
+      RDI_U64 element_size = (RDI_U64)rdi_section_element_size_table[kind];
+      result = (RDI_U8 *)table + element_size*idx;
+    }
+  }
+  
   return result;
 }
 
+RDI_PROC RDI_U64
+rdi_section_element_count_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind)
+{
+  RDI_U64 count = 0;
+  rdi_section_raw_table_range_from_kind(rdi, kind, 0, 0, &count);
+  return count;
+}
+
+//- packed section blocks
+
+RDI_PROC RDI_U64
+rdi_section_block_size_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 *block_count_out)
+{
+  RDI_U64 block_size = 0;
+  RDI_U64 block_count = 0;
+  if(0 <= kind && kind < rdi->sections_count)
+  {
+    RDI_Section *section = &rdi->sections[kind];
+    switch(section->encoding)
+    {
+      default:{}break;
+      case RDI_SectionEncoding_LZB:
+      {
+        block_size = section->unpacked_size;
+        block_count = (section->unpacked_size != 0);
+      }break;
+      case RDI_SectionEncoding_LZBBlocks:
+      {
+        if(sizeof(RDI_SectionBlockHeader) <= section->encoded_size &&
+           section->off + section->encoded_size <= rdi->raw_data_size)
+        {
+          RDI_SectionBlockHeader *hdr = (RDI_SectionBlockHeader *)(rdi->raw_data + section->off);
+          if(sizeof(*hdr) + sizeof(RDI_U64)*((RDI_U64)hdr->block_count+1) <= section->encoded_size)
+          {
+            block_size = hdr->block_size;
+            block_count = hdr->block_count;
+          }
+        }
+      }break;
+    }
+  }
+  *block_count_out = block_count;
+  return block_size;
+}
+
+RDI_PROC RDI_U64
+rdi_section_unpack_block(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 block_idx, RDI_U8 *unpacked_section_base)
+{
+  RDI_U64 unpacked_size = 0;
+  RDI_U64 block_count = 0;
+  RDI_U64 block_size = rdi_section_block_size_from_kind(rdi, kind, &block_count);
+  if(block_idx < block_count)
+  {
+    RDI_Section *section = &rdi->sections[kind];
+    RDI_U64 src_off = 0;
+    RDI_U64 src_opl = section->encoded_size;
+    if(section->encoding == RDI_SectionEncoding_LZBBlocks)
+    {
+      RDI_U64 *block_offs = (RDI_U64 *)(rdi->raw_data + section->off + sizeof(RDI_SectionBlockHeader));
+      src_off = block_offs[block_idx];
+      src_opl = block_offs[block_idx+1];
+    }
+    RDI_U64 dst_off = block_size*block_idx;
+    RDI_U64 dst_opl = dst_off + block_size;
+    if(dst_opl > section->unpacked_size)
+    {
+      dst_opl = section->unpacked_size;
+    }
+    if(src_off <= src_opl && src_opl <= section->encoded_size && dst_off < dst_opl)
+    {
+      rr_lzb_simple_decode(rdi->raw_data + section->off + src_off, (SINTa)(src_opl - src_off),
+                           unpacked_section_base + dst_off, (SINTa)(dst_opl - dst_off));
+      unpacked_size = dst_opl - dst_off;
+    }
+  }
+  return unpacked_size;
+}
+
 //- info about whole parse
 
 RDI_PROC RDI_U64
@@ -326,8 +477,20 @@ rdi_decompress_parsed(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *
         src < src_opl && dst < dst_opl;
         src += 1, dst += 1)
     {
-      rr_lzb_simple_decode((U8*)og_rdi->raw_data + src->off, src->encoded_size,
-                           decompressed_data     + dst->off, dst->unpacked_size);
+      RDI_SectionKind kind = (RDI_SectionKind)(src - src_first);
+      if(src->encoding == RDI_SectionEncoding_Unpacked)
+      {
+        MemoryCopy(decompressed_data + dst->off, (U8*)og_rdi->raw_data + src->off, Min(src->encoded_size, dst->unpacked_size));
+      }
+      else
+      {
+        U64 block_count = 0;
+        rdi_section_block_size_from_kind(og_rdi, kind, &block_count);
+        for(U64 block_idx = 0; block_idx < block_count; block_idx += 1)
+        {
+          rdi_section_unpack_block(og_rdi, kind, block_idx, decompressed_data + dst->off);
+        }
+      }
     }
   }
 }
@@ -341,13 +504,13 @@ rdi_string_from_idx(RDI_Parsed *rdi, RDI_U32 idx, RDI_U64 *len_out)
   RDI_U64 result_size = 0;
   {
     RDI_U64 string_offs_count = 0;
-    RDI_U32 *string_offs = rdi_table_from_name(rdi, StringTable, &string_offs_count);
+    RDI_U32 *string_offs = rdi_table_range_from_name(rdi, StringTable, idx, (RDI_U64)idx+2, &string_offs_count);
     if(idx < string_offs_count)
     {
-      RDI_U64 string_data_size = 0;
-      RDI_U8 *string_data = rdi_table_from_name(rdi, StringData, &string_data_size);
       RDI_U32 off_raw = string_offs[idx];
       RDI_U32 opl_raw = string_offs[idx + 1];
+      RDI_U64 string_data_size = 0;
+      RDI_U8 *string_data = rdi_table_range_from_name(rdi, StringData, off_raw, opl_raw, &string_data_size);
       RDI_U32 opl = rdi_parse__min(opl_raw, string_data_size);
       RDI_U32 off = rdi_parse__min(off_raw, opl);
       result_base = string_data + off;
@@ -363,9 +526,9 @@ rdi_string_from_idx(RDI_Parsed *rdi, RDI_U32 idx, RDI_U64 *len_out)
 RDI_PROC RDI_U32*
 rdi_idx_run_from_first_count(RDI_Parsed *rdi, RDI_U32 raw_first, RDI_U32 raw_count, RDI_U32 *n_out)
 {
-  RDI_U64 idx_run_count = 0;
-  RDI_U32 *idx_run_data = rdi_table_from_name(rdi, IndexRuns, &idx_run_count);
   RDI_U32 raw_opl = raw_first + raw_count;
+  RDI_U64 idx_run_count = 0;
+  RDI_U32 *idx_run_data = rdi_table_range_from_name(rdi, IndexRuns, raw_first, raw_opl, &idx_run_count);
   RDI_U32 opl = rdi_parse__min(raw_opl, idx_run_count);
   RDI_U32 first = rdi_parse__min(raw_first, opl);
   RDI_U32 *result = 0;
@@ -382,15 +545,18 @@ rdi_idx_run_from_first_count(RDI_Parsed *rdi, RDI_U32 raw_first, RDI_U32 raw_cou
 RDI_PROC void
 rdi_parsed_from_line_table(RDI_Parsed *rdi, RDI_LineTable *line_table, RDI_ParsedLineTable *out)
 {
-  //- rjf: extract top-level line info tables
+  //- rjf: extract top-level line info tables, unpacking only this line table's part
+  RDI_U64 lt_voffs_opl_idx = (RDI_U64)line_table->voffs_base_idx + line_table->lines_count + 1;
+  RDI_U64 lt_lines_opl_idx = (RDI_U64)line_table->lines_base_idx + line_table->lines_count;
+  RDI_U64 lt_cols_opl_idx  = (RDI_U64)line_table->cols_base_idx + line_table->cols_count;
   RDI_U64 all_voffs_count = 0;
-  RDI_U64 *all_voffs = rdi_table_from_name(rdi, LineInfoVOffs, &all_voffs_count);
+  RDI_U64 *all_voffs = rdi_table_range_from_name(rdi, LineInfoVOffs, line_table->voffs_base_idx, lt_voffs_opl_idx, &all_voffs_count);
   RDI_U64 *all_voffs_opl = all_voffs + all_voffs_count;
   RDI_U64 all_lines_count = 0;
-  RDI_Line *all_lines = rdi_table_from_name(rdi, LineInfoLines, &all_lines_count);
+  RDI_Line *all_lines = rdi_table_range_from_name(rdi, LineInfoLines, line_table->lines_base_idx, lt_lines_opl_idx, &all_lines_count);
   RDI_Line *all_lines_opl = all_lines + all_lines_count;
   RDI_U64 all_cols_count = 0;
-  RDI_Column *all_cols = rdi_table_from_name(rdi, LineInfoColumns, &all_cols_count);
+  RDI_Column *all_cols = rdi_table_range_from_name(rdi, LineInfoColumns, line_table->cols_base_idx, lt_cols_opl_idx, &all_cols_count);
   RDI_Column *all_cols_opl = all_cols + all_cols_count;
   
   //- rjf: extract ranges of top-level tables belonging to this line table
@@ -497,15 +663,18 @@ rdi_line_info_idx_from_voff(RDI_ParsedLineTable *line_info, RDI_U64 voff)
 RDI_PROC void
 rdi_parsed_from_source_line_map(RDI_Parsed *rdi, RDI_SourceLineMap *map, RDI_ParsedSourceLineMap *out)
 {
-  //- rjf: extract top-level line info tables
+  //- rjf: extract top-level line info tables, unpacking only this line map's part
+  RDI_U64 map_nums_opl_idx  = (RDI_U64)map->line_map_nums_base_idx + map->line_count;
+  RDI_U64 map_rngs_opl_idx  = (RDI_U64)map->line_map_range_base_idx + map->line_count + 1;
+  RDI_U64 map_voffs_opl_idx = (RDI_U64)map->line_map_voff_base_idx + map->voff_count;
   RDI_U64 all_nums_count = 0;
-  RDI_U32 *all_nums = rdi_table_from_name(rdi, SourceLineMapNumbers, &all_nums_count);
+  RDI_U32 *all_nums = rdi_table_range_from_name(rdi, SourceLineMapNumbers, map->line_map_nums_base_idx, map_nums_opl_idx, &all_nums_count);
   RDI_U32 *all_nums_opl = all_nums + all_nums_count;
   RDI_U64 all_rngs_count = 0;
-  RDI_U32 *all_rngs = rdi_table_from_name(rdi, SourceLineMapRanges, &all_rngs_count);
+  RDI_U32 *all_rngs = rdi_table_range_from_name(rdi, SourceLineMapRanges, map->line_map_range_base_idx, map_rngs_opl_idx, &all_rngs_count);
   RDI_U32 *all_rngs_opl = all_rngs + all_rngs_count;
   RDI_U64 all_voffs_count = 0;
-  RDI_U64 *all_voffs = rdi_table_from_name(rdi, SourceLineMapVOffs, &all_voffs_count);
+  RDI_U64 *all_voffs = rdi_table_range_from_name(rdi, SourceLineMapVOffs, map->line_map_voff_base_idx, map_voffs_opl_idx, &all_voffs_count);
   RDI_U64 *all_voffs_opl = all_voffs + all_voffs_count;
   
   //- rjf: extract ranges of top-level tables belonging to this line map
@@ -625,9 +794,46 @@ rdi_vmap_idx_from_voff(RDI_VMapEntry *vmap, RDI_U64 vmap_count, RDI_U64 voff)
 RDI_PROC RDI_U64
 rdi_vmap_idx_from_section_kind_voff(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 voff)
 {
-  RDI_U64 vmaps_count = 0;
-  RDI_VMapEntry *vmaps = rdi_section_raw_table_from_kind(rdi, kind, &vmaps_count);
-  RDI_U64 result = rdi_vmap_idx_from_voff(vmaps, vmaps_count, voff);
+  RDI_U64 result = 0;
+  
+  //- packed vmaps: search element by element, so that only the blocks
+  // touched by the search are unpacked
+  if(0 <= kind && kind < rdi->sections_count &&
+     rdi->sections[kind].encoding != RDI_SectionEncoding_Unpacked &&
+     rdi->section_unpack_hook != 0)
+  {
+    RDI_U64 vmap_count = rdi_section_element_count_from_kind(rdi, kind);
+    if(vmap_count > 0 &&
+       ((RDI_VMapEntry *)rdi_section_raw_element_from_kind_idx(rdi, kind, 0))->voff <= voff &&
+       voff < ((RDI_VMapEntry *)rdi_section_raw_element_from_kind_idx(rdi, kind, vmap_count - 1))->voff)
+    {
+      RDI_U64 first = 0;
+      RDI_U64 opl   = vmap_count;
+      for(;opl - first > 1;)
+      {
+        RDI_U64 mid = (first + opl)/2;
+        RDI_VMapEntry *mid_entry = (RDI_VMapEntry *)rdi_section_raw_element_from_kind_idx(rdi, kind, mid);
+        if(mid_entry->voff <= voff)
+        {
+          first = mid;
+        }
+        else
+        {
+          opl = mid;
+        }
+      }
+      result = ((RDI_VMapEntry *)rdi_section_raw_element_from_kind_idx(rdi, kind, first))->idx;
+    }
+  }
+  
+  //- unpacked vmaps: search table
+  else
+  {
+    RDI_U64 vmaps_count = 0;
+    RDI_VMapEntry *vmaps = rdi_section_raw_table_from_kind(rdi, kind, &vmaps_count);
+    result = rdi_vmap_idx_from_voff(vmaps, vmaps_count, voff);
+  }
+  
   return result;
 }
 
@@ -640,20 +846,23 @@ rdi_parsed_from_name_map(RDI_Parsed *rdi, RDI_NameMap *mapptr, RDI_ParsedNameMap
   out->bucket_count = 0;
   if(mapptr != 0)
   {
+    // NOTE: nothing is unpacked here - lookups unpack the bucket & nodes they touch
     RDI_U64 all_buckets_count = 0;
-    RDI_NameMapBucket *all_buckets = rdi_table_from_name(rdi, NameMapBuckets, &all_buckets_count);
+    RDI_NameMapBucket *all_buckets = rdi_table_range_from_name(rdi, NameMapBuckets, 0, 0, &all_buckets_count);
     RDI_U64 all_nodes_count = 0;
-    RDI_NameMapNode *all_nodes = rdi_table_from_name(rdi, NameMapNodes, &all_nodes_count);
+    RDI_NameMapNode *all_nodes = rdi_table_range_from_name(rdi, NameMapNodes, 0, 0, &all_nodes_count);
     out->buckets = all_buckets+mapptr->bucket_base_idx;
     out->nodes = all_nodes+mapptr->node_base_idx;
     out->bucket_count = mapptr->bucket_count;
     out->node_count = mapptr->node_count;
-    if(mapptr->bucket_base_idx > all_buckets_count)
+    out->bucket_base_idx = mapptr->bucket_base_idx;
+    out->node_base_idx = mapptr->node_base_idx;
+    if(out->bucket_base_idx + out->bucket_count > all_buckets_count)
     {
       out->buckets = 0;
       out->bucket_count = 0;
     }
-    if(mapptr->node_base_idx > all_nodes_count)
+    if(out->node_base_idx + out->node_count > all_nodes_count)
     {
       out->nodes = 0;
       out->node_count = 0;
@@ -671,7 +880,11 @@ rdi_name_map_lookup(RDI_Parsed *p, RDI_ParsedNameMap *map, RDI_U8 *str, RDI_U64
     RDI_U64 bucket_count = map->bucket_count;
     RDI_U64 hash = rdi_hash(str, len);
     RDI_U64 bucket_index = hash%bucket_count;
+    RDI_U64 all_buckets_count = 0;
+    rdi_table_range_from_name(p, NameMapBuckets, map->bucket_base_idx + bucket_index, map->bucket_base_idx + bucket_index + 1, &all_buckets_count);
     RDI_NameMapBucket *bucket = map->buckets + bucket_index;
+    RDI_U64 all_nodes_count = 0;
+    rdi_table_range_from_name(p, NameMapNodes, map->node_base_idx + bucket->first_node, map->node_base_idx + bucket->first_node + bucket->node_count, &all_nodes_count);
     RDI_NameMapNode *node = map->nodes + bucket->first_node;
     RDI_NameMapNode *node_opl = node + bucket->node_count;
     for(;node < node_opl; node += 1)
@@ -1043,6 +1256,48 @@ rdi_size_from_bytecode_stream(RDI_U8 *ptr, RDI_U8 *opl)
   return bytecode_size;
 }
 
+RDI_PROC RDI_U64
+rdi_location_size_from_off(RDI_Parsed *rdi, RDI_U64 off)
+{
+  // NOTE: unpacks only the location at `off` - its kind, & its fixed-size
+  // payload or its bytecode stream up to & including the terminating op
+  RDI_U64 size = 0;
+  RDI_U64 data_size = 0;
+  RDI_U8 *data = rdi_table_range_from_name(rdi, LocationData, off, off + sizeof(RDI_LocationKind), &data_size);
+  if(data != 0 && off + sizeof(RDI_LocationKind) <= data_size)
+  {
+    RDI_LocationKind kind = *(RDI_LocationKind *)(data + off);
+    switch(kind)
+    {
+      default:{size = sizeof(RDI_LocationKind);}break;
+      case RDI_LocationKind_AddrRegPlusU16:
+      case RDI_LocationKind_AddrAddrRegPlusU16:{size = sizeof(RDI_LocationRegPlusU16);}break;
+      case RDI_LocationKind_ValReg:{size = sizeof(RDI_LocationReg);}break;
+      case RDI_LocationKind_AddrBytecodeStream:
+      case RDI_LocationKind_ValBytecodeStream:
+      {
+        size = sizeof(RDI_LocationKind);
+        for(;off + size < data_size;)
+        {
+          rdi_table_range_from_name(rdi, LocationData, off + size, off + size + 1, &data_size);
+          RDI_U8 op = data[off + size];
+          size += 1;
+          if(op == 0)
+          {
+            break;
+          }
+          RDI_U16 ctrlbits = rdi_eval_op_ctrlbits_table[op];
+          RDI_U32 p_size   = RDI_DECODEN_FROM_CTRLBITS(ctrlbits);
+          rdi_table_range_from_name(rdi, LocationData, off + size, off + size + p_size, &data_size);
+          size += p_size;
+        }
+      }break;
+    }
+    rdi_table_range_from_name(rdi, LocationData, off, off + size, &data_size);
+  }
+  return size;
+}
+
 ////////////////////////////////
 //~ Compression/Decompression Implementation
 
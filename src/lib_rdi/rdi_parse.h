@@ -54,12 +54,23 @@ typedef enum RDI_ParseStatus
 RDI_ParseStatus;
 
 typedef struct RDI_Parsed RDI_Parsed;
+
+// NOTE: Resolving Packed Sections
+//
+// * sections not stored as RDI_SectionEncoding_Unpacked are only accessible
+// * through the raw section accessors if the user installs this hook
+// * the hook must return the base of the section's unpacked data, of which at
+// * least bytes [ min, opl ) have been unpacked - or 0, if unavailable
+typedef void *RDI_SectionUnpackHook(void *user_data, RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 min, RDI_U64 opl);
+
 struct RDI_Parsed
 {
   RDI_U8 *raw_data;
   RDI_U64 raw_data_size;
   RDI_Section *sections;
   RDI_U64 sections_count;
+  RDI_SectionUnpackHook *section_unpack_hook;
+  void *section_unpack_hook_user_data;
 };
 
 typedef struct RDI_ParsedLineTable RDI_ParsedLineTable;
@@ -101,6 +112,8 @@ struct RDI_ParsedNameMap
   RDI_NameMapNode *nodes;
   RDI_U64 bucket_count;
   RDI_U64 node_count;
+  RDI_U64 bucket_base_idx;
+  RDI_U64 node_base_idx;
 };
 
 ////////////////////////////////
@@ -144,10 +157,17 @@ RDI_PROC RDI_ParseStatus rdi_parse(RDI_U8 *data, RDI_U64 size, RDI_Parsed *out);
 //- section table/element raw data extraction
 RDI_PROC void *rdi_section_raw_data_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_SectionEncoding *encoding_out, RDI_U64 *size_out);
 RDI_PROC void *rdi_section_raw_table_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 *count_out);
+RDI_PROC void *rdi_section_raw_table_range_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 first, RDI_U64 opl, RDI_U64 *count_out);
 RDI_PROC void *rdi_section_raw_element_from_kind_idx(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 idx);
+RDI_PROC RDI_U64 rdi_section_element_count_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind);
 #define rdi_table_from_name(rdi, name, count_out) ((RDI_SectionElementType_##name *)rdi_section_raw_table_from_kind((rdi), RDI_SectionKind_##name, (count_out)))
+#define rdi_table_range_from_name(rdi, name, first, opl, count_out) ((RDI_SectionElementType_##name *)rdi_section_raw_table_range_from_kind((rdi), RDI_SectionKind_##name, (first), (opl), (count_out)))
 #define rdi_element_from_name_idx(rdi, name, idx) ((RDI_SectionElementType_##name *)rdi_section_raw_element_from_kind_idx((rdi), RDI_SectionKind_##name, (idx)))
 
+//- packed section blocks
+RDI_PROC RDI_U64 rdi_section_block_size_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 *block_count_out);
+RDI_PROC RDI_U64 rdi_section_unpack_block(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U64 block_idx, RDI_U8 *unpacked_section_base);
+
 //- info about whole parse
 RDI_PROC RDI_U64 rdi_decompressed_size_from_parsed(RDI_Parsed *rdi);
 
@@ -231,5 +251,6 @@ RDI_PROC RDI_U8 *rdi_name_from_file_path_node(RDI_Parsed *rdi, RDI_FilePathNode
 #define rdi_parse__min(a,b) (((a)<(b))?(a):(b))
 RDI_PROC RDI_U64 rdi_cstring_length(char *cstr);
 RDI_PROC RDI_U64 rdi_size_from_bytecode_stream(RDI_U8 *ptr, RDI_U8 *opl);
+RDI_PROC RDI_U64 rdi_location_size_from_off(RDI_Parsed *rdi, RDI_U64 off);
 
 #endif // RDI_FORMAT_PARSE_H
@@ -218,6 +218,26 @@ lnk_config_from_argcv(Arena *arena, int argc, char **argv)
   // init config
   LNK_Config *config = lnk_config_from_cmd_line(raw_cmd_line, cmd_line);
 
+  // hash everything that steers the link but is not an input file, incremental
+  // links compare it against the state recorded by the previous link
+  if (config->incremental == LNK_SwitchState_Yes) {
+    XXH3_state_t state;
+    XXH3_INITSTATE(&state);
+    XXH3_128bits_reset(&state);
+    for (String8Node *n = unwrapped_cmd_line.first; n != 0; n = n->next) {
+      XXH3_128bits_update(&state, n->string.str, n->string.size);
+      XXH3_128bits_update(&state, &n->string.size, sizeof(n->string.size));
+    }
+    for (String8Node *n = config->lib_dir_list.first; n != 0; n = n->next) {
+      XXH3_128bits_update(&state, n->string.str, n->string.size);
+      XXH3_128bits_update(&state, &n->string.size, sizeof(n->string.size));
+    }
+    XXH3_128bits_update(&state, config->work_dir.str, config->work_dir.size);
+    XXH128_hash_t hash = XXH3_128bits_digest(&state);
+    config->incremental_cmd_line_hash.u64[0] = hash.low64;
+    config->incremental_cmd_line_hash.u64[1] = hash.high64;
+  }
+
 #if PROFILE_TELEMETRY
   {
     String8 cmdl = str8_list_join(scratch.arena, &config->raw_cmd_line, &(StringJoin){ .sep = str8_lit_comp(" ") });
@@ -301,6 +321,431 @@ lnk_blake3_hash_parallel(TP_Context *tp, U64 chunk_count, String8 data)
   return result;
 }
 
+internal U128
+lnk_incremental_hash_from_data(String8 data)
+{
+  XXH128_hash_t hash = XXH3_128bits(data.str, data.size);
+  U128 result = { .u64 = { hash.low64, hash.high64 } };
+  return result;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_incremental_hasher_task)
+{
+  LNK_IncrementalHasher *task = raw_task;
+  task->hashes[task_id] = lnk_incremental_hash_from_data(task->data_arr.v[task_id]);
+}
+
+internal U128 *
+lnk_incremental_hash_parallel(TP_Context *tp, Arena *arena, String8Array data_arr)
+{
+  ProfBeginFunction();
+  LNK_IncrementalHasher task = {0};
+  task.data_arr              = data_arr;
+  task.hashes                = push_array(arena, U128, data_arr.count);
+  tp_for_parallel(tp, 0, data_arr.count, lnk_incremental_hasher_task, &task);
+  ProfEnd();
+  return task.hashes;
+}
+
+internal void
+lnk_incremental_file_list_push(Arena *arena, LNK_IncrementalFileList *list, String8 path, FileProperties props, U128 hash, LNK_IncrementalFileFlags flags)
+{
+  LNK_IncrementalFile *file = push_array(arena, LNK_IncrementalFile, 1);
+  file->path     = push_str8_copy(arena, path);
+  file->size     = props.size;
+  file->modified = props.modified;
+  file->hash     = hash;
+  file->flags    = flags;
+
+  SLLQueuePush(list->first, list->last, file);
+  list->count += 1;
+}
+
+internal LNK_IncrementalFile *
+lnk_incremental_input_file_from_path(LNK_IncrementalFileList list, String8 path)
+{
+  for (LNK_IncrementalFile *file = list.first; file != 0; file = file->next) {
+    if (file->flags == 0 && str8_match(file->path, path, 0)) {
+      return file;
+    }
+  }
+  return 0;
+}
+
+internal U128
+lnk_incremental_hash_from_lib_search(LNK_Config *config, LNK_IncrementalFileList files, String8 lib_name)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  // a library is resolved through LIBPATH and LIB, so record where the name
+  // landed and what that file holds, missing libraries hash to an empty path.
+  // a resolved library is a link input, so its content hash is normally in the
+  // list already, and that entry is checked on its own - the file is only read
+  // here when it isn't
+  String8 first_match  = lnk_find_first_file(scratch.arena, config->lib_dir_list, lib_name);
+  U128    content_hash = {0};
+  if (first_match.size) {
+    LNK_IncrementalFile *file = lnk_incremental_input_file_from_path(files, first_match);
+    if (file) {
+      content_hash = file->hash;
+    } else {
+      content_hash = lnk_incremental_hash_from_data(lnk_read_data_from_file_path(scratch.arena, 0, first_match));
+    }
+  }
+
+  String8List srl = {0};
+  str8_list_push(scratch.arena, &srl, first_match);
+  str8_list_push(scratch.arena, &srl, str8_struct(&content_hash));
+  String8 data = str8_list_join(scratch.arena, &srl, 0);
+  U128    hash = lnk_incremental_hash_from_data(data);
+
+  scratch_end(scratch);
+  return hash;
+}
+
+internal LNK_IncrementalFileList
+lnk_incremental_file_list_from_state(Arena *arena, String8 state_data, U128 *cmd_line_hash_out, String8 *layout_data_out)
+{
+  LNK_IncrementalFileList list = {0};
+
+  LNK_IncrementalStateHeader *header = str8_deserial_get_raw_ptr(state_data, 0, sizeof(*header));
+  if (header == 0)                                       { goto exit; }
+  if (header->magic != LNK_INCREMENTAL_STATE_MAGIC)      { goto exit; }
+  if (header->version != LNK_INCREMENTAL_STATE_VERSION)  { goto exit; }
+
+  U64                        files_off    = sizeof(*header);
+  U64                        files_size   = (U64)header->file_count * sizeof(LNK_IncrementalFileHeader);
+  LNK_IncrementalFileHeader *files        = str8_deserial_get_raw_ptr(state_data, files_off, files_size);
+  String8                    string_table = str8_substr(state_data, rng_1u64(files_off + files_size, files_off + files_size + header->string_table_size));
+  if (header->file_count > 0 && files == 0)              { goto exit; }
+  if (string_table.size != header->string_table_size)    { goto exit; }
+
+  // layout is 8-byte aligned after the string table
+  U64     layout_off  = AlignPow2(files_off + files_size + header->string_table_size, 8);
+  String8 layout_data = str8_substr(state_data, rng_1u64(layout_off, layout_off + header->layout_size));
+  if (layout_data.size != header->layout_size)           { goto exit; }
+
+  for EachIndex(file_idx, header->file_count) {
+    LNK_IncrementalFileHeader *file_header = &files[file_idx];
+    Rng1U64                    path_range  = rng_1u64(file_header->path_off, (U64)file_header->path_off + file_header->path_size);
+    if (path_range.max > string_table.size) {
+      MemoryZeroStruct(&list);
+      goto exit;
+    }
+
+    LNK_IncrementalFile *file = push_array(arena, LNK_IncrementalFile, 1);
+    file->path     = str8_substr(string_table, path_range);
+    file->size     = file_header->size;
+    file->modified = file_header->modified;
+    file->hash     = file_header->hash;
+    file->flags    = file_header->flags;
+    SLLQueuePush(list.first, list.last, file);
+    list.count += 1;
+  }
+
+  *cmd_line_hash_out = header->cmd_line_hash;
+  *layout_data_out   = layout_data;
+
+  exit:;
+  return list;
+}
+
+internal String8List
+lnk_incremental_state_from_file_list(Arena *arena, U128 cmd_line_hash, LNK_IncrementalFileList list, String8List layout)
+{
+  String8List state = {0};
+
+  LNK_IncrementalStateHeader *header = push_array(arena, LNK_IncrementalStateHeader, 1);
+  LNK_IncrementalFileHeader  *files  = push_array(arena, LNK_IncrementalFileHeader, list.count);
+  str8_list_push(arena, &state, str8_struct(header));
+  str8_list_push(arena, &state, str8_array(files, list.count));
+
+  U64 string_table_size = 0;
+  U64 file_idx          = 0;
+  for (LNK_IncrementalFile *file = list.first; file != 0; file = file->next, file_idx += 1) {
+    files[file_idx].size      = file->size;
+    files[file_idx].modified  = file->modified;
+    files[file_idx].hash      = file->hash;
+    files[file_idx].flags     = file->flags;
+    files[file_idx].path_off  = safe_cast_u32(string_table_size);
+    files[file_idx].path_size = safe_cast_u32(file->path.size);
+    str8_list_push(arena, &state, file->path);
+    string_table_size += file->path.size;
+  }
+
+  U64 layout_size = layout.total_size;
+  U64 align_size  = AlignPadPow2(state.total_size, 8);
+  str8_list_push(arena, &state, str8(push_array(arena, U8, align_size), align_size));
+  str8_list_concat_in_place(&state, &layout);
+
+  header->magic             = LNK_INCREMENTAL_STATE_MAGIC;
+  header->version           = LNK_INCREMENTAL_STATE_VERSION;
+  header->file_count        = safe_cast_u32(list.count);
+  header->cmd_line_hash     = cmd_line_hash;
+  header->string_table_size = string_table_size;
+  header->layout_size       = layout_size;
+
+  return state;
+}
+
+internal LNK_IncrementalLayout *
+lnk_incremental_layout_from_data(Arena *arena, String8 layout_data)
+{
+  LNK_IncrementalLayout *layout = 0;
+
+  LNK_IncrementalLayoutHeader *header = str8_deserial_get_raw_ptr(layout_data, 0, sizeof(*header));
+  if (header == 0) { goto exit; }
+
+  U64 sects_off    = sizeof(*header);
+  U64 objs_off     = sects_off    + (U64)header->sect_count    * sizeof(LNK_IncrementalSection);
+  U64 contribs_off = objs_off     + (U64)header->obj_count     * sizeof(LNK_IncrementalObj);
+  U64 symbols_off  = contribs_off + (U64)header->contrib_count * sizeof(LNK_IncrementalContrib);
+  U64 layout_size  = symbols_off  + (U64)header->symbol_count  * sizeof(LNK_IncrementalSymbol);
+  if (layout_size != layout_data.size) { goto exit; }
+
+  LNK_IncrementalSection *sects    = (LNK_IncrementalSection *)(layout_data.str + sects_off);
+  LNK_IncrementalObj     *objs     = (LNK_IncrementalObj     *)(layout_data.str + objs_off);
+  LNK_IncrementalContrib *contribs = (LNK_IncrementalContrib *)(layout_data.str + contribs_off);
+  LNK_IncrementalSymbol  *symbols  = (LNK_IncrementalSymbol  *)(layout_data.str + symbols_off);
+
+  // reject contributions that point outside the layout
+  for EachIndex(obj_idx, header->obj_count) {
+    if ((U64)objs[obj_idx].first_contrib + objs[obj_idx].contrib_count > header->contrib_count) { goto exit; }
+  }
+  for EachIndex(contrib_idx, header->contrib_count) {
+    if (contribs[contrib_idx].sect_idx >= header->sect_count) { goto exit; }
+  }
+
+  layout = push_array(arena, LNK_IncrementalLayout, 1);
+  layout->header   = header;
+  layout->sects    = sects;
+  layout->objs     = objs;
+  layout->contribs = contribs;
+  layout->symbols  = symbols;
+
+  exit:;
+  return layout;
+}
+
+internal B32
+lnk_incremental_is_up_to_date(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_IncrementalLayout **layout_out)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  B32 is_up_to_date  = 0;
+  B32 inputs_changed = 0;
+
+  // load state from the previous link, the layout is handed to the image build
+  String8 state_data = {0};
+  if (os_file_path_exists(config->incremental_name)) {
+    state_data = lnk_read_data_from_file_path(arena, 0, config->incremental_name);
+  }
+  U128                    cmd_line_hash = {0};
+  String8                 layout_data   = {0};
+  LNK_IncrementalFileList files         = lnk_incremental_file_list_from_state(scratch.arena, state_data, &cmd_line_hash, &layout_data);
+  if (files.count == 0) {
+    lnk_log(LNK_Log_Incremental, "Incremental: no valid state in %S, performing full link", config->incremental_name);
+    goto exit;
+  }
+  if (!u128_match(cmd_line_hash, config->incremental_cmd_line_hash)) {
+    lnk_log(LNK_Log_Incremental, "Incremental: command line changed, performing full link");
+    goto exit;
+  }
+
+  // size and time stamp checks are enough for most files, inputs that were
+  // touched without changing size are compared by content hash; changed objs
+  // and libs are patched into the image, anything else needs a full link
+  U64                   rehash_count = 0;
+  LNK_IncrementalFile **rehash_files = push_array(scratch.arena, LNK_IncrementalFile *, files.count);
+  for (LNK_IncrementalFile *file = files.first; file != 0; file = file->next) {
+    if (file->flags & LNK_IncrementalFileFlag_LibSearch) {
+      U128 hash = lnk_incremental_hash_from_lib_search(config, files, file->path);
+      if (!u128_match(hash, file->hash)) {
+        lnk_log(LNK_Log_Incremental, "Incremental: library `%S` resolves to a different file, performing full link", file->path);
+        goto exit;
+      }
+      continue;
+    }
+
+    FileProperties props = os_properties_from_file_path(file->path);
+    if (props.modified == 0 || props.size != file->size) {
+      if (file->flags & (LNK_IncrementalFileFlag_Output|LNK_IncrementalFileFlag_Extra)) {
+        lnk_log(LNK_Log_Incremental, "Incremental: %S changed, performing full link", file->path);
+        goto exit;
+      }
+      lnk_log(LNK_Log_Incremental, "Incremental: %S changed", file->path);
+      inputs_changed = 1;
+      continue;
+    }
+    if (props.modified != file->modified) {
+      if (file->flags & LNK_IncrementalFileFlag_Output) {
+        lnk_log(LNK_Log_Incremental, "Incremental: %S was modified after the last link, performing full link", file->path);
+        goto exit;
+      }
+      rehash_files[rehash_count++] = file;
+    }
+  }
+
+  if (rehash_count > 0) {
+    String8Array rehash_paths = {0};
+    rehash_paths.count = rehash_count;
+    rehash_paths.v     = push_array(scratch.arena, String8, rehash_count);
+    for EachIndex(i, rehash_count) {
+      rehash_paths.v[i] = rehash_files[i]->path;
+    }
+
+    String8Array rehash_datas = lnk_read_data_from_file_path_parallel(tp, scratch.arena, config->io_flags, rehash_paths);
+    U128        *hashes       = lnk_incremental_hash_parallel(tp, scratch.arena, rehash_datas);
+    for EachIndex(i, rehash_count) {
+      if (!u128_match(hashes[i], rehash_files[i]->hash)) {
+        if (rehash_files[i]->flags & LNK_IncrementalFileFlag_Extra) {
+          lnk_log(LNK_Log_Incremental, "Incremental: %S changed, performing full link", rehash_files[i]->path);
+          goto exit;
+        }
+        lnk_log(LNK_Log_Incremental, "Incremental: %S changed", rehash_files[i]->path);
+        inputs_changed = 1;
+      }
+    }
+  }
+
+  if (inputs_changed) {
+    *layout_out = lnk_incremental_layout_from_data(arena, layout_data);
+    if (*layout_out == 0) {
+      lnk_log(LNK_Log_Incremental, "Incremental: no image layout in %S, performing full link", config->incremental_name);
+    }
+  } else {
+    is_up_to_date = 1;
+    lnk_log(LNK_Log_Incremental, "Incremental: %S is up to date", config->image_name);
+  }
+
+  exit:;
+  scratch_end(scratch);
+  ProfEnd();
+  return is_up_to_date;
+}
+
+internal String8Array
+lnk_incremental_extra_input_paths(Arena *arena, LNK_Config *config)
+{
+  // inputs that bypass the inputer
+  String8List extra_path_lists[] = { config->input_list[LNK_Input_Res], config->input_list[LNK_Input_Manifest], config->natvis_list };
+  String8List extra_paths        = {0};
+  for EachElement(list_idx, extra_path_lists) {
+    for (String8Node *n = extra_path_lists[list_idx].first; n != 0; n = n->next) {
+      str8_list_push(arena, &extra_paths, n->string);
+    }
+  }
+
+  String8 extra_path_names[] = { config->order_name, config->order_profile_name };
+  for EachElement(name_idx, extra_path_names) {
+    if (extra_path_names[name_idx].size) {
+      str8_list_push(arena, &extra_paths, extra_path_names[name_idx]);
+    }
+  }
+
+  return str8_array_from_list(arena, &extra_paths);
+}
+
+internal FileProperties *
+lnk_incremental_props_from_paths(Arena *arena, String8Array paths)
+{
+  FileProperties *props = push_array(arena, FileProperties, paths.count);
+  for EachIndex(i, paths.count) {
+    props[i] = os_properties_from_file_path(paths.v[i]);
+  }
+  return props;
+}
+
+internal void
+lnk_incremental_write_state(TP_Context *tp, LNK_Config *config, LNK_Inputer *inputer, String8Array extra_paths, FileProperties *extra_props, String8List layout)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  LNK_IncrementalFileList files = {0};
+
+  // objs and libs were stamped and hashed by the inputer as they were read from
+  // disk, the link patches input data in place so it can't be hashed here
+  {
+    LNK_InputList input_lists[] = { inputer->objs, inputer->libs };
+    for EachElement(list_idx, input_lists) {
+      for (LNK_Input *input = input_lists[list_idx].first; input != 0; input = input->next) {
+        if (input->is_thin && !input->has_disk_read_failed) {
+          lnk_incremental_file_list_push(scratch.arena, &files, input->path, input->disk_props, input->disk_hash, 0);
+        }
+      }
+    }
+  }
+
+  // inputs that bypass the inputer are read all over the link, so they were
+  // stamped before it started; if one changed since, the hash taken here may not
+  // match what the link read, so drop the state and force a full link next time
+  {
+    for EachIndex(i, extra_paths.count) {
+      FileProperties props = os_properties_from_file_path(extra_paths.v[i]);
+      if (props.size != extra_props[i].size || props.modified != extra_props[i].modified) {
+        lnk_log(LNK_Log_Incremental, "Incremental: %S changed during the link, next link is a full link", extra_paths.v[i]);
+        os_delete_file_at_path(config->incremental_name);
+        goto exit;
+      }
+    }
+
+    String8Array extra_data_arr = lnk_read_data_from_file_path_parallel(tp, scratch.arena, 0, extra_paths);
+    U128        *hashes         = lnk_incremental_hash_parallel(tp, scratch.arena, extra_data_arr);
+    for EachIndex(i, extra_paths.count) {
+      lnk_incremental_file_list_push(scratch.arena, &files, extra_paths.v[i], extra_props[i], hashes[i], LNK_IncrementalFileFlag_Extra);
+    }
+  }
+
+  // library names are searched again on the next link; resolved libraries
+  // were pushed with the inputs above, so the search reuses their hashes
+  for (String8Node *n = inputer->lib_searches.first; n != 0; n = n->next) {
+    LNK_IncrementalFile *file = push_array(scratch.arena, LNK_IncrementalFile, 1);
+    file->path  = n->string;
+    file->hash  = lnk_incremental_hash_from_lib_search(config, files, n->string);
+    file->flags = LNK_IncrementalFileFlag_LibSearch;
+    SLLQueuePush(files.first, files.last, file);
+    files.count += 1;
+  }
+
+  // outputs are checked by size and time stamp only
+  {
+    String8List outputs = {0};
+    str8_list_push(scratch.arena, &outputs, config->image_name);
+    if (config->rad_chunk_map == LNK_SwitchState_Yes) {
+      str8_list_push(scratch.arena, &outputs, config->rad_chunk_map_name);
+    }
+    if (config->map == LNK_SwitchState_Yes) {
+      str8_list_push(scratch.arena, &outputs, config->map_name);
+    }
+    if (config->build_imp_lib && (config->file_characteristics & PE_ImageFileCharacteristic_FILE_DLL)) {
+      str8_list_push(scratch.arena, &outputs, config->imp_lib_name);
+    }
+    if (lnk_do_debug_info(config)) {
+      if (config->rad_debug == LNK_SwitchState_Yes) {
+        str8_list_push(scratch.arena, &outputs, config->rad_debug_name);
+      }
+      if (config->debug_mode == LNK_DebugMode_Full) {
+        str8_list_push(scratch.arena, &outputs, config->pdb_name);
+      }
+    }
+
+    U128 zero = {0};
+    for (String8Node *n = outputs.first; n != 0; n = n->next) {
+      lnk_incremental_file_list_push(scratch.arena, &files, n->string, os_properties_from_file_path(n->string), zero, LNK_IncrementalFileFlag_Output);
+    }
+  }
+
+  String8List state = lnk_incremental_state_from_file_list(scratch.arena, config->incremental_cmd_line_hash, files, layout);
+  lnk_write_data_list_to_file_path(config->incremental_name, str8_zero(), state);
+
+  exit:;
+  scratch_end(scratch);
+  ProfEnd();
+}
+
 internal String8
 lnk_make_linker_manifest(Arena      *arena,
                          B32         manifest_uac,
@@ -1088,6 +1533,7 @@ lnk_inputer_push_lib_thin(LNK_Inputer *inputer, LNK_Config *config, LNK_InputSou
   if (first_match.size == 0) {
     KeyValuePair *was_reported = hash_table_search_path(inputer->missing_lib_ht, path);
     if (was_reported == 0) {
+      str8_list_push(inputer->arena, &inputer->lib_searches, push_str8_copy(inputer->arena, path));
       hash_table_push_path_u64(inputer->arena, inputer->missing_lib_ht, path, 0);
       lnk_error(LNK_Warning_FileNotFound, "unable to find library `%S`", path);
     }
@@ -1101,6 +1547,7 @@ lnk_inputer_push_lib_thin(LNK_Inputer *inputer, LNK_Config *config, LNK_InputSou
   }
 
   lnk_log(LNK_Log_InputLib, "Input Lib: %S", first_match);
+  str8_list_push(inputer->arena, &inputer->lib_searches, push_str8_copy(inputer->arena, path));
   input = lnk_inputer_push_thin(inputer->arena, &inputer->new_libs[input_source], inputer->libs_ht, first_match);
 
   // store input path to early-out of file searches for default libs
@@ -1129,6 +1576,22 @@ lnk_inputer_has_items(LNK_Inputer *inputer)
   return 0;
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_stamp_input_task)
+{
+  // stamp before the read, so the /INCREMENTAL check never pairs a time stamp
+  // with contents older than it
+  LNK_Input **inputs = raw_task;
+  inputs[task_id]->disk_props = os_properties_from_file_path(inputs[task_id]->path);
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_hash_input_task)
+{
+  LNK_Input **inputs = raw_task;
+  inputs[task_id]->disk_hash = lnk_incremental_hash_from_data(inputs[task_id]->data);
+}
+
 internal LNK_InputPtrArray
 lnk_inputer_flush(Arena *arena, TP_Context *tp, LNK_Inputer *inputer, LNK_IO_Flags io_flags, LNK_InputList *all_inputs, LNK_InputList *new_inputs)
 {
@@ -1158,6 +1621,12 @@ lnk_inputer_flush(Arena *arena, TP_Context *tp, LNK_Inputer *inputer, LNK_IO_Fla
   }
   ProfEnd();
 
+  if (inputer->stamp_inputs) {
+    ProfBegin("Stamp Inputs");
+    tp_for_parallel(tp, 0, thin_inputs_count, lnk_stamp_input_task, thin_inputs);
+    ProfEnd();
+  }
+
   ProfBegin("Load Inputs From Disk"); 
   String8Array thin_input_datas  = lnk_read_data_from_file_path_parallel(tp, inputer->arena, io_flags, thin_input_paths);
   for EachIndex(thin_input_idx, thin_inputs_count) {
@@ -1166,6 +1635,12 @@ lnk_inputer_flush(Arena *arena, TP_Context *tp, LNK_Inputer *inputer, LNK_IO_Fla
   }
   ProfEnd();
 
+  if (inputer->hash_inputs) {
+    ProfBegin("Hash Inputs");
+    tp_for_parallel(tp, 0, thin_inputs_count, lnk_hash_input_task, thin_inputs);
+    ProfEnd();
+  }
+
   ProfBegin("Disk Read Check");
   for EachIndex(i, thin_inputs_count) {
     if (thin_inputs[i]->has_disk_read_failed) {
@@ -1222,8 +1697,8 @@ lnk_load_objs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *
   ProfBeginV("Load Objs [Count %llu]", inputer->new_objs.count);
   Temp scratch = scratch_begin(arena->v, arena->count);
 
-  // load obj inputer from disk
-  LNK_InputPtrArray new_input_objs = lnk_inputer_flush(arena->v[0], tp, inputer, config->io_flags, &inputer->objs, &inputer->new_objs);
+  // load obj inputer from disk, objs are parsed front to back
+  LNK_InputPtrArray new_input_objs = lnk_inputer_flush(arena->v[0], tp, inputer, config->io_flags|LNK_IO_Flags_SequentialAccess, &inputer->objs, &inputer->new_objs);
 
   if (lnk_get_log_status(LNK_Log_InputObj) && new_input_objs.count) {
     U64 input_size = 0;
@@ -1271,7 +1746,8 @@ lnk_load_libs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *
   for EachIndex(input_source, LNK_InputSource_Count) {
     ProfBegin("Input Libs [Count %llu]", inputer->new_libs[input_source].count);
 
-    LNK_InputPtrArray new_input_libs = lnk_inputer_flush(arena->v[0], tp, inputer, config->io_flags, &inputer->libs, &inputer->new_libs[input_source]);
+    // only members that resolve symbols are pulled out of libs
+    LNK_InputPtrArray new_input_libs = lnk_inputer_flush(arena->v[0], tp, inputer, config->io_flags|LNK_IO_Flags_RandomAccess, &inputer->libs, &inputer->new_libs[input_source]);
 
     if (lnk_get_log_status(LNK_Log_InputLib) && new_input_libs.count) {
       U64 input_size = 0;
@@ -2136,6 +2612,13 @@ lnk_link_image(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer
     lnk_opt_ref(tp, symtab, config, link->objs);
   }
 
+  //
+  // fold identical COMDAT sections
+  //
+  if (config->opt_icf == LNK_SwitchState_Yes) {
+    lnk_opt_icf(tp, symtab, config, link->objs);
+  }
+
   //
   // infer minimal padding size for functions from the target machine
   //
@@ -2519,69 +3002,466 @@ lnk_resolve_symbol(LNK_SymbolTable *symtab, LNK_ObjSymbolRef symbol, LNK_ObjSymb
   return is_resolved;
 }
 
+internal U64
+lnk_icf_hash_u64(U64 seed, U64 v)
+{
+  return u64_hash_from_seed_str8(seed, str8_struct(&v));
+}
+
+internal B32
+lnk_icf_is_section_foldable(LNK_Obj *obj, U32 section_number, U32 *external_counts)
+{
+  COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section_number);
+
+  // fold only read-only code from COMDATs
+  if (~section_header->flags & COFF_SectionFlag_LnkCOMDAT)            { return 0; }
+  if (section_header->flags & COFF_SectionFlag_LnkRemove)             { return 0; }
+  if (section_header->flags & COFF_SectionFlag_LnkInfo)               { return 0; }
+  if (section_header->flags & LNK_SECTION_FLAG_DEBUG)                 { return 0; }
+  if (section_header->flags & COFF_SectionFlag_CntUninitializedData) { return 0; }
+  if (section_header->flags & COFF_SectionFlag_MemWrite)              { return 0; }
+  if (~section_header->flags & COFF_SectionFlag_CntCode)              { return 0; }
+  if (section_header->fsize == 0)                                     { return 0; }
+
+  // symbols of a folded section are redirected to the leader symbol of the
+  // surviving section, so section must have a single external symbol
+  if (external_counts[section_number] != 1) { return 0; }
+
+  // section must be the COMDAT leader, duplicates already point to it
+  LNK_Symbol *symlink = lnk_obj_get_comdat_symlink(obj, section_number);
+  if (symlink == 0) { return 0; }
+  LNK_ObjSymbolRef  symlink_ref    = lnk_ref_from_symbol(symlink);
+  COFF_ParsedSymbol symlink_parsed = lnk_parsed_from_symbol(symlink);
+  if (symlink_ref.obj != obj || symlink_parsed.section_number != section_number) { return 0; }
+
+  return 1;
+}
+
 internal
-THREAD_POOL_TASK_FUNC(lnk_gather_section_definitions_task)
+THREAD_POOL_TASK_FUNC(lnk_icf_mark_sections_task)
 {
+  LNK_OptICFTask *task = raw_task;
+  LNK_Obj        *obj  = task->objs[task_id];
   Temp scratch = scratch_begin(&arena, 1);
 
-  LNK_BuildImageTask *task    = raw_task;
-  U64                 obj_idx = task_id;
+  // count external symbols per section
+  U32 *external_counts = push_array(scratch.arena, U32, obj->header.section_count_no_null+1);
+  COFF_ParsedSymbol symbol;
+  for (U64 symbol_idx = 0; symbol_idx < obj->header.symbol_count; symbol_idx += (1 + symbol.aux_symbol_count)) {
+    symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, symbol_idx);
+    COFF_SymbolValueInterpType interp = coff_interp_from_parsed_symbol(symbol);
+    if (interp == COFF_SymbolValueInterp_Regular && symbol.storage_class == COFF_SymStorageClass_External) {
+      external_counts[symbol.section_number] += 1;
+    }
+  }
 
-  HashTable          *sect_defn_ht  = task->u.gather_sects.defns[worker_id];
-  LNK_Obj            *obj           = task->objs[obj_idx];
-  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(obj->data, obj->header.section_table_range).str;
-  String8             string_table  = str8_substr(obj->data, obj->header.string_table_range);
+  // assign obj local index to every foldable section
+  U32 *section_idx_map = task->section_idx_maps[obj->input_idx];
+  U64  section_count   = 0;
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    U32 section_number = sect_idx+1;
+    if (lnk_icf_is_section_foldable(obj, section_number, external_counts)) {
+      section_idx_map[section_number] = section_count++;
+    } else {
+      section_idx_map[section_number] = LNK_ICF_NULL_SECTION;
+    }
+  }
+  task->section_counts[task_id] = section_count;
 
-  for (U64 sect_idx = 0; sect_idx < obj->header.section_count_no_null; sect_idx += 1) {
-    COFF_SectionHeader *sect_header = &section_table[sect_idx];
+  scratch_end(scratch);
+}
 
-    if (~sect_header->flags & COFF_SectionFlag_LnkRemove && ~sect_header->flags & COFF_SectionFlag_LnkInfo && sect_header->fsize > 0) {
-      Temp temp = temp_begin(scratch.arena);
+internal
+THREAD_POOL_TASK_FUNC(lnk_icf_gather_sections_task)
+{
+  LNK_OptICFTask *task            = raw_task;
+  LNK_Obj        *obj             = task->objs[task_id];
+  U32            *section_idx_map = task->section_idx_maps[obj->input_idx];
+  U64             section_base    = task->section_bases[task_id];
 
-      // was section defined?
-      String8                sect_name            = coff_name_from_section_header(string_table, sect_header);
-      String8                sect_name_with_flags = lnk_make_name_with_flags(temp.arena, sect_name, sect_header->flags & ~COFF_SectionFlags_LnkFlags);
-      LNK_SectionDefinition *sect_defn            = hash_table_search_string_raw(sect_defn_ht, sect_name_with_flags);
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    U32 section_number = sect_idx+1;
+    if (section_idx_map[section_number] != LNK_ICF_NULL_SECTION) {
+      section_idx_map[section_number] += section_base;
+
+      LNK_ICFSection *section = &task->sections[section_idx_map[section_number]];
+      section->obj            = obj;
+      section->section_number = section_number;
+      section->symbol_value   = lnk_parsed_from_symbol(lnk_obj_get_comdat_symlink(obj, section_number)).value;
+    }
+  }
+}
 
-      // push new section definition
-      if (sect_defn == 0) {
-        sect_defn = push_array(arena, LNK_SectionDefinition, 1);
-        sect_defn->name         = sect_name;
-        sect_defn->obj          = obj;
-        sect_defn->obj_sect_idx = sect_idx;
-        sect_defn->flags        = sect_header->flags & ~COFF_SectionFlags_LnkFlags;
+internal LNK_ICFTarget
+lnk_icf_target_from_reloc(LNK_SymbolTable *symtab, U32 **section_idx_maps, LNK_Obj *obj, COFF_Reloc *reloc)
+{
+  LNK_ObjSymbolRef           ref    = { .obj = obj, .symbol_idx = reloc->isymbol };
+  COFF_ParsedSymbol          parsed = lnk_parsed_symbol_from_coff_symbol_idx(ref.obj, ref.symbol_idx);
+  COFF_SymbolValueInterpType interp = coff_interp_from_parsed_symbol(parsed);
+
+  // regular symbols are resolved through the section to keep offsets of static labels
+  if (interp != COFF_SymbolValueInterp_Regular) {
+    if (lnk_resolve_symbol(symtab, ref, &ref)) {
+      parsed = lnk_parsed_symbol_from_coff_symbol_idx(ref.obj, ref.symbol_idx);
+      interp = coff_interp_from_parsed_symbol(parsed);
+    }
+  }
 
-        sect_name_with_flags = push_str8_copy(arena, sect_name_with_flags);
-        hash_table_push_string_raw(arena, sect_defn_ht, sect_name_with_flags, sect_defn);
-      }
+  LNK_ICFTarget target = { .section_idx = LNK_ICF_NULL_SECTION };
+  if (interp == COFF_SymbolValueInterp_Regular) {
+    LNK_Obj *section_obj    = ref.obj;
+    U32      section_number = parsed.section_number;
 
-      // acc contrib count
-      sect_defn->contribs_count += 1;
-      
-      temp_end(temp);
+    // redirect duplicate COMDAT to the leader section
+    LNK_Symbol *symlink = lnk_obj_get_comdat_symlink(section_obj, section_number);
+    if (symlink) {
+      section_obj    = lnk_ref_from_symbol(symlink).obj;
+      section_number = lnk_parsed_from_symbol(symlink).section_number;
+    }
+
+    target.section_idx = section_idx_maps[section_obj->input_idx][section_number];
+    if (target.section_idx == LNK_ICF_NULL_SECTION) {
+      target.hash = lnk_icf_hash_u64(lnk_icf_hash_u64(section_obj->input_idx, section_number), parsed.value);
+    } else {
+      target.offset = parsed.value;
     }
+  } else {
+    target.hash = lnk_icf_hash_u64(lnk_icf_hash_u64(lnk_icf_hash_u64(interp, ref.obj->input_idx), ref.symbol_idx), parsed.value);
   }
 
-  scratch_end(scratch);
+  return target;
 }
 
 internal
-THREAD_POOL_TASK_FUNC(lnk_gather_section_contribs_task)
+THREAD_POOL_TASK_FUNC(lnk_icf_hash_sections_task)
 {
-  Temp scratch = scratch_begin(&arena, 1);
+  LNK_OptICFTask *task = raw_task;
+  for EachInRange(section_idx, task->ranges[task_id]) {
+    LNK_ICFSection     *section        = &task->sections[section_idx];
+    LNK_Obj            *obj            = section->obj;
+    COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section->section_number);
+    COFF_RelocArray     relocs         = lnk_coff_reloc_info_from_section_number(obj, section->section_number);
+    String8             data           = str8_substr(obj->data, rng_1u64(section_header->foff, section_header->foff + section_header->fsize));
+
+    // hash section properties and contents
+    U64 hash = u64_hash_from_str8(data);
+    hash = lnk_icf_hash_u64(hash, section_header->flags & ~COFF_SectionFlags_LnkFlags);
+    hash = lnk_icf_hash_u64(hash, coff_align_size_from_section_flags(section_header->flags));
+    hash = lnk_icf_hash_u64(hash, Compose64Bit(section->symbol_value, obj->hotpatch));
+
+    // hash relocations, targets in foldable sections are hashed by offset
+    // here and by class during the refinement
+    section->targets_count = relocs.count;
+    section->targets       = push_array(arena, LNK_ICFTarget, relocs.count);
+    for EachIndex(reloc_idx, relocs.count) {
+      COFF_Reloc    *reloc  = &relocs.v[reloc_idx];
+      LNK_ICFTarget  target = lnk_icf_target_from_reloc(task->symtab, task->section_idx_maps, obj, reloc);
+      section->targets[reloc_idx] = target;
 
-  LNK_BuildImageTask *task    = raw_task;
-  U64                 obj_idx = task_id;
+      hash = lnk_icf_hash_u64(hash, Compose64Bit(reloc->type, reloc->apply_off));
+      if (target.section_idx == LNK_ICF_NULL_SECTION) {
+        hash = lnk_icf_hash_u64(hash, target.hash);
+      } else {
+        hash = lnk_icf_hash_u64(hash, target.offset);
+      }
+    }
 
-  LNK_Obj            *obj           = task->objs[obj_idx];
-  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(obj->data, obj->header.section_table_range).str;
-  String8             string_table  = str8_substr(obj->data, obj->header.string_table_range);
+    task->keys[section_idx] = (LNK_ICFClassKey){ .hash = hash, .class_idx = 0, .section_idx = section_idx };
+  }
+}
 
-  ProfBeginV("Gather Section Contribs [%S]", obj->path);
-  for (U64 sect_idx = 0; sect_idx < obj->header.section_count_no_null; sect_idx += 1) {
-    LNK_SectionContrib *sc          = task->null_sc;
-    COFF_SectionHeader *sect_header = &section_table[sect_idx];
-    if (~sect_header->flags & COFF_SectionFlag_LnkRemove && ~sect_header->flags & COFF_SectionFlag_LnkInfo && sect_header->fsize > 0) {
+internal
+THREAD_POOL_TASK_FUNC(lnk_icf_refine_classes_task)
+{
+  LNK_OptICFTask *task = raw_task;
+  for EachInRange(section_idx, task->ranges[task_id]) {
+    LNK_ICFSection *section = &task->sections[section_idx];
+
+    // sections stay in the same class only if their relocations point to sections from the same classes
+    U64 hash = task->classes[section_idx];
+    for EachIndex(target_idx, section->targets_count) {
+      LNK_ICFTarget *target = &section->targets[target_idx];
+      if (target->section_idx != LNK_ICF_NULL_SECTION) {
+        hash = lnk_icf_hash_u64(hash, Compose64Bit(task->classes[target->section_idx], target->offset));
+      }
+    }
+
+    task->keys[section_idx] = (LNK_ICFClassKey){ .hash = hash, .class_idx = task->classes[section_idx], .section_idx = section_idx };
+  }
+}
+
+internal int
+lnk_icf_class_key_is_before(void *raw_a, void *raw_b)
+{
+  LNK_ICFClassKey *a = raw_a;
+  LNK_ICFClassKey *b = raw_b;
+  if (a->class_idx != b->class_idx) { return a->class_idx < b->class_idx; }
+  if (a->hash != b->hash)           { return a->hash < b->hash;           }
+  return a->section_idx < b->section_idx;
+}
+
+internal U64
+lnk_icf_classes_from_keys(U64 keys_count, LNK_ICFClassKey *keys, U32 *classes)
+{
+  ProfBeginFunction();
+
+  radsort(keys, keys_count, lnk_icf_class_key_is_before);
+
+  // keys with same class and hash form a new class which is identified by
+  // the lowest section index, this makes the first section in the input order
+  // a survivor and keeps output deterministic
+  U64 class_count = 0;
+  U32 class_idx   = 0;
+  for EachIndex(key_idx, keys_count) {
+    LNK_ICFClassKey *key = &keys[key_idx];
+    if (key_idx == 0 || key->class_idx != keys[key_idx-1].class_idx || key->hash != keys[key_idx-1].hash) {
+      class_idx    = key->section_idx;
+      class_count += 1;
+    }
+    classes[key->section_idx] = class_idx;
+  }
+
+  ProfEnd();
+  return class_count;
+}
+
+internal B32
+lnk_icf_is_section_equal(U32 *classes, LNK_ICFSection *a, LNK_ICFSection *b)
+{
+  COFF_SectionHeader *a_header = lnk_coff_section_header_from_section_number(a->obj, a->section_number);
+  COFF_SectionHeader *b_header = lnk_coff_section_header_from_section_number(b->obj, b->section_number);
+  if (a_header->flags != b_header->flags)   { return 0; }
+  if (a_header->fsize != b_header->fsize)   { return 0; }
+  if (a->symbol_value != b->symbol_value)   { return 0; }
+  if (a->obj->hotpatch != b->obj->hotpatch) { return 0; }
+  if (a->targets_count != b->targets_count) { return 0; }
+
+  String8 a_data = str8_substr(a->obj->data, rng_1u64(a_header->foff, a_header->foff + a_header->fsize));
+  String8 b_data = str8_substr(b->obj->data, rng_1u64(b_header->foff, b_header->foff + b_header->fsize));
+  if (!str8_match(a_data, b_data, 0)) { return 0; }
+
+  COFF_RelocArray a_relocs = lnk_coff_reloc_info_from_section_number(a->obj, a->section_number);
+  COFF_RelocArray b_relocs = lnk_coff_reloc_info_from_section_number(b->obj, b->section_number);
+  for EachIndex(reloc_idx, a_relocs.count) {
+    COFF_Reloc    *a_reloc  = &a_relocs.v[reloc_idx];
+    COFF_Reloc    *b_reloc  = &b_relocs.v[reloc_idx];
+    LNK_ICFTarget *a_target = &a->targets[reloc_idx];
+    LNK_ICFTarget *b_target = &b->targets[reloc_idx];
+    if (a_reloc->type != b_reloc->type)           { return 0; }
+    if (a_reloc->apply_off != b_reloc->apply_off) { return 0; }
+    if (a_target->section_idx == LNK_ICF_NULL_SECTION || b_target->section_idx == LNK_ICF_NULL_SECTION) {
+      if (a_target->section_idx != b_target->section_idx) { return 0; }
+      if (a_target->hash != b_target->hash)               { return 0; }
+    } else {
+      if (classes[a_target->section_idx] != classes[b_target->section_idx]) { return 0; }
+      if (a_target->offset != b_target->offset)                             { return 0; }
+    }
+  }
+
+  return 1;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_icf_fold_sections_task)
+{
+  LNK_OptICFTask *task = raw_task;
+  U64 folded_count = 0;
+  U64 folded_size  = 0;
+  for EachInRange(section_idx, task->ranges[task_id]) {
+    U32 class_idx = task->classes[section_idx];
+    if (class_idx == section_idx) { continue; }
+
+    LNK_ICFSection *section  = &task->sections[section_idx];
+    LNK_ICFSection *survivor = &task->sections[class_idx];
+
+    // hashes may collide, fold only sections that are equal
+    if (!lnk_icf_is_section_equal(task->classes, section, survivor)) { continue; }
+
+    // remove folded section and its associates from the output
+    COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(section->obj, section->section_number);
+    section_header->flags |= COFF_SectionFlag_LnkRemove;
+    for EachNode(section_number_n, U32Node, section->obj->associated_sections[section->section_number]) {
+      COFF_SectionHeader *associated_header = lnk_coff_section_header_from_section_number(section->obj, section_number_n->data);
+      associated_header->flags |= COFF_SectionFlag_LnkRemove;
+    }
+
+    // redirect symbols to the survivor the same way COMDAT duplicates are
+    // redirected to their leader, section contrib and symbol values are
+    // patched from the symlink when the image is built
+    section->obj->symlinks[section->section_number] = survivor->obj->symlinks[survivor->section_number];
+
+    folded_count += 1;
+    folded_size  += section_header->fsize;
+  }
+  ins_atomic_u64_add_eval(&task->folded_count, folded_count);
+  ins_atomic_u64_add_eval(&task->folded_size,  folded_size);
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_icf_redirect_comdat_duplicates_task)
+{
+  LNK_OptICFTask *task = raw_task;
+  LNK_Obj        *obj  = task->objs[task_id];
+
+  // duplicates of a folded COMDAT still point to the folded section, redirect them to the survivor
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    U32         section_number = sect_idx+1;
+    LNK_Symbol *symlink        = lnk_obj_get_comdat_symlink(obj, section_number);
+    if (symlink == 0) { continue; }
+
+    LNK_ObjSymbolRef  symlink_ref    = lnk_ref_from_symbol(symlink);
+    COFF_ParsedSymbol symlink_parsed = lnk_parsed_from_symbol(symlink);
+    if (symlink_ref.obj == obj && symlink_parsed.section_number == section_number) { continue; }
+
+    U32 leader_idx = task->section_idx_maps[symlink_ref.obj->input_idx][symlink_parsed.section_number];
+    if (leader_idx == LNK_ICF_NULL_SECTION) { continue; }
+
+    LNK_ICFSection *leader = &task->sections[leader_idx];
+    obj->symlinks[section_number] = leader->obj->symlinks[leader->section_number];
+  }
+}
+
+internal void
+lnk_opt_icf(TP_Context *tp, LNK_SymbolTable *symtab, LNK_Config *config, LNK_ObjList objs)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  LNK_OptICFTask task = {0};
+  task.symtab         = symtab;
+  task.objs           = lnk_array_from_obj_list(scratch.arena, objs);
+  task.section_counts = push_array(scratch.arena, U64, objs.count);
+  task.section_bases  = push_array(scratch.arena, U64, objs.count);
+
+  //
+  // gather foldable sections
+  //
+  task.section_idx_maps = push_array(scratch.arena, U32 *, objs.count);
+  for EachIndex(obj_idx, objs.count) {
+    LNK_Obj *obj = task.objs[obj_idx];
+    task.section_idx_maps[obj->input_idx] = push_array_no_zero(scratch.arena, U32, obj->header.section_count_no_null+1);
+  }
+  tp_for_parallel_prof(tp, 0, objs.count, lnk_icf_mark_sections_task, &task, "Mark Foldable Sections");
+
+  U64 sections_count = 0;
+  for EachIndex(obj_idx, objs.count) {
+    task.section_bases[obj_idx] = sections_count;
+    sections_count += task.section_counts[obj_idx];
+  }
+  AssertAlways(sections_count < LNK_ICF_NULL_SECTION);
+
+  task.sections = push_array(scratch.arena, LNK_ICFSection, sections_count);
+  tp_for_parallel_prof(tp, 0, objs.count, lnk_icf_gather_sections_task, &task, "Gather Foldable Sections");
+
+  if (sections_count > 1) {
+    TP_Arena *arena = tp_arena_alloc(tp);
+
+    task.ranges  = tp_divide_work(scratch.arena, sections_count, tp->worker_count);
+    task.classes = push_array(scratch.arena, U32, sections_count);
+    task.keys    = push_array(scratch.arena, LNK_ICFClassKey, sections_count);
+
+    //
+    // make initial classes from section contents and relocations
+    //
+    tp_for_parallel_prof(tp, arena, tp->worker_count, lnk_icf_hash_sections_task, &task, "Hash Sections");
+    U64 class_count = lnk_icf_classes_from_keys(sections_count, task.keys, task.classes);
+
+    //
+    // split classes until sections in every class reference the same classes
+    //
+    // folding compares only the classes of direct targets, which is sound only
+    // once the partition has stopped changing, so an /OPT:ICF=N iteration count
+    // is not used to cut refinement short
+    //
+    ProfBegin("Refine Classes");
+    for (;;) {
+      tp_for_parallel(tp, 0, tp->worker_count, lnk_icf_refine_classes_task, &task);
+      U64 new_class_count = lnk_icf_classes_from_keys(sections_count, task.keys, task.classes);
+      if (new_class_count == class_count) { break; }
+      class_count = new_class_count;
+    }
+    ProfEnd();
+
+    //
+    // fold sections into class survivors
+    //
+    tp_for_parallel_prof(tp, 0, tp->worker_count, lnk_icf_fold_sections_task, &task, "Fold Sections");
+    if (task.folded_count) {
+      tp_for_parallel_prof(tp, 0, objs.count, lnk_icf_redirect_comdat_duplicates_task, &task, "Redirect COMDAT Duplicates");
+    }
+
+    lnk_log(LNK_Log_LinkStats, "[ICF Folded %llu of %llu Sections (%M)]", task.folded_count, sections_count, task.folded_size);
+
+    tp_arena_release(&arena);
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_gather_section_definitions_task)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_BuildImageTask *task    = raw_task;
+  U64                 obj_idx = task_id;
+
+  HashTable          *sect_defn_ht  = task->u.gather_sects.defns[worker_id];
+  LNK_Obj            *obj           = task->objs[obj_idx];
+  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(obj->data, obj->header.section_table_range).str;
+  String8             string_table  = str8_substr(obj->data, obj->header.string_table_range);
+
+  for (U64 sect_idx = 0; sect_idx < obj->header.section_count_no_null; sect_idx += 1) {
+    COFF_SectionHeader *sect_header = &section_table[sect_idx];
+
+    if (~sect_header->flags & COFF_SectionFlag_LnkRemove && ~sect_header->flags & COFF_SectionFlag_LnkInfo && sect_header->fsize > 0) {
+      Temp temp = temp_begin(scratch.arena);
+
+      // was section defined?
+      String8                sect_name            = coff_name_from_section_header(string_table, sect_header);
+      String8                sect_name_with_flags = lnk_make_name_with_flags(temp.arena, sect_name, sect_header->flags & ~COFF_SectionFlags_LnkFlags);
+      LNK_SectionDefinition *sect_defn            = hash_table_search_string_raw(sect_defn_ht, sect_name_with_flags);
+
+      // push new section definition
+      if (sect_defn == 0) {
+        sect_defn = push_array(arena, LNK_SectionDefinition, 1);
+        sect_defn->name         = sect_name;
+        sect_defn->obj          = obj;
+        sect_defn->obj_sect_idx = sect_idx;
+        sect_defn->flags        = sect_header->flags & ~COFF_SectionFlags_LnkFlags;
+
+        sect_name_with_flags = push_str8_copy(arena, sect_name_with_flags);
+        hash_table_push_string_raw(arena, sect_defn_ht, sect_name_with_flags, sect_defn);
+      }
+
+      // acc contrib count
+      sect_defn->contribs_count += 1;
+      
+      temp_end(temp);
+    }
+  }
+
+  scratch_end(scratch);
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_gather_section_contribs_task)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_BuildImageTask *task    = raw_task;
+  U64                 obj_idx = task_id;
+
+  LNK_Obj            *obj           = task->objs[obj_idx];
+  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(obj->data, obj->header.section_table_range).str;
+  String8             string_table  = str8_substr(obj->data, obj->header.string_table_range);
+
+  ProfBeginV("Gather Section Contribs [%S]", obj->path);
+  for (U64 sect_idx = 0; sect_idx < obj->header.section_count_no_null; sect_idx += 1) {
+    LNK_SectionContrib *sc          = task->null_sc;
+    COFF_SectionHeader *sect_header = &section_table[sect_idx];
+    if (~sect_header->flags & COFF_SectionFlag_LnkRemove && ~sect_header->flags & COFF_SectionFlag_LnkInfo && sect_header->fsize > 0) {
       LNK_SectionContribChunk *sc_chunk = 0;
       {
         Temp temp = temp_begin(scratch.arena);
@@ -2607,6 +3487,15 @@ THREAD_POOL_TASK_FUNC(lnk_gather_section_contribs_task)
         sc->align                  = sc_align == 0 ? task->default_align : sc_align;
         sc->u.obj_idx              = obj_idx;
         sc->u.obj_sect_idx         = sect_idx;
+        sc->order                  = task->order_map ? task->order_map[obj_idx][sect_idx] : 0;
+
+        // reserve space for the contribution to grow in the next incremental link
+        if (task->incremental) {
+          String8 sect_name = coff_name_from_section_header(string_table, sect_header);
+          if (lnk_incremental_is_growable_section(sect_name, sect_header->flags)) {
+            sc->tail_pad = lnk_incremental_tail_pad_from_size(data.size);
+          }
+        }
       }
     }
     task->sect_map[obj_idx][sect_idx] = sc;
@@ -2720,6 +3609,14 @@ internal int
 lnk_section_contrib_ptr_is_before(void *raw_a, void *raw_b)
 {
   LNK_SectionContrib **a = raw_a, **b = raw_b;
+
+  // ordered contribs go first, zero wraps around and puts the rest after them
+  if ((*a)->order != (*b)->order) {
+    U32 order_a = (*a)->order - 1;
+    U32 order_b = (*b)->order - 1;
+    return order_a < order_b;
+  }
+
   U64 input_idx_a = Compose64Bit((*a)->u.obj_idx, (*a)->u.obj_sect_idx);
   U64 input_idx_b = Compose64Bit((*b)->u.obj_idx, (*b)->u.obj_sect_idx);
   return u64_compar_is_before(&input_idx_a, &input_idx_b);
@@ -2770,11 +3667,11 @@ THREAD_POOL_TASK_FUNC(lnk_patch_common_block_leaders_task)
 
     if (symbol_ref.obj->header.is_big_obj) {
       COFF_Symbol32 *symbol32 = parsed_symbol.raw_symbol;
-      symbol32->value          = contrib->u.offset;
+      symbol32->value          = task->u.patch_symtabs.common_block_sc->u.off + contrib->u.offset;
       symbol32->section_number = safe_cast_u32(section_number);
     } else {
       COFF_Symbol16 *symbol16 = parsed_symbol.raw_symbol;
-      symbol16->value          = contrib->u.offset;
+      symbol16->value          = task->u.patch_symtabs.common_block_sc->u.off + contrib->u.offset;
       symbol16->section_number = safe_cast_u16(section_number);
     }
 
@@ -2999,6 +3896,9 @@ THREAD_POOL_TASK_FUNC(lnk_obj_reloc_patcher)
     if (section_header->flags & COFF_SectionFlag_LnkRemove)            { continue; }
     if (section_header->flags & COFF_SectionFlag_CntUninitializedData) { continue; }
 
+    // sections that weren't refilled keep relocations from the previous link, debug info is always rebuilt
+    if (task->is_sect_dirty && ~section_header->flags & LNK_SECTION_FLAG_DEBUG && !task->is_sect_dirty[task_id][sect_idx]) { continue; }
+
     // get section bytes (special case debug info because it is not copied to the image)
     String8 data           = section_header->flags & LNK_SECTION_FLAG_DEBUG ? obj->data : task->image_data;
     Rng1U64 section_frange = rng_1u64(section_header->foff, section_header->foff + section_header->fsize);
@@ -4052,96 +4952,928 @@ lnk_build_win32_header(Arena *arena, LNK_SymbolTable *symtab, LNK_Config *config
   return result;
 }
 
-internal LNK_ImageContext
-lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs)
+internal int
+lnk_order_profile_entry_is_before(void *raw_a, void *raw_b)
 {
-  ProfBegin("Image");
-  lnk_timer_begin(LNK_Timer_Image);
+  LNK_OrderProfileEntry *a = raw_a;
+  LNK_OrderProfileEntry *b = raw_b;
+  if (a->count != b->count) { return a->count > b->count; }
+  return a->line_idx < b->line_idx;
+}
 
-  Temp scratch = scratch_begin(arena->v, arena->count);
+internal String8List
+lnk_order_symbols_from_profile(Arena *arena, String8 path, String8 data)
+{
+  Temp scratch = scratch_begin(&arena, 1);
 
-  //
-  // init section table
-  //
-  LNK_SectionTable *sectab = lnk_section_table_alloc();
-  lnk_section_table_push(sectab, str8_lit(".text" ), PE_TEXT_SECTION_FLAGS );
-  lnk_section_table_push(sectab, str8_lit(".rdata"), PE_RDATA_SECTION_FLAGS);
-  lnk_section_table_push(sectab, str8_lit(".data" ), PE_DATA_SECTION_FLAGS );
-  lnk_section_table_push(sectab, str8_lit(".bss"  ), PE_BSS_SECTION_FLAGS  );
-  lnk_section_table_push(sectab, str8_lit(".pdata"), PE_PDATA_SECTION_FLAGS);
-  LNK_Section *common_block_sect = lnk_section_table_search(sectab, str8_lit(".bss"), PE_BSS_SECTION_FLAGS);
+  String8List            lines         = str8_split_by_string_chars(scratch.arena, data, str8_lit("\r\n"), 0);
+  LNK_OrderProfileEntry *entries       = push_array(scratch.arena, LNK_OrderProfileEntry, lines.node_count);
+  U64                    entries_count = 0;
+  for EachNode(line_n, String8Node, lines.first) {
+    String8 line = str8_skip_chop_whitespace(line_n->string);
+    if (line.size == 0 || line.str[0] == '#') { continue; }
+
+    // parse "SYMBOL COUNT"
+    String8List tokens = str8_split_by_string_chars(scratch.arena, line, str8_lit(" \t"), 0);
+    U64         count  = 0;
+    if (tokens.node_count != 2 || !try_u64_from_str8_c_rules(tokens.last->string, &count)) {
+      lnk_error(LNK_Warning_Order, "%S: unable to parse \"%S\", expected format \"SYMBOL COUNT\"", path, line);
+      continue;
+    }
 
-  LNK_BuildImageTask task = {
-    .symtab           = symtab,
-    .sectab           = sectab,
-    .objs_count       = objs_count,
-    .objs             = objs,
-    .function_pad_min = config->function_pad_min,
-    .default_align    = coff_default_align_from_machine(config->machine),
-    .null_sc          = push_array(arena->v[0], LNK_SectionContrib, 1),
-  };
+    LNK_OrderProfileEntry *entry = &entries[entries_count];
+    entry->name     = tokens.first->string;
+    entry->count    = count;
+    entry->line_idx = entries_count;
+    entries_count  += 1;
+  }
 
-  {
-    ProfBegin("Define And Count Sections");
-    TP_Temp temp = tp_temp_begin(arena);
+  // hottest functions go first, ties keep the profile order
+  radsort(entries, entries_count, lnk_order_profile_entry_is_before);
 
-    ProfBegin("Init Hash Tables For Gathering Section Definitions");
-    task.u.gather_sects.defns = push_array(arena->v[0], HashTable *, tp->worker_count);
-    for EachIndex(worker_id, tp->worker_count) { task.u.gather_sects.defns[worker_id] = hash_table_init(arena->v[0], 128); }
-    ProfEnd();
+  String8List result = {0};
+  for EachIndex(entry_idx, entries_count) {
+    str8_list_push(arena, &result, entries[entry_idx].name);
+  }
 
-    tp_for_parallel_prof(tp, arena, objs_count, lnk_gather_section_definitions_task, &task, "Gather Section Definitions");
+  scratch_end(scratch);
+  return result;
+}
 
-    ProfBegin("Merge Section Definitions Hash Tables");
-    for (U64 worker_idx = 1; worker_idx < tp->worker_count; worker_idx += 1) {
-      U64                     sect_defns_count = task.u.gather_sects.defns[worker_idx]->count;
-      LNK_SectionDefinition **sect_defns       = values_from_hash_table_raw(arena->v[0], task.u.gather_sects.defns[worker_idx]);
-      radsort(sect_defns, sect_defns_count, lnk_section_definition_is_before);
+internal U32 **
+lnk_order_map_from_config(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs)
+{
+  if (config->order_name.size == 0 && config->order_profile_name.size == 0) {
+    return 0;
+  }
 
-      for EachIndex(defn_idx, sect_defns_count) {
-        LNK_SectionDefinition *defn            = sect_defns[defn_idx];
-        String8                name_with_flags = lnk_make_name_with_flags(arena->v[0], defn->name, defn->flags);
-        LNK_SectionDefinition *main_defn       = hash_table_search_string_raw(task.u.gather_sects.defns[0], name_with_flags);
-        if (main_defn == 0) {
-          main_defn = sect_defns[defn_idx];
-          hash_table_push_string_raw(arena->v[0], task.u.gather_sects.defns[0], name_with_flags, main_defn);
-        } else {
-          if (lnk_section_definition_is_before(&sect_defns[defn_idx], &main_defn)) {
-            main_defn->obj = sect_defns[defn_idx]->obj;
-            main_defn->obj_sect_idx = sect_defns[defn_idx]->obj_sect_idx;
-          }
-          main_defn->contribs_count += sect_defns[defn_idx]->contribs_count;
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  // read order files
+  String8 order_paths[] = { config->order_name, config->order_profile_name };
+  String8 order_datas[ArrayCount(order_paths)] = {0};
+  {
+    String8List read_paths = {0};
+    for EachElement(path_idx, order_paths) {
+      if (order_paths[path_idx].size) { str8_list_push(scratch.arena, &read_paths, order_paths[path_idx]); }
+    }
+    String8Array read_datas = lnk_read_data_from_file_path_parallel(tp, scratch.arena, config->io_flags, str8_array_from_list(scratch.arena, &read_paths));
+    for (U64 path_idx = 0, read_idx = 0; path_idx < ArrayCount(order_paths); path_idx += 1) {
+      if (order_paths[path_idx].size) {
+        order_datas[path_idx] = read_datas.v[read_idx++];
+        if (order_datas[path_idx].size == 0) {
+          lnk_error(LNK_Error_FileNotFound, "unable to open order file \"%S\"", order_paths[path_idx]);
         }
       }
     }
-    U64                     sect_defns_count = task.u.gather_sects.defns[0]->count;
-    LNK_SectionDefinition **sect_defns       = values_from_hash_table_raw(arena->v[0], task.u.gather_sects.defns[0]);
-    ProfEnd();
+  }
 
-    ProfBegin("Sort Sections Definitions");
-    radsort(sect_defns, sect_defns_count, lnk_section_definition_is_before);
-    ProfEnd();
+  // symbols from /ORDER are placed first and in the listed order
+  String8List order_symbols = {0};
+  if (config->order_name.size) {
+    String8List lines = str8_split_by_string_chars(scratch.arena, order_datas[0], str8_lit("\r\n"), 0);
+    for EachNode(line_n, String8Node, lines.first) {
+      String8 name = str8_skip_chop_whitespace(line_n->string);
+      if (name.size) {
+        str8_list_push(scratch.arena, &order_symbols, name);
+      }
+    }
+  }
 
-    ProfBegin("Push Sections And Reserve Section Contrib Memory");
-    task.contribs_ht = hash_table_init(sectab->arena, sect_defns_count);
-    for EachIndex(defn_idx, sect_defns_count) {
-      LNK_SectionDefinition *sect_defn = sect_defns[defn_idx];
+  // hot functions from the profile follow, clustered by sample count
+  String8List profile_symbols = {0};
+  if (config->order_profile_name.size) {
+    profile_symbols = lnk_order_symbols_from_profile(scratch.arena, config->order_profile_name, order_datas[1]);
+  }
 
-      // parse section name
-      String8 sect_name, sort_idx;
-      coff_parse_section_name(sect_defn->name, &sect_name, &sort_idx);
+  U32 **order_map = push_array(arena, U32 *, objs_count);
+  for EachIndex(obj_idx, objs_count) {
+    order_map[obj_idx] = push_array(arena, U32, objs[obj_idx]->header.section_count_no_null);
+  }
 
-      // do not create definitions for sections that are removed from the image
-      if (lnk_is_section_removed(config, sect_name)) { continue; }
+  U64         order_count    = 0;
+  String8List symbol_lists[] = { order_symbols, profile_symbols };
+  for EachElement(list_idx, symbol_lists) {
+    // profiles are gathered from other images, don't warn about symbols that were not linked in
+    B32 is_profile = list_idx == 1;
 
-      // warn about conflicting section flags
-      for (LNK_SectionNode *sect_n = sectab->list.first; sect_n != 0; sect_n = sect_n->next) {
-        if (str8_match(sect_n->data.name, sect_name, 0) && sect_n->data.flags != sect_defn->flags) {
-          LNK_Obj            *obj                = sect_defn->obj;
-          U32                 sect_number        = sect_defn->obj_sect_idx + 1;
-          COFF_SectionHeader *sect_header        = lnk_coff_section_header_from_section_number(obj, sect_number);
-          String8             sect_name          = coff_name_from_section_header(str8_substr(obj->data, obj->header.string_table_range), sect_header);
-          String8             expected_flags_str = coff_string_from_section_flags(arena->v[0], sect_n->data.flags);
+    for EachNode(name_n, String8Node, symbol_lists[list_idx].first) {
+      LNK_Symbol *symbol = lnk_symbol_table_search(symtab, name_n->string);
+      if (symbol == 0) {
+        if (!is_profile) {
+          lnk_error(LNK_Warning_Order, "%S: symbol \"%S\" does not exist, ignored", order_paths[list_idx], name_n->string);
+        }
+        continue;
+      }
+      if (lnk_interp_from_symbol(symbol) != COFF_SymbolValueInterp_Regular) {
+        lnk_error(LNK_Warning_Order, "%S: symbol \"%S\" is not defined in a section, ignored", order_paths[list_idx], name_n->string);
+        continue;
+      }
+
+      LNK_ObjSymbolRef    symbol_ref     = lnk_ref_from_symbol(symbol);
+      LNK_Obj            *obj            = symbol_ref.obj;
+      U32                 section_number = lnk_parsed_from_symbol(symbol).section_number;
+      COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section_number);
+      if (~section_header->flags & COFF_SectionFlag_LnkCOMDAT) {
+        lnk_error(LNK_Warning_Order, "%S: symbol \"%S\" is not in a COMDAT section (compile with /Gy), ignored", order_paths[list_idx], name_n->string);
+        continue;
+      }
+
+      // COMDAT may have been folded into another section
+      LNK_Symbol *symlink = lnk_obj_get_comdat_symlink(obj, section_number);
+      if (symlink) {
+        obj            = lnk_ref_from_symbol(symlink).obj;
+        section_number = lnk_parsed_from_symbol(symlink).section_number;
+        section_header = lnk_coff_section_header_from_section_number(obj, section_number);
+      }
+
+      // section was discarded by /OPT:REF
+      if (section_header->flags & COFF_SectionFlag_LnkRemove) { continue; }
+
+      // first occurrence wins
+      U32 *order = &order_map[obj->input_idx][section_number-1];
+      if (*order == 0) {
+        order_count += 1;
+        *order       = order_count;
+      }
+    }
+  }
+
+  lnk_log(LNK_Log_LinkStats, "[Ordered %llu COMDAT Sections]", order_count);
+
+  scratch_end(scratch);
+  ProfEnd();
+  return order_map;
+}
+
+internal U64
+lnk_incremental_hash_from_section_name(String8 name, COFF_SectionFlags flags)
+{
+  return XXH3_64bits_withSeed(name.str, name.size, flags);
+}
+
+internal B32
+lnk_incremental_is_growable_section(String8 sect_name, COFF_SectionFlags flags)
+{
+  // code and plain data can grow into the space reserved after them, other
+  // sections hold tables that are read as a whole and must stay packed
+  String8 name, postfix;
+  coff_parse_section_name(sect_name, &name, &postfix);
+  B32 is_growable = !!(flags & COFF_SectionFlag_CntCode);
+  if (postfix.size == 0) {
+    is_growable = is_growable ||
+                  str8_match(name, str8_lit(".data"),  0) ||
+                  str8_match(name, str8_lit(".rdata"), 0) ||
+                  str8_match(name, str8_lit(".bss"),   0) ||
+                  str8_match(name, str8_lit(".xdata"), 0);
+  }
+  return is_growable;
+}
+
+internal U64
+lnk_incremental_tail_pad_from_size(U64 size)
+{
+  return Clamp(16, AlignPow2(size / 4, 16), 4096);
+}
+
+internal LNK_IncrementalSection *
+lnk_incremental_reloc_section_from_layout(LNK_IncrementalLayout *layout)
+{
+  LNK_IncrementalSection *reloc_sect = 0;
+  if (layout->header->sect_count > 0) {
+    LNK_IncrementalSection *last_sect = &layout->sects[layout->header->sect_count-1];
+    if (last_sect->name_hash == lnk_incremental_hash_from_section_name(str8_lit(".reloc"), PE_RELOC_SECTION_FLAGS)) {
+      reloc_sect = last_sect;
+    }
+  }
+  return reloc_sect;
+}
+
+internal LNK_IncrementalContrib *
+lnk_incremental_contrib_from_obj_sect_idx(LNK_IncrementalLayout *layout, U64 obj_idx, U64 obj_sect_idx)
+{
+  // contributions of an obj are stored in section order
+  LNK_IncrementalObj *obj = &layout->objs[obj_idx];
+  U64 lo = obj->first_contrib, hi = obj->first_contrib + obj->contrib_count;
+  while (lo < hi) {
+    U64 mid = lo + (hi - lo) / 2;
+    if (layout->contribs[mid].obj_sect_idx < obj_sect_idx) { lo = mid + 1; } else { hi = mid; }
+  }
+  if (lo < obj->first_contrib + obj->contrib_count && layout->contribs[lo].obj_sect_idx == obj_sect_idx) {
+    return &layout->contribs[lo];
+  }
+  return 0;
+}
+
+internal int
+lnk_incremental_range_is_before(void *raw_a, void *raw_b)
+{
+  Rng1U64 *a = raw_a, *b = raw_b;
+  return a->min < b->min;
+}
+
+internal B32
+lnk_incremental_is_offset_in_ranges(Rng1U64Array ranges, U64 off)
+{
+  U64 lo = 0, hi = ranges.count;
+  while (lo < hi) {
+    U64 mid = lo + (hi - lo) / 2;
+    if (ranges.v[mid].max <= off) { lo = mid + 1; } else { hi = mid; }
+  }
+  return lo < ranges.count && ranges.v[lo].min <= off;
+}
+
+internal Rng1U64Array
+lnk_incremental_merge_ranges(Arena *arena, Rng1U64List list)
+{
+  Rng1U64Array ranges = rng1u64_array_from_list(arena, &list);
+  radsort(ranges.v, ranges.count, lnk_incremental_range_is_before);
+
+  U64 merged_count = 0;
+  for EachIndex(range_idx, ranges.count) {
+    if (merged_count > 0 && ranges.v[range_idx].min <= ranges.v[merged_count-1].max) {
+      ranges.v[merged_count-1].max = Max(ranges.v[merged_count-1].max, ranges.v[range_idx].max);
+    } else {
+      ranges.v[merged_count++] = ranges.v[range_idx];
+    }
+  }
+  ranges.count = merged_count;
+
+  return ranges;
+}
+
+internal String8
+lnk_incremental_comdat_name_from_section_number(LNK_Obj *obj, U32 section_number)
+{
+  // associative sections are named after the COMDAT they are attached to
+  for EachIndex(i, obj->header.section_count_no_null) {
+    COFF_ComdatSelectType select;
+    U32                   assoc_section_number, section_length, check_sum;
+    if (!lnk_try_comdat_props_from_section_number(obj, section_number, &select, &assoc_section_number, &section_length, &check_sum)) { break; }
+    if (select != COFF_ComdatSelect_Associative)                                                                                       { break; }
+    if (assoc_section_number == 0 || assoc_section_number > obj->header.section_count_no_null)                                        { break; }
+    section_number = assoc_section_number;
+  }
+  LNK_Symbol *symlink = lnk_obj_get_comdat_symlink(obj, section_number);
+  return symlink ? symlink->name : str8_zero();
+}
+
+internal int
+lnk_incremental_symbol_ref_is_before(void *raw_a, void *raw_b)
+{
+  LNK_IncrementalSymbolRef *a = raw_a, *b = raw_b;
+  if (a->state.name_hash != b->state.name_hash) {
+    return a->state.name_hash < b->state.name_hash;
+  }
+  return str8_is_before_case_sensitive(&a->symbol->name, &b->symbol->name);
+}
+
+internal LNK_IncrementalImage *
+lnk_incremental_image_begin(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs, LNK_IncrementalLayout *prev)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_IncrementalImage *inc = push_array(arena, LNK_IncrementalImage, 1);
+  inc->prev           = prev;
+  inc->pdata_sect_idx = max_U64;
+  inc->contrib_keys   = push_array(arena, U64 *, objs_count);
+  for EachIndex(obj_idx, objs_count) { inc->contrib_keys[obj_idx] = push_array(arena, U64, objs[obj_idx]->header.section_count_no_null); }
+
+  // objs made by the linker have no disk hash, so they are identified by contents
+  {
+    ProfBegin("Hash Objs");
+    U64          *linkgen_obj_idxs = push_array(scratch.arena, U64, objs_count);
+    String8Array  linkgen_datas    = { .v = push_array(scratch.arena, String8, objs_count) };
+    inc->obj_hashes = push_array(arena, U128, objs_count);
+    for EachIndex(obj_idx, objs_count) {
+      if (u128_match(objs[obj_idx]->hash, u128_zero())) {
+        linkgen_obj_idxs[linkgen_datas.count] = obj_idx;
+        linkgen_datas.v[linkgen_datas.count]  = objs[obj_idx]->data;
+        linkgen_datas.count += 1;
+      } else {
+        inc->obj_hashes[obj_idx] = objs[obj_idx]->hash;
+      }
+    }
+    U128 *linkgen_hashes = lnk_incremental_hash_parallel(tp, scratch.arena, linkgen_datas);
+    for EachIndex(i, linkgen_datas.count) { inc->obj_hashes[linkgen_obj_idxs[i]] = linkgen_hashes[i]; }
+    ProfEnd();
+  }
+
+  // record which obj defines each symbol before symbols are patched with image offsets
+  {
+    ProfBegin("Snapshot Symbol Table");
+    U64                       chunks_count = 0;
+    LNK_SymbolHashTrieChunk **chunks       = lnk_array_from_symbol_hash_trie_chunk_list(scratch.arena, symtab->chunks, symtab->arena->count, &chunks_count);
+    for EachIndex(chunk_idx, chunks_count) {
+      for EachIndex(i, chunks[chunk_idx]->count) {
+        inc->symbol_count += chunks[chunk_idx]->v[i].symbol != 0;
+      }
+    }
+
+    U64 cursor = 0;
+    inc->symbols = push_array(arena, LNK_IncrementalSymbolRef, inc->symbol_count);
+    for EachIndex(chunk_idx, chunks_count) {
+      for EachIndex(i, chunks[chunk_idx]->count) {
+        LNK_Symbol *symbol = chunks[chunk_idx]->v[i].symbol;
+        if (symbol == 0) { continue; }
+        COFF_ParsedSymbol          parsed = lnk_parsed_from_symbol(symbol);
+        COFF_SymbolValueInterpType interp = coff_interp_from_parsed_symbol(parsed);
+        LNK_IncrementalSymbolRef  *ref    = &inc->symbols[cursor++];
+        ref->symbol          = symbol;
+        ref->state.name_hash = XXH3_64bits(symbol->name.str, symbol->name.size);
+        ref->state.obj_idx   = lnk_ref_from_symbol(symbol).obj->input_idx;
+        ref->state.interp    = interp;
+        ref->state.value     = interp == COFF_SymbolValueInterp_Abs ? parsed.value : 0;
+      }
+    }
+    radsort(inc->symbols, inc->symbol_count, lnk_incremental_symbol_ref_is_before);
+    ProfEnd();
+  }
+
+  // the previous layout is reused when the link pulled in the same objs and
+  // resolved every symbol to the same definition
+  if (prev) {
+    inc->is_patching = 1;
+
+    if (config->do_function_pad_min == LNK_SwitchState_Yes) {
+      lnk_log(LNK_Log_Incremental, "Incremental: hotpatch padding is not supported when patching, performing full link");
+      inc->is_patching = 0;
+    }
+
+    if (inc->is_patching && prev->header->obj_count != objs_count) {
+      lnk_log(LNK_Log_Incremental, "Incremental: linked objs changed, performing full link");
+      inc->is_patching = 0;
+    }
+    for (U64 obj_idx = 0; inc->is_patching && obj_idx < objs_count; obj_idx += 1) {
+      if (prev->objs[obj_idx].path_hash != XXH3_64bits(objs[obj_idx]->path.str, objs[obj_idx]->path.size)) {
+        lnk_log(LNK_Log_Incremental, "Incremental: linked objs changed at %S, performing full link", objs[obj_idx]->path);
+        inc->is_patching = 0;
+      }
+    }
+
+    if (inc->is_patching && prev->header->symbol_count != inc->symbol_count) {
+      lnk_log(LNK_Log_Incremental, "Incremental: symbol table changed, performing full link");
+      inc->is_patching = 0;
+    }
+    for (U64 symbol_idx = 0; inc->is_patching && symbol_idx < inc->symbol_count; symbol_idx += 1) {
+      LNK_IncrementalSymbol *a = &inc->symbols[symbol_idx].state;
+      LNK_IncrementalSymbol *b = &prev->symbols[symbol_idx];
+      B32 is_same = a->name_hash == b->name_hash && a->obj_idx == b->obj_idx && a->interp == b->interp;
+      if (is_same && a->interp == COFF_SymbolValueInterp_Abs) {
+        is_same = a->value == b->value;
+      }
+      if (!is_same) {
+        lnk_log(LNK_Log_Incremental, "Incremental: symbol %S changed, performing full link", inc->symbols[symbol_idx].symbol->name);
+        inc->is_patching = 0;
+      }
+    }
+
+    if (inc->is_patching) {
+      inc->is_obj_changed = push_array(arena, B8, objs_count);
+      for EachIndex(obj_idx, objs_count) {
+        if (u128_match(inc->obj_hashes[obj_idx], prev->objs[obj_idx].hash)) { continue; }
+        inc->is_obj_changed[obj_idx] = 1;
+        inc->changed_obj_count      += 1;
+
+        // common block is packed across objs
+        LNK_Obj          *obj = objs[obj_idx];
+        COFF_ParsedSymbol symbol;
+        for (U64 symbol_idx = 0; inc->is_patching && symbol_idx < obj->header.symbol_count; symbol_idx += (1 + symbol.aux_symbol_count)) {
+          symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, symbol_idx);
+          if (coff_interp_from_parsed_symbol(symbol) == COFF_SymbolValueInterp_Common) {
+            lnk_log(LNK_Log_Incremental, "Incremental: %S has common symbols, performing full link", obj->path);
+            inc->is_patching = 0;
+          }
+        }
+      }
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+  return inc;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_incremental_contrib_keys_task)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_BuildImageTask *task         = raw_task;
+  U64                 obj_idx      = task_id;
+  LNK_Obj            *obj          = task->objs[obj_idx];
+  String8             string_table = lnk_coff_string_table_from_obj(obj);
+  U64                *keys         = task->incremental->contrib_keys[obj_idx];
+  HashTable          *ordinal_ht   = hash_table_init(scratch.arena, Max(obj->header.section_count_no_null, 1));
+
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    if (task->sect_map[obj_idx][sect_idx] == task->null_sc) { continue; }
+
+    // a contribution is matched across links on section name and flags, the
+    // COMDAT it belongs to, and its position among the obj's sections that share those
+    COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, sect_idx+1);
+    String8             sect_name      = coff_name_from_section_header(string_table, section_header);
+    U64                 key            = XXH3_64bits_withSeed(sect_name.str, sect_name.size, section_header->flags & ~COFF_SectionFlags_LnkFlags);
+    if (section_header->flags & COFF_SectionFlag_LnkCOMDAT) {
+      String8 comdat_name = lnk_incremental_comdat_name_from_section_number(obj, sect_idx+1);
+      key = XXH3_64bits_withSeed(comdat_name.str, comdat_name.size, key);
+    }
+
+    U64           ordinal    = 0;
+    KeyValuePair *ordinal_kv = hash_table_search_u64(ordinal_ht, key);
+    if (ordinal_kv) {
+      ordinal = ++ordinal_kv->value_u64;
+    } else {
+      hash_table_push_u64_u64(scratch.arena, ordinal_ht, key, 0);
+    }
+    key = XXH3_64bits_withSeed(&ordinal, sizeof(ordinal), key);
+
+    // zero marks sections that don't contribute
+    keys[sect_idx] = Max(key, 1);
+  }
+
+  scratch_end(scratch);
+}
+
+internal B32
+lnk_incremental_pin_layout(LNK_Config *config, LNK_BuildImageTask *task, LNK_SectionContrib *common_block_sc)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  LNK_IncrementalImage        *inc       = task->incremental;
+  LNK_IncrementalLayout       *prev      = inc->prev;
+  LNK_IncrementalLayoutHeader *header    = prev->header;
+  B32                          is_pinned = 0;
+
+  // image sections must line up with the previous link, .reloc is laid out after them
+  LNK_IncrementalSection *prev_reloc      = lnk_incremental_reloc_section_from_layout(prev);
+  U64                     prev_sect_count = header->sect_count - (prev_reloc ? 1 : 0);
+  LNK_Section           **sects           = push_array(scratch.arena, LNK_Section *, prev_sect_count);
+  U64                     sect_count      = 0;
+  U64                     sc_count        = 0;
+  for EachNode(sect_n, LNK_SectionNode, task->sectab->list.first) {
+    LNK_Section *sect          = &sect_n->data;
+    U64          sect_sc_count = 0;
+    for EachNode(sc_chunk, LNK_SectionContribChunk, sect->contribs.first) { sect_sc_count += sc_chunk->count; }
+    if (sect_sc_count == 0) { continue; }
+
+    if (sect_count >= prev_sect_count || prev->sects[sect_count].name_hash != lnk_incremental_hash_from_section_name(sect->name, sect->flags)) {
+      lnk_log(LNK_Log_Incremental, "Incremental: image section %S is new or moved, performing full link", sect->name);
+      goto exit;
+    }
+    sects[sect_count++] = sect;
+    sc_count += sect_sc_count;
+  }
+  if (sect_count != prev_sect_count) {
+    lnk_log(LNK_Log_Incremental, "Incremental: image lost a section, performing full link");
+    goto exit;
+  }
+
+  // a new .reloc section header has to fit in front of the first section
+  if (prev_reloc == 0 && ~config->flags & LNK_ConfigFlag_Fixed && sect_count > 0) {
+    U64 image_header_size = AlignPow2(lnk_compute_win32_image_header_size(config, sect_count + 1), config->file_align);
+    if (image_header_size > prev->sects[0].foff) {
+      lnk_log(LNK_Log_Incremental, "Incremental: no room for .reloc section header, performing full link");
+      goto exit;
+    }
+  }
+
+  // changed objs look up their slots by key, unchanged objs by section index
+  HashTable **slot_hts = push_array(scratch.arena, HashTable *, task->objs_count);
+  for EachIndex(obj_idx, task->objs_count) {
+    if (!inc->is_obj_changed[obj_idx]) { continue; }
+    LNK_IncrementalObj *prev_obj = &prev->objs[obj_idx];
+    slot_hts[obj_idx] = hash_table_init(scratch.arena, Max(prev_obj->contrib_count, 1));
+    for EachIndex(i, prev_obj->contrib_count) {
+      U64 contrib_idx = prev_obj->first_contrib + i;
+      hash_table_push_u64_u64(scratch.arena, slot_hts[obj_idx], prev->contribs[contrib_idx].key, contrib_idx);
+    }
+  }
+
+  // plan every contribution before touching the layout, so a misfit leaves it as it was
+  B8  *is_slot_used = push_array(scratch.arena, B8,  header->contrib_count);
+  U32 *plan_offs    = push_array(scratch.arena, U32, sc_count);
+  U32 *plan_pads    = push_array(scratch.arena, U32, sc_count);
+  U64  plan_idx     = 0;
+  for EachIndex(sect_idx, sect_count) {
+    U64 cursor = 0;
+    for EachNode(sc_chunk, LNK_SectionContribChunk, sects[sect_idx]->contribs.first) {
+      for EachIndex(sc_idx, sc_chunk->count) {
+        LNK_SectionContrib *sc   = sc_chunk->v[sc_idx];
+        U64                 size = lnk_size_from_section_contrib(sc);
+        U64                 off, cap;
+        if (sc == common_block_sc) {
+          if (header->common_block_size != size || header->common_block_sect_idx != sect_idx) {
+            lnk_log(LNK_Log_Incremental, "Incremental: common block changed, performing full link");
+            goto exit;
+          }
+          off = header->common_block_off;
+          cap = size;
+        } else {
+          LNK_Obj                *obj            = task->objs[sc->u.obj_idx];
+          COFF_SectionHeader     *section_header = lnk_coff_section_header_from_section_number(obj, sc->u.obj_sect_idx+1);
+          String8                 sect_name      = coff_name_from_section_header(lnk_coff_string_table_from_obj(obj), section_header);
+          U64                     key            = inc->contrib_keys[sc->u.obj_idx][sc->u.obj_sect_idx];
+          LNK_IncrementalContrib *slot           = 0;
+          if (inc->is_obj_changed[sc->u.obj_idx]) {
+            KeyValuePair *slot_kv = hash_table_search_u64(slot_hts[sc->u.obj_idx], key);
+            slot = slot_kv ? &prev->contribs[slot_kv->value_u64] : 0;
+          } else {
+            slot = lnk_incremental_contrib_from_obj_sect_idx(prev, sc->u.obj_idx, sc->u.obj_sect_idx);
+            slot = slot && slot->key == key && slot->size == size ? slot : 0;
+          }
+          if (slot == 0 || slot->sect_idx != sect_idx || is_slot_used[slot - prev->contribs]) {
+            lnk_log(LNK_Log_Incremental, "Incremental: %S sections changed, performing full link", obj->path);
+            goto exit;
+          }
+
+          B32 is_growable = lnk_incremental_is_growable_section(sect_name, section_header->flags);
+          if (size > slot->cap || (!is_growable && size != slot->size)) {
+            lnk_log(LNK_Log_Incremental, "Incremental: %S(%S) outgrew its space in the image, performing full link", obj->path, sect_name);
+            goto exit;
+          }
+
+          is_slot_used[slot - prev->contribs] = 1;
+          off = slot->off;
+          cap = slot->cap;
+        }
+
+        // contributions stay in section order
+        if (off < cursor || off % sc->align != 0) {
+          lnk_log(LNK_Log_Incremental, "Incremental: contributions to %S moved, performing full link", sects[sect_idx]->name);
+          goto exit;
+        }
+        cursor = off + cap;
+
+        plan_offs[plan_idx] = off;
+        plan_pads[plan_idx] = cap - size;
+        plan_idx += 1;
+      }
+    }
+  }
+  if (header->common_block_size && common_block_sc == 0) {
+    lnk_log(LNK_Log_Incremental, "Incremental: common block changed, performing full link");
+    goto exit;
+  }
+  for EachIndex(contrib_idx, header->contrib_count) {
+    if (!is_slot_used[contrib_idx]) {
+      lnk_log(LNK_Log_Incremental, "Incremental: section contributions were removed, performing full link");
+      goto exit;
+    }
+  }
+
+  // commit layout
+  plan_idx = 0;
+  for EachIndex(sect_idx, sect_count) {
+    LNK_Section *sect = sects[sect_idx];
+    for EachNode(sc_chunk, LNK_SectionContribChunk, sect->contribs.first) {
+      for EachIndex(sc_idx, sc_chunk->count) {
+        sc_chunk->v[sc_idx]->u.off    = plan_offs[plan_idx];
+        sc_chunk->v[sc_idx]->tail_pad = plan_pads[plan_idx];
+        plan_idx += 1;
+      }
+    }
+    sect->vsize = prev->sects[sect_idx].vsize;
+    sect->fsize = prev->sects[sect_idx].fsize;
+  }
+  is_pinned = 1;
+
+  exit:;
+  scratch_end(scratch);
+  ProfEnd();
+  return is_pinned;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_incremental_flag_dirty_sections_task)
+{
+  LNK_BuildImageTask   *task                   = raw_task;
+  LNK_IncrementalImage *inc                    = task->incremental;
+  U64                   obj_idx                = task_id;
+  LNK_Obj              *obj                    = task->objs[obj_idx];
+
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    if (inc->contrib_keys[obj_idx][sect_idx] == 0) { continue; }
+
+    // changed objs are copied whole, the exception table is sorted after it is copied
+    LNK_SectionContrib *sc       = task->sect_map[obj_idx][sect_idx];
+    B8                  is_dirty = inc->is_obj_changed[obj_idx] || sc->u.sect_idx == inc->pdata_sect_idx;
+
+    // relocations that land in slots of changed objs are applied again
+    if (!is_dirty) {
+      COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, sect_idx+1);
+      COFF_RelocArray     relocs         = lnk_coff_relocs_from_section_header(obj, section_header);
+      for EachIndex(reloc_idx, relocs.count) {
+        COFF_ParsedSymbol symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, relocs.v[reloc_idx].isymbol);
+        if (coff_interp_from_parsed_symbol(symbol) != COFF_SymbolValueInterp_Regular)              { continue; }
+        if (symbol.section_number == 0 || symbol.section_number > task->image_sects.count)        { continue; }
+        if (lnk_incremental_is_offset_in_ranges(inc->dirty_ranges[symbol.section_number-1], symbol.value)) {
+          is_dirty = 1;
+          break;
+        }
+      }
+    }
+
+    inc->is_sect_dirty[obj_idx][sect_idx] = is_dirty;
+  }
+}
+
+internal void
+lnk_incremental_flag_dirty_sections(TP_Context *tp, Arena *arena, LNK_BuildImageTask *task)
+{
+  ProfBeginFunction();
+  LNK_IncrementalImage *inc = task->incremental;
+
+  // slots of changed objs, a symbol right past the end of a contribution still points into its slot
+  Rng1U64List *dirty_lists = push_array(arena, Rng1U64List, task->image_sects.count);
+  for EachIndex(obj_idx, task->objs_count) {
+    if (!inc->is_obj_changed[obj_idx]) { continue; }
+    for EachIndex(sect_idx, task->objs[obj_idx]->header.section_count_no_null) {
+      if (inc->contrib_keys[obj_idx][sect_idx] == 0) { continue; }
+      LNK_SectionContrib *sc        = task->sect_map[obj_idx][sect_idx];
+      U64                 slot_size = lnk_size_from_section_contrib(sc) + sc->tail_pad;
+      rng1u64_list_push(arena, &dirty_lists[sc->u.sect_idx], rng_1u64(sc->u.off, sc->u.off + slot_size + 1));
+    }
+  }
+  inc->dirty_ranges = push_array(arena, Rng1U64Array, task->image_sects.count);
+  for EachIndex(sect_idx, task->image_sects.count) {
+    inc->dirty_ranges[sect_idx] = rng1u64_array_from_list(arena, &dirty_lists[sect_idx]);
+    radsort(inc->dirty_ranges[sect_idx].v, inc->dirty_ranges[sect_idx].count, lnk_incremental_range_is_before);
+  }
+
+  LNK_Section *pdata_sect = lnk_section_table_search(task->sectab, str8_lit(".pdata"), PE_PDATA_SECTION_FLAGS);
+  if (pdata_sect) {
+    inc->pdata_sect_idx = pdata_sect->sect_idx;
+  }
+
+  inc->is_sect_dirty = push_array(arena, B8 *, task->objs_count);
+  for EachIndex(obj_idx, task->objs_count) { inc->is_sect_dirty[obj_idx] = push_array(arena, B8, task->objs[obj_idx]->header.section_count_no_null); }
+  tp_for_parallel_prof(tp, 0, task->objs_count, lnk_incremental_flag_dirty_sections_task, task, "Flag Dirty Sections");
+
+  ProfEnd();
+}
+
+internal String8
+lnk_incremental_fill_image(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_BuildImageTask *task, LNK_Section *image_header_sect, Rng1U64List *patch_ranges)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_IncrementalImage *inc            = task->incremental;
+  U8                    code_fill_byte = coff_code_align_byte_from_machine(config->machine);
+
+  // start from the previous image, .reloc is last and may have grown past its end
+  String8 image_data = {0};
+  image_data.size = lnk_section_table_total_fsize(task->sectab);
+  image_data.str  = push_array_no_zero(arena, U8, image_data.size);
+  U64 read_size = lnk_read_data_from_file_path_to_buffer(config->image_name, image_data.size, image_data.str);
+  if (read_size != inc->prev->header->image_size) {
+    lnk_error(LNK_Error_IO, "unable to read %S for incremental link", config->image_name);
+  }
+  MemoryZero(image_data.str + read_size, image_data.size - read_size);
+
+  // slots of changed objs are cleared, then dirty contributions are copied over the previous bytes
+  U64                 fill_node_count = 0;
+  LNK_ImageFillNode **fill_nodes      = push_array(scratch.arena, LNK_ImageFillNode *, tp->worker_count);
+  for EachIndex(obj_idx, task->objs_count) {
+    for EachIndex(sect_idx, task->objs[obj_idx]->header.section_count_no_null) {
+      if (!inc->is_sect_dirty[obj_idx][sect_idx]) { continue; }
+
+      LNK_SectionContrib **sc_ptr = &task->sect_map[obj_idx][sect_idx];
+      LNK_SectionContrib  *sc     = *sc_ptr;
+      LNK_Section         *sect   = task->image_sects.v[sc->u.sect_idx];
+      if (sect->flags & COFF_SectionFlag_CntUninitializedData) { continue; }
+
+      Rng1U64 range = rng_1u64(sect->foff + sc->u.off, sect->foff + sc->u.off + lnk_size_from_section_contrib(sc));
+      if (inc->is_obj_changed[obj_idx]) {
+        U8 fill_byte = sect->flags & COFF_SectionFlag_CntCode ? code_fill_byte : 0;
+        range.max += sc->tail_pad;
+        MemorySet(image_data.str + range.min, fill_byte, dim_1u64(range));
+      }
+      rng1u64_list_push(arena, patch_ranges, range);
+
+      LNK_ImageFillNode *n = push_array(scratch.arena, LNK_ImageFillNode, 1);
+      n->base_foff = sect->foff;
+      n->sc_count  = 1;
+      n->sc        = sc_ptr;
+      SLLStackPush(fill_nodes[fill_node_count % tp->worker_count], n);
+      fill_node_count += 1;
+    }
+  }
+
+  // image header and base relocations are rebuilt on every link
+  LNK_Section *rebuilt_sects[] = { image_header_sect, lnk_section_table_search(task->sectab, str8_lit(".reloc"), PE_RELOC_SECTION_FLAGS) };
+  for EachElement(i, rebuilt_sects) {
+    LNK_Section *sect = rebuilt_sects[i];
+    if (sect == 0) { continue; }
+    MemoryZero(image_data.str + sect->foff, sect->fsize);
+    rng1u64_list_push(arena, patch_ranges, rng_1u64(sect->foff, sect->foff + sect->fsize));
+    for EachNode(sc_chunk, LNK_SectionContribChunk, sect->contribs.first) {
+      LNK_ImageFillNode *n = push_array(scratch.arena, LNK_ImageFillNode, 1);
+      n->base_foff = sect->foff;
+      n->sc_count  = sc_chunk->count;
+      n->sc        = sc_chunk->v;
+      SLLStackPush(fill_nodes[fill_node_count % tp->worker_count], n);
+      fill_node_count += 1;
+    }
+  }
+
+  task->u.image_fill.image_data = image_data;
+  task->u.image_fill.fill_nodes = fill_nodes;
+  tp_for_parallel_prof(tp, 0, tp->worker_count, lnk_image_fill_task, task, "Fill");
+
+  scratch_end(scratch);
+  ProfEnd();
+  return image_data;
+}
+
+internal LNK_IncrementalLayout
+lnk_incremental_layout_from_image(Arena *arena, LNK_BuildImageTask *task, LNK_SectionContrib *common_block_sc, U64 image_size)
+{
+  ProfBeginFunction();
+  LNK_IncrementalImage *inc = task->incremental;
+
+  U64 contrib_count = 0;
+  for EachIndex(obj_idx, task->objs_count) {
+    for EachIndex(sect_idx, task->objs[obj_idx]->header.section_count_no_null) {
+      contrib_count += inc->contrib_keys[obj_idx][sect_idx] != 0;
+    }
+  }
+
+  LNK_IncrementalLayout layout = {0};
+  layout.header   = push_array(arena, LNK_IncrementalLayoutHeader, 1);
+  layout.sects    = push_array(arena, LNK_IncrementalSection, task->image_sects.count);
+  layout.objs     = push_array(arena, LNK_IncrementalObj,     task->objs_count);
+  layout.contribs = push_array(arena, LNK_IncrementalContrib, contrib_count);
+  layout.symbols  = push_array(arena, LNK_IncrementalSymbol,  inc->symbol_count);
+
+  layout.header->image_size    = image_size;
+  layout.header->sect_count    = safe_cast_u32(task->image_sects.count);
+  layout.header->obj_count     = safe_cast_u32(task->objs_count);
+  layout.header->contrib_count = safe_cast_u32(contrib_count);
+  layout.header->symbol_count  = safe_cast_u32(inc->symbol_count);
+  if (common_block_sc) {
+    layout.header->common_block_sect_idx = common_block_sc->u.sect_idx;
+    layout.header->common_block_off      = common_block_sc->u.off;
+    layout.header->common_block_size     = safe_cast_u32(lnk_size_from_section_contrib(common_block_sc));
+  }
+
+  for EachIndex(sect_idx, task->image_sects.count) {
+    LNK_Section *sect = task->image_sects.v[sect_idx];
+    layout.sects[sect_idx].name_hash = lnk_incremental_hash_from_section_name(sect->name, sect->flags);
+    layout.sects[sect_idx].voff      = safe_cast_u32(sect->voff);
+    layout.sects[sect_idx].vsize     = safe_cast_u32(sect->vsize);
+    layout.sects[sect_idx].foff      = safe_cast_u32(sect->foff);
+    layout.sects[sect_idx].fsize     = safe_cast_u32(sect->fsize);
+  }
+
+  U64 contrib_cursor = 0;
+  for EachIndex(obj_idx, task->objs_count) {
+    LNK_Obj *obj = task->objs[obj_idx];
+    layout.objs[obj_idx].hash          = inc->obj_hashes[obj_idx];
+    layout.objs[obj_idx].path_hash     = XXH3_64bits(obj->path.str, obj->path.size);
+    layout.objs[obj_idx].first_contrib = safe_cast_u32(contrib_cursor);
+    for EachIndex(sect_idx, obj->header.section_count_no_null) {
+      U64 key = inc->contrib_keys[obj_idx][sect_idx];
+      if (key == 0) { continue; }
+      LNK_SectionContrib     *sc      = task->sect_map[obj_idx][sect_idx];
+      U64                     size    = lnk_size_from_section_contrib(sc);
+      LNK_IncrementalContrib *contrib = &layout.contribs[contrib_cursor++];
+      contrib->key          = key;
+      contrib->obj_sect_idx = safe_cast_u32(sect_idx);
+      contrib->sect_idx     = sc->u.sect_idx;
+      contrib->off          = sc->u.off;
+      contrib->size         = safe_cast_u32(size);
+      contrib->cap          = safe_cast_u32(size + sc->tail_pad);
+    }
+    layout.objs[obj_idx].contrib_count = safe_cast_u32(contrib_cursor - layout.objs[obj_idx].first_contrib);
+  }
+
+  for EachIndex(symbol_idx, inc->symbol_count) {
+    LNK_IncrementalSymbolRef *ref    = &inc->symbols[symbol_idx];
+    COFF_ParsedSymbol         parsed = lnk_parsed_from_symbol(ref->symbol);
+    layout.symbols[symbol_idx] = ref->state;
+    if (coff_interp_from_parsed_symbol(parsed) == COFF_SymbolValueInterp_Regular && parsed.section_number > 0 && parsed.section_number <= task->image_sects.count) {
+      layout.symbols[symbol_idx].value = task->image_sects.v[parsed.section_number-1]->voff + parsed.value;
+    }
+  }
+
+  ProfEnd();
+  return layout;
+}
+
+internal String8List
+lnk_incremental_data_from_layout(Arena *arena, LNK_IncrementalLayout layout)
+{
+  String8List data = {0};
+  str8_list_push(arena, &data, str8_struct(layout.header));
+  str8_list_push(arena, &data, str8_array(layout.sects,    layout.header->sect_count));
+  str8_list_push(arena, &data, str8_array(layout.objs,     layout.header->obj_count));
+  str8_list_push(arena, &data, str8_array(layout.contribs, layout.header->contrib_count));
+  str8_list_push(arena, &data, str8_array(layout.symbols,  layout.header->symbol_count));
+  return data;
+}
+
+internal LNK_ImageContext
+lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs, LNK_IncrementalLayout *incremental_layout)
+{
+  ProfBegin("Image");
+  lnk_timer_begin(LNK_Timer_Image);
+
+  Temp scratch = scratch_begin(arena->v, arena->count);
+
+  //
+  // init section table
+  //
+  LNK_SectionTable *sectab = lnk_section_table_alloc();
+  lnk_section_table_push(sectab, str8_lit(".text" ), PE_TEXT_SECTION_FLAGS );
+  lnk_section_table_push(sectab, str8_lit(".rdata"), PE_RDATA_SECTION_FLAGS);
+  lnk_section_table_push(sectab, str8_lit(".data" ), PE_DATA_SECTION_FLAGS );
+  lnk_section_table_push(sectab, str8_lit(".bss"  ), PE_BSS_SECTION_FLAGS  );
+  lnk_section_table_push(sectab, str8_lit(".pdata"), PE_PDATA_SECTION_FLAGS);
+  LNK_Section *common_block_sect = lnk_section_table_search(sectab, str8_lit(".bss"), PE_BSS_SECTION_FLAGS);
+
+  LNK_BuildImageTask task = {
+    .symtab           = symtab,
+    .sectab           = sectab,
+    .objs_count       = objs_count,
+    .objs             = objs,
+    .function_pad_min = config->function_pad_min,
+    .default_align    = coff_default_align_from_machine(config->machine),
+    .null_sc          = push_array(arena->v[0], LNK_SectionContrib, 1),
+  };
+
+  // patch the previous image when the layout it was built with still fits
+  B32 is_patching = 0;
+  if (config->incremental == LNK_SwitchState_Yes) {
+    task.incremental = lnk_incremental_image_begin(tp, arena->v[0], config, symtab, objs_count, objs, incremental_layout);
+    is_patching      = task.incremental->is_patching;
+  }
+
+  {
+    ProfBegin("Define And Count Sections");
+    TP_Temp temp = tp_temp_begin(arena);
+
+    ProfBegin("Init Hash Tables For Gathering Section Definitions");
+    task.u.gather_sects.defns = push_array(arena->v[0], HashTable *, tp->worker_count);
+    for EachIndex(worker_id, tp->worker_count) { task.u.gather_sects.defns[worker_id] = hash_table_init(arena->v[0], 128); }
+    ProfEnd();
+
+    tp_for_parallel_prof(tp, arena, objs_count, lnk_gather_section_definitions_task, &task, "Gather Section Definitions");
+
+    ProfBegin("Merge Section Definitions Hash Tables");
+    for (U64 worker_idx = 1; worker_idx < tp->worker_count; worker_idx += 1) {
+      U64                     sect_defns_count = task.u.gather_sects.defns[worker_idx]->count;
+      LNK_SectionDefinition **sect_defns       = values_from_hash_table_raw(arena->v[0], task.u.gather_sects.defns[worker_idx]);
+      radsort(sect_defns, sect_defns_count, lnk_section_definition_is_before);
+
+      for EachIndex(defn_idx, sect_defns_count) {
+        LNK_SectionDefinition *defn            = sect_defns[defn_idx];
+        String8                name_with_flags = lnk_make_name_with_flags(arena->v[0], defn->name, defn->flags);
+        LNK_SectionDefinition *main_defn       = hash_table_search_string_raw(task.u.gather_sects.defns[0], name_with_flags);
+        if (main_defn == 0) {
+          main_defn = sect_defns[defn_idx];
+          hash_table_push_string_raw(arena->v[0], task.u.gather_sects.defns[0], name_with_flags, main_defn);
+        } else {
+          if (lnk_section_definition_is_before(&sect_defns[defn_idx], &main_defn)) {
+            main_defn->obj = sect_defns[defn_idx]->obj;
+            main_defn->obj_sect_idx = sect_defns[defn_idx]->obj_sect_idx;
+          }
+          main_defn->contribs_count += sect_defns[defn_idx]->contribs_count;
+        }
+      }
+    }
+    U64                     sect_defns_count = task.u.gather_sects.defns[0]->count;
+    LNK_SectionDefinition **sect_defns       = values_from_hash_table_raw(arena->v[0], task.u.gather_sects.defns[0]);
+    ProfEnd();
+
+    ProfBegin("Sort Sections Definitions");
+    radsort(sect_defns, sect_defns_count, lnk_section_definition_is_before);
+    ProfEnd();
+
+    ProfBegin("Push Sections And Reserve Section Contrib Memory");
+    task.contribs_ht = hash_table_init(sectab->arena, sect_defns_count);
+    for EachIndex(defn_idx, sect_defns_count) {
+      LNK_SectionDefinition *sect_defn = sect_defns[defn_idx];
+
+      // parse section name
+      String8 sect_name, sort_idx;
+      coff_parse_section_name(sect_defn->name, &sect_name, &sort_idx);
+
+      // do not create definitions for sections that are removed from the image
+      if (lnk_is_section_removed(config, sect_name)) { continue; }
+
+      // warn about conflicting section flags
+      for (LNK_SectionNode *sect_n = sectab->list.first; sect_n != 0; sect_n = sect_n->next) {
+        if (str8_match(sect_n->data.name, sect_name, 0) && sect_n->data.flags != sect_defn->flags) {
+          LNK_Obj            *obj                = sect_defn->obj;
+          U32                 sect_number        = sect_defn->obj_sect_idx + 1;
+          COFF_SectionHeader *sect_header        = lnk_coff_section_header_from_section_number(obj, sect_number);
+          String8             sect_name          = coff_name_from_section_header(str8_substr(obj->data, obj->header.string_table_range), sect_header);
+          String8             expected_flags_str = coff_string_from_section_flags(arena->v[0], sect_n->data.flags);
           String8             current_flags_str  = coff_string_from_section_flags(arena->v[0], sect_defn->flags);
           lnk_error_obj(LNK_Warning_SectionFlagsConflict, sect_defn->obj, "detected section flags conflict in %S(No. %X); expected {%S} but got {%S}", sect_name, sect_number, expected_flags_str, current_flags_str);
         }
@@ -4171,8 +5903,11 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
     ProfEnd();
   }
 
-  U64 expected_image_header_size;
+  U64                 expected_image_header_size;
+  LNK_SectionContrib *common_block_sc = 0;
   {
+    task.order_map = lnk_order_map_from_config(tp, scratch.arena, config, symtab, objs_count, objs);
+
     ProfBegin("Alloc Section Map");
     task.sect_map = push_array(scratch.arena, LNK_SectionContrib **, objs_count);
     for EachIndex(obj_idx, objs_count) { task.sect_map[obj_idx] = push_array(scratch.arena, LNK_SectionContrib *, objs[obj_idx]->header.section_count_no_null); }
@@ -4180,6 +5915,10 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
 
     tp_for_parallel_prof(tp, 0, objs_count, lnk_gather_section_contribs_task, &task, "Gather Section Contribs");
 
+    if (task.incremental) {
+      tp_for_parallel_prof(tp, 0, objs_count, lnk_incremental_contrib_keys_task, &task, "Incremental Contrib Keys");
+    }
+
     // ensure determinism by sorting section contribs in chunks by input index
     {
       ProfBegin("Sort Section Contribs");
@@ -4237,11 +5976,10 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
         // sort common blocks from for tighter packing
         radsort(common_block_contribs, common_block_contribs_count, lnk_common_block_contrib_is_before);
 
-        // compute .bss virtual size - this marks start of the common block
-        lnk_finalize_section_layout(common_block_sect, config->file_align, config->function_pad_min);
-        U64 common_block_cursor = common_block_sect->vsize;
-
-        // compute and assign offsets into the common block
+        // compute and assign offsets into the common block, leaders are patched with
+        // the block's offset once the section layout is final
+        U64 common_block_cursor = 0;
+        U64 common_block_align  = 1;
         for EachIndex(contrib_idx, common_block_contribs_count) {
           LNK_CommonBlockContrib *contrib = &common_block_contribs[contrib_idx];
           U32 size  = contrib->u.size;
@@ -4249,16 +5987,17 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
           common_block_cursor = AlignPow2(common_block_cursor, align);
           contrib->u.offset = common_block_cursor;
           common_block_cursor += size;
+          common_block_align   = Max(common_block_align, align);
         }
 
         // append common block's contribution
         LNK_SectionContribChunk *common_block_chunk = lnk_section_contrib_chunk_list_push_chunk(sectab->arena, &common_block_sect->contribs, 1, str8(0,0));
-        LNK_SectionContrib      *common_block_sc    = lnk_section_contrib_chunk_push(common_block_chunk, 1);
+        common_block_sc = lnk_section_contrib_chunk_push(common_block_chunk, 1);
         common_block_sc->u.obj_idx              = max_U32;
         common_block_sc->u.obj_sect_idx         = max_U32;
-        common_block_sc->align                  = 1;
+        common_block_sc->align                  = common_block_align;
         common_block_sc->first_data_node.next   = 0;
-        common_block_sc->first_data_node.string = str8(0, common_block_cursor - common_block_sect->vsize);
+        common_block_sc->first_data_node.string = str8(0, common_block_cursor);
         common_block_sc->last_data_node         = &common_block_sc->first_data_node;
 
         ProfEnd();
@@ -4289,8 +6028,13 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
       }
 
       // assign contribs offsets, sizes, and section indices
-      for (LNK_SectionNode *sect_n = sectab->list.first; sect_n != 0; sect_n = sect_n->next) {
-        lnk_finalize_section_layout(&sect_n->data, config->file_align, config->function_pad_min);
+      if (is_patching) {
+        is_patching = lnk_incremental_pin_layout(config, &task, common_block_sc);
+      }
+      if (!is_patching) {
+        for (LNK_SectionNode *sect_n = sectab->list.first; sect_n != 0; sect_n = sect_n->next) {
+          lnk_finalize_section_layout(&sect_n->data, config->file_align, config->function_pad_min);
+        }
       }
 
       // remove empty sections
@@ -4333,6 +6077,7 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
 
       // set up context for patch tasks
       task.u.patch_symtabs.common_block_sect     = common_block_sect;
+      task.u.patch_symtabs.common_block_sc       = common_block_sc;
       task.u.patch_symtabs.common_block_ranges   = tp_divide_work(temp.arena, common_block_contribs_count, tp->worker_count);
       task.u.patch_symtabs.common_block_contribs = common_block_contribs;
       task.u.patch_symtabs.was_symbol_patched    = push_array(temp.arena, B8 *, objs_count);
@@ -4364,10 +6109,15 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
     for EachIndex(sect_idx, task.image_sects.count) { lnk_assign_section_virtual_space(task.image_sects.v[sect_idx], config->sect_align, &voff_cursor); }
     tp_for_parallel_prof(tp, 0, task.objs_count, lnk_patch_virtual_offsets_and_sizes_in_obj_section_headers_task, &task, "Patch Virtual Offsets and Sizes in Obj Section Headers");
 
+    if (is_patching) {
+      lnk_incremental_flag_dirty_sections(tp, scratch.arena, &task);
+    }
+
     // build base relocs
     if (~config->flags & LNK_ConfigFlag_Fixed) {
-      String8 base_relocs_data = lnk_build_base_relocs(tp, arena, config, objs_count, objs);
-      if (base_relocs_data.size) {
+      String8                 base_relocs_data = lnk_build_base_relocs(tp, arena, config, objs_count, objs);
+      LNK_IncrementalSection *prev_reloc_sect  = is_patching ? lnk_incremental_reloc_section_from_layout(task.incremental->prev) : 0;
+      if (base_relocs_data.size || prev_reloc_sect) {
         LNK_Section             *reloc          = lnk_section_table_push(sectab, str8_lit(".reloc"), PE_RELOC_SECTION_FLAGS);
         LNK_SectionContribChunk *first_sc_chunk = lnk_section_contrib_chunk_list_push_chunk(sectab->arena, &reloc->contribs, 1, str8_zero());
         LNK_SectionContrib      *sc             = lnk_section_contrib_chunk_push(first_sc_chunk, 1);
@@ -4376,6 +6126,11 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
         sc->align                  = 1;
         sc->u.obj_idx              = max_U32;
 
+        // don't shrink .reloc when patching, so blocks from the previous link are cleared
+        if (prev_reloc_sect && prev_reloc_sect->vsize > base_relocs_data.size) {
+          sc->tail_pad = prev_reloc_sect->vsize - base_relocs_data.size;
+        }
+
         lnk_finalize_section_layout(reloc, config->file_align, config->function_pad_min);
         lnk_assign_section_virtual_space(reloc, config->sect_align, &voff_cursor);
         lnk_assign_section_index(reloc, sectab->next_sect_idx++);
@@ -4389,12 +6144,21 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
     U64 foff_cursor = AlignPow2(expected_image_header_size, config->file_align);
     for EachIndex(sect_idx, task.image_sects.count) { lnk_assign_section_file_space(task.image_sects.v[sect_idx], &foff_cursor); }
     tp_for_parallel_prof(tp, 0, task.objs_count, lnk_patch_file_offsets_and_sizes_in_obj_section_headers_task, &task, "Patch File Offsets And Sizes In Section Headers");
+
+    // pinned sections land where they were in the previous image
+    if (is_patching) {
+      for EachIndex(sect_idx, Min(task.image_sects.count, task.incremental->prev->header->sect_count)) {
+        Assert(task.image_sects.v[sect_idx]->voff == task.incremental->prev->sects[sect_idx].voff);
+        Assert(task.image_sects.v[sect_idx]->foff == task.incremental->prev->sects[sect_idx].foff);
+      }
+    }
   }
 
   // build win32 image header
+  LNK_Section *image_header_sect;
   {
     String8List              image_header_data     = lnk_build_win32_header(sectab->arena, symtab, config, task.image_sects, AlignPow2(expected_image_header_size, config->file_align));
-    LNK_Section             *image_header_sect     = lnk_section_table_push(sectab, str8_lit(".rad_linker_image_header_section"), 0);
+    image_header_sect = lnk_section_table_push(sectab, str8_lit(".rad_linker_image_header_section"), 0);
     LNK_SectionContribChunk *image_header_sc_chunk = lnk_section_contrib_chunk_list_push_chunk(sectab->arena, &image_header_sect->contribs, 1, str8_zero());
     LNK_SectionContrib      *image_header_sc       = lnk_section_contrib_chunk_push(image_header_sc_chunk, 1);
     image_header_sc->align           = config->file_align;
@@ -4405,8 +6169,13 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
 
   tp_for_parallel_prof(tp, 0, task.objs_count, lnk_patch_section_symbols_task, &task, "Patch Section Symbols");
 
-  String8 image_data = {0};
-  {
+  String8     image_data   = {0};
+  Rng1U64List patch_ranges = {0};
+  if (is_patching) {
+    ProfBegin("Image Patch Fill");
+    image_data = lnk_incremental_fill_image(tp, arena->v[0], config, &task, image_header_sect, &patch_ranges);
+    ProfEnd();
+  } else {
     ProfBegin("Image Fill");
 
     ProfBeginV("Alloc Image Buffer [%M]", lnk_section_table_total_fsize(sectab));
@@ -4474,7 +6243,8 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
 
     // patch relocs
     {
-      LNK_ObjRelocPatcher task = { .image_data = image_data, .objs = objs, .image_base = pe.image_base, .image_section_table = image_section_table };
+      B8                  **is_sect_dirty = is_patching ? task.incremental->is_sect_dirty : 0;
+      LNK_ObjRelocPatcher   task          = { .image_data = image_data, .objs = objs, .image_base = pe.image_base, .image_section_table = image_section_table, .is_sect_dirty = is_sect_dirty };
       tp_for_parallel_prof(tp, 0, objs_count, lnk_obj_reloc_patcher, &task, "Patch Relocs");
     }
 
@@ -4502,6 +6272,9 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
       if (pdata_sect) {
         String8 raw_pdata = str8_substr(image_data, rng_1u64(pdata_sect->foff, pdata_sect->foff + pdata_sect->vsize));
         pe_pdata_sort(config->machine, raw_pdata);
+        if (is_patching) {
+          rng1u64_list_push(arena->v[0], &patch_ranges, rng_1u64(pdata_sect->foff, pdata_sect->foff + pdata_sect->vsize));
+        }
 
         PE_DataDirectory *pdata_dir = pe_data_directory_from_idx(image_data, pe, PE_DataDirectoryIndex_EXCEPTIONS);
         pdata_dir->virt_off  = lnk_get_first_section_contrib_voff(image_section_table, pdata_sect);
@@ -4668,12 +6441,18 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
         U64   cv_guid_foff = lnk_foff_from_symbol(image_section_table, guid_pdb_symbol);
         Guid *cv_guid  = str8_deserial_get_raw_ptr(image_data, cv_guid_foff, sizeof(*cv_guid));
         *cv_guid = config->guid;
+        if (is_patching) {
+          rng1u64_list_push(arena->v[0], &patch_ranges, rng_1u64(cv_guid_foff, cv_guid_foff + sizeof(*cv_guid)));
+        }
       }
 
       if (guid_rdi_symbol) {
         U64   cv_guid_foff = lnk_foff_from_symbol(image_section_table, guid_rdi_symbol);
         Guid *cv_guid  = str8_deserial_get_raw_ptr(image_data, cv_guid_foff, sizeof(*cv_guid));
         *cv_guid = config->guid;
+        if (is_patching) {
+          rng1u64_list_push(arena->v[0], &patch_ranges, rng_1u64(cv_guid_foff, cv_guid_foff + sizeof(*cv_guid)));
+        }
       }
     }
     
@@ -4684,6 +6463,33 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
   image_ctx.image_data       = image_data;
   image_ctx.sectab           = sectab;
 
+  if (task.incremental) {
+    ProfBegin("Incremental Layout");
+    LNK_IncrementalLayout layout = lnk_incremental_layout_from_image(arena->v[0], &task, common_block_sc, image_data.size);
+    image_ctx.incremental_layout = lnk_incremental_data_from_layout(arena->v[0], layout);
+
+    if (is_patching) {
+      image_ctx.patch_ranges = lnk_incremental_merge_ranges(arena->v[0], patch_ranges);
+
+      U64 dirty_sect_count = 0;
+      for EachIndex(obj_idx, objs_count) {
+        for EachIndex(sect_idx, objs[obj_idx]->header.section_count_no_null) {
+          dirty_sect_count += task.incremental->is_sect_dirty[obj_idx][sect_idx];
+        }
+      }
+      U64 moved_symbol_count = 0;
+      for EachIndex(symbol_idx, layout.header->symbol_count) {
+        moved_symbol_count += layout.symbols[symbol_idx].value != task.incremental->prev->symbols[symbol_idx].value;
+      }
+      U64 patch_size = 0;
+      for EachIndex(range_idx, image_ctx.patch_ranges.count) { patch_size += dim_1u64(image_ctx.patch_ranges.v[range_idx]); }
+
+      lnk_log(LNK_Log_Incremental, "Incremental: patched %llu changed objs, relocated %llu sections, %llu symbols moved, %M of %M written",
+              task.incremental->changed_obj_count, dirty_sect_count, moved_symbol_count, patch_size, image_data.size);
+    }
+    ProfEnd();
+  }
+
   lnk_timer_end(LNK_Timer_Image);
   ProfEnd(); // :EndImage
   scratch_end(scratch);
@@ -4909,15 +6715,507 @@ lnk_build_rad_map(Arena *arena, String8 image_data, LNK_Config *config, U64 objs
   return map;
 }
 
+internal U32
+lnk_map_isect_from_voff(U64 section_count, COFF_SectionHeader **section_table, U64 voff)
+{
+  // find first section that ends past the virtual offset
+  U64 l = 1, r = section_count + 1;
+  for (; l < r; ) {
+    U64 m = l + (r - l) / 2;
+    if ((U64)section_table[m]->voff + section_table[m]->vsize <= voff) {
+      l = m + 1;
+    } else {
+      r = m;
+    }
+  }
+
+  U32 isect = 0;
+  if (l <= section_count && section_table[l]->voff <= voff) {
+    isect = safe_cast_u32(l);
+  }
+  return isect;
+}
+
+internal int
+lnk_map_entry_is_before(void *raw_a, void *raw_b)
+{
+  LNK_MapEntry *a = raw_a, *b = raw_b;
+  if (a->off != b->off) {
+    return a->off < b->off;
+  }
+  if (a->obj_idx != b->obj_idx) {
+    return a->obj_idx < b->obj_idx;
+  }
+  return a->idx < b->idx;
+}
+
+internal int
+lnk_map_entry_isect_is_before(void *raw_a, void *raw_b)
+{
+  LNK_MapEntry *a = raw_a, *b = raw_b;
+  if (a->isect != b->isect) {
+    return a->isect < b->isect;
+  }
+  return lnk_map_entry_is_before(a, b);
+}
+
+internal B32
+lnk_map_is_static_function(LNK_MapTask *task, LNK_Obj *obj, LNK_MapEntryArray contribs, COFF_ParsedSymbol symbol)
+{
+  if (symbol.storage_class != COFF_SymStorageClass_Static)                        { return 0; }
+  if (!COFF_SymbolType_IsFunc(symbol.type))                                       { return 0; }
+  if (coff_interp_from_parsed_symbol(symbol) != COFF_SymbolValueInterp_Regular)   { return 0; }
+  if (symbol.section_number == lnk_obj_get_removed_section_number(obj))           { return 0; }
+  if (symbol.section_number > task->image_section_count)                          { return 0; }
+
+  // resolved external references are patched to static symbols as well,
+  // so check that symbol is defined in one of the obj's own contributions
+  U64 l = 0, r = contribs.count;
+  for (; l < r; ) {
+    U64 m = l + (r - l) / 2;
+    if (contribs.v[m].isect < symbol.section_number || (contribs.v[m].isect == symbol.section_number && contribs.v[m].off <= symbol.value)) {
+      l = m + 1;
+    } else {
+      r = m;
+    }
+  }
+  if (l == 0) { return 0; }
+
+  LNK_MapEntry       *contrib        = &contribs.v[l-1];
+  COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, contrib->idx+1);
+  return contrib->isect == symbol.section_number && symbol.value - contrib->off < section_header->vsize;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_map_gather_obj_task)
+{
+  LNK_MapTask        *task          = raw_task;
+  U64                 obj_idx       = task_id;
+  LNK_Obj            *obj           = task->objs[obj_idx];
+  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(obj->data, obj->header.section_table_range).str;
+  String8             string_table  = str8_substr(obj->data, obj->header.string_table_range);
+
+  ProfBeginV("Gather Map Entries [%S]", obj->path);
+
+  // name of the obj in the map
+  LNK_Lib *lib = lnk_obj_get_lib(obj);
+  if (lib) {
+    String8 lib_name = str8_chop_last_dot(str8_skip_last_slash(lib->path));
+    String8 obj_name = str8_skip_last_slash(obj->path);
+    task->obj_names[obj_idx] = push_str8f(arena, "%S:%S", lib_name, obj_name);
+  } else {
+    task->obj_names[obj_idx] = str8_skip_last_slash(obj->path);
+  }
+
+  // contributions, section headers were patched with image offsets during layout
+  LNK_MapEntryArray *contribs = &task->u.gather.contribs[obj_idx];
+  contribs->v = push_array_no_zero(arena, LNK_MapEntry, obj->header.section_count_no_null);
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    COFF_SectionHeader *section_header = &section_table[sect_idx];
+    if (section_header->flags & (COFF_SectionFlag_LnkRemove|COFF_SectionFlag_LnkInfo|LNK_SECTION_FLAG_DEBUG)) { continue; }
+    if (section_header->fsize == 0)                                                                          { continue; }
+
+    String8 full_section_name = coff_name_from_section_header(string_table, section_header);
+    String8 section_name, section_postfix;
+    coff_parse_section_name(full_section_name, &section_name, &section_postfix);
+    if (lnk_is_section_removed(task->config, section_name)) { continue; }
+
+    U32 isect = lnk_map_isect_from_voff(task->image_section_count, task->image_section_table, section_header->voff);
+    if (isect == 0) { continue; }
+
+    LNK_MapEntry *entry = &contribs->v[contribs->count++];
+    entry->isect   = isect;
+    entry->off     = section_header->voff - task->image_section_table[isect]->voff;
+    entry->obj_idx = obj_idx;
+    entry->idx     = sect_idx;
+  }
+  arena_pop(arena, (obj->header.section_count_no_null - contribs->count) * sizeof(contribs->v[0]));
+  radsort(contribs->v, contribs->count, lnk_map_entry_isect_is_before);
+
+  // static functions
+  {
+    U64 statics_count = 0;
+    COFF_ParsedSymbol symbol;
+    for (U64 symbol_idx = 0; symbol_idx < obj->header.symbol_count; symbol_idx += (1 + symbol.aux_symbol_count)) {
+      symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, symbol_idx);
+      statics_count += lnk_map_is_static_function(task, obj, *contribs, symbol);
+    }
+
+    LNK_MapEntryArray *statics = &task->u.gather.statics[obj_idx];
+    statics->v = push_array_no_zero(arena, LNK_MapEntry, statics_count);
+    for (U64 symbol_idx = 0; symbol_idx < obj->header.symbol_count && statics->count < statics_count; symbol_idx += (1 + symbol.aux_symbol_count)) {
+      symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, symbol_idx);
+      if (lnk_map_is_static_function(task, obj, *contribs, symbol)) {
+        LNK_MapEntry *entry = &statics->v[statics->count++];
+        entry->isect   = symbol.section_number;
+        entry->off     = symbol.value;
+        entry->obj_idx = obj_idx;
+        entry->idx     = symbol_idx;
+      }
+    }
+  }
+
+  ProfEnd();
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_map_gather_publics_task)
+{
+  ProfBeginFunction();
+
+  LNK_MapTask                 *task       = raw_task;
+  LNK_SymbolHashTrieChunkList  chunk_list = task->symtab->chunks[task_id];
+
+  U64 max_publics = 0;
+  for (LNK_SymbolHashTrieChunk *chunk = chunk_list.first; chunk != 0; chunk = chunk->next) {
+    max_publics += chunk->count;
+  }
+
+  LNK_MapEntryArray *publics = &task->u.gather.publics[task_id];
+  publics->v = push_array_no_zero(arena, LNK_MapEntry, max_publics);
+  for (LNK_SymbolHashTrieChunk *chunk = chunk_list.first; chunk != 0; chunk = chunk->next) {
+    for EachIndex(i, chunk->count) {
+      LNK_Symbol       *symbol        = chunk->v[i].symbol;
+      LNK_ObjSymbolRef  symbol_ref    = lnk_ref_from_symbol(symbol);
+      COFF_ParsedSymbol symbol_parsed = lnk_parsed_from_symbol(symbol);
+
+      if (symbol_parsed.section_number == lnk_obj_get_removed_section_number(symbol_ref.obj)) { continue; }
+
+      COFF_SymbolValueInterpType symbol_interp = coff_interp_from_parsed_symbol(symbol_parsed);
+      if (symbol_interp != COFF_SymbolValueInterp_Regular)          { continue; }
+      if (symbol_parsed.section_number > task->image_section_count) { continue; }
+
+      LNK_MapEntry *entry = &publics->v[publics->count++];
+      entry->isect   = symbol_parsed.section_number;
+      entry->off     = symbol_parsed.value;
+      entry->obj_idx = symbol_ref.obj->input_idx;
+      entry->idx     = symbol_ref.symbol_idx;
+    }
+  }
+  arena_pop(arena, (max_publics - publics->count) * sizeof(publics->v[0]));
+
+  ProfEnd();
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_map_sort_bucket_task)
+{
+  LNK_MapTask       *task   = raw_task;
+  LNK_MapEntryArray  bucket = task->u.sort.buckets[task_id];
+  ProfBeginV("Sort Map Entries [%llu]", bucket.count);
+  radsort(bucket.v, bucket.count, lnk_map_entry_is_before);
+  ProfEnd();
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_map_format_block_task)
+{
+  LNK_MapTask       *task  = raw_task;
+  LNK_MapEntryArray  block = task->u.format.blocks[task_id];
+
+  Temp scratch = scratch_begin(&arena, 1);
+  String8List lines = {0};
+
+  for EachIndex(entry_idx, block.count) {
+    LNK_MapEntry *entry    = &block.v[entry_idx];
+    LNK_Obj      *obj      = task->objs[entry->obj_idx];
+    String8       obj_name = task->obj_names[entry->obj_idx];
+
+    switch (task->u.format.type) {
+    case LNK_MapEntry_Contrib: {
+      COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, entry->idx+1);
+      String8             string_table   = str8_substr(obj->data, obj->header.string_table_range);
+      String8             section_name   = coff_name_from_section_header(string_table, section_header);
+      char               *section_class  = (section_header->flags & COFF_SectionFlag_CntCode) ? "CODE" : "DATA";
+      str8_list_pushf(scratch.arena, &lines, " %04x:%08x %08xH %-23S %-4s %S\n", entry->isect, entry->off, section_header->vsize, section_name, section_class, obj_name);
+    } break;
+    case LNK_MapEntry_Public:
+    case LNK_MapEntry_Static: {
+      COFF_ParsedSymbol symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, entry->idx);
+      U64               va     = task->image_base + task->image_section_table[entry->isect]->voff + entry->off;
+      char              flag   = COFF_SymbolType_IsFunc(symbol.type) ? 'f' : ' ';
+      str8_list_pushf(scratch.arena, &lines, " %04x:%08x       %-26S %016llx %c   %S\n", entry->isect, entry->off, symbol.name, va, flag, obj_name);
+    } break;
+    default: { InvalidPath; } break;
+    }
+  }
+
+  // join lines so the writer issues one write per block
+  task->u.format.output[task_id] = str8_list_join(arena, &lines, 0);
+
+  scratch_end(scratch);
+}
+
+internal LNK_MapEntryArray *
+lnk_map_bucket_entries(Arena *arena, U64 arrays_count, LNK_MapEntryArray *arrays, U64 bucket_count)
+{
+  ProfBeginFunction();
+
+  LNK_MapEntryArray *buckets = push_array(arena, LNK_MapEntryArray, bucket_count);
+  for EachIndex(array_idx, arrays_count) {
+    for EachIndex(entry_idx, arrays[array_idx].count) {
+      buckets[arrays[array_idx].v[entry_idx].isect].count += 1;
+    }
+  }
+  for EachIndex(bucket_idx, bucket_count) {
+    buckets[bucket_idx].v     = push_array_no_zero(arena, LNK_MapEntry, buckets[bucket_idx].count);
+    buckets[bucket_idx].count = 0;
+  }
+  for EachIndex(array_idx, arrays_count) {
+    for EachIndex(entry_idx, arrays[array_idx].count) {
+      LNK_MapEntry      *entry  = &arrays[array_idx].v[entry_idx];
+      LNK_MapEntryArray *bucket = &buckets[entry->isect];
+      bucket->v[bucket->count++] = *entry;
+    }
+  }
+
+  ProfEnd();
+  return buckets;
+}
+
+internal void
+lnk_map_write_blocks(TP_Context *tp, TP_Arena *arena, LNK_FileWriter *writer, LNK_MapTask *task, U64 block_count)
+{
+  ProfBeginV("Format And Write Map Blocks [%llu]", block_count);
+  Temp scratch = scratch_begin(arena->v, arena->count);
+
+  Temp *temps = push_array_no_zero(scratch.arena, Temp, arena->count);
+  for EachIndex(arena_idx, arena->count) {
+    temps[arena_idx] = temp_begin(arena->v[arena_idx]);
+  }
+
+  tp_for_parallel(tp, arena, block_count, lnk_map_format_block_task, task);
+  for EachIndex(block_idx, block_count) {
+    lnk_file_writer_push(writer, task->u.format.output[block_idx]);
+  }
+
+  for (U64 arena_idx = arena->count; arena_idx > 0; arena_idx -= 1) {
+    temp_end(temps[arena_idx-1]);
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal void
+lnk_map_write_entries(TP_Context *tp, TP_Arena *arena, LNK_FileWriter *writer, LNK_MapTask *task, LNK_MapEntryType type, U64 bucket_count, LNK_MapEntryArray *buckets)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(arena->v, arena->count);
+
+  // format a fixed number of blocks at a time and flush them to disk, this way
+  // memory usage is bounded by the batch size and not by the size of the map
+  U64 max_blocks = tp->worker_count * LNK_MAP_BLOCKS_PER_WORKER;
+  task->u.format.type   = type;
+  task->u.format.blocks = push_array(scratch.arena, LNK_MapEntryArray, max_blocks);
+  task->u.format.output = push_array(scratch.arena, String8, max_blocks);
+
+  U64 block_count = 0;
+  for EachIndex(bucket_idx, bucket_count) {
+    LNK_MapEntryArray bucket = buckets[bucket_idx];
+    for (U64 entry_idx = 0; entry_idx < bucket.count; ) {
+      U64 count = Min(LNK_MAP_ENTRIES_PER_BLOCK, bucket.count - entry_idx);
+      task->u.format.blocks[block_count].count = count;
+      task->u.format.blocks[block_count].v     = bucket.v + entry_idx;
+      block_count += 1;
+      entry_idx   += count;
+
+      if (block_count == max_blocks) {
+        lnk_map_write_blocks(tp, arena, writer, task, block_count);
+        block_count = 0;
+      }
+    }
+  }
+  lnk_map_write_blocks(tp, arena, writer, task, block_count);
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal void
+lnk_build_and_write_map(TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, String8 image_data, U64 objs_count, LNK_Obj **objs)
+{
+  ProfBeginFunction();
+  lnk_timer_begin(LNK_Timer_Map);
+
+  Temp      scratch      = scratch_begin(0,0);
+  TP_Arena *gather_arena = tp_arena_alloc(tp);
+  TP_Arena *format_arena = tp_arena_alloc(tp);
+
+  PE_BinInfo           pe                  = pe_bin_info_from_data(scratch.arena, image_data);
+  COFF_SectionHeader **image_section_table = coff_section_table_from_data(scratch.arena, image_data, pe.section_table_range);
+  U64                  bucket_count        = pe.section_count + 1;
+
+  LNK_MapTask task = {0};
+  task.config              = config;
+  task.symtab              = symtab;
+  task.objs                = objs;
+  task.obj_names           = push_array(scratch.arena, String8, objs_count);
+  task.image_base          = pe.image_base;
+  task.image_section_count = pe.section_count;
+  task.image_section_table = image_section_table;
+
+  // gather contributions and symbols in parallel
+  U64 publics_lists_count = symtab->arena->count;
+  task.u.gather.contribs = push_array(scratch.arena, LNK_MapEntryArray, objs_count);
+  task.u.gather.statics  = push_array(scratch.arena, LNK_MapEntryArray, objs_count);
+  task.u.gather.publics  = push_array(scratch.arena, LNK_MapEntryArray, publics_lists_count);
+  tp_for_parallel(tp, gather_arena, objs_count, lnk_map_gather_obj_task, &task);
+  tp_for_parallel(tp, gather_arena, publics_lists_count, lnk_map_gather_publics_task, &task);
+
+  // bucket entries by image section and sort each bucket in parallel
+  LNK_MapEntryArray *buckets[LNK_MapEntry_Count];
+  buckets[LNK_MapEntry_Contrib] = lnk_map_bucket_entries(scratch.arena, objs_count,          task.u.gather.contribs, bucket_count);
+  buckets[LNK_MapEntry_Public]  = lnk_map_bucket_entries(scratch.arena, publics_lists_count, task.u.gather.publics,  bucket_count);
+  buckets[LNK_MapEntry_Static]  = lnk_map_bucket_entries(scratch.arena, objs_count,          task.u.gather.statics,  bucket_count);
+  for EachIndex(type, LNK_MapEntry_Count) {
+    task.u.sort.buckets = buckets[type];
+    tp_for_parallel(tp, 0, bucket_count, lnk_map_sort_bucket_task, &task);
+  }
+
+  LNK_FileWriter writer = lnk_file_writer_open(config->map_name, config->temp_map_name, 0);
+
+  // header
+  {
+    Temp temp = temp_begin(scratch.arena);
+    String8List header = {0};
+    str8_list_pushf(temp.arena, &header, " %S\n\n", str8_chop_last_dot(str8_skip_last_slash(config->image_name)));
+    str8_list_pushf(temp.arena, &header, " Timestamp is %08x\n\n", config->time_stamp);
+    str8_list_pushf(temp.arena, &header, " Preferred load address is %016llx\n\n", pe.image_base);
+    str8_list_pushf(temp.arena, &header, " Start         Length     Name                    Class Lib:Object\n");
+    lnk_file_writer_push_list(&writer, header);
+    temp_end(temp);
+  }
+  lnk_map_write_entries(tp, format_arena, &writer, &task, LNK_MapEntry_Contrib, bucket_count, buckets[LNK_MapEntry_Contrib]);
+
+  lnk_file_writer_push(&writer, str8_lit("\n  Address         Publics by Value              Rva+Base               Lib:Object\n\n"));
+  lnk_map_write_entries(tp, format_arena, &writer, &task, LNK_MapEntry_Public, bucket_count, buckets[LNK_MapEntry_Public]);
+
+  // entry point
+  if (pe.entry_point) {
+    U32     entry_isect = lnk_map_isect_from_voff(pe.section_count, image_section_table, pe.entry_point);
+    U64     entry_off   = entry_isect ? pe.entry_point - image_section_table[entry_isect]->voff : pe.entry_point;
+    String8 entry_str   = push_str8f(scratch.arena, "\n entry point at        %04x:%08llx\n", entry_isect, entry_off);
+    lnk_file_writer_push(&writer, entry_str);
+  }
+
+  lnk_file_writer_push(&writer, str8_lit("\n Static symbols\n\n"));
+  lnk_map_write_entries(tp, format_arena, &writer, &task, LNK_MapEntry_Static, bucket_count, buckets[LNK_MapEntry_Static]);
+
+  // :MapInfo
+  if (config->map_info & LNK_MapInfo_Exports) {
+    Temp temp = temp_begin(scratch.arena);
+    String8List exports_list = {0};
+    str8_list_pushf(temp.arena, &exports_list, "\n Exports\n\n  ordinal    name\n\n");
+    if (pe.data_dir_count > PE_DataDirectoryIndex_EXPORT) {
+      COFF_SectionHeader   *section_table = (COFF_SectionHeader *)str8_substr(image_data, pe.section_table_range).str;
+      PE_ParsedExportTable  export_table  = pe_exports_from_data(temp.arena, pe.section_count, section_table, image_data, pe.data_dir_franges[PE_DataDirectoryIndex_EXPORT], pe.data_dir_vranges[PE_DataDirectoryIndex_EXPORT]);
+      for EachIndex(export_idx, export_table.export_count) {
+        PE_ParsedExport *exp = &export_table.exports[export_idx];
+        if (exp->forwarder.size) {
+          str8_list_pushf(temp.arena, &exports_list, " %9llu    %S (forwarded to %S)\n", exp->ordinal, exp->name, exp->forwarder);
+        } else {
+          str8_list_pushf(temp.arena, &exports_list, " %9llu    %S\n", exp->ordinal, exp->name);
+        }
+      }
+    }
+    lnk_file_writer_push_list(&writer, exports_list);
+    temp_end(temp);
+  }
+
+  lnk_file_writer_close(&writer);
+
+  tp_arena_release(&format_arena);
+  tp_arena_release(&gather_arena);
+  scratch_end(scratch);
+
+  lnk_timer_end(LNK_Timer_Map);
+  ProfEnd();
+}
+
 internal void
 lnk_write_thread(void *raw_ctx)
 {
   ProfBeginFunction();
   LNK_WriteThreadContext *ctx = raw_ctx;
-  lnk_write_data_to_file_path(ctx->path, ctx->temp_path, ctx->data);
+  if (ctx->patch_ranges.count) {
+    lnk_write_data_ranges_to_file_path(ctx->path, ctx->data, ctx->patch_ranges);
+  } else {
+    lnk_write_data_to_file_path(ctx->path, ctx->temp_path, ctx->data);
+  }
+  ProfEnd();
+}
+
+internal void
+lnk_build_and_write_rdi(LNK_DebugInfoBuildContext *ctx)
+{
+  ProfBeginFunction();
+  lnk_timer_begin(LNK_Timer_Rdi);
+
+  LNK_Config        *config = ctx->config;
+  LNK_CodeViewInput *input  = ctx->input;
+
+  String8List rdi_data = lnk_build_rad_debug_info(ctx->tp,
+                                                  ctx->arena,
+                                                  config->target_os,
+                                                  rdi_arch_from_coff_machine(config->machine),
+                                                  config->image_name,
+                                                  ctx->image_data,
+                                                  input->count,
+                                                  input->obj_arr,
+                                                  input->debug_s_arr,
+                                                  input->total_symbol_input_count,
+                                                  input->symbol_inputs,
+                                                  input->parsed_symbols,
+                                                  ctx->types);
+
+  lnk_write_data_list_to_file_path(config->rad_debug_name, config->temp_rad_debug_name, rdi_data);
+
+  lnk_timer_end(LNK_Timer_Rdi);
+  ProfEnd();
+}
+
+internal void
+lnk_build_and_write_pdb(LNK_DebugInfoBuildContext *ctx)
+{
+  ProfBeginFunction();
+  lnk_timer_begin(LNK_Timer_Pdb);
+
+  LNK_Config        *config = ctx->config;
+  LNK_CodeViewInput *input  = ctx->input;
+
+  CV_DebugT types[CV_TypeIndexSource_COUNT];
+  MemoryCopy(types, ctx->types, sizeof(types));
+  if (config->pdb_hash_type_names != LNK_TypeNameHashMode_Null && config->pdb_hash_type_names != LNK_TypeNameHashMode_None) {
+    types[CV_TypeIndexSource_TPI] = lnk_replace_type_names_with_hashes(ctx->tp, ctx->arena, types[CV_TypeIndexSource_TPI], config->pdb_hash_type_names, config->pdb_hash_type_name_length, config->pdb_hash_type_name_map, ctx->is_concurrent || ctx->types_are_read_only);
+  }
+
+  String8List pdb_data = lnk_build_pdb(ctx->tp,
+                                       ctx->arena,
+                                       ctx->image_data,
+                                       config,
+                                       ctx->symtab,
+                                       input->count,
+                                       input->obj_arr,
+                                       input->debug_s_arr,
+                                       input->total_symbol_input_count,
+                                       input->symbol_inputs,
+                                       input->parsed_symbols,
+                                       types,
+                                       ctx->is_concurrent);
+
+  lnk_write_data_list_to_file_path(config->pdb_name, config->temp_pdb_name, pdb_data);
+
+  lnk_timer_end(LNK_Timer_Pdb);
   ProfEnd();
 }
 
+internal void
+lnk_build_pdb_thread(void *raw_ctx)
+{
+  lnk_build_and_write_pdb(raw_ctx);
+}
+
 internal void
 lnk_log_timers(void)
 {
@@ -4952,7 +7250,7 @@ lnk_log_timers(void)
 }
 
 internal void
-lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
+lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_IncrementalLayout *incremental_layout)
 {
   ProfBeginFunction();
 
@@ -4962,12 +7260,30 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   // Input Context
   //
   LNK_Inputer *inputer = lnk_inputer_init();
+  inputer->stamp_inputs = config->incremental == LNK_SwitchState_Yes;
+  inputer->hash_inputs  = config->incremental == LNK_SwitchState_Yes || (config->type_db == LNK_SwitchState_Yes && lnk_do_debug_info(config));
+
+  // stamp inputs that bypass the inputer before the link reads any of them
+  String8Array    incremental_extra_paths = {0};
+  FileProperties *incremental_extra_props = 0;
+  if (config->incremental == LNK_SwitchState_Yes) {
+    incremental_extra_paths = lnk_incremental_extra_input_paths(scratch.arena, config);
+    incremental_extra_props = lnk_incremental_props_from_paths(scratch.arena, incremental_extra_paths);
+  }
 
   //
   // Symbol Table
   //
   LNK_SymbolTable *symtab = lnk_symbol_table_init(arena);
 
+  //
+  // Type Database
+  //
+  LNK_TypeDB *type_db = 0;
+  if (config->type_db == LNK_SwitchState_Yes && lnk_do_debug_info(config)) {
+    type_db = lnk_type_db_open(scratch.arena, config->type_db_name);
+  }
+
   //
   // Link Image
   //
@@ -4981,13 +7297,14 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   //
   // Layout Image
   //
-  LNK_ImageContext image_ctx = lnk_build_image(arena, tp, config, symtab, objs_count, objs);
+  LNK_ImageContext image_ctx = lnk_build_image(arena, tp, config, symtab, objs_count, objs, incremental_layout);
 
-  // Write image in the background
+  // Write image in the background, a patched image only writes the ranges that changed
   LNK_WriteThreadContext *image_write_ctx = push_array(scratch.arena, LNK_WriteThreadContext, 1);
-  image_write_ctx->path      = config->image_name;
-  image_write_ctx->temp_path = config->temp_image_name;
-  image_write_ctx->data      = image_ctx.image_data;
+  image_write_ctx->path         = config->image_name;
+  image_write_ctx->temp_path    = config->temp_image_name;
+  image_write_ctx->data         = image_ctx.image_data;
+  image_write_ctx->patch_ranges = image_ctx.patch_ranges;
   Thread image_write_thread = thread_launch(lnk_write_thread, image_write_ctx);
 
   //
@@ -4998,6 +7315,13 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
     lnk_write_data_list_to_file_path(config->rad_chunk_map_name, config->temp_rad_chunk_map_name, rad_map);
   }
 
+  //
+  // Map
+  //
+  if (config->map == LNK_SwitchState_Yes) {
+    lnk_build_and_write_map(tp, config, symtab, image_ctx.image_data, objs_count, objs);
+  }
+
   //
   // Import Library
   //
@@ -5030,60 +7354,55 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
     // CodeView
     //
     LNK_CodeViewInput input = lnk_make_code_view_input(tp, arena, config->io_flags, config->lib_dir_list, config->alt_pch_dirs, debug_info_objs_count, debug_info_objs);
-    CV_DebugT        *types = lnk_import_types(tp, arena, &input);
-
-    //
-    // RDI
-    //
-    if (config->rad_debug == LNK_SwitchState_Yes) {
-      lnk_timer_begin(LNK_Timer_Rdi);
-
-      String8List rdi_data = lnk_build_rad_debug_info(tp,
-                                                      arena,
-                                                      config->target_os,
-                                                      rdi_arch_from_coff_machine(config->machine),
-                                                      config->image_name,
-                                                      image_ctx.image_data,
-                                                      input.count,
-                                                      input.obj_arr,
-                                                      input.debug_s_arr,
-                                                      input.total_symbol_input_count,
-                                                      input.symbol_inputs,
-                                                      input.parsed_symbols,
-                                                      types);
-
-      lnk_write_data_list_to_file_path(config->rad_debug_name, config->temp_rad_debug_name, rdi_data);
-
-      lnk_timer_end(LNK_Timer_Rdi);
-    }
-
-    //
-    // PDB
-    //
-    // TODO: Parallel debug info builds are currently blocked by the patch
-    // strings in $$FILE_CHECKSUM step in `lnk_process_c13_data_task`.
-    if (config->debug_mode == LNK_DebugMode_Full) {
-      lnk_timer_begin(LNK_Timer_Pdb);
-
-      if (config->pdb_hash_type_names != LNK_TypeNameHashMode_Null && config->pdb_hash_type_names != LNK_TypeNameHashMode_None) {
-        lnk_replace_type_names_with_hashes(tp, arena, types[CV_TypeIndexSource_TPI], config->pdb_hash_type_names, config->pdb_hash_type_name_length, config->pdb_hash_type_name_map);
+    CV_DebugT        *types = lnk_import_types(tp, arena, &input, type_db);
+
+    LNK_DebugInfoBuildContext debug_info_ctx = {0};
+    debug_info_ctx.tp                        = tp;
+    debug_info_ctx.arena                     = arena;
+    debug_info_ctx.config                    = config;
+    debug_info_ctx.symtab                    = symtab;
+    debug_info_ctx.image_data                = image_ctx.image_data;
+    debug_info_ctx.input                     = &input;
+    debug_info_ctx.types                     = types;
+    debug_info_ctx.types_are_read_only       = type_db != 0;
+
+    B32 build_rdi = config->rad_debug == LNK_SwitchState_Yes;
+    B32 build_pdb = config->debug_mode == LNK_DebugMode_Full;
+
+    // builders don't mutate shared inputs, so when both are requested split workers
+    // between them and let each write its file while the other one is still building
+    // (shared pool is skipped to stay within the worker budget of the other processes)
+    if (build_rdi && build_pdb && tp->worker_count > 1 && config->shared_thread_pool_name.size == 0) {
+      U32 rdi_worker_count = tp->worker_count / 2;
+      U32 pdb_worker_count = tp->worker_count - rdi_worker_count;
+
+      LNK_DebugInfoBuildContext *rdi_ctx = push_array(scratch.arena, LNK_DebugInfoBuildContext, 1);
+      *rdi_ctx               = debug_info_ctx;
+      rdi_ctx->tp            = tp_alloc(scratch.arena, rdi_worker_count, rdi_worker_count, str8_zero());
+      rdi_ctx->arena         = tp_arena_alloc(rdi_ctx->tp);
+      rdi_ctx->is_concurrent = 1;
+
+      LNK_DebugInfoBuildContext *pdb_ctx = push_array(scratch.arena, LNK_DebugInfoBuildContext, 1);
+      *pdb_ctx               = debug_info_ctx;
+      pdb_ctx->tp            = tp_alloc(scratch.arena, pdb_worker_count, pdb_worker_count, str8_zero());
+      pdb_ctx->arena         = tp_arena_alloc(pdb_ctx->tp);
+      pdb_ctx->is_concurrent = 1;
+
+      Thread pdb_thread = thread_launch(lnk_build_pdb_thread, pdb_ctx);
+      lnk_build_and_write_rdi(rdi_ctx);
+      thread_join(pdb_thread, -1);
+
+      tp_arena_release(&rdi_ctx->arena);
+      tp_arena_release(&pdb_ctx->arena);
+      tp_release(rdi_ctx->tp);
+      tp_release(pdb_ctx->tp);
+    } else {
+      if (build_rdi) {
+        lnk_build_and_write_rdi(&debug_info_ctx);
+      }
+      if (build_pdb) {
+        lnk_build_and_write_pdb(&debug_info_ctx);
       }
-
-      String8List pdb_data = lnk_build_pdb(tp,
-                                           arena,
-                                           image_ctx.image_data,
-                                           config,
-                                           symtab,
-                                           input.count,
-                                           input.obj_arr,
-                                           input.debug_s_arr,
-                                           input.total_symbol_input_count,
-                                           input.symbol_inputs,
-                                           input.parsed_symbols,
-                                           types);
-
-      lnk_write_data_list_to_file_path(config->pdb_name, config->temp_pdb_name, pdb_data);
-      lnk_timer_end(LNK_Timer_Pdb);
     }
 
     lnk_timer_end(LNK_Timer_Debug);
@@ -5093,6 +7412,20 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   // wait for the thread to finish writing image to disk
   thread_join(image_write_thread, -1);
 
+  //
+  // Update leaf hashes and merged types for the next link
+  //
+  if (type_db) {
+    lnk_type_db_write(type_db, config->temp_type_db_name);
+  }
+
+  //
+  // Record inputs and outputs for the next incremental link
+  //
+  if (config->incremental == LNK_SwitchState_Yes) {
+    lnk_incremental_write_state(tp, config, inputer, incremental_extra_paths, incremental_extra_props, image_ctx.incremental_layout);
+  }
+
   //
   // Timers
   //
@@ -5109,10 +7442,16 @@ entry_point(CmdLine *cmdline)
 {
   Temp scratch = scratch_begin(0,0);
   lnk_init_error_handler();
-  LNK_Config *config   = lnk_config_from_argcv(scratch.arena, cmdline->argc, cmdline->argv);
-  TP_Context *tp       = tp_alloc(scratch.arena, config->worker_count, config->max_worker_count, config->shared_thread_pool_name);
-  TP_Arena   *tp_arena = tp_arena_alloc(tp);
-  lnk_run(tp, tp_arena, config);
+  LNK_Config *config    = lnk_config_from_argcv(scratch.arena, cmdline->argc, cmdline->argv);
+  TP_Context *tp        = tp_alloc(scratch.arena, config->worker_count, config->max_worker_count, config->shared_thread_pool_name);
+  TP_Arena   *tp_arena  = tp_arena_alloc(tp);
+
+  // a previous /INCREMENTAL link either makes this one unnecessary or leaves a layout to patch
+  LNK_IncrementalLayout *incremental_layout = 0;
+  B32                    skip_link          = config->incremental == LNK_SwitchState_Yes && lnk_incremental_is_up_to_date(tp, scratch.arena, config, &incremental_layout);
+  if (!skip_link) {
+    lnk_run(tp, tp_arena, config, incremental_layout);
+  }
   scratch_end(scratch);
 }
 
@@ -34,6 +34,8 @@ typedef struct LNK_Input
   B32               disallow;
   B32               is_thin;
   B32               has_disk_read_failed;
+  FileProperties    disk_props; // stamped before the disk read
+  U128              disk_hash;  // hash of the data as read, before the link patches it
   B32               exclude_from_debug_info;
   LNK_LibMemberRef *link_member;
   void             *loaded_input;
@@ -66,6 +68,9 @@ typedef struct LNK_Inputer
   HashTable     *missing_lib_ht;
   LNK_InputList  libs;
   LNK_InputList  new_libs[LNK_InputSource_Count];
+  String8List    lib_searches;
+  B32            stamp_inputs;
+  B32            hash_inputs;
 } LNK_Inputer;
 
 // --- Image Link -------------------------------------------------------------
@@ -98,6 +103,8 @@ typedef struct LNK_ImageContext
 {
   String8           image_data;
   LNK_SectionTable *sectab;
+  Rng1U64Array      patch_ranges;       // file ranges that changed when the image was patched in place, empty on a full link
+  String8List       incremental_layout; // serialized LNK_IncrementalLayout for the next /INCREMENTAL link
 } LNK_ImageContext;
 
 typedef struct LNK_SectionDefinition
@@ -118,6 +125,144 @@ typedef struct LNK_CommonBlockContrib
   } u;
 } LNK_CommonBlockContrib;
 
+// --- Incremental -------------------------------------------------------------
+//
+// /INCREMENTAL records input stamps and content hashes, and the image layout:
+// image sections, every obj's section contributions with the capacity reserved
+// after them, and the symbol table. When nothing changed the link is skipped.
+// When inputs changed the front end runs as usual and the image is built on the
+// recorded layout: changed objs are placed into their old slots, sections with
+// relocations into those slots are refilled, and only the touched file ranges
+// are written to the existing image. Anything that doesn't fit the layout falls
+// back to a full link. Debug info is rebuilt from the patched objs.
+
+#define LNK_INCREMENTAL_STATE_MAGIC   0x4b4c495f444152ull // "RAD_ILK"
+#define LNK_INCREMENTAL_STATE_VERSION 4
+
+typedef enum
+{
+  LNK_IncrementalFileFlag_Output    = (1 << 0),
+  LNK_IncrementalFileFlag_LibSearch = (1 << 1),
+  LNK_IncrementalFileFlag_Extra     = (1 << 2), // input that bypasses the inputer, changes force a full link
+} LNK_IncrementalFileFlags;
+
+typedef struct LNK_IncrementalStateHeader
+{
+  U64  magic;
+  U32  version;
+  U32  file_count;
+  U128 cmd_line_hash;
+  U64  string_table_size;
+  U64  layout_size;
+} LNK_IncrementalStateHeader;
+
+typedef struct LNK_IncrementalLayoutHeader
+{
+  U64 image_size;
+  U32 sect_count;
+  U32 obj_count;
+  U32 contrib_count;
+  U32 symbol_count;
+  U32 common_block_sect_idx;
+  U32 common_block_off;
+  U32 common_block_size;
+  U32 pad;
+} LNK_IncrementalLayoutHeader;
+
+typedef struct LNK_IncrementalSection
+{
+  U64 name_hash; // name and flags
+  U32 voff;
+  U32 vsize;
+  U32 foff;
+  U32 fsize;
+} LNK_IncrementalSection;
+
+typedef struct LNK_IncrementalObj
+{
+  U128 hash;      // obj contents
+  U64  path_hash;
+  U32  first_contrib;
+  U32  contrib_count;
+} LNK_IncrementalObj;
+
+typedef struct LNK_IncrementalContrib
+{
+  U64 key;          // section name, flags and COMDAT, see lnk_incremental_contrib_keys_task
+  U32 obj_sect_idx;
+  U32 sect_idx;     // image section index
+  U32 off;
+  U32 size;
+  U32 cap;          // size and bytes reserved after the contribution
+  U32 pad;
+} LNK_IncrementalContrib;
+
+typedef struct LNK_IncrementalSymbol
+{
+  U64 name_hash;
+  U32 obj_idx;
+  U32 interp;
+  U64 value; // virtual offset for regular symbols, value for absolute symbols
+} LNK_IncrementalSymbol;
+
+typedef struct LNK_IncrementalSymbolRef
+{
+  LNK_IncrementalSymbol  state;
+  LNK_Symbol            *symbol;
+} LNK_IncrementalSymbolRef;
+
+typedef struct LNK_IncrementalLayout
+{
+  LNK_IncrementalLayoutHeader *header;
+  LNK_IncrementalSection      *sects;
+  LNK_IncrementalObj          *objs;
+  LNK_IncrementalContrib      *contribs;
+  LNK_IncrementalSymbol       *symbols;
+} LNK_IncrementalLayout;
+
+typedef struct LNK_IncrementalImage
+{
+  LNK_IncrementalLayout    *prev;           // layout from the previous link, zero on a full link
+  B32                       is_patching;    // previous layout is used when it fits
+  U128                     *obj_hashes;
+  B8                       *is_obj_changed;
+  U64                       changed_obj_count;
+  U64                     **contrib_keys;   // per obj section, zero when the section doesn't contribute
+  U64                       symbol_count;
+  LNK_IncrementalSymbolRef *symbols;        // symbol table sorted on name hash
+  Rng1U64Array             *dirty_ranges;   // per image section, slots of changed objs
+  U64                       pdata_sect_idx; // exception table is sorted across objs, so it is always refilled
+  B8                      **is_sect_dirty;  // per obj section, contribution is copied and relocated again
+} LNK_IncrementalImage;
+
+typedef struct LNK_IncrementalFileHeader
+{
+  U64                      size;
+  DenseTime                modified;
+  U128                     hash;
+  U32                      flags;
+  U32                      path_off;
+  U32                      path_size;
+  U32                      pad;
+} LNK_IncrementalFileHeader;
+
+typedef struct LNK_IncrementalFile
+{
+  String8                     path;
+  U64                         size;
+  DenseTime                   modified;
+  U128                        hash;
+  LNK_IncrementalFileFlags    flags;
+  struct LNK_IncrementalFile *next;
+} LNK_IncrementalFile;
+
+typedef struct LNK_IncrementalFileList
+{
+  U64                  count;
+  LNK_IncrementalFile *first;
+  LNK_IncrementalFile *last;
+} LNK_IncrementalFileList;
+
 // --- Ref ---------------------------------------------------------------------
 
 #define LNK_RELOCS_PER_TASK 0x1000
@@ -148,6 +293,42 @@ typedef struct AlignType(16) LNK_RelocRefsList
   LNK_RelocRefsPointer head;
 } LNK_RelocRefsList;
 
+// --- ICF ---------------------------------------------------------------------
+
+#define LNK_ICF_NULL_SECTION max_U32
+
+typedef struct LNK_ICFTarget
+{
+  U32 section_idx; // index of the foldable target section, LNK_ICF_NULL_SECTION if target can't be folded
+  U32 offset;      // offset of the target symbol in the foldable section
+  U64 hash;        // identity of a target that can't be folded
+} LNK_ICFTarget;
+
+typedef struct LNK_ICFSection
+{
+  LNK_Obj       *obj;
+  U32            section_number;
+  U32            symbol_value;
+  U64            targets_count;
+  LNK_ICFTarget *targets;
+} LNK_ICFSection;
+
+typedef struct LNK_ICFClassKey
+{
+  U64 hash;
+  U32 class_idx;
+  U32 section_idx;
+} LNK_ICFClassKey;
+
+// --- Order -------------------------------------------------------------------
+
+typedef struct LNK_OrderProfileEntry
+{
+  String8 name;
+  U64     count;
+  U64     line_idx;
+} LNK_OrderProfileEntry;
+
 // --- Base Reloc --------------------------------------------------------------
 
 typedef struct LNK_BaseRelocPage
@@ -194,12 +375,28 @@ typedef struct
   LNK_RelocRefsList *reloc_refs;
 } LNK_OptRefTask;
 
+typedef struct
+{
+  LNK_SymbolTable  *symtab;
+  LNK_Obj         **objs;
+  U32             **section_idx_maps;
+  U64              *section_counts;
+  U64              *section_bases;
+  LNK_ICFSection   *sections;
+  Rng1U64          *ranges;
+  U32              *classes;
+  LNK_ICFClassKey  *keys;
+  U64               folded_count;
+  U64               folded_size;
+} LNK_OptICFTask;
+
 typedef struct
 {
   String8              image_data;
   LNK_Obj            **objs;
   U64                  image_base;
   COFF_SectionHeader **image_section_table;
+  B8                 **is_sect_dirty; // when set, only dirty sections and debug info are relocated
 } LNK_ObjRelocPatcher;
 
 typedef struct
@@ -240,8 +437,10 @@ typedef struct
   U64                        default_align;
   LNK_SectionContrib        *null_sc;
   LNK_SectionContrib      ***sect_map;
+  U32                      **order_map;
   HashTable                 *contribs_ht;
   LNK_SectionArray           image_sects;
+  LNK_IncrementalImage      *incremental;
   union {
     struct {
       HashTable **defns;
@@ -257,6 +456,7 @@ typedef struct
     struct {
       B8                        **was_symbol_patched;
       LNK_Section                *common_block_sect;
+      LNK_SectionContrib         *common_block_sc;
       Rng1U64                    *common_block_ranges;
       LNK_CommonBlockContrib     *common_block_contribs;
       COFF_SymbolValueInterpType  fixup_type;
@@ -270,11 +470,78 @@ typedef struct
 
 typedef struct
 {
-  String8 path;
-  String8 temp_path;
-  String8 data;
+  String8      path;
+  String8      temp_path;
+  String8      data;
+  Rng1U64Array patch_ranges;
 } LNK_WriteThreadContext;
 
+typedef struct
+{
+  TP_Context        *tp;
+  TP_Arena          *arena;
+  LNK_Config        *config;
+  LNK_SymbolTable   *symtab;
+  String8            image_data;
+  LNK_CodeViewInput *input;
+  CV_DebugT         *types;
+  B32                is_concurrent;       // RDI and PDB are built at the same time from the same inputs
+  B32                types_are_read_only; // types reference leaves mapped from the type database
+} LNK_DebugInfoBuildContext;
+
+// --- Map ---------------------------------------------------------------------
+
+#define LNK_MAP_ENTRIES_PER_BLOCK  0x1000
+#define LNK_MAP_BLOCKS_PER_WORKER  8
+
+typedef enum
+{
+  LNK_MapEntry_Contrib,
+  LNK_MapEntry_Public,
+  LNK_MapEntry_Static,
+  LNK_MapEntry_Count
+} LNK_MapEntryType;
+
+typedef struct LNK_MapEntry
+{
+  U32 isect;   // image section number
+  U32 off;     // offset within the image section
+  U32 obj_idx;
+  U32 idx;     // section index for contributions, symbol index for symbols
+} LNK_MapEntry;
+
+typedef struct LNK_MapEntryArray
+{
+  U64           count;
+  LNK_MapEntry *v;
+} LNK_MapEntryArray;
+
+typedef struct
+{
+  LNK_Config          *config;
+  LNK_SymbolTable     *symtab;
+  LNK_Obj            **objs;
+  String8             *obj_names;
+  U64                  image_base;
+  U64                  image_section_count;
+  COFF_SectionHeader **image_section_table;
+  union {
+    struct {
+      LNK_MapEntryArray *contribs;
+      LNK_MapEntryArray *statics;
+      LNK_MapEntryArray *publics;
+    } gather;
+    struct {
+      LNK_MapEntryArray *buckets;
+    } sort;
+    struct {
+      LNK_MapEntryType   type;
+      LNK_MapEntryArray *blocks;
+      String8           *output;
+    } format;
+  } u;
+} LNK_MapTask;
+
 typedef struct
 {
   String8  data;
@@ -282,13 +549,19 @@ typedef struct
   U128    *hashes;
 } LNK_Blake3Hasher;
 
+typedef struct
+{
+  String8Array data_arr;
+  U128        *hashes;
+} LNK_IncrementalHasher;
+
 // --- Config -----------------------------------------------------------------
 
 internal LNK_Config * lnk_config_from_argcv(Arena *arena, int argc, char **argv);
 
 // --- Entry Point -------------------------------------------------------------
 
-internal void lnk_run(TP_Context *tp, TP_Arena *tp_arena, LNK_Config *config);
+internal void lnk_run(TP_Context *tp, TP_Arena *tp_arena, LNK_Config *config, LNK_IncrementalLayout *incremental_layout);
 
 // --- Path --------------------------------------------------------------------
 
@@ -298,6 +571,21 @@ internal String8 lnk_make_full_path(Arena *arena, PathStyle system_path_style, S
 
 internal U128 lnk_blake3_hash_parallel(TP_Context *tp, U64 chunk_count, String8 data);
 
+// --- Incremental -------------------------------------------------------------
+
+internal U128                    lnk_incremental_hash_from_data(String8 data);
+internal U128 *                  lnk_incremental_hash_parallel(TP_Context *tp, Arena *arena, String8Array data_arr);
+internal void                    lnk_incremental_file_list_push(Arena *arena, LNK_IncrementalFileList *list, String8 path, FileProperties props, U128 hash, LNK_IncrementalFileFlags flags);
+internal LNK_IncrementalFile *   lnk_incremental_input_file_from_path(LNK_IncrementalFileList list, String8 path);
+internal U128                    lnk_incremental_hash_from_lib_search(LNK_Config *config, LNK_IncrementalFileList files, String8 lib_name);
+internal String8Array            lnk_incremental_extra_input_paths(Arena *arena, LNK_Config *config);
+internal FileProperties *        lnk_incremental_props_from_paths(Arena *arena, String8Array paths);
+internal LNK_IncrementalFileList lnk_incremental_file_list_from_state(Arena *arena, String8 state_data, U128 *cmd_line_hash_out, String8 *layout_data_out);
+internal String8List             lnk_incremental_state_from_file_list(Arena *arena, U128 cmd_line_hash, LNK_IncrementalFileList list, String8List layout);
+internal LNK_IncrementalLayout * lnk_incremental_layout_from_data(Arena *arena, String8 layout_data);
+internal B32                     lnk_incremental_is_up_to_date(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_IncrementalLayout **layout_out);
+internal void                    lnk_incremental_write_state(TP_Context *tp, LNK_Config *config, LNK_Inputer *inputer, String8Array extra_paths, FileProperties *extra_props, String8List layout);
+
 // --- Manifest ----------------------------------------------------------------
 
 internal String8 lnk_make_linker_manifest(Arena *arena, B32 manifest_uac, String8 manifest_level, String8 manifest_ui_access, String8List manifest_dependency_list);
@@ -348,13 +636,40 @@ internal LNK_Link *    lnk_link_image (TP_Context *tp, TP_Arena *arena, LNK_Conf
 // --- Optimizations -----------------------------------------------------------
 
 internal void lnk_opt_ref(TP_Context *tp, LNK_SymbolTable *symtab, LNK_Config *config, LNK_ObjList objs);
+internal void lnk_opt_icf(TP_Context *tp, LNK_SymbolTable *symtab, LNK_Config *config, LNK_ObjList objs);
+
+// --- Order -------------------------------------------------------------------
+
+internal String8List lnk_order_symbols_from_profile(Arena *arena, String8 path, String8 data);
+internal U32 **      lnk_order_map_from_config(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs);
+
+// --- Incremental Image -------------------------------------------------------
+
+internal B32                     lnk_incremental_is_growable_section(String8 sect_name, COFF_SectionFlags flags);
+internal U64                     lnk_incremental_tail_pad_from_size(U64 size);
+internal LNK_IncrementalImage *  lnk_incremental_image_begin(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs, LNK_IncrementalLayout *prev);
+internal B32                     lnk_incremental_pin_layout(LNK_Config *config, LNK_BuildImageTask *task, LNK_SectionContrib *common_block_sc);
+internal void                    lnk_incremental_flag_dirty_sections(TP_Context *tp, Arena *arena, LNK_BuildImageTask *task);
+internal String8                 lnk_incremental_fill_image(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_BuildImageTask *task, LNK_Section *image_header_sect, Rng1U64List *patch_ranges);
+internal LNK_IncrementalLayout   lnk_incremental_layout_from_image(Arena *arena, LNK_BuildImageTask *task, LNK_SectionContrib *common_block_sc, U64 image_size);
+internal String8List             lnk_incremental_data_from_layout(Arena *arena, LNK_IncrementalLayout layout);
 
 // --- Win32 Image -------------------------------------------------------------
 
 internal String8List      lnk_build_guard_tables(TP_Context *tp, LNK_SectionTable *sectab, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs, COFF_MachineType machine, String8 entry_point_name, LNK_GuardFlags guard_flags, B32 emit_suppress_flag);
 internal String8          lnk_build_base_relocs(TP_Context *tp, TP_Arena *tp_temp, LNK_Config *config, U64 objs_count, LNK_Obj **objs);
 internal String8List      lnk_build_win32_image_header(Arena *arena, LNK_SymbolTable *symtab, LNK_Config *config, LNK_SectionArray sect_arr, U64 expected_image_header_size);
-internal LNK_ImageContext lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, U64 obj_count, LNK_Obj **objs);
+internal LNK_ImageContext lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, U64 obj_count, LNK_Obj **objs, LNK_IncrementalLayout *incremental_layout);
+
+// --- Map ---------------------------------------------------------------------
+
+internal void lnk_build_and_write_map(TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, String8 image_data, U64 objs_count, LNK_Obj **objs);
+
+// --- Debug Info --------------------------------------------------------------
+
+internal void lnk_build_and_write_rdi(LNK_DebugInfoBuildContext *ctx);
+internal void lnk_build_and_write_pdb(LNK_DebugInfoBuildContext *ctx);
+internal void lnk_build_pdb_thread(void *raw_ctx);
 
 // --- Logger ------------------------------------------------------------------
 
@@ -55,10 +55,10 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_NotImplemented,     0, "IDLOUT",               "", ""                                                                                                      },
   { LNK_CmdSwitch_Ignore,             0, "IGNORE",               ":#", ""                                                                                                    },
   { LNK_CmdSwitch_NotImplemented,     0, "IGNOREIDL",            "", ""                                                                                                      },
-  { LNK_CmdSwitch_NotImplemented,     0, "ILK",                  "", ""                                                                                                      },
+  { LNK_CmdSwitch_Ilk,                0, "ILK",                  ":FILENAME", "Path to the incremental link state file, default is image name with .ilk extension."         },
   { LNK_CmdSwitch_ImpLib,             0, "IMPLIB",               ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_Include,            1, "INCLUDE",              "", ""                                                                                                      },
-  { LNK_CmdSwitch_Incremental,        0, "INCREMENTAL",          "[:NO]", "Incremental linking is not supported."                                                            },
+  { LNK_CmdSwitch_Incremental,        0, "INCREMENTAL",          "[:NO]", "Skips the link when inputs match /ILK, otherwise patches changed objs into the existing image and falls back to a full link when they don't fit its layout."},
   { LNK_CmdSwitch_NotImplemented,     0, "INTEGRITYCHECK",       "", ""                                                                                                      },
   { LNK_CmdSwitch_InferAsanLibs,      1, "INFERASANLIBS",        "[:NO]", ""                                                                                                 },
   { LNK_CmdSwitch_InferAsanLibsNo,    1, "INFERASANLIBSNO",      "", "",                                                                                                     },
@@ -78,8 +78,8 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_ManifestFile,       0, "MANIFESTFILE",         ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_ManifestInput,      0, "MANIFESTINPUT",        ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_ManifestUac,        0, "MANIFESTUAC",          ":{NO|{'level'={'asInvoker'|'highestAvailable'|'requireAdministrator'} ['uiAccess'={'true'|'false'}]}}", "" },
-  { LNK_CmdSwitch_NotImplemented,     0, "MAP",                  "", ""                                                                                                      },
-  { LNK_CmdSwitch_NotImplemented,     0, "MAPINFO",              "", ""                                                                                                      },
+  { LNK_CmdSwitch_Map,                0, "MAP",                  "[:FILENAME]", "Emit map file with sections, contributions and symbols of the image."                      },
+  { LNK_CmdSwitch_MapInfo,            0, "MAPINFO",              ":{EXPORTS}", "Add extra information to the map file."                                                       },
   { LNK_CmdSwitch_Merge,              1, "MERGE",                ":from=to", ""                                                                                              },
   { LNK_CmdSwitch_NotImplemented,     0, "MIDL",                 "", ""                                                                                                      },
   { LNK_CmdSwitch_Natvis,             0, "NATVIS",               ":FILENAME", ""                                                                                             },
@@ -92,7 +92,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_NoLogo,             0, "NOLOGO",               "", ""                                                                                                      },
   { LNK_CmdSwitch_NxCompat,           0, "NXCOMPAT",             "[:NO]", ""                                                                                                 },
   { LNK_CmdSwitch_Opt,                0, "OPT",                  "", ""                                                                                                      },
-  { LNK_CmdSwitch_NotImplemented,     0, "ORDER",                "", ""                                                                                                      },
+  { LNK_CmdSwitch_Order,              0, "ORDER",                ":@FILENAME", "Lays out listed COMDAT functions in the given order, one symbol per line."                  },
   { LNK_CmdSwitch_Out,                0, "OUT",                  ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_Pdb,                0, "PDB",                  ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_PdbAltPath,         0, "PDBALTPATH",           "", ""                                                                                                      },
@@ -130,6 +130,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_Rad_Map,                          0, "RAD_MAP",                              ":FILENAME", "Emit file with the output image's layout description."                            },
   { LNK_CmdSwitch_Rad_MapLinesForUnresolvedSymbols, 0, "RAD_MAP_LINES_FOR_UNRESOLVED_SYMBOLS", "[:NO]",     "Use debug info to print source file location for unresolved symbol"               },
   { LNK_CmdSwitch_Rad_MemoryMapFiles,               0, "RAD_MEMORY_MAP_FILES",                 "[:NO]",     "When enabled, files are memory-mapped instead of being read entirely on request." },
+  { LNK_CmdSwitch_Rad_MemoryMapFilesPopulate,       0, "RAD_MEMORY_MAP_FILES_POPULATE",        "[:NO]",     "Pre-fault pages of memory-mapped files when they are mapped."                     },
   { LNK_CmdSwitch_Rad_Debug,                        0, "RAD_DEBUG",                            "[:NO]",     "Emit RAD debug info file."                                                        },
   { LNK_CmdSwitch_Rad_DebugAltPath,                 0, "RAD_DEBUGALTPATH",                     "", ""                                                                                          },
   { LNK_CmdSwitch_Rad_DebugName,                    0, "RAD_DEBUG_NAME",                       ":FILENAME", "Sets file name for RAD debug info file."                                          },
@@ -140,8 +141,9 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_Rad_Guid,                         0, "RAD_GUID",                             ":{IMAGEBLAKE3|XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXXXXXX}", ""                                   },
   { LNK_CmdSwitch_Rad_LargePages,                   0, "RAD_LARGE_PAGES",                      "[:NO]",     "Disabled by default on Windows."                                                  },
   { LNK_CmdSwitch_Rad_LinkVer,                      0, "RAD_LINK_VER",                         ":##,##", ""                                                                                    },
-  { LNK_CmdSwitch_Rad_Log,                          0, "RAD_LOG",                              ":{ALL,INPUT_OBJ,INPUT_LIB,IO,LINK_STATS,TIMERS}", ""                                           },
+  { LNK_CmdSwitch_Rad_Log,                          0, "RAD_LOG",                              ":{ALL,INPUT_OBJ,INPUT_LIB,IO,LINK_STATS,TIMERS,INCREMENTAL}", ""                               },
   { LNK_CmdSwitch_Rad_MtPath,                       0, "RAD_MT_PATH",                          ":EXEPATH",  "Exe path to manifest tool, default: " LNK_MANIFEST_MERGE_TOOL_NAME                },
+  { LNK_CmdSwitch_Rad_OrderProfile,                 0, "RAD_ORDER_PROFILE",                    ":FILENAME", "Clusters hot COMDAT functions, each line is a symbol followed by a sample count."  },
   { LNK_CmdSwitch_Rad_OsVer,                        0, "RAD_OS_VER",                           ":##,##", ""                                                                                    },
   { LNK_CmdSwitch_Rad_PageSize,                     0, "RAD_PAGE_SIZE",                        ":#",        "Must be power of two."                                                            },
   { LNK_CmdSwitch_Rad_PathStyle,                    0, "RAD_PATH_STYLE",                       ":{WindowsAbsolute|UnixAbsolute}", ""                                                           },
@@ -155,6 +157,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_Rad_TargetOs,                     0, "RAD_TARGET_OS",                        ":{WINDOWS,LINUX,MAC}"                                                                          },
   { LNK_CmdSwitch_Rad_WriteTempFiles,               0, "RAD_WRITE_TEMP_FILES",                 "[:NO]",     "When speicifed linker writes image and debug info to temporary files and renames after link is done." },
   { LNK_CmdSwitch_Rad_TimeStamp,                    0, "RAD_TIME_STAMP",                       ":#",        "Time stamp embeded in EXE and PDB."                                               },
+  { LNK_CmdSwitch_Rad_TypeDb,                       0, "RAD_TYPE_DB",                          "[:FILENAME]", "Caches CodeView leaf hashes and merged type indices between links, types of unchanged objs are merged by lookup. Default file name is image name with .rtdb extension." },
   { LNK_CmdSwitch_Rad_UnresolvedSymbolLimit,        0, "RAD_UNRESOLVED_SYMBOL_LIMIT",          ":#",        "Limits number of unresolved symbol errors linker reports."                        },
   { LNK_CmdSwitch_Rad_UnresolvedSymbolRefLimit,     0, "RAD_UNRESOLVED_SYMBOL_REF_LIMIT",      ":#",        "Limit number of unresolved symbol references linker reports."                     },
   { LNK_CmdSwitch_Rad_Version,                      0, "RAD_VERSION",                          "",          "Print version and exit."                                                          },
@@ -1420,6 +1423,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     }
   } break;
 
+  case LNK_CmdSwitch_Ilk: {
+    lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->incremental_name);
+  } break;
+
   case LNK_CmdSwitch_ImpLib: {
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->imp_lib_name);
   } break;
@@ -1431,12 +1438,7 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
   } break;
 
   case LNK_CmdSwitch_Incremental: {
-    LNK_SwitchState state;
-    if (lnk_cmd_switch_parse_flag(obj, cmd_switch, value_strings, &state)) {
-      if (state == LNK_SwitchState_Yes) {
-        lnk_error_cmd_switch(LNK_Warning_Cmdl, obj, cmd_switch, "incremental linkage is not supported");
-      }
-    }
+    lnk_cmd_switch_parse_flag(obj, cmd_switch, value_strings, &config->incremental);
   } break;
 
   case LNK_CmdSwitch_LargeAddressAware: {
@@ -1589,6 +1591,26 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     }
   } break;
 
+  case LNK_CmdSwitch_Map: {
+    if (value_strings.node_count > 0) {
+      lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->map_name);
+    }
+    config->map = LNK_SwitchState_Yes;
+  } break;
+
+  case LNK_CmdSwitch_MapInfo: {
+    for (String8Node *n = value_strings.first; n != 0; n = n->next) {
+      String8 param = n->string;
+      if (str8_match_lit("exports", param, StringMatchFlag_CaseInsensitive)) {
+        config->map_info |= LNK_MapInfo_Exports;
+      } else if (str8_match_lit("fixups", param, StringMatchFlag_CaseInsensitive) || str8_match_lit("lines", param, StringMatchFlag_CaseInsensitive)) {
+        lnk_error_cmd_switch(LNK_Warning_Cmdl, obj, cmd_switch, "\"%S\" is not supported, ignoring", param);
+      } else {
+        lnk_error_cmd_switch(LNK_Error_Cmdl, obj, cmd_switch, "unknown option \"%S\"", param);
+      }
+    }
+  } break;
+
   case LNK_CmdSwitch_Merge: {
     if (value_strings.node_count == 1) {
       LNK_MergeDirective merge = {0};
@@ -1680,6 +1702,17 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     }
   } break;
 
+  case LNK_CmdSwitch_Order: {
+    String8 order_name = {0};
+    if (lnk_cmd_switch_parse_string(obj, cmd_switch, value_strings, &order_name)) {
+      if (str8_starts_with(order_name, str8_lit("@"))) {
+        config->order_name = push_str8_copy(config->arena, str8_skip(order_name, 1));
+      } else {
+        lnk_error_cmd_switch(LNK_Error_Cmdl, obj, cmd_switch, "expected file name prefixed with @, got \"%S\"", order_name);
+      }
+    }
+  } break;
+
   case LNK_CmdSwitch_Out: {
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->image_name);
   } break;
@@ -1811,6 +1844,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     lnk_cmd_switch_set_flag_32(obj, cmd_switch, value_strings, &config->io_flags, LNK_IO_Flags_MemoryMapFiles);
   } break;
 
+  case LNK_CmdSwitch_Rad_MemoryMapFilesPopulate: {
+    lnk_cmd_switch_set_flag_32(obj, cmd_switch, value_strings, &config->io_flags, LNK_IO_Flags_MemoryMapPopulate);
+  } break;
+
   case LNK_CmdSwitch_Rad_Debug: {
     lnk_cmd_switch_parse_flag(obj, cmd_switch, value_strings, &config->rad_debug);
   } break;
@@ -1922,6 +1959,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->mt_path);
   } break;
 
+  case LNK_CmdSwitch_Rad_OrderProfile: {
+    lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->order_profile_name);
+  } break;
+
   case LNK_CmdSwitch_Rad_OsVer: {
     lnk_cmd_switch_parse_version(obj, cmd_switch, value_strings, &config->os_ver);
   } break;
@@ -2036,6 +2077,13 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     lnk_cmd_switch_parse_u32(obj, cmd_switch, value_strings, &config->time_stamp, 0);
   } break;
 
+  case LNK_CmdSwitch_Rad_TypeDb: {
+    if (value_strings.node_count > 0) {
+      lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->type_db_name);
+    }
+    config->type_db = LNK_SwitchState_Yes;
+  } break;
+
   case LNK_CmdSwitch_Rad_UnresolvedSymbolLimit: {
     lnk_cmd_switch_parse_u64(obj, cmd_switch, value_strings, &config->unresolved_symbol_limit, 0);
   } break;
@@ -2234,17 +2282,39 @@ lnk_config_from_cmd_line(String8List raw_cmd_line, LNK_CmdLine cmd_line)
     config->imp_lib_name = path_replace_file_extension(scratch.arena, config->image_name, str8_lit("lib"));
   }
 
+  // handle empty /ILK
+  if (!lnk_cmd_line_has_switch(cmd_line, LNK_CmdSwitch_Ilk)) {
+    config->incremental_name = path_replace_file_extension(scratch.arena, config->image_name, str8_lit("ilk"));
+  }
+
+  // handle empty /MAP
+  if (config->map == LNK_SwitchState_Yes && config->map_name.size == 0) {
+    config->map_name = path_replace_file_extension(scratch.arena, config->image_name, str8_lit("map"));
+  }
+
+  // handle empty /RAD_TYPE_DB
+  if (config->type_db == LNK_SwitchState_Yes && config->type_db_name.size == 0) {
+    config->type_db_name = path_replace_file_extension(scratch.arena, config->image_name, str8_lit("rtdb"));
+  }
+
   // handle empty /MANIFESTFILE
   if (!lnk_cmd_line_has_switch(cmd_line, LNK_CmdSwitch_ManifestFile)) {
     config->manifest_name = push_str8f(scratch.arena, "%S.manifest", config->image_name);
   }
 
   // convert to full paths
-  config->image_name     = os_full_path_from_path(arena, config->image_name);
-  config->pdb_name       = os_full_path_from_path(arena, config->pdb_name);
-  config->rad_debug_name = os_full_path_from_path(arena, config->rad_debug_name);
-  config->imp_lib_name   = os_full_path_from_path(arena, config->imp_lib_name);
-  config->manifest_name  = os_full_path_from_path(arena, config->manifest_name);
+  config->image_name       = os_full_path_from_path(arena, config->image_name);
+  config->pdb_name         = os_full_path_from_path(arena, config->pdb_name);
+  config->rad_debug_name   = os_full_path_from_path(arena, config->rad_debug_name);
+  config->imp_lib_name     = os_full_path_from_path(arena, config->imp_lib_name);
+  config->manifest_name    = os_full_path_from_path(arena, config->manifest_name);
+  config->incremental_name = os_full_path_from_path(arena, config->incremental_name);
+  if (config->type_db == LNK_SwitchState_Yes) {
+    config->type_db_name = os_full_path_from_path(arena, config->type_db_name);
+  }
+  if (config->map == LNK_SwitchState_Yes) {
+    config->map_name = os_full_path_from_path(arena, config->map_name);
+  }
 
   // collect env vars
   HashTable *env_vars = hash_table_init(scratch.arena, 512);
@@ -2301,11 +2371,17 @@ lnk_config_from_cmd_line(String8List raw_cmd_line, LNK_CmdLine cmd_line)
   // create temporary files names
   if (config->write_temp_files == LNK_SwitchState_Yes) {
     config->temp_rad_chunk_map_name = push_str8f(arena, "%S.tmp%x", config->rad_chunk_map_name, config->time_stamp);
+    config->temp_map_name           = push_str8f(arena, "%S.tmp%x", config->map_name,           config->time_stamp);
     config->temp_image_name         = push_str8f(arena, "%S.tmp%x", config->image_name,         config->time_stamp);
     config->temp_pdb_name           = push_str8f(arena, "%S.tmp%x", config->pdb_name,           config->time_stamp);
     config->temp_rad_debug_name     = push_str8f(arena, "%S.tmp%x", config->rad_debug_name,     config->time_stamp);
   }
 
+  // type database is mapped while the link runs, so updates always go through a temporary file
+  if (config->type_db == LNK_SwitchState_Yes) {
+    config->temp_type_db_name = push_str8f(arena, "%S.tmp%x", config->type_db_name, config->time_stamp);
+  }
+
   scratch_end(scratch);
   ProfEnd();
   return config;
@@ -169,7 +169,9 @@ typedef enum
   LNK_CmdSwitch_Rad_Map,
   LNK_CmdSwitch_Rad_MapLinesForUnresolvedSymbols,
   LNK_CmdSwitch_Rad_MemoryMapFiles,
+  LNK_CmdSwitch_Rad_MemoryMapFilesPopulate,
   LNK_CmdSwitch_Rad_MtPath,
+  LNK_CmdSwitch_Rad_OrderProfile,
   LNK_CmdSwitch_Rad_OsVer,
   LNK_CmdSwitch_Rad_PageSize,
   LNK_CmdSwitch_Rad_PathStyle,
@@ -182,6 +184,7 @@ typedef enum
   LNK_CmdSwitch_Rad_SuppressError,
   LNK_CmdSwitch_Rad_TargetOs,
   LNK_CmdSwitch_Rad_TimeStamp,
+  LNK_CmdSwitch_Rad_TypeDb,
   LNK_CmdSwitch_Rad_UnresolvedSymbolLimit,
   LNK_CmdSwitch_Rad_UnresolvedSymbolRefLimit,
   LNK_CmdSwitch_Rad_Version,
@@ -243,6 +246,12 @@ enum
 };
 typedef U32 LNK_GuardFlags;
 
+enum
+{
+  LNK_MapInfo_Exports = (1 << 0),
+};
+typedef U32 LNK_MapInfoFlags;
+
 typedef enum
 {
   LNK_ManifestOpt_Null,
@@ -394,6 +403,9 @@ typedef struct LNK_Config
   LNK_SwitchState             rad_debug;
   LNK_SwitchState             rad_chunk_map;
   String8                     rad_chunk_map_name;
+  LNK_SwitchState             map;
+  String8                     map_name;
+  LNK_MapInfoFlags            map_info;
   String8                     rad_debug_name;
   String8                     rad_debug_alt_path;
   LNK_IncludeSymbolList       include_symbol_list;
@@ -407,9 +419,18 @@ typedef struct LNK_Config
   String8                     temp_pdb_name;
   String8                     temp_rad_debug_name;
   String8                     temp_rad_chunk_map_name;
+  String8                     temp_map_name;
   String8                     delay_load_helper_name;
   String8List                 remove_sections;
+  String8                     order_name;
+  String8                     order_profile_name;
   LNK_IO_Flags                io_flags;
+  LNK_SwitchState             incremental;
+  String8                     incremental_name;
+  U128                        incremental_cmd_line_hash;
+  LNK_SwitchState             type_db;
+  String8                     type_db_name;
+  String8                     temp_type_db_name;
   HashTable                  *export_ht;
   HashTable                  *alt_name_ht;
   HashTable                  *include_symbol_ht;
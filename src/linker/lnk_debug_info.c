@@ -1502,6 +1502,31 @@ THREAD_POOL_TASK_FUNC(lnk_hash_debug_t_task)
   CV_DebugT  debug_t     = task->debug_t_arr[obj_idx];
   U128Array  out_hashes  = task->hashes->v[LNK_LeafLocType_Internal][obj_idx][CV_TypeIndexSource_TPI];
 
+  // reuse hashes (and type indices when types are merged with the database) from the previous link when obj is unchanged
+  if (task->type_db && debug_t.count > 0) {
+    LNK_PchInfo pch     = task->input->pch_arr[obj_idx];
+    U128        pch_key = pch.ti_lo != pch.ti_hi ? task->type_db_keys[pch.debug_p_obj_idx] : u128_zero();
+    U128        key     = lnk_type_db_key_from_obj(task->input->internal_obj_arr[obj_idx], debug_t.count, pch, pch_key);
+
+    task->type_db_keys[obj_idx] = key;
+
+    if (!u128_match(key, u128_zero())) {
+      LNK_TypeDBEntry *entry = lnk_type_db_lookup(task->type_db, key);
+      if (entry && entry->leaf_count == debug_t.count) {
+        U128Array cached = { .v = task->type_db->leaf_hashes + entry->leaf_off, .count = entry->leaf_count };
+        for EachIndex(ti_source, CV_TypeIndexSource_COUNT) {
+          task->hashes->v[LNK_LeafLocType_Internal][obj_idx][ti_source] = cached;
+        }
+        if (task->type_index_maps) {
+          task->type_index_maps[obj_idx] = task->type_db->leaf_type_indices + entry->leaf_off;
+        }
+        ins_atomic_u64_inc_eval(&task->type_db->hit_count);
+        goto exit;
+      }
+    }
+    ins_atomic_u64_inc_eval(&task->type_db->miss_count);
+  }
+
   Rng1U64 ti_ranges[CV_TypeIndexSource_COUNT];
   for (U64 ti_source = 0; ti_source < ArrayCount(ti_ranges); ++ti_source) {
     ti_ranges[ti_source] = rng_1u64(task->input->pch_arr[obj_idx].ti_lo, task->input->pch_arr[obj_idx].ti_hi + debug_t.count);
@@ -1530,6 +1555,7 @@ THREAD_POOL_TASK_FUNC(lnk_hash_debug_t_task)
     temp_end(temp);
   }
 
+  exit:;
   ProfEnd();
 }
 
@@ -1978,6 +2004,65 @@ lnk_assign_type_indices(TP_Context *tp, LNK_LeafBucketArray bucket_arr, CV_TypeI
   scratch_end(scratch);
 }
 
+internal CV_TypeIndex
+lnk_merged_type_index_from_loc_idx_and_ti(LNK_CodeViewInput  *input,
+                                          LNK_LeafHashes     *hashes,
+                                          LNK_LeafHashTable  *leaf_ht_arr,
+                                          CV_TypeIndex      **type_index_maps,
+                                          LNK_LeafLocType     loc_type,
+                                          CV_TypeIndexSource  ti_source,
+                                          U64                 loc_idx,
+                                          CV_TypeIndex        obj_ti)
+{
+  LNK_LeafRef leaf_ref = lnk_leaf_ref_from_loc_idx_and_ti(input, loc_type, ti_source, loc_idx, obj_ti);
+
+  // type index maps cover internal leaves only
+  if (type_index_maps) {
+    Assert(loc_type == LNK_LeafLocType_Internal);
+    return type_index_maps[leaf_ref.enc_loc_idx][leaf_ref.enc_leaf_idx];
+  }
+
+  LNK_LeafBucket *leaf_bucket = lnk_leaf_hash_table_search(&leaf_ht_arr[ti_source], input, hashes, leaf_ref);
+  return leaf_bucket->type_index;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_type_index_maps_task)
+{
+  ProfBeginFunction();
+
+  LNK_TypeIndexMapsTask *task    = raw_task;
+  U64                    obj_idx = task_id;
+  CV_DebugT              debug_t = task->input->merged_debug_t_p_arr[obj_idx];
+
+  CV_TypeIndex *map = push_array_no_zero(arena, CV_TypeIndex, debug_t.count);
+  for EachIndex(leaf_idx, debug_t.count) {
+    CV_LeafHeader      *leaf_header = cv_debug_t_get_leaf_header(debug_t, leaf_idx);
+    CV_TypeIndexSource  ti_source   = cv_type_index_source_from_leaf_kind(leaf_header->kind);
+    LNK_LeafBucket     *leaf_bucket = lnk_leaf_hash_table_search(&task->leaf_ht_arr[ti_source], task->input, task->hashes, lnk_obj_leaf_ref(obj_idx, leaf_idx));
+    map[leaf_idx] = leaf_bucket->type_index;
+  }
+  task->type_index_maps[obj_idx] = map;
+
+  ProfEnd();
+}
+
+internal CV_TypeIndex **
+lnk_type_index_maps_from_leaf_hash_tables(TP_Context *tp, TP_Arena *arena, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr)
+{
+  ProfBeginFunction();
+
+  LNK_TypeIndexMapsTask task = {0};
+  task.input                 = input;
+  task.hashes                = hashes;
+  task.leaf_ht_arr           = leaf_ht_arr;
+  task.type_index_maps       = push_array(arena->v[0], CV_TypeIndex *, input->internal_count);
+  tp_for_parallel(tp, arena, input->internal_count, lnk_type_index_maps_task, &task);
+
+  ProfEnd();
+  return task.type_index_maps;
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_patch_symbols_task)
 {
@@ -2005,12 +2090,8 @@ THREAD_POOL_TASK_FUNC(lnk_patch_symbols_task)
       for (CV_TypeIndexInfo *ti_info = ti_list.first; ti_info != 0; ti_info = ti_info->next) {
         CV_TypeIndex *ti_ptr = (CV_TypeIndex *) (symnode->data.data.str + ti_info->offset);
         if (*ti_ptr >= ti_lo_arr[ti_info->source]) {
-          LNK_LeafHashTable *leaf_ht     = &task->leaf_ht_arr[ti_info->source];
-          LNK_LeafRef        leaf_ref    = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
-          LNK_LeafBucket    *leaf_bucket = lnk_leaf_hash_table_search(leaf_ht, task->input, task->hashes, leaf_ref);
-
           // we overwrite section memory directly
-          *ti_ptr = leaf_bucket->type_index;
+          *ti_ptr = lnk_merged_type_index_from_loc_idx_and_ti(task->input, task->hashes, task->leaf_ht_arr, task->type_index_maps, loc_type, ti_info->source, loc_idx, *ti_ptr);
         }
       }
 
@@ -2024,7 +2105,8 @@ internal void
 lnk_patch_symbols(TP_Context         *tp,
                   LNK_CodeViewInput  *input,
                   LNK_LeafHashes     *hashes,
-                  LNK_LeafHashTable  *leaf_ht_arr)
+                  LNK_LeafHashTable  *leaf_ht_arr,
+                  CV_TypeIndex      **type_index_maps)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(0,0);
@@ -2036,6 +2118,7 @@ lnk_patch_symbols(TP_Context         *tp,
   task.input           = input;
   task.hashes          = hashes;
   task.leaf_ht_arr     = leaf_ht_arr;
+  task.type_index_maps = type_index_maps;
   task.arena_arr       = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, max_ti_list_size, max_ti_list_size);
   tp_for_parallel(tp, 0, tp->worker_count, lnk_patch_symbols_task, &task);
 
@@ -2065,11 +2148,8 @@ THREAD_POOL_TASK_FUNC(lnk_patch_inlines_task)
       CV_TypeIndex *ti_ptr = (CV_TypeIndex *) (inline_data_node->string.str + ti_info->offset);
       CV_TypeIndex  ti_lo  = lnk_ti_lo_from_loc(task->input, loc_type, loc_idx, ti_info->source);
       if (*ti_ptr >= ti_lo) {
-        LNK_LeafRef     leaf_ref    = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
-        LNK_LeafBucket *leaf_bucket = lnk_leaf_hash_table_search(&task->leaf_ht_arr[ti_info->source], task->input, task->hashes, leaf_ref);
-        
         // patch index
-        *ti_ptr = leaf_bucket->type_index;
+        *ti_ptr = lnk_merged_type_index_from_loc_idx_and_ti(task->input, task->hashes, task->leaf_ht_arr, task->type_index_maps, loc_type, ti_info->source, loc_idx, *ti_ptr);
       }
     }
 
@@ -2085,16 +2165,18 @@ lnk_patch_inlines(TP_Context         *tp,
                   LNK_CodeViewInput  *input,
                   LNK_LeafHashes     *hashes,
                   LNK_LeafHashTable  *leaf_ht_arr,
+                  CV_TypeIndex      **type_index_maps,
                   U64                 obj_count,
                   CV_DebugS          *debug_s_arr)
 {
   ProfBeginFunction();
   
   LNK_PatchInlinesTask task = {0};
-  task.input       = input;
-  task.hashes      = hashes;
-  task.leaf_ht_arr = leaf_ht_arr;
-  task.debug_s_arr = debug_s_arr;
+  task.input           = input;
+  task.hashes          = hashes;
+  task.leaf_ht_arr     = leaf_ht_arr;
+  task.type_index_maps = type_index_maps;
+  task.debug_s_arr     = debug_s_arr;
   tp_for_parallel(tp, 0, obj_count, lnk_patch_inlines_task, &task);
 
   ProfEnd();
@@ -2124,12 +2206,8 @@ THREAD_POOL_TASK_FUNC(lnk_patch_leaves_task)
     for (CV_TypeIndexInfo *ti_info = ti_info_list.first; ti_info != 0; ti_info = ti_info->next) {
       CV_TypeIndex *ti_ptr = (CV_TypeIndex *) (leaf.data.str + ti_info->offset);
       if (*ti_ptr >= ti_lo) {
-        LNK_LeafHashTable *leaf_ht         = &task->leaf_ht_arr[ti_info->source];
-        LNK_LeafRef        sub_leaf_ref    = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
-        LNK_LeafBucket    *sub_leaf_bucket = lnk_leaf_hash_table_search(leaf_ht, task->input, task->hashes, sub_leaf_ref);
-
          // patch index
-        *ti_ptr = sub_leaf_bucket->type_index;
+        *ti_ptr = lnk_merged_type_index_from_loc_idx_and_ti(task->input, task->hashes, task->leaf_ht_arr, task->type_index_maps, loc_type, ti_info->source, loc_idx, *ti_ptr);
       }
     }
 
@@ -2140,7 +2218,7 @@ THREAD_POOL_TASK_FUNC(lnk_patch_leaves_task)
 }
 
 internal void
-lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, LNK_LeafBucketArray bucket_arr)
+lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, LNK_LeafBucketArray bucket_arr)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(0,0);
@@ -2149,6 +2227,7 @@ lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashe
   task.input           = input;
   task.hashes          = hashes;
   task.leaf_ht_arr     = leaf_ht_arr;
+  task.type_index_maps = type_index_maps;
   task.bucket_arr      = bucket_arr.v;
   task.range_arr       = tp_divide_work(scratch.arena, bucket_arr.count, tp->worker_count);
   task.fixed_arena_arr = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, MB(1), MB(1));
@@ -2244,11 +2323,530 @@ THREAD_POOL_TASK_FUNC(lnk_post_process_cv_symbols_task)
   }
 }
 
+internal int
+lnk_type_db_key_compare(U128 a, U128 b)
+{
+  if (a.u64[1] != b.u64[1]) { return a.u64[1] < b.u64[1] ? -1 : +1; }
+  if (a.u64[0] != b.u64[0]) { return a.u64[0] < b.u64[0] ? -1 : +1; }
+  return 0;
+}
+
+internal int
+lnk_type_db_entry_is_before(void *raw_a, void *raw_b)
+{
+  LNK_TypeDBEntry *a = raw_a;
+  LNK_TypeDBEntry *b = raw_b;
+  return lnk_type_db_key_compare(a->key, b->key) < 0;
+}
+
+internal int
+lnk_type_db_type_is_before(void *raw_a, void *raw_b)
+{
+  LNK_TypeDBType *a = raw_a;
+  LNK_TypeDBType *b = raw_b;
+  return lnk_type_db_key_compare(a->hash, b->hash) < 0;
+}
+
+internal B32
+lnk_type_db_read_table(String8 data, U64 *cursor, U64 count, U64 elem_size, void **table_out)
+{
+  B32 fits = *cursor <= data.size && count <= (data.size - *cursor) / elem_size;
+  if (fits) {
+    *table_out  = data.str + *cursor;
+    *cursor    += AlignPow2(count * elem_size, 8);
+  }
+  return fits;
+}
+
+internal B32
+lnk_type_db_validate_types(LNK_TypeDB *db)
+{
+  // leaf type indices must point into the merged types
+  CV_TypeIndex ti_hi = CV_MinComplexTypeIndex + Max(db->type_count[CV_TypeIndexSource_TPI], db->type_count[CV_TypeIndexSource_IPI]);
+  for EachIndex(leaf_idx, db->leaf_count) {
+    if (db->leaf_type_indices[leaf_idx] < CV_MinComplexTypeIndex || db->leaf_type_indices[leaf_idx] >= ti_hi) {
+      return 0;
+    }
+  }
+
+  for (CV_TypeIndexSource ti_source = CV_TypeIndexSource_TPI; ti_source < CV_TypeIndexSource_COUNT; ti_source += 1) {
+    U64      type_count = db->type_count[ti_source];
+    String8  type_data  = db->type_data[ti_source];
+    U64     *offsets    = db->type_data_offsets[ti_source];
+
+    for EachIndex(type_idx, type_count) {
+      if (db->types[ti_source][type_idx].type_index - CV_MinComplexTypeIndex >= type_count) {
+        return 0;
+      }
+    }
+
+    // leaves are laid out back to back in type index order
+    U64 expected_offset = 0;
+    for EachIndex(type_idx, type_count) {
+      if (offsets[type_idx] != expected_offset || type_data.size - expected_offset < sizeof(CV_LeafHeader)) {
+        return 0;
+      }
+      CV_LeafHeader *leaf_header = (CV_LeafHeader *)(type_data.str + expected_offset);
+      U64            leaf_size   = sizeof(leaf_header->size) + leaf_header->size;
+      if (leaf_size < sizeof(CV_LeafHeader) || leaf_size > type_data.size - expected_offset) {
+        return 0;
+      }
+      expected_offset += leaf_size;
+    }
+    if (expected_offset != type_data.size) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+internal LNK_TypeDB *
+lnk_type_db_open(Arena *arena, String8 path)
+{
+  ProfBeginFunction();
+
+  LNK_TypeDB *db = push_array(arena, LNK_TypeDB, 1);
+  db->path       = push_str8_copy(arena, path);
+
+  OS_Handle      file  = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, path);
+  FileProperties props = os_properties_from_file(file);
+  if (!os_handle_match(file, os_handle_zero()) && props.size >= sizeof(LNK_TypeDBHeader)) {
+    OS_Handle map  = os_file_map_open(OS_AccessFlag_Read, file);
+    void     *view = os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, props.size));
+    if (view) {
+      db->file = file;
+      db->map  = map;
+      db->data = str8(view, props.size);
+
+      // validate header and make sure tables fit
+      LNK_TypeDBHeader *header        = (LNK_TypeDBHeader *)db->data.str;
+      B32               is_valid      = header->magic == LNK_TYPE_DB_MAGIC && header->version == LNK_TYPE_DB_VERSION && header->hash_size == sizeof(U128);
+      B32               is_same_build = is_valid && u128_match(header->build_stamp, lnk_type_db_build_stamp());
+
+      LNK_TypeDB parsed = {0};
+      if (is_valid) {
+        U64 cursor         = sizeof(*header);
+        parsed.flags       = header->flags;
+        parsed.entry_count = header->entry_count;
+        parsed.leaf_count  = header->leaf_count;
+        is_valid = lnk_type_db_read_table(db->data, &cursor, parsed.entry_count, sizeof(parsed.entries[0]),           (void **)&parsed.entries)     &&
+                   lnk_type_db_read_table(db->data, &cursor, parsed.leaf_count,  sizeof(parsed.leaf_hashes[0]),       (void **)&parsed.leaf_hashes) &&
+                   lnk_type_db_read_table(db->data, &cursor, parsed.leaf_count,  sizeof(parsed.leaf_type_indices[0]), (void **)&parsed.leaf_type_indices);
+        for (CV_TypeIndexSource ti_source = CV_TypeIndexSource_TPI; is_valid && ti_source < CV_TypeIndexSource_COUNT; ti_source += 1) {
+          parsed.type_count[ti_source]      = header->type_count[ti_source];
+          parsed.full_type_count[ti_source] = header->full_type_count[ti_source];
+          parsed.type_data[ti_source].size  = header->type_data_size[ti_source];
+          is_valid = lnk_type_db_read_table(db->data, &cursor, parsed.type_count[ti_source],     sizeof(parsed.types[ti_source][0]),             (void **)&parsed.types[ti_source])             &&
+                     lnk_type_db_read_table(db->data, &cursor, parsed.type_count[ti_source],     sizeof(parsed.type_data_offsets[ti_source][0]), (void **)&parsed.type_data_offsets[ti_source]) &&
+                     lnk_type_db_read_table(db->data, &cursor, parsed.type_data[ti_source].size, 1,                                              (void **)&parsed.type_data[ti_source].str);
+        }
+        is_valid = is_valid && cursor == db->data.size;
+
+        for (U64 entry_idx = 0; is_valid && entry_idx < parsed.entry_count; entry_idx += 1) {
+          LNK_TypeDBEntry *entry = &parsed.entries[entry_idx];
+          is_valid = entry->leaf_off <= parsed.leaf_count && entry->leaf_count <= parsed.leaf_count - entry->leaf_off;
+        }
+        if (is_valid && is_same_build && (parsed.flags & LNK_TypeDBFlag_HasTypes)) {
+          is_valid = lnk_type_db_validate_types(&parsed);
+        }
+      }
+
+      if (is_valid && is_same_build) {
+        db->flags             = parsed.flags;
+        db->entry_count       = parsed.entry_count;
+        db->entries           = parsed.entries;
+        db->leaf_count        = parsed.leaf_count;
+        db->leaf_hashes       = parsed.leaf_hashes;
+        db->leaf_type_indices = parsed.leaf_type_indices;
+        MemoryCopyArray(db->type_count,        parsed.type_count);
+        MemoryCopyArray(db->full_type_count,   parsed.full_type_count);
+        MemoryCopyArray(db->types,             parsed.types);
+        MemoryCopyArray(db->type_data_offsets, parsed.type_data_offsets);
+        MemoryCopyArray(db->type_data,         parsed.type_data);
+      } else if (is_valid) {
+        lnk_log(LNK_Log_Incremental, "Type DB: %S was written by a different linker build, types will be rehashed", path);
+      } else {
+        lnk_error(LNK_Warning_TypeDb, "%S: unrecognized type database, types will be rehashed", path);
+      }
+    } else {
+      os_file_map_close(map);
+      os_file_close(file);
+    }
+  } else if (!os_handle_match(file, os_handle_zero())) {
+    os_file_close(file);
+  }
+
+  ProfEnd();
+  return db;
+}
+
+internal void
+lnk_type_db_close(LNK_TypeDB *db)
+{
+  if (db->data.size) {
+    os_file_map_view_close(db->map, db->data.str, r1u64(0, db->data.size));
+    os_file_map_close(db->map);
+    os_file_close(db->file);
+  }
+  db->flags             = 0;
+  db->entry_count       = 0;
+  db->entries           = 0;
+  db->leaf_count        = 0;
+  db->leaf_hashes       = 0;
+  db->leaf_type_indices = 0;
+  MemoryZeroArray(db->type_count);
+  MemoryZeroArray(db->full_type_count);
+  MemoryZeroArray(db->types);
+  MemoryZeroArray(db->type_data_offsets);
+  MemoryZeroArray(db->type_data);
+  MemoryZeroStruct(&db->data);
+}
+
+internal void
+lnk_type_db_write(LNK_TypeDB *db, String8 temp_path)
+{
+  ProfBeginFunction();
+
+  // update references tables and leaves in the mapped database, so it is written
+  // to a temporary file first and replaces the database only after unmapping
+  Assert(temp_path.size > 0);
+  LNK_FileWriter writer = lnk_file_writer_open(db->path, temp_path, db->update.total_size);
+  lnk_file_writer_push_list(&writer, db->update);
+  lnk_type_db_close(db);
+  lnk_file_writer_close(&writer);
+
+  ProfEnd();
+}
+
+internal LNK_TypeDBEntry *
+lnk_type_db_lookup(LNK_TypeDB *db, U128 key)
+{
+  LNK_TypeDBEntry *result = 0;
+  for (U64 lo = 0, hi = db->entry_count; lo < hi; ) {
+    U64              mid   = lo + (hi - lo) / 2;
+    LNK_TypeDBEntry *entry = &db->entries[mid];
+    int              cmp   = lnk_type_db_key_compare(key, entry->key);
+    if (cmp == 0) {
+      result = entry;
+      break;
+    }
+    if (cmp < 0) { hi = mid; } else { lo = mid + 1; }
+  }
+  return result;
+}
+
+internal U64
+lnk_type_db_lower_bound(LNK_TypeDBType *types, U64 count, U128 hash)
+{
+  U64 lo = 0, hi = count;
+  while (lo < hi) {
+    U64 mid = lo + (hi - lo) / 2;
+    if (lnk_type_db_key_compare(types[mid].hash, hash) < 0) { lo = mid + 1; } else { hi = mid; }
+  }
+  return lo;
+}
+
+internal CV_TypeIndex
+lnk_type_db_type_index_from_hash(LNK_TypeDB *db, CV_TypeIndexSource ti_source, U128 hash)
+{
+  U64 type_count = db->type_count[ti_source];
+  U64 type_idx   = lnk_type_db_lower_bound(db->types[ti_source], type_count, hash);
+  if (type_idx < type_count && u128_match(db->types[ti_source][type_idx].hash, hash)) {
+    return db->types[ti_source][type_idx].type_index;
+  }
+  return 0;
+}
+
+internal B32
+lnk_type_db_can_merge(LNK_TypeDB *db, LNK_CodeViewInput *input)
+{
+  if (~db->flags & LNK_TypeDBFlag_HasTypes) {
+    return 0;
+  }
+
+  // type indices are recorded for leaves in objs only
+  if (input->external_count > 0) {
+    lnk_log(LNK_Log_Incremental, "Type DB: link uses external type servers, types are merged from scratch");
+    return 0;
+  }
+
+  // types of changed and removed objs stay in the merged types, start over once they outnumber the types of the last full merge
+  for (CV_TypeIndexSource ti_source = CV_TypeIndexSource_TPI; ti_source < CV_TypeIndexSource_COUNT; ti_source += 1) {
+    if (db->type_count[ti_source] > db->full_type_count[ti_source] * 2) {
+      lnk_log(LNK_Log_Incremental, "Type DB: %llu of %llu %S types are stale, types are merged from scratch",
+              db->type_count[ti_source] - db->full_type_count[ti_source], db->type_count[ti_source], cv_string_from_type_index_source(ti_source));
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+internal U128
+lnk_type_db_build_stamp(void)
+{
+  // leaf hashes are only comparable between links done by the same linker build
+  return u128_hash_from_str8(str8_lit(BUILD_TITLE_STRING_LITERAL " [Leaf Hash: blake3]"));
+}
+
+internal U128
+lnk_type_db_key_from_obj(LNK_Obj *obj, U64 leaf_count, LNK_PchInfo pch, U128 pch_key)
+{
+  // obj hash was taken when the input was read, objs without one are not cached
+  B32 uses_pch = pch.ti_lo != pch.ti_hi;
+  if (u128_match(obj->hash, u128_zero()) || (uses_pch && u128_match(pch_key, u128_zero()))) {
+    return u128_zero();
+  }
+
+  // leaf hashes of objs that use precompiled types depend on the .debug$P obj
+  struct {
+    U128         obj_hash;
+    U128         pch_key;
+    U64          leaf_count;
+    CV_TypeIndex ti_lo;
+    CV_TypeIndex ti_hi;
+  } key_data = {0};
+  key_data.obj_hash   = obj->hash;
+  key_data.pch_key    = pch_key;
+  key_data.leaf_count = leaf_count;
+  key_data.ti_lo      = pch.ti_lo;
+  key_data.ti_hi      = pch.ti_hi;
+
+  return lnk_incremental_hash_from_data(str8_struct(&key_data));
+}
+
+internal String8List
+lnk_type_db_serialize(Arena          *arena,
+                      LNK_TypeDB     *base,
+                      U64             obj_count,
+                      U128           *keys,
+                      U128Array     **hashes,
+                      CV_TypeIndex  **type_index_maps,
+                      CV_DebugT      *new_types,
+                      U128          **new_type_hashes,
+                      U64            *full_type_count)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  // gather entries for hashed objs
+  LNK_TypeDBEntry *entries     = push_array(arena, LNK_TypeDBEntry, obj_count);
+  U64              entry_count = 0;
+  for EachIndex(obj_idx, obj_count) {
+    U128Array obj_hashes = hashes[obj_idx][CV_TypeIndexSource_TPI];
+    if (obj_hashes.count == 0 || u128_match(keys[obj_idx], u128_zero())) { continue; }
+    LNK_TypeDBEntry *entry = &entries[entry_count++];
+    entry->key        = keys[obj_idx];
+    entry->leaf_off   = obj_idx; // patched below
+    entry->leaf_count = obj_hashes.count;
+  }
+
+  // sort for binary search and drop duplicate objs
+  radsort(entries, entry_count, lnk_type_db_entry_is_before);
+  U64 unique_count = 0;
+  for EachIndex(entry_idx, entry_count) {
+    if (unique_count > 0 && u128_match(entries[unique_count-1].key, entries[entry_idx].key)) { continue; }
+    entries[unique_count++] = entries[entry_idx];
+  }
+  entry_count = unique_count;
+
+  // lay out leaf hashes and type indices, both reference this link's arrays or the mapped database
+  String8List leaf_hash_data = {0};
+  String8List leaf_ti_data   = {0};
+  U64         leaf_count     = 0;
+  for EachIndex(entry_idx, entry_count) {
+    LNK_TypeDBEntry *entry   = &entries[entry_idx];
+    U64              obj_idx = entry->leaf_off;
+    str8_list_push(arena, &leaf_hash_data, str8_array(hashes[obj_idx][CV_TypeIndexSource_TPI].v, entry->leaf_count));
+    if (type_index_maps) {
+      str8_list_push(arena, &leaf_ti_data, str8_array(type_index_maps[obj_idx], entry->leaf_count));
+    }
+    entry->leaf_off = leaf_count;
+    leaf_count     += entry->leaf_count;
+  }
+  if (!type_index_maps) {
+    str8_list_push(arena, &leaf_ti_data, str8(push_array(arena, U8, leaf_count * sizeof(CV_TypeIndex)), leaf_count * sizeof(CV_TypeIndex)));
+  }
+  U8 *pad = push_array(arena, U8, 8);
+  str8_list_push(arena, &leaf_ti_data, str8(pad, AlignPadPow2(leaf_ti_data.total_size, 8)));
+
+  LNK_TypeDBHeader *header = push_array(arena, LNK_TypeDBHeader, 1);
+  header->magic       = LNK_TYPE_DB_MAGIC;
+  header->version     = LNK_TYPE_DB_VERSION;
+  header->hash_size   = sizeof(U128);
+  header->build_stamp = lnk_type_db_build_stamp();
+  header->entry_count = entry_count;
+  header->leaf_count  = leaf_count;
+
+  String8List result = {0};
+  str8_list_push(arena, &result, str8_struct(header));
+  str8_list_push(arena, &result, str8_array(entries, entry_count));
+  str8_list_concat_in_place(&result, &leaf_hash_data);
+  str8_list_concat_in_place(&result, &leaf_ti_data);
+
+  // append new types to the merged types of the base database
+  if (new_types) {
+    header->flags |= LNK_TypeDBFlag_HasTypes;
+
+    for (CV_TypeIndexSource ti_source = CV_TypeIndexSource_TPI; ti_source < CV_TypeIndexSource_COUNT; ti_source += 1) {
+      U64             base_type_count = base ? base->type_count[ti_source] : 0;
+      LNK_TypeDBType *base_types      = base ? base->types[ti_source] : 0;
+      String8         base_type_data  = base ? base->type_data[ti_source] : str8_zero();
+      CV_DebugT       types           = new_types[ti_source];
+
+      // sort new types by hash
+      LNK_TypeDBType *sorted_types = push_array(arena, LNK_TypeDBType, types.count);
+      for EachIndex(type_idx, types.count) {
+        sorted_types[type_idx].hash       = new_type_hashes[ti_source][type_idx];
+        sorted_types[type_idx].type_index = CV_MinComplexTypeIndex + base_type_count + type_idx;
+      }
+      radsort(sorted_types, types.count, lnk_type_db_type_is_before);
+
+      // merge with base types, runs of base types are referenced from the mapped database
+      String8List type_list = {0};
+      U64         base_cursor = 0;
+      for EachIndex(type_idx, types.count) {
+        U64 insert_idx = base_cursor + lnk_type_db_lower_bound(base_types + base_cursor, base_type_count - base_cursor, sorted_types[type_idx].hash);
+        if (insert_idx > base_cursor) {
+          str8_list_push(arena, &type_list, str8_array(base_types + base_cursor, insert_idx - base_cursor));
+        }
+        str8_list_push(arena, &type_list, str8_struct(&sorted_types[type_idx]));
+        base_cursor = insert_idx;
+      }
+      if (base_cursor < base_type_count) {
+        str8_list_push(arena, &type_list, str8_array(base_types + base_cursor, base_type_count - base_cursor));
+      }
+
+      // copy new leaves, builders may patch them later
+      U64 new_data_size = 0;
+      for EachIndex(type_idx, types.count) {
+        new_data_size += cv_debug_t_get_raw_leaf(types, type_idx).size;
+      }
+      U64 *offsets  = push_array_no_zero(arena, U64, types.count);
+      U8  *new_data = push_array_no_zero(arena, U8, new_data_size);
+      U64  cursor   = 0;
+      for EachIndex(type_idx, types.count) {
+        String8 raw_leaf = cv_debug_t_get_raw_leaf(types, type_idx);
+        offsets[type_idx] = base_type_data.size + cursor;
+        MemoryCopy(new_data + cursor, raw_leaf.str, raw_leaf.size);
+        cursor += raw_leaf.size;
+      }
+
+      header->type_count[ti_source]      = base_type_count + types.count;
+      header->full_type_count[ti_source] = full_type_count[ti_source];
+      header->type_data_size[ti_source]  = base_type_data.size + new_data_size;
+
+      str8_list_concat_in_place(&result, &type_list);
+      if (base_type_count) {
+        str8_list_push(arena, &result, str8_array(base->type_data_offsets[ti_source], base_type_count));
+      }
+      str8_list_push(arena, &result, str8_array(offsets, types.count));
+      str8_list_push(arena, &result, base_type_data);
+      str8_list_push(arena, &result, str8(new_data, new_data_size));
+      str8_list_push(arena, &result, str8(pad, AlignPadPow2(header->type_data_size[ti_source], 8)));
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+  return result;
+}
+
+internal U128 *
+lnk_hashes_from_leaf_bucket_array(Arena *arena, LNK_LeafHashes *hashes, LNK_LeafBucketArray bucket_arr)
+{
+  U128 *result = push_array_no_zero(arena, U128, bucket_arr.count);
+  for EachIndex(bucket_idx, bucket_arr.count) {
+    result[bucket_idx] = lnk_hash_from_leaf_ref(hashes, bucket_arr.v[bucket_idx]->leaf_ref);
+  }
+  return result;
+}
+
+internal CV_DebugT
+lnk_type_db_types_with_new_leaves(Arena *arena, LNK_TypeDB *db, CV_TypeIndexSource ti_source, CV_DebugT new_types)
+{
+  ProfBeginFunction();
+  U64       base_type_count = db->type_count[ti_source];
+  CV_DebugT result          = {0};
+  result.count = base_type_count + new_types.count;
+  result.v     = push_array_no_zero(arena, U8 *, result.count);
+  for EachIndex(type_idx, base_type_count) {
+    result.v[type_idx] = db->type_data[ti_source].str + db->type_data_offsets[ti_source][type_idx];
+  }
+  MemoryCopyTyped(result.v + base_type_count, new_types.v, new_types.count);
+  ProfEnd();
+  return result;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_leaf_merge_with_type_db_task)
+{
+  LNK_LeafMergeWithTypeDB *task    = raw_task;
+  U64                      obj_idx = task->miss_obj_idx_arr[task_id];
+  CV_DebugT                debug_t = task->input->merged_debug_t_p_arr[obj_idx];
+
+  ProfBeginDynamic("Leaf Merge Task 0x%llX [Leaf Count %llu]", obj_idx, debug_t.count);
+
+  CV_TypeIndex   *map    = push_array(arena, CV_TypeIndex, debug_t.count);
+  LNK_LeafBucket *bucket = 0;
+  for EachIndex(leaf_idx, debug_t.count) {
+    CV_LeafHeader     *leaf_header = cv_debug_t_get_leaf_header(debug_t, leaf_idx);
+    CV_TypeIndexSource ti_source   = cv_type_index_source_from_leaf_kind(leaf_header->kind);
+    LNK_LeafRef        leaf_ref    = lnk_obj_leaf_ref(obj_idx, leaf_idx);
+    U128               leaf_hash   = lnk_hash_from_leaf_ref(task->hashes, leaf_ref);
+
+    // leaf was merged in a previous link
+    map[leaf_idx] = lnk_type_db_type_index_from_hash(task->type_db, ti_source, leaf_hash);
+    if (map[leaf_idx] != 0) {
+      continue;
+    }
+
+    // new leaf, dedup it with other new leaves
+    if (bucket == 0) {
+      bucket = push_array_no_zero(arena, LNK_LeafBucket, 1);
+    }
+    bucket->leaf_ref = leaf_ref;
+
+    LNK_LeafBucket *inserted_or_updated = lnk_leaf_hash_table_insert_or_update(&task->leaf_ht_arr[ti_source], task->input, task->hashes, leaf_hash, bucket);
+
+    if (inserted_or_updated != bucket) {
+      bucket = 0;
+    }
+  }
+  task->type_index_maps[obj_idx] = map;
+
+  ProfEnd();
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_map_new_leaves_task)
+{
+  LNK_LeafMergeWithTypeDB *task    = raw_task;
+  U64                      obj_idx = task->miss_obj_idx_arr[task_id];
+  CV_DebugT                debug_t = task->input->merged_debug_t_p_arr[obj_idx];
+  CV_TypeIndex            *map     = task->type_index_maps[obj_idx];
+
+  for EachIndex(leaf_idx, debug_t.count) {
+    if (map[leaf_idx] == 0) {
+      CV_LeafHeader      *leaf_header = cv_debug_t_get_leaf_header(debug_t, leaf_idx);
+      CV_TypeIndexSource  ti_source   = cv_type_index_source_from_leaf_kind(leaf_header->kind);
+      LNK_LeafBucket     *leaf_bucket = lnk_leaf_hash_table_search(&task->leaf_ht_arr[ti_source], task->input, task->hashes, lnk_obj_leaf_ref(obj_idx, leaf_idx));
+      map[leaf_idx] = leaf_bucket->type_index;
+    }
+  }
+}
+
 internal CV_DebugT *
-lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
+lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input, LNK_TypeDB *type_db)
 {
   ProfBegin("Import Types");
 
+  // unchanged objs take type indices from the database when its merged types can be extended
+  B32            merge_with_type_db = type_db && lnk_type_db_can_merge(type_db, input);
+  CV_TypeIndex **type_index_maps    = merge_with_type_db ? push_array(tp_temp->v[0], CV_TypeIndex *, input->internal_count) : 0;
+  U128          *type_db_keys       = type_db ? push_array(tp_temp->v[0], U128, input->internal_count) : 0;
+
   ProfBegin("Hash Leaves");
   LNK_LeafHashes *hashes = push_array(tp_temp->v[0], LNK_LeafHashes, 1);
   {
@@ -2292,9 +2890,12 @@ lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
     ProfEnd();
 
     LNK_LeafHasherTask task = {0};
-    task.input        = input;
-    task.hashes       = hashes;
-    task.fixed_arenas = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, MB(1), MB(1));
+    task.input           = input;
+    task.hashes          = hashes;
+    task.fixed_arenas    = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, MB(1), MB(1));
+    task.type_db         = type_db;
+    task.type_db_keys    = type_db_keys;
+    task.type_index_maps = type_index_maps;
 
     // hash .debug$P first so we can mix in hashes for precompiled sub leaves when hashing leaves in .debug$T
     ProfBeginDynamic("Hash .debug$P [Count: %llu]", input->internal_count);
@@ -2314,110 +2915,209 @@ lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
     tp_for_parallel(tp, 0, input->external_count, lnk_hash_type_server_leaves_task, &task);
     ProfEnd();
 
+    if (type_db) {
+      lnk_log(LNK_Log_Incremental, "Type DB: reused leaf hashes for %llu of %llu objs", type_db->hit_count, type_db->hit_count + type_db->miss_count);
+    }
+
     scratch_end(scratch);
   }
   ProfEnd();
 
-  ProfBegin("Leaf Hash Table Init");
-  LNK_LeafHashTable leaf_ht_arr[CV_TypeIndexSource_COUNT] = { 0 };
-  U64 internal_per_source_count[CV_TypeIndexSource_COUNT] = { 0 };
-  U64 external_per_source_count[CV_TypeIndexSource_COUNT] = { 0 };
-  {
-    // count internal leaves
-    lnk_cv_debug_t_count_leaves_per_source(tp, input->internal_count, input->internal_debug_p_arr, internal_per_source_count);
-    lnk_cv_debug_t_count_leaves_per_source(tp, input->internal_count, input->internal_debug_t_arr, internal_per_source_count);
+  CV_DebugT tpi_types = {0};
+  CV_DebugT ipi_types = {0};
+  if (merge_with_type_db) {
+    ProfBegin("Merge Leaves With Type DB");
+
+    // gather objs that missed the database
+    U64 *miss_obj_idx_arr = push_array_no_zero(tp_temp->v[0], U64, input->internal_count);
+    U64  miss_count       = 0;
+    for EachIndex(obj_idx, input->internal_count) {
+      if (type_index_maps[obj_idx] == 0 && input->merged_debug_t_p_arr[obj_idx].count > 0) {
+        miss_obj_idx_arr[miss_count++] = obj_idx;
+      }
+    }
 
-    // count external leaves
-    for (U64 ts_idx = 0; ts_idx < input->type_server_count; ++ts_idx) {
-      for (U64 ti_source = 0; ti_source < CV_TypeIndexSource_COUNT; ++ti_source) {
-        external_per_source_count[ti_source] += dim_1u64(input->external_ti_ranges[ts_idx][ti_source]);
+    // size hash tables for leaves of changed objs
+    LNK_LeafHashTable leaf_ht_arr[CV_TypeIndexSource_COUNT] = {0};
+    {
+      Temp scratch = scratch_begin(tp_temp->v, tp_temp->count);
+      CV_DebugT *miss_debug_t_arr = push_array_no_zero(scratch.arena, CV_DebugT, miss_count);
+      for EachIndex(miss_idx, miss_count) {
+        miss_debug_t_arr[miss_idx] = input->merged_debug_t_p_arr[miss_obj_idx_arr[miss_idx]];
+      }
+      U64 per_source_count[CV_TypeIndexSource_COUNT] = {0};
+      lnk_cv_debug_t_count_leaves_per_source(tp, miss_count, miss_debug_t_arr, per_source_count);
+      for EachIndex(ti_source, CV_TypeIndexSource_COUNT) {
+        leaf_ht_arr[ti_source].cap        = Max(1, (U64)((F64)per_source_count[ti_source] * 1.3));
+        leaf_ht_arr[ti_source].bucket_arr = push_array(tp_temp->v[0], LNK_LeafBucket *, leaf_ht_arr[ti_source].cap);
       }
+      scratch_end(scratch);
     }
 
-    // push buckets per source
-    for (U64 ti_source = 0; ti_source < CV_TypeIndexSource_COUNT; ++ti_source) {
-      U64 bucket_cap = 0;
-      bucket_cap += internal_per_source_count[ti_source];
-      bucket_cap += external_per_source_count[ti_source];
-      bucket_cap  = (U64) ((F64) bucket_cap * 1.3);
+    // look up leaves of changed objs in the merged types, dedup the rest
+    LNK_LeafMergeWithTypeDB task = {0};
+    task.input                   = input;
+    task.hashes                  = hashes;
+    task.leaf_ht_arr             = leaf_ht_arr;
+    task.type_db                 = type_db;
+    task.type_index_maps         = type_index_maps;
+    task.miss_obj_idx_arr        = miss_obj_idx_arr;
+    tp_for_parallel(tp, tp_temp, miss_count, lnk_leaf_merge_with_type_db_task, &task);
+
+    // new leaves go after the merged types in the order of a full merge
+    LNK_LeafBucketArray tpi_arr = lnk_present_bucket_array_from_leaf_hash_table(tp, tp_temp->v[0], &leaf_ht_arr[CV_TypeIndexSource_TPI]);
+    LNK_LeafBucketArray ipi_arr = lnk_present_bucket_array_from_leaf_hash_table(tp, tp_temp->v[0], &leaf_ht_arr[CV_TypeIndexSource_IPI]);
+    lnk_leaf_bucket_array_sort(tp, ipi_arr, input->internal_count, input->type_server_count);
+    lnk_leaf_bucket_array_sort(tp, tpi_arr, input->internal_count, input->type_server_count);
+    lnk_assign_type_indices(tp, tpi_arr, CV_MinComplexTypeIndex + type_db->type_count[CV_TypeIndexSource_TPI]);
+    lnk_assign_type_indices(tp, ipi_arr, CV_MinComplexTypeIndex + type_db->type_count[CV_TypeIndexSource_IPI]);
+    tp_for_parallel(tp, 0, miss_count, lnk_map_new_leaves_task, &task);
+
+    lnk_log(LNK_Log_Incremental, "Type DB: merged types of %llu objs by lookup, %llu new TPI and %llu new IPI types from %llu changed objs",
+            type_db->hit_count, tpi_arr.count, ipi_arr.count, miss_count);
+
+    // patch indices in symbols, inline sites, and new leaves
+    lnk_patch_symbols(tp, input, hashes, leaf_ht_arr, type_index_maps);
+    lnk_patch_inlines(tp, input, hashes, leaf_ht_arr, type_index_maps, input->count, input->debug_s_arr);
+    lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, type_index_maps, tpi_arr);
+    lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, type_index_maps, ipi_arr);
+
+    CV_DebugT new_types[CV_TypeIndexSource_COUNT] = {0};
+    U128     *new_type_hashes[CV_TypeIndexSource_COUNT] = {0};
+    new_types[CV_TypeIndexSource_TPI]       = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, tpi_arr);
+    new_types[CV_TypeIndexSource_IPI]       = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, ipi_arr);
+    new_type_hashes[CV_TypeIndexSource_TPI] = lnk_hashes_from_leaf_bucket_array(tp_temp->v[0], hashes, tpi_arr);
+    new_type_hashes[CV_TypeIndexSource_IPI] = lnk_hashes_from_leaf_bucket_array(tp_temp->v[0], hashes, ipi_arr);
+
+    type_db->update = lnk_type_db_serialize(tp_temp->v[0], type_db, input->internal_count, type_db_keys, hashes->internal_hashes, type_index_maps, new_types, new_type_hashes, type_db->full_type_count);
+
+    tpi_types = lnk_type_db_types_with_new_leaves(tp_temp->v[0], type_db, CV_TypeIndexSource_TPI, new_types[CV_TypeIndexSource_TPI]);
+    ipi_types = lnk_type_db_types_with_new_leaves(tp_temp->v[0], type_db, CV_TypeIndexSource_IPI, new_types[CV_TypeIndexSource_IPI]);
 
-      #if PROFILE_TELEMETRY
-      tmMessage(0, TMMF_ICON_NOTE, "%.*s Bucket Count: %llu", str8_varg(cv_string_from_type_index_source(ti_source)), bucket_cap);
-      #endif
+    ProfEnd();
+  } else {
+    ProfBegin("Leaf Hash Table Init");
+    LNK_LeafHashTable leaf_ht_arr[CV_TypeIndexSource_COUNT] = { 0 };
+    U64 internal_per_source_count[CV_TypeIndexSource_COUNT] = { 0 };
+    U64 external_per_source_count[CV_TypeIndexSource_COUNT] = { 0 };
+    {
+      // count internal leaves
+      lnk_cv_debug_t_count_leaves_per_source(tp, input->internal_count, input->internal_debug_p_arr, internal_per_source_count);
+      lnk_cv_debug_t_count_leaves_per_source(tp, input->internal_count, input->internal_debug_t_arr, internal_per_source_count);
+
+      // count external leaves
+      for (U64 ts_idx = 0; ts_idx < input->type_server_count; ++ts_idx) {
+        for (U64 ti_source = 0; ti_source < CV_TypeIndexSource_COUNT; ++ti_source) {
+          external_per_source_count[ti_source] += dim_1u64(input->external_ti_ranges[ts_idx][ti_source]);
+        }
+      }
+
+      // push buckets per source
+      for (U64 ti_source = 0; ti_source < CV_TypeIndexSource_COUNT; ++ti_source) {
+        U64 bucket_cap = 0;
+        bucket_cap += internal_per_source_count[ti_source];
+        bucket_cap += external_per_source_count[ti_source];
+        bucket_cap  = (U64) ((F64) bucket_cap * 1.3);
 
-      leaf_ht_arr[ti_source].cap        = bucket_cap;
-      leaf_ht_arr[ti_source].bucket_arr = push_array(tp_temp->v[0], LNK_LeafBucket *, bucket_cap);
+        #if PROFILE_TELEMETRY
+        tmMessage(0, TMMF_ICON_NOTE, "%.*s Bucket Count: %llu", str8_varg(cv_string_from_type_index_source(ti_source)), bucket_cap);
+        #endif
+
+        leaf_ht_arr[ti_source].cap        = bucket_cap;
+        leaf_ht_arr[ti_source].bucket_arr = push_array(tp_temp->v[0], LNK_LeafBucket *, bucket_cap);
+      }
     }
-  }
-  ProfEnd();
+    ProfEnd();
 
 #if PROFILE_TELEMETRY
-  String8 obj_count_string = str8_from_count(tp_temp->v[0], input->internal_count);
-  String8 tpi_count_string = str8_from_count(tp_temp->v[0], internal_per_source_count[CV_TypeIndexSource_TPI]);
-  String8 ipi_count_string = str8_from_count(tp_temp->v[0], internal_per_source_count[CV_TypeIndexSource_IPI]);
-  ProfBeginDynamic("Internal Leaf Dedup [Obj Count: %.*s, TPI: %.*s, IPI: %.*s]",
-                           str8_varg(obj_count_string),
-                           str8_varg(tpi_count_string),
-                           str8_varg(ipi_count_string));
+    String8 obj_count_string = str8_from_count(tp_temp->v[0], input->internal_count);
+    String8 tpi_count_string = str8_from_count(tp_temp->v[0], internal_per_source_count[CV_TypeIndexSource_TPI]);
+    String8 ipi_count_string = str8_from_count(tp_temp->v[0], internal_per_source_count[CV_TypeIndexSource_IPI]);
+    ProfBeginDynamic("Internal Leaf Dedup [Obj Count: %.*s, TPI: %.*s, IPI: %.*s]",
+                             str8_varg(obj_count_string),
+                             str8_varg(tpi_count_string),
+                             str8_varg(ipi_count_string));
 #endif
-  {
+    {
 
-    LNK_LeafDedupInternal task;
-    task.input       = input;
-    task.hashes      = hashes;
-    task.leaf_ht_arr = leaf_ht_arr;
+      LNK_LeafDedupInternal task;
+      task.input       = input;
+      task.hashes      = hashes;
+      task.leaf_ht_arr = leaf_ht_arr;
 
-    ProfBegin("Dedup .debug$P");
-    task.debug_t_arr = input->internal_debug_p_arr;
-    tp_for_parallel(tp, tp_temp, input->internal_count, lnk_leaf_dedup_internal_task, &task);
-    ProfEnd();
+      ProfBegin("Dedup .debug$P");
+      task.debug_t_arr = input->internal_debug_p_arr;
+      tp_for_parallel(tp, tp_temp, input->internal_count, lnk_leaf_dedup_internal_task, &task);
+      ProfEnd();
 
-    ProfBegin("Dedup .debug$T");
-    task.debug_t_arr = input->internal_debug_t_arr;
-    tp_for_parallel(tp, tp_temp, input->internal_count, lnk_leaf_dedup_internal_task, &task);
+      ProfBegin("Dedup .debug$T");
+      task.debug_t_arr = input->internal_debug_t_arr;
+      tp_for_parallel(tp, tp_temp, input->internal_count, lnk_leaf_dedup_internal_task, &task);
+      ProfEnd();
+    }
     ProfEnd();
-  }
-  ProfEnd();
 
-  ProfBeginDynamic("External Leaf Import [Type Server Count: %llu, Dependent Obj Count: %llu]", input->type_server_count, input->external_count);
-  {
-    LNK_LeafDedupExternal task = {0};
-    task.input                 = input;
-    task.hashes                = hashes;
-    task.leaf_ht_arr           = leaf_ht_arr;
-
-    ProfBeginDynamic("Dedup TPI [Leaf Count %llu]", external_per_source_count[CV_TypeIndexSource_TPI]);
-    task.dedup_ti_source = CV_TypeIndexSource_TPI;
-    tp_for_parallel(tp, tp_temp, input->type_server_count, lnk_leaf_dedup_external_task, &task);
-    ProfEnd();
+    ProfBeginDynamic("External Leaf Import [Type Server Count: %llu, Dependent Obj Count: %llu]", input->type_server_count, input->external_count);
+    {
+      LNK_LeafDedupExternal task = {0};
+      task.input                 = input;
+      task.hashes                = hashes;
+      task.leaf_ht_arr           = leaf_ht_arr;
+
+      ProfBeginDynamic("Dedup TPI [Leaf Count %llu]", external_per_source_count[CV_TypeIndexSource_TPI]);
+      task.dedup_ti_source = CV_TypeIndexSource_TPI;
+      tp_for_parallel(tp, tp_temp, input->type_server_count, lnk_leaf_dedup_external_task, &task);
+      ProfEnd();
 
-    ProfBeginDynamic("Dedup IPI [Leaf Count %llu]", external_per_source_count[CV_TypeIndexSource_IPI]);
-    task.dedup_ti_source = CV_TypeIndexSource_IPI;
-    tp_for_parallel(tp, tp_temp, input->type_server_count, lnk_leaf_dedup_external_task, &task);
+      ProfBeginDynamic("Dedup IPI [Leaf Count %llu]", external_per_source_count[CV_TypeIndexSource_IPI]);
+      task.dedup_ti_source = CV_TypeIndexSource_IPI;
+      tp_for_parallel(tp, tp_temp, input->type_server_count, lnk_leaf_dedup_external_task, &task);
+      ProfEnd();
+    }
     ProfEnd();
-  }
-  ProfEnd();
 
-  // extract present buckets from the hash tables
-  LNK_LeafBucketArray tpi_arr = lnk_present_bucket_array_from_leaf_hash_table(tp, tp_temp->v[0], &leaf_ht_arr[CV_TypeIndexSource_TPI]);
-  LNK_LeafBucketArray ipi_arr = lnk_present_bucket_array_from_leaf_hash_table(tp, tp_temp->v[0], &leaf_ht_arr[CV_TypeIndexSource_IPI]);
+    // extract present buckets from the hash tables
+    LNK_LeafBucketArray tpi_arr = lnk_present_bucket_array_from_leaf_hash_table(tp, tp_temp->v[0], &leaf_ht_arr[CV_TypeIndexSource_TPI]);
+    LNK_LeafBucketArray ipi_arr = lnk_present_bucket_array_from_leaf_hash_table(tp, tp_temp->v[0], &leaf_ht_arr[CV_TypeIndexSource_IPI]);
 
-  // sort output leaves based on { location index, leaf index } to guarantee determinism
-  lnk_leaf_bucket_array_sort(tp, ipi_arr, input->internal_count, input->type_server_count);
-  lnk_leaf_bucket_array_sort(tp, tpi_arr, input->internal_count, input->type_server_count);
+    // sort output leaves based on { location index, leaf index } to guarantee determinism
+    lnk_leaf_bucket_array_sort(tp, ipi_arr, input->internal_count, input->type_server_count);
+    lnk_leaf_bucket_array_sort(tp, tpi_arr, input->internal_count, input->type_server_count);
 
-  // assign type indices to each bucket
-  lnk_assign_type_indices(tp, tpi_arr, CV_MinComplexTypeIndex);
-  lnk_assign_type_indices(tp, ipi_arr, CV_MinComplexTypeIndex);
+    // assign type indices to each bucket
+    lnk_assign_type_indices(tp, tpi_arr, CV_MinComplexTypeIndex);
+    lnk_assign_type_indices(tp, ipi_arr, CV_MinComplexTypeIndex);
 
-  // patch indices in symbols, inline sites, and leaves
-  lnk_patch_symbols(tp, input, hashes, leaf_ht_arr);
-  lnk_patch_inlines(tp, input, hashes, leaf_ht_arr, input->count, input->debug_s_arr);
-  lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, tpi_arr);
-  lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, ipi_arr);
+    // record type indices of obj leaves for the database
+    B32 record_types = type_db && input->external_count == 0;
+    if (record_types) {
+      type_index_maps = lnk_type_index_maps_from_leaf_hash_tables(tp, tp_temp, input, hashes, leaf_ht_arr);
+    }
 
-  CV_DebugT tpi_types = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, tpi_arr);
-  CV_DebugT ipi_types = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, ipi_arr);
+    // patch indices in symbols, inline sites, and leaves
+    lnk_patch_symbols(tp, input, hashes, leaf_ht_arr, type_index_maps);
+    lnk_patch_inlines(tp, input, hashes, leaf_ht_arr, type_index_maps, input->count, input->debug_s_arr);
+    lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, type_index_maps, tpi_arr);
+    lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, type_index_maps, ipi_arr);
+
+    tpi_types = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, tpi_arr);
+    ipi_types = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, ipi_arr);
+
+    if (type_db) {
+      CV_DebugT new_types[CV_TypeIndexSource_COUNT] = {0};
+      U128     *new_type_hashes[CV_TypeIndexSource_COUNT] = {0};
+      U64       full_type_count[CV_TypeIndexSource_COUNT] = {0};
+      if (record_types) {
+        new_types[CV_TypeIndexSource_TPI]       = tpi_types;
+        new_types[CV_TypeIndexSource_IPI]       = ipi_types;
+        new_type_hashes[CV_TypeIndexSource_TPI] = lnk_hashes_from_leaf_bucket_array(tp_temp->v[0], hashes, tpi_arr);
+        new_type_hashes[CV_TypeIndexSource_IPI] = lnk_hashes_from_leaf_bucket_array(tp_temp->v[0], hashes, ipi_arr);
+        full_type_count[CV_TypeIndexSource_TPI] = tpi_types.count;
+        full_type_count[CV_TypeIndexSource_IPI] = ipi_types.count;
+      }
+      type_db->update = lnk_type_db_serialize(tp_temp->v[0], 0, input->internal_count, type_db_keys, hashes->internal_hashes, type_index_maps, record_types ? new_types : 0, new_type_hashes, full_type_count);
+    }
+  }
 
   ProfBegin("Post Process CV Symbols");
   {
@@ -2454,6 +3154,16 @@ lnk_format_u128(U8 *buf, U64 buf_max, U64 length, U128 v)
   return size;
 }
 
+internal CV_Leaf
+lnk_copy_leaf_for_replace(Arena *arena, CV_DebugT debug_t, U64 leaf_idx)
+{
+  String8 raw_leaf    = cv_debug_t_get_raw_leaf(debug_t, leaf_idx);
+  U8     *leaf_copy   = push_array_no_zero(arena, U8, raw_leaf.size);
+  MemoryCopy(leaf_copy, raw_leaf.str, raw_leaf.size);
+  debug_t.v[leaf_idx] = leaf_copy;
+  return cv_debug_t_get_leaf(debug_t, leaf_idx);
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_replace_type_names_with_hashes_lenient_task)
 {
@@ -2483,6 +3193,12 @@ THREAD_POOL_TASK_FUNC(lnk_replace_type_names_with_hashes_lenient_task)
       if ((udt_info.props & CV_TypeProp_HasUniqueName) &&
            udt_info.unique_name.size > hash_max_chars &&
            udt_info.name.size > hash_max_chars) {
+        // type data is shared with the concurrent RDI builder, replace names in a copy
+        if (task->copy_leaves) {
+          leaf     = lnk_copy_leaf_for_replace(arena, debug_t, leaf_idx);
+          udt_info = cv_get_udt_info(leaf.kind, leaf.data);
+        }
+
         // hash unique name
         U128 name_hash;
         blake3_hasher hasher; blake3_hasher_init(&hasher);
@@ -2566,6 +3282,12 @@ THREAD_POOL_TASK_FUNC(lnk_replace_type_names_with_hashes_full_task)
       CV_UDTInfo udt_info = cv_get_udt_info(leaf.kind, leaf.data);
 
       if (udt_info.name.size > hash_max_chars) {
+        // type data is shared with the concurrent RDI builder, replace names in a copy
+        if (task->copy_leaves) {
+          leaf     = lnk_copy_leaf_for_replace(arena, debug_t, leaf_idx);
+          udt_info = cv_get_udt_info(leaf.kind, leaf.data);
+        }
+
         // pick name to hash
         String8 name;
         if (udt_info.props & CV_TypeProp_HasUniqueName) {
@@ -2607,17 +3329,25 @@ THREAD_POOL_TASK_FUNC(lnk_replace_type_names_with_hashes_full_task)
   ProfEnd();
 }
 
-internal void
-lnk_replace_type_names_with_hashes(TP_Context *tp, TP_Arena *arena, CV_DebugT debug_t, LNK_TypeNameHashMode mode, U64 hash_length, String8 map_name)
+internal CV_DebugT
+lnk_replace_type_names_with_hashes(TP_Context *tp, TP_Arena *arena, CV_DebugT debug_t, LNK_TypeNameHashMode mode, U64 hash_length, String8 map_name, B32 copy_leaves)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(arena->v, arena->count);
 
+  // replaced leaves are copied, so give them a separate leaf table
+  CV_DebugT result = debug_t;
+  if (copy_leaves) {
+    result.v = push_array_no_zero(arena->v[0], U8 *, debug_t.count);
+    MemoryCopy(result.v, debug_t.v, sizeof(debug_t.v[0]) * debug_t.count);
+  }
+
   // init task context
   LNK_TypeNameReplacer task = {0};
-  task.debug_t              = debug_t;
+  task.debug_t              = result;
   task.ranges               = tp_divide_work(scratch.arena, debug_t.count, tp->worker_count);
   task.hash_length          = Clamp(1, hash_length, 16);
+  task.copy_leaves          = copy_leaves;
 
   if (map_name.size > 0) {
     task.make_map  = 1;
@@ -2649,6 +3379,26 @@ lnk_replace_type_names_with_hashes(TP_Context *tp, TP_Arena *arena, CV_DebugT de
 
   scratch_end(scratch);
   ProfEnd();
+  return result;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_copy_symbol_lists_task)
+{
+  U64                         obj_idx        = task_id;
+  LNK_ProcessSymDataTaskData *task           = raw_task;
+  CV_SymbolListArray          parsed_symbols = task->parsed_symbols[obj_idx];
+  CV_SymbolListArray         *copy           = &task->parsed_symbols_copy[obj_idx];
+
+  copy->count = parsed_symbols.count;
+  copy->v     = push_array(arena, CV_SymbolList, parsed_symbols.count);
+  for (U64 i = 0; i < parsed_symbols.count; ++i) {
+    for (CV_SymbolNode *symbol_n = parsed_symbols.v[i].first; symbol_n != 0; symbol_n = symbol_n->next) {
+      CV_SymbolNode *copy_n = cv_symbol_list_push(arena, &copy->v[i]);
+      copy_n->data          = symbol_n->data;
+      copy_n->data.data     = push_str8_copy(arena, symbol_n->data.data);
+    }
+  }
 }
 
 internal
@@ -2788,9 +3538,15 @@ THREAD_POOL_TASK_FUNC(lnk_process_c13_data_task)
   LNK_ProcessC13DataTask *task    = raw_task;
   CV_DebugS               debug_s = task->debug_s_arr[obj_idx];
 
+  // obj sub-sections are patched in place, unless the RDI builder is reading them
+  // at the same time, then patch copies instead
+  String8List *checksum_data = cv_sub_section_ptr_from_debug_s(&debug_s, CV_C13SubSectionKind_FileChksms);
+  if (task->copy_shared_inputs) {
+    *checksum_data = str8_list_copy(arena, checksum_data);
+  }
+
   // parse checksum data
-  String8List     checksum_data = cv_sub_section_from_debug_s(debug_s, CV_C13SubSectionKind_FileChksms);
-  CV_ChecksumList checksum_list = cv_c13_parse_checksum_data_list(scratch.arena, checksum_data);
+  CV_ChecksumList checksum_list = cv_c13_parse_checksum_data_list(scratch.arena, *checksum_data);
 
   // get strings sub-section
   String8 string_data = cv_string_table_from_debug_s(debug_s);
@@ -2811,10 +3567,14 @@ THREAD_POOL_TASK_FUNC(lnk_process_c13_data_task)
   U64          checksum_base            = mod_checksum_data->total_size;
   B32          is_checksum_patch_needed = checksum_base > 0;
   if (is_checksum_patch_needed) {
-    String8List line_data  = cv_sub_section_from_debug_s(debug_s, CV_C13SubSectionKind_Lines);
-    String8List frame_data = cv_sub_section_from_debug_s(debug_s, CV_C13SubSectionKind_FrameData);
-    cv_c13_patch_checksum_offsets_in_line_data_list(line_data, checksum_base);
-    cv_c13_patch_checksum_offsets_in_frame_data_list(frame_data, checksum_base);
+    String8List *line_data  = cv_sub_section_ptr_from_debug_s(&debug_s, CV_C13SubSectionKind_Lines);
+    String8List *frame_data = cv_sub_section_ptr_from_debug_s(&debug_s, CV_C13SubSectionKind_FrameData);
+    if (task->copy_shared_inputs) {
+      *line_data  = str8_list_copy(arena, line_data);
+      *frame_data = str8_list_copy(arena, frame_data);
+    }
+    cv_c13_patch_checksum_offsets_in_line_data_list(*line_data, checksum_base);
+    cv_c13_patch_checksum_offsets_in_frame_data_list(*frame_data, checksum_base);
   }
 
   // push obj c13 data to module
@@ -2833,7 +3593,7 @@ THREAD_POOL_TASK_FUNC(lnk_process_c13_data_task)
 }
 
 internal LNK_ProcessedCodeViewC13Data
-lnk_process_c13_data(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_DebugS *debug_s_arr, U64 string_data_base_offset, CV_StringHashTable string_ht, MSF_Context *msf, PDB_DbiModule **mod_arr)
+lnk_process_c13_data(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_DebugS *debug_s_arr, U64 string_data_base_offset, CV_StringHashTable string_ht, MSF_Context *msf, PDB_DbiModule **mod_arr, B32 copy_shared_inputs)
 {
   ProfBeginFunction();
 
@@ -2845,6 +3605,7 @@ lnk_process_c13_data(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_DebugS *
   task.source_file_names_list_arr = push_array_no_zero(arena->v[0], String8List, obj_count);
   task.string_data_base_offset    = string_data_base_offset;
   task.string_ht                  = string_ht;
+  task.copy_shared_inputs         = copy_shared_inputs;
   tp_for_parallel(tp, arena, obj_count, lnk_process_c13_data_task, &task);
   
   // fill out result
@@ -3095,7 +3856,8 @@ lnk_build_pdb(TP_Context               *tp,
               U64                       total_symbol_input_count,
               LNK_CodeViewSymbolsInput *symbol_inputs,
               CV_SymbolListArray       *parsed_symbols,
-              CV_DebugT                 types[CV_TypeIndexSource_COUNT])
+              CV_DebugT                 types[CV_TypeIndexSource_COUNT],
+              B32                       copy_shared_inputs)
 {
   ProfBegin("PDB");
   Temp scratch = scratch_begin(tp_arena->v, tp_arena->count);
@@ -3115,6 +3877,19 @@ lnk_build_pdb(TP_Context               *tp,
   pdb_type_server_push_parallel(tp, pdb->type_servers[CV_TypeIndexSource_IPI], types[CV_TypeIndexSource_IPI]);
   pdb_type_server_push_parallel(tp, pdb->type_servers[CV_TypeIndexSource_TPI], types[CV_TypeIndexSource_TPI]);
 
+  // PDB moves global symbols out of the module lists, assigns stream offsets and
+  // patches scope parent and end offsets into the records, so when the RDI builder
+  // reads the originals concurrently work on a deep copy of the nodes and record bytes
+  if (copy_shared_inputs) {
+    ProfBegin("Copy Symbol Lists");
+    LNK_ProcessSymDataTaskData task = {0};
+    task.parsed_symbols             = parsed_symbols;
+    task.parsed_symbols_copy        = push_array(tp_arena->v[0], CV_SymbolListArray, obj_count);
+    tp_for_parallel(tp, tp_arena, obj_count, lnk_copy_symbol_lists_task, &task);
+    parsed_symbols = task.parsed_symbols_copy;
+    ProfEnd();
+  }
+
   ProfBegin("Collect Symbols for GSI");
   CV_SymbolList *gsi_list_arr = push_array(scratch.arena, CV_SymbolList, obj_count);
   {
@@ -3162,7 +3937,7 @@ lnk_build_pdb(TP_Context               *tp,
       ProfEnd();
 
       LNK_ProcessedCodeViewC11Data processed_c11 = lnk_process_c11_data(tp, tp_arena, obj_count, debug_s_arr, string_data_base_offset, string_ht, pdb->msf, mod_arr);
-      LNK_ProcessedCodeViewC13Data processed_c13 = lnk_process_c13_data(tp, tp_arena, obj_count, debug_s_arr, string_data_base_offset, string_ht, pdb->msf, mod_arr);
+      LNK_ProcessedCodeViewC13Data processed_c13 = lnk_process_c13_data(tp, tp_arena, obj_count, debug_s_arr, string_data_base_offset, string_ht, pdb->msf, mod_arr, copy_shared_inputs);
 
       ProfEnd();
 
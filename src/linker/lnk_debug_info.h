@@ -155,6 +155,77 @@ typedef struct
   B8                 *is_corrupted;
 } LNK_GetExternalLeavesTask;
 
+// --- Type DB -----------------------------------------------------------------
+
+#define LNK_TYPE_DB_MAGIC   0x4244505954444152ull // "RADTYPDB"
+#define LNK_TYPE_DB_VERSION 3
+
+enum
+{
+  LNK_TypeDBFlag_HasTypes = (1 << 0), // merged types and per-leaf type indices are present
+};
+
+// on-disk layout:
+//  header
+//  entries sorted by key
+//  leaf hashes of every entry
+//  leaf type indices of every entry (padded to 8 bytes)
+//  per TPI and IPI:
+//   merged types sorted by hash
+//   offsets of merged leaves in type index order
+//   merged leaf data (padded to 8 bytes)
+typedef struct LNK_TypeDBHeader
+{
+  U64  magic;
+  U32  version;
+  U32  hash_size;
+  U128 build_stamp; // linker build and leaf hash algorithm that produced the hashes
+  U64  flags;
+  U64  entry_count;
+  U64  leaf_count;
+  U64  type_count[CV_TypeIndexSource_COUNT];
+  U64  full_type_count[CV_TypeIndexSource_COUNT]; // type count after the last full merge
+  U64  type_data_size[CV_TypeIndexSource_COUNT];
+} LNK_TypeDBHeader;
+
+typedef struct LNK_TypeDBEntry
+{
+  U128 key;        // hash of obj's contents and its precompiled types
+  U64  leaf_off;   // first leaf hash and type index
+  U64  leaf_count; // number of leaves in .debug$T or .debug$P
+} LNK_TypeDBEntry;
+
+typedef struct LNK_TypeDBType
+{
+  U128         hash;
+  CV_TypeIndex type_index;
+  U32          pad;
+} LNK_TypeDBType;
+
+typedef struct LNK_TypeDB
+{
+  String8          path;
+  OS_Handle        file;
+  OS_Handle        map;
+  String8          data;
+  U64              flags;
+  U64              entry_count;
+  LNK_TypeDBEntry *entries;
+  U64              leaf_count;
+  U128            *leaf_hashes;
+  CV_TypeIndex    *leaf_type_indices;
+  U64              type_count[CV_TypeIndexSource_COUNT];
+  U64              full_type_count[CV_TypeIndexSource_COUNT];
+  LNK_TypeDBType  *types[CV_TypeIndexSource_COUNT];
+  U64             *type_data_offsets[CV_TypeIndexSource_COUNT];
+  String8          type_data[CV_TypeIndexSource_COUNT];
+
+  // filled out during type import
+  U64              hit_count;
+  U64              miss_count;
+  String8List      update;
+} LNK_TypeDB;
+
 // --- Leaf Deduping Tasks -----------------------------------------------------
 
 typedef struct
@@ -169,6 +240,9 @@ typedef struct
   LNK_LeafHashes    *hashes;
   Arena            **fixed_arenas;
   CV_DebugT         *debug_t_arr;
+  LNK_TypeDB        *type_db;
+  U128              *type_db_keys;
+  CV_TypeIndex     **type_index_maps;
 } LNK_LeafHasherTask;
 
 typedef struct
@@ -179,6 +253,24 @@ typedef struct
   CV_DebugT          *debug_t_arr;
 } LNK_LeafDedupInternal;
 
+typedef struct
+{
+  LNK_CodeViewInput  *input;
+  LNK_LeafHashes     *hashes;
+  LNK_LeafHashTable  *leaf_ht_arr;
+  LNK_TypeDB         *type_db;
+  CV_TypeIndex      **type_index_maps;
+  U64                *miss_obj_idx_arr;
+} LNK_LeafMergeWithTypeDB;
+
+typedef struct
+{
+  LNK_CodeViewInput  *input;
+  LNK_LeafHashes     *hashes;
+  LNK_LeafHashTable  *leaf_ht_arr;
+  CV_TypeIndex      **type_index_maps;
+} LNK_TypeIndexMapsTask;
+
 typedef struct
 {
   LNK_CodeViewInput  *input;
@@ -240,6 +332,7 @@ typedef struct
   LNK_CodeViewInput  *input;
   LNK_LeafHashes     *hashes;
   LNK_LeafHashTable  *leaf_ht_arr;
+  CV_TypeIndex      **type_index_maps;
   CV_SymbolList      *symbol_list_arr;
   Arena             **arena_arr;
 } LNK_PatchSymbolTypesTask;
@@ -249,6 +342,7 @@ typedef struct
   LNK_CodeViewInput *input;
   LNK_LeafHashes    *hashes;
   LNK_LeafHashTable *leaf_ht_arr;
+  CV_TypeIndex     **type_index_maps;
   CV_DebugS         *debug_s_arr;
 } LNK_PatchInlinesTask;
 
@@ -257,6 +351,7 @@ typedef struct
   LNK_CodeViewInput  *input;
   LNK_LeafHashes     *hashes;
   LNK_LeafHashTable  *leaf_ht_arr;
+  CV_TypeIndex      **type_index_maps;
   LNK_LeafBucket    **bucket_arr;
   Rng1U64            *range_arr;
   Arena             **fixed_arena_arr;
@@ -288,6 +383,7 @@ typedef struct
   PDB_DbiModule            **mod_arr;
   String8List               *symbol_data_arr;
   CV_SymbolList             *gsi_list_arr;
+  CV_SymbolListArray        *parsed_symbols_copy;
 } LNK_ProcessSymDataTaskData;
 
 typedef struct
@@ -299,6 +395,7 @@ typedef struct
   String8List        *source_file_names_list_arr;
   U64                 string_data_base_offset;
   CV_StringHashTable  string_ht;
+  B32                 copy_shared_inputs;
 } LNK_ProcessC13DataTask;
 
 typedef struct
@@ -377,6 +474,7 @@ typedef struct
   B32          make_map;
   TP_Arena    *map_arena;
   String8List *maps;
+  B32          copy_leaves;
 } LNK_TypeNameReplacer;
 
 // --- RAD Debug Info ----------------------------------------------------------
@@ -527,13 +625,27 @@ internal LNK_LeafBucketArray lnk_present_bucket_array_from_leaf_hash_table(TP_Co
 internal void                lnk_leaf_bucket_array_sort_radix_subset_parallel(TP_Context *tp, U64 bucket_count, U64 loc_idx_max, LNK_LeafBucket **dst, LNK_LeafBucket **src);
 internal void                lnk_leaf_bucket_array_sort_radix_parallel(TP_Context *tp, LNK_LeafBucketArray arr, U64 obj_count, U64 type_server_count);
 internal void                lnk_assign_type_indices(TP_Context *tp, LNK_LeafBucketArray bucket_arr, CV_TypeIndex min_type_index);
-internal void                lnk_patch_symbols(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr);
-internal void                lnk_patch_inlines(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, U64 obj_count, CV_DebugS *debug_s_arr);
-internal void                lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, LNK_LeafBucketArray bucket_arr);
+internal CV_TypeIndex        lnk_merged_type_index_from_loc_idx_and_ti(LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, LNK_LeafLocType loc_type, CV_TypeIndexSource ti_source, U64 loc_idx, CV_TypeIndex obj_ti);
+internal CV_TypeIndex **     lnk_type_index_maps_from_leaf_hash_tables(TP_Context *tp, TP_Arena *arena, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr);
+internal void                lnk_patch_symbols(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps);
+internal void                lnk_patch_inlines(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, U64 obj_count, CV_DebugS *debug_s_arr);
+internal void                lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, LNK_LeafBucketArray bucket_arr);
 internal String8Node *       lnk_copy_raw_leaf_arr_to_type_server(TP_Context *tp, CV_DebugT types, PDB_TypeServer *type_server);
-internal CV_DebugT *         lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input);
+internal CV_DebugT *         lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input, LNK_TypeDB *type_db);
+
+// --- Type DB -----------------------------------------------------------------
+
+internal LNK_TypeDB *      lnk_type_db_open(Arena *arena, String8 path);
+internal void              lnk_type_db_close(LNK_TypeDB *db);
+internal void              lnk_type_db_write(LNK_TypeDB *db, String8 temp_path);
+internal LNK_TypeDBEntry * lnk_type_db_lookup(LNK_TypeDB *db, U128 key);
+internal CV_TypeIndex      lnk_type_db_type_index_from_hash(LNK_TypeDB *db, CV_TypeIndexSource ti_source, U128 hash);
+internal B32               lnk_type_db_can_merge(LNK_TypeDB *db, LNK_CodeViewInput *input);
+internal U128              lnk_type_db_build_stamp(void);
+internal U128              lnk_type_db_key_from_obj(LNK_Obj *obj, U64 leaf_count, LNK_PchInfo pch, U128 pch_key);
+internal String8List       lnk_type_db_serialize(Arena *arena, LNK_TypeDB *base, U64 obj_count, U128 *keys, U128Array **hashes, CV_TypeIndex **type_index_maps, CV_DebugT *new_types, U128 **new_type_hashes, U64 *full_type_count);
 
-internal void lnk_replace_type_names_with_hashes(TP_Context *tp, TP_Arena *arena, CV_DebugT debug_t, LNK_TypeNameHashMode mode, U64 hash_length, String8 map_name);
+internal CV_DebugT lnk_replace_type_names_with_hashes(TP_Context *tp, TP_Arena *arena, CV_DebugT debug_t, LNK_TypeNameHashMode mode, U64 hash_length, String8 map_name, B32 copy_leaves);
 
 // --- RAD Debug info ----------------------------------------------------------
 
@@ -564,7 +676,7 @@ internal String8List lnk_build_rad_debug_info(TP_Context               *tp,
 // --- PDB ---------------------------------------------------------------------
 
 internal LNK_ProcessedCodeViewC11Data lnk_process_c11_data(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_DebugS *debug_s_arr, U64 string_data_base_offset, CV_StringHashTable string_ht, MSF_Context *msf, PDB_DbiModule **mod_arr);
-internal LNK_ProcessedCodeViewC13Data lnk_process_c13_data(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_DebugS *debug_s_arr, U64 string_data_base_offset, CV_StringHashTable string_ht, MSF_Context *msf, PDB_DbiModule **mod_arr);
+internal LNK_ProcessedCodeViewC13Data lnk_process_c13_data(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_DebugS *debug_s_arr, U64 string_data_base_offset, CV_StringHashTable string_ht, MSF_Context *msf, PDB_DbiModule **mod_arr, B32 copy_shared_inputs);
 internal U64 *                        lnk_hash_cv_symbol_ptr_arr(TP_Context *tp, Arena *arena, CV_SymbolPtrArray arr);
 internal CV_SymbolPtrArray            lnk_dedup_gsi_symbols(TP_Context *tp, Arena *arena, PDB_GsiContext *gsi, U64 obj_count, CV_SymbolList *symbol_list_arr);
 
@@ -581,7 +693,8 @@ internal String8List lnk_build_pdb(TP_Context               *tp,
                                    U64                       total_symbol_input_count,
                                    LNK_CodeViewSymbolsInput *symbol_inputs,
                                    CV_SymbolListArray       *parsed_symbols,
-                                   CV_DebugT                 types[CV_TypeIndexSource_COUNT]);
+                                   CV_DebugT                 types[CV_TypeIndexSource_COUNT],
+                                   B32                       copy_shared_inputs);
 
 // --- RAD Debug Info ----------------------------------------------------------
 
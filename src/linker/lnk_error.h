@@ -91,6 +91,8 @@ typedef enum
   LNK_Warning_DirectiveSectionWithRelocs,
   LNK_Warning_NoLargeAddressAwarenessForDll,
   LNK_Warning_TryingToExportEntryPoint,
+  LNK_Warning_Order,
+  LNK_Warning_TypeDb,
   LNK_Warning_Last,
   
   LNK_Error_Count
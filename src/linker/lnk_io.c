@@ -145,12 +145,56 @@ lnk_file_rename(OS_Handle handle, String8 new_name)
   return is_renamed;
 }
 
+internal OS_Handle
+lnk_file_open_existing_for_write(String8 path)
+{
+  OS_Handle file_handle = os_handle_zero();
+#if OS_WINDOWS
+  Temp scratch = scratch_begin(0,0);
+
+  // unlike os_file_open this keeps the file contents
+  String16            path16              = str16_from_8(scratch.arena, path);
+  SECURITY_ATTRIBUTES security_attributes = { sizeof(security_attributes) };
+  HANDLE native_handle = CreateFileW((WCHAR*)path16.str,
+                                     GENERIC_WRITE,
+                                     FILE_SHARE_READ,
+                                     &security_attributes,
+                                     OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL,
+                                     0);
+  if (native_handle != INVALID_HANDLE_VALUE) {
+    file_handle.u64[0] = (U64)native_handle;
+  }
+
+  scratch_end(scratch);
+#else
+# error "TODO: open existing file for write"
+#endif
+  return file_handle;
+}
+
 internal void
 lnk_log_read(String8 path, U64 size)
 {
   lnk_log(LNK_Log_IO_Read, "Read from \"%S\" %M", path, size);
 }
 
+internal U64
+lnk_read_data_from_file_path_to_buffer(String8 path, U64 buffer_size, U8 *buffer)
+{
+  U64       read_size = 0;
+  OS_Handle handle    = {0};
+  if (lnk_open_file_read((char *)path.str, path.size, &handle, sizeof(handle))) {
+    U64 file_size = lnk_size_from_file(&handle);
+    if (file_size <= buffer_size) {
+      read_size = os_file_read(handle, rng_1u64(0, file_size), buffer);
+    }
+    lnk_close_file(&handle);
+  }
+  lnk_log_read(path, read_size);
+  return read_size;
+}
+
 internal String8
 lnk_read_data_from_file_path(Arena *arena, LNK_IO_Flags io_flags, String8 path)
 {
@@ -218,6 +262,32 @@ THREAD_POOL_TASK_FUNC(lnk_memory_map_file_task)
     CloseHandle(file_handle);
   }
   scratch_end(scratch);
+#elif OS_LINUX
+  Temp scratch = scratch_begin(&arena, 1);
+  String8 path = push_str8_copy(scratch.arena, task->path_arr.v[task_id]);
+  int     fd   = open((char *)path.str, O_RDONLY);
+  if (fd != -1) {
+    struct stat st = {0};
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      // private mapping gives the same copy-on-write semantics as FILE_MAP_COPY,
+      // clean pages are shared with the page cache and other links
+      int flags = MAP_PRIVATE;
+      if (task->io_flags & LNK_IO_Flags_MemoryMapPopulate) {
+        flags |= MAP_POPULATE;
+      }
+      void *file_data = mmap(0, st.st_size, PROT_READ|PROT_WRITE, flags, fd, 0);
+      if (file_data != MAP_FAILED) {
+        if (task->io_flags & LNK_IO_Flags_SequentialAccess) {
+          madvise(file_data, st.st_size, MADV_SEQUENTIAL);
+        } else if (task->io_flags & LNK_IO_Flags_RandomAccess) {
+          madvise(file_data, st.st_size, MADV_RANDOM);
+        }
+        task->data_arr.v[task_id] = str8(file_data, st.st_size);
+      }
+    }
+    close(fd);
+  }
+  scratch_end(scratch);
 #else
 # error "memory mapping files is not supported on this platform"
 #endif
@@ -276,75 +346,128 @@ lnk_read_data_from_file_path_parallel(TP_Context *tp, Arena *arena, LNK_IO_Flags
   return result;
 }
 
-internal void
-lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List data)
+internal LNK_FileWriter
+lnk_file_writer_open(String8 path, String8 temp_path, U64 size_hint)
 {
-  ProfBeginV("Write %M to %S", data.total_size, path);
+  LNK_FileWriter writer = {0};
+  writer.path      = path;
+  writer.temp_path = temp_path;
 
-  B32       open_with_rename = (temp_path.size > 0);
-  OS_Handle file_handle      = {0};
-  String8   open_file_path   = {0};
-  if (open_with_rename) {
-    file_handle    = lnk_file_open_with_rename_permissions(temp_path);
-    open_file_path = temp_path;
+  if (temp_path.size > 0) {
+    writer.handle    = lnk_file_open_with_rename_permissions(temp_path);
+    writer.open_path = temp_path;
 
     // mark file to be deleted on exit, so we don't leave corrupted files on disk
-    if (!lnk_file_set_delete_on_close(file_handle, 1)) {
-      lnk_error(LNK_Error_IO, "failed to update file disposition on %S", open_file_path);
+    if (!lnk_file_set_delete_on_close(writer.handle, 1)) {
+      lnk_error(LNK_Error_IO, "failed to update file disposition on %S", writer.open_path);
     }
   } else {
-    lnk_open_file_write((char*)path.str, path.size, &file_handle, sizeof(file_handle));
-    open_file_path = path;
+    lnk_open_file_write((char*)path.str, path.size, &writer.handle, sizeof(writer.handle));
+    writer.open_path = path;
   }
 
-  if (!os_handle_match(file_handle, os_handle_zero())) {
+  if (!os_handle_match(writer.handle, os_handle_zero())) {
     // try to reserve up front file size
-    if (!os_file_reserve_size(file_handle, data.total_size)) {
-      lnk_log(LNK_Log_IO_Write, "Failed to pre-allocate file %S with size %M", open_file_path, data.total_size);
+    if (!os_file_reserve_size(writer.handle, size_hint)) {
+      lnk_log(LNK_Log_IO_Write, "Failed to pre-allocate file %S with size %M", writer.open_path, size_hint);
     }
+  } else {
+    lnk_error(LNK_Error_NoAccess, "don't have access to write to %S", path);
+  }
 
-    // write data nodes
-    U64 bytes_written = 0;
-    for (String8Node *data_n = data.first; data_n != 0; data_n = data_n->next) {
-      U64 write_size = lnk_write_file(&file_handle, bytes_written, data_n->string.str, data_n->string.size);
-      if (write_size != data_n->string.size) {
-        break;
-      }
-      bytes_written += data_n->string.size;
-    }
-    B32 is_write_complete = (bytes_written == data.total_size);
+  return writer;
+}
+
+internal void
+lnk_file_writer_push(LNK_FileWriter *writer, String8 data)
+{
+  // after a failed write keep counting expected bytes so close reports the correct size
+  B32 is_writable = !os_handle_match(writer->handle, os_handle_zero()) && writer->bytes_written == writer->bytes_expected;
+  writer->bytes_expected += data.size;
+  if (is_writable) {
+    U64 write_size = lnk_write_file(&writer->handle, writer->bytes_written, data.str, data.size);
+    writer->bytes_written += write_size;
+  }
+}
+
+internal void
+lnk_file_writer_push_list(LNK_FileWriter *writer, String8List list)
+{
+  for (String8Node *data_n = list.first; data_n != 0; data_n = data_n->next) {
+    lnk_file_writer_push(writer, data_n->string);
+  }
+}
+
+internal void
+lnk_file_writer_close(LNK_FileWriter *writer)
+{
+  if (!os_handle_match(writer->handle, os_handle_zero())) {
+    B32 is_write_complete = (writer->bytes_written == writer->bytes_expected);
 
     if (is_write_complete) {
       // rename temp file
-      if (open_with_rename) {
+      if (writer->temp_path.size > 0) {
         // all writes succeeded, remove delete on exit flag
-        if (!lnk_file_set_delete_on_close(file_handle, 0)) {
-          lnk_error(LNK_Error_IO, "failed to update file disposition on %S", open_file_path);
+        if (!lnk_file_set_delete_on_close(writer->handle, 0)) {
+          lnk_error(LNK_Error_IO, "failed to update file disposition on %S", writer->open_path);
         }
 
-        if (lnk_file_rename(file_handle, path)) {
-          lnk_log(LNK_Log_IO_Write, "Renamed %S -> %S", temp_path, path);
+        if (lnk_file_rename(writer->handle, writer->path)) {
+          lnk_log(LNK_Log_IO_Write, "Renamed %S -> %S", writer->temp_path, writer->path);
         } else {
-          lnk_error(LNK_Error_IO, "failed to rename %S -> %S", temp_path, path);
+          lnk_error(LNK_Error_IO, "failed to rename %S -> %S", writer->temp_path, writer->path);
         }
       }
     }
 
     // clean up file handle
-    lnk_close_file(&file_handle);
+    lnk_close_file(&writer->handle);
 
     // log write
     if (is_write_complete) {
       if (lnk_get_log_status(LNK_Log_IO_Write)) {
-        lnk_log(LNK_Log_IO_Write, "File \"%S\" %M written", path, data.total_size);
+        lnk_log(LNK_Log_IO_Write, "File \"%S\" %M written", writer->path, writer->bytes_written);
       }
     } else {
-      lnk_error(LNK_Error_IO, "incomplete write, %M written, expected %M, file %S", bytes_written, data.total_size, path);
+      lnk_error(LNK_Error_IO, "incomplete write, %M written, expected %M, file %S", writer->bytes_written, writer->bytes_expected, writer->path);
+    }
+  }
+
+  MemoryZeroStruct(writer);
+}
+
+internal void
+lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List data)
+{
+  ProfBeginV("Write %M to %S", data.total_size, path);
+  LNK_FileWriter writer = lnk_file_writer_open(path, temp_path, data.total_size);
+  lnk_file_writer_push_list(&writer, data);
+  lnk_file_writer_close(&writer);
+  ProfEnd();
+}
+
+internal void
+lnk_write_data_ranges_to_file_path(String8 path, String8 data, Rng1U64Array ranges)
+{
+  ProfBeginV("Patch %llu Ranges in %S", ranges.count, path);
+  OS_Handle handle = lnk_file_open_existing_for_write(path);
+  if (!os_handle_match(handle, os_handle_zero())) {
+    U64 bytes_written = 0, bytes_expected = 0;
+    for EachIndex(range_idx, ranges.count) {
+      String8 range_data = str8_substr(data, ranges.v[range_idx]);
+      bytes_expected += range_data.size;
+      bytes_written  += lnk_write_file(&handle, ranges.v[range_idx].min, range_data.str, range_data.size);
+    }
+    lnk_close_file(&handle);
+
+    if (bytes_written == bytes_expected) {
+      lnk_log(LNK_Log_IO_Write, "File \"%S\" %M patched", path, bytes_written);
+    } else {
+      lnk_error(LNK_Error_IO, "incomplete write, %M written, expected %M, file %S", bytes_written, bytes_expected, path);
     }
   } else {
     lnk_error(LNK_Error_NoAccess, "don't have access to write to %S", path);
   }
-  
   ProfEnd();
 }
 
@@ -3,7 +3,10 @@
 typedef U32 LNK_IO_Flags;
 enum
 {
-  LNK_IO_Flags_MemoryMapFiles = (1 << 0),
+  LNK_IO_Flags_MemoryMapFiles    = (1 << 0),
+  LNK_IO_Flags_MemoryMapPopulate = (1 << 1), // pre-fault mapped pages
+  LNK_IO_Flags_SequentialAccess  = (1 << 2), // access pattern hints for mapped pages
+  LNK_IO_Flags_RandomAccess      = (1 << 3),
 };
 
 typedef struct
@@ -17,6 +20,16 @@ typedef struct
   U8          *buffer;
 } LNK_DiskReader;
 
+typedef struct
+{
+  String8   path;
+  String8   temp_path;
+  String8   open_path;
+  OS_Handle handle;
+  U64       bytes_written;
+  U64       bytes_expected;
+} LNK_FileWriter;
+
 // --- Shared File API ---------------------------------------------------------
 
 shared_function int      lnk_open_file_read(char *path, uint64_t path_size, void *handle_buffer, uint64_t handle_buffer_max);
@@ -31,10 +44,18 @@ shared_function uint64_t lnk_write_file(void *raw_handle, uint64_t offset, void
 internal OS_Handle lnk_file_open_with_rename_permissions(String8 path);
 internal B32       lnk_file_set_delete_on_close(OS_Handle handle, B32 delete_file);
 internal B32       lnk_file_rename(OS_Handle handle, String8 new_name);
+internal OS_Handle lnk_file_open_existing_for_write(String8 path);
 
+internal U64          lnk_read_data_from_file_path_to_buffer(String8 path, U64 buffer_size, U8 *buffer);
 internal String8      lnk_read_data_from_file_path(Arena *arena, LNK_IO_Flags io_flags, String8 path);
 internal String8Array lnk_read_data_from_file_path_parallel(TP_Context *tp, Arena *arena, LNK_IO_Flags io_flags, String8Array path_arr);
 
+internal LNK_FileWriter lnk_file_writer_open(String8 path, String8 temp_path, U64 size_hint);
+internal void           lnk_file_writer_push(LNK_FileWriter *writer, String8 data);
+internal void           lnk_file_writer_push_list(LNK_FileWriter *writer, String8List list);
+internal void           lnk_file_writer_close(LNK_FileWriter *writer);
+
 internal void lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List list);
+internal void lnk_write_data_ranges_to_file_path(String8 path, String8 data, Rng1U64Array ranges);
 internal void lnk_write_data_to_file_path(String8 path, String8 temp_path, String8 data);
 
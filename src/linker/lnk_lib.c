@@ -159,6 +159,7 @@ THREAD_POOL_TASK_FUNC(lnk_lib_initer)
   LNK_LibNode *lib_node     = &task->free_libs[lib_node_idx];
 
   B32 is_valid_lib = lnk_lib_from_data(arena, input->data, input->path, task->lib_id_base + task_id, &lib_node->data);
+  lib_node->data.hash = input->disk_hash;
   if (is_valid_lib) {
     U64 valid_lib_idx = ins_atomic_u64_inc_eval(&task->valid_libs_count)-1;
     task->valid_libs[valid_lib_idx] = lib_node;
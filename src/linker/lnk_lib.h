@@ -16,6 +16,7 @@ typedef struct LNK_Lib
   String8Array         symbol_names;
   String8              long_names;
   U64                  input_idx;
+  U128                 hash; // hash of the lib as read from disk, zero when inputs are not hashed
 } LNK_Lib;
  
 typedef struct LNK_LibNode
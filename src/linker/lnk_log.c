@@ -46,6 +46,7 @@ lnk_log_type_from_string(String8 string)
     "LinkStats",     LNK_Log_LinkStats,
     "Timers",        LNK_Log_Timers,
     "Links",         LNK_Log_Links,
+    "Incremental",   LNK_Log_Incremental,
   };
   Assert(ArrayCount(map) == LNK_Log_Count);
 
@@ -15,6 +15,7 @@ typedef enum
   LNK_Log_LinkStats,
   LNK_Log_Timers,
   LNK_Log_Links, 
+  LNK_Log_Incremental,
   LNK_Log_Count
 } LNK_LogType;
 
@@ -326,6 +326,15 @@ THREAD_POOL_TASK_FUNC(lnk_obj_initer)
     scratch_end(scratch);
   }
 
+  // members are sliced from the lib, so they are identified by the lib's hash and member offset
+  U128 hash = input->disk_hash;
+  if (!input->is_thin && input->link_member && !u128_match(input->link_member->lib->hash, u128_zero())) {
+    struct { U128 lib_hash; U64 member_offset; } member_id = {0};
+    member_id.lib_hash      = input->link_member->lib->hash;
+    member_id.member_offset = input->link_member->lib->member_offsets[input->link_member->member_idx];
+    hash = lnk_incremental_hash_from_data(str8_struct(&member_id));
+  }
+
   // fill out obj
   obj->data                    = input->data;
   obj->path                    = push_str8_copy(arena, input->path);
@@ -336,6 +345,7 @@ THREAD_POOL_TASK_FUNC(lnk_obj_initer)
   obj->associated_sections     = associated_sections;
   obj->node                    = &task->objs[task_id];
   obj->link_member             = input->link_member;
+  obj->hash                    = hash;
 }
 
 internal LNK_ObjNode *
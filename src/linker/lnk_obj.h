@@ -16,6 +16,7 @@ typedef struct LNK_Obj
   B8                       exclude_from_debug_info;
   U32Node                **associated_sections;
   LNK_SymbolHashTrie     **symlinks;
+  U128                     hash; // identifies obj contents, zero when inputs are not hashed
 
   struct LNK_LibMemberRef *link_member;
 
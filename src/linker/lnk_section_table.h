@@ -23,6 +23,8 @@ typedef struct LNK_SectionContrib
   } u;
   U16 align; // contribution alignment in the image
   B8 hotpatch;
+  U32 order; // position from /ORDER or profile, zero when contribution is not ordered
+  U32 tail_pad; // bytes reserved after the contribution, lets /INCREMENTAL grow it in place
 } LNK_SectionContrib;
 
 typedef struct LNK_SectionContribChunk
@@ -24,6 +24,7 @@ lnk_string_from_timer_type(LNK_TimerType type)
   case LNK_Timer_Rdi:   return str8_lit("RDI");
   case LNK_Timer_Lib:   return str8_lit("Lib");
   case LNK_Timer_Debug: return str8_lit("Debug");
+  case LNK_Timer_Map:   return str8_lit("Map");
   default: InvalidPath;
   }
   return str8_zero();
@@ -10,6 +10,7 @@ typedef enum LNK_TimerType
   LNK_Timer_Rdi,
   LNK_Timer_Lib,
   LNK_Timer_Debug,
+  LNK_Timer_Map,
   LNK_Timer_Count
 } LNK_TimerType;
 
@@ -120,8 +120,14 @@ tp_release(TP_Context *pool)
   for (U64 i = 0; i < pool->worker_count; ++i) {
     semaphore_drop(pool->task_semaphore);
   }
+  // wait for private workers to exit before their semaphores are released,
+  // shared exec drops may be taken by other processes so those workers are detached
   for (U64 i = 1; i < pool->worker_count; i += 1) {
-    thread_detach(pool->worker_arr[i].handle);
+    if (is_shared) {
+      thread_detach(pool->worker_arr[i].handle);
+    } else {
+      thread_join(pool->worker_arr[i].handle, max_U64);
+    }
   }
   if (is_shared) {
     semaphore_release(pool->exec_semaphore);
@@ -45,6 +45,244 @@ mtx_push_op(C_Key buffer_key, MTX_Op op)
   mtx_enqueue_op(thread, buffer_key, op);
 }
 
+////////////////////////////////
+//~ Piece Tables
+
+internal MTX_Node *
+mtx_node_from_key(C_Key buffer_key)
+{
+  U64 hash = u64_hash_from_str8(str8_struct(&buffer_key));
+  U64 slot_idx = hash%mtx_shared->slots_count;
+  U64 stripe_idx = slot_idx%mtx_shared->stripes_count;
+  MTX_Slot *slot = &mtx_shared->slots[slot_idx];
+  MTX_Stripe *stripe = &mtx_shared->stripes[stripe_idx];
+  MTX_Node *node = 0;
+  RWMutexScope(stripe->rw_mutex, 1)
+  {
+    for(MTX_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(c_key_match(n->key, buffer_key))
+      {
+        node = n;
+        break;
+      }
+    }
+    if(node == 0)
+    {
+      node = stripe->free_node;
+      if(node != 0)
+      {
+        SLLStackPop(stripe->free_node);
+      }
+      else
+      {
+        node = push_array_no_zero(stripe->arena, MTX_Node, 1);
+      }
+      MemoryZeroStruct(node);
+      DLLPushBack(slot->first, slot->last, node);
+      node->key = buffer_key;
+      node->arena = arena_alloc();
+    }
+  }
+  
+  //- seed fresh piece tables from whatever the buffer currently holds -
+  // only the owning mut thread touches the node from here on, so no lock is
+  // needed for the piece table itself
+  if(!node->is_seeded)
+  {
+    node->is_seeded = 1;
+    U128 hash = c_hash_from_key(buffer_key, 0);
+    if(!u128_match(hash, u128_zero()))
+    {
+      mtx_node_rebase(node, hash);
+    }
+  }
+  return node;
+}
+
+internal MTX_Piece *
+mtx_piece_alloc(MTX_Node *node, String8 string)
+{
+  MTX_Piece *piece = node->free_piece;
+  if(piece != 0)
+  {
+    SLLStackPop(node->free_piece);
+  }
+  else
+  {
+    piece = push_array_no_zero(node->arena, MTX_Piece, 1);
+  }
+  MemoryZeroStruct(piece);
+  piece->string = string;
+  return piece;
+}
+
+internal MTX_Piece *
+mtx_piece_split(MTX_Node *node, U64 off)
+{
+  //- the end of the buffer is past every piece -> null result, callers
+  // append there rather than splitting off an empty piece
+  if(off >= node->total_size)
+  {
+    return 0;
+  }
+  
+  //- find piece containing offset, walking from whichever end is closer
+  MTX_Piece *piece = 0;
+  U64 piece_off = 0;
+  if(off <= node->total_size/2)
+  {
+    for(MTX_Piece *p = node->first_piece; p != 0; piece_off += p->string.size, p = p->next)
+    {
+      if(off < piece_off + p->string.size)
+      {
+        piece = p;
+        break;
+      }
+    }
+  }
+  else
+  {
+    piece_off = node->total_size;
+    for(MTX_Piece *p = node->last_piece; p != 0; p = p->prev)
+    {
+      piece_off -= p->string.size;
+      if(piece_off <= off)
+      {
+        piece = p;
+        break;
+      }
+    }
+  }
+  
+  //- split piece, so that the returned piece begins exactly at `off`
+  if(piece != 0 && piece_off < off)
+  {
+    U64 split_size = off - piece_off;
+    MTX_Piece *post = mtx_piece_alloc(node, str8_skip(piece->string, split_size));
+    piece->string = str8_prefix(piece->string, split_size);
+    DLLInsert(node->first_piece, node->last_piece, piece, post);
+    node->piece_count += 1;
+    piece = post;
+  }
+  return piece;
+}
+
+internal void
+mtx_node_reset(MTX_Node *node)
+{
+  arena_clear(node->arena);
+  node->first_piece = node->last_piece = node->free_piece = 0;
+  node->piece_count = 0;
+  node->total_size = 0;
+}
+
+internal void
+mtx_node_rebase(MTX_Node *node, U128 hash)
+{
+  //- pin the new base blob before unpinning the old one, they may be the same
+  c_hash_downstream_inc(hash);
+  if(!u128_match(node->base_hash, u128_zero()))
+  {
+    c_hash_downstream_dec(node->base_hash);
+  }
+  node->base_hash = hash;
+  
+  //- replace the piece table with one piece spanning the base blob
+  mtx_node_reset(node);
+  Access *access = access_open();
+  String8 data = c_data_from_hash(access, hash);
+  if(data.size != 0)
+  {
+    MTX_Piece *piece = mtx_piece_alloc(node, data);
+    DLLPushBack(node->first_piece, node->last_piece, piece);
+    node->piece_count = 1;
+    node->total_size = data.size;
+  }
+  access_close(access);
+}
+
+internal void
+mtx_node_apply_op(MTX_Node *node, MTX_Op op)
+{
+  //- rjf: clamp op by data
+  op.range.min = Min(op.range.min, node->total_size);
+  op.range.max = Min(op.range.max, node->total_size);
+  if(op.range.max == op.range.min && op.replace.size == 0)
+  {
+    return;
+  }
+  node->is_dirty = 1;
+  
+  //- replacing everything -> drop all pushed text storage
+  if(op.range.min == 0 && op.range.max == node->total_size)
+  {
+    mtx_node_reset(node);
+  }
+  
+  //- push replacement text into the node's append-only text storage
+  String8 replace = {0};
+  if(op.replace.size != 0)
+  {
+    replace.str = push_array_no_zero_aligned(node->arena, U8, op.replace.size, 1);
+    replace.size = op.replace.size;
+    MemoryCopy(replace.str, op.replace.str, op.replace.size);
+  }
+  
+  //- appending -> extend the last piece if its text is contiguous with
+  // the new text, otherwise tack on a new piece
+  if(op.range.min == node->total_size)
+  {
+    if(node->last_piece != 0 && node->last_piece->string.str + node->last_piece->string.size == replace.str)
+    {
+      node->last_piece->string.size += replace.size;
+    }
+    else
+    {
+      MTX_Piece *piece = mtx_piece_alloc(node, replace);
+      DLLPushBack(node->first_piece, node->last_piece, piece);
+      node->piece_count += 1;
+    }
+    node->total_size += replace.size;
+  }
+  
+  //- general edit -> split at both ends of the range, unlink the pieces
+  // in between, and link the replacement in their place
+  else
+  {
+    MTX_Piece *first_removed = mtx_piece_split(node, op.range.min);
+    MTX_Piece *opl = mtx_piece_split(node, op.range.max);
+    for(MTX_Piece *p = first_removed, *next = 0; p != opl; p = next)
+    {
+      next = p->next;
+      DLLRemove(node->first_piece, node->last_piece, p);
+      SLLStackPush(node->free_piece, p);
+      node->piece_count -= 1;
+    }
+    if(replace.size != 0)
+    {
+      MTX_Piece *piece = mtx_piece_alloc(node, replace);
+      MTX_Piece *prev = (opl != 0 ? opl->prev : node->last_piece);
+      DLLInsert(node->first_piece, node->last_piece, prev, piece);
+      node->piece_count += 1;
+    }
+    node->total_size = node->total_size + replace.size - dim_1u64(op.range);
+  }
+}
+
+internal String8
+mtx_node_materialize(Arena *arena, MTX_Node *node)
+{
+  String8 result = {0};
+  result.str = push_array_no_zero(arena, U8, node->total_size);
+  for(MTX_Piece *p = node->first_piece; p != 0; p = p->next)
+  {
+    MemoryCopy(result.str + result.size, p->string.str, p->string.size);
+    result.size += p->string.size;
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Mutation Threads
 
@@ -70,9 +308,10 @@ mtx_enqueue_op(MTX_MutThread *thread, C_Key buffer_key, MTX_Op op)
   cond_var_broadcast(thread->cv);
 }
 
-internal void
-mtx_dequeue_op(Arena *arena, MTX_MutThread *thread, C_Key *buffer_key_out, MTX_Op *op_out)
+internal B32
+mtx_dequeue_op(Arena *arena, MTX_MutThread *thread, C_Key *buffer_key_out, MTX_Op *op_out, U64 endt_us)
 {
+  B32 result = 0;
   MutexScope(thread->mutex) for(;;)
   {
     U64 unconsumed_size = thread->ring_write_pos - thread->ring_read_pos;
@@ -83,11 +322,20 @@ mtx_dequeue_op(Arena *arena, MTX_MutThread *thread, C_Key *buffer_key_out, MTX_O
       thread->ring_read_pos += ring_read_struct(thread->ring_base, thread->ring_size, thread->ring_read_pos, &op_out->replace.size);
       op_out->replace.str = push_array_no_zero(arena, U8, op_out->replace.size);
       thread->ring_read_pos += ring_read(thread->ring_base, thread->ring_size, thread->ring_read_pos, op_out->replace.str, op_out->replace.size);
+      result = 1;
       break;
     }
-    cond_var_wait(thread->cv, thread->mutex, max_U64);
+    if(os_now_microseconds() >= endt_us)
+    {
+      break;
+    }
+    cond_var_wait(thread->cv, thread->mutex, endt_us);
   }
-  cond_var_broadcast(thread->cv);
+  if(result)
+  {
+    cond_var_broadcast(thread->cv);
+  }
+  return result;
 }
 
 internal void
@@ -98,46 +346,59 @@ mtx_mut_thread__entry_point(void *p)
   for(;;)
   {
     Temp scratch = scratch_begin(0, 0);
-    Access *access = access_open();
     
-    //- rjf: get next op
-    C_Key buffer_key = {0};
-    MTX_Op op = {0};
-    mtx_dequeue_op(scratch.arena, mut_thread, &buffer_key, &op);
-    
-    //- rjf: get buffer's current data
-    U128 hash = c_hash_from_key(buffer_key, 0);
-    String8 data = c_data_from_hash(access, hash);
-    
-    //- rjf: clamp op by data
-    op.range.min = Min(op.range.min, data.size);
-    op.range.max = Min(op.range.max, data.size);
-    
-    //- rjf: construct new buffer
-    if(op.range.max != op.range.min || op.replace.size != 0)
+    //- drain queued ops into the buffers' piece tables, blocking for the
+    // first one, then folding in whatever else arrives within the batch
+    // window, so that bursts of edits (e.g. many log appends) coalesce into
+    // a single buffer submission
+    MTX_Node *first_dirty = 0;
     {
-      U64 new_data_size = data.size + op.replace.size - dim_1u64(op.range);
-      Arena *arena = arena_alloc(.commit_size = new_data_size + ARENA_HEADER_SIZE, .reserve_size = new_data_size + ARENA_HEADER_SIZE);
-      U8 *new_data_base = push_array_no_zero(arena, U8, new_data_size);
-      String8 pre_replace_data = str8_substr(data, r1u64(0, op.range.min));
-      String8 post_replace_data = str8_substr(data, r1u64(op.range.max, data.size));
-      if(pre_replace_data.size != 0)
+      U64 op_count = 0;
+      U64 endt_us = max_U64;
+      for(;;)
       {
-        MemoryCopy(new_data_base+0,                                     pre_replace_data.str, pre_replace_data.size);
+        C_Key buffer_key = {0};
+        MTX_Op op = {0};
+        U64 scratch_pos = arena_pos(scratch.arena);
+        if(!mtx_dequeue_op(scratch.arena, mut_thread, &buffer_key, &op, endt_us))
+        {
+          break;
+        }
+        MTX_Node *node = mtx_node_from_key(buffer_key);
+        B32 was_dirty = node->is_dirty;
+        mtx_node_apply_op(node, op);
+        if(!was_dirty && node->is_dirty)
+        {
+          SLLStackPush_N(first_dirty, node, dirty_next);
+        }
+        arena_pop_to(scratch.arena, scratch_pos);
+        if(op_count == 0)
+        {
+          endt_us = os_now_microseconds() + MTX_BATCH_WINDOW_US;
+        }
+        op_count += 1;
+        if(op_count >= 4096)
+        {
+          break;
+        }
       }
-      if(op.replace.size != 0)
-      {
-        MemoryCopy(new_data_base+pre_replace_data.size,                 op.replace.str, op.replace.size);
-      }
-      if(post_replace_data.size != 0)
-      {
-        MemoryCopy(new_data_base+pre_replace_data.size+op.replace.size, post_replace_data.str, post_replace_data.size);
-      }
-      String8 new_data = str8(new_data_base, new_data_size);
-      c_submit_data(buffer_key, &arena, new_data);
     }
     
-    access_close(access);
+    //- materialize & submit each touched buffer once; the submitted blob
+    // becomes the node's new base, so the node's arena only ever holds text
+    // pushed since the last submission, rather than a second copy of the
+    // whole buffer
+    for(MTX_Node *node = first_dirty, *next = 0; node != 0; node = next)
+    {
+      next = node->dirty_next;
+      Arena *arena = arena_alloc(.commit_size = node->total_size + ARENA_HEADER_SIZE, .reserve_size = node->total_size + ARENA_HEADER_SIZE);
+      String8 new_data = mtx_node_materialize(arena, node);
+      U128 hash = c_submit_data(node->key, &arena, new_data);
+      mtx_node_rebase(node, hash);
+      node->dirty_next = 0;
+      node->is_dirty = 0;
+    }
+    
     scratch_end(scratch);
   }
 }
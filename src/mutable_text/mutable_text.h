@@ -7,12 +7,36 @@
 ////////////////////////////////
 //~ rjf: Cache Types
 
+typedef struct MTX_Piece MTX_Piece;
+struct MTX_Piece
+{
+  MTX_Piece *next;
+  MTX_Piece *prev;
+  String8 string;
+};
+
 typedef struct MTX_Node MTX_Node;
 struct MTX_Node
 {
   MTX_Node *next;
   MTX_Node *prev;
-  U128 key;
+  C_Key key;
+  
+  // piece table (owned exclusively by the buffer's mut thread); pieces point
+  // either into the last submitted blob, which stays pinned as the base, or
+  // into the arena, which only holds text pushed since that submission
+  U128 base_hash;
+  Arena *arena;
+  MTX_Piece *first_piece;
+  MTX_Piece *last_piece;
+  MTX_Piece *free_piece;
+  U64 piece_count;
+  U64 total_size;
+  B32 is_seeded;
+  
+  // batch state
+  MTX_Node *dirty_next;
+  B32 is_dirty;
 };
 
 typedef struct MTX_Slot MTX_Slot;
@@ -33,6 +57,11 @@ struct MTX_Stripe
 ////////////////////////////////
 //~ rjf: Mutation Thread Types
 
+// ops arriving within this long after a batch's first op are folded into the
+// batch - each submission re-hashes the whole buffer, and readers only pick up
+// a new version once per frame anyway
+#define MTX_BATCH_WINDOW_US 16000
+
 typedef struct MTX_Op MTX_Op;
 struct MTX_Op
 {
@@ -86,11 +115,22 @@ internal void mtx_init(void);
 
 internal void mtx_push_op(C_Key buffer_key, MTX_Op op);
 
+////////////////////////////////
+//~ Piece Tables
+
+internal MTX_Node *mtx_node_from_key(C_Key buffer_key);
+internal MTX_Piece *mtx_piece_alloc(MTX_Node *node, String8 string);
+internal MTX_Piece *mtx_piece_split(MTX_Node *node, U64 off);
+internal void mtx_node_reset(MTX_Node *node);
+internal void mtx_node_rebase(MTX_Node *node, U128 hash);
+internal void mtx_node_apply_op(MTX_Node *node, MTX_Op op);
+internal String8 mtx_node_materialize(Arena *arena, MTX_Node *node);
+
 ////////////////////////////////
 //~ rjf: Mutation Threads
 
 internal void mtx_enqueue_op(MTX_MutThread *thread, C_Key buffer_key, MTX_Op op);
-internal void mtx_dequeue_op(Arena *arena, MTX_MutThread *thread, C_Key *buffer_key_out, MTX_Op *op_out);
+internal B32 mtx_dequeue_op(Arena *arena, MTX_MutThread *thread, C_Key *buffer_key_out, MTX_Op *op_out, U64 endt_us);
 internal void mtx_mut_thread__entry_point(void *p);
 
 #endif // MUTABLE_TEXT_H
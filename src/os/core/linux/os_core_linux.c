@@ -770,13 +770,101 @@ os_sleep_milliseconds(U32 msec)
 internal OS_Handle
 os_process_launch(OS_ProcessLaunchParams *params)
 {
-  NotImplemented;
+  OS_Handle result = {0};
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- unpack command line; a relative exe path with a folder is resolved
+  // before the child changes into the working directory
+  char **argv = push_array(scratch.arena, char *, params->cmd_line.node_count+1);
+  {
+    U64 idx = 0;
+    for(String8Node *n = params->cmd_line.first; n != 0; n = n->next, idx += 1)
+    {
+      String8 arg = n->string;
+      if(idx == 0 && arg.size != 0 && arg.str[0] != '/' && str8_find_needle(arg, 0, str8_lit("/"), 0) < arg.size)
+      {
+        arg = push_str8f(scratch.arena, "%S/%S", os_get_current_path(scratch.arena), arg);
+      }
+      argv[idx] = (char *)push_str8_copy(scratch.arena, arg).str;
+    }
+  }
+  
+  //- unpack working directory
+  char *path = (char *)push_str8_copy(scratch.arena, params->path).str;
+  
+  //- unpack environment; explicit variables come first, so they win over inherited ones
+  extern char **environ;
+  char **env = 0;
+  {
+    U64 inherited_count = 0;
+    if(params->inherit_env)
+    {
+      for(char **e = environ; *e != 0; e += 1) { inherited_count += 1; }
+    }
+    env = push_array(scratch.arena, char *, params->env.node_count+inherited_count+1);
+    U64 idx = 0;
+    for(String8Node *n = params->env.first; n != 0; n = n->next, idx += 1)
+    {
+      env[idx] = (char *)push_str8_copy(scratch.arena, n->string).str;
+    }
+    for(U64 inherited_idx = 0; inherited_idx < inherited_count; inherited_idx += 1, idx += 1)
+    {
+      env[idx] = environ[inherited_idx];
+    }
+  }
+  
+  //- fork & exec; the child only calls async-signal-safe functions before exec
+  if(argv[0] != 0)
+  {
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+      if(!os_handle_match(params->stdin_file, os_handle_zero()))  { dup2((int)params->stdin_file.u64[0], STDIN_FILENO); }
+      if(!os_handle_match(params->stdout_file, os_handle_zero())) { dup2((int)params->stdout_file.u64[0], STDOUT_FILENO); }
+      if(!os_handle_match(params->stderr_file, os_handle_zero())) { dup2((int)params->stderr_file.u64[0], STDERR_FILENO); }
+      if(path[0] == 0 || chdir(path) == 0)
+      {
+        environ = env;
+        execvp(argv[0], argv);
+      }
+      _exit(127);
+    }
+    if(pid > 0)
+    {
+      result.u64[0] = (U64)pid;
+    }
+  }
+  
+  scratch_end(scratch);
+  return result;
 }
 
 internal B32
 os_process_join(OS_Handle handle, U64 endt_us, U64 *exit_code_out)
 {
-  NotImplemented;
+  if(os_handle_match(handle, os_handle_zero())) { return 0; }
+  pid_t pid = (pid_t)handle.u64[0];
+  int status = 0;
+  pid_t wait_result = 0;
+  for(;;)
+  {
+    wait_result = waitpid(pid, &status, endt_us == max_U64 ? 0 : WNOHANG);
+    if(wait_result == -1 && errno == EINTR)
+    {
+      continue;
+    }
+    if(wait_result != 0 || os_now_microseconds() >= endt_us)
+    {
+      break;
+    }
+    os_sleep_milliseconds(1);
+  }
+  B32 process_joined = (wait_result == pid);
+  if(process_joined && exit_code_out)
+  {
+    *exit_code_out = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+  }
+  return process_joined;
 }
 
 internal U64
@@ -788,13 +876,17 @@ os_process_array_join(OS_HandleArray processes, U64 endt_us, U64 *exit_code_out)
 internal void
 os_process_detach(OS_Handle handle)
 {
-  NotImplemented;
+  // no resources are held for a child pid; an unjoined child is reaped by
+  // init once this process exits
 }
 
 internal B32
 os_process_kill(OS_Handle handle)
 {
-  NotImplemented;
+  if(os_handle_match(handle, os_handle_zero())) { return 0; }
+  pid_t pid = (pid_t)handle.u64[0];
+  B32 result = (kill(pid, SIGKILL) == 0);
+  return result;
 }
 
 ////////////////////////////////
@@ -1053,24 +1145,59 @@ os_cond_var_broadcast(CondVar cv)
 
 //- rjf: cross-process semaphores
 
+internal B32
+os_lnx_semaphore_name_from_string(char *dst, U64 dst_cap, String8 name)
+{
+  // NOTE: POSIX semaphore names are a single leading slash followed by a
+  // path component, so separators in the caller's name are flattened
+  B32 result = 0;
+  if(name.size + 2 <= dst_cap)
+  {
+    dst[0] = '/';
+    for EachIndex(idx, name.size)
+    {
+      U8 c = name.str[idx];
+      dst[idx+1] = (c == '/' || c == '\\') ? '_' : (char)c;
+    }
+    dst[name.size+1] = 0;
+    result = 1;
+  }
+  return result;
+}
+
 internal Semaphore
 os_semaphore_alloc(U32 initial_count, U32 max_count, String8 name)
 {
   Semaphore result = {0};
-  if (name.size > 0)
+  OS_LNX_Entity *entity = os_lnx_entity_alloc(OS_LNX_EntityKind_Semaphore);
+  if(name.size > 0)
   {
-    // TODO: we need to allocate shared memory to store sem_t
-    // NotImplemented;
+    // NOTE: the allocating process owns the name and unlinks it on release;
+    // if the name already exists, it is opened rather than re-initialized,
+    // like a named semaphore on Windows
+    if(os_lnx_semaphore_name_from_string(entity->semaphore.name, sizeof(entity->semaphore.name), name))
+    {
+      entity->semaphore.is_named = 1;
+      entity->semaphore.handle = sem_open(entity->semaphore.name, O_CREAT|O_EXCL, 0600, initial_count);
+      entity->semaphore.is_owner = (entity->semaphore.handle != SEM_FAILED);
+      if(entity->semaphore.handle == SEM_FAILED && errno == EEXIST)
+      {
+        entity->semaphore.handle = sem_open(entity->semaphore.name, 0);
+      }
+    }
   }
   else
   {
-    sem_t *s = mmap(0, sizeof(*s), PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
-    AssertAlways(s != MAP_FAILED);
-    int err = sem_init(s, 0, initial_count);
-    if(err == 0)
-    {
-      result.u64[0] = (U64)s;
-    }
+    int err = sem_init(&entity->semaphore.local, 0, initial_count);
+    entity->semaphore.handle = (err == 0) ? &entity->semaphore.local : SEM_FAILED;
+  }
+  if(entity->semaphore.handle == 0 || entity->semaphore.handle == SEM_FAILED)
+  {
+    os_lnx_entity_release(entity);
+  }
+  else
+  {
+    result.u64[0] = (U64)entity;
   }
   return result;
 }
@@ -1078,49 +1205,102 @@ os_semaphore_alloc(U32 initial_count, U32 max_count, String8 name)
 internal void
 os_semaphore_release(Semaphore semaphore)
 {
-  int err = munmap((void*)semaphore.u64[0], sizeof(sem_t));
-  AssertAlways(err == 0);
+  if(MemoryIsZeroStruct(&semaphore)) { return; }
+  OS_LNX_Entity *entity = (OS_LNX_Entity *)semaphore.u64[0];
+  if(entity->semaphore.is_named)
+  {
+    sem_close(entity->semaphore.handle);
+    if(entity->semaphore.is_owner)
+    {
+      sem_unlink(entity->semaphore.name);
+    }
+  }
+  else
+  {
+    sem_destroy(entity->semaphore.handle);
+  }
+  os_lnx_entity_release(entity);
 }
 
 internal Semaphore
 os_semaphore_open(String8 name)
 {
-  NotImplemented;
+  Semaphore result = {0};
+  OS_LNX_Entity *entity = os_lnx_entity_alloc(OS_LNX_EntityKind_Semaphore);
+  entity->semaphore.is_named = 1;
+  entity->semaphore.handle = SEM_FAILED;
+  if(os_lnx_semaphore_name_from_string(entity->semaphore.name, sizeof(entity->semaphore.name), name))
+  {
+    entity->semaphore.handle = sem_open(entity->semaphore.name, 0);
+  }
+  if(entity->semaphore.handle == SEM_FAILED)
+  {
+    os_lnx_entity_release(entity);
+  }
+  else
+  {
+    result.u64[0] = (U64)entity;
+  }
+  return result;
 }
 
 internal void
 os_semaphore_close(Semaphore semaphore)
 {
-  NotImplemented;
+  os_semaphore_release(semaphore);
 }
 
 internal B32
 os_semaphore_take(Semaphore semaphore, U64 endt_us)
 {
-  // TODO(rjf): we need to use `sem_timedwait` here.
-  AssertAlways(endt_us == max_U64);
+  // NOTE: endt_us is on the monotonic clock, but sem_timedwait takes an
+  // absolute CLOCK_REALTIME time, so the remaining wait is rebased onto it
+  struct timespec endt_timespec = {0};
+  if(endt_us != max_U64)
+  {
+    U64 now_us = os_now_microseconds();
+    U64 wait_us = (endt_us > now_us) ? (endt_us - now_us) : 0;
+    clock_gettime(CLOCK_REALTIME, &endt_timespec);
+    U64 endt_ns = endt_timespec.tv_nsec + (wait_us%Million(1))*Thousand(1);
+    endt_timespec.tv_sec += wait_us/Million(1) + endt_ns/Billion(1);
+    endt_timespec.tv_nsec = endt_ns%Billion(1);
+  }
+  B32 result = 0;
+  if(MemoryIsZeroStruct(&semaphore)) { return result; }
+  sem_t *handle = ((OS_LNX_Entity *)semaphore.u64[0])->semaphore.handle;
   for(;;)
   {
-    int err = sem_wait((sem_t*)semaphore.u64[0]);
+    int err = 0;
+    if(endt_us == max_U64)
+    {
+      err = sem_wait(handle);
+    }
+    else
+    {
+      err = sem_timedwait(handle, &endt_timespec);
+    }
     if(err == 0)
     {
+      result = 1;
       break;
     }
-    else if(errno == EAGAIN)
+    else if(errno == EAGAIN || errno == EINTR)
     {
       continue;
     }
     break;
   }
-  return 1;
+  return result;
 }
 
 internal void
 os_semaphore_drop(Semaphore semaphore)
 {
+  if(MemoryIsZeroStruct(&semaphore)) { return; }
+  sem_t *handle = ((OS_LNX_Entity *)semaphore.u64[0])->semaphore.handle;
   for(;;)
   {
-    int err = sem_post((sem_t*)semaphore.u64[0]);
+    int err = sem_post(handle);
     if(err == 0)
     {
       break;
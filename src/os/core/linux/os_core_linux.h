@@ -25,6 +25,7 @@
 #include <sys/syscall.h>
 #include <sys/sysinfo.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -68,6 +69,7 @@ typedef enum OS_LNX_EntityKind
   OS_LNX_EntityKind_RWMutex,
   OS_LNX_EntityKind_ConditionVariable,
   OS_LNX_EntityKind_Barrier,
+  OS_LNX_EntityKind_Semaphore,
 }
 OS_LNX_EntityKind;
 
@@ -92,6 +94,14 @@ struct OS_LNX_Entity
       pthread_mutex_t rwlock_mutex_handle;
     } cv;
     pthread_barrier_t barrier;
+    struct
+    {
+      sem_t *handle;
+      sem_t local;
+      B32 is_named;
+      B32 is_owner;
+      char name[NAME_MAX];
+    } semaphore;
   };
 };
 
@@ -40,6 +40,7 @@ rb_entry_point(CmdLine *cmdline)
   {
     thread_join(threads[idx], max_U64);
   }
+  barrier_release(barrier);
   scratch_end(scratch);
 }
 
@@ -63,7 +64,7 @@ rb_thread_entry_point(void *p)
   {
     rb_shared = push_array(arena, RB_Shared, 1);
   }
-  lane_sync();
+  lane_sync_u64(&rb_shared, 0);
   
   //////////////////////////////
   //- rjf: analyze & load command line input files
@@ -477,6 +478,7 @@ rb_thread_entry_point(void *p)
   //- rjf: perform operation based on output kind
   //
   String8List output_blobs = {0};
+  String8List dwarf_mapped_views = {0};
   switch(output_kind)
   {
     ////////////////////////////
@@ -709,7 +711,7 @@ rb_thread_entry_point(void *p)
             convert_params.subset_flags   = subset_flags;
             convert_params.deterministic  = cmd_line_has_flag(cmdline, str8_lit("deterministic"));
           }
-          ProfScope("convert") dwarf_bake_params = d2r_convert(arena, &convert_params);
+          ProfScope("convert") dwarf_bake_params = d2r_convert(arena, &convert_params, &dwarf_mapped_views);
         }
         
         //- rjf: PDB inputs => PDB -> RDI conversion
@@ -826,14 +828,14 @@ rb_thread_entry_point(void *p)
             String8List *lane_chunk_file_dumps;
             String8List *lane_chunk_func_dumps;
           };
-          local_persist P2B_Shared *p2b_shared = 0;
+          local_persist thread_static P2B_Shared *p2b_shared = 0;
           if(lane_idx() == 0)
           {
             p2b_shared = push_array(arena, P2B_Shared, 1);
             p2b_shared->lane_chunk_file_dumps = push_array(arena, String8List, lane_count()*bake_params->src_files.chunk_count);
             p2b_shared->lane_chunk_func_dumps = push_array(arena, String8List, lane_count()*bake_params->procedures.chunk_count);
           }
-          lane_sync();
+          lane_sync_u64(&p2b_shared, 0);
           
           //- rjf: dump MODULE record
           if(lane_idx() == 0)
@@ -1238,6 +1240,9 @@ rb_thread_entry_point(void *p)
       }
       log_info(str8_lit("Results written to stdout"));
     }
+    
+    // rjf: outputs are written => release split DWARF files the converted strings pointed into
+    d2r_unmap_views(dwarf_mapped_views);
   }
   lane_sync();
   
@@ -1264,4 +1269,12 @@ rb_thread_entry_point(void *p)
       }
     }
   }
+  
+  //////////////////////////////
+  //- release - this may run many times within one process (e.g. as a
+  // conversion server runner), so nothing may outlive the invocation
+  //
+  lane_sync();
+  log_release(log);
+  arena_release(arena);
 }
@@ -68,7 +68,7 @@ struct RB_Shared
 ////////////////////////////////
 //~ rjf: Globals
 
-global RB_Shared *rb_shared = 0;
+thread_static RB_Shared *rb_shared = 0;
 
 ////////////////////////////////
 //~ rjf: Top-Level Entry Points
@@ -23,6 +23,7 @@
 #include "codeview/codeview.h"
 #include "codeview/codeview_parse.h"
 #include "eh/eh_frame.h"
+#include "zstd/zstd.h"
 #include "dwarf/dwarf_inc.h"
 #include "msf/msf.h"
 #include "msf/msf_parse.h"
@@ -48,6 +49,7 @@
 #include "codeview/codeview.c"
 #include "codeview/codeview_parse.c"
 #include "eh/eh_frame.c"
+#include "zstd/zstd.c"
 #include "dwarf/dwarf_inc.c"
 #include "msf/msf.c"
 #include "msf/msf_parse.c"
@@ -5697,6 +5697,19 @@ rd_window_frame(void)
         
         ui_divider(ui_em(1.f, 1.f));
         
+        //- rjf: draw cache memory stats
+        {
+          C_Stats c_s = c_stats();
+          AC_Stats ac_s = ac_stats();
+          ui_labelf("Cache Memory: %I64u / %I64u MB", ins_atomic_u64_eval(&cache_memory_total)/MB(1), cache_memory_budget/MB(1));
+          ui_labelf("Content Blobs: %I64u (%I64u MB)", c_s.blob_count, c_s.blob_bytes/MB(1));
+          ui_labelf("Content Blobs Evicted For Budget: %I64u (%I64u MB)", c_s.budget_evicted_blob_count, c_s.budget_evicted_blob_bytes/MB(1));
+          ui_labelf("Artifacts: %I64u (%I64u MB)", ac_s.artifact_count, ac_s.artifact_bytes/MB(1));
+          ui_labelf("Artifacts Evicted For Budget: %I64u (%I64u MB)", ac_s.budget_evicted_artifact_count, ac_s.budget_evicted_artifact_bytes/MB(1));
+        }
+        
+        ui_divider(ui_em(1.f, 1.f));
+        
         //- rjf: draw per-window stats
         for(RD_WindowState *w = rd_state->first_window_state; w != &rd_nil_window_state; w = w->order_next)
         {
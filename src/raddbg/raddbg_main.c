@@ -218,6 +218,7 @@
 #include "pdb/pdb_parse.h"
 #include "pdb/pdb_stringize.h"
 #include "eh/eh_frame.h"
+#include "zstd/zstd.h"
 #include "dwarf/dwarf_inc.h"
 #include "rdi_from_coff/rdi_from_coff.h"
 #include "rdi_from_elf/rdi_from_elf.h"
@@ -266,6 +267,7 @@
 #include "pdb/pdb_parse.c"
 #include "pdb/pdb_stringize.c"
 #include "eh/eh_frame.c"
+#include "zstd/zstd.c"
 #include "dwarf/dwarf_inc.c"
 #include "rdi_from_coff/rdi_from_coff.c"
 #include "rdi_from_elf/rdi_from_elf.c"
@@ -296,6 +298,7 @@ typedef enum ExecMode
   ExecMode_Normal,
   ExecMode_IPCSender,
   ExecMode_BinaryUtility,
+  ExecMode_ConversionServer,
   ExecMode_Help,
 }
 ExecMode;
@@ -361,6 +364,29 @@ ipc_signaler_thread__entry_point(void *p)
   }
 }
 
+////////////////////////////////
+//~ Conversion Server Runner Thread
+
+internal void
+conversion_server_runner_thread__entry_point(void *p)
+{
+  ThreadNameF("rd_conversion_server_runner_thread_%I64u", (U64)p);
+  Arena *arena = arena_alloc();
+  for(;;)
+  {
+    DI_ConversionJob job = di_conversion_job_pop(arena, DI_CONVERSION_SERVER_IDLE_TIMEOUT_US);
+    if(job.cmd_line.node_count == 0)
+    {
+      break;
+    }
+    CmdLine cmd_line = cmd_line_from_string_list(arena, job.cmd_line);
+    rb_entry_point(&cmd_line);
+    di_conversion_job_finish(&job);
+    arena_clear(arena);
+  }
+  arena_release(arena);
+}
+
 ////////////////////////////////
 //~ rjf: Ctrl -> Main Thread Wakeup Hook
 
@@ -400,6 +426,11 @@ entry_point(CmdLine *cmd_line)
     {
       exec_mode = ExecMode_IPCSender;
     }
+    else if(cmd_line_has_flag(cmd_line, str8_lit("bin")) &&
+            cmd_line_has_flag(cmd_line, str8_lit("conversion_server")))
+    {
+      exec_mode = ExecMode_ConversionServer;
+    }
     else if(cmd_line_has_flag(cmd_line, str8_lit("bin")))
     {
       exec_mode = ExecMode_BinaryUtility;
@@ -731,6 +762,22 @@ entry_point(CmdLine *cmd_line)
       di_signal_completion();
     }break;
     
+    //- long-lived conversion server - runs binary utility jobs, pulled from
+    // the parent's job ring, until idle
+    case ExecMode_ConversionServer:
+    {
+      U64 runners_count = Max(1, os_get_system_info()->logical_processor_count/2);
+      Thread *runners = push_array(scratch.arena, Thread, runners_count);
+      for EachIndex(idx, runners_count)
+      {
+        runners[idx] = thread_launch(conversion_server_runner_thread__entry_point, (void *)idx);
+      }
+      for EachIndex(idx, runners_count)
+      {
+        thread_join(runners[idx], max_U64);
+      }
+    }break;
+    
     //- rjf: help message box
     case ExecMode_Help:
     {
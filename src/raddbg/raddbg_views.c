@@ -3910,6 +3910,7 @@ rd_bitmap_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *
      data.size >= (U64)top.dim.x*(U64)top.dim.y*(U64)r_tex2d_format_bytes_per_pixel_table[top.fmt])
   {
     texture = r_tex2d_alloc(R_ResourceKind_Static, v2s32(top.dim.x, top.dim.y), top.fmt, data.str);
+    ac_report_artifact_size((U64)top.dim.x*(U64)top.dim.y*(U64)r_tex2d_format_bytes_per_pixel_table[top.fmt]);
   }
   
   //- rjf: bundle as artifact
@@ -4526,6 +4527,7 @@ rd_geo3d_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *g
   if(data.size != 0)
   {
     buffer = r_buffer_alloc(R_ResourceKind_Static, data.size, data.str);
+    ac_report_artifact_size(data.size);
   }
   AC_Artifact artifact = {0};
   MemoryCopy(&artifact, &buffer, Min(sizeof(artifact), sizeof(buffer)));
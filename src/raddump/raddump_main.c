@@ -41,6 +41,7 @@
 #include "msf/msf_parse.h"
 #include "pdb/pdb.h"
 #include "pdb/pdb_parse.h"
+#include "zstd/zstd.h"
 #include "dwarf/dwarf.h"
 #include "dwarf/dwarf_parse.h"
 #include "dwarf/dwarf_expr.h"
@@ -73,6 +74,7 @@
 #include "msf/msf_parse.c"
 #include "pdb/pdb.c"
 #include "pdb/pdb_parse.c"
+#include "zstd/zstd.c"
 #include "dwarf/dwarf.c"
 #include "dwarf/dwarf_parse.c"
 #include "dwarf/dwarf_expr.c"
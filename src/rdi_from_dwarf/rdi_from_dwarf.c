@@ -21,20 +21,6 @@ static const U64 PROC_CHUNK_CAP        = 256;
 static const U64 SCOPE_CHUNK_CAP       = 256;
 static const U64 INLINE_SITE_CHUNK_CAP = 256;
 
-RDIM_TopLevelInfo        top_level_info  = {0};
-RDIM_BinarySectionList   binary_sections = {0};
-RDIM_UnitChunkList       units           = {0};
-RDIM_UDTChunkList        udts            = {0};
-RDIM_TypeChunkList       types           = {0};
-RDIM_SrcFileChunkList    src_files       = {0};
-RDIM_LineTableChunkList  line_tables     = {0};
-RDIM_LocationChunkList   locations       = {0};
-RDIM_SymbolChunkList     gvars           = {0};
-RDIM_SymbolChunkList     tvars           = {0};
-RDIM_SymbolChunkList     procs           = {0};
-RDIM_ScopeChunkList      scopes          = {0};
-RDIM_InlineSiteChunkList inline_sites    = {0};
-
 ////////////////////////////////
 //~ rjf: Enum Conversion Helpers
 
@@ -113,10 +99,27 @@ d2r_rdi_reg_code_from_dw_reg(Arch arch, DW_Reg v)
 internal RDIM_Type *
 d2r_create_type(Arena *arena, D2R_TypeTable *type_table)
 {
-  RDIM_Type *type = rdim_type_chunk_list_push(arena, type_table->types, type_table->type_chunk_cap);
+  // chunk elements are not zeroed, and unit types are made on memory that is
+  // reused from unit to unit
+  RDIM_Type          *type  = rdim_type_chunk_list_push(arena, type_table->types, type_table->type_chunk_cap);
+  RDIM_TypeChunkNode *chunk = type->chunk;
+  MemoryZeroStruct(type);
+  type->chunk = chunk;
   return type;
 }
 
+internal RDIM_UDT *
+d2r_create_udt(Arena *arena, D2R_TypeTable *type_table, RDIM_Type *type)
+{
+  RDIM_UDT          *udt   = rdim_udt_chunk_list_push(arena, type_table->udts, type_table->udt_chunk_cap);
+  RDIM_UDTChunkNode *chunk = udt->chunk;
+  MemoryZeroStruct(udt);
+  udt->chunk     = chunk;
+  udt->self_type = type;
+  type->udt      = udt;
+  return udt;
+}
+
 internal RDIM_Type *
 d2r_create_type_from_offset(Arena *arena, D2R_TypeTable *type_table, U64 info_off)
 {
@@ -1182,7 +1185,7 @@ d2r_bytecode_from_expression(Arena       *arena,
           out = D2R_ValueType_Generic;
         } else {
           // find ref tag
-          DW_TagNode *tag_node = dw_tag_node_from_info_off(cu, inst->operands[0].u64);
+          DW_TagNode *tag_node = dw_tag_node_from_info_off(cu, cu->info_range.min + inst->operands[0].u64);
           DW_Tag      tag      = tag_node->tag;
           if (tag.kind == DW_TagKind_BaseType) {
             // extract encoding attribute
@@ -1244,7 +1247,8 @@ d2r_bytecode_from_expression(Arena       *arena,
         
         d2r_value_type_stack_push(scratch.arena, stack, call_site_result_type);
       } break;
-      case DW_ExprOp_Addrx: {
+      case DW_ExprOp_Addrx:
+      case DW_ExprOp_GNU_AddrIndex: {
         U64 addr = dw_addr_from_list_unit(addr_lu, inst->operands[0].u64);
         if (addr != max_U64) {
           if (addr >= image_base) {
@@ -1687,6 +1691,1045 @@ d2r_push_scope(Arena *arena, RDIM_ScopeChunkList *scopes, U64 scope_chunk_cap, D
   return scope;
 }
 
+////////////////////////////////
+//~ Split DWARF Helpers
+
+internal String8
+d2r_dwo_name_from_skeleton_cu(DW_Input *input, DW_CompUnit *cu)
+{
+  // pre-standard split units (GNU extension) name the .dwo with DW_AT_GNU_dwo_name
+  String8 dwo_name = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_DwoName);
+  if (dwo_name.size == 0) {
+    dwo_name = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_GNU_DwoName);
+  }
+  return dwo_name;
+}
+
+internal B32
+d2r_is_skeleton_cu(DW_Input *input, DW_CompUnit *cu)
+{
+  B32 is_skeleton = (cu->kind == DW_CompUnitKind_Skeleton || cu->dwo_id != 0);
+  if (!is_skeleton) {
+    is_skeleton = (d2r_dwo_name_from_skeleton_cu(input, cu).size != 0);
+  }
+  return is_skeleton;
+}
+
+internal String8
+d2r_mapped_data_from_file_path(String8 path)
+{
+  // file and map handles are closed right away, the view stays open -
+  // converted strings point into the mapped data, so d2r_convert reports the
+  // views and the caller unmaps them with d2r_unmap_views once output is written
+  String8   result = {0};
+  OS_Handle file   = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, path);
+  if (!os_handle_match(file, os_handle_zero())) {
+    FileProperties props = os_properties_from_file(file);
+    OS_Handle      map   = os_file_map_open(OS_AccessFlag_Read, file);
+    void          *base  = props.size ? os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, props.size)) : 0;
+    if (base) {
+      result = str8(base, props.size);
+    }
+    os_file_map_close(map);
+    os_file_close(file);
+  }
+  return result;
+}
+
+internal DW_Input
+d2r_dw_input_from_elf_data(Arena *arena, String8 data)
+{
+  // called from a single lane - run the lane-wide section loader on a thin
+  // lane context, so its syncs don't wait on the other lanes
+  DW_Input result = {0};
+  ELF_Bin  bin    = elf_bin_from_data(arena, data);
+  if (bin.shdrs.count) {
+    U64        broadcast_memory = 0;
+    LaneCtx    thin_lane_ctx    = {0, 1, {0}, &broadcast_memory};
+    LaneCtx    restore_lane_ctx = lane_ctx(thin_lane_ctx);
+    result = dw_input_from_elf_bin(arena, data, &bin);
+    lane_ctx(restore_lane_ctx);
+  }
+  return result;
+}
+
+internal D2R_DwarfPackage *
+d2r_dwarf_package_from_path(Arena *arena, String8 path)
+{
+  D2R_DwarfPackage *package = 0;
+  String8 data = d2r_mapped_data_from_file_path(path);
+  if (data.size) {
+    DW_Input     input    = d2r_dw_input_from_elf_data(arena, data);
+    DW_UnitIndex cu_index = dw_unit_index_from_data(arena, input.sec[DW_Section_CuIndex].data);
+    if (cu_index.unit_count) {
+      package           = push_array(arena, D2R_DwarfPackage, 1);
+      package->data     = data;
+      package->input    = input;
+      package->cu_index = cu_index;
+    } else {
+      os_file_map_view_close(os_handle_zero(), data.str, r1u64(0, data.size));
+    }
+  }
+  return package;
+}
+
+internal D2R_SplitUnit
+d2r_split_unit_from_skeleton(Arena *arena, D2R_DwarfPackage *package, String8 exe_dir, DW_Input *input, DW_CompUnit *skeleton_cu)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  D2R_SplitUnit result = {0};
+  
+  // find sections with the split unit, package takes precedence over .dwo files
+  DW_Input *split_input = 0;
+  if (package) {
+    U64 row = dw_unit_index_row_from_sig(&package->cu_index, skeleton_cu->dwo_id);
+    if (row) {
+      split_input  = push_array(arena, DW_Input, 1);
+      *split_input = dw_input_from_unit_index_row(&package->input, &package->cu_index, row);
+    }
+  }
+  if (split_input == 0) {
+    String8 dwo_name = d2r_dwo_name_from_skeleton_cu(input, skeleton_cu);
+    String8 comp_dir = dw_string_from_tag_attrib_kind(input, skeleton_cu, skeleton_cu->tag, DW_AttribKind_CompDir);
+    String8 dwo_path_candidates[] = {
+      path_style_from_str8(dwo_name) != PathStyle_Relative ? dwo_name : str8_zero(),
+      comp_dir.size ? push_str8f(scratch.arena, "%S/%S", comp_dir, dwo_name) : str8_zero(),
+      exe_dir.size  ? push_str8f(scratch.arena, "%S/%S", exe_dir, str8_skip_last_slash(dwo_name)) : str8_zero(),
+    };
+    for EachElement(candidate_idx, dwo_path_candidates) {
+      String8 dwo_path = dwo_path_candidates[candidate_idx];
+      if (dwo_name.size == 0 || dwo_path.size == 0) { continue; }
+      String8 dwo_data = d2r_mapped_data_from_file_path(dwo_path);
+      if (dwo_data.size) {
+        result.dwo_data = dwo_data;
+        split_input     = push_array(arena, DW_Input, 1);
+        *split_input    = d2r_dw_input_from_elf_data(arena, dwo_data);
+        break;
+      }
+    }
+  }
+  
+  // find split compile unit with matching id
+  if (split_input) {
+    // addresses of a split unit are in the skeleton's .debug_addr contribution;
+    // pre-standard split units keep their range lists in the skeleton's
+    // .debug_ranges too, at offsets from its ranges base
+    split_input->sec[DW_Section_Addr] = input->sec[DW_Section_Addr];
+    if (skeleton_cu->version < DW_Version_5) {
+      DW_Attrib *ranges_base_attrib = dw_attrib_from_tag(input, skeleton_cu, skeleton_cu->tag, DW_AttribKind_GNU_RangesBase);
+      U64        ranges_base        = dw_interp_sec_offset(ranges_base_attrib->form_kind, ranges_base_attrib->form);
+      split_input->sec[DW_Section_Ranges]      = input->sec[DW_Section_Ranges];
+      split_input->sec[DW_Section_Ranges].data = str8_skip(input->sec[DW_Section_Ranges].data, ranges_base);
+    }
+    
+    DW_ListUnitInput lu_input    = dw_list_unit_input_from_input(arena, split_input);
+    String8          info_data   = split_input->sec[DW_Section_Info].data;
+    Rng1U64List      unit_ranges = dw_unit_ranges_from_data(scratch.arena, info_data);
+    for EachNode(unit_range_n, Rng1U64Node, unit_ranges.first) {
+      // peek unit header - split type units have a different layout, and
+      // pre-standard .dwo files carry compile units only
+      U64             unit_length      = 0;
+      DW_Version      unit_version     = 0;
+      DW_CompUnitKind unit_kind        = DW_CompUnitKind_Reserved;
+      U64             unit_length_size = str8_deserial_read_dwarf_packed_size(info_data, unit_range_n->v.min, &unit_length);
+      U64             unit_version_off = unit_range_n->v.min + unit_length_size;
+      str8_deserial_read_struct(info_data, unit_version_off, &unit_version);
+      str8_deserial_read_struct(info_data, unit_version_off + sizeof(unit_version), &unit_kind);
+      if (unit_version == DW_Version_5 && unit_kind != DW_CompUnitKind_SplitCompile) { continue; }
+      if (unit_version < DW_Version_2 || DW_Version_5 < unit_version)                { continue; }
+      
+      DW_CompUnit split_cu = dw_cu_from_info_off(arena, split_input, lu_input, unit_range_n->v.min, 1);
+      if (split_cu.dwo_id == skeleton_cu->dwo_id) {
+        split_cu.addr_lu = skeleton_cu->addr_lu;
+        split_cu.low_pc  = skeleton_cu->low_pc;
+        result.input     = split_input;
+        result.cu        = split_cu;
+        break;
+      }
+    }
+  }
+  
+  scratch_end(scratch);
+  return result;
+}
+
+internal void
+d2r_unmap_views(String8List views)
+{
+  for EachNode(n, String8Node, views.first) {
+    os_file_map_view_close(os_handle_zero(), n->string.str, r1u64(0, n->string.size));
+  }
+}
+
+////////////////////////////////
+//~ Type Deduplication
+
+// every compile unit carries its own copy of the types it uses, so converted
+// types are split into classes of structurally identical types and collapsed
+// to one copy per class. classes are refined to a fixed point: all types
+// start out in one class, and every round splits a class whenever its types
+// differ in their own layout or in the classes of the types they refer to.
+// this terminates on self-referential types, and two types share a class
+// only if they match all the way down.
+//
+// units are deduplicated as soon as they are converted: a unit's classes are
+// given a structural hash that does not depend on the unit and are looked up
+// in a table shared by all units, and only classes no unit has kept yet are
+// copied out of the unit's temporary memory. the joined outputs then go
+// through one more pass, which merges what units could not - types in
+// reference cycles with too many look-alike members to hash, and copies kept
+// by two units racing on the same type.
+
+#define D2R_TYPE_CYCLE_ROOT_MAX 16
+
+internal B32
+d2r_type_hash_is_before(U128 a, U128 b)
+{
+  return a.u64[1] < b.u64[1] || (a.u64[1] == b.u64[1] && a.u64[0] < b.u64[0]);
+}
+
+internal void
+d2r_type_hash_update_string(XXH3_state_t *state, RDIM_String8 string)
+{
+  XXH3_128bits_update(state, &string.size, sizeof(string.size));
+  XXH3_128bits_update(state, string.str, string.size);
+}
+
+internal void
+d2r_type_hash_update_header(XXH3_state_t *state, RDIM_Type *type)
+{
+  B32 has_udt = (type->udt != 0);
+  XXH3_128bits_update(state, &type->kind, sizeof(type->kind));
+  XXH3_128bits_update(state, &type->byte_size, sizeof(type->byte_size));
+  XXH3_128bits_update(state, &type->flags, sizeof(type->flags));
+  XXH3_128bits_update(state, &type->off, sizeof(type->off));
+  XXH3_128bits_update(state, &type->count, sizeof(type->count));
+  XXH3_128bits_update(state, &has_udt, sizeof(has_udt));
+  d2r_type_hash_update_string(state, type->name);
+  d2r_type_hash_update_string(state, type->link_name);
+}
+
+internal U128
+d2r_type_hash_from_state(XXH3_state_t *state)
+{
+  U128          result = {0};
+  XXH128_hash_t hash   = XXH3_128bits_digest(state);
+  MemoryCopy(&result, &hash, sizeof(result));
+  return result;
+}
+
+internal U64
+d2r_type_class_from_type(D2R_TypeDedup *dedup, RDIM_Type *type)
+{
+  U64 result = 0;
+  U64 idx    = rdim_idx_from_type(type);
+  if (type == 0 || idx == 0) {
+    // null type - class zero
+  } else if (idx <= dedup->type_count && dedup->types[idx] == type) {
+    result = dedup->classes[idx];
+  } else {
+    // foreign type - only equal to itself
+    result = IntFromPtr(type);
+  }
+  return result;
+}
+
+internal U64
+d2r_type_local_class_from_type(D2R_TypeDedup *dedup, RDIM_Type *type)
+{
+  U64 result = 0;
+  U64 idx    = rdim_idx_from_type(type);
+  if (0 < idx && idx <= dedup->type_count && dedup->types[idx] == type) {
+    result = dedup->classes[idx];
+  }
+  return result;
+}
+
+internal U128
+d2r_type_signature_from_type(D2R_TypeDedup *dedup, RDIM_Type *type)
+{
+  XXH3_state_t state;
+  XXH3_128bits_reset(&state);
+  d2r_type_hash_update_header(&state, type);
+  
+  // own class keeps refinement monotonic, classes are only ever split
+  U64 self_class   = d2r_type_class_from_type(dedup, type);
+  U64 direct_class = d2r_type_class_from_type(dedup, type->direct_type);
+  XXH3_128bits_update(&state, &self_class, sizeof(self_class));
+  XXH3_128bits_update(&state, &direct_class, sizeof(direct_class));
+  if (type->param_types) {
+    for EachIndex(param_idx, type->count) {
+      U64 param_class = d2r_type_class_from_type(dedup, type->param_types[param_idx]);
+      XXH3_128bits_update(&state, &param_class, sizeof(param_class));
+    }
+  }
+  if (type->udt) {
+    for EachNode(m, RDIM_UDTMember, type->udt->first_member) {
+      U64 member_class = d2r_type_class_from_type(dedup, m->type);
+      XXH3_128bits_update(&state, &m->kind, sizeof(m->kind));
+      XXH3_128bits_update(&state, &m->off, sizeof(m->off));
+      XXH3_128bits_update(&state, &member_class, sizeof(member_class));
+      d2r_type_hash_update_string(&state, m->name);
+    }
+    for EachNode(e, RDIM_UDTEnumVal, type->udt->first_enum_val) {
+      XXH3_128bits_update(&state, &e->val, sizeof(e->val));
+      d2r_type_hash_update_string(&state, e->name);
+    }
+  }
+  
+  return d2r_type_hash_from_state(&state);
+}
+
+internal U128
+d2r_type_label_hash_from_type(RDIM_Type *type)
+{
+  // everything but the referenced types; the declaration site is part of the
+  // hash so that all copies behind one hash are interchangeable
+  XXH3_state_t state;
+  XXH3_128bits_reset(&state);
+  d2r_type_hash_update_header(&state, type);
+  if (type->udt) {
+    RDIM_UDT *udt = type->udt;
+    XXH3_128bits_update(&state, &udt->src_file, sizeof(udt->src_file));
+    XXH3_128bits_update(&state, &udt->line, sizeof(udt->line));
+    XXH3_128bits_update(&state, &udt->col, sizeof(udt->col));
+    XXH3_128bits_update(&state, &udt->member_count, sizeof(udt->member_count));
+    XXH3_128bits_update(&state, &udt->enum_val_count, sizeof(udt->enum_val_count));
+    for EachNode(m, RDIM_UDTMember, udt->first_member) {
+      XXH3_128bits_update(&state, &m->kind, sizeof(m->kind));
+      XXH3_128bits_update(&state, &m->off, sizeof(m->off));
+      d2r_type_hash_update_string(&state, m->name);
+    }
+    for EachNode(e, RDIM_UDTEnumVal, udt->first_enum_val) {
+      XXH3_128bits_update(&state, &e->val, sizeof(e->val));
+      d2r_type_hash_update_string(&state, e->name);
+    }
+  }
+  return d2r_type_hash_from_state(&state);
+}
+
+internal U64
+d2r_type_ref_count_from_type(RDIM_Type *type)
+{
+  U64 count = 1;
+  if (type->param_types) { count += type->count; }
+  if (type->udt)         { count += type->udt->member_count; }
+  return count;
+}
+
+internal void
+d2r_type_refs_from_type(RDIM_Type *type, RDIM_Type **refs_out)
+{
+  U64 ref_idx = 0;
+  refs_out[ref_idx] = type->direct_type;
+  ref_idx += 1;
+  if (type->param_types) {
+    for EachIndex(param_idx, type->count) {
+      refs_out[ref_idx] = type->param_types[param_idx];
+      ref_idx += 1;
+    }
+  }
+  if (type->udt) {
+    for EachNode(m, RDIM_UDTMember, type->udt->first_member) {
+      refs_out[ref_idx] = m->type;
+      ref_idx += 1;
+    }
+  }
+}
+
+internal RDIM_Type *
+d2r_dedup_remap_type(D2R_TypeDedup *dedup, RDIM_Type *type)
+{
+  // idempotent, pointers are shared (param arrays) and may be visited twice
+  RDIM_Type *result    = type;
+  U64        class_idx = d2r_type_local_class_from_type(dedup, type);
+  if (class_idx != 0) {
+    result = dedup->canonical_types[class_idx];
+  }
+  return result;
+}
+
+internal void
+d2r_dedup_remap_symbols(D2R_TypeDedup *dedup, RDIM_SymbolChunkList *symbols)
+{
+  U64 chunk_idx = 0;
+  for EachNode(chunk, RDIM_SymbolChunkNode, symbols->first) {
+    if (lane_from_task_idx(chunk_idx) == lane_idx()) {
+      for EachIndex(i, chunk->count) {
+        RDIM_Symbol *symbol    = &chunk->v[i];
+        symbol->type           = d2r_dedup_remap_type(dedup, symbol->type);
+        symbol->container_type = d2r_dedup_remap_type(dedup, symbol->container_type);
+      }
+    }
+    chunk_idx += 1;
+  }
+}
+
+internal void
+d2r_dedup_remap_scopes(D2R_TypeDedup *dedup, RDIM_ScopeChunkList *scopes)
+{
+  U64 chunk_idx = 0;
+  for EachNode(chunk, RDIM_ScopeChunkNode, scopes->first) {
+    if (lane_from_task_idx(chunk_idx) == lane_idx()) {
+      for EachIndex(i, chunk->count) {
+        for EachNode(local, RDIM_Local, chunk->v[i].first_local) { local->type = d2r_dedup_remap_type(dedup, local->type); }
+      }
+    }
+    chunk_idx += 1;
+  }
+}
+
+internal void
+d2r_dedup_remap_inline_sites(D2R_TypeDedup *dedup, RDIM_InlineSiteChunkList *inline_sites)
+{
+  U64 chunk_idx = 0;
+  for EachNode(chunk, RDIM_InlineSiteChunkNode, inline_sites->first) {
+    if (lane_from_task_idx(chunk_idx) == lane_idx()) {
+      for EachIndex(i, chunk->count) {
+        RDIM_InlineSite *site = &chunk->v[i];
+        site->type  = d2r_dedup_remap_type(dedup, site->type);
+        site->owner = d2r_dedup_remap_type(dedup, site->owner);
+      }
+    }
+    chunk_idx += 1;
+  }
+}
+
+internal D2R_TypeDedup *
+d2r_type_dedup_alloc(Arena *arena, RDIM_TypeChunkList *types)
+{
+  D2R_TypeDedup *dedup = push_array(arena, D2R_TypeDedup, 1);
+  dedup->type_count = types->total_count;
+  dedup->types      = push_array_no_zero(arena, RDIM_Type *, dedup->type_count + 1);
+  dedup->types[0]   = 0;
+  for EachNode(chunk, RDIM_TypeChunkNode, types->first) {
+    for EachIndex(i, chunk->count) { dedup->types[chunk->base_idx + i + 1] = &chunk->v[i]; }
+  }
+  dedup->signatures      = push_array_no_zero(arena, U128, dedup->type_count + 1);
+  dedup->classes         = push_array_no_zero(arena, U64, dedup->type_count + 1);
+  dedup->next_classes    = push_array_no_zero(arena, U64, dedup->type_count + 1);
+  dedup->slot_count      = u64_up_to_pow2((dedup->type_count + 1) * 2);
+  dedup->slots           = push_array_no_zero(arena, U64, dedup->slot_count);
+  dedup->canonical_types = push_array(arena, RDIM_Type *, dedup->type_count + 1);
+  return dedup;
+}
+
+internal void
+d2r_refine_type_classes(D2R_TypeDedup *dedup)
+{
+  {
+    Rng1U64 range = lane_range(dedup->type_count);
+    for EachInRange(i, range) { dedup->classes[i + 1] = 1; }
+  }
+  lane_sync();
+  for (U64 prev_class_count = 1;;) {
+    {
+      Rng1U64 range = lane_range(dedup->type_count);
+      for EachInRange(i, range) { dedup->signatures[i + 1] = d2r_type_signature_from_type(dedup, dedup->types[i + 1]); }
+      
+      Rng1U64 slot_range = lane_range(dedup->slot_count);
+      MemoryZero(dedup->slots + slot_range.min, dim_1u64(slot_range) * sizeof(dedup->slots[0]));
+    }
+    lane_sync();
+    
+    // types with matching signatures go to the slot of the smallest index
+    {
+      U64     slot_mask = dedup->slot_count - 1;
+      Rng1U64 range     = lane_range(dedup->type_count);
+      for EachInRange(i, range) {
+        U64  idx  = i + 1;
+        U128 hash = dedup->signatures[idx];
+        for (U64 slot_idx = hash.u64[0] & slot_mask;; slot_idx = (slot_idx + 1) & slot_mask) {
+          U64 slot = ins_atomic_u64_eval(&dedup->slots[slot_idx]);
+          if (slot == 0) {
+            slot = ins_atomic_u64_eval_cond_assign(&dedup->slots[slot_idx], idx, 0);
+            if (slot == 0) { break; }
+          }
+          if (u128_match(dedup->signatures[slot], hash)) {
+            // keep smallest index, so the pick doesn't depend on lane timing
+            while (idx < slot) {
+              U64 prev = ins_atomic_u64_eval_cond_assign(&dedup->slots[slot_idx], idx, slot);
+              if (prev == slot) { break; }
+              slot = prev;
+            }
+            break;
+          }
+        }
+      }
+    }
+    lane_sync();
+    
+    // smallest index with the same signature names the class
+    {
+      U64     slot_mask   = dedup->slot_count - 1;
+      U64     class_count = 0;
+      Rng1U64 range       = lane_range(dedup->type_count);
+      for EachInRange(i, range) {
+        U64  idx  = i + 1;
+        U128 hash = dedup->signatures[idx];
+        for (U64 slot_idx = hash.u64[0] & slot_mask;; slot_idx = (slot_idx + 1) & slot_mask) {
+          U64 slot = dedup->slots[slot_idx];
+          if (u128_match(dedup->signatures[slot], hash)) {
+            dedup->next_classes[idx] = slot;
+            class_count += (slot == idx);
+            break;
+          }
+        }
+      }
+      ins_atomic_u64_add_eval(&dedup->class_count, class_count);
+    }
+    lane_sync();
+    
+    if (lane_idx() == 0) { Swap(U64 *, dedup->classes, dedup->next_classes); }
+    lane_sync();
+    
+    // classes only split, so an unchanged count means a fixed point
+    U64 class_count = dedup->class_count;
+    lane_sync();
+    if (lane_idx() == 0) { dedup->class_count = 0; }
+    if (class_count == prev_class_count) { break; }
+    prev_class_count = class_count;
+  }
+}
+
+internal D2R_TypeHashNode *
+d2r_type_hash_table_search(D2R_TypeHashTable *table, U128 hash)
+{
+  D2R_TypeHashNode *result = 0;
+  D2R_TypeHashNode *head   = ins_atomic_ptr_eval(&table->buckets[hash.u64[1] & (table->bucket_count - 1)]);
+  for EachNode(n, D2R_TypeHashNode, head) {
+    if (u128_match(n->hash, hash)) {
+      result = n;
+      break;
+    }
+  }
+  return result;
+}
+
+internal D2R_TypeHashNode *
+d2r_type_hash_table_insert(D2R_TypeHashTable *table, D2R_TypeHashNode *node)
+{
+  // returns the node that is already in the table if another unit inserted
+  // the same hash first
+  D2R_TypeHashNode  *result  = node;
+  D2R_TypeHashNode **bucket  = &table->buckets[node->hash.u64[1] & (table->bucket_count - 1)];
+  D2R_TypeHashNode  *checked = 0;
+  for (D2R_TypeHashNode *head = ins_atomic_ptr_eval(bucket);;) {
+    for (D2R_TypeHashNode *n = head; n != checked; n = n->next) {
+      if (u128_match(n->hash, node->hash)) {
+        result = n;
+        break;
+      }
+    }
+    if (result != node) { break; }
+    node->next = head;
+    D2R_TypeHashNode *prev = ins_atomic_ptr_eval_cond_assign(bucket, node, head);
+    if (prev == head) { break; }
+    checked = head;
+    head    = prev;
+  }
+  return result;
+}
+
+internal void
+d2r_type_hash_node_lower_order_key(D2R_TypeHashNode *node, U64 order_key)
+{
+  for (U64 current = ins_atomic_u64_eval(&node->order_key); order_key < current;) {
+    U64 prev = ins_atomic_u64_eval_cond_assign(&node->order_key, order_key, current);
+    if (prev == current) { break; }
+    current = prev;
+  }
+}
+
+internal U128
+d2r_type_hash_from_walk(D2R_TypeDedup *dedup, U128 *labels, U128 *hashes, U64 *scc_ids, U64 scc_id, U64 *ref_first, RDIM_Type **refs, U64 *walk_idxs, U64 *walk_nodes, U64 *walk_refs, U64 root)
+{
+  // walks the component from root in reference order. classes visited before
+  // are referred to by visit number and classes outside the component stand
+  // in by their hash; visit numbers are left in walk_idxs
+  XXH3_state_t state;
+  XXH3_128bits_reset(&state);
+  
+  U64 walk_count = 0;
+  U64 walk_idx   = 1;
+  walk_idxs[root]        = walk_idx;
+  walk_nodes[walk_count] = root;
+  walk_refs[walk_count]  = ref_first[root];
+  walk_count += 1;
+  XXH3_128bits_update(&state, &labels[root], sizeof(labels[root]));
+  while (walk_count > 0) {
+    U64 walk_node = walk_nodes[walk_count - 1];
+    if (walk_refs[walk_count - 1] >= ref_first[walk_node + 1]) {
+      walk_count -= 1;
+      continue;
+    }
+    RDIM_Type *ref_type = refs[walk_refs[walk_count - 1]];
+    U64        ref      = d2r_type_local_class_from_type(dedup, ref_type);
+    walk_refs[walk_count - 1] += 1;
+    if (ref == 0) {
+      // null or foreign type - foreign types are shared by all units
+      U8 tag = 0;
+      XXH3_128bits_update(&state, &tag, sizeof(tag));
+      XXH3_128bits_update(&state, &ref_type, sizeof(ref_type));
+    } else if (scc_ids[ref] != scc_id) {
+      U8 tag = 1;
+      XXH3_128bits_update(&state, &tag, sizeof(tag));
+      XXH3_128bits_update(&state, &hashes[ref], sizeof(hashes[ref]));
+    } else if (walk_idxs[ref] != 0) {
+      U8 tag = 2;
+      XXH3_128bits_update(&state, &tag, sizeof(tag));
+      XXH3_128bits_update(&state, &walk_idxs[ref], sizeof(walk_idxs[ref]));
+    } else {
+      U8 tag = 3;
+      XXH3_128bits_update(&state, &tag, sizeof(tag));
+      XXH3_128bits_update(&state, &labels[ref], sizeof(labels[ref]));
+      walk_idx += 1;
+      walk_idxs[ref]         = walk_idx;
+      walk_nodes[walk_count] = ref;
+      walk_refs[walk_count]  = ref_first[ref];
+      walk_count += 1;
+    }
+  }
+  
+  return d2r_type_hash_from_state(&state);
+}
+
+internal void
+d2r_canonicalize_unit_types(Arena *arena, D2R_TypeHashTable *type_hash_table, U64 unit_order, RDIM_TypeChunkList *unit_types, D2R_CompUnitOutput *out)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  // units are converted wide, each one on a single lane - run the lane-wide
+  // refinement on a thin lane context
+  U64     broadcast_memory = 0;
+  LaneCtx thin_lane_ctx    = {0, 1, {0}, &broadcast_memory};
+  LaneCtx restore_lane_ctx = lane_ctx(thin_lane_ctx);
+  
+  D2R_TypeDedup *dedup = d2r_type_dedup_alloc(scratch.arena, unit_types);
+  d2r_refine_type_classes(dedup);
+  
+  ////////////////////////////////
+  
+  U64         type_count = dedup->type_count;
+  U128       *labels     = push_array_no_zero(scratch.arena, U128, type_count + 1);
+  U64        *ref_first  = push_array(scratch.arena, U64, type_count + 2);
+  RDIM_Type **refs       = 0;
+  {
+    U64 ref_count = 0;
+    for (U64 idx = 1; idx <= type_count; idx += 1) {
+      ref_first[idx] = ref_count;
+      if (dedup->classes[idx] == idx) {
+        labels[idx] = d2r_type_label_hash_from_type(dedup->types[idx]);
+        ref_count  += d2r_type_ref_count_from_type(dedup->types[idx]);
+      }
+    }
+    ref_first[type_count + 1] = ref_count;
+    refs = push_array_no_zero(scratch.arena, RDIM_Type *, ref_count);
+    for (U64 idx = 1; idx <= type_count; idx += 1) {
+      if (dedup->classes[idx] == idx) { d2r_type_refs_from_type(dedup->types[idx], refs + ref_first[idx]); }
+    }
+  }
+  
+  ////////////////////////////////
+  
+  // a strongly connected component is hashed by one walk over its classes,
+  // see d2r_type_hash_from_walk; components reached from it are hashed first.
+  // classes are minimal here, so two walks match exactly when the types match
+  // all the way down, and no two members of a component walk alike.
+  U128 *hashes     = push_array_no_zero(scratch.arena, U128, type_count + 1);
+  B8   *is_hashed  = push_array(scratch.arena, B8, type_count + 1);
+  U64  *scc_ids    = push_array(scratch.arena, U64, type_count + 1);
+  U64  *visit_idxs = push_array(scratch.arena, U64, type_count + 1);
+  U64  *low_idxs   = push_array_no_zero(scratch.arena, U64, type_count + 1);
+  U64  *scc_stack  = push_array_no_zero(scratch.arena, U64, type_count);
+  U64  *call_nodes = push_array_no_zero(scratch.arena, U64, type_count);
+  U64  *call_refs  = push_array_no_zero(scratch.arena, U64, type_count);
+  U64  *walk_idxs  = push_array(scratch.arena, U64, type_count + 1);
+  U64  *walk_nodes = push_array_no_zero(scratch.arena, U64, type_count);
+  U64  *walk_refs  = push_array_no_zero(scratch.arena, U64, type_count);
+  U64   scc_count  = 0;
+  U64   visit_idx  = 0;
+  for (U64 root = 1; root <= type_count; root += 1) {
+    if (dedup->classes[root] != root || visit_idxs[root] != 0) { continue; }
+    
+    // tarjan, components come out after all the components they reach
+    U64 scc_stack_count = 0;
+    U64 call_count      = 0;
+    visit_idx += 1;
+    visit_idxs[root]           = visit_idx;
+    low_idxs[root]             = visit_idx;
+    scc_stack[scc_stack_count] = root;
+    call_nodes[call_count]     = root;
+    call_refs[call_count]      = ref_first[root];
+    scc_stack_count += 1;
+    call_count      += 1;
+    while (call_count > 0) {
+      U64 node = call_nodes[call_count - 1];
+      if (call_refs[call_count - 1] < ref_first[node + 1]) {
+        U64 ref = d2r_type_local_class_from_type(dedup, refs[call_refs[call_count - 1]]);
+        call_refs[call_count - 1] += 1;
+        if (ref == 0) {
+          // null or foreign type
+        } else if (visit_idxs[ref] == 0) {
+          visit_idx += 1;
+          visit_idxs[ref]            = visit_idx;
+          low_idxs[ref]              = visit_idx;
+          scc_stack[scc_stack_count] = ref;
+          call_nodes[call_count]     = ref;
+          call_refs[call_count]      = ref_first[ref];
+          scc_stack_count += 1;
+          call_count      += 1;
+        } else if (scc_ids[ref] == 0) {
+          low_idxs[node] = Min(low_idxs[node], visit_idxs[ref]);
+        }
+        continue;
+      }
+      
+      call_count -= 1;
+      if (call_count > 0) {
+        U64 caller = call_nodes[call_count - 1];
+        low_idxs[caller] = Min(low_idxs[caller], low_idxs[node]);
+      }
+      if (low_idxs[node] != visit_idxs[node]) { continue; }
+      
+      // pop component
+      U64 scc_first = scc_stack_count;
+      do { scc_first -= 1; } while (scc_stack[scc_first] != node);
+      U64 *scc      = scc_stack + scc_first;
+      U64  scc_size = scc_stack_count - scc_first;
+      scc_stack_count = scc_first;
+      scc_count      += 1;
+      for EachIndex(i, scc_size) { scc_ids[scc[i]] = scc_count; }
+      
+      // a component is hashed when everything it reaches outside is hashed
+      B32 is_hashable = 1;
+      for (U64 i = 0; i < scc_size && is_hashable; i += 1) {
+        for (U64 ref_idx = ref_first[scc[i]]; ref_idx < ref_first[scc[i] + 1]; ref_idx += 1) {
+          U64 ref = d2r_type_local_class_from_type(dedup, refs[ref_idx]);
+          if (ref != 0 && scc_ids[ref] != scc_count && !is_hashed[ref]) {
+            is_hashable = 0;
+            break;
+          }
+        }
+      }
+      if (!is_hashable) { continue; }
+      
+      // the walk starts from the member that walks to the smallest hash of the
+      // ones with the smallest label, which is the same member in every unit
+      U128 root_label = labels[scc[0]];
+      U64  root_count = 0;
+      for EachIndex(i, scc_size) {
+        if (d2r_type_hash_is_before(labels[scc[i]], root_label)) {
+          root_label = labels[scc[i]];
+          root_count = 0;
+        }
+        root_count += u128_match(labels[scc[i]], root_label);
+      }
+      if (root_count > D2R_TYPE_CYCLE_ROOT_MAX) { continue; }
+      
+      U64  root     = 0;
+      U64  walked   = 0;
+      U128 scc_hash = {0};
+      for EachIndex(i, scc_size) {
+        if (!u128_match(labels[scc[i]], root_label)) { continue; }
+        if (walked != 0) {
+          for EachIndex(j, scc_size) { walk_idxs[scc[j]] = 0; }
+        }
+        U128 hash = d2r_type_hash_from_walk(dedup, labels, hashes, scc_ids, scc_count, ref_first, refs, walk_idxs, walk_nodes, walk_refs, scc[i]);
+        walked = scc[i];
+        if (root == 0 || d2r_type_hash_is_before(hash, scc_hash)) {
+          root     = scc[i];
+          scc_hash = hash;
+        }
+      }
+      
+      // members are told apart by where the walk from the root reached them
+      if (walked != root) {
+        for EachIndex(j, scc_size) { walk_idxs[scc[j]] = 0; }
+        d2r_type_hash_from_walk(dedup, labels, hashes, scc_ids, scc_count, ref_first, refs, walk_idxs, walk_nodes, walk_refs, root);
+      }
+      for EachIndex(i, scc_size) {
+        XXH3_state_t state;
+        XXH3_128bits_reset(&state);
+        XXH3_128bits_update(&state, &scc_hash, sizeof(scc_hash));
+        XXH3_128bits_update(&state, &walk_idxs[scc[i]], sizeof(walk_idxs[scc[i]]));
+        hashes[scc[i]] = d2r_type_hash_from_state(&state);
+      }
+      for EachIndex(i, scc_size) {
+        walk_idxs[scc[i]] = 0;
+        is_hashed[scc[i]] = 1;
+      }
+    }
+  }
+  
+  ////////////////////////////////
+  
+  // classes that no unit has kept yet are copied out, the rest point at the
+  // copy that is already kept; order keys stand for (unit, first position in
+  // unit), lowered to the smallest one a kept type was seen at
+  U64         kept_count = 0;
+  U64        *kept       = push_array_no_zero(scratch.arena, U64, type_count);
+  RDIM_Type **kept_types = push_array_no_zero(scratch.arena, RDIM_Type *, type_count);
+  out->type_order_keys = push_array_no_zero(arena, U64 *, type_count);
+  for (U64 idx = 1; idx <= type_count; idx += 1) {
+    if (dedup->classes[idx] != idx) { continue; }
+    U64               order_key = (unit_order << 32) | idx;
+    D2R_TypeHashNode *node      = 0;
+    if (is_hashed[idx]) {
+      node = d2r_type_hash_table_search(type_hash_table, hashes[idx]);
+      if (node != 0) {
+        d2r_type_hash_node_lower_order_key(node, order_key);
+        dedup->canonical_types[idx] = node->type;
+        continue;
+      }
+    }
+    
+    RDIM_Type *type = rdim_type_chunk_list_push(arena, &out->types, TYPE_CHUNK_CAP);
+    dedup->canonical_types[idx] = type;
+    kept[kept_count]       = idx;
+    kept_types[kept_count] = type;
+    
+    U64 *order_key_ptr = push_array_no_zero(arena, U64, 1);
+    *order_key_ptr = order_key;
+    if (is_hashed[idx]) {
+      D2R_TypeHashNode *new_node = push_array(arena, D2R_TypeHashNode, 1);
+      new_node->hash      = hashes[idx];
+      new_node->type      = type;
+      new_node->order_key = order_key;
+      node = d2r_type_hash_table_insert(type_hash_table, new_node);
+      if (node == new_node) {
+        order_key_ptr = &new_node->order_key;
+      } else {
+        // another unit got there first, this copy goes to the joined pass
+        d2r_type_hash_node_lower_order_key(node, order_key);
+        dedup->canonical_types[idx] = node->type;
+      }
+    }
+    out->type_order_keys[kept_count] = order_key_ptr;
+    kept_count += 1;
+  }
+  
+  // copies refer to kept types only, the unit's own types go away with it
+  for EachIndex(kept_idx, kept_count) {
+    RDIM_Type          *src       = dedup->types[kept[kept_idx]];
+    RDIM_Type          *dst       = kept_types[kept_idx];
+    RDIM_TypeChunkNode *dst_chunk = dst->chunk;
+    *dst             = *src;
+    dst->chunk       = dst_chunk;
+    dst->direct_type = d2r_dedup_remap_type(dedup, src->direct_type);
+    if (src->param_types) {
+      dst->param_types = push_array_no_zero(arena, RDIM_Type *, src->count);
+      for EachIndex(param_idx, src->count) { dst->param_types[param_idx] = d2r_dedup_remap_type(dedup, src->param_types[param_idx]); }
+    }
+    if (src->udt) {
+      RDIM_UDT          *udt   = rdim_udt_chunk_list_push(arena, &out->udts, UDT_CHUNK_CAP);
+      RDIM_UDTChunkNode *chunk = udt->chunk;
+      MemoryZeroStruct(udt);
+      udt->chunk     = chunk;
+      udt->self_type = dst;
+      udt->src_file  = src->udt->src_file;
+      udt->line      = src->udt->line;
+      udt->col       = src->udt->col;
+      for EachNode(m, RDIM_UDTMember, src->udt->first_member) {
+        RDIM_UDTMember *member = rdim_udt_push_member(arena, &out->udts, udt);
+        member->kind = m->kind;
+        member->name = m->name;
+        member->type = d2r_dedup_remap_type(dedup, m->type);
+        member->off  = m->off;
+      }
+      for EachNode(e, RDIM_UDTEnumVal, src->udt->first_enum_val) {
+        RDIM_UDTEnumVal *enum_val = rdim_udt_push_enum_val(arena, &out->udts, udt);
+        enum_val->name = e->name;
+        enum_val->val  = e->val;
+      }
+      dst->udt = udt;
+    }
+  }
+  
+  d2r_dedup_remap_symbols(dedup, &out->gvars);
+  d2r_dedup_remap_symbols(dedup, &out->tvars);
+  d2r_dedup_remap_symbols(dedup, &out->procs);
+  d2r_dedup_remap_scopes(dedup, &out->scopes);
+  d2r_dedup_remap_inline_sites(dedup, &out->inline_sites);
+  
+  lane_ctx(restore_lane_ctx);
+  scratch_end(scratch);
+}
+
+internal void
+d2r_dedup_types(Arena *arena, RDIM_BakeParams *bake_params, U64 *type_order_keys)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  ////////////////////////////////
+  
+  D2R_TypeDedup *dedup = 0;
+  if (lane_idx() == 0) {
+    dedup             = d2r_type_dedup_alloc(scratch.arena, &bake_params->types);
+    dedup->order_keys = type_order_keys;
+    dedup->sources    = push_array_no_zero(scratch.arena, U64, dedup->type_count + 1);
+    
+    dedup->udt_count = bake_params->udts.total_count;
+    dedup->udts      = push_array_no_zero(scratch.arena, RDIM_UDT *, dedup->udt_count + 1);
+    dedup->udts[0]   = 0;
+    for EachNode(chunk, RDIM_UDTChunkNode, bake_params->udts.first) {
+      for EachIndex(i, chunk->count) { dedup->udts[chunk->base_idx + i + 1] = &chunk->v[i]; }
+    }
+    dedup->udt_remap = push_array(scratch.arena, U64, dedup->udt_count + 1);
+  }
+  lane_sync_u64(&dedup, 0);
+  
+  ////////////////////////////////
+  
+  ProfBegin("Refine Type Classes");
+  d2r_refine_type_classes(dedup);
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  // classes go in order of their smallest order key, which is where the class
+  // first occurs in unit order, and the type with that key is the one copied
+  if (lane_idx() == 0) {
+    U64 class_count = 0;
+    for (U64 idx = 1; idx <= dedup->type_count; idx += 1) {
+      U64 class_idx = dedup->classes[idx];
+      if (class_idx == idx) {
+        dedup->sources[class_idx] = idx;
+        class_count += 1;
+      } else if (dedup->order_keys[idx] < dedup->order_keys[dedup->sources[class_idx]]) {
+        dedup->sources[class_idx] = idx;
+      }
+    }
+    
+    RDIM_SortKey *keys    = push_array_no_zero(scratch.arena, RDIM_SortKey, class_count);
+    U64           key_idx = 0;
+    for (U64 idx = 1; idx <= dedup->type_count; idx += 1) {
+      if (dedup->classes[idx] == idx) {
+        keys[key_idx].key = dedup->order_keys[dedup->sources[idx]];
+        keys[key_idx].val = PtrFromInt(idx);
+        key_idx += 1;
+      }
+    }
+    radsort(keys, class_count, rdim_sort_key_is_before);
+    
+    dedup->new_types        = push_array(arena, RDIM_TypeChunkNode, 1);
+    dedup->new_types->v     = push_array_no_zero(arena, RDIM_Type, class_count);
+    dedup->new_types->count = class_count;
+    dedup->new_types->cap   = class_count;
+    for EachIndex(i, class_count) {
+      dedup->canonical_types[IntFromPtr(keys[i].val)] = &dedup->new_types->v[i];
+    }
+  }
+  lane_sync();
+  
+  ProfBegin("Copy Canonical Types");
+  {
+    Rng1U64 range = lane_range(dedup->type_count);
+    for EachInRange(i, range) {
+      U64 idx = i + 1;
+      if (dedup->classes[idx] == idx) {
+        RDIM_Type *dst = dedup->canonical_types[idx];
+        *dst       = *dedup->types[dedup->sources[idx]];
+        dst->chunk = dedup->new_types;
+      }
+    }
+  }
+  lane_sync();
+  ProfEnd();
+  
+  // keep the UDTs that canonical types point to
+  if (lane_idx() == 0) {
+    U64 new_udt_count        = 0;
+    U64 new_member_count     = 0;
+    U64 new_enum_val_count   = 0;
+    for EachIndex(i, dedup->new_types->count) {
+      RDIM_UDT *udt     = dedup->new_types->v[i].udt;
+      U64       udt_idx = rdim_idx_from_udt(udt);
+      if (0 < udt_idx && udt_idx <= dedup->udt_count && dedup->udt_remap[udt_idx] == 0) {
+        new_udt_count      += 1;
+        new_member_count   += udt->member_count;
+        new_enum_val_count += udt->enum_val_count;
+        dedup->udt_remap[udt_idx] = new_udt_count;
+      }
+    }
+    dedup->new_udts        = push_array(arena, RDIM_UDTChunkNode, 1);
+    dedup->new_udts->v     = push_array_no_zero(arena, RDIM_UDT, new_udt_count);
+    dedup->new_udts->count = new_udt_count;
+    dedup->new_udts->cap   = new_udt_count;
+    
+    MemoryZeroStruct(&bake_params->udts);
+    bake_params->udts.first                = dedup->new_udts;
+    bake_params->udts.last                 = dedup->new_udts;
+    bake_params->udts.chunk_count          = 1;
+    bake_params->udts.total_count          = new_udt_count;
+    bake_params->udts.total_member_count   = new_member_count;
+    bake_params->udts.total_enum_val_count = new_enum_val_count;
+  }
+  lane_sync();
+  
+  ProfBegin("Copy Canonical UDTs");
+  {
+    Rng1U64 range = lane_range(dedup->udt_count);
+    for EachInRange(i, range) {
+      U64 udt_idx = i + 1;
+      if (dedup->udt_remap[udt_idx]) {
+        RDIM_UDT *dst = &dedup->new_udts->v[dedup->udt_remap[udt_idx] - 1];
+        *dst       = *dedup->udts[udt_idx];
+        dst->chunk = dedup->new_udts;
+      }
+    }
+  }
+  lane_sync();
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  ProfBegin("Remap Type References");
+  {
+    Rng1U64 type_range = lane_range(dedup->new_types->count);
+    for EachInRange(i, type_range) {
+      RDIM_Type *type   = &dedup->new_types->v[i];
+      U64        udt_idx = rdim_idx_from_udt(type->udt);
+      type->direct_type = d2r_dedup_remap_type(dedup, type->direct_type);
+      if (type->param_types) {
+        for EachIndex(param_idx, type->count) { type->param_types[param_idx] = d2r_dedup_remap_type(dedup, type->param_types[param_idx]); }
+      }
+      if (0 < udt_idx && udt_idx <= dedup->udt_count) {
+        type->udt = &dedup->new_udts->v[dedup->udt_remap[udt_idx] - 1];
+      }
+    }
+    
+    Rng1U64 udt_range = lane_range(dedup->new_udts->count);
+    for EachInRange(i, udt_range) {
+      RDIM_UDT *udt  = &dedup->new_udts->v[i];
+      udt->self_type = d2r_dedup_remap_type(dedup, udt->self_type);
+      for EachNode(m, RDIM_UDTMember, udt->first_member) { m->type = d2r_dedup_remap_type(dedup, m->type); }
+    }
+    
+    d2r_dedup_remap_symbols(dedup, &bake_params->global_variables);
+    d2r_dedup_remap_symbols(dedup, &bake_params->thread_variables);
+    d2r_dedup_remap_symbols(dedup, &bake_params->constants);
+    d2r_dedup_remap_symbols(dedup, &bake_params->procedures);
+    d2r_dedup_remap_scopes(dedup, &bake_params->scopes);
+    d2r_dedup_remap_inline_sites(dedup, &bake_params->inline_sites);
+  }
+  lane_sync();
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  if (lane_idx() == 0) {
+    MemoryZeroStruct(&bake_params->types);
+    bake_params->types.first       = dedup->new_types;
+    bake_params->types.last        = dedup->new_types;
+    bake_params->types.chunk_count = 1;
+    bake_params->types.total_count = dedup->new_types->count;
+  }
+  lane_sync();
+  
+  scratch_end(scratch);
+}
+
 ////////////////////////////////
 //~ rjf: Main Conversion Entry Point
 
@@ -2202,7 +3245,7 @@ d2r_convert_types(Arena         *arena,
         if(parent->udt != 0)
         {
           RDIM_Type      *type   = d2r_find_or_convert_type(arena, type_table, input, cu, cu_lang, arch_addr_size, tag, DW_AttribKind_Type);
-          RDIM_UDTMember *member = rdim_udt_push_member(arena, &udts, parent->udt);
+          RDIM_UDTMember *member = rdim_udt_push_member(arena, type_table->udts, parent->udt);
           member->kind           = RDI_MemberKind_Base;
           member->type           = type;
           member->off            = safe_cast_u32(dw_const_u32_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_DataMemberLocation));
@@ -2233,9 +3276,7 @@ d2r_convert_udts(Arena         *arena,
           d2r_tag_iterator_skip_children(it);
         } else {
           RDIM_Type *type = d2r_type_from_offset(type_table, tag.info_off);
-          RDIM_UDT  *udt  = rdim_udt_chunk_list_push(arena, &udts, UDT_CHUNK_CAP);
-          udt->self_type = type;
-          type->udt      = udt;
+          d2r_create_udt(arena, type_table, type);
         }
       } break;
       case DW_TagKind_StructureType: {
@@ -2244,9 +3285,7 @@ d2r_convert_udts(Arena         *arena,
           d2r_tag_iterator_skip_children(it);
         } else {
           RDIM_Type *type = d2r_type_from_offset(type_table, tag.info_off);
-          RDIM_UDT  *udt  = rdim_udt_chunk_list_push(arena, &udts, UDT_CHUNK_CAP);
-          udt->self_type = type;
-          type->udt      = udt;
+          d2r_create_udt(arena, type_table, type);
         }
       } break;
       case DW_TagKind_UnionType: {
@@ -2255,9 +3294,7 @@ d2r_convert_udts(Arena         *arena,
           d2r_tag_iterator_skip_children(it);
         } else {
           RDIM_Type *type = d2r_type_from_offset(type_table, tag.info_off);
-          RDIM_UDT  *udt  = rdim_udt_chunk_list_push(arena, &udts, UDT_CHUNK_CAP);
-          udt->self_type = type;
-          type->udt      = udt;
+          d2r_create_udt(arena, type_table, type);
         }
       } break;
       case DW_TagKind_EnumerationType: {
@@ -2266,9 +3303,7 @@ d2r_convert_udts(Arena         *arena,
           d2r_tag_iterator_skip_children(it);
         } else {
           RDIM_Type *type = d2r_type_from_offset(type_table, tag.info_off);
-          RDIM_UDT  *udt  = rdim_udt_chunk_list_push(arena, &udts, UDT_CHUNK_CAP);
-          udt->self_type = type;
-          type->udt      = udt;
+          d2r_create_udt(arena, type_table, type);
         }
       } break;
       case DW_TagKind_Member: {
@@ -2284,7 +3319,7 @@ d2r_convert_udts(Arena         *arena,
           }
           
           RDIM_Type      *parent_type = d2r_type_from_offset(type_table, parent_tag.info_off);
-          RDIM_UDTMember *udt_member  = rdim_udt_push_member(arena, &udts, parent_type->udt);
+          RDIM_UDTMember *udt_member  = rdim_udt_push_member(arena, type_table->udts, parent_type->udt);
           udt_member->kind = RDI_MemberKind_DataField;
           udt_member->name = dw_string_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_Name);
           udt_member->type = d2r_type_from_attrib(type_table, input, cu, tag, DW_AttribKind_Type);
@@ -2298,7 +3333,7 @@ d2r_convert_udts(Arena         *arena,
         DW_Tag parent_tag = d2r_tag_iterator_parent_tag(it);
         if (parent_tag.kind == DW_TagKind_EnumerationType) {
           RDIM_Type       *parent_type = d2r_type_from_offset(type_table, parent_tag.info_off);
-          RDIM_UDTEnumVal *udt_member  = rdim_udt_push_enum_val(arena, &udts, parent_type->udt);
+          RDIM_UDTEnumVal *udt_member  = rdim_udt_push_enum_val(arena, type_table->udts, parent_type->udt);
           udt_member->name = dw_string_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_Name);
           udt_member->val  = dw_const_u64_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_ConstValue);
         } else {
@@ -2312,18 +3347,21 @@ d2r_convert_udts(Arena         *arena,
 }
 
 internal void
-d2r_convert_symbols(Arena         *arena,
-                    D2R_TypeTable *type_table,
-                    RDIM_Scope    *global_scope,
-                    DW_Input      *input,
-                    DW_CompUnit   *cu,
-                    DW_Language    cu_lang,
-                    U64            arch_addr_size,
-                    U64            image_base,
-                    Arch           arch,
-                    DW_TagNode    *root)
+d2r_convert_symbols(Arena              *arena,
+                    D2R_TypeTable      *type_table,
+                    D2R_CompUnitOutput *out,
+                    RDIM_Scope         *global_scope,
+                    DW_Input           *input,
+                    DW_CompUnit        *cu,
+                    DW_Language         cu_lang,
+                    U64                 arch_addr_size,
+                    U64                 image_base,
+                    Arch                arch,
+                    DW_TagNode         *root)
 {
-  Temp scratch = scratch_begin(&arena, 1);
+  // types made here go to the unit's type arena, keep scratch off of it
+  Arena *conflicts[] = { arena, type_table->arena };
+  Temp   scratch     = scratch_begin(conflicts, ArrayCount(conflicts));
   for (D2R_TagIterator *it = d2r_tag_iterator_init(scratch.arena, root); it->tag_node != 0; d2r_tag_iterator_next(scratch.arena, it)) {
     DW_TagNode *tag_node = it->tag_node;
     DW_Tag      tag      = tag_node->tag;
@@ -2356,13 +3394,13 @@ d2r_convert_symbols(Arena         *arena,
         switch (inl) {
           case DW_Inl_NotInlined: {
             U64         param_count = 0;
-            RDIM_Type **params      = d2r_collect_proc_params(arena, type_table, input, cu, tag_node, &param_count);
+            RDIM_Type **params      = d2r_collect_proc_params(type_table->arena, type_table, input, cu, tag_node, &param_count);
             
             // get return type
             RDIM_Type *ret_type = d2r_type_from_attrib(type_table, input, cu, tag, DW_AttribKind_Type);
             
             // fill out proc type
-            RDIM_Type *proc_type   = d2r_create_type(arena, type_table);
+            RDIM_Type *proc_type   = d2r_create_type(type_table->arena, type_table);
             proc_type->kind        = RDI_TypeKind_Function;
             proc_type->byte_size   = arch_addr_size;
             proc_type->direct_type = ret_type;
@@ -2379,11 +3417,11 @@ d2r_convert_symbols(Arena         *arena,
             String8 frame_base_expr = dw_exprloc_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_FrameBase);
             
             // get proc container symbol
-            RDIM_Symbol *proc = rdim_symbol_chunk_list_push(arena, &procs,  PROC_CHUNK_CAP);
+            RDIM_Symbol *proc = rdim_symbol_chunk_list_push(arena, &out->procs, PROC_CHUNK_CAP);
             
             // make scope
             Rng1U64List  ranges     = d2r_range_list_from_tag(scratch.arena, input, cu, image_base, tag);
-            RDIM_Scope  *root_scope = d2r_push_scope(arena, &scopes, SCOPE_CHUNK_CAP, it->stack, ranges);
+            RDIM_Scope  *root_scope = d2r_push_scope(arena, &out->scopes, SCOPE_CHUNK_CAP, it->stack, ranges);
             root_scope->symbol      = proc;
             
             // fill out proc
@@ -2394,7 +3432,7 @@ d2r_convert_symbols(Arena         *arena,
             proc->container_symbol = 0;
             proc->container_type   = container_type;
             proc->root_scope       = root_scope;
-            proc->location_cases   = d2r_locset_from_attrib(arena, &scopes, root_scope, &locations, input, cu, image_base, arch, tag, DW_AttribKind_FrameBase);
+            proc->location_cases   = d2r_locset_from_attrib(arena, &out->scopes, root_scope, &out->locations, input, cu, image_base, arch, tag, DW_AttribKind_FrameBase);
             
             // sub program with user-defined parent tag is a method
             DW_Tag parent_tag = d2r_tag_iterator_parent_tag(it);
@@ -2409,7 +3447,7 @@ d2r_convert_symbols(Arena         *arena,
               }
               
               RDIM_Type      *type   = d2r_type_from_offset(type_table, parent_tag.info_off);
-              RDIM_UDTMember *member = rdim_udt_push_member(arena, &udts, type->udt);
+              RDIM_UDTMember *member = rdim_udt_push_member(type_table->arena, type_table->udts, type->udt);
               member->kind           = member_kind;
               member->type           = type;
               member->name           = dw_string_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_Name);
@@ -2429,13 +3467,13 @@ d2r_convert_symbols(Arena         *arena,
       } break;
       case DW_TagKind_InlinedSubroutine: {
         U64         param_count = 0;
-        RDIM_Type **params      = d2r_collect_proc_params(arena, type_table, input, cu, tag_node, &param_count);
+        RDIM_Type **params      = d2r_collect_proc_params(type_table->arena, type_table, input, cu, tag_node, &param_count);
         
         // get return type
         RDIM_Type *ret_type = d2r_type_from_attrib(type_table, input, cu, tag, DW_AttribKind_Type);
         
         // fill out proc type
-        RDIM_Type *proc_type   = d2r_create_type(arena, type_table);
+        RDIM_Type *proc_type   = d2r_create_type(type_table->arena, type_table);
         proc_type->kind        = RDI_TypeKind_Function;
         proc_type->byte_size   = arch_addr_size;
         proc_type->direct_type = ret_type;
@@ -2449,7 +3487,7 @@ d2r_convert_symbols(Arena         *arena,
         }
         
         // fill out inline site
-        RDIM_InlineSite *inline_site = rdim_inline_site_chunk_list_push(arena, &inline_sites, INLINE_SITE_CHUNK_CAP);
+        RDIM_InlineSite *inline_site = rdim_inline_site_chunk_list_push(arena, &out->inline_sites, INLINE_SITE_CHUNK_CAP);
         inline_site->name            = dw_string_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_Name);
         inline_site->type            = proc_type;
         inline_site->owner           = owner;
@@ -2457,7 +3495,7 @@ d2r_convert_symbols(Arena         *arena,
         
         // make scope
         Rng1U64List  ranges     = d2r_range_list_from_tag(scratch.arena, input, cu, image_base, tag);
-        RDIM_Scope  *root_scope = d2r_push_scope(arena, &scopes, SCOPE_CHUNK_CAP, it->stack, ranges);
+        RDIM_Scope  *root_scope = d2r_push_scope(arena, &out->scopes, SCOPE_CHUNK_CAP, it->stack, ranges);
         root_scope->inline_site = inline_site;
       } break;
       case DW_TagKind_Variable: {
@@ -2469,11 +3507,11 @@ d2r_convert_symbols(Arena         *arena,
             parent_tag.kind == DW_TagKind_InlinedSubroutine ||
             parent_tag.kind == DW_TagKind_LexicalBlock) {
           RDIM_Scope *scope = it->stack->next->scope;
-          RDIM_Local *local = rdim_scope_push_local(arena, &scopes, scope);
+          RDIM_Local *local = rdim_scope_push_local(arena, &out->scopes, scope);
           local->kind           = RDI_LocalKind_Variable;
           local->name           = name;
           local->type           = type;
-          local->location_cases = d2r_var_locset_from_tag(arena, &scopes, scope, &locations, input, cu, image_base, arch, tag);
+          local->location_cases = d2r_var_locset_from_tag(arena, &out->scopes, scope, &out->locations, input, cu, image_base, arch, tag);
         } else {
           
           // NOTE: due to a bug in clang in stb_sprint.h local variables
@@ -2508,8 +3546,8 @@ d2r_convert_symbols(Arena         *arena,
           }
           
           RDIM_SymbolChunkList *var_chunks; U64 var_chunks_cap;
-          if (is_thread_var) { var_chunks = &tvars; var_chunks_cap = TVAR_CHUNK_CAP; }
-          else               { var_chunks = &gvars; var_chunks_cap = GVAR_CHUNK_CAP; }
+          if (is_thread_var) { var_chunks = &out->tvars; var_chunks_cap = TVAR_CHUNK_CAP; }
+          else               { var_chunks = &out->gvars; var_chunks_cap = GVAR_CHUNK_CAP; }
           
           RDIM_Symbol *var = rdim_symbol_chunk_list_push(arena, var_chunks, var_chunks_cap);
           var->is_extern        = dw_flag_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_External);
@@ -2525,11 +3563,11 @@ d2r_convert_symbols(Arena         *arena,
         DW_Tag parent_tag = d2r_tag_iterator_parent_tag(it);
         if (parent_tag.kind == DW_TagKind_SubProgram || parent_tag.kind == DW_TagKind_InlinedSubroutine) {
           RDIM_Scope *scope = it->stack->next->scope;
-          RDIM_Local *param = rdim_scope_push_local(arena, &scopes, scope);
+          RDIM_Local *param = rdim_scope_push_local(arena, &out->scopes, scope);
           param->kind           = RDI_LocalKind_Parameter;
           param->name           = dw_string_from_tag_attrib_kind(input, cu, tag, DW_AttribKind_Name);
           param->type           = d2r_type_from_attrib(type_table, input, cu, tag, DW_AttribKind_Type);
-          param->location_cases = d2r_var_locset_from_tag(arena, &scopes, scope, &locations, input, cu, image_base, arch, tag);
+          param->location_cases = d2r_var_locset_from_tag(arena, &out->scopes, scope, &out->locations, input, cu, image_base, arch, tag);
         } else {
           // TODO: error handling
           AssertAlways(!"this is a local variable");
@@ -2541,7 +3579,7 @@ d2r_convert_symbols(Arena         *arena,
             parent_tag.kind == DW_TagKind_InlinedSubroutine ||
             parent_tag.kind == DW_TagKind_LexicalBlock) {
           Rng1U64List ranges = d2r_range_list_from_tag(scratch.arena, input, cu, image_base, tag);
-          d2r_push_scope(arena, &scopes, SCOPE_CHUNK_CAP, it->stack, ranges);
+          d2r_push_scope(arena, &out->scopes, SCOPE_CHUNK_CAP, it->stack, ranges);
         }
       } break;
       case DW_TagKind_CallSite: {
@@ -2570,22 +3608,25 @@ d2r_convert_symbols(Arena         *arena,
 }
 
 internal RDIM_BakeParams
-d2r_convert(Arena *arena, D2R_ConvertParams *params)
+d2r_convert(Arena *arena, D2R_ConvertParams *params, String8List *mapped_views_out)
 {
   Temp scratch = scratch_begin(&arena, 1);
+  
+  ////////////////////////////////
+  
+  RDIM_TopLevelInfo       top_level_info  = {0};
+  RDIM_BinarySectionList  binary_sections = {0};
+  Arch                    arch            = Arch_Null;
+  U64                     arch_addr_size  = 0;
+  U64                     image_base      = 0;
+  DW_Input               *input           = 0;
+  ELF_Bin                *elf_bin         = 0;
   if (lane_idx() == 0) {
-    ////////////////////////////////
-    
     ProfBegin("compute exe hash");
     U64 exe_hash = rdi_hash(params->exe_data.str, params->exe_data.size);
     ProfEnd();
     
-    ////////////////////////////////
-    
-    Arch     arch       = Arch_Null;
-    U64      image_base = 0;
-    DW_Input input      = {0};
-    
+    input = push_array(scratch.arena, DW_Input, 1);
     switch(params->exe_kind) {
       default:{}break;
       case ExecutableImageKind_CoffPe: {
@@ -2596,97 +3637,226 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
         arch            = pe.arch;
         image_base      = pe.image_base;
         binary_sections = c2r_rdi_binary_sections_from_coff_sections(arena, params->exe_data, string_table, pe.section_count, section_table);
-        input           = dw_input_from_coff_section_table(scratch.arena, params->exe_data, string_table, pe.section_count, section_table);
+        *input          = dw_input_from_coff_section_table(scratch.arena, params->exe_data, string_table, pe.section_count, section_table);
       } break;
       case ExecutableImageKind_Elf32:
       case ExecutableImageKind_Elf64: {
-        ELF_Bin bin = elf_bin_from_data(scratch.arena, params->dbg_data);
-        arch            = arch_from_elf_machine(bin.hdr.e_machine);
-        image_base      = elf_base_addr_from_bin(&bin);
-        binary_sections = e2r_rdi_binary_sections_from_elf_section_table(arena, bin.shdrs);
-        input           = dw_input_from_elf_bin(scratch.arena, params->dbg_data, &bin);
+        elf_bin         = push_array(scratch.arena, ELF_Bin, 1);
+        *elf_bin        = elf_bin_from_data(scratch.arena, params->dbg_data);
+        arch            = arch_from_elf_machine(elf_bin->hdr.e_machine);
+        image_base      = elf_base_addr_from_bin(elf_bin);
+        binary_sections = e2r_rdi_binary_sections_from_elf_section_table(arena, elf_bin->shdrs);
       } break;
     }
     
-    ////////////////////////////////
-    
     top_level_info = rdim_make_top_level_info(params->exe_name, arch, exe_hash, binary_sections);
-    
-    ////////////////////////////////
-    
-    U64 arch_addr_size = rdi_addr_size_from_arch(top_level_info.arch);
-    
-    ////////////////////////////////
-    
-    RDIM_Scope *global_scope = rdim_scope_chunk_list_push(arena, &scopes, SCOPE_CHUNK_CAP);
-    
-    ////////////////////////////////
-    
+    arch_addr_size = rdi_addr_size_from_arch(top_level_info.arch);
+  }
+  lane_sync_u64(&arch, 0);
+  lane_sync_u64(&arch_addr_size, 0);
+  lane_sync_u64(&image_base, 0);
+  lane_sync_u64(&input, 0);
+  lane_sync_u64(&elf_bin, 0);
+  
+  // debug sections may be compressed - decompress them across all lanes, into
+  // the output arena, since converted strings point into section data
+  if (elf_bin) {
+    ProfBegin("Load ELF Debug Sections");
+    DW_Input elf_input = dw_input_from_elf_bin(arena, params->dbg_data, elf_bin);
+    if (lane_idx() == 0) {
+      *input = elf_input;
+    }
+    lane_sync();
+    ProfEnd();
+  }
+  
+  ////////////////////////////////
+  
+  D2R_CompUnitContribMap *cu_contrib_map = 0;
+  DW_ListUnitInput       *lu_input       = 0;
+  Rng1U64Array           *cu_ranges      = 0;
+  if (lane_idx() == 0) {
     ProfBegin("Parse Unit Contrib Map");
-    D2R_CompUnitContribMap cu_contrib_map = {0};
-    if (input.sec[DW_Section_ARanges].data.size) {
-      cu_contrib_map = d2r_cu_contrib_map_from_aranges(arena, &input, image_base);
+    cu_contrib_map = push_array(scratch.arena, D2R_CompUnitContribMap, 1);
+    if (input->sec[DW_Section_ARanges].data.size) {
+      *cu_contrib_map = d2r_cu_contrib_map_from_aranges(arena, input, image_base);
     }
     ProfEnd();
     
     ProfBegin("Parse Comop Unit Ranges");
-    DW_ListUnitInput lu_input      = dw_list_unit_input_from_input(scratch.arena, &input);
-    Rng1U64List      cu_range_list = dw_unit_ranges_from_data(scratch.arena, input.sec[DW_Section_Info].data);
-    Rng1U64Array     cu_ranges     = rng1u64_array_from_list(scratch.arena, &cu_range_list);
+    lu_input  = push_array(scratch.arena, DW_ListUnitInput, 1);
+    cu_ranges = push_array(scratch.arena, Rng1U64Array, 1);
+    Rng1U64List cu_range_list = dw_unit_ranges_from_data(scratch.arena, input->sec[DW_Section_Info].data);
+    *lu_input  = dw_list_unit_input_from_input(scratch.arena, input);
+    *cu_ranges = rng1u64_array_from_list(scratch.arena, &cu_range_list);
     ProfEnd();
-    
-    ////////////////////////////////
-    
-    ProfBegin("Parse Compile Unit Headers");
-    // TODO(rjf): parse should always be relaxed. any verification checks we do
-    // should just be logged via log_info(...), and then the caller of this
-    // converter can collect those & display as necessary.
-    B32 is_parse_relaxed = 1;
-    DW_CompUnit *cu_arr = push_array(scratch.arena, DW_CompUnit, cu_ranges.count);
-    for EachIndex(cu_idx, cu_ranges.count) {
-      cu_arr[cu_idx] = dw_cu_from_info_off(scratch.arena, &input, lu_input, cu_ranges.v[cu_idx].min, is_parse_relaxed);
+  }
+  lane_sync_u64(&cu_contrib_map, 0);
+  lane_sync_u64(&lu_input, 0);
+  lane_sync_u64(&cu_ranges, 0);
+  U64 cu_count = cu_ranges->count;
+  
+  ////////////////////////////////
+  
+  DW_CompUnit              *cu_arr           = 0;
+  DW_LineTableParseResult  *cu_line_tables   = 0;
+  String8Array             *cu_file_paths    = 0;
+  RDIM_SrcFile           ***cu_src_file_maps = 0;
+  D2R_CompUnitOutput       *cu_outputs       = 0;
+  if (lane_idx() == 0) {
+    cu_arr           = push_array(scratch.arena, DW_CompUnit,             cu_count);
+    cu_line_tables   = push_array(scratch.arena, DW_LineTableParseResult, cu_count);
+    cu_file_paths    = push_array(scratch.arena, String8Array,            cu_count);
+    cu_src_file_maps = push_array(scratch.arena, RDIM_SrcFile **,         cu_count);
+    cu_outputs       = push_array(scratch.arena, D2R_CompUnitOutput,      cu_count);
+  }
+  lane_sync_u64(&cu_arr, 0);
+  lane_sync_u64(&cu_line_tables, 0);
+  lane_sync_u64(&cu_file_paths, 0);
+  lane_sync_u64(&cu_src_file_maps, 0);
+  lane_sync_u64(&cu_outputs, 0);
+  
+  ////////////////////////////////
+  
+  ProfBegin("Parse Compile Unit Headers & Line Tables");
+  {
+    U64  cu_take_counter     = 0;
+    U64 *cu_take_counter_ptr = &cu_take_counter;
+    lane_sync_u64(&cu_take_counter_ptr, 0);
+    for (;;) {
+      U64 cu_idx = ins_atomic_u64_inc_eval(cu_take_counter_ptr) - 1;
+      if (cu_idx >= cu_count) { break; }
+      
+      // TODO(rjf): parse should always be relaxed. any verification checks we do
+      // should just be logged via log_info(...), and then the caller of this
+      // converter can collect those & display as necessary.
+      B32 is_parse_relaxed = 1;
+      DW_CompUnit *cu = &cu_arr[cu_idx];
+      *cu = dw_cu_from_info_off(scratch.arena, input, *lu_input, cu_ranges->v[cu_idx].min, is_parse_relaxed);
+      
+      // parse line table
+      String8 cu_stmt_list = dw_line_ptr_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_StmtList);
+      String8 cu_dir       = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_CompDir);
+      String8 cu_name      = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_Name);
+      cu_line_tables[cu_idx] = dw_parsed_line_table_from_data(scratch.arena, cu_stmt_list, input, cu_dir, cu_name, cu->address_size, cu->str_offsets_lu);
+      
+      // resolve file paths, source files are deduplicated later in unit order
+      DW_LineTableParseResult *line_table = &cu_line_tables[cu_idx];
+      DW_LineVMFileArray      *file_table = &line_table->vm_header.file_table;
+      String8Array             file_paths = { .count = file_table->count, .v = push_array(scratch.arena, String8, file_table->count) };
+      for EachIndex(file_idx, file_table->count) {
+        String8     file_path       = dw_path_from_file_idx(scratch.arena, &line_table->vm_header, file_idx);
+        String8List file_path_split = str8_split_path(scratch.arena, file_path);
+        str8_path_list_resolve_dots_in_place(&file_path_split, PathStyle_WindowsAbsolute);
+        file_paths.v[file_idx] = str8_path_list_join_by_style(scratch.arena, &file_path_split, PathStyle_WindowsAbsolute);
+      }
+      cu_file_paths[cu_idx] = file_paths;
     }
-    ProfEnd();
-    
-    ////////////////////////////////
-    
-    ProfBegin("Parse Line Tables");
-    DW_LineTableParseResult *cu_line_tables = push_array(scratch.arena, DW_LineTableParseResult, cu_ranges.count);
-    for EachIndex(cu_idx, cu_ranges.count) {
-      DW_CompUnit *cu           = &cu_arr[cu_idx];
-      String8      cu_stmt_list = dw_line_ptr_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_StmtList);
-      String8      cu_dir       = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_CompDir);
-      String8      cu_name      = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Name);
-      cu_line_tables[cu_idx] = dw_parsed_line_table_from_data(scratch.arena, cu_stmt_list, &input, cu_dir, cu_name, cu->address_size, cu->str_offsets_lu);
+  }
+  lane_sync();
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  D2R_DwarfPackage *dwarf_package = 0;
+  D2R_SplitUnit    *cu_splits     = 0;
+  if (lane_idx() == 0) {
+    ProfBegin("Load DWARF Package");
+    cu_splits = push_array(scratch.arena, D2R_SplitUnit, cu_count);
+    String8 package_path_candidates[] = {
+      push_str8f(scratch.arena, "%S.dwp", params->dbg_name),
+      push_str8f(scratch.arena, "%S.dwp", params->exe_name),
+    };
+    for EachElement(candidate_idx, package_path_candidates) {
+      dwarf_package = d2r_dwarf_package_from_path(arena, package_path_candidates[candidate_idx]);
+      if (dwarf_package) { break; }
     }
     ProfEnd();
+  }
+  lane_sync_u64(&dwarf_package, 0);
+  lane_sync_u64(&cu_splits, 0);
+  
+  // split inputs go to the output arena, like the main input - converted
+  // strings point into their section data until baking
+  ProfBegin("Load Split Units");
+  {
+    String8 exe_dir = str8_chop_last_slash(params->exe_name);
     
-    ////////////////////////////////
-    
-    ProfBegin("Convert Line Tables");
-    HashTable       *source_file_ht     = hash_table_init(scratch.arena, 0x4000);
-    RDIM_LineTable **cu_line_tables_rdi = push_array(scratch.arena, RDIM_LineTable *, cu_ranges.count);
-    for EachIndex(cu_idx, cu_ranges.count) {
-      cu_line_tables_rdi[cu_idx] = rdim_line_table_chunk_list_push(arena, &line_tables, LINE_TABLE_CAP);
+    U64  cu_take_counter     = 0;
+    U64 *cu_take_counter_ptr = &cu_take_counter;
+    lane_sync_u64(&cu_take_counter_ptr, 0);
+    for (;;) {
+      U64 cu_idx = ins_atomic_u64_inc_eval(cu_take_counter_ptr) - 1;
+      if (cu_idx >= cu_count) { break; }
       
-      DW_LineTableParseResult *line_table   = &cu_line_tables[cu_idx];
-      DW_LineVMFileArray      *dir_table    = &line_table->vm_header.dir_table;
-      DW_LineVMFileArray      *file_table   = &line_table->vm_header.file_table;
-      RDIM_SrcFile           **src_file_map = push_array(scratch.arena, RDIM_SrcFile *, file_table->count);
-      for EachIndex(file_idx, file_table->count) {
-        DW_LineFile  *file                 = &file_table->v[file_idx];
-        String8       file_path            = dw_path_from_file_idx(scratch.arena, &line_table->vm_header, file_idx);
-        String8List   file_path_split      = str8_split_path(scratch.arena, file_path);
-        str8_path_list_resolve_dots_in_place(&file_path_split, PathStyle_WindowsAbsolute);
-        String8       file_path_resolved   = str8_path_list_join_by_style(scratch.arena, &file_path_split, PathStyle_WindowsAbsolute);
-        RDIM_SrcFile *src_file             = hash_table_search_path_raw(source_file_ht, file_path_resolved);
+      DW_CompUnit *cu = &cu_arr[cu_idx];
+      if (d2r_is_skeleton_cu(input, cu)) {
+        cu_splits[cu_idx] = d2r_split_unit_from_skeleton(arena, dwarf_package, exe_dir, input, cu);
+      }
+    }
+  }
+  lane_sync();
+  if (lane_idx() == 0) {
+    for EachIndex(cu_idx, cu_count) {
+      DW_CompUnit *cu = &cu_arr[cu_idx];
+      if (cu_splits[cu_idx].input == 0 && d2r_is_skeleton_cu(input, cu)) {
+        String8 dwo_name = d2r_dwo_name_from_skeleton_cu(input, cu);
+        log_user_errorf("Unable to find split DWARF unit %S (DWO id %#llx); only line info is converted for it.\n", dwo_name, cu->dwo_id);
+      }
+    }
+  }
+  if (lane_idx() == 0 && mapped_views_out) {
+    if (dwarf_package) {
+      str8_list_push(arena, mapped_views_out, dwarf_package->data);
+    }
+    for EachIndex(cu_idx, cu_count) {
+      if (cu_splits[cu_idx].dwo_data.size) {
+        str8_list_push(arena, mapped_views_out, cu_splits[cu_idx].dwo_data);
+      }
+    }
+  }
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  RDIM_SrcFileChunkList *src_files = 0;
+  if (lane_idx() == 0) {
+    ProfBegin("Build Source File Map");
+    src_files = push_array(scratch.arena, RDIM_SrcFileChunkList, 1);
+    HashTable *source_file_ht = hash_table_init(scratch.arena, 0x4000);
+    for EachIndex(cu_idx, cu_count) {
+      String8Array   file_paths   = cu_file_paths[cu_idx];
+      RDIM_SrcFile **src_file_map = push_array(scratch.arena, RDIM_SrcFile *, file_paths.count);
+      for EachIndex(file_idx, file_paths.count) {
+        RDIM_SrcFile *src_file = hash_table_search_path_raw(source_file_ht, file_paths.v[file_idx]);
         if (src_file == 0) {
-          src_file       = rdim_src_file_chunk_list_push(arena, &src_files, SRC_FILE_CAP);
-          src_file->path = push_str8_copy(arena, file_path_resolved);
+          src_file       = rdim_src_file_chunk_list_push(arena, src_files, SRC_FILE_CAP);
+          src_file->path = push_str8_copy(arena, file_paths.v[file_idx]);
           hash_table_push_path_raw(scratch.arena, source_file_ht, src_file->path, src_file);
         }
         src_file_map[file_idx] = src_file;
       }
+      cu_src_file_maps[cu_idx] = src_file_map;
+    }
+    ProfEnd();
+  }
+  lane_sync_u64(&src_files, 0);
+  
+  ////////////////////////////////
+  
+  ProfBegin("Convert Line Tables");
+  {
+    U64  cu_take_counter     = 0;
+    U64 *cu_take_counter_ptr = &cu_take_counter;
+    lane_sync_u64(&cu_take_counter_ptr, 0);
+    for (;;) {
+      U64 cu_idx = ins_atomic_u64_inc_eval(cu_take_counter_ptr) - 1;
+      if (cu_idx >= cu_count) { break; }
+      
+      RDIM_LineTableChunkList  *line_tables   = &cu_outputs[cu_idx].line_tables;
+      RDIM_LineTable           *line_table_rdi = rdim_line_table_chunk_list_push(arena, line_tables, LINE_TABLE_CAP);
+      DW_LineTableParseResult  *line_table    = &cu_line_tables[cu_idx];
+      RDIM_SrcFile            **src_file_map  = cu_src_file_maps[cu_idx];
       
       for EachNode(line_seq, DW_LineSeqNode, line_table->first_seq) {
         if (line_seq->count == 0) { continue; }
@@ -2723,9 +3893,8 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
               }
             }
             
-            RDIM_SrcFile      *src_file = src_file_map[file_index];
-            RDIM_LineSequence *line_seq = rdim_line_table_push_sequence(arena, &line_tables, cu_line_tables_rdi[cu_idx], src_file, file_voffs, file_line_nums, file_col_nums, lines_written);
-            rdim_src_file_push_line_sequence(arena, &src_files, src_file, line_seq);
+            RDIM_SrcFile *src_file = src_file_map[file_index];
+            rdim_line_table_push_sequence(arena, line_tables, line_table_rdi, src_file, file_voffs, file_line_nums, file_col_nums, lines_written);
             
             file_line_count = 1;
           } else {
@@ -2747,21 +3916,32 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
             line_nums[line_idx] = file_line_n->v.line;
           }
           
-          RDIM_SrcFile      *src_file = src_file_map[file_index];
-          RDIM_LineSequence *line_seq = rdim_line_table_push_sequence(arena, &line_tables, cu_line_tables_rdi[cu_idx], src_file, file_voffs, file_line_nums, file_col_nums, file_line_count);
-          rdim_src_file_push_line_sequence(arena, &src_files, src_file, line_seq);
+          RDIM_SrcFile *src_file = src_file_map[file_index];
+          rdim_line_table_push_sequence(arena, line_tables, line_table_rdi, src_file, file_voffs, file_line_nums, file_col_nums, file_line_count);
         }
         
         //Assert(line_idx == line_seq->count);
       }
     }
-    ProfEnd();
+  }
+  lane_sync();
+  ProfEnd();
+  
+  //////////////////////////////// 
+  
+  RDIM_TypeChunkList  *types         = 0;
+  RDIM_ScopeChunkList *scopes        = 0;
+  RDIM_Scope          *global_scope  = 0;
+  RDIM_Type          **builtin_types = 0;
+  if (lane_idx() == 0) {
+    types         = push_array(scratch.arena, RDIM_TypeChunkList, 1);
+    scopes        = push_array(scratch.arena, RDIM_ScopeChunkList, 1);
+    builtin_types = push_array(scratch.arena, RDIM_Type *, RDI_TypeKind_Count);
     
-    //////////////////////////////// 
+    global_scope = rdim_scope_chunk_list_push(arena, scopes, SCOPE_CHUNK_CAP);
     
-    RDIM_Type *builtin_types[RDI_TypeKind_Count] = {0};
     for (RDI_TypeKind type_kind = RDI_TypeKind_FirstBuiltIn; type_kind <= RDI_TypeKind_LastBuiltIn; type_kind += 1) {
-      RDIM_Type *type = rdim_type_chunk_list_push(arena, &types, TYPE_CHUNK_CAP);
+      RDIM_Type *type = rdim_type_chunk_list_push(arena, types, TYPE_CHUNK_CAP);
       type->kind      = type_kind;
       type->name.str  = rdi_string_from_type_kind(type_kind, &type->name.size);
       type->byte_size = rdi_size_from_basic_type_kind(type_kind);
@@ -2770,57 +3950,89 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
     builtin_types[RDI_TypeKind_Void]->byte_size = arch_addr_size;
     builtin_types[RDI_TypeKind_Handle]->byte_size = arch_addr_size;
     
-    builtin_types[RDI_TypeKind_Variadic] = rdim_type_chunk_list_push(arena, &types, TYPE_CHUNK_CAP);
+    builtin_types[RDI_TypeKind_Variadic] = rdim_type_chunk_list_push(arena, types, TYPE_CHUNK_CAP);
     builtin_types[RDI_TypeKind_Variadic]->kind = RDI_TypeKind_Variadic;
-    
-    //////////////////////////////// 
-    
-    ProfBegin("Convert Units");
-    for EachIndex(cu_idx, cu_ranges.count) {
+  }
+  lane_sync_u64(&types, 0);
+  lane_sync_u64(&scopes, 0);
+  lane_sync_u64(&global_scope, 0);
+  lane_sync_u64(&builtin_types, 0);
+  
+  // sized on the unit count, the number of distinct types is not known until
+  // the units are converted
+  D2R_TypeHashTable *type_hash_table = 0;
+  if (lane_idx() == 0) {
+    type_hash_table               = push_array(scratch.arena, D2R_TypeHashTable, 1);
+    type_hash_table->bucket_count = u64_up_to_pow2(Max(0x10000, cu_count * 0x100));
+    type_hash_table->buckets      = push_array(scratch.arena, D2R_TypeHashNode *, type_hash_table->bucket_count);
+  }
+  lane_sync_u64(&type_hash_table, 0);
+  
+  //////////////////////////////// 
+  
+  ProfBegin("Convert Units");
+  {
+    U64  cu_take_counter     = 0;
+    U64 *cu_take_counter_ptr = &cu_take_counter;
+    lane_sync_u64(&cu_take_counter_ptr, 0);
+    for (;;) {
+      U64 cu_idx = ins_atomic_u64_inc_eval(cu_take_counter_ptr) - 1;
+      if (cu_idx >= cu_count) { break; }
+      
       Temp comp_temp = temp_begin(scratch.arena);
       
-      DW_CompUnit *cu = &cu_arr[cu_idx];
+      DW_CompUnit        *cu  = &cu_arr[cu_idx];
+      D2R_CompUnitOutput *out = &cu_outputs[cu_idx];
       
-      // parse and build tag tree
-      DW_TagTree tag_tree = dw_tag_tree_from_cu(comp_temp.arena, &input, cu);
-      
-      // skip DWO
-      {
-        if (cu->dwo_id) { goto next_cu; }
-        
-        String8 dwo_name = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_DwoName);
-        if (dwo_name.size) { goto next_cu; }
-        
-        String8 gnu_dwo_name = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_GNU_DwoName);
-        if (gnu_dwo_name.size) { goto next_cu; }
+      // skeleton units only carry ranges and line info, the rest is converted
+      // from the split unit they resolved to
+      DW_Input    *unit_input = input;
+      DW_CompUnit *unit_cu    = cu;
+      if (d2r_is_skeleton_cu(input, cu)) {
+        D2R_SplitUnit *split = &cu_splits[cu_idx];
+        if (split->input == 0) { goto next_cu; }
+        unit_input = split->input;
+        unit_cu    = &split->cu;
       }
       
+      // parse and build tag tree
+      DW_TagTree tag_tree = dw_tag_tree_from_cu(comp_temp.arena, unit_input, unit_cu);
+      
       // build (info offset -> tag) hash table to resolve tags with abstract origin
-      cu->tag_ht = dw_make_tag_hash_table(comp_temp.arena, tag_tree);
+      unit_cu->tag_ht = dw_make_tag_hash_table(comp_temp.arena, tag_tree);
       
       // extract compile unit info
-      String8     cu_name = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Name);
-      String8     cu_dir  = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_CompDir);
-      String8     cu_prod = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Producer);
-      DW_Language cu_lang = dw_const_u64_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Language);
+      String8     cu_name = dw_string_from_tag_attrib_kind(unit_input, unit_cu, unit_cu->tag, DW_AttribKind_Name);
+      String8     cu_dir  = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_CompDir);
+      String8     cu_prod = dw_string_from_tag_attrib_kind(unit_input, unit_cu, unit_cu->tag, DW_AttribKind_Producer);
+      DW_Language cu_lang = dw_const_u64_from_tag_attrib_kind(unit_input, unit_cu, unit_cu->tag, DW_AttribKind_Language);
+      if (cu_name.size == 0) {
+        cu_name = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_Name);
+      }
       
-      // init type table
+      // init type table, the unit's types live only as long as the unit
       D2R_TypeTable *type_table   = push_array(comp_temp.arena, D2R_TypeTable, 1);
+      type_table->arena           = comp_temp.arena;
       type_table->ht              = hash_table_init(comp_temp.arena, 0x4000);
-      type_table->types           = &types;
+      type_table->types           = push_array(comp_temp.arena, RDIM_TypeChunkList, 1);
       type_table->type_chunk_cap  = TYPE_CHUNK_CAP;
+      type_table->udts            = push_array(comp_temp.arena, RDIM_UDTChunkList, 1);
+      type_table->udt_chunk_cap   = UDT_CHUNK_CAP;
       type_table->builtin_types   = builtin_types;
       
       // convert debug info
-      d2r_convert_types(arena, type_table, &input, cu, cu_lang, arch_addr_size, tag_tree.root);
-      d2r_convert_udts(arena, type_table, &input, cu, cu_lang, arch_addr_size, tag_tree.root);
-      d2r_convert_symbols(arena, type_table, global_scope, &input, cu, cu_lang, arch_addr_size, image_base, arch, tag_tree.root);
+      d2r_convert_types(type_table->arena, type_table, unit_input, unit_cu, cu_lang, arch_addr_size, tag_tree.root);
+      d2r_convert_udts(type_table->arena, type_table, unit_input, unit_cu, cu_lang, arch_addr_size, tag_tree.root);
+      d2r_convert_symbols(arena, type_table, out, global_scope, unit_input, unit_cu, cu_lang, arch_addr_size, image_base, arch, tag_tree.root);
+      
+      // keep only the types no other unit has kept
+      d2r_canonicalize_unit_types(arena, type_hash_table, cu_idx + 1, type_table->types, out);
       
       RDIM_Rng1U64ChunkList cu_voff_ranges = {0};
-      if (cu_idx < cu_contrib_map.count) {
-        cu_voff_ranges = d2r_voff_ranges_from_cu_info_off(cu_contrib_map, cu_ranges.v[cu_idx].min);
+      if (cu_idx < cu_contrib_map->count) {
+        cu_voff_ranges = d2r_voff_ranges_from_cu_info_off(*cu_contrib_map, cu_ranges->v[cu_idx].min);
       } else {
-        Rng1U64List range_list  = d2r_range_list_from_tag(scratch.arena, &input, cu, image_base, cu->tag);
+        Rng1U64List range_list  = d2r_range_list_from_tag(comp_temp.arena, input, cu, image_base, cu->tag);
         for EachNode(n, Rng1U64Node, range_list.first) {
           rdim_rng1u64_chunk_list_push(arena, &cu_voff_ranges, 512, (RDIM_Rng1U64){ .min = n->v.min, .max = n->v.max });
         }
@@ -2828,7 +4040,7 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
       
       // convert compile unit
       {
-        RDIM_Unit *unit     = rdim_unit_chunk_list_push(arena, &units, UNIT_CHUNK_CAP);
+        RDIM_Unit *unit     = rdim_unit_chunk_list_push(arena, &out->units, UNIT_CHUNK_CAP);
         unit->unit_name     = cu_name;
         unit->compiler_name = cu_prod;
         unit->source_file   = str8_zero(); // TODO
@@ -2836,34 +4048,112 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
         unit->archive_file  = str8_zero(); // TODO
         unit->build_path    = cu_dir;
         unit->language      = d2r_rdi_language_from_dw_language(cu_lang);
-        unit->line_table    = cu_line_tables_rdi[cu_idx];
+        unit->line_table    = out->line_tables.first->v;
         unit->voff_ranges   = cu_voff_ranges;
       }
       
       next_cu:;
       temp_end(comp_temp);
     }
-    ProfEnd();
   }
+  lane_sync();
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  // order keys of the joined types: built-in types come first, then the types
+  // units kept, in unit order
+  U64 *type_order_keys = 0;
+  if (lane_idx() == 0) {
+    U64 type_count = types->total_count;
+    for EachIndex(cu_idx, cu_count) { type_count += cu_outputs[cu_idx].types.total_count; }
+    type_order_keys = push_array_no_zero(scratch.arena, U64, type_count + 1);
+    type_order_keys[0] = 0;
+    U64 type_idx = 1;
+    for EachIndex(i, types->total_count) {
+      type_order_keys[type_idx] = type_idx;
+      type_idx += 1;
+    }
+    for EachIndex(cu_idx, cu_count) {
+      for EachIndex(i, cu_outputs[cu_idx].types.total_count) {
+        type_order_keys[type_idx] = *cu_outputs[cu_idx].type_order_keys[i];
+        type_idx += 1;
+      }
+    }
+  }
+  lane_sync_u64(&type_order_keys, 0);
+  
+  RDIM_BakeParams *bake_params = 0;
+  if (lane_idx() == 0) {
+    bake_params = push_array(scratch.arena, RDIM_BakeParams, 1);
+    bake_params->subset_flags    = params->subset_flags;
+    bake_params->top_level_info  = top_level_info;
+    bake_params->binary_sections = binary_sections;
+    bake_params->types           = *types;
+    bake_params->scopes          = *scopes;
+  }
+  lane_sync_u64(&bake_params, 0);
   
+  ProfBegin("Join Unit Outputs");
+  if (lane_idx() == lane_from_task_idx(0)) {
+    for EachIndex(cu_idx, cu_count) { rdim_unit_chunk_list_concat_in_place(&bake_params->units, &cu_outputs[cu_idx].units); }
+  }
+  if (lane_idx() == lane_from_task_idx(1)) {
+    for EachIndex(cu_idx, cu_count) { rdim_line_table_chunk_list_concat_in_place(&bake_params->line_tables, &cu_outputs[cu_idx].line_tables); }
+  }
+  if (lane_idx() == lane_from_task_idx(2)) {
+    for EachIndex(cu_idx, cu_count) { rdim_type_chunk_list_concat_in_place(&bake_params->types, &cu_outputs[cu_idx].types); }
+  }
+  if (lane_idx() == lane_from_task_idx(3)) {
+    for EachIndex(cu_idx, cu_count) { rdim_udt_chunk_list_concat_in_place(&bake_params->udts, &cu_outputs[cu_idx].udts); }
+  }
+  if (lane_idx() == lane_from_task_idx(4)) {
+    for EachIndex(cu_idx, cu_count) { rdim_location_chunk_list_concat_in_place(&bake_params->locations, &cu_outputs[cu_idx].locations); }
+  }
+  if (lane_idx() == lane_from_task_idx(5)) {
+    for EachIndex(cu_idx, cu_count) { rdim_symbol_chunk_list_concat_in_place(&bake_params->global_variables, &cu_outputs[cu_idx].gvars); }
+  }
+  if (lane_idx() == lane_from_task_idx(6)) {
+    for EachIndex(cu_idx, cu_count) { rdim_symbol_chunk_list_concat_in_place(&bake_params->thread_variables, &cu_outputs[cu_idx].tvars); }
+  }
+  if (lane_idx() == lane_from_task_idx(7)) {
+    for EachIndex(cu_idx, cu_count) { rdim_symbol_chunk_list_concat_in_place(&bake_params->procedures, &cu_outputs[cu_idx].procs); }
+  }
+  if (lane_idx() == lane_from_task_idx(8)) {
+    for EachIndex(cu_idx, cu_count) { rdim_scope_chunk_list_concat_in_place(&bake_params->scopes, &cu_outputs[cu_idx].scopes); }
+  }
+  if (lane_idx() == lane_from_task_idx(9)) {
+    for EachIndex(cu_idx, cu_count) { rdim_inline_site_chunk_list_concat_in_place(&bake_params->inline_sites, &cu_outputs[cu_idx].inline_sites); }
+  }
+  lane_sync();
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  ProfBegin("Deduplicate Types");
+  d2r_dedup_types(arena, bake_params, type_order_keys);
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  if (lane_idx() == 0) {
+    ProfBegin("Equip Source Files With Line Sequences");
+    for EachNode(line_table_chunk_n, RDIM_LineTableChunkNode, bake_params->line_tables.first) {
+      for EachIndex(chunk_line_table_idx, line_table_chunk_n->count) {
+        RDIM_LineTable *line_table = &line_table_chunk_n->v[chunk_line_table_idx];
+        for EachNode(seq_n, RDIM_LineSequenceNode, line_table->first_seq) {
+          rdim_src_file_push_line_sequence(arena, src_files, seq_n->v.src_file, &seq_n->v);
+        }
+      }
+    }
+    bake_params->src_files = *src_files;
+    ProfEnd();
+  }
   lane_sync();
   
-  RDIM_BakeParams bake_params  = {0};
-  bake_params.subset_flags     = params->subset_flags;
-  bake_params.top_level_info   = top_level_info;
-  bake_params.binary_sections  = binary_sections;
-  bake_params.units            = units;
-  bake_params.types            = types;
-  bake_params.udts             = udts;
-  bake_params.src_files        = src_files;
-  bake_params.line_tables      = line_tables;
-  bake_params.locations        = locations;
-  bake_params.global_variables = gvars;
-  bake_params.thread_variables = tvars;
-  bake_params.procedures       = procs;
-  bake_params.scopes           = scopes;
-  bake_params.inline_sites     = inline_sites;
+  RDIM_BakeParams result = *bake_params;
+  lane_sync();
   
   scratch_end(scratch);
-  return bake_params;
+  return result;
 }
@@ -15,14 +15,36 @@ struct D2R_ConvertParams
   B32                 deterministic;
 };
 
+// types of the unit being converted, they are allocated on the unit's own
+// arena and only the canonical ones are copied out once the unit is done
 typedef struct D2R_TypeTable
 {
+  Arena               *arena;
   HashTable           *ht;
   RDIM_TypeChunkList  *types;
   U64                  type_chunk_cap;
+  RDIM_UDTChunkList   *udts;
+  U64                  udt_chunk_cap;
   RDIM_Type          **builtin_types;
 } D2R_TypeTable;
 
+// per-unit conversion outputs; units are converted wide and then joined in
+// compile unit order, so baked RDI does not depend on the lane count
+typedef struct D2R_CompUnitOutput
+{
+  RDIM_UnitChunkList       units;
+  RDIM_LineTableChunkList  line_tables;
+  RDIM_TypeChunkList       types;
+  RDIM_UDTChunkList        udts;
+  RDIM_LocationChunkList   locations;
+  RDIM_SymbolChunkList     gvars;
+  RDIM_SymbolChunkList     tvars;
+  RDIM_SymbolChunkList     procs;
+  RDIM_ScopeChunkList      scopes;
+  RDIM_InlineSiteChunkList inline_sites;
+  U64                    **type_order_keys;
+} D2R_CompUnitOutput;
+
 typedef struct D2R_TagFrame
 {
   DW_TagNode *node;
@@ -45,6 +67,64 @@ typedef struct D2R_CompUnitContribMap
   RDIM_Rng1U64ChunkList *voff_range_arr;
 } D2R_CompUnitContribMap;
 
+// split DWARF package (.dwp) with its compile unit index
+typedef struct D2R_DwarfPackage
+{
+  String8      data;
+  DW_Input     input;
+  DW_UnitIndex cu_index;
+} D2R_DwarfPackage;
+
+// split compile unit that a skeleton unit resolved to, input is zero when
+// neither a package nor a .dwo file had a unit with matching id; dwo_data is
+// the mapped .dwo file, zero when the unit came from the package
+typedef struct D2R_SplitUnit
+{
+  DW_Input    *input;
+  DW_CompUnit  cu;
+  String8      dwo_data;
+} D2R_SplitUnit;
+
+// type deduplication state, runs once per unit on the unit's own types and
+// once more on the joined unit outputs; types are indexed by their RDIM type
+// index in the list being deduplicated
+typedef struct D2R_TypeDedup
+{
+  U64                 type_count;
+  RDIM_Type         **types;
+  U128               *signatures;
+  U64                *classes;
+  U64                *next_classes;
+  U64                 class_count;
+  U64                 slot_count;
+  U64                *slots;
+  RDIM_Type         **canonical_types;
+  U64                *order_keys;
+  U64                *sources;
+  RDIM_TypeChunkNode *new_types;
+  U64                 udt_count;
+  RDIM_UDT          **udts;
+  U64                *udt_remap;
+  RDIM_UDTChunkNode  *new_udts;
+} D2R_TypeDedup;
+
+// types that units kept, keyed on a structural hash that is stable across
+// units; order key is the smallest (unit, position) the type was seen at,
+// so the joined output does not depend on which unit got to a type first
+typedef struct D2R_TypeHashNode
+{
+  struct D2R_TypeHashNode *next;
+  U128                     hash;
+  RDIM_Type               *type;
+  U64                      order_key;
+} D2R_TypeHashNode;
+
+typedef struct D2R_TypeHashTable
+{
+  U64                bucket_count;
+  D2R_TypeHashNode **buckets;
+} D2R_TypeHashTable;
+
 #define D2R_ValueType_IsSigned(x)   ((x) == D2R_ValueType_S8 || (x) == D2R_ValueType_S16 || (x) == D2R_ValueType_S32 || (x) == D2R_ValueType_S64 || (x) == D2R_ValueType_S128 || (x) == D2R_ValueType_S256 || (x) == D2R_ValueType_S512)
 #define D2R_ValueType_IsUnsigned(x) ((x) == D2R_ValueType_U8 || (x) == D2R_ValueType_U16 || (x) == D2R_ValueType_U32 || (x) == D2R_ValueType_U64 || (x) == D2R_ValueType_U128 || (x) == D2R_ValueType_U256 || (x) == D2R_ValueType_U512)
 #define D2R_ValueType_IsFloat(x)    ((x) == D2R_ValueType_F32 || (x) == D2R_ValueType_F64)
@@ -99,6 +179,7 @@ internal RDI_RegCode    d2r_rdi_reg_code_from_dw_reg(Arch arch, DW_Reg v);
 //~ rjf: Type Conversion Helpers
 
 internal RDIM_Type *       d2r_create_type(Arena *arena, D2R_TypeTable *type_table);
+internal RDIM_UDT *        d2r_create_udt(Arena *arena, D2R_TypeTable *type_table, RDIM_Type *type);
 internal RDIM_Type *       d2r_create_type_from_offset(Arena *arena, D2R_TypeTable *type_table, U64 info_off);
 internal RDIM_Type *       d2r_type_from_offset(D2R_TypeTable *type_table, U64 info_off);
 internal RDIM_Type *       d2r_type_from_attrib(D2R_TypeTable *type_table, DW_Input *input, DW_CompUnit *cu, DW_Tag tag, DW_AttribKind kind);
@@ -144,6 +225,17 @@ internal RDIM_LocationCaseList d2r_var_locset_from_tag(Arena *arena, RDIM_ScopeC
 internal D2R_CompUnitContribMap d2r_cu_contrib_map_from_aranges(Arena *arena, DW_Input *input, U64 image_base);
 internal RDIM_Rng1U64ChunkList  d2r_voff_ranges_from_cu_info_off(D2R_CompUnitContribMap map, U64 info_off);
 
+////////////////////////////////
+//~ Split DWARF Helpers
+
+internal String8            d2r_dwo_name_from_skeleton_cu(DW_Input *input, DW_CompUnit *cu);
+internal B32                d2r_is_skeleton_cu(DW_Input *input, DW_CompUnit *cu);
+internal String8            d2r_mapped_data_from_file_path(String8 path);
+internal DW_Input           d2r_dw_input_from_elf_data(Arena *arena, String8 data);
+internal D2R_DwarfPackage * d2r_dwarf_package_from_path(Arena *arena, String8 path);
+internal D2R_SplitUnit      d2r_split_unit_from_skeleton(Arena *arena, D2R_DwarfPackage *package, String8 exe_dir, DW_Input *input, DW_CompUnit *skeleton_cu);
+internal void               d2r_unmap_views(String8List views);
+
 ////////////////////////////////
 //~ Tag Iterator
 
@@ -161,9 +253,23 @@ internal B8   d2r_is_tag_converted(DW_TagNode *tag_node);
 
 internal void d2r_convert_types(Arena *arena, D2R_TypeTable *type_table, DW_Input *input, DW_CompUnit *cu, DW_Language cu_lang, U64 arch_addr_size, DW_TagNode *root);
 internal void d2r_convert_udts(Arena *arena, D2R_TypeTable *type_table, DW_Input *input, DW_CompUnit *cu, DW_Language cu_lang, U64 arch_addr_size, DW_TagNode *root);
-internal void d2r_convert_symbols(Arena *arena, D2R_TypeTable *type_table, RDIM_Scope *global_scope, DW_Input *input, DW_CompUnit *cu, DW_Language cu_lang, U64 arch_addr_size, U64 image_base, Arch arch, DW_TagNode *root);
+internal void d2r_convert_symbols(Arena *arena, D2R_TypeTable *type_table, D2R_CompUnitOutput *out, RDIM_Scope *global_scope, DW_Input *input, DW_CompUnit *cu, DW_Language cu_lang, U64 arch_addr_size, U64 image_base, Arch arch, DW_TagNode *root);
+
+////////////////////////////////
+//~ Type Deduplication
+
+internal U64         d2r_type_class_from_type(D2R_TypeDedup *dedup, RDIM_Type *type);
+internal U128        d2r_type_signature_from_type(D2R_TypeDedup *dedup, RDIM_Type *type);
+internal RDIM_Type * d2r_dedup_remap_type(D2R_TypeDedup *dedup, RDIM_Type *type);
+internal void        d2r_dedup_remap_symbols(D2R_TypeDedup *dedup, RDIM_SymbolChunkList *symbols);
+internal void        d2r_dedup_remap_scopes(D2R_TypeDedup *dedup, RDIM_ScopeChunkList *scopes);
+internal void        d2r_dedup_remap_inline_sites(D2R_TypeDedup *dedup, RDIM_InlineSiteChunkList *inline_sites);
+internal D2R_TypeDedup * d2r_type_dedup_alloc(Arena *arena, RDIM_TypeChunkList *types);
+internal void        d2r_refine_type_classes(D2R_TypeDedup *dedup);
+internal void        d2r_canonicalize_unit_types(Arena *arena, D2R_TypeHashTable *type_hash_table, U64 unit_order, RDIM_TypeChunkList *unit_types, D2R_CompUnitOutput *out);
+internal void        d2r_dedup_types(Arena *arena, RDIM_BakeParams *bake_params, U64 *type_order_keys);
 
 ////////////////////////////////
 //~ rjf: Main Conversion Entry Point
 
-internal RDIM_BakeParams d2r_convert(Arena *arena, D2R_ConvertParams *params);
+internal RDIM_BakeParams d2r_convert(Arena *arena, D2R_ConvertParams *params, String8List *mapped_views_out);
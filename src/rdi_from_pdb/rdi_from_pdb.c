@@ -2099,550 +2099,707 @@ p2r_convert(Arena *arena, P2R_ConvertParams *params)
   // subsequent passes, to build RDI "UDT" information, which is distinct
   // from regular type info.
   //
+  // types are built wide, in levels - an itype's level is one more than the
+  // deepest level of anything in its chain, so everything a level references
+  // is finished before that level starts. levels are joined in order, which
+  // keeps rdi's "only reference backward" rule. within a level, each lane
+  // builds a contiguous itype range & lanes are joined in order, so the built
+  // types come out in the same order regardless of the lane count.
+  //
   RDIM_TypeChunkList all_types__pre_typedefs = {0};
   RDIM_TypeChunkList *all_types__pre_typedefs_ptr = &all_types__pre_typedefs;
   RDIM_Type **itype_type_ptrs = 0;
   RDIM_Type **basic_type_ptrs = 0;
-  if(lane_idx() == 0) ProfScope("types pass 3: construct all root/stub types from TPI")
+  ProfScope("types pass 3: construct all root/stub types from TPI")
   {
 #define p2r_builtin_type_ptr_from_kind(kind) ((basic_type_ptrs && RDI_TypeKind_FirstBuiltIn <= (kind) && (kind) <= RDI_TypeKind_LastBuiltIn) ? (basic_type_ptrs[(kind) - RDI_TypeKind_FirstBuiltIn]) : 0)
 #define p2r_type_ptr_from_itype(itype) ((itype_type_ptrs && (itype) < itype_opl) ? (itype_type_ptrs[(itype_fwd_map[(itype)] ? itype_fwd_map[(itype)] : (itype))]) : 0)
-    itype_type_ptrs = push_array(scratch.arena, RDIM_Type *, (U64)(itype_opl));
-    basic_type_ptrs = push_array(scratch.arena, RDIM_Type *, (RDI_TypeKind_LastBuiltIn - RDI_TypeKind_FirstBuiltIn + 1));
     
     ////////////////////////////
-    //- rjf: build basic types
+    //- build basic types, aliases, & basic itypes; set up level tables
     //
-    if(params->subset_flags & RDIM_SubsetFlag_Types)
+    U32 *itype_levels = 0;
+    U32 *lanes_max_levels = 0;
+    U64 **lanes_level_counts = 0;
+    if(lane_idx() == 0) ProfScope("build basic types")
     {
-      for(RDI_TypeKind type_kind = RDI_TypeKind_FirstBuiltIn;
-          type_kind <= RDI_TypeKind_LastBuiltIn;
-          type_kind += 1)
+      itype_type_ptrs = push_array(scratch.arena, RDIM_Type *, (U64)(itype_opl));
+      basic_type_ptrs = push_array(scratch.arena, RDIM_Type *, (RDI_TypeKind_LastBuiltIn - RDI_TypeKind_FirstBuiltIn + 1));
+      itype_levels = push_array(scratch.arena, U32, (U64)(itype_opl));
+      lanes_max_levels = push_array(scratch.arena, U32, lane_count());
+      lanes_level_counts = push_array(scratch.arena, U64 *, lane_count());
+      ////////////////////////////
+      //- rjf: build basic types
+      //
+      if(params->subset_flags & RDIM_SubsetFlag_Types)
       {
-        RDIM_Type *type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, 512);
-        type->name.str  = rdi_string_from_type_kind(type_kind, &type->name.size);
-        type->kind      = type_kind;
-        type->byte_size = rdi_size_from_basic_type_kind(type_kind);
-        basic_type_ptrs[type_kind - RDI_TypeKind_FirstBuiltIn] = type;
+        for(RDI_TypeKind type_kind = RDI_TypeKind_FirstBuiltIn;
+            type_kind <= RDI_TypeKind_LastBuiltIn;
+            type_kind += 1)
+        {
+          RDIM_Type *type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, 512);
+          type->name.str  = rdi_string_from_type_kind(type_kind, &type->name.size);
+          type->kind      = type_kind;
+          type->byte_size = rdi_size_from_basic_type_kind(type_kind);
+          basic_type_ptrs[type_kind - RDI_TypeKind_FirstBuiltIn] = type;
+        }
       }
-    }
-    
-    ////////////////////////////
-    //- rjf: build basic type aliases
-    //
-    if(params->subset_flags & RDIM_SubsetFlag_Types)
-    {
-      RDIM_DataModel data_model = rdim_data_model_from_os_arch(OperatingSystem_Windows, arch);
-      RDI_TypeKind short_type      = rdim_short_type_kind_from_data_model(data_model);
-      RDI_TypeKind ushort_type     = rdim_unsigned_short_type_kind_from_data_model(data_model);
-      RDI_TypeKind long_type       = rdim_long_type_kind_from_data_model(data_model);
-      RDI_TypeKind ulong_type      = rdim_unsigned_long_type_kind_from_data_model(data_model);
-      RDI_TypeKind long_long_type  = rdim_long_long_type_kind_from_data_model(data_model);
-      RDI_TypeKind ulong_long_type = rdim_unsigned_long_long_type_kind_from_data_model(data_model);
-      RDI_TypeKind ptr_type        = rdim_pointer_size_t_type_kind_from_data_model(data_model);
-      struct
+      
+      ////////////////////////////
+      //- rjf: build basic type aliases
+      //
+      if(params->subset_flags & RDIM_SubsetFlag_Types)
       {
-        char *       name;
-        RDI_TypeKind kind_rdi;
-        CV_LeafKind  kind_cv;
+        RDIM_DataModel data_model = rdim_data_model_from_os_arch(OperatingSystem_Windows, arch);
+        RDI_TypeKind short_type      = rdim_short_type_kind_from_data_model(data_model);
+        RDI_TypeKind ushort_type     = rdim_unsigned_short_type_kind_from_data_model(data_model);
+        RDI_TypeKind long_type       = rdim_long_type_kind_from_data_model(data_model);
+        RDI_TypeKind ulong_type      = rdim_unsigned_long_type_kind_from_data_model(data_model);
+        RDI_TypeKind long_long_type  = rdim_long_long_type_kind_from_data_model(data_model);
+        RDI_TypeKind ulong_long_type = rdim_unsigned_long_long_type_kind_from_data_model(data_model);
+        RDI_TypeKind ptr_type        = rdim_pointer_size_t_type_kind_from_data_model(data_model);
+        struct
+        {
+          char *       name;
+          RDI_TypeKind kind_rdi;
+          CV_LeafKind  kind_cv;
+        }
+        table[] =
+        {
+          { "signed char"          , RDI_TypeKind_Char8      , CV_BasicType_CHAR       },
+          { "short"                , short_type              , CV_BasicType_SHORT      },
+          { "long"                 , long_type               , CV_BasicType_LONG       },
+          { "long long"            , long_long_type          , CV_BasicType_QUAD       },
+          { "__int128"             , RDI_TypeKind_S128       , CV_BasicType_OCT        }, // Clang type
+          { "unsigned char"        , RDI_TypeKind_UChar8     , CV_BasicType_UCHAR      },
+          { "unsigned short"       , ushort_type             , CV_BasicType_USHORT     },
+          { "unsigned long"        , ulong_type              , CV_BasicType_ULONG      },
+          { "unsigned long long"   , ulong_long_type         , CV_BasicType_UQUAD      },
+          { "__uint128"            , RDI_TypeKind_U128       , CV_BasicType_UOCT       }, // Clang type
+          { "bool"                 , RDI_TypeKind_S8         , CV_BasicType_BOOL8      },
+          { "__bool16"             , RDI_TypeKind_S16        , CV_BasicType_BOOL16     }, // not real C type
+          { "__bool32"             , RDI_TypeKind_S32        , CV_BasicType_BOOL32     }, // not real C type
+          { "float"                , RDI_TypeKind_F32        , CV_BasicType_FLOAT32    },
+          { "double"               , RDI_TypeKind_F64        , CV_BasicType_FLOAT64    },
+          { "long double"          , RDI_TypeKind_F80        , CV_BasicType_FLOAT80    },
+          { "__float128"           , RDI_TypeKind_F128       , CV_BasicType_FLOAT128   }, // Clang type
+          { "__float48"            , RDI_TypeKind_F48        , CV_BasicType_FLOAT48    }, // not real C type
+          { "__float32pp"          , RDI_TypeKind_F32PP      , CV_BasicType_FLOAT32PP  }, // not real C type
+          { "__float16"            , RDI_TypeKind_F16        , CV_BasicType_FLOAT16    },
+          { "_Complex float"       , RDI_TypeKind_ComplexF32 , CV_BasicType_COMPLEX32  },
+          { "_Complex double"      , RDI_TypeKind_ComplexF64 , CV_BasicType_COMPLEX64  },
+          { "_Complex long double" , RDI_TypeKind_ComplexF80 , CV_BasicType_COMPLEX80  },
+          { "_Complex __float128"  , RDI_TypeKind_ComplexF128, CV_BasicType_COMPLEX128 },
+          { "__int8"               , RDI_TypeKind_S8         , CV_BasicType_INT8       },
+          { "__uint8"              , RDI_TypeKind_U8         , CV_BasicType_UINT8      },
+          { "__int16"              , RDI_TypeKind_S16        , CV_BasicType_INT16      },
+          { "__uint16"             , RDI_TypeKind_U16        , CV_BasicType_UINT16     },
+          { "int"                  , RDI_TypeKind_S32        , CV_BasicType_INT32      },
+          { "int32"                , RDI_TypeKind_S32        , CV_BasicType_INT32      },
+          { "uint32"               , RDI_TypeKind_U32        , CV_BasicType_UINT32     },
+          { "__int64"              , RDI_TypeKind_S64        , CV_BasicType_INT64      },
+          { "__uint64"             , RDI_TypeKind_U64        , CV_BasicType_UINT64     },
+          { "__int128"             , RDI_TypeKind_S128       , CV_BasicType_INT128     },
+          { "__uint128"            , RDI_TypeKind_U128       , CV_BasicType_UINT128    },
+          { "char"                 , RDI_TypeKind_Char8      , CV_BasicType_RCHAR      }, // always ASCII
+          { "wchar_t"              , RDI_TypeKind_UChar16    , CV_BasicType_WCHAR      }, // on windows always UTF-16
+          { "char8_t"              , RDI_TypeKind_Char8      , CV_BasicType_CHAR8      }, // always UTF-8
+          { "char16_t"             , RDI_TypeKind_Char16     , CV_BasicType_CHAR16     }, // always UTF-16
+          { "char32_t"             , RDI_TypeKind_Char32     , CV_BasicType_CHAR32     }, // always UTF-32
+          { "__pointer"            , ptr_type                , CV_BasicType_PTR        }
+        };
+        for EachElement(idx, table)
+        {
+          RDIM_Type *builtin_alias   = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, tpi_leaf->itype_opl);
+          builtin_alias->kind        = RDI_TypeKind_Alias;
+          builtin_alias->name        = str8_cstring(table[idx].name);
+          builtin_alias->direct_type = p2r_builtin_type_ptr_from_kind(table[idx].kind_rdi);
+          builtin_alias->byte_size   = rdi_size_from_basic_type_kind(table[idx].kind_rdi);
+          itype_type_ptrs[table[idx].kind_cv] = builtin_alias;
+        }
+        itype_type_ptrs[CV_BasicType_HRESULT] = basic_type_ptrs[RDI_TypeKind_HResult - RDI_TypeKind_FirstBuiltIn];
+        itype_type_ptrs[CV_BasicType_VOID]    = basic_type_ptrs[RDI_TypeKind_Void - RDI_TypeKind_FirstBuiltIn];
       }
-      table[] =
-      {
-        { "signed char"          , RDI_TypeKind_Char8      , CV_BasicType_CHAR       },
-        { "short"                , short_type              , CV_BasicType_SHORT      },
-        { "long"                 , long_type               , CV_BasicType_LONG       },
-        { "long long"            , long_long_type          , CV_BasicType_QUAD       },
-        { "__int128"             , RDI_TypeKind_S128       , CV_BasicType_OCT        }, // Clang type
-        { "unsigned char"        , RDI_TypeKind_UChar8     , CV_BasicType_UCHAR      },
-        { "unsigned short"       , ushort_type             , CV_BasicType_USHORT     },
-        { "unsigned long"        , ulong_type              , CV_BasicType_ULONG      },
-        { "unsigned long long"   , ulong_long_type         , CV_BasicType_UQUAD      },
-        { "__uint128"            , RDI_TypeKind_U128       , CV_BasicType_UOCT       }, // Clang type
-        { "bool"                 , RDI_TypeKind_S8         , CV_BasicType_BOOL8      },
-        { "__bool16"             , RDI_TypeKind_S16        , CV_BasicType_BOOL16     }, // not real C type
-        { "__bool32"             , RDI_TypeKind_S32        , CV_BasicType_BOOL32     }, // not real C type
-        { "float"                , RDI_TypeKind_F32        , CV_BasicType_FLOAT32    },
-        { "double"               , RDI_TypeKind_F64        , CV_BasicType_FLOAT64    },
-        { "long double"          , RDI_TypeKind_F80        , CV_BasicType_FLOAT80    },
-        { "__float128"           , RDI_TypeKind_F128       , CV_BasicType_FLOAT128   }, // Clang type
-        { "__float48"            , RDI_TypeKind_F48        , CV_BasicType_FLOAT48    }, // not real C type
-        { "__float32pp"          , RDI_TypeKind_F32PP      , CV_BasicType_FLOAT32PP  }, // not real C type
-        { "__float16"            , RDI_TypeKind_F16        , CV_BasicType_FLOAT16    },
-        { "_Complex float"       , RDI_TypeKind_ComplexF32 , CV_BasicType_COMPLEX32  },
-        { "_Complex double"      , RDI_TypeKind_ComplexF64 , CV_BasicType_COMPLEX64  },
-        { "_Complex long double" , RDI_TypeKind_ComplexF80 , CV_BasicType_COMPLEX80  },
-        { "_Complex __float128"  , RDI_TypeKind_ComplexF128, CV_BasicType_COMPLEX128 },
-        { "__int8"               , RDI_TypeKind_S8         , CV_BasicType_INT8       },
-        { "__uint8"              , RDI_TypeKind_U8         , CV_BasicType_UINT8      },
-        { "__int16"              , RDI_TypeKind_S16        , CV_BasicType_INT16      },
-        { "__uint16"             , RDI_TypeKind_U16        , CV_BasicType_UINT16     },
-        { "int"                  , RDI_TypeKind_S32        , CV_BasicType_INT32      },
-        { "int32"                , RDI_TypeKind_S32        , CV_BasicType_INT32      },
-        { "uint32"               , RDI_TypeKind_U32        , CV_BasicType_UINT32     },
-        { "__int64"              , RDI_TypeKind_S64        , CV_BasicType_INT64      },
-        { "__uint64"             , RDI_TypeKind_U64        , CV_BasicType_UINT64     },
-        { "__int128"             , RDI_TypeKind_S128       , CV_BasicType_INT128     },
-        { "__uint128"            , RDI_TypeKind_U128       , CV_BasicType_UINT128    },
-        { "char"                 , RDI_TypeKind_Char8      , CV_BasicType_RCHAR      }, // always ASCII
-        { "wchar_t"              , RDI_TypeKind_UChar16    , CV_BasicType_WCHAR      }, // on windows always UTF-16
-        { "char8_t"              , RDI_TypeKind_Char8      , CV_BasicType_CHAR8      }, // always UTF-8
-        { "char16_t"             , RDI_TypeKind_Char16     , CV_BasicType_CHAR16     }, // always UTF-16
-        { "char32_t"             , RDI_TypeKind_Char32     , CV_BasicType_CHAR32     }, // always UTF-32
-        { "__pointer"            , ptr_type                , CV_BasicType_PTR        }
-      };
-      for EachElement(idx, table)
+      
+      //////////////////////////
+      //- build basic itypes
+      //
+      if(params->subset_flags & RDIM_SubsetFlag_Types)
       {
-        RDIM_Type *builtin_alias   = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, tpi_leaf->itype_opl);
-        builtin_alias->kind        = RDI_TypeKind_Alias;
-        builtin_alias->name        = str8_cstring(table[idx].name);
-        builtin_alias->direct_type = p2r_builtin_type_ptr_from_kind(table[idx].kind_rdi);
-        builtin_alias->byte_size   = rdi_size_from_basic_type_kind(table[idx].kind_rdi);
-        itype_type_ptrs[table[idx].kind_cv] = builtin_alias;
+        for(CV_TypeId itype = 0; itype < itype_first; itype += 1)
+        {
+          if(itype_type_ptrs[itype] != 0)
+          {
+            continue;
+          }
+          RDIM_Type *dst_type = 0;
+          
+          // rjf: unpack itype
+          CV_BasicPointerKind cv_basic_ptr_kind  = CV_BasicPointerKindFromTypeId(itype);
+          CV_BasicType        cv_basic_type_code = CV_BasicTypeFromTypeId(itype);
+          
+          // rjf: get basic type slot, fill if unfilled
+          RDIM_Type *basic_type = itype_type_ptrs[cv_basic_type_code];
+          if(basic_type == 0)
+          {
+            RDI_TypeKind type_kind = p2r_rdi_type_kind_from_cv_basic_type(cv_basic_type_code);
+            U32 byte_size = rdi_size_from_basic_type_kind(type_kind);
+            basic_type = dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
+            if(byte_size == 0xffffffff)
+            {
+              byte_size = arch_addr_size;
+            }
+            basic_type->kind      = type_kind;
+            basic_type->name      = cv_type_name_from_basic_type(cv_basic_type_code);
+            basic_type->byte_size = byte_size;
+          }
+          
+          // rjf: nonzero ptr kind -> form ptr type to basic tpye
+          if(cv_basic_ptr_kind != 0)
+          {
+            dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
+            dst_type->kind        = RDI_TypeKind_Ptr;
+            dst_type->byte_size   = arch_addr_size;
+            dst_type->direct_type = basic_type;
+          }
+          
+          // rjf: fill this itype's slot with the finished type
+          itype_type_ptrs[itype] = dst_type;
+        }
       }
-      itype_type_ptrs[CV_BasicType_HRESULT] = basic_type_ptrs[RDI_TypeKind_HResult - RDI_TypeKind_FirstBuiltIn];
-      itype_type_ptrs[CV_BasicType_VOID]    = basic_type_ptrs[RDI_TypeKind_Void - RDI_TypeKind_FirstBuiltIn];
     }
+    lane_sync_u64(&itype_type_ptrs, 0);
+    lane_sync_u64(&basic_type_ptrs, 0);
+    lane_sync_u64(&itype_levels, 0);
+    lane_sync_u64(&lanes_max_levels, 0);
+    lane_sync_u64(&lanes_level_counts, 0);
     
     ////////////////////////////
-    //- rjf: build types from TPI
+    //- compute levels for all itypes which will be built - every itype
+    // not forwarded elsewhere, plus everything reachable from those chains.
+    // lanes may race to fill the same slot, but always with the same level.
     //
-    if(params->subset_flags & RDIM_SubsetFlag_Types)
+    U32 lane_max_level = 0;
+    if(params->subset_flags & RDIM_SubsetFlag_Types) ProfScope("compute itype levels")
     {
-      for(CV_TypeId root_itype = 0; root_itype < itype_opl; root_itype += 1)
+      Temp scratch2 = scratch_begin(&scratch.arena, 1);
+      P2R_TypeIdChain *free_tasks = 0;
+      Rng1U64 range = lane_range(itype_opl);
+      for EachInRange(idx, range)
       {
-        for(P2R_TypeIdChain *itype_chain = itype_chains[root_itype];
-            itype_chain != 0;
-            itype_chain = itype_chain->next)
+        CV_TypeId root_itype = (CV_TypeId)idx;
+        if(root_itype < itype_first || itype_fwd_map[root_itype] != 0 || itype_levels[root_itype] != 0)
         {
-          CV_TypeId itype = (root_itype != itype_chain->itype && itype_chain->itype < itype_opl && itype_fwd_map[itype_chain->itype]) ? itype_fwd_map[itype_chain->itype] : itype_chain->itype;
-          B32 itype_is_basic = (itype < tpi->itype_first);
-          
-          //////////////////////////
-          //- rjf: skip forward-reference itypes - all future resolutions will
-          // reference whatever this itype resolves to, and so there is no point
-          // in filling out this slot
-          //
-          if(itype_fwd_map[root_itype] != 0)
-          {
-            continue;
-          }
-          
-          //////////////////////////
-          //- rjf: skip already produced dependencies
-          //
-          if(itype_type_ptrs[itype] != 0)
-          {
-            continue;
-          }
+          continue;
+        }
+        P2R_TypeIdChain *task_stack = push_array(scratch2.arena, P2R_TypeIdChain, 1);
+        task_stack->itype = root_itype;
+        for(;task_stack != 0;)
+        {
+          CV_TypeId itype = task_stack->itype;
+          U32 level = itype_levels[itype];
           
-          //////////////////////////
-          //- rjf: build basic type
-          //
-          if(itype_is_basic)
+          // level not yet known -> gather from chain; push unknown deps
+          // to be computed first
+          if(level == 0)
           {
-            RDIM_Type *dst_type = 0;
-            
-            // rjf: unpack itype
-            CV_BasicPointerKind cv_basic_ptr_kind  = CV_BasicPointerKindFromTypeId(itype);
-            CV_BasicType        cv_basic_type_code = CV_BasicTypeFromTypeId(itype);
-            
-            // rjf: get basic type slot, fill if unfilled
-            RDIM_Type *basic_type = itype_type_ptrs[cv_basic_type_code];
-            if(basic_type == 0)
+            B32 deps_are_done = 1;
+            U32 deps_level = 0;
+            for(P2R_TypeIdChain *itype_chain = itype_chains[itype];
+                itype_chain != 0;
+                itype_chain = itype_chain->next)
             {
-              RDI_TypeKind type_kind = p2r_rdi_type_kind_from_cv_basic_type(cv_basic_type_code);
-              U32 byte_size = rdi_size_from_basic_type_kind(type_kind);
-              basic_type = dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-              if(byte_size == 0xffffffff)
+              CV_TypeId dep_itype = (itype != itype_chain->itype && itype_chain->itype < itype_opl && itype_fwd_map[itype_chain->itype]) ? itype_fwd_map[itype_chain->itype] : itype_chain->itype;
+              if(dep_itype == itype || dep_itype < itype_first || dep_itype >= itype_opl)
               {
-                byte_size = arch_addr_size;
+                continue;
               }
-              basic_type->kind      = type_kind;
-              basic_type->name      = cv_type_name_from_basic_type(cv_basic_type_code);
-              basic_type->byte_size = byte_size;
+              U32 dep_level = itype_levels[dep_itype];
+              if(dep_level == 0)
+              {
+                P2R_TypeIdChain *task = free_tasks;
+                if(task != 0)
+                {
+                  SLLStackPop(free_tasks);
+                }
+                else
+                {
+                  task = push_array_no_zero(scratch2.arena, P2R_TypeIdChain, 1);
+                }
+                task->itype = dep_itype;
+                SLLStackPush(task_stack, task);
+                deps_are_done = 0;
+              }
+              deps_level = Max(deps_level, dep_level);
             }
-            
-            // rjf: nonzero ptr kind -> form ptr type to basic tpye
-            if(cv_basic_ptr_kind != 0)
+            if(deps_are_done)
             {
-              dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-              dst_type->kind        = RDI_TypeKind_Ptr;
-              dst_type->byte_size   = arch_addr_size;
-              dst_type->direct_type = basic_type;
+              level = deps_level + 1;
+              itype_levels[itype] = level;
             }
-            
-            // rjf: fill this itype's slot with the finished type
-            itype_type_ptrs[itype] = dst_type;
           }
           
-          //////////////////////////
-          //- rjf: build non-basic type
-          //
-          if(!itype_is_basic && itype >= itype_first)
+          // level known -> pop
+          if(level != 0)
+          {
+            lane_max_level = Max(lane_max_level, level);
+            P2R_TypeIdChain *task = task_stack;
+            SLLStackPop(task_stack);
+            SLLStackPush(free_tasks, task);
+          }
+        }
+      }
+      scratch_end(scratch2);
+    }
+    lanes_max_levels[lane_idx()] = lane_max_level;
+    lane_sync();
+    
+    ////////////////////////////
+    //- bucket itypes by level - counted per-lane, then each lane
+    // writes its (ascending) itypes into its slice of each level
+    //
+    U64 level_count = 1;
+    for EachIndex(idx, lane_count())
+    {
+      level_count = Max(level_count, (U64)lanes_max_levels[idx] + 1);
+    }
+    U64 *level_offs = 0;
+    CV_TypeId *level_itypes = 0;
+    ProfScope("bucket itypes by level")
+    {
+      Rng1U64 range = lane_range(itype_opl);
+      U64 *level_counts = push_array(scratch.arena, U64, level_count);
+      for EachInRange(idx, range)
+      {
+        if(idx >= itype_first && itype_levels[idx] != 0)
+        {
+          level_counts[itype_levels[idx]] += 1;
+        }
+      }
+      lanes_level_counts[lane_idx()] = level_counts;
+      lane_sync();
+      if(lane_idx() == 0)
+      {
+        level_offs = push_array(scratch.arena, U64, level_count+1);
+        U64 off = 0;
+        for EachIndex(level, level_count)
+        {
+          level_offs[level] = off;
+          for EachIndex(lane, lane_count())
           {
-            RDIM_Type *dst_type = 0;
-            CV_RecRange *range = &tpi_leaf->leaf_ranges.ranges[itype-itype_first];
-            CV_LeafKind kind = range->hdr.kind;
-            U64 header_struct_size = cv_header_struct_size_from_leaf_kind(kind);
-            if(range->off+range->hdr.size <= tpi_leaf->data.size &&
-               range->off+2+header_struct_size <= tpi_leaf->data.size &&
-               range->hdr.size >= 2)
+            U64 count = lanes_level_counts[lane][level];
+            lanes_level_counts[lane][level] = off;
+            off += count;
+          }
+        }
+        level_offs[level_count] = off;
+        level_itypes = push_array_no_zero(scratch.arena, CV_TypeId, off);
+      }
+      lane_sync_u64(&level_offs, 0);
+      lane_sync_u64(&level_itypes, 0);
+      for EachInRange(idx, range)
+      {
+        if(idx >= itype_first && itype_levels[idx] != 0)
+        {
+          level_itypes[level_counts[itype_levels[idx]]] = (CV_TypeId)idx;
+          level_counts[itype_levels[idx]] += 1;
+        }
+      }
+    }
+    lane_sync();
+    
+    ////////////////////////////
+    //- build types from TPI, level-by-level
+    //
+    RDIM_TypeChunkList *lanes_level_types = 0;
+    if(lane_idx() == 0)
+    {
+      lanes_level_types = push_array(scratch.arena, RDIM_TypeChunkList, level_count*lane_count());
+    }
+    lane_sync_u64(&lanes_level_types, 0);
+    if(params->subset_flags & RDIM_SubsetFlag_Types) ProfScope("build types from TPI")
+    {
+      for(U64 level = 1; level < level_count; level += 1)
+      {
+        Rng1U64 level_range = r1u64(level_offs[level], level_offs[level+1]);
+        Rng1U64 lane_level_range = lane_range(dim_1u64(level_range));
+        RDIM_TypeChunkList *level_types = &lanes_level_types[level*lane_count() + lane_idx()];
+        U64 level_types_chunk_cap = dim_1u64(lane_level_range);
+        for EachInRange(idx, lane_level_range)
+        {
+          CV_TypeId itype = level_itypes[level_range.min + idx];
+          RDIM_Type *dst_type = 0;
+          CV_RecRange *range = &tpi_leaf->leaf_ranges.ranges[itype-itype_first];
+          CV_LeafKind kind = range->hdr.kind;
+          U64 header_struct_size = cv_header_struct_size_from_leaf_kind(kind);
+          if(range->off+range->hdr.size <= tpi_leaf->data.size &&
+             range->off+2+header_struct_size <= tpi_leaf->data.size &&
+             range->hdr.size >= 2)
+          {
+            U8 *itype_leaf_first = tpi_leaf->data.str + range->off+2;
+            U8 *itype_leaf_opl   = itype_leaf_first + range->hdr.size-2;
+            switch(kind)
             {
-              U8 *itype_leaf_first = tpi_leaf->data.str + range->off+2;
-              U8 *itype_leaf_opl   = itype_leaf_first + range->hdr.size-2;
-              switch(kind)
+              //- rjf: MODIFIER
+              case CV_LeafKind_MODIFIER:
               {
-                //- rjf: MODIFIER
-                case CV_LeafKind_MODIFIER:
-                {
-                  // rjf: unpack leaf
-                  CV_LeafModifier *lf = (CV_LeafModifier *)itype_leaf_first;
-                  
-                  // rjf: cv -> rdi flags
-                  RDI_TypeModifierFlags flags = 0;
-                  if(lf->flags & CV_ModifierFlag_Const)    {flags |= RDI_TypeModifierFlag_Const;}
-                  if(lf->flags & CV_ModifierFlag_Volatile) {flags |= RDI_TypeModifierFlag_Volatile;}
-                  
-                  // rjf: fill type
-                  if(flags == 0)
-                  {
-                    dst_type = p2r_type_ptr_from_itype(lf->itype);
-                  }
-                  else
-                  {
-                    dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                    dst_type->kind        = RDI_TypeKind_Modifier;
-                    dst_type->flags       = flags;
-                    dst_type->direct_type = p2r_type_ptr_from_itype(lf->itype);
-                    dst_type->byte_size   = dst_type->direct_type ? dst_type->direct_type->byte_size : 0;
-                  }
-                }break;
+                // rjf: unpack leaf
+                CV_LeafModifier *lf = (CV_LeafModifier *)itype_leaf_first;
                 
-                //- rjf: POINTER
-                case CV_LeafKind_POINTER:
-                {
-                  // TODO(rjf): if ptr_mode in {PtrMem, PtrMethod} then output a member pointer instead
-                  
-                  // rjf: unpack leaf
-                  CV_LeafPointer *lf = (CV_LeafPointer *)itype_leaf_first;
-                  RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->itype);
-                  CV_PointerKind ptr_kind = CV_PointerAttribs_Extract_Kind(lf->attribs);
-                  CV_PointerMode ptr_mode = CV_PointerAttribs_Extract_Mode(lf->attribs);
-                  U32            ptr_size = CV_PointerAttribs_Extract_Size(lf->attribs);
-                  
-                  // rjf: cv -> rdi modifier flags
-                  RDI_TypeModifierFlags modifier_flags = 0;
-                  if(lf->attribs & CV_PointerAttrib_Const)      {modifier_flags |= RDI_TypeModifierFlag_Const;}
-                  if(lf->attribs & CV_PointerAttrib_Volatile)   {modifier_flags |= RDI_TypeModifierFlag_Volatile;}
-                  if(lf->attribs & CV_PointerAttrib_Restricted) {modifier_flags |= RDI_TypeModifierFlag_Restrict;}
-                  
-                  // rjf: cv info -> rdi pointer type kind
-                  RDI_TypeKind type_kind = RDI_TypeKind_Ptr;
-                  {
-                    if(lf->attribs & CV_PointerAttrib_LRef)
-                    {
-                      type_kind = RDI_TypeKind_LRef;
-                    }
-                    else if(lf->attribs & CV_PointerAttrib_RRef)
-                    {
-                      type_kind = RDI_TypeKind_RRef;
-                    }
-                    if(ptr_mode == CV_PointerMode_LRef)
-                    {
-                      type_kind = RDI_TypeKind_LRef;
-                    }
-                    else if(ptr_mode == CV_PointerMode_RRef)
-                    {
-                      type_kind = RDI_TypeKind_RRef;
-                    }
-                  }
-                  
-                  // rjf: fill type
-                  if(modifier_flags != 0)
-                  {
-                    RDIM_Type *pointer_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                    dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                    dst_type->kind             = RDI_TypeKind_Modifier;
-                    dst_type->flags            = modifier_flags;
-                    dst_type->direct_type      = pointer_type;
-                    dst_type->byte_size        = arch_addr_size;
-                    pointer_type->kind         = type_kind;
-                    pointer_type->byte_size    = arch_addr_size;
-                    pointer_type->direct_type  = direct_type;
-                  }
-                  else
-                  {
-                    dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                    dst_type->kind        = type_kind;
-                    dst_type->byte_size   = arch_addr_size;
-                    dst_type->direct_type = direct_type;
-                  }
-                }break;
+                // rjf: cv -> rdi flags
+                RDI_TypeModifierFlags flags = 0;
+                if(lf->flags & CV_ModifierFlag_Const)    {flags |= RDI_TypeModifierFlag_Const;}
+                if(lf->flags & CV_ModifierFlag_Volatile) {flags |= RDI_TypeModifierFlag_Volatile;}
                 
-                //- rjf: PROCEDURE
-                case CV_LeafKind_PROCEDURE:
+                // rjf: fill type
+                if(flags == 0)
                 {
-                  // TODO(rjf): handle call_kind & attribs
-                  
-                  // rjf: unpack leaf
-                  CV_LeafProcedure *lf = (CV_LeafProcedure *)itype_leaf_first;
-                  RDIM_Type *ret_type = p2r_type_ptr_from_itype(lf->ret_itype);
-                  
-                  // rjf: fill type's basics
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  dst_type->kind        = RDI_TypeKind_Function;
-                  dst_type->byte_size   = arch_addr_size;
-                  dst_type->direct_type = ret_type;
-                  
-                  // rjf: unpack arglist range
-                  CV_RecRange *arglist_range = &tpi_leaf->leaf_ranges.ranges[lf->arg_itype-itype_first];
-                  if(arglist_range->hdr.kind != CV_LeafKind_ARGLIST ||
-                     arglist_range->hdr.size<2 ||
-                     arglist_range->off + arglist_range->hdr.size > tpi_leaf->data.size)
-                  {
-                    break;
-                  }
-                  U8 *arglist_first = tpi_leaf->data.str + arglist_range->off + 2;
-                  U8 *arglist_opl   = arglist_first+arglist_range->hdr.size-2;
-                  if(arglist_first + sizeof(CV_LeafArgList) > arglist_opl)
-                  {
-                    break;
-                  }
-                  
-                  // rjf: unpack arglist info
-                  CV_LeafArgList *arglist = (CV_LeafArgList*)arglist_first;
-                  CV_TypeId *arglist_itypes_base = (CV_TypeId *)(arglist+1);
-                  U32 arglist_itypes_count = arglist->count;
-                  
-                  // rjf: build param type array
-                  RDIM_Type **params = push_array(arena, RDIM_Type *, arglist_itypes_count);
-                  for(U32 idx = 0; idx < arglist_itypes_count; idx += 1)
-                  {
-                    params[idx] = p2r_type_ptr_from_itype(arglist_itypes_base[idx]);
-                  }
-                  
-                  // rjf: fill dst type
-                  dst_type->count = arglist_itypes_count;
-                  dst_type->param_types = params;
-                }break;
+                  dst_type = p2r_type_ptr_from_itype(lf->itype);
+                }
+                else
+                {
+                  dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                  dst_type->kind        = RDI_TypeKind_Modifier;
+                  dst_type->flags       = flags;
+                  dst_type->direct_type = p2r_type_ptr_from_itype(lf->itype);
+                  dst_type->byte_size   = dst_type->direct_type ? dst_type->direct_type->byte_size : 0;
+                }
+              }break;
+              
+              //- rjf: POINTER
+              case CV_LeafKind_POINTER:
+              {
+                // TODO(rjf): if ptr_mode in {PtrMem, PtrMethod} then output a member pointer instead
+                
+                // rjf: unpack leaf
+                CV_LeafPointer *lf = (CV_LeafPointer *)itype_leaf_first;
+                RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->itype);
+                CV_PointerKind ptr_kind = CV_PointerAttribs_Extract_Kind(lf->attribs);
+                CV_PointerMode ptr_mode = CV_PointerAttribs_Extract_Mode(lf->attribs);
+                U32            ptr_size = CV_PointerAttribs_Extract_Size(lf->attribs);
                 
-                //- rjf: MFUNCTION
-                case CV_LeafKind_MFUNCTION:
+                // rjf: cv -> rdi modifier flags
+                RDI_TypeModifierFlags modifier_flags = 0;
+                if(lf->attribs & CV_PointerAttrib_Const)      {modifier_flags |= RDI_TypeModifierFlag_Const;}
+                if(lf->attribs & CV_PointerAttrib_Volatile)   {modifier_flags |= RDI_TypeModifierFlag_Volatile;}
+                if(lf->attribs & CV_PointerAttrib_Restricted) {modifier_flags |= RDI_TypeModifierFlag_Restrict;}
+                
+                // rjf: cv info -> rdi pointer type kind
+                RDI_TypeKind type_kind = RDI_TypeKind_Ptr;
                 {
-                  // TODO(rjf): handle call_kind & attribs
-                  // TODO(rjf): preserve "this_adjust"
-                  
-                  // rjf: unpack leaf
-                  CV_LeafMFunction *lf = (CV_LeafMFunction *)itype_leaf_first;
-                  RDIM_Type *ret_type  = p2r_type_ptr_from_itype(lf->ret_itype);
-                  
-                  // rjf: fill type
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  dst_type->kind        = (lf->this_itype != 0) ? RDI_TypeKind_Method : RDI_TypeKind_Function;
-                  dst_type->byte_size   = arch_addr_size;
-                  dst_type->direct_type = ret_type;
-                  
-                  // rjf: unpack arglist range
-                  CV_RecRange *arglist_range = &tpi_leaf->leaf_ranges.ranges[lf->arg_itype-itype_first];
-                  if(arglist_range->hdr.kind != CV_LeafKind_ARGLIST ||
-                     arglist_range->hdr.size<2 ||
-                     arglist_range->off + arglist_range->hdr.size > tpi_leaf->data.size)
+                  if(lf->attribs & CV_PointerAttrib_LRef)
                   {
-                    break;
-                  }
-                  U8 *arglist_first = tpi_leaf->data.str + arglist_range->off + 2;
-                  U8 *arglist_opl   = arglist_first+arglist_range->hdr.size-2;
-                  if(arglist_first + sizeof(CV_LeafArgList) > arglist_opl)
-                  {
-                    break;
+                    type_kind = RDI_TypeKind_LRef;
                   }
-                  
-                  // rjf: unpack arglist info
-                  CV_LeafArgList *arglist = (CV_LeafArgList*)arglist_first;
-                  CV_TypeId *arglist_itypes_base = (CV_TypeId *)(arglist+1);
-                  U32 arglist_itypes_count = arglist->count;
-                  
-                  // rjf: build param type array
-                  U64 num_this_extras = 1;
-                  if(lf->this_itype == 0)
+                  else if(lf->attribs & CV_PointerAttrib_RRef)
                   {
-                    num_this_extras = 0;
+                    type_kind = RDI_TypeKind_RRef;
                   }
-                  RDIM_Type **params = push_array(arena, RDIM_Type *, arglist_itypes_count+num_this_extras);
-                  for(U32 idx = 0; idx < arglist_itypes_count; idx += 1)
+                  if(ptr_mode == CV_PointerMode_LRef)
                   {
-                    params[idx+num_this_extras] = p2r_type_ptr_from_itype(arglist_itypes_base[idx]);
+                    type_kind = RDI_TypeKind_LRef;
                   }
-                  if(lf->this_itype != 0)
+                  else if(ptr_mode == CV_PointerMode_RRef)
                   {
-                    params[0] = p2r_type_ptr_from_itype(lf->this_itype);
+                    type_kind = RDI_TypeKind_RRef;
                   }
-                  
-                  // rjf: fill dst type
-                  dst_type->count = arglist_itypes_count+num_this_extras;
-                  dst_type->param_types = params;
-                }break;
+                }
                 
-                //- rjf: BITFIELD
-                case CV_LeafKind_BITFIELD:
+                // rjf: fill type
+                if(modifier_flags != 0)
                 {
-                  // rjf: unpack leaf
-                  CV_LeafBitField *lf = (CV_LeafBitField *)itype_leaf_first;
-                  RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->itype);
-                  
-                  // rjf: fill type
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  dst_type->kind        = RDI_TypeKind_Bitfield;
-                  dst_type->off         = lf->pos;
-                  dst_type->count       = lf->len;
-                  dst_type->byte_size   = direct_type?direct_type->byte_size:0;
+                  RDIM_Type *pointer_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                  dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                  dst_type->kind             = RDI_TypeKind_Modifier;
+                  dst_type->flags            = modifier_flags;
+                  dst_type->direct_type      = pointer_type;
+                  dst_type->byte_size        = arch_addr_size;
+                  pointer_type->kind         = type_kind;
+                  pointer_type->byte_size    = arch_addr_size;
+                  pointer_type->direct_type  = direct_type;
+                }
+                else
+                {
+                  dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                  dst_type->kind        = type_kind;
+                  dst_type->byte_size   = arch_addr_size;
                   dst_type->direct_type = direct_type;
-                }break;
+                }
+              }break;
+              
+              //- rjf: PROCEDURE
+              case CV_LeafKind_PROCEDURE:
+              {
+                // TODO(rjf): handle call_kind & attribs
+                
+                // rjf: unpack leaf
+                CV_LeafProcedure *lf = (CV_LeafProcedure *)itype_leaf_first;
+                RDIM_Type *ret_type = p2r_type_ptr_from_itype(lf->ret_itype);
                 
-                //- rjf: ARRAY
-                case CV_LeafKind_ARRAY:
+                // rjf: fill type's basics
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                dst_type->kind        = RDI_TypeKind_Function;
+                dst_type->byte_size   = arch_addr_size;
+                dst_type->direct_type = ret_type;
+                
+                // rjf: unpack arglist range
+                CV_RecRange *arglist_range = &tpi_leaf->leaf_ranges.ranges[lf->arg_itype-itype_first];
+                if(arglist_range->hdr.kind != CV_LeafKind_ARGLIST ||
+                   arglist_range->hdr.size<2 ||
+                   arglist_range->off + arglist_range->hdr.size > tpi_leaf->data.size)
                 {
-                  // rjf: unpack leaf
-                  CV_LeafArray *lf = (CV_LeafArray *)itype_leaf_first;
-                  RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->entry_itype);
-                  U8 *numeric_ptr = (U8*)(lf + 1);
-                  CV_NumericParsed array_count = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
-                  U64 full_size = cv_u64_from_numeric(&array_count);
-                  
-                  // rjf: fill type
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  dst_type->kind        = RDI_TypeKind_Array;
-                  dst_type->direct_type = direct_type;
-                  dst_type->byte_size   = full_size;
-                  dst_type->count       = (direct_type && direct_type->byte_size) ? (dst_type->byte_size/direct_type->byte_size) : 0;
-                }break;
+                  break;
+                }
+                U8 *arglist_first = tpi_leaf->data.str + arglist_range->off + 2;
+                U8 *arglist_opl   = arglist_first+arglist_range->hdr.size-2;
+                if(arglist_first + sizeof(CV_LeafArgList) > arglist_opl)
+                {
+                  break;
+                }
                 
-                //- rjf: CLASS/STRUCTURE
-                case CV_LeafKind_CLASS:
-                case CV_LeafKind_STRUCTURE:
+                // rjf: unpack arglist info
+                CV_LeafArgList *arglist = (CV_LeafArgList*)arglist_first;
+                CV_TypeId *arglist_itypes_base = (CV_TypeId *)(arglist+1);
+                U32 arglist_itypes_count = arglist->count;
+                
+                // rjf: build param type array
+                RDIM_Type **params = push_array(arena, RDIM_Type *, arglist_itypes_count);
+                for(U32 idx = 0; idx < arglist_itypes_count; idx += 1)
                 {
-                  // TODO(rjf): handle props
-                  
-                  // rjf: unpack leaf
-                  CV_LeafStruct *lf = (CV_LeafStruct *)itype_leaf_first;
-                  U8 *numeric_ptr = (U8*)(lf + 1);
-                  CV_NumericParsed size = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
-                  U64 size_u64 = cv_u64_from_numeric(&size);
-                  U8 *name_ptr = numeric_ptr + size.encoded_size;
-                  String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
-                  
-                  // rjf: fill type
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  if(lf->props & CV_TypeProp_FwdRef)
-                  {
-                    dst_type->kind = (kind == CV_LeafKind_CLASS ? RDI_TypeKind_IncompleteClass : RDI_TypeKind_IncompleteStruct);
-                    dst_type->name = name;
-                  }
-                  else
-                  {
-                    dst_type->kind      = (kind == CV_LeafKind_CLASS ? RDI_TypeKind_Class : RDI_TypeKind_Struct);
-                    dst_type->byte_size = (U32)size_u64;
-                    dst_type->name      = name;
-                  }
-                }break;
+                  params[idx] = p2r_type_ptr_from_itype(arglist_itypes_base[idx]);
+                }
+                
+                // rjf: fill dst type
+                dst_type->count = arglist_itypes_count;
+                dst_type->param_types = params;
+              }break;
+              
+              //- rjf: MFUNCTION
+              case CV_LeafKind_MFUNCTION:
+              {
+                // TODO(rjf): handle call_kind & attribs
+                // TODO(rjf): preserve "this_adjust"
                 
-                //- rjf: CLASS2/STRUCT2
-                case CV_LeafKind_CLASS2:
-                case CV_LeafKind_STRUCT2:
+                // rjf: unpack leaf
+                CV_LeafMFunction *lf = (CV_LeafMFunction *)itype_leaf_first;
+                RDIM_Type *ret_type  = p2r_type_ptr_from_itype(lf->ret_itype);
+                
+                // rjf: fill type
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                dst_type->kind        = (lf->this_itype != 0) ? RDI_TypeKind_Method : RDI_TypeKind_Function;
+                dst_type->byte_size   = arch_addr_size;
+                dst_type->direct_type = ret_type;
+                
+                // rjf: unpack arglist range
+                CV_RecRange *arglist_range = &tpi_leaf->leaf_ranges.ranges[lf->arg_itype-itype_first];
+                if(arglist_range->hdr.kind != CV_LeafKind_ARGLIST ||
+                   arglist_range->hdr.size<2 ||
+                   arglist_range->off + arglist_range->hdr.size > tpi_leaf->data.size)
                 {
-                  // TODO(rjf): handle props
-                  
-                  // rjf: unpack leaf
-                  CV_LeafStruct2 *lf = (CV_LeafStruct2 *)itype_leaf_first;
-                  U8 *numeric_ptr = (U8*)(lf + 1);
-                  CV_NumericParsed size = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
-                  U64 size_u64 = cv_u64_from_numeric(&size);
-                  U8 *name_ptr = numeric_ptr + size.encoded_size;
-                  String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
-                  
-                  // rjf: fill type
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  if(lf->props & CV_TypeProp_FwdRef)
-                  {
-                    dst_type->kind = (kind == CV_LeafKind_CLASS2 ? RDI_TypeKind_IncompleteClass : RDI_TypeKind_IncompleteStruct);
-                    dst_type->name = name;
-                  }
-                  else
-                  {
-                    dst_type->kind      = (kind == CV_LeafKind_CLASS2 ? RDI_TypeKind_Class : RDI_TypeKind_Struct);
-                    dst_type->byte_size = (U32)size_u64;
-                    dst_type->name      = name;
-                  }
-                }break;
+                  break;
+                }
+                U8 *arglist_first = tpi_leaf->data.str + arglist_range->off + 2;
+                U8 *arglist_opl   = arglist_first+arglist_range->hdr.size-2;
+                if(arglist_first + sizeof(CV_LeafArgList) > arglist_opl)
+                {
+                  break;
+                }
                 
-                //- rjf: UNION
-                case CV_LeafKind_UNION:
+                // rjf: unpack arglist info
+                CV_LeafArgList *arglist = (CV_LeafArgList*)arglist_first;
+                CV_TypeId *arglist_itypes_base = (CV_TypeId *)(arglist+1);
+                U32 arglist_itypes_count = arglist->count;
+                
+                // rjf: build param type array
+                U64 num_this_extras = 1;
+                if(lf->this_itype == 0)
                 {
-                  // TODO(rjf): handle props
-                  
-                  // rjf: unpack leaf
-                  CV_LeafUnion *lf = (CV_LeafUnion *)itype_leaf_first;
-                  U8 *numeric_ptr = (U8*)(lf + 1);
-                  CV_NumericParsed size = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
-                  U64 size_u64 = cv_u64_from_numeric(&size);
-                  U8 *name_ptr = numeric_ptr + size.encoded_size;
-                  String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
-                  
-                  // rjf: fill type
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  if(lf->props & CV_TypeProp_FwdRef)
-                  {
-                    dst_type->kind = RDI_TypeKind_IncompleteUnion;
-                    dst_type->name = name;
-                  }
-                  else
-                  {
-                    dst_type->kind      = RDI_TypeKind_Union;
-                    dst_type->byte_size = (U32)size_u64;
-                    dst_type->name      = name;
-                  }
-                }break;
+                  num_this_extras = 0;
+                }
+                RDIM_Type **params = push_array(arena, RDIM_Type *, arglist_itypes_count+num_this_extras);
+                for(U32 idx = 0; idx < arglist_itypes_count; idx += 1)
+                {
+                  params[idx+num_this_extras] = p2r_type_ptr_from_itype(arglist_itypes_base[idx]);
+                }
+                if(lf->this_itype != 0)
+                {
+                  params[0] = p2r_type_ptr_from_itype(lf->this_itype);
+                }
+                
+                // rjf: fill dst type
+                dst_type->count = arglist_itypes_count+num_this_extras;
+                dst_type->param_types = params;
+              }break;
+              
+              //- rjf: BITFIELD
+              case CV_LeafKind_BITFIELD:
+              {
+                // rjf: unpack leaf
+                CV_LeafBitField *lf = (CV_LeafBitField *)itype_leaf_first;
+                RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->itype);
+                
+                // rjf: fill type
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                dst_type->kind        = RDI_TypeKind_Bitfield;
+                dst_type->off         = lf->pos;
+                dst_type->count       = lf->len;
+                dst_type->byte_size   = direct_type?direct_type->byte_size:0;
+                dst_type->direct_type = direct_type;
+              }break;
+              
+              //- rjf: ARRAY
+              case CV_LeafKind_ARRAY:
+              {
+                // rjf: unpack leaf
+                CV_LeafArray *lf = (CV_LeafArray *)itype_leaf_first;
+                RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->entry_itype);
+                U8 *numeric_ptr = (U8*)(lf + 1);
+                CV_NumericParsed array_count = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
+                U64 full_size = cv_u64_from_numeric(&array_count);
+                
+                // rjf: fill type
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                dst_type->kind        = RDI_TypeKind_Array;
+                dst_type->direct_type = direct_type;
+                dst_type->byte_size   = full_size;
+                dst_type->count       = (direct_type && direct_type->byte_size) ? (dst_type->byte_size/direct_type->byte_size) : 0;
+              }break;
+              
+              //- rjf: CLASS/STRUCTURE
+              case CV_LeafKind_CLASS:
+              case CV_LeafKind_STRUCTURE:
+              {
+                // TODO(rjf): handle props
                 
-                //- rjf: ENUM
-                case CV_LeafKind_ENUM:
+                // rjf: unpack leaf
+                CV_LeafStruct *lf = (CV_LeafStruct *)itype_leaf_first;
+                U8 *numeric_ptr = (U8*)(lf + 1);
+                CV_NumericParsed size = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
+                U64 size_u64 = cv_u64_from_numeric(&size);
+                U8 *name_ptr = numeric_ptr + size.encoded_size;
+                String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
+                
+                // rjf: fill type
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                if(lf->props & CV_TypeProp_FwdRef)
                 {
-                  // TODO(rjf): handle props
-                  
-                  // rjf: unpack leaf
-                  CV_LeafEnum *lf = (CV_LeafEnum *)itype_leaf_first;
-                  RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->base_itype);
-                  U8 *name_ptr = (U8 *)(lf + 1);
-                  String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
-                  
-                  // rjf: fill type
-                  dst_type = rdim_type_chunk_list_push(arena, all_types__pre_typedefs_ptr, (U64)itype_opl);
-                  if(lf->props & CV_TypeProp_FwdRef)
-                  {
-                    dst_type->kind = RDI_TypeKind_IncompleteEnum;
-                    dst_type->name = name;
-                  }
-                  else
-                  {
-                    dst_type->kind        = RDI_TypeKind_Enum;
-                    dst_type->direct_type = direct_type;
-                    dst_type->byte_size   = direct_type ? direct_type->byte_size : 0;
-                    dst_type->name        = name;
-                  }
-                }break;
-              }
+                  dst_type->kind = (kind == CV_LeafKind_CLASS ? RDI_TypeKind_IncompleteClass : RDI_TypeKind_IncompleteStruct);
+                  dst_type->name = name;
+                }
+                else
+                {
+                  dst_type->kind      = (kind == CV_LeafKind_CLASS ? RDI_TypeKind_Class : RDI_TypeKind_Struct);
+                  dst_type->byte_size = (U32)size_u64;
+                  dst_type->name      = name;
+                }
+              }break;
+              
+              //- rjf: CLASS2/STRUCT2
+              case CV_LeafKind_CLASS2:
+              case CV_LeafKind_STRUCT2:
+              {
+                // TODO(rjf): handle props
+                
+                // rjf: unpack leaf
+                CV_LeafStruct2 *lf = (CV_LeafStruct2 *)itype_leaf_first;
+                U8 *numeric_ptr = (U8*)(lf + 1);
+                CV_NumericParsed size = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
+                U64 size_u64 = cv_u64_from_numeric(&size);
+                U8 *name_ptr = numeric_ptr + size.encoded_size;
+                String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
+                
+                // rjf: fill type
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                if(lf->props & CV_TypeProp_FwdRef)
+                {
+                  dst_type->kind = (kind == CV_LeafKind_CLASS2 ? RDI_TypeKind_IncompleteClass : RDI_TypeKind_IncompleteStruct);
+                  dst_type->name = name;
+                }
+                else
+                {
+                  dst_type->kind      = (kind == CV_LeafKind_CLASS2 ? RDI_TypeKind_Class : RDI_TypeKind_Struct);
+                  dst_type->byte_size = (U32)size_u64;
+                  dst_type->name      = name;
+                }
+              }break;
+              
+              //- rjf: UNION
+              case CV_LeafKind_UNION:
+              {
+                // TODO(rjf): handle props
+                
+                // rjf: unpack leaf
+                CV_LeafUnion *lf = (CV_LeafUnion *)itype_leaf_first;
+                U8 *numeric_ptr = (U8*)(lf + 1);
+                CV_NumericParsed size = cv_numeric_from_data_range(numeric_ptr, itype_leaf_opl);
+                U64 size_u64 = cv_u64_from_numeric(&size);
+                U8 *name_ptr = numeric_ptr + size.encoded_size;
+                String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
+                
+                // rjf: fill type
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                if(lf->props & CV_TypeProp_FwdRef)
+                {
+                  dst_type->kind = RDI_TypeKind_IncompleteUnion;
+                  dst_type->name = name;
+                }
+                else
+                {
+                  dst_type->kind      = RDI_TypeKind_Union;
+                  dst_type->byte_size = (U32)size_u64;
+                  dst_type->name      = name;
+                }
+              }break;
+              
+              //- rjf: ENUM
+              case CV_LeafKind_ENUM:
+              {
+                // TODO(rjf): handle props
+                
+                // rjf: unpack leaf
+                CV_LeafEnum *lf = (CV_LeafEnum *)itype_leaf_first;
+                RDIM_Type *direct_type = p2r_type_ptr_from_itype(lf->base_itype);
+                U8 *name_ptr = (U8 *)(lf + 1);
+                String8 name = str8_cstring_capped(name_ptr, itype_leaf_opl);
+                
+                // rjf: fill type
+                dst_type = rdim_type_chunk_list_push(arena, level_types, level_types_chunk_cap);
+                if(lf->props & CV_TypeProp_FwdRef)
+                {
+                  dst_type->kind = RDI_TypeKind_IncompleteEnum;
+                  dst_type->name = name;
+                }
+                else
+                {
+                  dst_type->kind        = RDI_TypeKind_Enum;
+                  dst_type->direct_type = direct_type;
+                  dst_type->byte_size   = direct_type ? direct_type->byte_size : 0;
+                  dst_type->name        = name;
+                }
+              }break;
             }
-            
-            //- rjf: store finalized type to this itype's slot
-            itype_type_ptrs[itype] = dst_type;
           }
+          
+          //- rjf: store finalized type to this itype's slot
+          itype_type_ptrs[itype] = dst_type;
         }
+        lane_sync();
+      }
+    }
+    
+    ////////////////////////////
+    //- join all levels, in level order
+    //
+    if(lane_idx() == 0) ProfScope("join types")
+    {
+      for EachIndex(idx, level_count*lane_count())
+      {
+        rdim_type_chunk_list_concat_in_place(all_types__pre_typedefs_ptr, &lanes_level_types[idx]);
       }
     }
 #undef p2r_type_ptr_from_itype
 #undef p2r_builtin_type_ptr_from_kind
   }
-  lane_sync_u64(&itype_type_ptrs, 0);
-  lane_sync_u64(&basic_type_ptrs, 0);
   lane_sync_u64(&all_types__pre_typedefs_ptr, 0);
   all_types__pre_typedefs = *all_types__pre_typedefs_ptr;
   
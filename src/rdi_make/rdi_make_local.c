@@ -56,7 +56,7 @@ rdim_bake(Arena *arena, RDIM_BakeParams *params)
   {
     rdim_shared = push_array(arena, RDIM_Shared, 1);
   }
-  lane_sync();
+  lane_sync_u64(&rdim_shared, 0);
   
   //////////////////////////////////////////////////////////////
   //- rjf: @rdim_bake_stage bake vmaps
@@ -3074,14 +3074,52 @@ rdim_compress(Arena *arena, RDIM_SerializedSectionBundle *in)
     RDIM_SerializedSection *src = &in->sections[k];
     RDIM_SerializedSection *dst = &out->sections[k];
     MemoryCopyStruct(dst, src);
-    if(src->encoded_size != 0)
+    
+    //- small sections -> single LZB blob
+    if(0 < src->encoded_size && src->encoded_size <= RDIM_COMPRESS_BLOCK_SIZE_TARGET)
     {
       MemoryZero(ctx.m_hashTable, sizeof(U16)*(1<<ctx.m_tableSizeBits));
-      dst->data = push_array_no_zero(arena, U8, src->encoded_size);
+      dst->data = push_array_no_zero(arena, U8, src->encoded_size + RDIM_COMPRESS_DST_SLOP);
       dst->encoded_size = rr_lzb_simple_encode_veryfast(&ctx, src->data, src->encoded_size, dst->data);
+      AssertAlways(dst->encoded_size <= src->encoded_size);
+      arena_pop(arena, src->encoded_size + RDIM_COMPRESS_DST_SLOP - dst->encoded_size);
       dst->unpacked_size = src->encoded_size;
       dst->encoding = RDI_SectionEncoding_LZB;
     }
+    
+    //- large sections -> independently compressed blocks, so that readers
+    // can unpack only the parts of the section which they touch. blocks never
+    // split elements.
+    else if(src->encoded_size > RDIM_COMPRESS_BLOCK_SIZE_TARGET)
+    {
+      U64 element_size = Max(rdi_section_element_size_table[k], 1);
+      U64 block_size = Max(RDIM_COMPRESS_BLOCK_SIZE_TARGET - RDIM_COMPRESS_BLOCK_SIZE_TARGET%element_size, element_size);
+      U64 block_count = (src->encoded_size + block_size - 1) / block_size;
+      U64 block_offs_size = sizeof(U64)*(block_count+1);
+      U64 header_size = sizeof(RDI_SectionBlockHeader) + block_offs_size;
+      U8 *dst_data = push_array_no_zero(arena, U8, header_size + block_size*block_count + RDIM_COMPRESS_DST_SLOP);
+      RDI_SectionBlockHeader *hdr = (RDI_SectionBlockHeader *)dst_data;
+      U64 *block_offs = (U64 *)(hdr+1);
+      hdr->block_size  = (U32)block_size;
+      hdr->block_count = (U32)block_count;
+      U64 off = header_size;
+      for EachIndex(block_idx, block_count)
+      {
+        U64 src_off = block_size*block_idx;
+        U64 src_size = Min(block_size, src->encoded_size - src_off);
+        MemoryZero(ctx.m_hashTable, sizeof(U16)*(1<<ctx.m_tableSizeBits));
+        block_offs[block_idx] = off;
+        U64 block_encoded_size = rr_lzb_simple_encode_veryfast(&ctx, (U8 *)src->data + src_off, src_size, dst_data + off);
+        AssertAlways(block_encoded_size <= src_size);
+        off += block_encoded_size;
+      }
+      block_offs[block_count] = off;
+      arena_pop(arena, header_size + block_size*block_count + RDIM_COMPRESS_DST_SLOP - off);
+      dst->data = dst_data;
+      dst->encoded_size = off;
+      dst->unpacked_size = src->encoded_size;
+      dst->encoding = RDI_SectionEncoding_LZBBlocks;
+    }
   }
   lane_sync();
   
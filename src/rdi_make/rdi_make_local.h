@@ -48,6 +48,16 @@
 //- rjf: main library
 #include "lib_rdi_make/rdi_make.h"
 
+//- compression parameters
+#define RDIM_COMPRESS_BLOCK_SIZE_TARGET KB(64)
+
+// NOTE: LZB never returns more than the raw size - once its output comes within
+// 8 bytes of it, the encoder bails & stores the input raw. the run it emits just
+// before that check trips can still write past the raw size though (a control
+// byte, up to 5 LRL & 5 ML excess bytes, a 2-byte offset, and literals copied 8
+// bytes at a time), so destination buffers are padded by this much.
+#define RDIM_COMPRESS_DST_SLOP 64
+
 //- rjf: unsorted joined line table info
 
 typedef struct RDIM_UnsortedJoinedLineTable RDIM_UnsortedJoinedLineTable;
@@ -158,7 +168,7 @@ struct RDIM_Shared
   RDIM_BinarySectionBakeResult baked_binary_sections;
 };
 
-global RDIM_Shared *rdim_shared = 0;
+thread_static RDIM_Shared *rdim_shared = 0;
 
 internal RDIM_DataModel rdim_data_model_from_os_arch(OperatingSystem os, RDI_Arch arch);
 internal RDIM_TopLevelInfo rdim_make_top_level_info(String8 image_name, Arch arch, U64 exe_hash, RDIM_BinarySectionList sections);
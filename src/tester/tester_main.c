@@ -6,7 +6,8 @@
 
 #define BUILD_TITLE "tester"
 #define BUILD_CONSOLE_INTERFACE 1
-#define OS_FEATURE_GRAPHICAL 1
+#define DMN_INIT_MANUAL 1
+#define CTRL_INIT_MANUAL 1
 
 ////////////////////////////////
 //~ rjf: Includes
@@ -14,20 +15,82 @@
 //- rjf: [h]
 #include "base/base_inc.h"
 #include "os/os_inc.h"
+#include "linker/hash_table.h"
+#include "artifact_cache/artifact_cache.h"
+#include "rdi/rdi_local.h"
+#include "rdi_make/rdi_make_local.h"
+#include "mdesk/mdesk.h"
 #include "content/content.h"
-#include "rdi_format/rdi_format_local.h"
+#include "file_stream/file_stream.h"
+#include "coff/coff.h"
+#include "coff/coff_parse.h"
+#include "pe/pe.h"
+#include "elf/elf.h"
+#include "elf/elf_parse.h"
+#include "codeview/codeview.h"
+#include "codeview/codeview_parse.h"
+#include "msf/msf.h"
+#include "msf/msf_parse.h"
+#include "pdb/pdb.h"
+#include "pdb/pdb_parse.h"
+#include "eh/eh_frame.h"
+#include "zstd/zstd.h"
+#include "dwarf/dwarf_inc.h"
+#include "rdi_from_coff/rdi_from_coff.h"
+#include "rdi_from_elf/rdi_from_elf.h"
 #include "regs/regs.h"
 #include "regs/rdi/regs_rdi.h"
+#include "dbg_info/dbg_info.h"
+#include "demon/demon_inc.h"
 #include "eval/eval_inc.h"
+#include "ctrl/ctrl_inc.h"
+
+//- rjf: [h] frontend hooks used by the eval layer
+internal CTRL_Entity *rd_ctrl_entity_from_eval_space(E_Space space);
 
 //- rjf: [c]
 #include "base/base_inc.c"
 #include "os/os_inc.c"
+#include "linker/hash_table.c"
+#include "artifact_cache/artifact_cache.c"
+#include "rdi/rdi_local.c"
+#include "rdi_make/rdi_make_local.c"
+#include "mdesk/mdesk.c"
 #include "content/content.c"
-#include "rdi_format/rdi_format_local.c"
+#include "file_stream/file_stream.c"
+#include "coff/coff.c"
+#include "coff/coff_parse.c"
+#include "pe/pe.c"
+#include "elf/elf.c"
+#include "elf/elf_parse.c"
+#include "codeview/codeview.c"
+#include "codeview/codeview_parse.c"
+#include "msf/msf.c"
+#include "msf/msf_parse.c"
+#include "pdb/pdb.c"
+#include "pdb/pdb_parse.c"
+#include "eh/eh_frame.c"
+#include "zstd/zstd.c"
+#include "dwarf/dwarf_inc.c"
+#include "rdi_from_coff/rdi_from_coff.c"
+#include "rdi_from_elf/rdi_from_elf.c"
 #include "regs/regs.c"
 #include "regs/rdi/regs_rdi.c"
+#include "dbg_info/dbg_info.c"
+#include "demon/demon_inc.c"
 #include "eval/eval_inc.c"
+#include "ctrl/ctrl_inc.c"
+
+////////////////////////////////
+//~ Frontend Hook Stubs
+
+// the eval layer still asks the debugger frontend for the ctrl entity behind
+// an eval space; the tester attaches to nothing, so there never is one.
+internal CTRL_Entity *
+rd_ctrl_entity_from_eval_space(E_Space space)
+{
+  return &ctrl_entity_nil;
+}
 
 ////////////////////////////////
 //~ rjf: Entry Points
@@ -202,6 +265,83 @@ for(Test *test = test_##name_identifier; test != 0; test = 0)
     }
   }
   
+  //////////////////////////////
+  //- DWARF -> RDI, split units & type deduplication
+  //
+  // split_dwarf_main is built by gcc from three units with -gsplit-dwarf and
+  // compressed .dwo sections; every unit declares `typedef struct Vec {int x, y;} Vec;`
+  // with its names stored inline (DW_FORM_string). after deduplication, the
+  // struct & the typedef must each be converted once, with their names intact.
+  // two more units declare a `struct W` which differs only in the type of a
+  // nested member, so both copies of W must survive.
+  //
+  Test(dwarf2rdi_split_type_dedup)
+  {
+    String8 test_artifacts_path = push_str8f(arena, "%S/%S", artifacts_path, test->name);
+    os_make_directory(test_artifacts_path);
+    
+    // build split_dwarf_main
+    struct {char *name; String8 text;} srcs[] =
+    {
+      {"u1.c", str8_lit_comp("typedef struct Vec {int x, y;} Vec;\nVec g1;\nint f1(Vec *v) { return v->x + v->y + 1; }\n")},
+      {"u2.c", str8_lit_comp("typedef struct Vec {int x, y;} Vec;\nVec g2;\nint f2(Vec *v) { return v->x + v->y + 2; }\n")},
+      {"u3.c", str8_lit_comp("typedef struct Vec {int x, y;} Vec;\nVec g3;\nint f3(Vec *v) { return v->x + v->y + 3; }\n")},
+      {"u4.c", str8_lit_comp("struct A {int v;};\nstruct W {struct A a;};\nstruct W w4;\n")},
+      {"u5.c", str8_lit_comp("struct A {float v;};\nstruct W {struct A a;};\nstruct W w5;\n")},
+      {"main.c", str8_lit_comp("int f1(void *), f2(void *), f3(void *);\nint main(void) { return f1(0) + f2(0) + f3(0); }\n")},
+    };
+    String8List src_paths = {0};
+    for EachElement(idx, srcs)
+    {
+      String8 src_path = push_str8f(arena, "%S/%s", test_artifacts_path, srcs[idx].name);
+      os_write_data_to_file_path(src_path, srcs[idx].text);
+      str8_list_push(arena, &src_paths, src_path);
+    }
+    String8 srcs_string = str8_list_join(arena, &src_paths, &(StringJoin){.sep = str8_lit(" ")});
+    
+    // build, convert & dump with standard (v5) and pre-standard GNU (v4) split units
+    U64 dwarf_versions[] = {5, 4};
+    for EachElement(version_idx, dwarf_versions)
+    {
+      U64 dwarf_version = dwarf_versions[version_idx];
+      String8 exe_path = push_str8f(arena, "%S/split_dwarf_main_v%I64u", test_artifacts_path, dwarf_version);
+      os_process_join(os_cmd_line_launchf("gcc -g -gdwarf-%I64u -gsplit-dwarf -gz %S -o %S", dwarf_version, srcs_string, exe_path), max_U64, 0);
+      if(!os_file_path_exists(exe_path))
+      {
+        test->good = 0;
+        str8_list_pushf(arena, &test->out, "unable to build \"%S\" (gcc with -gsplit-dwarf and -gz support is required)\n", exe_path);
+        break;
+      }
+      String8 rdi_path = push_str8f(arena, "%S.rdi", exe_path);
+      String8 dump_path = push_str8f(arena, "%S.dump", rdi_path);
+      os_process_join(os_cmd_line_launchf("radbin --rdi --deterministic %S --out:%S", exe_path, rdi_path), max_U64, 0);
+      os_process_join(os_cmd_line_launchf("radbin --dump %S --out:%S", rdi_path, dump_path), max_U64, 0);
+      String8 dump = os_data_from_file_path(arena, dump_path);
+      struct {String8 string; U64 count;} expected_strings[] =
+      {
+        {str8_lit_comp("kind: Struct\n    byte_size: 8\n    name: 'Vec'"), 1},
+        {str8_lit_comp("kind: Alias\n    byte_size: 8\n    name: 'Vec'"), 1},
+        {str8_lit_comp("kind: Struct\n    byte_size: 4\n    name: 'W'"), 2},
+        {str8_lit_comp("frame_base:"), 4},
+      };
+      for EachElement(idx, expected_strings)
+      {
+        U64 count = 0;
+        for(U64 pos = str8_find_needle(dump, 0, expected_strings[idx].string, 0);
+            pos < dump.size;
+            pos = str8_find_needle(dump, pos+1, expected_strings[idx].string, 0))
+        {
+          count += 1;
+        }
+        if(count != expected_strings[idx].count)
+        {
+          test->good = 0;
+          str8_list_pushf(arena, &test->out, "expected %I64u of \"%S\" in \"%S\", found %I64u\n", expected_strings[idx].count, expected_strings[idx].string, dump_path, count);
+        }
+      }
+    }
+  }
+  
   //////////////////////////////
   //- rjf: eval compiler basics
   //
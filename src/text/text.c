@@ -4,6 +4,20 @@
 #undef LAYER_COLOR
 #define LAYER_COLOR 0xe34cd4ff
 
+////////////////////////////////
+//~ Main Layer Initialization
+
+internal void
+txt_init(void)
+{
+  Arena *arena = arena_alloc();
+  txt_shared = push_array(arena, TXT_Shared, 1);
+  txt_shared->arena = arena;
+  txt_shared->base_hints_count = 1024;
+  txt_shared->base_hints = push_array(arena, TXT_BaseHint, txt_shared->base_hints_count);
+  txt_shared->base_hint_stripes = stripe_array_alloc(arena);
+}
+
 ////////////////////////////////
 //~ rjf: Basic Helpers
 
@@ -1950,6 +1964,283 @@ txt_scope_node_from_info_pt(TXT_TextInfo *info, TxtPt pt)
   return result;
 }
 
+////////////////////////////////
+//~ Incremental Text Info Building
+
+internal TXT_LineEndKind
+txt_line_end_kind_from_data(String8 data)
+{
+  TXT_LineEndKind line_end_kind = TXT_LineEndKind_Null;
+  U64 lf_count = 0;
+  U64 cr_count = 0;
+  for(U64 idx = 0; idx < data.size && idx < 1024; idx += 1)
+  {
+    if(data.str[idx] == '\r')
+    {
+      cr_count += 1;
+    }
+    if(data.str[idx] == '\n')
+    {
+      lf_count += 1;
+    }
+  }
+  if(cr_count >= lf_count/2 && lf_count >= 1)
+  {
+    line_end_kind = TXT_LineEndKind_CRLF;
+  }
+  else if(lf_count >= 1)
+  {
+    line_end_kind = TXT_LineEndKind_LF;
+  }
+  return line_end_kind;
+}
+
+internal void
+txt_push_base_hint(U128 hash, U128 base_hash)
+{
+  U64 slot_idx = hash.u64[1]%txt_shared->base_hints_count;
+  Stripe *stripe = stripe_from_slot_idx(&txt_shared->base_hint_stripes, slot_idx);
+  RWMutexScope(stripe->rw_mutex, 1)
+  {
+    txt_shared->base_hints[slot_idx].hash = hash;
+    txt_shared->base_hints[slot_idx].base_hash = base_hash;
+  }
+}
+
+internal U128
+txt_base_hash_from_hash(U128 hash)
+{
+  U128 result = {0};
+  U64 slot_idx = hash.u64[1]%txt_shared->base_hints_count;
+  Stripe *stripe = stripe_from_slot_idx(&txt_shared->base_hint_stripes, slot_idx);
+  RWMutexScope(stripe->rw_mutex, 0)
+  {
+    if(u128_match(txt_shared->base_hints[slot_idx].hash, hash))
+    {
+      result = txt_shared->base_hints[slot_idx].base_hash;
+    }
+  }
+  return result;
+}
+
+internal B32
+txt_text_info_patch_from_base(Arena *arena, TXT_LangLexFunctionType *lex_function, String8 base_data, TXT_TextInfo *base_info, String8 data, TXT_TextInfo *info_out)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //- measure unchanged prefix & suffix. offsets past the edit are
+  // shifted by `delta`, which wraps for shrinking edits.
+  U64 max_shared_size = Min(base_data.size, data.size);
+  U64 prefix_size = 0;
+  for(;prefix_size < max_shared_size && base_data.str[prefix_size] == data.str[prefix_size]; prefix_size += 1);
+  U64 suffix_size = 0;
+  for(;suffix_size < max_shared_size - prefix_size && base_data.str[base_data.size-1-suffix_size] == data.str[data.size-1-suffix_size]; suffix_size += 1);
+  U64 suffix_off = data.size - suffix_size;
+  U64 delta = data.size - base_data.size;
+  
+  //- only patch small edits - for big ones, the wide from-scratch build
+  // is cheaper
+  B32 can_patch = (base_info->lines_count != 0 && suffix_off - prefix_size <= data.size/2);
+  
+  //- patch line ranges
+  if(can_patch)
+  {
+    // find first base line that the edit may have touched (with slack
+    // for CRLF line endings), then back up by one more line
+    U64 first_line_idx = 0;
+    {
+      U64 lo = 0;
+      U64 hi = base_info->lines_count;
+      for(;lo < hi;)
+      {
+        U64 mid = (lo+hi)/2;
+        if(base_info->lines_ranges[mid].max + 2 < prefix_size)
+        {
+          lo = mid+1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      first_line_idx = Min(lo, base_info->lines_count-1);
+      first_line_idx -= !!first_line_idx;
+    }
+    
+    // rescan lines until we're back in sync with the base's lines in
+    // the unchanged suffix
+    Rng1U64List rescanned_lines = {0};
+    U64 tail_line_idx = base_info->lines_count;
+    {
+      U64 line_start_idx = base_info->lines_ranges[first_line_idx].min;
+      for(U64 idx = line_start_idx; idx <= data.size; idx += 1)
+      {
+        if(idx == data.size || data.str[idx] == '\n' || data.str[idx] == '\r')
+        {
+          rng1u64_list_push(scratch.arena, &rescanned_lines, r1u64(line_start_idx, idx));
+          line_start_idx = idx+1;
+          if(idx < data.size && data.str[idx] == '\r')
+          {
+            line_start_idx += 1;
+            idx += 1;
+          }
+          if(suffix_off + 2 <= line_start_idx && line_start_idx <= data.size)
+          {
+            U64 base_line_start_idx = line_start_idx - delta;
+            U64 lo = first_line_idx+1;
+            U64 hi = base_info->lines_count;
+            for(;lo < hi;)
+            {
+              U64 mid = (lo+hi)/2;
+              if(base_info->lines_ranges[mid].min < base_line_start_idx)
+              {
+                lo = mid+1;
+              }
+              else
+              {
+                hi = mid;
+              }
+            }
+            if(lo < base_info->lines_count && base_info->lines_ranges[lo].min == base_line_start_idx)
+            {
+              tail_line_idx = lo;
+              break;
+            }
+          }
+        }
+      }
+    }
+    
+    // splice
+    info_out->lines_count = first_line_idx + rescanned_lines.count + (base_info->lines_count - tail_line_idx);
+    info_out->lines_ranges = push_array_no_zero(arena, Rng1U64, info_out->lines_count);
+    U64 line_idx = 0;
+    for(U64 idx = 0; idx < first_line_idx; idx += 1, line_idx += 1)
+    {
+      info_out->lines_ranges[line_idx] = base_info->lines_ranges[idx];
+    }
+    for(Rng1U64Node *n = rescanned_lines.first; n != 0; n = n->next, line_idx += 1)
+    {
+      info_out->lines_ranges[line_idx] = n->v;
+    }
+    for(U64 idx = tail_line_idx; idx < base_info->lines_count; idx += 1, line_idx += 1)
+    {
+      info_out->lines_ranges[line_idx] = r1u64(base_info->lines_ranges[idx].min + delta, base_info->lines_ranges[idx].max + delta);
+    }
+    for EachIndex(idx, info_out->lines_count)
+    {
+      info_out->lines_max_size = Max(info_out->lines_max_size, dim_1u64(info_out->lines_ranges[idx]));
+    }
+    info_out->line_end_kind = txt_line_end_kind_from_data(data);
+  }
+  
+  //- patch tokens
+  if(can_patch && lex_function != 0)
+  {
+    TXT_TokenArray *base_tokens = &base_info->tokens;
+    
+    // find first base token that the edit may have touched (a token
+    // ending right at the edit may be extended by it), then back up to a
+    // checkpoint the lexer can restart from. lexers carry state across
+    // tokens (e.g. runs of symbols), so only token starts which directly
+    // follow whitespace are treated as clean lexer states.
+    U64 restart_token_idx = 0;
+    {
+      U64 lo = 0;
+      U64 hi = base_tokens->count;
+      for(;lo < hi;)
+      {
+        U64 mid = (lo+hi)/2;
+        if(base_tokens->v[mid].range.max < prefix_size)
+        {
+          lo = mid+1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      restart_token_idx = (lo < base_tokens->count ? lo : base_tokens->count);
+      restart_token_idx -= !!restart_token_idx;
+      for(;restart_token_idx != 0 && base_tokens->v[restart_token_idx-1].kind != TXT_TokenKind_Whitespace; restart_token_idx -= 1);
+    }
+    U64 restart_off = (restart_token_idx < base_tokens->count ? base_tokens->v[restart_token_idx].range.min : 0);
+    
+    // re-lex growing windows past the edit, until the new tokens line
+    // up with the base's tokens in the unchanged suffix
+    TXT_TokenArray window_tokens = {0};
+    U64 window_tokens_used_count = 0;
+    U64 tail_token_idx = base_tokens->count;
+    for(U64 window_slack = KB(4);; window_slack *= 4)
+    {
+      U64 window_opl = (data.size - suffix_off > window_slack ? suffix_off + window_slack : data.size);
+      B32 window_is_tail = (window_opl == data.size);
+      window_tokens = lex_function(scratch.arena, 0, str8_substr(data, r1u64(restart_off, window_opl)));
+      window_tokens_used_count = window_tokens.count;
+      B32 converged = 0;
+      for EachIndex(idx, window_tokens.count)
+      {
+        TXT_Token *token = &window_tokens.v[idx];
+        token->range = shift_1u64(token->range, restart_off);
+        if(converged || token->range.min < suffix_off || idx == 0 || window_tokens.v[idx-1].kind != TXT_TokenKind_Whitespace)
+        {
+          continue;
+        }
+        if(!window_is_tail && token->range.max >= window_opl)
+        {
+          break;
+        }
+        U64 base_token_min = token->range.min - delta;
+        U64 lo = restart_token_idx;
+        U64 hi = base_tokens->count;
+        for(;lo < hi;)
+        {
+          U64 mid = (lo+hi)/2;
+          if(base_tokens->v[mid].range.min < base_token_min)
+          {
+            lo = mid+1;
+          }
+          else
+          {
+            hi = mid;
+          }
+        }
+        if(lo < base_tokens->count && lo != 0 &&
+           base_tokens->v[lo-1].kind == TXT_TokenKind_Whitespace &&
+           base_tokens->v[lo].range.min == base_token_min &&
+           base_tokens->v[lo].range.max == token->range.max - delta &&
+           base_tokens->v[lo].kind == token->kind)
+        {
+          converged = 1;
+          window_tokens_used_count = idx;
+          tail_token_idx = lo;
+        }
+      }
+      if(converged || window_is_tail)
+      {
+        break;
+      }
+    }
+    
+    // splice
+    info_out->tokens.count = restart_token_idx + window_tokens_used_count + (base_tokens->count - tail_token_idx);
+    info_out->tokens.v = push_array_no_zero(arena, TXT_Token, info_out->tokens.count);
+    MemoryCopy(info_out->tokens.v, base_tokens->v, sizeof(TXT_Token)*restart_token_idx);
+    MemoryCopy(info_out->tokens.v + restart_token_idx, window_tokens.v, sizeof(TXT_Token)*window_tokens_used_count);
+    TXT_Token *tail_tokens = info_out->tokens.v + restart_token_idx + window_tokens_used_count;
+    for(U64 idx = tail_token_idx; idx < base_tokens->count; idx += 1, tail_tokens += 1)
+    {
+      tail_tokens->kind = base_tokens->v[idx].kind;
+      tail_tokens->range = r1u64(base_tokens->v[idx].range.min + delta, base_tokens->v[idx].range.max + delta);
+    }
+  }
+  
+  scratch_end(scratch);
+  ProfEnd();
+  return can_patch;
+}
+
 ////////////////////////////////
 //~ rjf: Artifact Cache Hooks / Lookups
 
@@ -1966,6 +2257,7 @@ struct TXT_ArtifactCreateShared
 {
   Arena *arena;
   TXT_TextInfo info;
+  B32 info_is_patched;
   TXT_Artifact *artifact;
 };
 
@@ -2001,101 +2293,106 @@ txt_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_ou
     }
     
     //- rjf: set # of bytes to process
-    //                  (line ending calc)     (line counting)    (line measuring)   (lexing)
-    set_progress_target(Min(data.size, 1024) + data.size        + data.size        + data.size*(lang != TXT_LangKind_Null));
+    //                    (line ending calc)     (line counting)    (line measuring)   (lexing)
+    U64 progress_target = Min(data.size, 1024) + data.size        + data.size        + data.size*(lang != TXT_LangKind_Null);
+    set_progress_target(progress_target);
     
-    //- rjf: detect line end kind
-    TXT_LineEndKind line_end_kind = TXT_LineEndKind_Null;
+    //- try to patch the info of the previous version of this text. only use
+    // a base which is already built - requesting one here would queue a full
+    // build of a version that is no longer needed.
     if(lane_idx() == 0)
     {
-      U64 lf_count = 0;
-      U64 cr_count = 0;
-      for(U64 idx = 0; idx < data.size && idx < 1024; idx += 1)
+      U128 base_hash = txt_base_hash_from_hash(hash);
+      if(!u128_match(base_hash, u128_zero()) && !u128_match(base_hash, hash))
       {
-        if(data.str[idx] == '\r')
-        {
-          cr_count += 1;
-        }
-        if(data.str[idx] == '\n')
+        TXT_TextInfo base_info = txt_text_info_from_hash_lang_flags(access, base_hash, lang, AC_Flag_NoRequest);
+        String8 base_data = c_data_from_hash(access, base_hash);
+        if(base_info.lines_count != 0 && base_data.size != 0)
         {
-          lf_count += 1;
+          shared->info_is_patched = txt_text_info_patch_from_base(shared->arena, lex_function, base_data, &base_info, data, &shared->info);
         }
       }
-      if(cr_count >= lf_count/2 && lf_count >= 1)
-      {
-        line_end_kind = TXT_LineEndKind_CRLF;
-      }
-      else if(lf_count >= 1)
-      {
-        line_end_kind = TXT_LineEndKind_LF;
-      }
-      shared->info.line_end_kind = line_end_kind;
     }
     lane_sync();
-    set_progress(Min(data.size, 1024));
-    
-    //- rjf: count # of lines
-    U64 lane_line_count = 0;
-    if(lane_idx() == 0)
+    if(shared->info_is_patched)
     {
-      lane_line_count = 1;
+      set_progress(progress_target);
     }
+    
+    //- no previous version? -> build from scratch
+    else
     {
-      Rng1U64 range = lane_range(data.size);
-      for EachInRange(idx, range)
+      //- rjf: detect line end kind
+      if(lane_idx() == 0)
       {
-        if(data.str[idx] == '\n')
-        {
-          lane_line_count += 1;
-        }
-        if(idx && idx%1000 == 0)
-        {
-          add_progress(1000);
-        }
+        shared->info.line_end_kind = txt_line_end_kind_from_data(data);
       }
-    }
-    ins_atomic_u64_add_eval(&shared->info.lines_count, lane_line_count);
-    lane_sync();
-    set_progress(Min(data.size, 1024) + data.size);
-    
-    //- rjf: allocate & store line ranges
-    if(lane_idx() == 0)
-    {
-      shared->info.lines_ranges = push_array_no_zero(shared->arena, Rng1U64, shared->info.lines_count);
-      U64 line_idx = 0;
-      U64 line_start_idx = 0;
-      for(U64 idx = 0; idx <= data.size; idx += 1)
+      lane_sync();
+      set_progress(Min(data.size, 1024));
+      
+      //- rjf: count # of lines
+      U64 lane_line_count = 0;
+      if(lane_idx() == 0)
       {
-        if(idx == data.size || data.str[idx] == '\n' || data.str[idx] == '\r')
+        lane_line_count = 1;
+      }
+      {
+        Rng1U64 range = lane_range(data.size);
+        for EachInRange(idx, range)
         {
-          Rng1U64 line_range = r1u64(line_start_idx, idx);
-          U64 line_size = dim_1u64(line_range);
-          shared->info.lines_ranges[line_idx] = line_range;
-          shared->info.lines_max_size = Max(shared->info.lines_max_size, line_size);
-          line_idx += 1;
-          line_start_idx = idx+1;
-          if(idx < data.size && data.str[idx] == '\r')
+          if(data.str[idx] == '\n')
           {
-            line_start_idx += 1;
-            idx += 1;
+            lane_line_count += 1;
+          }
+          if(idx && idx%1000 == 0)
+          {
+            add_progress(1000);
           }
         }
-        if(idx && idx%1000 == 0)
+      }
+      ins_atomic_u64_add_eval(&shared->info.lines_count, lane_line_count);
+      lane_sync();
+      set_progress(Min(data.size, 1024) + data.size);
+      
+      //- rjf: allocate & store line ranges
+      if(lane_idx() == 0)
+      {
+        shared->info.lines_ranges = push_array_no_zero(shared->arena, Rng1U64, shared->info.lines_count);
+        U64 line_idx = 0;
+        U64 line_start_idx = 0;
+        for(U64 idx = 0; idx <= data.size; idx += 1)
         {
-          add_progress(1000);
+          if(idx == data.size || data.str[idx] == '\n' || data.str[idx] == '\r')
+          {
+            Rng1U64 line_range = r1u64(line_start_idx, idx);
+            U64 line_size = dim_1u64(line_range);
+            shared->info.lines_ranges[line_idx] = line_range;
+            shared->info.lines_max_size = Max(shared->info.lines_max_size, line_size);
+            line_idx += 1;
+            line_start_idx = idx+1;
+            if(idx < data.size && data.str[idx] == '\r')
+            {
+              line_start_idx += 1;
+              idx += 1;
+            }
+          }
+          if(idx && idx%1000 == 0)
+          {
+            add_progress(1000);
+          }
         }
       }
+      lane_sync();
+      set_progress(Min(data.size, 1024) + data.size + data.size);
+      
+      //- rjf: lex function * data -> tokens
+      if(lane_idx() == 0 && lex_function != 0)
+      {
+        shared->info.tokens = lex_function(shared->arena, 0, data);
+      }
+      lane_sync();
+      set_progress(Min(data.size, 1024) + data.size + data.size + data.size*(lex_function != 0));
     }
-    lane_sync();
-    set_progress(Min(data.size, 1024) + data.size + data.size);
-    
-    //- rjf: lex function * data -> tokens
-    if(lane_idx() == 0 && lex_function != 0)
-    {
-      shared->info.tokens = lex_function(shared->arena, 0, data);
-    }
-    lane_sync();
-    set_progress(Min(data.size, 1024) + data.size + data.size + data.size*(lex_function != 0));
     TXT_TokenArray tokens = shared->info.tokens;
     
     //- rjf: count scope points
@@ -2227,6 +2524,7 @@ txt_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_ou
     shared->artifact->arena     = shared->arena;
     shared->artifact->data_hash = hash;
     shared->artifact->info      = shared->info;
+    ac_report_artifact_size(arena_pos(shared->arena));
   }
   lane_sync();
   
@@ -2248,7 +2546,7 @@ txt_artifact_destroy(AC_Artifact artifact)
 }
 
 internal TXT_TextInfo
-txt_text_info_from_hash_lang(Access *access, U128 hash, TXT_LangKind lang)
+txt_text_info_from_hash_lang_flags(Access *access, U128 hash, TXT_LangKind lang, AC_Flags flags)
 {
 #pragma pack(push, 1)
   struct
@@ -2258,7 +2556,7 @@ txt_text_info_from_hash_lang(Access *access, U128 hash, TXT_LangKind lang)
   } key = {hash, lang};
 #pragma pack(pop)
   String8 key_string = str8_struct(&key);
-  AC_Artifact artifact = ac_artifact_from_key(access, key_string, txt_artifact_create, txt_artifact_destroy, 0, .flags = AC_Flag_Wide);
+  AC_Artifact artifact = ac_artifact_from_key(access, key_string, txt_artifact_create, txt_artifact_destroy, 0, .flags = AC_Flag_Wide|flags);
   TXT_Artifact *txt_artifact = (TXT_Artifact *)artifact.u64[0];
   TXT_TextInfo info = {0};
   if(txt_artifact != 0)
@@ -2268,6 +2566,13 @@ txt_text_info_from_hash_lang(Access *access, U128 hash, TXT_LangKind lang)
   return info;
 }
 
+internal TXT_TextInfo
+txt_text_info_from_hash_lang(Access *access, U128 hash, TXT_LangKind lang)
+{
+  TXT_TextInfo info = txt_text_info_from_hash_lang_flags(access, hash, lang, 0);
+  return info;
+}
+
 internal TXT_TextInfo
 txt_text_info_from_key_lang(Access *access, C_Key key, TXT_LangKind lang, U128 *hash_out)
 {
@@ -2275,6 +2580,14 @@ txt_text_info_from_key_lang(Access *access, C_Key key, TXT_LangKind lang, U128 *
   for(U64 rewind_idx = 0; rewind_idx < C_KEY_HASH_HISTORY_COUNT; rewind_idx += 1)
   {
     U128 hash = c_hash_from_key(key, rewind_idx);
+    if(rewind_idx == 0)
+    {
+      U128 base_hash = c_hash_from_key(key, 1);
+      if(!u128_match(base_hash, u128_zero()))
+      {
+        txt_push_base_hint(hash, base_hash);
+      }
+    }
     result = txt_text_info_from_hash_lang(access, hash, lang);
     if(result.lines_count != 0)
     {
@@ -155,10 +155,37 @@ TXT_LangKind;
 
 typedef TXT_TokenArray TXT_LangLexFunctionType(Arena *arena, U64 *bytes_processed_counter, String8 string);
 
+////////////////////////////////
+//~ Shared State
+
+typedef struct TXT_BaseHint TXT_BaseHint;
+struct TXT_BaseHint
+{
+  U128 hash;
+  U128 base_hash;
+};
+
+typedef struct TXT_Shared TXT_Shared;
+struct TXT_Shared
+{
+  Arena *arena;
+  
+  // (text hash -> previous text hash) hints, for incremental info builds
+  U64 base_hints_count;
+  TXT_BaseHint *base_hints;
+  StripeArray base_hint_stripes;
+};
+
 ////////////////////////////////
 //~ rjf: Globals
 
 read_only global TXT_ScopeNode txt_scope_node_nil = {0};
+global TXT_Shared *txt_shared = 0;
+
+////////////////////////////////
+//~ Main Layer Initialization
+
+internal void txt_init(void);
 
 ////////////////////////////////
 //~ rjf: Basic Helpers
@@ -200,11 +227,20 @@ internal TXT_ScopeNode *txt_scope_node_from_info_num(TXT_TextInfo *info, U64 num
 internal TXT_ScopeNode *txt_scope_node_from_info_off(TXT_TextInfo *info, U64 off);
 internal TXT_ScopeNode *txt_scope_node_from_info_pt(TXT_TextInfo *info, TxtPt pt);
 
+////////////////////////////////
+//~ Incremental Text Info Building
+
+internal TXT_LineEndKind txt_line_end_kind_from_data(String8 data);
+internal void txt_push_base_hint(U128 hash, U128 base_hash);
+internal U128 txt_base_hash_from_hash(U128 hash);
+internal B32 txt_text_info_patch_from_base(Arena *arena, TXT_LangLexFunctionType *lex_function, String8 base_data, TXT_TextInfo *base_info, String8 data, TXT_TextInfo *info_out);
+
 ////////////////////////////////
 //~ rjf: Artifact Cache Hooks / Lookups
 
 internal AC_Artifact txt_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
 internal void txt_artifact_destroy(AC_Artifact artifact);
+internal TXT_TextInfo txt_text_info_from_hash_lang_flags(Access *access, U128 hash, TXT_LangKind lang, AC_Flags flags);
 internal TXT_TextInfo txt_text_info_from_hash_lang(Access *access, U128 hash, TXT_LangKind lang);
 internal TXT_TextInfo txt_text_info_from_key_lang(Access *access, C_Key key, TXT_LangKind lang, U128 *hash_out);
 
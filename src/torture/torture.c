@@ -199,6 +199,36 @@ t_make_file_path(Arena *arena, String8 name)
   return push_str8f(arena, "%S\\%S", g_wdir, name);
 }
 
+internal int
+t_invoke_linker_capturef(Arena *arena, String8 *output_out, char *fmt, ...)
+{
+  Temp scratch = scratch_begin(&arena,1);
+
+  // route linker output to a file in the working directory, so the test can inspect warnings
+  String8 stdout_file_name = g_stdout_file_name;
+  B32     redirect_stdout  = g_redirect_stdout;
+  g_stdout_file_name = t_make_file_path(scratch.arena, str8_lit("linker.out"));
+  g_redirect_stdout  = 1;
+  os_delete_file_at_path(g_stdout_file_name);
+
+  va_list args;
+  va_start(args, fmt);
+  String8 cmdline = push_str8fv(scratch.arena, fmt, args);
+  int exit_code = t_invoke_linker(cmdline);
+  va_end(args);
+
+  *output_out = os_data_from_file_path(arena, g_stdout_file_name);
+  if (g_verbose) {
+    fprintf(stdout, "%.*s", str8_varg(*output_out));
+  }
+
+  g_stdout_file_name = stdout_file_name;
+  g_redirect_stdout  = redirect_stdout;
+
+  scratch_end(scratch);
+  return exit_code;
+}
+
 internal B32
 t_write_file_list(String8 name, String8List data)
 {
@@ -3958,6 +3988,505 @@ exit:;
   return result;
 }
 
+internal COFF_ObjSection *
+t_push_comdat_func(COFF_ObjWriter *obj_writer, String8 name, String8 code, COFF_ObjSymbol **symbol_out)
+{
+  COFF_ObjSection *sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$mn"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align16Bytes, code);
+  coff_obj_writer_push_symbol_secdef(obj_writer, sect, COFF_ComdatSelect_Any);
+  COFF_ObjSymbol *symbol = coff_obj_writer_push_symbol_extern_func(obj_writer, name, 0, sect);
+  if (symbol_out) {
+    *symbol_out = symbol;
+  }
+  return sect;
+}
+
+internal B32
+t_write_refs_obj(String8 *names, U64 names_count)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+  U8 text[] = { 0xC3 };
+  COFF_ObjSection *text_sect = t_push_text_section(obj_writer, str8_array_fixed(text));
+  coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+
+  // virtual offset of every named symbol, in order
+  U8              *refs      = push_array(scratch.arena, U8, sizeof(U32)*names_count);
+  COFF_ObjSection *refs_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".refs"), PE_RDATA_SECTION_FLAGS, str8(refs, sizeof(U32)*names_count));
+  for EachIndex(i, names_count) {
+    COFF_ObjSymbol *symbol = coff_obj_writer_push_symbol_undef(obj_writer, names[i]);
+    coff_obj_writer_section_push_reloc_voff(obj_writer, refs_sect, i*sizeof(U32), symbol);
+  }
+
+  String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+  B32 is_written = t_write_file(str8_lit("refs.obj"), obj);
+
+  scratch_end(scratch);
+  return is_written;
+}
+
+internal B32
+t_voffs_from_refs(String8 exe_name, String8 refs_name, U32 *voffs, U64 voffs_count)
+{
+  Temp scratch = scratch_begin(0,0);
+  B32 is_read = 0;
+
+  String8             exe           = t_read_file(scratch.arena, exe_name);
+  PE_BinInfo          pe            = pe_bin_info_from_data(scratch.arena, exe);
+  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(exe, pe.section_table_range).str;
+  COFF_SectionHeader *sect          = t_coff_section_header_from_name(exe, section_table, pe.section_count, refs_name);
+  if (sect) {
+    String8 data = str8_substr(exe, rng_1u64(sect->foff, sect->foff + sect->vsize));
+    if (data.size >= sizeof(U32)*voffs_count) {
+      MemoryCopy(voffs, data.str, sizeof(U32)*voffs_count);
+      is_read = 1;
+    }
+  }
+
+  scratch_end(scratch);
+  return is_read;
+}
+
+internal T_Result
+t_icf_fold(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    U8 one[] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 1; ret
+    U8 two[] = { 0xB8, 0x02, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 2; ret
+    t_push_comdat_func(obj_writer, str8_lit("f"), str8_array_fixed(one), 0);
+    t_push_comdat_func(obj_writer, str8_lit("g"), str8_array_fixed(one), 0);
+    t_push_comdat_func(obj_writer, str8_lit("h"), str8_array_fixed(two), 0);
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("a.obj"), obj)) { goto exit; }
+  }
+
+  String8 names[] = { str8_lit("f"), str8_lit("g"), str8_lit("h") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  // identical functions are folded, different ones are kept
+  {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:icf /out:a.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (voffs[0] != voffs[1]) { goto exit; }
+    if (voffs[0] == voffs[2]) { goto exit; }
+  }
+
+  // nothing is folded without /OPT:ICF
+  {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:noicf /out:b.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("b.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (voffs[0] == voffs[1]) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_icf_reloc_target(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    U8 x[] = "x";
+    U8 y[] = "y";
+    COFF_ObjSymbol *x_symbol = coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("x"), 0, t_push_data_section(obj_writer, str8_array_fixed(x)));
+    COFF_ObjSymbol *y_symbol = coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("y"), 0, t_push_data_section(obj_writer, str8_array_fixed(y)));
+
+    // same bytes, but g loads a different address
+    U8 code[] = { 0x48, 0x8D, 0x05, 0x00, 0x00, 0x00, 0x00, 0xC3 }; // lea rax, [rip + sym]; ret
+    COFF_ObjSection *f = t_push_comdat_func(obj_writer, str8_lit("f"), str8_array_fixed(code), 0);
+    COFF_ObjSection *g = t_push_comdat_func(obj_writer, str8_lit("g"), str8_array_fixed(code), 0);
+    COFF_ObjSection *h = t_push_comdat_func(obj_writer, str8_lit("h"), str8_array_fixed(code), 0);
+    coff_obj_writer_section_push_reloc(obj_writer, f, 3, x_symbol, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, g, 3, y_symbol, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, h, 3, x_symbol, COFF_Reloc_X64_Rel32);
+
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("a.obj"), obj)) { goto exit; }
+  }
+
+  String8 names[] = { str8_lit("f"), str8_lit("g"), str8_lit("h") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:icf /out:a.exe refs.obj a.obj");
+  if (linker_exit_code != 0) { goto exit; }
+
+  U32 voffs[ArrayCount(names)];
+  if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+  if (voffs[0] == voffs[1]) { goto exit; }
+  if (voffs[0] != voffs[2]) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_icf_mutual_recursion(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    U8 f_code[] = { 0xE8, 0x00, 0x00, 0x00, 0x00, 0xC3 };       // call g; ret
+    U8 g_code[] = { 0xE8, 0x00, 0x00, 0x00, 0x00, 0x90, 0xC3 }; // call f; nop; ret
+    U8 k_code[] = { 0xB8, 0x02, 0x00, 0x00, 0x00, 0xC3 };       // mov eax, 2; ret
+
+    // fa <-> ga and fb <-> gb are identical cycles
+    COFF_ObjSymbol *fa, *ga, *fb, *gb, *fc, *gc, *k;
+    COFF_ObjSection *fa_sect = t_push_comdat_func(obj_writer, str8_lit("fa"), str8_array_fixed(f_code), &fa);
+    COFF_ObjSection *ga_sect = t_push_comdat_func(obj_writer, str8_lit("ga"), str8_array_fixed(g_code), &ga);
+    COFF_ObjSection *fb_sect = t_push_comdat_func(obj_writer, str8_lit("fb"), str8_array_fixed(f_code), &fb);
+    COFF_ObjSection *gb_sect = t_push_comdat_func(obj_writer, str8_lit("gb"), str8_array_fixed(g_code), &gb);
+    coff_obj_writer_section_push_reloc(obj_writer, fa_sect, 1, ga, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, ga_sect, 1, fa, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, fb_sect, 1, gb, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, gb_sect, 1, fb, COFF_Reloc_X64_Rel32);
+
+    // fc -> gc -> k has the same bytes, but gc calls a different function
+    COFF_ObjSection *fc_sect = t_push_comdat_func(obj_writer, str8_lit("fc"), str8_array_fixed(f_code), &fc);
+    COFF_ObjSection *gc_sect = t_push_comdat_func(obj_writer, str8_lit("gc"), str8_array_fixed(g_code), &gc);
+    t_push_comdat_func(obj_writer, str8_lit("k"), str8_array_fixed(k_code), &k);
+    coff_obj_writer_section_push_reloc(obj_writer, fc_sect, 1, gc, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, gc_sect, 1, k,  COFF_Reloc_X64_Rel32);
+
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("a.obj"), obj)) { goto exit; }
+  }
+
+  String8 names[] = { str8_lit("fa"), str8_lit("ga"), str8_lit("fb"), str8_lit("gb"), str8_lit("fc"), str8_lit("gc") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:icf /out:a.exe refs.obj a.obj");
+  if (linker_exit_code != 0) { goto exit; }
+
+  U32 voffs[ArrayCount(names)];
+  if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+  if (voffs[0] != voffs[2]) { goto exit; }
+  if (voffs[1] != voffs[3]) { goto exit; }
+  if (voffs[0] == voffs[1]) { goto exit; }
+  if (voffs[4] == voffs[0]) { goto exit; }
+  if (voffs[5] == voffs[1]) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_icf_chain(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    U8 e_code[] = { 0xE8, 0x00, 0x00, 0x00, 0x00, 0xC3 };             // call f; ret
+    U8 f_code[] = { 0xE8, 0x00, 0x00, 0x00, 0x00, 0x90, 0xC3 };       // call g; nop; ret
+    U8 g_code[] = { 0xE8, 0x00, 0x00, 0x00, 0x00, 0x90, 0x90, 0xC3 }; // call h; nop; nop; ret
+    U8 one[]    = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 };             // mov eax, 1; ret
+    U8 two[]    = { 0xB8, 0x02, 0x00, 0x00, 0x00, 0xC3 };             // mov eax, 2; ret
+
+    // e1 -> f1 -> g1 -> h1 and e2 -> f2 -> g2 -> h2 differ only at the far end,
+    // it takes three refinement passes for the difference to reach e1 and e2
+    COFF_ObjSymbol *f1, *g1, *h1, *f2, *g2, *h2;
+    t_push_comdat_func(obj_writer, str8_lit("h1"), str8_array_fixed(one), &h1);
+    t_push_comdat_func(obj_writer, str8_lit("h2"), str8_array_fixed(two), &h2);
+    COFF_ObjSection *g1_sect = t_push_comdat_func(obj_writer, str8_lit("g1"), str8_array_fixed(g_code), &g1);
+    COFF_ObjSection *g2_sect = t_push_comdat_func(obj_writer, str8_lit("g2"), str8_array_fixed(g_code), &g2);
+    COFF_ObjSection *f1_sect = t_push_comdat_func(obj_writer, str8_lit("f1"), str8_array_fixed(f_code), &f1);
+    COFF_ObjSection *f2_sect = t_push_comdat_func(obj_writer, str8_lit("f2"), str8_array_fixed(f_code), &f2);
+    COFF_ObjSection *e1_sect = t_push_comdat_func(obj_writer, str8_lit("e1"), str8_array_fixed(e_code), 0);
+    COFF_ObjSection *e2_sect = t_push_comdat_func(obj_writer, str8_lit("e2"), str8_array_fixed(e_code), 0);
+    coff_obj_writer_section_push_reloc(obj_writer, g1_sect, 1, h1, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, g2_sect, 1, h2, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, f1_sect, 1, g1, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, f2_sect, 1, g2, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, e1_sect, 1, f1, COFF_Reloc_X64_Rel32);
+    coff_obj_writer_section_push_reloc(obj_writer, e2_sect, 1, f2, COFF_Reloc_X64_Rel32);
+
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("a.obj"), obj)) { goto exit; }
+  }
+
+  String8 names[] = { str8_lit("e1"), str8_lit("e2"), str8_lit("f1"), str8_lit("f2"), str8_lit("g1"), str8_lit("g2") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  // an iteration count must not cut refinement short and fold the chains
+  char *opts[] = { "/opt:icf", "/opt:icf=1" };
+  for EachElement(opt_idx, opts) {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry %s /out:a.exe refs.obj a.obj", opts[opt_idx]);
+    if (linker_exit_code != 0) { goto exit; }
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (voffs[0] == voffs[1]) { goto exit; }
+    if (voffs[2] == voffs[3]) { goto exit; }
+    if (voffs[4] == voffs[5]) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_icf_comdat_duplicate(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  U8 code[] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 1; ret
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    t_push_comdat_func(obj_writer, str8_lit("f"), str8_array_fixed(code), 0);
+    t_push_comdat_func(obj_writer, str8_lit("g"), str8_array_fixed(code), 0);
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("a.obj"), obj)) { goto exit; }
+  }
+
+  // duplicate of g, referenced from its own obj
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSymbol *g;
+    t_push_comdat_func(obj_writer, str8_lit("g"), str8_array_fixed(code), &g);
+    U8 bref[4] = {0};
+    COFF_ObjSection *bref_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".bref"), PE_RDATA_SECTION_FLAGS, str8_array_fixed(bref));
+    coff_obj_writer_section_push_reloc_voff(obj_writer, bref_sect, 0, g);
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("b.obj"), obj)) { goto exit; }
+  }
+
+  String8 names[] = { str8_lit("f"), str8_lit("g") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:icf /out:a.exe refs.obj a.obj b.obj");
+  if (linker_exit_code != 0) { goto exit; }
+
+  U32 voffs[ArrayCount(names)];
+  U32 bref_voff = 0;
+  if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+  if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".bref"), &bref_voff, 1))           { goto exit; }
+  if (voffs[0] != voffs[1]) { goto exit; }
+  if (bref_voff != voffs[0]) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_icf_associative(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    U8 code[]  = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 1; ret
+    U8 xdata[] = { 0x01, 0x00, 0x00, 0x00 };             // version 1, no unwind codes
+    char *func_names[] = { "f", "g" };
+    for EachIndex(i, ArrayCount(func_names)) {
+      COFF_ObjSymbol  *func_symbol;
+      COFF_ObjSection *func_sect = t_push_comdat_func(obj_writer, str8_cstring(func_names[i]), str8_array_fixed(code), &func_symbol);
+
+      // unwind info and function table entry go with the function
+      COFF_ObjSection *xdata_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".xdata"), PE_RDATA_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align4Bytes, str8_array_fixed(xdata));
+      coff_obj_writer_push_symbol_associative(obj_writer, xdata_sect, func_sect);
+      COFF_ObjSymbol *xdata_symbol = coff_obj_writer_push_symbol_static(obj_writer, str8_lit("$unwind"), 0, xdata_sect);
+
+      PE_IntelPdata *pdata = push_array(scratch.arena, PE_IntelPdata, 1);
+      pdata->voff_one_past_last = sizeof(code);
+      COFF_ObjSection *pdata_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".pdata"), PE_RDATA_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align4Bytes, str8_struct(pdata));
+      coff_obj_writer_push_symbol_associative(obj_writer, pdata_sect, func_sect);
+      coff_obj_writer_section_push_reloc(obj_writer, pdata_sect, OffsetOf(PE_IntelPdata, voff_first),         func_symbol,  COFF_Reloc_X64_Addr32Nb);
+      coff_obj_writer_section_push_reloc(obj_writer, pdata_sect, OffsetOf(PE_IntelPdata, voff_one_past_last), func_symbol,  COFF_Reloc_X64_Addr32Nb);
+      coff_obj_writer_section_push_reloc(obj_writer, pdata_sect, OffsetOf(PE_IntelPdata, voff_unwind_info),   xdata_symbol, COFF_Reloc_X64_Addr32Nb);
+    }
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("a.obj"), obj)) { goto exit; }
+  }
+
+  String8 names[] = { str8_lit("f"), str8_lit("g") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  // .pdata and .xdata of the folded function are removed with it
+  {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:icf /out:a.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    String8    exe = t_read_file(scratch.arena, str8_lit("a.exe"));
+    PE_BinInfo pe  = pe_bin_info_from_data(scratch.arena, exe);
+    if (dim_1u64(pe.data_dir_franges[PE_DataDirectoryIndex_EXCEPTIONS]) != sizeof(PE_IntelPdata)) { goto exit; }
+    String8        pdata_data = str8_substr(exe, pe.data_dir_franges[PE_DataDirectoryIndex_EXCEPTIONS]);
+    PE_IntelPdata *pdata      = (PE_IntelPdata *)pdata_data.str;
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (voffs[0] != voffs[1])         { goto exit; }
+    if (pdata->voff_first != voffs[0]) { goto exit; }
+  }
+
+  {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:noicf /out:b.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    String8    exe = t_read_file(scratch.arena, str8_lit("b.exe"));
+    PE_BinInfo pe  = pe_bin_info_from_data(scratch.arena, exe);
+    if (dim_1u64(pe.data_dir_franges[PE_DataDirectoryIndex_EXCEPTIONS]) != 2*sizeof(PE_IntelPdata)) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal B32
+t_write_order_obj(void)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+
+  // distinct bodies so nothing gets folded
+  U8 f[] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 1; ret
+  U8 g[] = { 0xB8, 0x02, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 2; ret
+  U8 h[] = { 0xB8, 0x03, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 3; ret
+  U8 x[] = { 0xB8, 0x04, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 4; ret
+  U8 n[] = { 0xB8, 0x05, 0x00, 0x00, 0x00, 0xC3 }; // mov eax, 5; ret
+  t_push_comdat_func(obj_writer, str8_lit("f"), str8_array_fixed(f), 0);
+  t_push_comdat_func(obj_writer, str8_lit("g"), str8_array_fixed(g), 0);
+  t_push_comdat_func(obj_writer, str8_lit("h"), str8_array_fixed(h), 0);
+
+  // COMDAT in a later $-group
+  COFF_ObjSection *x_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$x"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align16Bytes, str8_array_fixed(x));
+  coff_obj_writer_push_symbol_secdef(obj_writer, x_sect, COFF_ComdatSelect_Any);
+  coff_obj_writer_push_symbol_extern_func(obj_writer, str8_lit("x"), 0, x_sect);
+
+  // function without COMDAT (compiled without /Gy)
+  COFF_ObjSection *n_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$mn"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8_array_fixed(n));
+  coff_obj_writer_push_symbol_extern_func(obj_writer, str8_lit("n"), 0, n_sect);
+
+  String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+  B32 is_written = t_write_file(str8_lit("a.obj"), obj);
+
+  scratch_end(scratch);
+  return is_written;
+}
+
+internal T_Result
+t_order_file(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  if (!t_write_order_obj()) { goto exit; }
+
+  String8 names[] = { str8_lit("f"), str8_lit("g"), str8_lit("h"), str8_lit("x") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  // without an order file COMDATs keep the input order
+  {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:noicf /out:a.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (!(voffs[0] < voffs[1] && voffs[1] < voffs[2])) { goto exit; }
+  }
+
+  // listed COMDATs follow the file order, but never leave their $-group
+  {
+    if (!t_write_file(str8_lit("order.txt"), str8_lit("x\nh\ng\nf\nn\nmissing\n"))) { goto exit; }
+    String8 output = {0};
+    int linker_exit_code = t_invoke_linker_capturef(scratch.arena, &output, "/subsystem:console /entry:entry /opt:noicf /order:@order.txt /out:b.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("b.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (!(voffs[2] < voffs[1] && voffs[1] < voffs[0])) { goto exit; }
+    if (voffs[3] < voffs[0]) { goto exit; }
+
+    // unknown and non-COMDAT symbols are reported
+    if (str8_find_needle(output, 0, str8_lit("symbol \"missing\" does not exist"), 0) >= output.size) { goto exit; }
+    if (str8_find_needle(output, 0, str8_lit("symbol \"n\" is not in a COMDAT section"), 0) >= output.size) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_order_profile(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  if (!t_write_order_obj()) { goto exit; }
+
+  String8 names[] = { str8_lit("f"), str8_lit("g"), str8_lit("h") };
+  if (!t_write_refs_obj(names, ArrayCount(names))) { goto exit; }
+
+  // hottest functions go first
+  {
+    if (!t_write_file(str8_lit("profile.txt"), str8_lit("# symbol count\nf 10\ng 300\nh 20\n"))) { goto exit; }
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:noicf /rad_order_profile:profile.txt /out:a.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("a.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (!(voffs[1] < voffs[2] && voffs[2] < voffs[0])) { goto exit; }
+  }
+
+  // symbols from /ORDER precede the profile
+  {
+    if (!t_write_file(str8_lit("order.txt"), str8_lit("f\n"))) { goto exit; }
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:noicf /order:@order.txt /rad_order_profile:profile.txt /out:b.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    U32 voffs[ArrayCount(names)];
+    if (!t_voffs_from_refs(str8_lit("b.exe"), str8_lit(".refs"), voffs, ArrayCount(voffs))) { goto exit; }
+    if (!(voffs[0] < voffs[1] && voffs[1] < voffs[2])) { goto exit; }
+  }
+
+  // malformed lines are reported
+  {
+    if (!t_write_file(str8_lit("bad.txt"), str8_lit("g 300\nh\n"))) { goto exit; }
+    String8 output = {0};
+    int linker_exit_code = t_invoke_linker_capturef(scratch.arena, &output, "/subsystem:console /entry:entry /opt:noicf /rad_order_profile:bad.txt /out:c.exe refs.obj a.obj");
+    if (linker_exit_code != 0) { goto exit; }
+    if (str8_find_needle(output, 0, str8_lit("unable to parse \"h\""), 0) >= output.size) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
 internal T_Result
 t_sect_align(void)
 {
@@ -5009,6 +5538,14 @@ entry_point(CmdLine *cmdline)
     { "comdat_associative_out_of_bounds",  t_comdat_associative_out_of_bounds  },
     { "comdat_with_offset",                t_comdat_with_offset                },
     { "reloc_against_removed_comdat",      t_reloc_against_removed_comdat      },
+    { "icf_fold",                          t_icf_fold                          },
+    { "icf_reloc_target",                  t_icf_reloc_target                  },
+    { "icf_mutual_recursion",              t_icf_mutual_recursion              },
+    { "icf_chain",                         t_icf_chain                         },
+    { "icf_comdat_duplicate",              t_icf_comdat_duplicate              },
+    { "icf_associative",                   t_icf_associative                   },
+    { "order_file",                        t_order_file                        },
+    { "order_profile",                     t_order_profile                     },
     { "alt_name",                          t_alt_name                          },
     { "include",                           t_include                           },
     { "communal_var_vs_regular_comdat",    t_communal_var_vs_regular_comdat    },
@@ -0,0 +1,1028 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ Predefined Distributions & Code Tables
+
+global read_only S16 zstd_ll_default_counts[ZSTD_LL_SYMBOL_MAX+1] =
+{
+  4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+  2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+  -1,-1,-1,-1,
+};
+global read_only S16 zstd_ml_default_counts[ZSTD_ML_SYMBOL_MAX+1] =
+{
+  1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,-1,-1,
+  -1,-1,-1,-1,-1,
+};
+global read_only S16 zstd_of_default_counts[] =
+{
+  1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1,-1,-1,-1,-1,-1,
+};
+
+global read_only U32 zstd_ll_base[ZSTD_LL_SYMBOL_MAX+1] =
+{
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512, 1024, 2048, 4096,
+  8192, 16384, 32768, 65536,
+};
+global read_only U8 zstd_ll_extra_bits[ZSTD_LL_SYMBOL_MAX+1] =
+{
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12,
+  13, 14, 15, 16,
+};
+global read_only U32 zstd_ml_base[ZSTD_ML_SYMBOL_MAX+1] =
+{
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+  19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+  35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515, 1027, 2051,
+  4099, 8195, 16387, 32771, 65539,
+};
+global read_only U8 zstd_ml_extra_bits[ZSTD_ML_SYMBOL_MAX+1] =
+{
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+  12, 13, 14, 15, 16,
+};
+
+////////////////////////////////
+//~ Bit Reader Functions
+
+internal B32
+zstd_bit_reader_init(ZSTD_BitReader *br, U8 *data, U64 size)
+{
+  B32 result = 0;
+  MemoryZeroStruct(br);
+
+  // the last byte carries a 1-bit end marker above the first real bit;
+  // a zero last byte means the stream is corrupt
+  if(size != 0 && data[size-1] != 0)
+  {
+    br->data    = data;
+    br->size    = size;
+    br->bit_off = (S64)((size-1)*8 + (31 - clz32(data[size-1])));
+    result = 1;
+  }
+  return result;
+}
+
+internal U64
+zstd_bit_reader_peek(ZSTD_BitReader *br, U64 nb_bits)
+{
+  U64 result = 0;
+  if(nb_bits != 0)
+  {
+    S64 lo = br->bit_off - (S64)nb_bits;
+    if(lo >= 0)
+    {
+      U64 byte_off = (U64)lo >> 3;
+      U64 word = 0;
+      MemoryCopy(&word, br->data + byte_off, Min(8, br->size - byte_off));
+      result = (word >> (lo & 7)) & ((1ull << nb_bits) - 1);
+    }
+    else if(br->bit_off > 0)
+    {
+      U64 word = 0;
+      MemoryCopy(&word, br->data, Min(8, br->size));
+      result = (word & ((1ull << br->bit_off) - 1)) << (U64)(-lo);
+    }
+  }
+  return result;
+}
+
+internal void
+zstd_bit_reader_skip(ZSTD_BitReader *br, U64 nb_bits)
+{
+  br->bit_off -= (S64)nb_bits;
+}
+
+internal U64
+zstd_bit_reader_read(ZSTD_BitReader *br, U64 nb_bits)
+{
+  U64 result = zstd_bit_reader_peek(br, nb_bits);
+  zstd_bit_reader_skip(br, nb_bits);
+  return result;
+}
+
+internal U64
+zstd_forward_bits_from_data(String8 data, U64 bit_off, U64 nb_bits)
+{
+  U64 result = 0;
+  U64 byte_off = bit_off >> 3;
+  if(byte_off < data.size)
+  {
+    U64 word = 0;
+    MemoryCopy(&word, data.str + byte_off, Min(8, data.size - byte_off));
+    result = (word >> (bit_off & 7)) & ((1ull << nb_bits) - 1);
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Entropy Table Functions
+
+internal B32
+zstd_fse_table_from_counts(ZSTD_FSETable *table, S16 *counts, U32 symbol_count, U32 accuracy_log)
+{
+  B32 is_good = 1;
+  U32 table_size = 1u << accuracy_log;
+  U32 table_mask = table_size - 1;
+  U32 high_threshold = table_size;
+  U16 symbol_next[ZSTD_FSE_SYMBOL_COUNT_MAX];
+  table->accuracy_log = accuracy_log;
+
+  // "less than 1" probability symbols take one cell each from the top
+  for(U32 symbol = 0; symbol < symbol_count; symbol += 1)
+  {
+    if(counts[symbol] == -1)
+    {
+      if(high_threshold == 0) { is_good = 0; break; }
+      high_threshold -= 1;
+      table->entries[high_threshold].symbol = (U8)symbol;
+      symbol_next[symbol] = 1;
+    }
+    else
+    {
+      symbol_next[symbol] = (U16)counts[symbol];
+    }
+  }
+
+  // spread the remaining symbols over the low cells
+  if(is_good)
+  {
+    U32 step = (table_size >> 1) + (table_size >> 3) + 3;
+    U32 pos = 0;
+    for(U32 symbol = 0; symbol < symbol_count; symbol += 1)
+    {
+      for(S32 idx = 0; idx < counts[symbol]; idx += 1)
+      {
+        table->entries[pos].symbol = (U8)symbol;
+        do
+        {
+          pos = (pos + step) & table_mask;
+        } while(pos >= high_threshold);
+      }
+    }
+    is_good = (pos == 0);
+  }
+
+  // fill states
+  if(is_good)
+  {
+    for(U32 idx = 0; idx < table_size; idx += 1)
+    {
+      ZSTD_FSEEntry *entry = &table->entries[idx];
+      U32 next_state = symbol_next[entry->symbol];
+      symbol_next[entry->symbol] += 1;
+      U32 nb_bits = accuracy_log - (31 - clz32(next_state));
+      entry->nb_bits  = (U8)nb_bits;
+      entry->baseline = (U16)((next_state << nb_bits) - table_size);
+    }
+  }
+
+  return is_good;
+}
+
+internal U64
+zstd_fse_table_from_data(ZSTD_FSETable *table, String8 data, U32 symbol_max, U32 accuracy_log_max)
+{
+  U64 result = 0;
+  U64 bit_off = 0;
+  S16 counts[ZSTD_FSE_SYMBOL_COUNT_MAX] = {0};
+  U32 symbol_count = 0;
+  U32 accuracy_log = (U32)zstd_forward_bits_from_data(data, bit_off, 4) + 5;
+  bit_off += 4;
+  if(accuracy_log <= accuracy_log_max)
+  {
+    S32 remaining = 1 << accuracy_log;
+    while(remaining > 0 && symbol_count <= symbol_max)
+    {
+      // values use either nb_bits-1 or nb_bits bits, depending on
+      // whether they fall under the threshold
+      U32 nb_bits    = (31 - clz32((U32)remaining + 1)) + 1;
+      U32 val        = (U32)zstd_forward_bits_from_data(data, bit_off, nb_bits);
+      U32 lower_mask = (1u << (nb_bits - 1)) - 1;
+      U32 threshold  = (1u << nb_bits) - 1 - ((U32)remaining + 1);
+      if((val & lower_mask) < threshold)
+      {
+        val &= lower_mask;
+        bit_off += nb_bits - 1;
+      }
+      else
+      {
+        if(val > lower_mask)
+        {
+          val -= threshold;
+        }
+        bit_off += nb_bits;
+      }
+      S32 proba = (S32)val - 1;
+      remaining -= (proba < 0 ? -proba : proba);
+      counts[symbol_count] = (S16)proba;
+      symbol_count += 1;
+
+      // zero probabilities are followed by 2-bit repeat flags
+      if(proba == 0)
+      {
+        for(;;)
+        {
+          U32 repeat = (U32)zstd_forward_bits_from_data(data, bit_off, 2);
+          bit_off += 2;
+          for(U32 idx = 0; idx < repeat && symbol_count <= symbol_max; idx += 1)
+          {
+            counts[symbol_count] = 0;
+            symbol_count += 1;
+          }
+          if(repeat != 3 || bit_off > data.size*8)
+          {
+            break;
+          }
+        }
+      }
+    }
+    if(remaining == 0 && bit_off <= data.size*8 &&
+       zstd_fse_table_from_counts(table, counts, symbol_count, accuracy_log))
+    {
+      result = (bit_off + 7) / 8;
+    }
+  }
+  return result;
+}
+
+internal void
+zstd_fse_table_from_rle(ZSTD_FSETable *table, U8 symbol)
+{
+  table->accuracy_log = 0;
+  table->entries[0].baseline = 0;
+  table->entries[0].symbol   = symbol;
+  table->entries[0].nb_bits  = 0;
+}
+
+internal U64
+zstd_huf_table_from_data(ZSTD_HufTable *table, String8 data)
+{
+  U64 result = 0;
+  B32 is_good = (data.size != 0);
+  U8 weights[ZSTD_HUF_SYMBOL_MAX+1] = {0};
+  U32 weight_count = 0;
+
+  //- read weights
+  if(is_good)
+  {
+    U8 header = data.str[0];
+
+    // direct representation: 4 bits per weight
+    if(header >= 128)
+    {
+      weight_count = header - 127;
+      U64 size = (weight_count + 1) / 2;
+      if(1 + size <= data.size)
+      {
+        for(U32 idx = 0; idx < weight_count; idx += 1)
+        {
+          U8 byte = data.str[1 + idx/2];
+          weights[idx] = (idx & 1) ? (byte & 0xf) : (byte >> 4);
+        }
+        result = 1 + size;
+      }
+      else
+      {
+        is_good = 0;
+      }
+    }
+
+    // FSE-compressed weights, two interleaved states sharing one stream
+    else if(1 + (U64)header <= data.size)
+    {
+      String8 fse_data = str8(data.str + 1, header);
+      ZSTD_FSETable fse_table;
+      U64 fse_table_size = zstd_fse_table_from_data(&fse_table, fse_data, ZSTD_HUF_BITS_MAX, ZSTD_HUF_WEIGHT_ACCURACY_LOG_MAX);
+      ZSTD_BitReader br = {0};
+      is_good = (fse_table_size != 0 && zstd_bit_reader_init(&br, fse_data.str + fse_table_size, fse_data.size - fse_table_size));
+      if(is_good)
+      {
+        U32 accuracy_log = fse_table.accuracy_log;
+        U32 states[2];
+        states[0] = (U32)zstd_bit_reader_read(&br, accuracy_log);
+        states[1] = (U32)zstd_bit_reader_read(&br, accuracy_log);
+        for(U32 state_idx = 0;; state_idx ^= 1)
+        {
+          ZSTD_FSEEntry *entry = &fse_table.entries[states[state_idx]];
+          if(weight_count >= ZSTD_HUF_SYMBOL_MAX) { is_good = 0; break; }
+          weights[weight_count] = entry->symbol;
+          weight_count += 1;
+          states[state_idx] = entry->baseline + (U32)zstd_bit_reader_read(&br, entry->nb_bits);
+
+          // once the stream is overrun, the other state emits its last weight
+          if(br.bit_off < 0)
+          {
+            if(weight_count >= ZSTD_HUF_SYMBOL_MAX) { is_good = 0; break; }
+            weights[weight_count] = fse_table.entries[states[state_idx^1]].symbol;
+            weight_count += 1;
+            break;
+          }
+        }
+        result = 1 + header;
+      }
+    }
+    else
+    {
+      is_good = 0;
+    }
+  }
+
+  //- derive the last, implied weight & the max code length
+  U32 max_bits = 0;
+  if(is_good)
+  {
+    U32 weight_sum = 0;
+    for(U32 idx = 0; idx < weight_count; idx += 1)
+    {
+      if(weights[idx] > ZSTD_HUF_BITS_MAX) { is_good = 0; break; }
+      if(weights[idx] != 0)
+      {
+        weight_sum += 1u << (weights[idx] - 1);
+      }
+    }
+    if(is_good && weight_sum != 0)
+    {
+      max_bits = (31 - clz32(weight_sum)) + 1;
+      U32 left_over = (1u << max_bits) - weight_sum;
+      if(max_bits <= ZSTD_HUF_BITS_MAX && IsPow2OrZero(left_over) && left_over != 0)
+      {
+        weights[weight_count] = (U8)((31 - clz32(left_over)) + 1);
+        weight_count += 1;
+      }
+      else
+      {
+        is_good = 0;
+      }
+    }
+    else
+    {
+      is_good = 0;
+    }
+  }
+
+  //- fill decoding table - longest codes take the lowest prefixes
+  if(is_good)
+  {
+    U8 nb_bits[ZSTD_HUF_SYMBOL_MAX+1];
+    U32 rank_count[ZSTD_HUF_BITS_MAX+1] = {0};
+    U32 rank_idx[ZSTD_HUF_BITS_MAX+1] = {0};
+    for(U32 symbol = 0; symbol < weight_count; symbol += 1)
+    {
+      nb_bits[symbol] = weights[symbol] ? (U8)(max_bits + 1 - weights[symbol]) : 0;
+      rank_count[nb_bits[symbol]] += 1;
+    }
+    rank_idx[max_bits] = 0;
+    for(U32 bits = max_bits; bits >= 1; bits -= 1)
+    {
+      rank_idx[bits-1] = rank_idx[bits] + rank_count[bits] * (1u << (max_bits - bits));
+    }
+    for(U32 symbol = 0; symbol < weight_count; symbol += 1)
+    {
+      if(nb_bits[symbol] != 0)
+      {
+        U32 code = rank_idx[nb_bits[symbol]];
+        U32 len  = 1u << (max_bits - nb_bits[symbol]);
+        for(U32 idx = 0; idx < len; idx += 1)
+        {
+          table->entries[code + idx].symbol  = (U8)symbol;
+          table->entries[code + idx].nb_bits = nb_bits[symbol];
+        }
+        rank_idx[nb_bits[symbol]] += len;
+      }
+    }
+    table->max_bits = max_bits;
+  }
+
+  if(!is_good)
+  {
+    result = 0;
+  }
+  return result;
+}
+
+internal B32
+zstd_huf_decode_stream(ZSTD_HufTable *table, String8 data, U8 *dst, U64 dst_size)
+{
+  B32 result = 0;
+  ZSTD_BitReader br = {0};
+  if(zstd_bit_reader_init(&br, data.str, data.size))
+  {
+    U32 max_bits = table->max_bits;
+    for(U64 idx = 0; idx < dst_size; idx += 1)
+    {
+      ZSTD_HufEntry *entry = &table->entries[zstd_bit_reader_peek(&br, max_bits)];
+      dst[idx] = entry->symbol;
+      zstd_bit_reader_skip(&br, entry->nb_bits);
+    }
+
+    // a well-formed stream is consumed exactly
+    result = (br.bit_off == 0);
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Decoding Functions
+
+internal U64
+zstd_decode_literals(ZSTD_Decoder *d, String8 data, U8 **literals_out, U64 *literals_size_out)
+{
+  U64 result = 0;
+  if(data.size != 0)
+  {
+    U8 b0 = data.str[0];
+    ZSTD_LiteralsBlockKind kind = (ZSTD_LiteralsBlockKind)(b0 & 3);
+    U32 size_format = (b0 >> 2) & 3;
+    switch(kind)
+    {
+      //- raw / RLE literals
+      case ZSTD_LiteralsBlockKind_Raw:
+      case ZSTD_LiteralsBlockKind_RLE:
+      {
+        U64 header_size = 0;
+        U64 regen_size = 0;
+        switch(size_format)
+        {
+          case 0: case 2: {header_size = 1; regen_size = b0 >> 3;}break;
+          case 1:
+          {
+            header_size = 2;
+            if(data.size >= 2) { regen_size = (b0 >> 4) + ((U64)data.str[1] << 4); }
+          }break;
+          case 3:
+          {
+            header_size = 3;
+            if(data.size >= 3) { regen_size = (b0 >> 4) + ((U64)data.str[1] << 4) + ((U64)data.str[2] << 12); }
+          }break;
+        }
+        if(regen_size > ZSTD_BLOCK_SIZE_MAX)
+        {
+          break;
+        }
+        if(kind == ZSTD_LiteralsBlockKind_Raw && header_size + regen_size <= data.size)
+        {
+          *literals_out = data.str + header_size;
+          *literals_size_out = regen_size;
+          result = header_size + regen_size;
+        }
+        else if(kind == ZSTD_LiteralsBlockKind_RLE && header_size + 1 <= data.size)
+        {
+          MemorySet(d->literals, data.str[header_size], regen_size);
+          *literals_out = d->literals;
+          *literals_size_out = regen_size;
+          result = header_size + 1;
+        }
+      }break;
+
+      //- huffman-coded literals
+      case ZSTD_LiteralsBlockKind_Compressed:
+      case ZSTD_LiteralsBlockKind_Treeless:
+      {
+        U64 header_size = 0;
+        U64 regen_size = 0;
+        U64 comp_size = 0;
+        U64 stream_count = (size_format == 0) ? 1 : 4;
+        U64 header = 0;
+        switch(size_format)
+        {
+          case 0: case 1: {header_size = 3;}break;
+          case 2:         {header_size = 4;}break;
+          case 3:         {header_size = 5;}break;
+        }
+        if(header_size > data.size)
+        {
+          break;
+        }
+        MemoryCopy(&header, data.str, header_size);
+        switch(size_format)
+        {
+          case 0: case 1: {regen_size = (header >> 4) & 0x3ff;   comp_size = (header >> 14) & 0x3ff;}break;
+          case 2:         {regen_size = (header >> 4) & 0x3fff;  comp_size = (header >> 18) & 0x3fff;}break;
+          case 3:         {regen_size = (header >> 4) & 0x3ffff; comp_size = (header >> 22) & 0x3ffff;}break;
+        }
+        if(regen_size > ZSTD_BLOCK_SIZE_MAX || header_size + comp_size > data.size)
+        {
+          break;
+        }
+        String8 comp_data = str8(data.str + header_size, comp_size);
+
+        // read the tree, or reuse the previous block's
+        if(kind == ZSTD_LiteralsBlockKind_Compressed)
+        {
+          U64 table_size = zstd_huf_table_from_data(&d->huf_table, comp_data);
+          d->huf_table_is_valid = (table_size != 0);
+          comp_data = str8_skip(comp_data, table_size);
+        }
+        if(!d->huf_table_is_valid)
+        {
+          break;
+        }
+
+        // decode streams
+        B32 is_good = 1;
+        if(stream_count == 1)
+        {
+          is_good = zstd_huf_decode_stream(&d->huf_table, comp_data, d->literals, regen_size);
+        }
+        else if(comp_data.size >= 6)
+        {
+          U64 stream_sizes[4];
+          stream_sizes[0] = (U64)comp_data.str[0] | ((U64)comp_data.str[1] << 8);
+          stream_sizes[1] = (U64)comp_data.str[2] | ((U64)comp_data.str[3] << 8);
+          stream_sizes[2] = (U64)comp_data.str[4] | ((U64)comp_data.str[5] << 8);
+          U64 streams_size = comp_data.size - 6;
+          U64 segment_size = (regen_size + 3) / 4;
+          if(stream_sizes[0] + stream_sizes[1] + stream_sizes[2] > streams_size || segment_size*3 > regen_size)
+          {
+            is_good = 0;
+          }
+          else
+          {
+            stream_sizes[3] = streams_size - (stream_sizes[0] + stream_sizes[1] + stream_sizes[2]);
+            U64 src_off = 6;
+            U64 dst_off = 0;
+            for(U64 idx = 0; idx < 4 && is_good; idx += 1)
+            {
+              U64 dst_size = (idx < 3) ? segment_size : regen_size - segment_size*3;
+              is_good = zstd_huf_decode_stream(&d->huf_table, str8(comp_data.str + src_off, stream_sizes[idx]), d->literals + dst_off, dst_size);
+              src_off += stream_sizes[idx];
+              dst_off += dst_size;
+            }
+          }
+        }
+        else
+        {
+          is_good = 0;
+        }
+        if(is_good)
+        {
+          *literals_out = d->literals;
+          *literals_size_out = regen_size;
+          result = header_size + comp_size;
+        }
+      }break;
+    }
+  }
+  return result;
+}
+
+internal B32
+zstd_decode_sequences(ZSTD_Decoder *d, String8 data, U8 *literals, U64 literals_size)
+{
+  B32 is_good = (data.size != 0);
+  U64 off = 0;
+
+  //- read sequence count
+  U64 seq_count = 0;
+  if(is_good)
+  {
+    U8 b0 = data.str[0];
+    if(b0 < 128)
+    {
+      seq_count = b0;
+      off = 1;
+    }
+    else if(b0 < 255 && data.size >= 2)
+    {
+      seq_count = ((U64)(b0 - 128) << 8) + data.str[1];
+      off = 2;
+    }
+    else if(b0 == 255 && data.size >= 3)
+    {
+      seq_count = (U64)data.str[1] + ((U64)data.str[2] << 8) + 0x7f00;
+      off = 3;
+    }
+    else
+    {
+      is_good = 0;
+    }
+  }
+
+  //- read the three symbol compression modes & their tables
+  ZSTD_BitReader br = {0};
+  if(is_good && seq_count != 0)
+  {
+    U8 modes = (off < data.size) ? data.str[off] : 0xff;
+    off += 1;
+    is_good = ((modes & 3) == 0);
+    struct
+    {
+      ZSTD_SeqMode mode;
+      ZSTD_FSETable *table;
+      B32 *table_is_valid;
+      S16 *default_counts;
+      U32 default_symbol_count;
+      U32 default_accuracy_log;
+      U32 symbol_max;
+      U32 accuracy_log_max;
+    }
+    tables[] =
+    {
+      {(ZSTD_SeqMode)((modes >> 6) & 3), &d->ll_table, &d->ll_table_is_valid, zstd_ll_default_counts, ArrayCount(zstd_ll_default_counts), 6, ZSTD_LL_SYMBOL_MAX, ZSTD_LL_ACCURACY_LOG_MAX},
+      {(ZSTD_SeqMode)((modes >> 4) & 3), &d->of_table, &d->of_table_is_valid, zstd_of_default_counts, ArrayCount(zstd_of_default_counts), 5, ZSTD_OF_SYMBOL_MAX, ZSTD_OF_ACCURACY_LOG_MAX},
+      {(ZSTD_SeqMode)((modes >> 2) & 3), &d->ml_table, &d->ml_table_is_valid, zstd_ml_default_counts, ArrayCount(zstd_ml_default_counts), 6, ZSTD_ML_SYMBOL_MAX, ZSTD_ML_ACCURACY_LOG_MAX},
+    };
+    for EachElement(idx, tables)
+    {
+      if(!is_good)
+      {
+        break;
+      }
+      switch(tables[idx].mode)
+      {
+        case ZSTD_SeqMode_Predefined:
+        {
+          is_good = zstd_fse_table_from_counts(tables[idx].table, tables[idx].default_counts, tables[idx].default_symbol_count, tables[idx].default_accuracy_log);
+        }break;
+        case ZSTD_SeqMode_RLE:
+        {
+          is_good = (off < data.size && data.str[off] <= tables[idx].symbol_max);
+          if(is_good)
+          {
+            zstd_fse_table_from_rle(tables[idx].table, data.str[off]);
+            off += 1;
+          }
+        }break;
+        case ZSTD_SeqMode_FSE:
+        {
+          U64 table_size = zstd_fse_table_from_data(tables[idx].table, str8_skip(data, off), tables[idx].symbol_max, tables[idx].accuracy_log_max);
+          is_good = (table_size != 0);
+          off += table_size;
+        }break;
+        case ZSTD_SeqMode_Repeat:
+        {
+          is_good = *tables[idx].table_is_valid;
+        }break;
+      }
+      *tables[idx].table_is_valid = is_good;
+    }
+    if(is_good)
+    {
+      is_good = (off < data.size && zstd_bit_reader_init(&br, data.str + off, data.size - off));
+    }
+  }
+
+  //- decode & execute sequences
+  U8 *dst = d->dst_base;
+  U8 *lit_ptr = literals;
+  U8 *lit_opl = literals + literals_size;
+  if(is_good && seq_count != 0)
+  {
+    U32 ll_state = (U32)zstd_bit_reader_read(&br, d->ll_table.accuracy_log);
+    U32 of_state = (U32)zstd_bit_reader_read(&br, d->of_table.accuracy_log);
+    U32 ml_state = (U32)zstd_bit_reader_read(&br, d->ml_table.accuracy_log);
+    for(U64 seq_idx = 0; seq_idx < seq_count; seq_idx += 1)
+    {
+      ZSTD_FSEEntry *ll_entry = &d->ll_table.entries[ll_state];
+      ZSTD_FSEEntry *of_entry = &d->of_table.entries[of_state];
+      ZSTD_FSEEntry *ml_entry = &d->ml_table.entries[ml_state];
+
+      // extra bits are read offset -> match length -> literal length
+      U32 of_code = of_entry->symbol;
+      U32 ml_code = ml_entry->symbol;
+      U32 ll_code = ll_entry->symbol;
+      U64 offset_value = (1ull << of_code) + zstd_bit_reader_read(&br, of_code);
+      U64 ml = zstd_ml_base[ml_code] + zstd_bit_reader_read(&br, zstd_ml_extra_bits[ml_code]);
+      U64 ll = zstd_ll_base[ll_code] + zstd_bit_reader_read(&br, zstd_ll_extra_bits[ll_code]);
+
+      // resolve repeat offsets
+      U64 offset = 0;
+      if(offset_value > ZSTD_REP_COUNT)
+      {
+        offset = offset_value - ZSTD_REP_COUNT;
+        d->rep[2] = d->rep[1];
+        d->rep[1] = d->rep[0];
+        d->rep[0] = offset;
+      }
+      else
+      {
+        U64 rep_idx = offset_value - 1 + (ll == 0);
+        if(rep_idx == 0)
+        {
+          offset = d->rep[0];
+        }
+        else
+        {
+          offset = (rep_idx == 3) ? d->rep[0] - 1 : d->rep[rep_idx];
+          if(rep_idx > 1)
+          {
+            d->rep[2] = d->rep[1];
+          }
+          d->rep[1] = d->rep[0];
+          d->rep[0] = offset;
+        }
+      }
+
+      // update states (literal length -> match length -> offset)
+      if(seq_idx + 1 < seq_count)
+      {
+        ll_state = ll_entry->baseline + (U32)zstd_bit_reader_read(&br, ll_entry->nb_bits);
+        ml_state = ml_entry->baseline + (U32)zstd_bit_reader_read(&br, ml_entry->nb_bits);
+        of_state = of_entry->baseline + (U32)zstd_bit_reader_read(&br, of_entry->nb_bits);
+      }
+
+      // execute - copy literals, then the match; matches may overlap
+      // their own output, and may not reach back before this frame
+      if(ll > (U64)(lit_opl - lit_ptr) ||
+         ll + ml > d->dst_cap - d->dst_off ||
+         offset == 0 || offset > d->dst_off + ll - d->frame_dst_off)
+      {
+        is_good = 0;
+        break;
+      }
+      MemoryCopy(dst + d->dst_off, lit_ptr, ll);
+      lit_ptr += ll;
+      d->dst_off += ll;
+      U8 *match_dst = dst + d->dst_off;
+      U8 *match_src = match_dst - offset;
+      if(offset >= ml)
+      {
+        MemoryCopy(match_dst, match_src, ml);
+      }
+      else
+      {
+        for(U64 idx = 0; idx < ml; idx += 1)
+        {
+          match_dst[idx] = match_src[idx];
+        }
+      }
+      d->dst_off += ml;
+    }
+    if(is_good)
+    {
+      is_good = (br.bit_off == 0);
+    }
+  }
+
+  //- copy trailing literals
+  if(is_good)
+  {
+    U64 size = (U64)(lit_opl - lit_ptr);
+    if(size <= d->dst_cap - d->dst_off)
+    {
+      MemoryCopy(dst + d->dst_off, lit_ptr, size);
+      d->dst_off += size;
+    }
+    else
+    {
+      is_good = 0;
+    }
+  }
+
+  return is_good;
+}
+
+internal U64
+zstd_decode_frame(ZSTD_Decoder *d, String8 data)
+{
+  U64 result = 0;
+  U64 dst_size = 0;
+  B32 has_checksum = 0;
+  U64 off = zstd_frame_header_size_from_data(data, &dst_size, &has_checksum);
+  B32 is_good = (off != 0);
+
+  //- reset per-frame state
+  d->frame_dst_off = d->dst_off;
+  d->rep[0] = 1;
+  d->rep[1] = 4;
+  d->rep[2] = 8;
+  d->huf_table_is_valid = 0;
+  d->ll_table_is_valid = 0;
+  d->of_table_is_valid = 0;
+  d->ml_table_is_valid = 0;
+
+  //- decode blocks
+  for(B32 is_last = 0; is_good && !is_last;)
+  {
+    if(off + 3 > data.size)
+    {
+      is_good = 0;
+      break;
+    }
+    U32 block_header = (U32)data.str[off] | ((U32)data.str[off+1] << 8) | ((U32)data.str[off+2] << 16);
+    off += 3;
+    is_last = (block_header & 1);
+    ZSTD_BlockKind kind = (ZSTD_BlockKind)((block_header >> 1) & 3);
+    U64 block_size = block_header >> 3;
+    switch(kind)
+    {
+      case ZSTD_BlockKind_Raw:
+      {
+        is_good = (off + block_size <= data.size && block_size <= d->dst_cap - d->dst_off);
+        if(is_good)
+        {
+          MemoryCopy(d->dst_base + d->dst_off, data.str + off, block_size);
+          d->dst_off += block_size;
+          off += block_size;
+        }
+      }break;
+      case ZSTD_BlockKind_RLE:
+      {
+        is_good = (off + 1 <= data.size && block_size <= d->dst_cap - d->dst_off);
+        if(is_good)
+        {
+          MemorySet(d->dst_base + d->dst_off, data.str[off], block_size);
+          d->dst_off += block_size;
+          off += 1;
+        }
+      }break;
+      case ZSTD_BlockKind_Compressed:
+      {
+        is_good = (off + block_size <= data.size && block_size <= ZSTD_BLOCK_SIZE_MAX);
+        if(is_good)
+        {
+          String8 block = str8(data.str + off, block_size);
+          U8 *literals = 0;
+          U64 literals_size = 0;
+          U64 literals_section_size = zstd_decode_literals(d, block, &literals, &literals_size);
+          is_good = (literals_section_size != 0 &&
+                     zstd_decode_sequences(d, str8_skip(block, literals_section_size), literals, literals_size));
+          off += block_size;
+        }
+      }break;
+      case ZSTD_BlockKind_Reserved:
+      {
+        is_good = 0;
+      }break;
+    }
+  }
+
+  //- skip content checksum (not verified)
+  if(is_good && has_checksum)
+  {
+    is_good = (off + 4 <= data.size);
+    off += 4;
+  }
+
+  //- check output against the declared content size
+  if(is_good && dst_size != max_U64)
+  {
+    is_good = (d->dst_off - d->frame_dst_off == dst_size);
+  }
+
+  if(is_good)
+  {
+    result = off;
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Top-Level API
+
+internal U64
+zstd_frame_header_size_from_data(String8 data, U64 *dst_size_out, B32 *has_checksum_out)
+{
+  U64 result = 0;
+  U32 magic = 0;
+  if(data.size >= 5)
+  {
+    MemoryCopy(&magic, data.str, sizeof(magic));
+  }
+  if(magic == ZSTD_MAGIC)
+  {
+    U8 descriptor = data.str[4];
+    U32 fcs_flag          = descriptor >> 6;
+    B32 is_single_segment = (descriptor >> 5) & 1;
+    B32 is_reserved_set   = (descriptor >> 3) & 1;
+    B32 has_checksum      = (descriptor >> 2) & 1;
+    U32 dict_id_flag      = descriptor & 3;
+    local_persist U8 dict_id_sizes[] = {0, 1, 2, 4};
+    U64 dict_id_size = dict_id_sizes[dict_id_flag];
+    U64 fcs_size = (fcs_flag == 0) ? (is_single_segment ? 1 : 0) : (1ull << fcs_flag);
+    U64 off = 5 + (is_single_segment ? 0 : 1);
+    U64 dict_id = 0;
+    U64 fcs = 0;
+    if(!is_reserved_set && off + dict_id_size + fcs_size <= data.size)
+    {
+      MemoryCopy(&dict_id, data.str + off, dict_id_size);
+      off += dict_id_size;
+      MemoryCopy(&fcs, data.str + off, fcs_size);
+      off += fcs_size;
+      if(fcs_size == 2)
+      {
+        fcs += 256;
+      }
+
+      // dictionaries are not supported
+      if(dict_id == 0)
+      {
+        *dst_size_out = (fcs_size != 0) ? fcs : max_U64;
+        *has_checksum_out = has_checksum;
+        result = off;
+      }
+    }
+  }
+  return result;
+}
+
+internal ZSTD_FrameArray
+zstd_frame_array_from_data(Arena *arena, String8 data)
+{
+  // walk block headers without decoding, first to count frames, then to
+  // fill them in. stops at the first malformed frame.
+  ZSTD_FrameArray frames = {0};
+  for(U64 pass = 0; pass < 2; pass += 1)
+  {
+    U64 frame_count = 0;
+    for(U64 off = 0; off + 4 <= data.size;)
+    {
+      U32 magic = 0;
+      MemoryCopy(&magic, data.str + off, sizeof(magic));
+      if(ZSTD_SKIPPABLE_MAGIC_MIN <= magic && magic <= ZSTD_SKIPPABLE_MAGIC_MAX)
+      {
+        U32 skip_size = 0;
+        if(off + 8 > data.size) { break; }
+        MemoryCopy(&skip_size, data.str + off + 4, sizeof(skip_size));
+        off += 8 + skip_size;
+        continue;
+      }
+      U64 dst_size = 0;
+      B32 has_checksum = 0;
+      U64 header_size = zstd_frame_header_size_from_data(str8_skip(data, off), &dst_size, &has_checksum);
+      if(header_size == 0)
+      {
+        break;
+      }
+      B32 is_good = 1;
+      U64 cursor = off + header_size;
+      for(B32 is_last = 0; !is_last;)
+      {
+        if(cursor + 3 > data.size)
+        {
+          is_good = 0;
+          break;
+        }
+        U32 block_header = (U32)data.str[cursor] | ((U32)data.str[cursor+1] << 8) | ((U32)data.str[cursor+2] << 16);
+        ZSTD_BlockKind kind = (ZSTD_BlockKind)((block_header >> 1) & 3);
+        is_last = (block_header & 1);
+        cursor += 3 + ((kind == ZSTD_BlockKind_RLE) ? 1 : (block_header >> 3));
+        if(kind == ZSTD_BlockKind_Reserved)
+        {
+          is_good = 0;
+          break;
+        }
+      }
+      cursor += has_checksum ? 4 : 0;
+      if(!is_good || cursor > data.size)
+      {
+        break;
+      }
+      if(pass == 1)
+      {
+        frames.v[frame_count].src_range = r1u64(off, cursor);
+        frames.v[frame_count].dst_size  = dst_size;
+      }
+      frame_count += 1;
+      off = cursor;
+    }
+    if(pass == 0)
+    {
+      frames.count = frame_count;
+      frames.v = push_array(arena, ZSTD_Frame, frames.count);
+    }
+  }
+  return frames;
+}
+
+internal U64
+zstd_decompress(void *dst, U64 dst_cap, void *src, U64 src_size)
+{
+  Temp scratch = scratch_begin(0, 0);
+  ZSTD_Decoder *d = push_array_no_zero(scratch.arena, ZSTD_Decoder, 1);
+  d->dst_base = (U8 *)dst;
+  d->dst_cap  = dst_cap;
+  d->dst_off  = 0;
+  String8 data = str8((U8 *)src, src_size);
+  for(U64 off = 0; off + 4 <= data.size;)
+  {
+    U32 magic = 0;
+    MemoryCopy(&magic, data.str + off, sizeof(magic));
+    if(ZSTD_SKIPPABLE_MAGIC_MIN <= magic && magic <= ZSTD_SKIPPABLE_MAGIC_MAX)
+    {
+      U32 skip_size = 0;
+      if(off + 8 > data.size) { break; }
+      MemoryCopy(&skip_size, data.str + off + 4, sizeof(skip_size));
+      off += 8 + skip_size;
+      continue;
+    }
+    U64 frame_size = zstd_decode_frame(d, str8_skip(data, off));
+    if(frame_size == 0)
+    {
+      break;
+    }
+    off += frame_size;
+  }
+  U64 result = d->dst_off;
+  scratch_end(scratch);
+  return result;
+}
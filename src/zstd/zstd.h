@@ -0,0 +1,164 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef ZSTD_H
+#define ZSTD_H
+
+////////////////////////////////
+//~ Format Constants (RFC 8878)
+
+#define ZSTD_MAGIC                  0xFD2FB528u
+#define ZSTD_SKIPPABLE_MAGIC_MIN    0x184D2A50u
+#define ZSTD_SKIPPABLE_MAGIC_MAX    0x184D2A5Fu
+#define ZSTD_BLOCK_SIZE_MAX         (1u << 17)
+#define ZSTD_REP_COUNT              3
+
+#define ZSTD_LL_SYMBOL_MAX          35
+#define ZSTD_ML_SYMBOL_MAX          52
+#define ZSTD_OF_SYMBOL_MAX          31
+#define ZSTD_LL_ACCURACY_LOG_MAX    9
+#define ZSTD_ML_ACCURACY_LOG_MAX    9
+#define ZSTD_OF_ACCURACY_LOG_MAX    8
+#define ZSTD_HUF_WEIGHT_ACCURACY_LOG_MAX 6
+#define ZSTD_HUF_SYMBOL_MAX         255
+#define ZSTD_HUF_BITS_MAX           11
+#define ZSTD_FSE_SYMBOL_COUNT_MAX   256
+
+typedef enum ZSTD_BlockKind
+{
+  ZSTD_BlockKind_Raw,
+  ZSTD_BlockKind_RLE,
+  ZSTD_BlockKind_Compressed,
+  ZSTD_BlockKind_Reserved,
+}
+ZSTD_BlockKind;
+
+typedef enum ZSTD_LiteralsBlockKind
+{
+  ZSTD_LiteralsBlockKind_Raw,
+  ZSTD_LiteralsBlockKind_RLE,
+  ZSTD_LiteralsBlockKind_Compressed,
+  ZSTD_LiteralsBlockKind_Treeless,
+}
+ZSTD_LiteralsBlockKind;
+
+typedef enum ZSTD_SeqMode
+{
+  ZSTD_SeqMode_Predefined,
+  ZSTD_SeqMode_RLE,
+  ZSTD_SeqMode_FSE,
+  ZSTD_SeqMode_Repeat,
+}
+ZSTD_SeqMode;
+
+////////////////////////////////
+//~ Frame Info Types
+
+typedef struct ZSTD_Frame ZSTD_Frame;
+struct ZSTD_Frame
+{
+  Rng1U64 src_range;
+  U64 dst_size; // max_U64 if the frame header doesn't store the content size
+};
+
+typedef struct ZSTD_FrameArray ZSTD_FrameArray;
+struct ZSTD_FrameArray
+{
+  ZSTD_Frame *v;
+  U64 count;
+};
+
+////////////////////////////////
+//~ Decoder Types
+
+typedef struct ZSTD_FSEEntry ZSTD_FSEEntry;
+struct ZSTD_FSEEntry
+{
+  U16 baseline;
+  U8 symbol;
+  U8 nb_bits;
+};
+
+typedef struct ZSTD_FSETable ZSTD_FSETable;
+struct ZSTD_FSETable
+{
+  U32 accuracy_log;
+  ZSTD_FSEEntry entries[1 << ZSTD_LL_ACCURACY_LOG_MAX];
+};
+
+typedef struct ZSTD_HufEntry ZSTD_HufEntry;
+struct ZSTD_HufEntry
+{
+  U8 symbol;
+  U8 nb_bits;
+};
+
+typedef struct ZSTD_HufTable ZSTD_HufTable;
+struct ZSTD_HufTable
+{
+  U32 max_bits;
+  ZSTD_HufEntry entries[1 << ZSTD_HUF_BITS_MAX];
+};
+
+// bits are consumed from the end of the stream towards its start; reads
+// past the start yield zeros, which the format relies on for its final states
+typedef struct ZSTD_BitReader ZSTD_BitReader;
+struct ZSTD_BitReader
+{
+  U8 *data;
+  U64 size;
+  S64 bit_off;
+};
+
+typedef struct ZSTD_Decoder ZSTD_Decoder;
+struct ZSTD_Decoder
+{
+  U8 *dst_base;
+  U64 dst_off;
+  U64 dst_cap;
+  U64 frame_dst_off;
+  U64 rep[ZSTD_REP_COUNT];
+  B32 huf_table_is_valid;
+  B32 ll_table_is_valid;
+  B32 of_table_is_valid;
+  B32 ml_table_is_valid;
+  ZSTD_HufTable huf_table;
+  ZSTD_FSETable ll_table;
+  ZSTD_FSETable of_table;
+  ZSTD_FSETable ml_table;
+  U8 literals[ZSTD_BLOCK_SIZE_MAX];
+};
+
+////////////////////////////////
+//~ Bit Reader Functions
+
+internal B32 zstd_bit_reader_init(ZSTD_BitReader *br, U8 *data, U64 size);
+internal U64 zstd_bit_reader_peek(ZSTD_BitReader *br, U64 nb_bits);
+internal void zstd_bit_reader_skip(ZSTD_BitReader *br, U64 nb_bits);
+internal U64 zstd_bit_reader_read(ZSTD_BitReader *br, U64 nb_bits);
+internal U64 zstd_forward_bits_from_data(String8 data, U64 bit_off, U64 nb_bits);
+
+////////////////////////////////
+//~ Entropy Table Functions
+
+internal B32 zstd_fse_table_from_counts(ZSTD_FSETable *table, S16 *counts, U32 symbol_count, U32 accuracy_log);
+internal U64 zstd_fse_table_from_data(ZSTD_FSETable *table, String8 data, U32 symbol_max, U32 accuracy_log_max);
+internal void zstd_fse_table_from_rle(ZSTD_FSETable *table, U8 symbol);
+internal U64 zstd_huf_table_from_data(ZSTD_HufTable *table, String8 data);
+internal B32 zstd_huf_decode_stream(ZSTD_HufTable *table, String8 data, U8 *dst, U64 dst_size);
+
+////////////////////////////////
+//~ Decoding Functions
+
+internal U64 zstd_decode_literals(ZSTD_Decoder *d, String8 data, U8 **literals_out, U64 *literals_size_out);
+internal B32 zstd_decode_sequences(ZSTD_Decoder *d, String8 data, U8 *literals, U64 literals_size);
+internal U64 zstd_decode_frame(ZSTD_Decoder *d, String8 data);
+
+////////////////////////////////
+//~ Top-Level API
+
+internal U64 zstd_frame_header_size_from_data(String8 data, U64 *dst_size_out, B32 *has_checksum_out);
+internal ZSTD_FrameArray zstd_frame_array_from_data(Arena *arena, String8 data);
+internal U64 zstd_decompress(void *dst, U64 dst_cap, void *src, U64 src_size);
+
+#endif // ZSTD_H